@@ -0,0 +1,279 @@
+// IN THIS FILE: Benchmark of the solvers for banded matrices. A
+// tridiagonal system (1D Poisson) is solved with the Thomas algorithm,
+// the banded LU solver and the dense LU solver from Numerical Recipes,
+// and a non-symmetric pentadiagonal system with the banded and the
+// dense LU solvers. The banded solvers work in O(n * bw^2) operations
+// and O(n * bw) memory, the dense solver in O(n^3) and O(n^2) (only
+// run for the small sizes). The backward error of each solution is
+// checked, and a tridiagonal matrix that needs pivoting is rejected by
+// the Thomas algorithm and solved by the banded LU solver
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The classes to create matrices and vectors
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+#include "../../../src/matrices/cc_banded_matrix.h"
+// The linear solvers
+#include "../../../src/linear_solvers/cc_factory_linear_solver.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > sizes;
+ argparse::ArgValue<unsigned long> max_dense_size;
+};
+
+// ==================================================================
+// Seconds elapsed since the given time
+// ==================================================================
+double seconds_since(clock_t initial_clock_time)
+{
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ return Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+}
+
+// ==================================================================
+// The normwise backward error of the solution x of A x = b,
+// |b - A x| / (|A| |x| + |b|) in the infinity norm
+// ==================================================================
+Real backward_error(const CCBandedMatrix<Real> &A, const CCVector<Real> &x,
+                    const CCVector<Real> &b)
+{
+ CCVector<Real> r;
+ multiply_matrix_times_vector(A, x, r);
+ const unsigned long n = A.n_rows();
+ Real norm_A = 0.0;
+ Real norm_r = 0.0;
+ Real norm_x = 0.0;
+ Real norm_b = 0.0;
+ for (unsigned long i = 0; i < n; i++)
+  {
+   Real sum = 0.0;
+   for (unsigned long j = (i > A.n_lower_diagonals() ? i - A.n_lower_diagonals() : 0);
+        j < std::min(n, i + A.n_upper_diagonals() + 1); j++)
+    {
+     sum+= std::fabs(A.value(i, j));
+    }
+   norm_A = std::max(norm_A, sum);
+   norm_r = std::max(norm_r, Real(std::fabs(b(i) - r(i))));
+   norm_x = std::max(norm_x, Real(std::fabs(x(i))));
+   norm_b = std::max(norm_b, Real(std::fabs(b(i))));
+  }
+ return norm_r / (norm_A * norm_x + norm_b);
+}
+
+// ==================================================================
+// Is the backward error within a few hundred roundings
+// ==================================================================
+bool is_accurate(const Real error)
+{
+ return error <= 1000.0 * std::numeric_limits<Real>::epsilon();
+}
+
+// ==================================================================
+// Solves A x = b with the given solver, returns the backward error
+// and the time spent
+// ==================================================================
+Real solve_and_time(const std::string &solver_name, ACMatrix<Real> *A_pt,
+                    const CCBandedMatrix<Real> &A_banded, const CCVector<Real> &b,
+                    double &seconds)
+{
+ CCFactoryLinearSolver factory;
+ ACLinearSolver *solver_pt = factory.create_linear_solver(solver_name);
+ CCVector<Real> x;
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ solver_pt->solve(A_pt, &b, &x);
+ seconds = seconds_since(initial_clock_time);
+ delete solver_pt;
+ return backward_error(A_banded, x, b);
+}
+
+// ==================================================================
+// Solves the tridiagonal and the pentadiagonal systems of size n
+// with the banded solvers (and the dense solver if n is small), all
+// the solutions should have small backward errors
+// ==================================================================
+bool benchmark(const unsigned long n, const bool run_dense)
+{
+ // 1D Poisson, tridiagonal
+ CCBandedMatrix<Real> T(n, 1, 1);
+ // Non-symmetric pentadiagonal, the diagonal is not dominant in some
+ // rows thus rows are interchanged by partial pivoting
+ CCBandedMatrix<Real> P(n, 2, 2);
+ CCVector<Real> b(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   T(i, i) = 2.0;
+   if (i > 0) {T(i, i - 1) = -1.0;}
+   if (i + 1 < n) {T(i, i + 1) = -1.0;}
+   for (unsigned long j = (i > 2 ? i - 2 : 0); j < std::min(n, i + 3); j++)
+    {
+     P(i, j) = std::sin(Real(3*i + 7*j + 1));
+    }
+   b(i) = 1.0 + 0.5 * std::cos(Real(i));
+  }
+
+ double seconds_thomas = 0.0;
+ double seconds_banded_T = 0.0;
+ double seconds_banded_P = 0.0;
+ const Real error_thomas = solve_and_time("thomas", &T, T, b, seconds_thomas);
+ const Real error_banded_T = solve_and_time("banded_lu", &T, T, b, seconds_banded_T);
+ const Real error_banded_P = solve_and_time("banded_lu", &P, P, b, seconds_banded_P);
+ bool passed = is_accurate(error_thomas) && is_accurate(error_banded_T) &&
+  is_accurate(error_banded_P);
+
+ std::cout << std::setw(9) << n << " tridiagonal   time thomas: " << std::setw(10)
+           << seconds_thomas << " s banded lu: " << std::setw(10) << seconds_banded_T << " s";
+ double seconds_dense = 0.0;
+ if (run_dense)
+  {
+   CCMatrix<Real> T_dense;
+   T.to_dense(T_dense);
+   const Real error_dense = solve_and_time("numerical_recipes", &T_dense, T, b, seconds_dense);
+   passed = passed && is_accurate(error_dense);
+   std::cout << " dense lu: " << std::setw(10) << seconds_dense << " s";
+  }
+ std::cout << std::endl;
+ std::cout << std::setw(9) << n << " pentadiagonal time banded lu: " << std::setw(10)
+           << seconds_banded_P << " s";
+ if (run_dense)
+  {
+   CCMatrix<Real> P_dense;
+   P.to_dense(P_dense);
+   const Real error_dense = solve_and_time("numerical_recipes", &P_dense, P, b, seconds_dense);
+   passed = passed && is_accurate(error_dense);
+   std::cout << " dense lu: " << std::setw(10) << seconds_dense << " s";
+  }
+ std::cout << std::endl;
+ std::cout << std::setw(9) << " " << " backward errors thomas: " << error_thomas
+           << " banded lu: " << error_banded_T << " " << error_banded_P << std::endl;
+
+ return passed;
+}
+
+// ==================================================================
+// A tridiagonal matrix with zeroes in the diagonal (needs pivoting),
+// returns true if the Thomas algorithm rejects it and the banded LU
+// solver solves it
+// ==================================================================
+bool needs_pivoting()
+{
+ const unsigned long n = 6;
+ CCBandedMatrix<Real> A(n, 1, 1);
+ CCVector<Real> b(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   if (i > 0) {A(i, i - 1) = 1.0;}
+   if (i + 1 < n) {A(i, i + 1) = 1.0;}
+   b(i) = Real(i + 1);
+  }
+
+ // The Thomas algorithm finds a zero pivot in the first row (the
+ // error message is expected)
+ bool rejected = false;
+ CCThomasSolver thomas;
+ CCVector<Real> x;
+ try
+  {
+   thomas.solve(&A, &b, &x);
+  }
+ catch (const SciCellxxLibError &error)
+  {
+   rejected = true;
+  }
+
+ CCBandedLUSolver banded_lu;
+ CCVector<Real> y;
+ banded_lu.solve(&A, &b, &y);
+
+ // The LU factorisation is re-used with a new right-hand side
+ CCVector<Real> c(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   c(i) = 1.0;
+  }
+ CCVector<Real> z;
+ banded_lu.resolve(&c, &z);
+
+ return rejected && is_accurate(backward_error(A, y, b)) &&
+  is_accurate(backward_error(A, z, c));
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the solvers for banded matrices");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.sizes, "--sizes")
+  .help("Number of rows of the matrices")
+  .nargs('+')
+  .default_value({"100", "1000", "100000", "1000000"});
+
+ parser.add_argument(args.max_dense_size, "--max_dense_size")
+  .help("Largest number of rows solved with the dense solver")
+  .default_value("1000");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ std::vector<unsigned long> sizes = args.sizes.value();
+ unsigned long max_dense_size = args.max_dense_size;
+ if (args.test)
+  {
+   sizes.clear();
+   sizes.push_back(10);
+   sizes.push_back(200);
+   sizes.push_back(10000);
+   max_dense_size = 200;
+  }
+
+ bool all_passed = true;
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   const unsigned long n = sizes[i];
+   const bool passed = benchmark(n, n <= max_dense_size);
+   output_test << n << " " << passed << std::endl;
+   all_passed = all_passed && passed;
+  }
+
+ const bool pivoting = needs_pivoting();
+ std::cout << "Zero diagonal rejected by thomas and solved by banded lu: "
+           << pivoting << std::endl;
+ output_test << pivoting << std::endl;
+ all_passed = all_passed && pivoting;
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The solutions of the banded solvers are not accurate" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
@@ -0,0 +1,289 @@
+// IN THIS FILE: Benchmark of the batched operations on many small
+// independent systems (CCMatrixBatch, CCVectorBatch and
+// CCBatchedLUSolver). A batch of non-symmetric n X n systems (that
+// need pivoting) is solved one by one with the dense LU solver from
+// Numerical Recipes and at once with the batched LU solver, and the
+// batched matrix times matrix and matrix times vector are compared
+// against the products of each member with CCMatrix and CCVector. A
+// batch with a singular member is checked to be rejected naming it
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The classes to create matrices, vectors and their batches
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+#include "../../../src/matrices/cc_matrix_batch.h"
+// The linear solvers
+#include "../../../src/linear_solvers/cc_factory_linear_solver.h"
+#include "../../../src/linear_solvers/cc_batched_lu_solver.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > sizes;
+ argparse::ArgValue<unsigned long> n_systems;
+};
+
+// ==================================================================
+// Seconds elapsed since the given time
+// ==================================================================
+double seconds_since(clock_t initial_clock_time)
+{
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ return Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+}
+
+// ==================================================================
+// The (i, j) entry of the b-th matrix, the diagonal is not dominant
+// thus rows are interchanged by partial pivoting
+// ==================================================================
+Real matrix_entry(const unsigned long b, const unsigned long i, const unsigned long j)
+{
+ return std::sin(Real(3*i + 7*j + 11*b + 1)) + (i == j ? 0.1 : 0.0);
+}
+
+// ==================================================================
+// The largest difference between the entries of x and y relative to
+// the largest entry of y
+// ==================================================================
+Real relative_difference(const ACVector<Real> &x, const ACVector<Real> &y)
+{
+ Real difference = 0.0;
+ Real norm = 0.0;
+ for (unsigned long i = 0; i < y.n_values(); i++)
+  {
+   difference = std::max(difference, Real(std::fabs(x.value(i) - y.value(i))));
+   norm = std::max(norm, Real(std::fabs(y.value(i))));
+  }
+ return difference / norm;
+}
+
+// ==================================================================
+// Solves n_systems systems of size n one by one and as a batch,
+// checks the batched solutions, matrix times matrix and matrix times
+// vector against the ones of each member
+// ==================================================================
+void benchmark(const unsigned long n, const unsigned long n_systems,
+               bool &passed_lu, bool &passed_gemm, bool &passed_gemv)
+{
+ CCMatrixBatch<Real> A(n_systems, n, n);
+ CCVectorBatch<Real> rhs(n_systems, n);
+ for (unsigned long b = 0; b < n_systems; b++)
+  {
+   for (unsigned long i = 0; i < n; i++)
+    {
+     for (unsigned long j = 0; j < n; j++)
+      {
+       A(b, i, j) = matrix_entry(b, i, j);
+      }
+     rhs(b, i) = 1.0 + 0.5 * std::cos(Real(i + b));
+    }
+  }
+
+ // One by one with the dense solver
+ CCFactoryLinearSolver factory;
+ ACLinearSolver *solver_pt = factory.create_linear_solver("numerical_recipes");
+ std::vector<CCVector<Real> > x_one_by_one(n_systems);
+ CCMatrix<Real> A_b;
+ CCVector<Real> rhs_b;
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned long b = 0; b < n_systems; b++)
+  {
+   A.get_matrix(b, A_b);
+   rhs.get_vector(b, rhs_b);
+   solver_pt->solve(&A_b, &rhs_b, &x_one_by_one[b]);
+  }
+ const double seconds_one_by_one = seconds_since(initial_clock_time);
+ delete solver_pt;
+
+ // As a batch
+ CCBatchedLUSolver batched_solver;
+ CCVectorBatch<Real> x;
+ initial_clock_time = Timing::cpu_clock_time();
+ batched_solver.solve(A, rhs, x);
+ const double seconds_batched = seconds_since(initial_clock_time);
+
+ Real difference_lu = 0.0;
+ CCVector<Real> x_b;
+ for (unsigned long b = 0; b < n_systems; b++)
+  {
+   x.get_vector(b, x_b);
+   difference_lu = std::max(difference_lu, relative_difference(x_b, x_one_by_one[b]));
+  }
+
+ // Matrix times matrix, C_b = A_b * A_b
+ CCMatrixBatch<Real> C;
+ initial_clock_time = Timing::cpu_clock_time();
+ multiply_matrices(A, A, C);
+ const double seconds_gemm = seconds_since(initial_clock_time);
+
+ // Matrix times vector, y_b = A_b * x_b
+ CCVectorBatch<Real> y;
+ initial_clock_time = Timing::cpu_clock_time();
+ multiply_matrix_times_vector(A, x, y);
+ const double seconds_gemv = seconds_since(initial_clock_time);
+
+ Real difference_gemm = 0.0;
+ Real difference_gemv = 0.0;
+ CCMatrix<Real> C_b;
+ CCMatrix<Real> C_one;
+ CCVector<Real> y_b;
+ CCVector<Real> y_one;
+ for (unsigned long b = 0; b < n_systems; b++)
+  {
+   A.get_matrix(b, A_b);
+   C.get_matrix(b, C_b);
+   multiply_matrices(A_b, A_b, C_one);
+   for (unsigned long i = 0; i < n; i++)
+    {
+     CCVector<Real> row_batch(C_b.matrix_pt() + i*n, n);
+     CCVector<Real> row_one(C_one.matrix_pt() + i*n, n);
+     difference_gemm = std::max(difference_gemm, relative_difference(row_batch, row_one));
+    }
+   x.get_vector(b, x_b);
+   y.get_vector(b, y_b);
+   multiply_matrix_times_vector(A_b, x_b, y_one);
+   // Relative to |A_b| |x_b|, the entries of y_b cancel
+   Real difference = 0.0;
+   Real scale = 0.0;
+   for (unsigned long i = 0; i < n; i++)
+    {
+     Real sum = 0.0;
+     for (unsigned long j = 0; j < n; j++)
+      {
+       sum+= std::fabs(A_b(i, j) * x_b(j));
+      }
+     difference = std::max(difference, Real(std::fabs(y_b(i) - y_one(i))));
+     scale = std::max(scale, sum);
+    }
+   difference_gemv = std::max(difference_gemv, difference / scale);
+  }
+
+ // The pivots of both solvers are the same, the solutions differ by
+ // a few roundings amplified by the condition number
+ const Real eps = std::numeric_limits<Real>::epsilon();
+ passed_lu = difference_lu <= 1.0e6 * eps;
+ passed_gemm = difference_gemm <= 100.0 * n * eps;
+ passed_gemv = difference_gemv <= 100.0 * n * eps;
+
+ std::cout << "n = " << std::setw(3) << n << " (" << n_systems << " systems)\n"
+           << "  LU one by one: " << std::setw(10) << seconds_one_by_one << " s"
+           << "  batched: " << std::setw(10) << seconds_batched << " s"
+           << "  (relative difference " << difference_lu << ")\n"
+           << "  batched matrix times matrix: " << std::setw(10) << seconds_gemm << " s"
+           << "  (relative difference " << difference_gemm << ")\n"
+           << "  batched matrix times vector: " << std::setw(10) << seconds_gemv << " s"
+           << "  (relative difference " << difference_gemv << ")" << std::endl;
+}
+
+// ==================================================================
+// A batch whose member with the given index is singular is rejected
+// ==================================================================
+bool singular_member_is_rejected(const unsigned long n, const unsigned long n_systems,
+                                 const unsigned long singular_member)
+{
+ CCMatrixBatch<Real> A(n_systems, n, n);
+ for (unsigned long b = 0; b < n_systems; b++)
+  {
+   for (unsigned long i = 0; i < n; i++)
+    {
+     for (unsigned long j = 0; j < n; j++)
+      {
+       // Two equal rows in the singular member
+       A(b, i, j) = matrix_entry(b, (b == singular_member && i == 1) ? 0 : i, j);
+      }
+    }
+  }
+
+ CCBatchedLUSolver batched_solver;
+ try
+  {
+   batched_solver.factorise(A);
+  }
+ catch (const SciCellxxLibError &error)
+  {
+   return true;
+  }
+ return false;
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the batched operations on small systems");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.sizes, "--sizes")
+  .help("Number of rows of the matrices of the batch")
+  .nargs('+')
+  .default_value({"4", "8", "16", "32"});
+
+ parser.add_argument(args.n_systems, "--n_systems")
+  .help("Number of systems in the batch")
+  .default_value("100000");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ std::vector<unsigned long> sizes = args.sizes.value();
+ unsigned long n_systems = args.n_systems;
+ if (args.test)
+  {
+   sizes.clear();
+   sizes.push_back(4);
+   sizes.push_back(8);
+   // Not a multiple of the groups of the batch
+   n_systems = 250;
+  }
+
+ bool all_passed = true;
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   bool passed_lu = false;
+   bool passed_gemm = false;
+   bool passed_gemv = false;
+   benchmark(sizes[i], n_systems, passed_lu, passed_gemm, passed_gemv);
+   output_test << sizes[i] << " " << passed_lu << " " << passed_gemm << " "
+               << passed_gemv << std::endl;
+   all_passed = all_passed && passed_lu && passed_gemm && passed_gemv;
+  }
+
+ // The singular member is in the last (incomplete) group
+ const bool singular_rejected = singular_member_is_rejected(4, 250, 247);
+ std::cout << "A batch with a singular member is rejected: " << singular_rejected << std::endl;
+ output_test << singular_rejected << std::endl;
+ all_passed = all_passed && singular_rejected;
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The batched operations differ from the ones of each member" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
@@ -0,0 +1,389 @@
+// IN THIS FILE: Benchmark of the blocked LU solver (CCBlockedLUSolver)
+// against the LU solver from Numerical Recipes. Dense non-symmetric
+// systems of size n are solved with both of them, the time of the
+// factorisation and the backward error of the solutions are
+// reported. The factorisation in place of a CCMatrix, the copy of a
+// matrix stored by columns, resolve() with a second right-hand side
+// the rejection of a singular matrix and the factorisation of a badly
+// scaled one are also checked
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The classes to create matrices and vectors
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+// The linear solvers
+#include "../../../src/linear_solvers/cc_factory_linear_solver.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > sizes;
+ argparse::ArgValue<unsigned long> max_reference_size;
+ argparse::ArgValue<unsigned long> block_size;
+ argparse::ArgValue<unsigned> n_threads;
+};
+
+// ==================================================================
+// Seconds elapsed since the given times, the wall time if it is large
+// enough to be measured (the blocked solver runs in several threads),
+// otherwise the cpu time
+// ==================================================================
+double seconds_since(clock_t initial_clock_time, time_t initial_wall_time)
+{
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ time_t final_wall_time = Timing::wall_time();
+ const double wall_seconds = Timing::diff_wall_time(initial_wall_time, final_wall_time);
+ if (wall_seconds > 1.0)
+  {
+   return wall_seconds;
+  }
+ return Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+}
+
+// ==================================================================
+// Fills the matrix with entries in [-1, 1], the diagonal is not
+// dominant thus rows are interchanged by partial pivoting. The phase
+// grows with i*j such that the matrix is not singular (the sine of a
+// sum of functions of i and of j only gives a matrix of rank two)
+// ==================================================================
+void fill_matrix(CCMatrix<Real> &A)
+{
+ const unsigned long n = A.n_rows();
+ for (unsigned long i = 0; i < n; i++)
+  {
+   for (unsigned long j = 0; j < n; j++)
+    {
+     A(i, j) = std::sin(Real(3*i + 7*j + 1) + 0.1 * Real(i*j));
+    }
+  }
+}
+
+// ==================================================================
+// The normwise backward error of the solution x of A x = b,
+// |b - A x| / (|A| |x| + |b|) in the infinity norm
+// ==================================================================
+Real backward_error(const CCMatrix<Real> &A, const CCVector<Real> &x,
+                    const CCVector<Real> &b)
+{
+ const unsigned long n = A.n_rows();
+ Real norm_A = 0.0;
+ Real norm_r = 0.0;
+ Real norm_x = 0.0;
+ Real norm_b = 0.0;
+ for (unsigned long i = 0; i < n; i++)
+  {
+   Real sum = 0.0;
+   Real r_i = b(i);
+   for (unsigned long j = 0; j < n; j++)
+    {
+     sum+= std::fabs(A(i, j));
+     r_i-= A(i, j) * x(j);
+    }
+   norm_A = std::max(norm_A, sum);
+   norm_r = std::max(norm_r, Real(std::fabs(r_i)));
+   norm_x = std::max(norm_x, Real(std::fabs(x(i))));
+   norm_b = std::max(norm_b, Real(std::fabs(b(i))));
+  }
+ return norm_r / (norm_A * norm_x + norm_b);
+}
+
+// ==================================================================
+// Is the backward error within the expected roundings of a
+// factorisation with partial pivoting
+// ==================================================================
+bool is_accurate(const Real error, const unsigned long n)
+{
+ return error <= 10.0 * Real(n) * std::numeric_limits<Real>::epsilon();
+}
+
+// ==================================================================
+// Solves a system of size n with the blocked solver (and with the
+// solver from Numerical Recipes if run_reference is true). Returns
+// true if the solutions are accurate
+// ==================================================================
+bool benchmark(const unsigned long n, const unsigned long block_size,
+               const bool run_reference)
+{
+ CCMatrix<Real> A(n, n);
+ fill_matrix(A);
+ CCVector<Real> b(n);
+ CCVector<Real> b2(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   b(i) = 1.0 + 0.5 * std::cos(Real(i));
+   b2(i) = Real(i % 7) - 3.0;
+  }
+
+ // Blocked LU
+ CCBlockedLUSolver blocked_solver;
+ blocked_solver.set_block_size(block_size);
+ CCVector<Real> x;
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ time_t initial_wall_time = Timing::wall_time();
+ blocked_solver.factorise(&A);
+ const double seconds_blocked = seconds_since(initial_clock_time, initial_wall_time);
+ blocked_solver.resolve(&b, &x);
+ const Real error_blocked = backward_error(A, x, b);
+
+ // A second right-hand side with the same factorisation
+ CCVector<Real> x2;
+ blocked_solver.resolve(&b2, &x2);
+ const Real error_resolve = backward_error(A, x2, b2);
+ bool passed = is_accurate(error_blocked, n) && is_accurate(error_resolve, n);
+
+ std::cout << std::setw(6) << n << "  blocked lu: " << std::setw(10) << seconds_blocked
+           << " s (" << (2.0 * n * n * n / 3.0) / seconds_blocked * 1.0e-9
+           << " GFlops, backward error " << error_blocked << ")";
+
+ if (run_reference)
+  {
+   CCFactoryLinearSolver factory;
+   ACLinearSolver *solver_pt = factory.create_linear_solver("numerical_recipes");
+   CCLUSolverNumericalRecipes *nr_solver_pt = dynamic_cast<CCLUSolverNumericalRecipes*>(solver_pt);
+   CCVector<Real> x_nr;
+   initial_clock_time = Timing::cpu_clock_time();
+   initial_wall_time = Timing::wall_time();
+   nr_solver_pt->factorise(&A);
+   const double seconds_nr = seconds_since(initial_clock_time, initial_wall_time);
+   nr_solver_pt->resolve(&b, &x_nr);
+   const Real error_nr = backward_error(A, x_nr, b);
+   delete solver_pt;
+   passed = passed && is_accurate(error_nr, n);
+   std::cout << "  numerical recipes: " << std::setw(10) << seconds_nr
+             << " s (backward error " << error_nr << ")  speed up: "
+             << seconds_nr / seconds_blocked;
+  }
+ std::cout << std::endl;
+
+ return passed;
+}
+
+// ==================================================================
+// The factorisation in place gives the same solution as the one of a
+// copy, and a matrix stored by columns is copied and factorised
+// ==================================================================
+bool check_in_place_and_column_major(const unsigned long n, const unsigned long block_size)
+{
+ CCMatrix<Real> A(n, n);
+ fill_matrix(A);
+ CCVector<Real> b(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   b(i) = 1.0 + 0.5 * std::cos(Real(i));
+  }
+
+ CCBlockedLUSolver copy_solver;
+ copy_solver.set_block_size(block_size);
+ CCVector<Real> x_copy;
+ copy_solver.solve(&A, &b, &x_copy);
+
+ // The matrix stored by columns
+ CCMatrix<Real> A_by_columns(n, n);
+ A_by_columns.set_column_major(true);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   for (unsigned long j = 0; j < n; j++)
+    {
+     A_by_columns(i, j) = A(i, j);
+    }
+  }
+ CCBlockedLUSolver column_major_solver;
+ column_major_solver.set_block_size(block_size);
+ CCVector<Real> x_column_major;
+ column_major_solver.solve(&A_by_columns, &b, &x_column_major);
+
+ // In place, A is overwritten by its factors
+ CCMatrix<Real> A_in_place(A);
+ CCBlockedLUSolver in_place_solver;
+ in_place_solver.set_block_size(block_size);
+ in_place_solver.enable_factorise_in_place();
+ CCVector<Real> x_in_place;
+ in_place_solver.solve(&A_in_place, &b, &x_in_place);
+
+ bool same_solutions = true;
+ bool overwritten = false;
+ for (unsigned long i = 0; i < n; i++)
+  {
+   same_solutions = same_solutions && x_in_place(i) == x_copy(i) &&
+    x_column_major(i) == x_copy(i);
+   for (unsigned long j = 0; j < n; j++)
+    {
+     overwritten = overwritten || A_in_place(i, j) != A(i, j);
+    }
+  }
+ return same_solutions && overwritten;
+}
+
+// ==================================================================
+// A singular matrix is rejected (the rounding errors leave a pivot of
+// the order of eps instead of a zero one, it is below the pivot
+// tolerance set to the machine epsilon)
+// ==================================================================
+bool singular_matrix_is_rejected(const unsigned long n, const unsigned long block_size)
+{
+ CCMatrix<Real> A(n, n);
+ fill_matrix(A);
+ // The last column is the sum of the first two
+ for (unsigned long i = 0; i < n; i++)
+  {
+   A(i, n - 1) = A(i, 0) + A(i, 1);
+  }
+ CCBlockedLUSolver solver;
+ solver.set_block_size(block_size);
+ solver.set_pivot_tolerance(std::numeric_limits<Real>::epsilon());
+ try
+  {
+   solver.factorise(&A);
+  }
+ catch (const SciCellxxLibError &error)
+  {
+   return true;
+  }
+ return false;
+}
+
+// ==================================================================
+// A badly scaled matrix (the rows scaled from 1 to 1e-16) is
+// factorised with the default pivot tolerance and solved accurately
+// ==================================================================
+bool badly_scaled_matrix_is_factorised(const unsigned long n, const unsigned long block_size)
+{
+ CCMatrix<Real> A(n, n);
+ fill_matrix(A);
+ CCVector<Real> b(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   const Real scaling = std::pow(Real(10.0), -Real(16 * i) / Real(n - 1));
+   for (unsigned long j = 0; j < n; j++)
+    {
+     A(i, j)*= scaling;
+    }
+   b(i) = scaling;
+  }
+ CCBlockedLUSolver solver;
+ solver.set_block_size(block_size);
+ CCVector<Real> x;
+ try
+  {
+   solver.solve(&A, &b, &x);
+  }
+ catch (const SciCellxxLibError &error)
+  {
+   return false;
+  }
+ return is_accurate(backward_error(A, x, b), n);
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the blocked LU solver");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.sizes, "--sizes")
+  .help("Number of rows of the matrices")
+  .nargs('+')
+  .default_value({"500", "1000", "2000", "4000", "8000"});
+
+ parser.add_argument(args.max_reference_size, "--max_reference_size")
+  .help("Largest size solved with the solver from Numerical Recipes")
+  .default_value("8000");
+
+ parser.add_argument(args.block_size, "--block_size")
+  .help("Number of columns of the panels of the blocked solver")
+  .default_value("256");
+
+ parser.add_argument(args.n_threads, "--n_threads")
+  .help("Number of threads used by the trailing updates (0 for the number of hardware threads)")
+  .default_value("0");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ std::vector<unsigned long> sizes = args.sizes.value();
+ unsigned long max_reference_size = args.max_reference_size;
+ unsigned long block_size = args.block_size;
+ if (args.test)
+  {
+   sizes.clear();
+   sizes.push_back(50);
+   sizes.push_back(300);
+   max_reference_size = 300;
+  }
+
+ if (args.n_threads > 0)
+  {
+   ThreadPool::set_n_threads(args.n_threads);
+  }
+ std::cout << "Threads: " << ThreadPool::n_threads() << std::endl;
+
+ bool all_passed = true;
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   const bool passed = benchmark(sizes[i], block_size, sizes[i] <= max_reference_size);
+   output_test << sizes[i] << " " << passed << std::endl;
+   all_passed = all_passed && passed;
+  }
+
+ // Small blocks such that there are several panels and the panels
+ // are split recursively
+ const bool passed_small_blocks = benchmark(200, 48, false);
+ const bool passed_in_place = check_in_place_and_column_major(150, 64);
+ const bool passed_singular = singular_matrix_is_rejected(100, 32);
+ const bool passed_badly_scaled = badly_scaled_matrix_is_factorised(100, 32);
+
+ // The updates split among several threads (even with small sizes)
+ const unsigned n_threads = ThreadPool::n_threads();
+ const unsigned long serial_threshold = ThreadPool::serial_threshold();
+ ThreadPool::set_n_threads(4);
+ ThreadPool::set_serial_threshold(1);
+ const bool passed_threads = benchmark(200, 48, false) &&
+  check_in_place_and_column_major(150, 64);
+ ThreadPool::set_n_threads(n_threads);
+ ThreadPool::set_serial_threshold(serial_threshold);
+
+ std::cout << "Small blocks: " << passed_small_blocks << "\n"
+           << "In place and stored by columns: " << passed_in_place << "\n"
+           << "Singular matrix rejected: " << passed_singular << "\n"
+           << "Badly scaled matrix factorised: " << passed_badly_scaled << "\n"
+           << "Four threads: " << passed_threads << std::endl;
+ output_test << passed_small_blocks << " " << passed_in_place << " "
+             << passed_singular << " " << passed_badly_scaled << " "
+             << passed_threads << std::endl;
+ all_passed = all_passed && passed_small_blocks && passed_in_place &&
+  passed_singular && passed_badly_scaled && passed_threads;
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The blocked LU solver did not pass the checks" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
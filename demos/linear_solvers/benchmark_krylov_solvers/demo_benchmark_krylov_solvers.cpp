@@ -0,0 +1,427 @@
+// IN THIS FILE: Benchmark of the iterative (Krylov) solvers, CG,
+// GMRES(m) and BiCGStab, with no preconditioner and with the Jacobi,
+// SSOR and ILU(0) preconditioners. The systems are the 5-point
+// discretisation of the Poisson equation (symmetric positive definite)
+// and of a convection-diffusion equation with upwind convection
+// (non-symmetric) on a g X g grid, stored as sparse matrices. The
+// iterations, the time and the true relative residual of each solve
+// are reported. The same systems given as dense matrices, resolve()
+// with a second right-hand side, the error thrown when the iterations
+// are exhausted and the solves with several threads are also checked
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The classes to create matrices and vectors
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+#include "../../../src/matrices/cc_sparse_matrix.h"
+// The linear solvers
+#include "../../../src/linear_solvers/cc_factory_linear_solver.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > grid_sizes;
+ argparse::ArgValue<unsigned long> maximum_iterations;
+ argparse::ArgValue<unsigned long> restart;
+ argparse::ArgValue<unsigned> n_threads;
+};
+
+// ==================================================================
+// Seconds elapsed since the given times, the wall time if it is large
+// enough to be measured (the mat-vecs run in several threads),
+// otherwise the cpu time
+// ==================================================================
+double seconds_since(clock_t initial_clock_time, time_t initial_wall_time)
+{
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ time_t final_wall_time = Timing::wall_time();
+ const double wall_seconds = Timing::diff_wall_time(initial_wall_time, final_wall_time);
+ if (wall_seconds > 1.0)
+  {
+   return wall_seconds;
+  }
+ return Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+}
+
+// ==================================================================
+// The 5-point matrix of -Laplacian(u) + convection * (u_x + u_y) on a
+// g X g grid (scaled by h^2), the convection is discretised upwind
+// with convection * h = convection_h. With no convection the matrix
+// is symmetric positive definite
+// ==================================================================
+void fill_grid_matrix(const unsigned long g, const Real convection_h,
+                      CCSparseMatrix<Real> &A)
+{
+ const unsigned long n = g * g;
+ CCSparseMatrixBuilder<Real> builder(n, n);
+ builder.reserve(5 * n);
+ for (unsigned long i = 0; i < g; i++)
+  {
+   for (unsigned long j = 0; j < g; j++)
+    {
+     const unsigned long k = i * g + j;
+     builder.add_entry(k, k, 4.0 + 2.0 * convection_h);
+     if (i > 0)
+      {
+       builder.add_entry(k, k - g, -1.0 - convection_h);
+      }
+     if (j > 0)
+      {
+       builder.add_entry(k, k - 1, -1.0 - convection_h);
+      }
+     if (j + 1 < g)
+      {
+       builder.add_entry(k, k + 1, -1.0);
+      }
+     if (i + 1 < g)
+      {
+       builder.add_entry(k, k + g, -1.0);
+      }
+    }
+  }
+ builder.build(A);
+}
+
+// ==================================================================
+// The relative residual ||b - A x|| / ||b|| of the solution
+// ==================================================================
+Real relative_residual(const CCSparseMatrix<Real> &A, const CCVector<Real> &x,
+                       const CCVector<Real> &b)
+{
+ CCVector<Real> r;
+ multiply_matrix_times_vector(A, x, r);
+ Real norm_r = 0.0;
+ Real norm_b = 0.0;
+ for (unsigned long i = 0; i < b.n_values(); i++)
+  {
+   norm_r+= (b(i) - r(i)) * (b(i) - r(i));
+   norm_b+= b(i) * b(i);
+  }
+ return std::sqrt(norm_r / norm_b);
+}
+
+// ==================================================================
+// Is the true residual close to the tolerance of the solver (the
+// norm tracked by GMRES and the recursive residuals of CG and
+// BiCGStab drift from the true one by roundings)
+// ==================================================================
+bool is_accurate(const Real residual, const Real tolerance)
+{
+ return residual <= 100.0 * tolerance;
+}
+
+// ==================================================================
+// Solves A x = b with the given solver and preconditioner (NULL for
+// none), GMRES restarts every restart iterations. Prints the
+// iterations, the time and the true residual. Returns the number of
+// iterations, zero if the solve did not converge or the solution is
+// not accurate
+// ==================================================================
+unsigned long run_solver(const std::string &solver_name,
+                         const std::string &preconditioner_name,
+                         ACPreconditioner *preconditioner_pt,
+                         CCSparseMatrix<Real> &A, const CCVector<Real> &b,
+                         const unsigned long maximum_iterations,
+                         const unsigned long restart)
+{
+ CCFactoryLinearSolver factory;
+ ACLinearSolver *linear_solver_pt = factory.create_linear_solver(solver_name);
+ ACIterativeLinearSolver *iterative_solver_pt =
+  dynamic_cast<ACIterativeLinearSolver*>(linear_solver_pt);
+ iterative_solver_pt->set_maximum_number_of_iterations(maximum_iterations);
+ iterative_solver_pt->set_preconditioner(preconditioner_pt);
+ CCGMRESSolver *gmres_solver_pt = dynamic_cast<CCGMRESSolver*>(linear_solver_pt);
+ if (gmres_solver_pt != 0)
+  {
+   gmres_solver_pt->set_restart(restart);
+  }
+
+ CCVector<Real> x;
+ bool converged = true;
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ time_t initial_wall_time = Timing::wall_time();
+ try
+  {
+   linear_solver_pt->solve(&A, &b, &x);
+  }
+ catch (const SciCellxxLibError &error)
+  {
+   converged = false;
+  }
+ const double seconds = seconds_since(initial_clock_time, initial_wall_time);
+ const unsigned long n_iterations = iterative_solver_pt->n_iterations();
+ const Real residual = converged ? relative_residual(A, x, b) : Real(0.0);
+ const bool accurate = converged && is_accurate(residual, iterative_solver_pt->tolerance());
+
+ std::cout << "  " << std::setw(9) << solver_name << " + " << std::setw(6)
+           << preconditioner_name << ": " << std::setw(6) << n_iterations
+           << " iterations " << std::setw(10) << seconds << " s";
+ if (converged)
+  {
+   std::cout << " (residual " << residual << ")" << std::endl;
+  }
+ else
+  {
+   std::cout << " (did not converge, relative residual "
+             << iterative_solver_pt->residual_history().back() << ")" << std::endl;
+  }
+
+ delete linear_solver_pt;
+ return accurate ? n_iterations : 0;
+}
+
+// ==================================================================
+// Solves the Poisson (with CG, GMRES and BiCGStab) and the
+// convection-diffusion (with GMRES and BiCGStab) systems on a g X g
+// grid with each preconditioner. Returns true if all the solves with
+// SSOR and ILU(0) are accurate and ILU(0) needs fewer iterations than
+// no preconditioner. The solves with no preconditioner may not
+// converge (GMRES(m) stagnates on large Poisson systems), nor those
+// with Jacobi since the diagonal of these matrices is constant
+// ==================================================================
+bool benchmark_grid(const unsigned long g, const unsigned long maximum_iterations,
+                    const unsigned long restart)
+{
+ const unsigned long n = g * g;
+ CCVector<Real> b(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   b(i) = 1.0 + 0.5 * std::cos(Real(i));
+  }
+
+ CCJacobiPreconditioner jacobi;
+ CCSSORPreconditioner ssor(1.5);
+ CCILU0Preconditioner ilu0;
+ const unsigned n_preconditioners = 4;
+ ACPreconditioner *preconditioners_pt[n_preconditioners] = {0, &jacobi, &ssor, &ilu0};
+ const std::string preconditioner_names[n_preconditioners] = {"none", "jacobi", "ssor", "ilu0"};
+
+ bool passed = true;
+ for (unsigned problem = 0; problem < 2; problem++)
+  {
+   const bool symmetric = problem == 0;
+   CCSparseMatrix<Real> A;
+   fill_grid_matrix(g, symmetric ? 0.0 : 1.0, A);
+   std::cout << std::setw(6) << n << (symmetric ? " poisson" : " convection-diffusion")
+             << " (" << A.n_non_zeros() << " non-zeros)" << std::endl;
+
+   const unsigned n_solvers = 3;
+   const std::string solver_names[n_solvers] = {"cg", "gmres", "bicgstab"};
+   for (unsigned s = symmetric ? 0 : 1; s < n_solvers; s++)
+    {
+     unsigned long n_iterations[n_preconditioners];
+     for (unsigned p = 0; p < n_preconditioners; p++)
+      {
+       n_iterations[p] = run_solver(solver_names[s], preconditioner_names[p],
+                                    preconditioners_pt[p], A, b, maximum_iterations,
+                                    restart);
+       passed = passed && (p < 2 || n_iterations[p] > 0);
+      }
+     passed = passed && (n_iterations[0] == 0 || n_iterations[3] < n_iterations[0]);
+    }
+  }
+
+ return passed;
+}
+
+// ==================================================================
+// Solves the convection-diffusion system on a g X g grid given as a
+// dense matrix with GMRES + ILU(0) and BiCGStab + SSOR, and re-solves
+// with a second right-hand side. Returns true if the solutions are
+// accurate and the iterations are those of the sparse matrix
+// ==================================================================
+bool check_dense_and_resolve(const unsigned long g)
+{
+ const unsigned long n = g * g;
+ CCSparseMatrix<Real> A;
+ fill_grid_matrix(g, 1.0, A);
+ CCMatrix<Real> A_dense;
+ A.to_dense(A_dense);
+ CCVector<Real> b(n);
+ CCVector<Real> b2(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   b(i) = 1.0 + 0.5 * std::cos(Real(i));
+   b2(i) = Real(i % 7) - 3.0;
+  }
+
+ bool passed = true;
+ CCILU0Preconditioner ilu0;
+ CCSSORPreconditioner ssor;
+ CCGMRESSolver gmres_solver;
+ CCBiCGStabSolver bicgstab_solver;
+ gmres_solver.set_preconditioner(&ilu0);
+ bicgstab_solver.set_preconditioner(&ssor);
+ ACIterativeLinearSolver *solvers_pt[2] = {&gmres_solver, &bicgstab_solver};
+ for (unsigned s = 0; s < 2; s++)
+  {
+   CCVector<Real> x_sparse;
+   solvers_pt[s]->solve(&A, &b, &x_sparse);
+   const unsigned long n_iterations_sparse = solvers_pt[s]->n_iterations();
+   CCVector<Real> x_dense;
+   solvers_pt[s]->solve(&A_dense, &b, &x_dense);
+   const unsigned long n_iterations_dense = solvers_pt[s]->n_iterations();
+   const Real residual_dense = relative_residual(A, x_dense, b);
+
+   // A second right-hand side, reusing the preconditioner of the
+   // dense matrix
+   CCVector<Real> x2;
+   solvers_pt[s]->resolve(&b2, &x2);
+   const Real residual_resolve = relative_residual(A, x2, b2);
+
+   // The history has one entry per iteration and the initial one
+   const bool history = solvers_pt[s]->residual_history().size() ==
+    solvers_pt[s]->n_iterations() + 1 && solvers_pt[s]->residual_history()[0] == 1.0;
+
+   std::cout << "  dense " << (s == 0 ? "gmres + ilu0" : "bicgstab + ssor") << ": "
+             << n_iterations_dense << " iterations (sparse " << n_iterations_sparse
+             << "), residual " << residual_dense << ", resolve " << residual_resolve
+             << std::endl;
+   const Real tolerance = solvers_pt[s]->tolerance();
+   passed = passed && is_accurate(residual_dense, tolerance) &&
+    is_accurate(residual_resolve, tolerance) && history &&
+    (n_iterations_dense > n_iterations_sparse ? n_iterations_dense - n_iterations_sparse :
+     n_iterations_sparse - n_iterations_dense) <= 1;
+  }
+
+ return passed;
+}
+
+// ==================================================================
+// Checks that an error is thrown when the iterations are exhausted
+// and that the last iterate is returned (its residual is the last one
+// of the history)
+// ==================================================================
+bool check_not_converged(const unsigned long g)
+{
+ CCSparseMatrix<Real> A;
+ fill_grid_matrix(g, 0.0, A);
+ CCVector<Real> b(g * g);
+ for (unsigned long i = 0; i < g * g; i++)
+  {
+   b(i) = 1.0;
+  }
+ CCCGSolver cg_solver;
+ cg_solver.set_maximum_number_of_iterations(3);
+ CCVector<Real> x;
+ bool thrown = false;
+ try
+  {
+   cg_solver.solve(&A, &b, &x);
+  }
+ catch (const SciCellxxLibError &error)
+  {
+   thrown = true;
+  }
+ const Real residual = relative_residual(A, x, b);
+ std::cout << "  not converged: error thrown " << thrown << ", iterations "
+           << cg_solver.n_iterations() << ", residual " << residual << std::endl;
+ return thrown && cg_solver.n_iterations() == 3 &&
+  std::fabs(residual - cg_solver.residual_history().back()) < 1.0e-3;
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the Krylov solvers and their preconditioners");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.grid_sizes, "--grid_sizes")
+  .help("Number of points per side of the grids, the systems have the square of them unknowns")
+  .nargs('+')
+  .default_value({"100", "224"});
+
+ parser.add_argument(args.maximum_iterations, "--maximum_iterations")
+  .help("Maximum number of iterations of each solve")
+  .default_value("5000");
+
+ parser.add_argument(args.restart, "--restart")
+  .help("Number of iterations between the restarts of GMRES")
+  .default_value("30");
+
+ parser.add_argument(args.n_threads, "--n_threads")
+  .help("Number of threads used by the mat-vecs and the dot products (0 for the number of hardware threads)")
+  .default_value("0");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ std::vector<unsigned long> grid_sizes = args.grid_sizes.value();
+ if (args.test)
+  {
+   grid_sizes.clear();
+   grid_sizes.push_back(10);
+   grid_sizes.push_back(40);
+  }
+
+ if (args.n_threads > 0)
+  {
+   ThreadPool::set_n_threads(args.n_threads);
+  }
+ std::cout << "Threads: " << ThreadPool::n_threads() << std::endl;
+
+ bool all_passed = true;
+ for (unsigned i = 0; i < grid_sizes.size(); i++)
+  {
+   const bool passed = benchmark_grid(grid_sizes[i], args.maximum_iterations, args.restart);
+   output_test << grid_sizes[i] * grid_sizes[i] << " " << passed << std::endl;
+   all_passed = all_passed && passed;
+  }
+
+ // Dense matrices, resolve and the error when not converged
+ const bool passed_dense = check_dense_and_resolve(12);
+ const bool passed_not_converged = check_not_converged(20);
+ std::cout << "Dense and resolve: " << passed_dense << std::endl
+           << "Not converged: " << passed_not_converged << std::endl;
+ output_test << passed_dense << " " << passed_not_converged << std::endl;
+ all_passed = all_passed && passed_dense && passed_not_converged;
+
+ // The mat-vecs, dot products and axpys split among several threads
+ // (even with small sizes)
+ const unsigned n_threads = ThreadPool::n_threads();
+ const unsigned long serial_threshold = ThreadPool::serial_threshold();
+ ThreadPool::set_n_threads(4);
+ ThreadPool::set_serial_threshold(1);
+ const bool passed_threads = benchmark_grid(20, args.maximum_iterations, args.restart) &&
+  check_dense_and_resolve(12);
+ ThreadPool::set_n_threads(n_threads);
+ ThreadPool::set_serial_threshold(serial_threshold);
+
+ std::cout << "Four threads: " << passed_threads << std::endl;
+ output_test << passed_threads << std::endl;
+ all_passed = all_passed && passed_threads;
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The Krylov solvers did not pass the checks" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
@@ -0,0 +1,340 @@
+// IN THIS FILE: Benchmark of the solution of many right-hand sides
+// with one factorisation. The blocked LU solver (CCBlockedLUSolver)
+// and the Cholesky solver (CCCholeskySolver) solve the right-hand
+// sides column by column with resolve() of vectors, and all at once
+// with resolve() of a matrix (blocked forward and backward
+// substitutions). The times and the backward errors are reported,
+// the solutions stored by rows and by columns are checked to be the
+// same
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The classes to create matrices and vectors
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+// The linear solvers
+#include "../../../src/linear_solvers/cc_factory_linear_solver.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > sizes;
+ argparse::ArgValue<unsigned long> n_rhs;
+ argparse::ArgValue<unsigned> n_threads;
+};
+
+// ==================================================================
+// Seconds elapsed since the given times, the wall time if it is large
+// enough to be measured (the substitutions run in several threads),
+// otherwise the cpu time
+// ==================================================================
+double seconds_since(clock_t initial_clock_time, time_t initial_wall_time)
+{
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ time_t final_wall_time = Timing::wall_time();
+ const double wall_seconds = Timing::diff_wall_time(initial_wall_time, final_wall_time);
+ if (wall_seconds > 1.0)
+  {
+   return wall_seconds;
+  }
+ return Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+}
+
+// ==================================================================
+// A non-symmetric matrix with no dominant diagonal, thus the LU
+// factorisation needs row interchanges
+// ==================================================================
+void fill_general_matrix(CCMatrix<Real> &A)
+{
+ const unsigned long n = A.n_rows();
+ for (unsigned long i = 0; i < n; i++)
+  {
+   for (unsigned long j = 0; j < n; j++)
+    {
+     A(i, j) = std::sin(Real((i + 1) * (j + 2) % 97) + 0.3 * Real(i) - 0.7 * Real(j));
+    }
+  }
+}
+
+// ==================================================================
+// A symmetric positive definite matrix, the Toeplitz matrix 1 / (1 +
+// |i - j|) (positive definite since the sequence is convex and
+// decreasing) plus the identity
+// ==================================================================
+void fill_positive_definite_matrix(CCMatrix<Real> &A)
+{
+ const unsigned long n = A.n_rows();
+ for (unsigned long i = 0; i < n; i++)
+  {
+   for (unsigned long j = 0; j < n; j++)
+    {
+     const unsigned long distance = i > j ? i - j : j - i;
+     A(i, j) = Real(1) / Real(1 + distance) + (i == j ? 1.0 : 0.0);
+    }
+  }
+}
+
+// ==================================================================
+// The right-hand sides, smooth functions of different frequencies as
+// those of the evaluation of interpolants
+// ==================================================================
+void fill_right_hand_sides(CCMatrix<Real> &B)
+{
+ const unsigned long n = B.n_rows();
+ const unsigned long n_rhs = B.n_columns();
+ for (unsigned long i = 0; i < n; i++)
+  {
+   for (unsigned long j = 0; j < n_rhs; j++)
+    {
+     B(i, j) = std::cos(Real(i) * Real(j + 1) / Real(n)) + 0.1 * Real(j % 5);
+    }
+  }
+}
+
+// ==================================================================
+// The largest normwise backward error of the solutions X of A X = B,
+// |b - A x| / (|A| |x| + |b|) in the infinity norm for each column
+// ==================================================================
+Real backward_error(const CCMatrix<Real> &A, const CCMatrix<Real> &X,
+                    const CCMatrix<Real> &B)
+{
+ const unsigned long n = A.n_rows();
+ const unsigned long n_rhs = B.n_columns();
+ Real norm_A = 0.0;
+ for (unsigned long i = 0; i < n; i++)
+  {
+   Real sum = 0.0;
+   for (unsigned long j = 0; j < n; j++)
+    {
+     sum+= std::fabs(A(i, j));
+    }
+   norm_A = std::max(norm_A, sum);
+  }
+
+ Real error = 0.0;
+ std::vector<Real> r(n);
+ for (unsigned long k = 0; k < n_rhs; k++)
+  {
+   Real norm_r = 0.0;
+   Real norm_x = 0.0;
+   Real norm_b = 0.0;
+   for (unsigned long i = 0; i < n; i++)
+    {
+     Real r_i = B(i, k);
+     for (unsigned long j = 0; j < n; j++)
+      {
+       r_i-= A(i, j) * X(j, k);
+      }
+     norm_r = std::max(norm_r, Real(std::fabs(r_i)));
+     norm_x = std::max(norm_x, Real(std::fabs(X(i, k))));
+     norm_b = std::max(norm_b, Real(std::fabs(B(i, k))));
+    }
+   error = std::max(error, norm_r / (norm_A * norm_x + norm_b));
+  }
+ return error;
+}
+
+// ==================================================================
+// Is the backward error within the expected roundings of a stable
+// factorisation
+// ==================================================================
+bool is_accurate(const Real error, const unsigned long n)
+{
+ return error <= 10.0 * Real(n) * std::numeric_limits<Real>::epsilon();
+}
+
+// ==================================================================
+// Solves the n_rhs right-hand sides with the factorised solver,
+// column by column and all at once into solutions stored by rows and
+// by columns. Returns true if all the solutions are accurate and the
+// ones stored by rows and by columns are the same
+// ==================================================================
+bool benchmark_right_hand_sides(const std::string &name,
+                                ACDirectLinearSolver &solver,
+                                const CCMatrix<Real> &A,
+                                const unsigned long n_rhs)
+{
+ const unsigned long n = A.n_rows();
+ CCMatrix<Real> B(n, n_rhs);
+ fill_right_hand_sides(B);
+
+ // Column by column
+ CCMatrix<Real> X_columns(n, n_rhs);
+ CCVector<Real> b(n);
+ CCVector<Real> x(n);
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ time_t initial_wall_time = Timing::wall_time();
+ for (unsigned long k = 0; k < n_rhs; k++)
+  {
+   for (unsigned long i = 0; i < n; i++)
+    {
+     b(i) = B(i, k);
+    }
+   solver.resolve(&b, &x);
+   for (unsigned long i = 0; i < n; i++)
+    {
+     X_columns(i, k) = x(i);
+    }
+  }
+ const double seconds_columns = seconds_since(initial_clock_time, initial_wall_time);
+
+ // All at once, solved in the memory of the solution
+ CCMatrix<Real> X_rows(n, n_rhs);
+ initial_clock_time = Timing::cpu_clock_time();
+ initial_wall_time = Timing::wall_time();
+ solver.resolve(&B, &X_rows);
+ const double seconds_block = seconds_since(initial_clock_time, initial_wall_time);
+
+ // All at once, the solution stored by columns
+ CCMatrix<Real> X_by_columns(n, n_rhs);
+ X_by_columns.set_column_major(true);
+ solver.resolve(&B, &X_by_columns);
+ bool same_solutions = true;
+ for (unsigned long i = 0; i < n; i++)
+  {
+   for (unsigned long k = 0; k < n_rhs; k++)
+    {
+     same_solutions = same_solutions && X_by_columns(i, k) == X_rows(i, k);
+    }
+  }
+
+ const Real error_columns = backward_error(A, X_columns, B);
+ const Real error_block = backward_error(A, X_rows, B);
+
+ std::cout << "  " << name << ":\n"
+           << "    column by column: " << std::setw(10) << seconds_columns
+           << " s (backward error " << error_columns << ")\n"
+           << "    all at once:      " << std::setw(10) << seconds_block
+           << " s (backward error " << error_block << ", same by columns "
+           << same_solutions << ")" << std::endl;
+
+ return is_accurate(error_columns, n) && is_accurate(error_block, n) && same_solutions;
+}
+
+// ==================================================================
+// Factorises the matrices of size n with the blocked LU solver and
+// the Cholesky solver (with panels of block_size columns) and solves
+// n_rhs right-hand sides. Returns true if both solvers pass the checks
+// ==================================================================
+bool benchmark(const unsigned long n, const unsigned long n_rhs,
+               const unsigned long block_size)
+{
+ std::cout << std::setw(6) << n << " rows, " << n_rhs << " right-hand sides" << std::endl;
+
+ CCMatrix<Real> A_general(n, n);
+ fill_general_matrix(A_general);
+ CCBlockedLUSolver lu_solver;
+ lu_solver.factorise(&A_general);
+ const bool passed_lu = benchmark_right_hand_sides("blocked lu", lu_solver, A_general, n_rhs);
+
+ CCMatrix<Real> A_positive_definite(n, n);
+ fill_positive_definite_matrix(A_positive_definite);
+ CCCholeskySolver cholesky_solver;
+ cholesky_solver.set_block_size(block_size);
+ cholesky_solver.factorise(&A_positive_definite);
+ const bool passed_cholesky =
+  benchmark_right_hand_sides("cholesky", cholesky_solver, A_positive_definite, n_rhs);
+
+ return passed_lu && passed_cholesky;
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the solution of many right-hand sides");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.sizes, "--sizes")
+  .help("Number of rows of the matrices")
+  .nargs('+')
+  .default_value({"500", "1000", "2000"});
+
+ parser.add_argument(args.n_rhs, "--n_rhs")
+  .help("Number of right-hand sides")
+  .default_value("200");
+
+ parser.add_argument(args.n_threads, "--n_threads")
+  .help("Number of threads used by the substitutions (0 for the number of hardware threads)")
+  .default_value("0");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ std::vector<unsigned long> sizes = args.sizes.value();
+ unsigned long n_rhs = args.n_rhs;
+ if (args.test)
+  {
+   sizes.clear();
+   sizes.push_back(50);
+   sizes.push_back(150);
+   n_rhs = 37;
+  }
+
+ if (args.n_threads > 0)
+  {
+   ThreadPool::set_n_threads(args.n_threads);
+  }
+ std::cout << "Threads: " << ThreadPool::n_threads() << std::endl;
+
+ bool all_passed = true;
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   const bool passed = benchmark(sizes[i], n_rhs, 64);
+   output_test << sizes[i] << " " << passed << std::endl;
+   all_passed = all_passed && passed;
+  }
+
+ // A single right-hand side, and small panels such that the last one
+ // is not complete
+ const bool passed_small_blocks = benchmark(150, 1, 16) && benchmark(150, 37, 16);
+ std::cout << "Small blocks: " << passed_small_blocks << std::endl;
+ output_test << passed_small_blocks << std::endl;
+ all_passed = all_passed && passed_small_blocks;
+
+ // The right-hand sides split among several threads (even with small
+ // sizes)
+ const unsigned n_threads = ThreadPool::n_threads();
+ const unsigned long serial_threshold = ThreadPool::serial_threshold();
+ ThreadPool::set_n_threads(4);
+ ThreadPool::set_serial_threshold(1);
+ const bool passed_threads = benchmark(150, 37, 16);
+ ThreadPool::set_n_threads(n_threads);
+ ThreadPool::set_serial_threshold(serial_threshold);
+
+ std::cout << "Four threads: " << passed_threads << std::endl;
+ output_test << passed_threads << std::endl;
+ all_passed = all_passed && passed_threads;
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The solution of many right-hand sides did not pass the checks" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
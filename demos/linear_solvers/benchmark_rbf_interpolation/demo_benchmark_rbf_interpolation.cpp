@@ -0,0 +1,273 @@
+// IN THIS FILE: Benchmark of the symmetric packed storage for the
+// interpolation matrices of radial basis functions (RBF). Franke's
+// function is interpolated at scattered points (Halton sequence) with
+// the Gaussian RBF as in Program 2.1 of "Meshfree Approximation
+// Methods with MATLAB, G. E. Fasshauer". The interpolation matrix is
+// assembled as a full dense matrix and solved by LU (the previous
+// path), and assembled in packed storage (only i <= j) and solved by
+// the Cholesky factorisation. Both interpolants are evaluated at a
+// grid of points and compared
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The classes to create matrices and vectors
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+#include "../../../src/matrices/cc_symmetric_matrix.h"
+// The linear solvers
+#include "../../../src/linear_solvers/cc_factory_linear_solver.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > sizes;
+ argparse::ArgValue<Real> epsilon;
+};
+
+// ==================================================================
+// The Gaussian RBF, psi(r) = exp(-(epsilon r)^2)
+// ==================================================================
+class Gaussian
+{
+public:
+ Gaussian(const Real epsilon) : Epsilon(epsilon) { }
+ const Real psi(const Real r) {return std::exp(-(Epsilon*r)*(Epsilon*r));}
+protected:
+ Real Epsilon;
+};
+
+// ==================================================================
+// Franke's function (2D version)
+// ==================================================================
+Real franke(const Real x, const Real y)
+{
+ const Real f1 = 0.75 * std::exp(-0.25*((9*x-2)*(9*x-2)+((9*y-2)*(9*y-2))));
+ const Real f2 = 0.75 * std::exp((-(1.0/49.0)*((9*x+1)*(9*x+1)))-((1.0/10.0)*((9*y+1)*(9*y+1))));
+ const Real f3 = 0.50 * std::exp(-0.25*((9*x-7)*(9*x-7)+((9*y-3)*(9*y-3))));
+ const Real f4 = 0.20 * std::exp(-((9*x-4)*(9*x-4)+(9*y-7)*(9*y-7)));
+ return f1 + f2 + f3 - f4;
+}
+
+// ==================================================================
+// The i-th entry of the van der Corput sequence in the given base
+// ==================================================================
+Real van_der_corput(unsigned long i, const unsigned long base)
+{
+ Real value = 0.0;
+ Real fraction = 1.0 / Real(base);
+ while (i > 0)
+  {
+   value+= Real(i % base) * fraction;
+   i/= base;
+   fraction/= Real(base);
+  }
+ return value;
+}
+
+// ==================================================================
+// Seconds elapsed since the given time
+// ==================================================================
+double seconds_since(clock_t initial_clock_time)
+{
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ return Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+}
+
+// ==================================================================
+// Evaluates the interpolant with coefficients c at the evaluation
+// points, returns the maximum error with respect to Franke's
+// function
+// ==================================================================
+Real evaluate(const CCMatrix<Real> &nodes, const CCVector<Real> &c,
+              const CCMatrix<Real> &evaluation_points, Gaussian &rbf,
+              std::vector<Real> &values)
+{
+ const unsigned long n_nodes = nodes.n_columns();
+ const unsigned long n_points = evaluation_points.n_columns();
+ values.resize(n_points);
+ Real max_error = 0.0;
+ for (unsigned long p = 0; p < n_points; p++)
+  {
+   const Real x = evaluation_points(0, p);
+   const Real y = evaluation_points(1, p);
+   Real sum = 0.0;
+   for (unsigned long j = 0; j < n_nodes; j++)
+    {
+     const Real dx = x - nodes(0, j);
+     const Real dy = y - nodes(1, j);
+     sum+= c(j) * rbf.psi(std::sqrt(dx*dx + dy*dy));
+    }
+   values[p] = sum;
+   max_error = std::max(max_error, Real(std::fabs(sum - franke(x, y))));
+  }
+ return max_error;
+}
+
+// ==================================================================
+// Interpolates Franke's function at n nodes with both paths. Returns
+// true if both matrices store the same entries and both interpolants
+// are the same (up to the rounding of the solvers)
+// ==================================================================
+bool benchmark(const unsigned long n, const Real epsilon, std::ofstream &output_test)
+{
+ // The nodes, each column stores the position of a node
+ CCMatrix<Real> nodes(2, n);
+ CCVector<Real> rhs(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   nodes(0, i) = van_der_corput(i + 1, 2);
+   nodes(1, i) = van_der_corput(i + 1, 3);
+   rhs(i) = franke(nodes(0, i), nodes(1, i));
+  }
+ Gaussian rbf(epsilon);
+ CCFactoryLinearSolver factory;
+
+ // Dense assembly (all the n^2 entries) and LU
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ CCMatrix<Real> A_dense(n, n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   for (unsigned long j = 0; j < n; j++)
+    {
+     const Real dx = nodes(0, i) - nodes(0, j);
+     const Real dy = nodes(1, i) - nodes(1, j);
+     A_dense(i, j) = rbf.psi(std::sqrt(dx*dx + dy*dy));
+    }
+  }
+ const double seconds_dense_assembly = seconds_since(initial_clock_time);
+ CCVector<Real> c_dense;
+ ACLinearSolver *lu_pt = factory.create_linear_solver("numerical_recipes");
+ initial_clock_time = Timing::cpu_clock_time();
+ lu_pt->solve(&A_dense, &rhs, &c_dense);
+ const double seconds_lu = seconds_since(initial_clock_time);
+ delete lu_pt;
+
+ // Packed assembly (only i <= j) and Cholesky
+ initial_clock_time = Timing::cpu_clock_time();
+ CCSymmetricMatrix<Real> A_packed;
+ compute_interpolation_matrix(nodes, rbf, A_packed);
+ const double seconds_packed_assembly = seconds_since(initial_clock_time);
+ CCVector<Real> c_packed;
+ ACLinearSolver *cholesky_pt = factory.create_linear_solver("cholesky");
+ initial_clock_time = Timing::cpu_clock_time();
+ cholesky_pt->solve(&A_packed, &rhs, &c_packed);
+ const double seconds_cholesky = seconds_since(initial_clock_time);
+ delete cholesky_pt;
+
+ // Both matrices store the same entries
+ bool same_entries = true;
+ for (unsigned long i = 0; i < n && same_entries; i++)
+  {
+   for (unsigned long j = 0; j < n && same_entries; j++)
+    {
+     same_entries = A_dense(i, j) == A_packed(i, j);
+    }
+  }
+
+ // Evaluate both interpolants in a grid
+ const unsigned long n_per_dimension = 40;
+ CCMatrix<Real> evaluation_points(2, n_per_dimension*n_per_dimension);
+ for (unsigned long i = 0; i < n_per_dimension; i++)
+  {
+   for (unsigned long j = 0; j < n_per_dimension; j++)
+    {
+     evaluation_points(0, i*n_per_dimension + j) = Real(i) / Real(n_per_dimension - 1);
+     evaluation_points(1, i*n_per_dimension + j) = Real(j) / Real(n_per_dimension - 1);
+    }
+  }
+ std::vector<Real> values_dense;
+ std::vector<Real> values_packed;
+ const Real error_dense = evaluate(nodes, c_dense, evaluation_points, rbf, values_dense);
+ const Real error_packed = evaluate(nodes, c_packed, evaluation_points, rbf, values_packed);
+ Real max_difference = 0.0;
+ for (unsigned long p = 0; p < values_dense.size(); p++)
+  {
+   max_difference = std::max(max_difference, Real(std::fabs(values_dense[p] - values_packed[p])));
+  }
+
+ const unsigned long bytes_dense = n * n * sizeof(Real);
+ const unsigned long bytes_packed = A_packed.n_packed_values() * sizeof(Real);
+ std::cout << std::setw(7) << n << " dense: assembly " << std::setw(10) << seconds_dense_assembly
+           << " s lu " << std::setw(10) << seconds_lu << " s " << std::setw(11) << bytes_dense
+           << " bytes" << std::endl;
+ std::cout << std::setw(7) << " " << " packed: assembly " << std::setw(9) << seconds_packed_assembly
+           << " s cholesky " << std::setw(10) << seconds_cholesky << " s " << std::setw(11)
+           << bytes_packed << " bytes" << std::endl;
+ std::cout << std::setw(7) << " " << " max error dense: " << error_dense
+           << " packed: " << error_packed
+           << " max difference: " << max_difference << std::endl;
+
+ // Both interpolants are the same up to the rounding of the solvers
+ // (the Gaussian matrices are ill-conditioned, the difference is
+ // measured in the interpolant instead of the coefficients)
+ const bool passed = same_entries && max_difference <= 1.0e-6;
+ output_test << n << " " << A_packed.n_packed_values() << " " << same_entries
+             << " " << passed << std::endl;
+ return passed;
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the packed storage for RBF interpolation matrices");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.sizes, "--sizes")
+  .help("Number of nodes")
+  .nargs('+')
+  .default_value({"289", "1089", "2000"});
+
+ parser.add_argument<Real>(args.epsilon, "--epsilon")
+  .help("Shape parameter of the Gaussian RBF")
+  .default_value("21.1");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ std::vector<unsigned long> sizes = args.sizes.value();
+ if (args.test)
+  {
+   sizes.clear();
+   sizes.push_back(81);
+   sizes.push_back(289);
+  }
+
+ bool all_passed = true;
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   all_passed = benchmark(sizes[i], args.epsilon, output_test) && all_passed;
+  }
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The interpolants computed with the packed storage are not accurate" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
@@ -0,0 +1,368 @@
+// IN THIS FILE: Benchmark of the solvers for symmetric matrices, the
+// Cholesky solver (CCCholeskySolver) for positive definite matrices
+// and the LDL^T solver with Bunch-Kaufman pivoting (CCLDLTSolver) for
+// indefinite ones, against the blocked LU solver. The matrices are
+// given in packed storage (CCSymmetricMatrix) and as dense matrices
+// (CCMatrix), the time of the factorisations and the backward error
+// of the solutions are reported. The inertia given by LDL^T, resolve()
+// with a second right-hand side and the rejection of an indefinite
+// matrix by the Cholesky solver are also checked
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The classes to create matrices and vectors
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+#include "../../../src/matrices/cc_symmetric_matrix.h"
+// The linear solvers
+#include "../../../src/linear_solvers/cc_factory_linear_solver.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > sizes;
+ argparse::ArgValue<unsigned long> block_size;
+ argparse::ArgValue<unsigned> n_threads;
+};
+
+// ==================================================================
+// Seconds elapsed since the given times, the wall time if it is large
+// enough to be measured (the updates run in several threads),
+// otherwise the cpu time
+// ==================================================================
+double seconds_since(clock_t initial_clock_time, time_t initial_wall_time)
+{
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ time_t final_wall_time = Timing::wall_time();
+ const double wall_seconds = Timing::diff_wall_time(initial_wall_time, final_wall_time);
+ if (wall_seconds > 1.0)
+  {
+   return wall_seconds;
+  }
+ return Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+}
+
+// ==================================================================
+// A symmetric positive definite matrix, the Toeplitz matrix 1 / (1 +
+// |i - j|) (positive definite since the sequence is convex and
+// decreasing) plus the identity
+// ==================================================================
+void fill_positive_definite_matrix(CCMatrix<Real> &A)
+{
+ const unsigned long n = A.n_rows();
+ for (unsigned long i = 0; i < n; i++)
+  {
+   for (unsigned long j = 0; j < n; j++)
+    {
+     const unsigned long distance = i > j ? i - j : j - i;
+     A(i, j) = Real(1) / Real(1 + distance) + (i == j ? 1.0 : 0.0);
+    }
+  }
+}
+
+// ==================================================================
+// A symmetric indefinite matrix with a zero diagonal, thus the
+// diagonal pivots alone fail and 2 X 2 blocks are needed
+// ==================================================================
+void fill_indefinite_matrix(CCMatrix<Real> &A)
+{
+ const unsigned long n = A.n_rows();
+ for (unsigned long i = 0; i < n; i++)
+  {
+   for (unsigned long j = i; j < n; j++)
+    {
+     const Real value = i == j ? 0.0 : std::sin(Real((i + 1) * (j + 1) % 101) + 0.5 * Real(i + j));
+     A(i, j) = value;
+     A(j, i) = value;
+    }
+  }
+}
+
+// ==================================================================
+// The normwise backward error of the solution x of A x = b,
+// |b - A x| / (|A| |x| + |b|) in the infinity norm
+// ==================================================================
+Real backward_error(const CCMatrix<Real> &A, const CCVector<Real> &x,
+                    const CCVector<Real> &b)
+{
+ const unsigned long n = A.n_rows();
+ Real norm_A = 0.0;
+ Real norm_r = 0.0;
+ Real norm_x = 0.0;
+ Real norm_b = 0.0;
+ for (unsigned long i = 0; i < n; i++)
+  {
+   Real sum = 0.0;
+   Real r_i = b(i);
+   for (unsigned long j = 0; j < n; j++)
+    {
+     sum+= std::fabs(A(i, j));
+     r_i-= A(i, j) * x(j);
+    }
+   norm_A = std::max(norm_A, sum);
+   norm_r = std::max(norm_r, Real(std::fabs(r_i)));
+   norm_x = std::max(norm_x, Real(std::fabs(x(i))));
+   norm_b = std::max(norm_b, Real(std::fabs(b(i))));
+  }
+ return norm_r / (norm_A * norm_x + norm_b);
+}
+
+// ==================================================================
+// Is the backward error within the expected roundings of a stable
+// factorisation
+// ==================================================================
+bool is_accurate(const Real error, const unsigned long n)
+{
+ return error <= 10.0 * Real(n) * std::numeric_limits<Real>::epsilon();
+}
+
+// ==================================================================
+// Solves the positive definite system of size n with the Cholesky
+// solver (packed and dense input), the LDL^T solver (both with panels
+// of block_size columns) and the blocked LU solver. Returns true if the
+// solutions are accurate, the ones of the packed and dense inputs are
+// the same and the inertia is (n, 0)
+// ==================================================================
+bool benchmark_positive_definite(const unsigned long n, const unsigned long block_size)
+{
+ CCMatrix<Real> A(n, n);
+ fill_positive_definite_matrix(A);
+ CCSymmetricMatrix<Real> A_packed;
+ A_packed.set_matrix(A.matrix_pt(), n, n);
+ CCVector<Real> b(n);
+ CCVector<Real> b2(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   b(i) = 1.0 + 0.5 * std::cos(Real(i));
+   b2(i) = Real(i % 7) - 3.0;
+  }
+
+ CCFactoryLinearSolver factory;
+
+ // Cholesky with the packed matrix, and resolve with a second
+ // right-hand side
+ ACLinearSolver *cholesky_pt = factory.create_linear_solver("cholesky");
+ CCCholeskySolver *cholesky_solver_pt = dynamic_cast<CCCholeskySolver*>(cholesky_pt);
+ cholesky_solver_pt->set_block_size(block_size);
+ CCVector<Real> x_cholesky;
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ time_t initial_wall_time = Timing::wall_time();
+ cholesky_solver_pt->factorise(&A_packed);
+ const double seconds_cholesky = seconds_since(initial_clock_time, initial_wall_time);
+ cholesky_solver_pt->resolve(&b, &x_cholesky);
+ const Real error_cholesky = backward_error(A, x_cholesky, b);
+ CCVector<Real> x2_cholesky;
+ cholesky_solver_pt->resolve(&b2, &x2_cholesky);
+ const Real error_resolve = backward_error(A, x2_cholesky, b2);
+
+ // Cholesky with the dense matrix, only its upper triangle is read
+ CCVector<Real> x_dense;
+ cholesky_pt->solve(&A, &b, &x_dense);
+ delete cholesky_pt;
+ bool same_solutions = true;
+ for (unsigned long i = 0; i < n; i++)
+  {
+   same_solutions = same_solutions && x_dense(i) == x_cholesky(i);
+  }
+
+ // LDL^T with the packed matrix
+ CCLDLTSolver ldlt_solver;
+ ldlt_solver.set_block_size(block_size);
+ CCVector<Real> x_ldlt;
+ initial_clock_time = Timing::cpu_clock_time();
+ initial_wall_time = Timing::wall_time();
+ ldlt_solver.factorise(&A_packed);
+ const double seconds_ldlt = seconds_since(initial_clock_time, initial_wall_time);
+ ldlt_solver.resolve(&b, &x_ldlt);
+ const Real error_ldlt = backward_error(A, x_ldlt, b);
+ unsigned long n_positive = 0;
+ unsigned long n_negative = 0;
+ ldlt_solver.inertia(n_positive, n_negative);
+
+ // Blocked LU with the dense matrix
+ CCBlockedLUSolver lu_solver;
+ CCVector<Real> x_lu;
+ initial_clock_time = Timing::cpu_clock_time();
+ initial_wall_time = Timing::wall_time();
+ lu_solver.factorise(&A);
+ const double seconds_lu = seconds_since(initial_clock_time, initial_wall_time);
+ lu_solver.resolve(&b, &x_lu);
+ const Real error_lu = backward_error(A, x_lu, b);
+
+ std::cout << std::setw(6) << n << " positive definite\n"
+           << "  cholesky: " << std::setw(10) << seconds_cholesky
+           << " s (backward error " << error_cholesky << ", resolve " << error_resolve << ")\n"
+           << "  ldlt:     " << std::setw(10) << seconds_ldlt
+           << " s (backward error " << error_ldlt << ", inertia " << n_positive
+           << " " << n_negative << ")\n"
+           << "  blocked lu (dense): " << std::setw(10) << seconds_lu
+           << " s (backward error " << error_lu << ")" << std::endl;
+
+ return is_accurate(error_cholesky, n) && is_accurate(error_resolve, n) &&
+  is_accurate(error_ldlt, n) && is_accurate(error_lu, n) && same_solutions &&
+  n_positive == n && n_negative == 0;
+}
+
+// ==================================================================
+// Solves the indefinite system of size n with the LDL^T solver (dense
+// input, panels of block_size columns) and the blocked LU
+// solver. Returns true if the solutions are accurate, the inertia has
+// positive and negative eigenvalues and the Cholesky solver rejects
+// the matrix
+// ==================================================================
+bool benchmark_indefinite(const unsigned long n, const unsigned long block_size)
+{
+ CCMatrix<Real> A(n, n);
+ fill_indefinite_matrix(A);
+ CCVector<Real> b(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   b(i) = 1.0 + 0.5 * std::cos(Real(i));
+  }
+
+ CCLDLTSolver ldlt_solver;
+ ldlt_solver.set_block_size(block_size);
+ CCVector<Real> x_ldlt;
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ time_t initial_wall_time = Timing::wall_time();
+ ldlt_solver.factorise(&A);
+ const double seconds_ldlt = seconds_since(initial_clock_time, initial_wall_time);
+ ldlt_solver.resolve(&b, &x_ldlt);
+ const Real error_ldlt = backward_error(A, x_ldlt, b);
+ unsigned long n_positive = 0;
+ unsigned long n_negative = 0;
+ ldlt_solver.inertia(n_positive, n_negative);
+
+ CCBlockedLUSolver lu_solver;
+ CCVector<Real> x_lu;
+ initial_clock_time = Timing::cpu_clock_time();
+ initial_wall_time = Timing::wall_time();
+ lu_solver.factorise(&A);
+ const double seconds_lu = seconds_since(initial_clock_time, initial_wall_time);
+ lu_solver.resolve(&b, &x_lu);
+ const Real error_lu = backward_error(A, x_lu, b);
+
+ bool cholesky_rejected = false;
+ CCCholeskySolver cholesky_solver;
+ try
+  {
+   cholesky_solver.factorise(&A);
+  }
+ catch (const SciCellxxLibError &error)
+  {
+   cholesky_rejected = true;
+  }
+
+ std::cout << std::setw(6) << n << " indefinite\n"
+           << "  ldlt:     " << std::setw(10) << seconds_ldlt
+           << " s (backward error " << error_ldlt << ", inertia " << n_positive
+           << " " << n_negative << ")\n"
+           << "  blocked lu (dense): " << std::setw(10) << seconds_lu
+           << " s (backward error " << error_lu << ")\n"
+           << "  rejected by cholesky: " << cholesky_rejected << std::endl;
+
+ return is_accurate(error_ldlt, n) && is_accurate(error_lu, n) &&
+  n_positive + n_negative == n && n_positive > 0 && n_negative > 0 &&
+  cholesky_rejected;
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the solvers for symmetric matrices");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.sizes, "--sizes")
+  .help("Number of rows of the matrices")
+  .nargs('+')
+  .default_value({"500", "1000", "2000", "4000"});
+
+ parser.add_argument(args.block_size, "--block_size")
+  .help("Number of columns of the panels of the Cholesky and LDL^T solvers")
+  .default_value("64");
+
+ parser.add_argument(args.n_threads, "--n_threads")
+  .help("Number of threads used by the updates (0 for the number of hardware threads)")
+  .default_value("0");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ std::vector<unsigned long> sizes = args.sizes.value();
+ if (args.test)
+  {
+   sizes.clear();
+   sizes.push_back(50);
+   sizes.push_back(301);
+  }
+
+ if (args.n_threads > 0)
+  {
+   ThreadPool::set_n_threads(args.n_threads);
+  }
+ std::cout << "Threads: " << ThreadPool::n_threads() << std::endl;
+
+ bool all_passed = true;
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   const bool passed_positive_definite = benchmark_positive_definite(sizes[i], args.block_size);
+   const bool passed_indefinite = benchmark_indefinite(sizes[i], args.block_size);
+   output_test << sizes[i] << " " << passed_positive_definite << " "
+               << passed_indefinite << std::endl;
+   all_passed = all_passed && passed_positive_definite && passed_indefinite;
+  }
+
+ // Small panels such that the last one is not complete
+ const bool passed_small_blocks = benchmark_positive_definite(301, 16) &&
+  benchmark_indefinite(301, 16);
+ std::cout << "Small blocks: " << passed_small_blocks << std::endl;
+ output_test << passed_small_blocks << std::endl;
+ all_passed = all_passed && passed_small_blocks;
+
+ // The updates of Cholesky and LDL^T split among several threads
+ // (even with small sizes)
+ const unsigned n_threads = ThreadPool::n_threads();
+ const unsigned long serial_threshold = ThreadPool::serial_threshold();
+ ThreadPool::set_n_threads(4);
+ ThreadPool::set_serial_threshold(1);
+ const bool passed_threads = benchmark_positive_definite(120, 16) && benchmark_indefinite(120, 16);
+ ThreadPool::set_n_threads(n_threads);
+ ThreadPool::set_serial_threshold(serial_threshold);
+
+ std::cout << "Four threads: " << passed_threads << std::endl;
+ output_test << passed_threads << std::endl;
+ all_passed = all_passed && passed_threads;
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The solvers for symmetric matrices did not pass the checks" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
@@ -0,0 +1,115 @@
+#include <iostream>
+#include <cmath>
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+
+// The class to create vectors and matrices
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+
+using namespace scicellxx;
+
+// -------------------------------------------------------------------
+// 1 - Show element-wise operations of vectors by means of expression
+// templates (a + b - c, u + h*k)
+// 2 - Show element-wise operations of matrices by means of expression
+// templates (2*A + B - A*0.5)
+// 3 - Show that the result may be stored in one of the operands
+// -------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+ 
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+ 
+ // =============================================================
+ // Vector expressions
+ // =============================================================
+ const unsigned long n_values = 6;
+ CCVector<Real> a(n_values);
+ CCVector<Real> b(n_values);
+ CCVector<Real> c(n_values);
+ for (unsigned long i = 0; i < n_values; i++)
+  {
+   a(i) = i + 1;
+   b(i) = 2.0 * i;
+   c(i) = 0.5 * i * i;
+  }
+ 
+ // The expression is evaluated in a single loop when constructing d
+ CCVector<Real> d = a + b - c;
+ std::cout << std::endl << "a + b - c" << std::endl << std::endl;
+ output_test << std::endl << "a + b - c" << std::endl << std::endl;
+ d.output();
+ d.output(output_test);
+ 
+ // An explicit Euler-like update, u = u + h*k, the result is stored
+ // in one of the operands
+ const Real h = 0.1;
+ CCVector<Real> u(a);
+ u = u + h*b;
+ std::cout << std::endl << "u = u + h*b" << std::endl << std::endl;
+ output_test << std::endl << "u = u + h*b" << std::endl << std::endl;
+ u.output();
+ u.output(output_test);
+ 
+ // Accumulate and substract expressions
+ u+= 2*a - b*h;
+ u-= c;
+ std::cout << std::endl << "u+= 2*a - b*h; u-= c" << std::endl << std::endl;
+ output_test << std::endl << "u+= 2*a - b*h; u-= c" << std::endl << std::endl;
+ u.output();
+ u.output(output_test);
+ 
+ // Assign to an empty vector
+ CCVector<Real> e;
+ e = 0.5 * (a + b);
+ std::cout << std::endl << "e = 0.5 * (a + b)" << std::endl << std::endl;
+ output_test << std::endl << "e = 0.5 * (a + b)" << std::endl << std::endl;
+ e.output();
+ e.output(output_test);
+ 
+ // =============================================================
+ // Matrix expressions
+ // =============================================================
+ const unsigned long n_rows = 3;
+ const unsigned long n_columns = 4;
+ CCMatrix<Real> A(n_rows, n_columns);
+ CCMatrix<Real> B(n_rows, n_columns);
+ for (unsigned long i = 0; i < n_rows; i++)
+  {
+   for (unsigned long j = 0; j < n_columns; j++)
+    {
+     A(i,j) = i * n_columns + j;
+     B(i,j) = Real(i) - Real(j);
+    }
+  }
+ 
+ CCMatrix<Real> C = 2.0*A + B - A*0.5;
+ std::cout << std::endl << "2*A + B - A*0.5" << std::endl << std::endl;
+ output_test << std::endl << "2*A + B - A*0.5" << std::endl << std::endl;
+ C.output();
+ C.output(output_test);
+ 
+ // Store the result in one of the operands
+ C = C - B;
+ C+= h*A;
+ std::cout << std::endl << "C = C - B; C+= h*A" << std::endl << std::endl;
+ output_test << std::endl << "C = C - B; C+= h*A" << std::endl << std::endl;
+ C.output();
+ C.output(output_test);
+ 
+ // Close the output for test
+ output_test.close();
+ 
+ // Finalise scicellxx
+ finalise_scicellxx();
+ 
+ return 0;
+ 
+}
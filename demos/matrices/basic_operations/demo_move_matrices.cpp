@@ -0,0 +1,162 @@
+#include <iostream>
+#include <cmath>
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+
+// The class to create vectors and matrices
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+// The class to store data
+#include "../../../src/data_structures/cc_data.h"
+
+using namespace scicellxx;
+
+// -------------------------------------------------------------------
+// Creates a matrix and returns it by value (the memory is transferred
+// to the caller, no copy is performed)
+// -------------------------------------------------------------------
+CCMatrix<Real> create_matrix(const unsigned long n_rows,
+                             const unsigned long n_columns)
+{
+ CCMatrix<Real> matrix(n_rows, n_columns);
+ for (unsigned long i = 0; i < n_rows; i++)
+  {
+   for (unsigned long j = 0; j < n_columns; j++)
+    {
+     matrix(i,j) = i * n_columns + j;
+    }
+  }
+ return matrix;
+}
+
+// -------------------------------------------------------------------
+// 1 - Show move construction and move assignment of matrices
+// 2 - Show move construction and move assignment of vectors
+// 3 - Show move construction and move assignment of data
+// -------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+ 
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+ 
+ // =============================================================
+ // Matrices
+ // =============================================================
+ CCMatrix<Real> A = create_matrix(3, 4);
+ std::cout << std::endl << "Matrix returned by value" << std::endl << std::endl;
+ output_test << std::endl << "Matrix returned by value" << std::endl << std::endl;
+ A.output();
+ A.output(output_test);
+ 
+ // Move construction, A is left empty with no memory
+ const Real *A_entries_pt = A.matrix_pt();
+ CCMatrix<Real> B(std::move(A));
+ std::cout << std::endl << "Moved matrix (memory transferred: "
+           << (B.matrix_pt() == A_entries_pt) << ", source has memory: "
+           << A.is_own_memory_allocated() << ", source size: " << A.n_rows()
+           << " X " << A.n_columns() << ")" << std::endl << std::endl;
+ output_test << std::endl << "Moved matrix (memory transferred: "
+             << (B.matrix_pt() == A_entries_pt) << ", source has memory: "
+             << A.is_own_memory_allocated() << ", source size: " << A.n_rows()
+             << " X " << A.n_columns() << ")" << std::endl << std::endl;
+ B.output();
+ B.output(output_test);
+ 
+ // Move assignment of the result of a product
+ CCMatrix<Real> I(4, 4);
+ I.fill_with_zeroes();
+ for (unsigned long i = 0; i < 4; i++)
+  {
+   I(i,i) = 2.0;
+  }
+ A = B * I;
+ std::cout << std::endl << "Move assigned product" << std::endl << std::endl;
+ output_test << std::endl << "Move assigned product" << std::endl << std::endl;
+ A.output();
+ A.output(output_test);
+ 
+ // A matrix whose memory is not allowed to be deleted by itself is
+ // copied instead
+ B.disable_delete_matrix();
+ const Real *B_entries_pt = B.matrix_pt();
+ CCMatrix<Real> C(std::move(B));
+ std::cout << std::endl << "Moved non-deletable matrix (memory transferred: "
+           << (C.matrix_pt() == B_entries_pt) << ")" << std::endl << std::endl;
+ output_test << std::endl << "Moved non-deletable matrix (memory transferred: "
+             << (C.matrix_pt() == B_entries_pt) << ")" << std::endl << std::endl;
+ C.output();
+ C.output(output_test);
+ 
+ // =============================================================
+ // Vectors
+ // =============================================================
+ CCVector<Real> a(5, false);
+ for (unsigned long i = 0; i < 5; i++)
+  {
+   a(i) = 0.5 * i;
+  }
+ const Real *a_entries_pt = a.vector_pt();
+ CCVector<Real> b(std::move(a));
+ std::cout << std::endl << "Moved vector (memory transferred: "
+           << (b.vector_pt() == a_entries_pt) << ", is column vector: "
+           << b.is_column_vector() << ", source has memory: "
+           << a.is_own_memory_allocated() << ", source size: "
+           << a.n_values() << ")" << std::endl << std::endl;
+ output_test << std::endl << "Moved vector (memory transferred: "
+             << (b.vector_pt() == a_entries_pt) << ", is column vector: "
+             << b.is_column_vector() << ", source has memory: "
+             << a.is_own_memory_allocated() << ", source size: "
+             << a.n_values() << ")" << std::endl << std::endl;
+ b.output();
+ b.output(output_test);
+ 
+ a = std::move(b);
+ std::cout << std::endl << "Move assigned vector" << std::endl << std::endl;
+ output_test << std::endl << "Move assigned vector" << std::endl << std::endl;
+ a.output();
+ a.output(output_test);
+ 
+ // =============================================================
+ // Data
+ // =============================================================
+ CCData u(3, 2);
+ for (unsigned i = 0; i < 3; i++)
+  {
+   u(i,0) = i + 1.0;
+   u(i,1) = -(i + 1.0);
+  }
+ u.pin(1);
+ const Real *u_values_pt = u.values_pt();
+ CCData v(std::move(u));
+ std::cout << std::endl << "Moved data (memory transferred: "
+           << (v.values_pt() == u_values_pt) << ", source is empty: "
+           << u.is_empty() << ", pinned: " << v.is_pinned(1) << ")"
+           << std::endl << std::endl;
+ output_test << std::endl << "Moved data (memory transferred: "
+             << (v.values_pt() == u_values_pt) << ", source is empty: "
+             << u.is_empty() << ", pinned: " << v.is_pinned(1) << ")"
+             << std::endl << std::endl;
+ v.output(true);
+ v.output(output_test, true);
+ 
+ u = std::move(v);
+ std::cout << std::endl << "Move assigned data" << std::endl << std::endl;
+ output_test << std::endl << "Move assigned data" << std::endl << std::endl;
+ u.output(true);
+ u.output(output_test, true);
+ 
+ // Close the output for test
+ output_test.close();
+ 
+ // Finalise scicellxx
+ finalise_scicellxx();
+ 
+ return 0;
+ 
+}
@@ -0,0 +1,164 @@
+// IN THIS FILE: Benchmark of the allocator used for the entries of
+// vectors and matrices. Many short-lived vectors and matrices are
+// created and destroyed (as in the stages of a Runge-Kutta method or
+// the steps of Newton's method), the time per object and the counters
+// of the allocator are reported. The allocations are checked to be
+// balanced and, for the ALIGNED and POOL strategies, to start at a 64
+// bytes boundary
+//
+// The strategy is chosen at configure time with SCICELLXX_ALLOCATOR
+// in the configuration file (NEW, ALIGNED or POOL)
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The classes to create vectors and matrices
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > sizes;
+ argparse::ArgValue<unsigned> repetitions;
+};
+
+// ==================================================================
+// Is the address a multiple of the alignment of the allocator
+// ==================================================================
+bool is_aligned(const void *pt)
+{
+ return reinterpret_cast<std::size_t>(pt) % MemoryAllocator::Alignment == 0;
+}
+
+// ==================================================================
+// Create and destroy vectors of size n and matrices of size n x n.
+// Returns true if the allocations are balanced and (when requested)
+// aligned
+// ==================================================================
+bool benchmark_allocations(const unsigned long n, const unsigned repetitions)
+{
+ MemoryAllocator::reset_statistics();
+ const unsigned long initial_bytes_in_use =
+  MemoryAllocator::statistics().N_bytes_in_use;
+
+ // Only the ALIGNED and POOL strategies guarantee the alignment
+ const bool check_alignment = MemoryAllocator::allocator() != MemoryAllocator::NEW;
+ bool aligned = true;
+
+ // Keep the result such that the compiler does not remove the loop
+ Real sum = 0.0;
+
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned r = 0; r < repetitions; r++)
+  {
+   // The temporaries of a time step
+   CCVector<Real> k1(n);
+   CCVector<Real> k2(n);
+   CCMatrix<Real> jacobian(n, n);
+   k1.fill_with_zeroes();
+   k2(n-1) = Real(r);
+   jacobian(0,0) = Real(r);
+   sum+= k1(0) + k2(n-1) + jacobian(0,0);
+   if (check_alignment)
+    {
+     aligned = aligned && is_aligned(k1.vector_pt()) &&
+      is_aligned(k2.vector_pt()) && is_aligned(jacobian.matrix_pt());
+    }
+  }
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ const double seconds =
+  Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+
+ const MemoryAllocator::Statistics counters = MemoryAllocator::statistics();
+ const bool balanced = counters.N_allocations == counters.N_deallocations &&
+  counters.N_bytes_in_use == initial_bytes_in_use;
+
+ std::cout << "n = " << std::setw(8) << n
+           << " time per time step: " << std::setw(10)
+           << seconds * 1.0e9 / double(repetitions) << " ns"
+           << ", allocations: " << counters.N_allocations
+           << ", system allocations: " << counters.N_system_allocations
+           << ", bytes allocated: " << counters.N_bytes_allocated
+           << ", peak bytes in use: " << counters.Peak_bytes_in_use
+           << " (sum: " << sum << ")" << std::endl;
+
+ return balanced && aligned;
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the allocator for vectors and matrices");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.sizes, "--sizes")
+  .help("Sizes of the vectors (and of the side of the square matrices)")
+  .nargs('+')
+  .default_value({"3", "10", "100", "500"});
+
+ parser.add_argument(args.repetitions, "--repetitions")
+  .help("Number of time steps")
+  .default_value("100000");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ std::vector<unsigned long> sizes = args.sizes.value();
+ unsigned repetitions = args.repetitions;
+ if (args.test)
+  {
+   sizes.clear();
+   sizes.push_back(3);
+   sizes.push_back(50);
+   repetitions = 100;
+  }
+
+ std::cout << "Allocator: "
+           << MemoryAllocator::allocator_name(MemoryAllocator::allocator())
+           << std::endl;
+
+ bool all_passed = true;
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   const unsigned long n = sizes[i];
+   const bool passed = benchmark_allocations(n, repetitions);
+   output_test << n << " " << passed << std::endl;
+   all_passed = all_passed && passed;
+  }
+
+ std::cout << std::endl;
+ MemoryAllocator::output_statistics(std::cout);
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The allocations are not balanced or not aligned" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
@@ -0,0 +1,277 @@
+// IN THIS FILE: Benchmark of the bulk operations (copy, axpy and
+// scale) of ACVector and ACMatrix. The loops that access each entry
+// through the virtual value() methods of the base classes (the
+// previous implementation of the Newton update and of the copies in
+// the LU solver) are compared against the bulk operations, which
+// resolve the span of the memory once and work on raw pointers. The
+// results of both versions are checked to be the same
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The classes to create vectors and matrices
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > sizes;
+ argparse::ArgValue<unsigned> repetitions;
+};
+
+// ==================================================================
+// Per-entry axpy through the virtual methods of the base class
+// ==================================================================
+void virtual_axpy(const Real alpha, const ACVector<Real> *x_pt, ACVector<Real> *y_pt)
+{
+ const unsigned long n = y_pt->n_values();
+ for (unsigned long i = 0; i < n; i++)
+  {
+   y_pt->value(i)+= alpha * x_pt->value(i);
+  }
+}
+
+// ==================================================================
+// Per-entry copy through the virtual methods of the base class
+// ==================================================================
+void virtual_copy(const ACMatrix<Real> *x_pt, ACMatrix<Real> *y_pt)
+{
+ const unsigned long n_rows = y_pt->n_rows();
+ const unsigned long n_columns = y_pt->n_columns();
+ for (unsigned long i = 0; i < n_rows; i++)
+  {
+   for (unsigned long j = 0; j < n_columns; j++)
+    {
+     (*y_pt)(i,j) = (*x_pt)(i,j);
+    }
+  }
+}
+
+// ==================================================================
+// Per-entry scale through the virtual methods of the base class
+// ==================================================================
+void virtual_scale(const Real alpha, ACMatrix<Real> *x_pt)
+{
+ const unsigned long n_rows = x_pt->n_rows();
+ const unsigned long n_columns = x_pt->n_columns();
+ for (unsigned long i = 0; i < n_rows; i++)
+  {
+   for (unsigned long j = 0; j < n_columns; j++)
+    {
+     x_pt->value(i,j)*= alpha;
+    }
+  }
+}
+
+// ==================================================================
+// Compute the nanoseconds per entry
+// ==================================================================
+double ns_per_entry(const double seconds, const unsigned long n_entries,
+                    const unsigned repetitions)
+{
+ return seconds * 1.0e9 / (double(n_entries) * double(repetitions));
+}
+
+// ==================================================================
+// Maximum difference between two arrays
+// ==================================================================
+Real max_difference(const unsigned long n_entries, const Real *reference, const Real *values)
+{
+ Real max_diff = 0.0;
+ for (unsigned long i = 0; i < n_entries; i++)
+  {
+   max_diff = std::max(max_diff, Real(std::fabs(reference[i] - values[i])));
+  }
+ return max_diff;
+}
+
+// ==================================================================
+// Benchmark axpy on vectors of size n. Returns true if both versions
+// give the same result
+// ==================================================================
+bool benchmark_vector_axpy(const unsigned long n, const unsigned repetitions)
+{
+ CCVector<Real> x(n);
+ CCVector<Real> y_virtual(n);
+ CCVector<Real> y_bulk(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   x(i) = Real((i*7)%13) / 13.0 - 0.5;
+   y_virtual(i) = y_bulk(i) = Real((i*5)%11) / 11.0;
+  }
+ // Work through the base class, as the library does
+ ACVector<Real> *x_pt = &x;
+ ACVector<Real> *y_virtual_pt = &y_virtual;
+ ACVector<Real> *y_bulk_pt = &y_bulk;
+ const Real alpha = 1.0e-3;
+
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned r = 0; r < repetitions; r++)
+  {
+   virtual_axpy(alpha, x_pt, y_virtual_pt);
+  }
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ const double seconds_virtual =
+  Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+
+ initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned r = 0; r < repetitions; r++)
+  {
+   y_bulk_pt->axpy(alpha, *x_pt);
+  }
+ final_clock_time = Timing::cpu_clock_time();
+ const double seconds_bulk =
+  Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+
+ const Real diff = max_difference(n, y_virtual.vector_pt(), y_bulk.vector_pt());
+ std::cout << "vector axpy  n = " << std::setw(8) << n
+           << " value(): " << std::setw(10) << ns_per_entry(seconds_virtual, n, repetitions)
+           << " ns/entry, bulk: " << std::setw(10) << ns_per_entry(seconds_bulk, n, repetitions)
+           << " ns/entry (difference: " << diff << ")" << std::endl;
+ return diff == 0.0;
+}
+
+// ==================================================================
+// Benchmark copy and scale on matrices of size n x n. Returns true if
+// both versions give the same result
+// ==================================================================
+bool benchmark_matrix_copy_and_scale(const unsigned long n, const unsigned repetitions)
+{
+ CCMatrix<Real> A(n, n);
+ CCMatrix<Real> B_virtual(n, n);
+ CCMatrix<Real> B_bulk(n, n);
+ Real *A_entries_pt = A.matrix_pt();
+ for (unsigned long i = 0; i < n*n; i++)
+  {
+   A_entries_pt[i] = Real((i*7)%13) / 13.0 - 0.5;
+  }
+ // Work through the base class, as the library does
+ ACMatrix<Real> *A_pt = &A;
+ ACMatrix<Real> *B_virtual_pt = &B_virtual;
+ ACMatrix<Real> *B_bulk_pt = &B_bulk;
+ const Real alpha = 0.999;
+
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned r = 0; r < repetitions; r++)
+  {
+   virtual_copy(A_pt, B_virtual_pt);
+  }
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ const double seconds_copy_virtual =
+  Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+
+ initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned r = 0; r < repetitions; r++)
+  {
+   B_bulk_pt->copy(*A_pt);
+  }
+ final_clock_time = Timing::cpu_clock_time();
+ const double seconds_copy_bulk =
+  Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+
+ const Real diff_copy = max_difference(n*n, B_virtual.matrix_pt(), B_bulk.matrix_pt());
+ std::cout << "matrix copy  n = " << std::setw(8) << n
+           << " value(): " << std::setw(10) << ns_per_entry(seconds_copy_virtual, n*n, repetitions)
+           << " ns/entry, bulk: " << std::setw(10) << ns_per_entry(seconds_copy_bulk, n*n, repetitions)
+           << " ns/entry (difference: " << diff_copy << ")" << std::endl;
+
+ initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned r = 0; r < repetitions; r++)
+  {
+   virtual_scale(alpha, B_virtual_pt);
+  }
+ final_clock_time = Timing::cpu_clock_time();
+ const double seconds_scale_virtual =
+  Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+
+ initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned r = 0; r < repetitions; r++)
+  {
+   B_bulk_pt->scale(alpha);
+  }
+ final_clock_time = Timing::cpu_clock_time();
+ const double seconds_scale_bulk =
+  Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+
+ const Real diff_scale = max_difference(n*n, B_virtual.matrix_pt(), B_bulk.matrix_pt());
+ std::cout << "matrix scale n = " << std::setw(8) << n
+           << " value(): " << std::setw(10) << ns_per_entry(seconds_scale_virtual, n*n, repetitions)
+           << " ns/entry, bulk: " << std::setw(10) << ns_per_entry(seconds_scale_bulk, n*n, repetitions)
+           << " ns/entry (difference: " << diff_scale << ")" << std::endl;
+
+ return diff_copy == 0.0 && diff_scale == 0.0;
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the bulk operations on vectors and matrices");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.sizes, "--sizes")
+  .help("Sizes of the vectors (and of the side of the square matrices)")
+  .nargs('+')
+  .default_value({"1000", "100000", "1000000"});
+
+ parser.add_argument(args.repetitions, "--repetitions")
+  .help("Number of times each operation is repeated")
+  .default_value("10");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ std::vector<unsigned long> sizes = args.sizes.value();
+ unsigned repetitions = args.repetitions;
+ if (args.test)
+  {
+   sizes.clear();
+   sizes.push_back(17);
+   sizes.push_back(300);
+   repetitions = 2;
+  }
+
+ bool all_passed = true;
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   const unsigned long n = sizes[i];
+   const bool passed_vector = benchmark_vector_axpy(n, repetitions);
+   // Keep the matrices in a reasonable size
+   const unsigned long n_matrix = std::min(n, 2048ul);
+   const bool passed_matrix = benchmark_matrix_copy_and_scale(n_matrix, repetitions);
+   output_test << n << " " << passed_vector << " " << passed_matrix << std::endl;
+   all_passed = all_passed && passed_vector && passed_matrix;
+  }
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The results of the bulk operations differ from the per-entry loops" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
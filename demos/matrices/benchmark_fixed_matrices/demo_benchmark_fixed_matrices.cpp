@@ -0,0 +1,219 @@
+// IN THIS FILE: Benchmark of small matrices whose size is known at
+// compile time (CCFixedMatrix, CCFixedVector) against CCMatrix and
+// CCVector. The kernel computes x = A * (B * x) + c many times, as in
+// a per-node operation, with 3 X 3 and 6 X 6 matrices. The results of
+// both versions are checked to be the same and the allocations
+// performed by each version are counted. The conversions between
+// fixed and dynamic matrices are also checked
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The class to create matrices and vectors
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+// Fixed size matrices and vectors
+#include "../../../src/matrices/cc_fixed_vector.h"
+#include "../../../src/matrices/cc_fixed_matrix.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<unsigned long> n_iterations;
+};
+
+// ==================================================================
+// Seconds elapsed since the given time
+// ==================================================================
+double seconds_since(clock_t initial_clock_time)
+{
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ return Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+}
+
+// ==================================================================
+// Benchmark the kernel with N X N matrices. Returns true if both
+// versions give the same result and the fixed version performs no
+// allocations, n_allocations_fixed is the number of allocations
+// performed by the fixed version
+// ==================================================================
+template<unsigned long N>
+bool benchmark_fixed_matrices(const unsigned long n_iterations,
+                              unsigned long &n_allocations_fixed)
+{
+ // Fill the matrices with values such that the iterations converge
+ // (the norm of A * B is smaller than one)
+ CCFixedMatrix<Real, N, N> A_fixed;
+ CCFixedMatrix<Real, N, N> B_fixed;
+ CCFixedVector<Real, N> x_fixed;
+ CCFixedVector<Real, N> c_fixed;
+ for (unsigned long i = 0; i < N; i++)
+  {
+   for (unsigned long j = 0; j < N; j++)
+    {
+     A_fixed(i, j) = 0.1 / (1.0 + i + j);
+     B_fixed(i, j) = (i == j ? 0.5 : 0.01 * (Real(i) - Real(j)));
+    }
+   x_fixed(i) = 1.0 + i;
+   c_fixed(i) = 1.0;
+  }
+
+ // The dynamic matrices, converted from the fixed ones
+ CCMatrix<Real> A;
+ CCMatrix<Real> B;
+ CCVector<Real> x;
+ CCVector<Real> c;
+ A_fixed.copy_to(A);
+ B_fixed.copy_to(B);
+ x_fixed.copy_to(x);
+ c_fixed.copy_to(c);
+
+ // Dynamic matrices and vectors, the products create temporaries
+ MemoryAllocator::reset_statistics();
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned long k = 0; k < n_iterations; k++)
+  {
+   CCVector<Real> Bx;
+   multiply_matrix_times_vector(B, x, Bx);
+   CCVector<Real> ABx;
+   multiply_matrix_times_vector(A, Bx, ABx);
+   x = ABx + c;
+  }
+ const double seconds_dynamic = seconds_since(initial_clock_time);
+ const unsigned long n_allocations_dynamic = MemoryAllocator::statistics().N_allocations;
+
+ // Fixed matrices and vectors
+ MemoryAllocator::reset_statistics();
+ initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned long k = 0; k < n_iterations; k++)
+  {
+   x_fixed = A_fixed * (B_fixed * x_fixed) + c_fixed;
+  }
+ const double seconds_fixed = seconds_since(initial_clock_time);
+ n_allocations_fixed = MemoryAllocator::statistics().N_allocations;
+
+ // Compare the results
+ CCFixedVector<Real, N> x_converted(x);
+ const Real relative_difference =
+  (x_converted - x_fixed).norm_inf() / x_fixed.norm_inf();
+ const bool passed = relative_difference < 1.0e-12 && n_allocations_fixed == 0;
+
+ std::cout << std::setw(2) << N << " x " << std::setw(2) << N
+           << " dynamic: " << std::setw(10) << seconds_dynamic << " s ("
+           << n_allocations_dynamic << " allocations)"
+           << " fixed: " << std::setw(10) << seconds_fixed << " s ("
+           << n_allocations_fixed << " allocations)"
+           << " speedup: " << std::setw(8) << seconds_dynamic / seconds_fixed
+           << " (relative difference: " << relative_difference << ")"
+           << (passed ? "" : " (FAILED)") << std::endl;
+
+ return passed;
+}
+
+// ==================================================================
+// Check the conversions between fixed and dynamic matrices, and the
+// use of a fixed matrix through its view
+// ==================================================================
+bool check_conversions()
+{
+ CCFixedMatrix<Real, 2, 3> F;
+ for (unsigned long i = 0; i < 2; i++)
+  {
+   for (unsigned long j = 0; j < 3; j++)
+    {
+     F(i, j) = Real(3*i + j);
+    }
+  }
+
+ // Fixed -> dynamic -> fixed
+ CCMatrix<Real> D;
+ F.copy_to(D);
+ CCFixedMatrix<Real, 2, 3> G(D);
+ bool passed = true;
+ for (unsigned long k = 0; k < 6; k++)
+  {
+   passed = passed && G.data_pt()[k] == F.data_pt()[k] &&
+    D.matrix_pt()[k] == F.data_pt()[k];
+  }
+
+ // Modify the fixed matrix through its view
+ CCMatrixView<Real> F_view = F.view();
+ F_view.scale(2.0);
+ passed = passed && F(1, 2) == 10.0;
+
+ // Transpose and identity
+ const CCFixedMatrix<Real, 3, 2> F_t = F.transpose();
+ const CCFixedMatrix<Real, 3, 3> I = CCFixedMatrix<Real, 3, 3>::identity();
+ const CCFixedMatrix<Real, 3, 2> IF_t = I * F_t;
+ passed = passed && IF_t(2, 1) == F(1, 2) && IF_t(0, 1) == F(1, 0);
+
+ // Cross product
+ CCFixedVector<Real, 3> e_x;
+ CCFixedVector<Real, 3> e_y;
+ e_x(0) = 1.0;
+ e_y(1) = 1.0;
+ passed = passed && cross(e_x, e_y)(2) == 1.0;
+
+ return passed;
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of fixed size matrices");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with a small number of iterations for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.n_iterations, "--n_iterations")
+  .help("Number of evaluations of the kernel")
+  .default_value("1000000");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ unsigned long n_iterations = args.n_iterations;
+ if (args.test)
+  {
+   n_iterations = 1000;
+  }
+
+ unsigned long n_allocations_3 = 0;
+ unsigned long n_allocations_6 = 0;
+ const bool passed_3 = benchmark_fixed_matrices<3>(n_iterations, n_allocations_3);
+ const bool passed_6 = benchmark_fixed_matrices<6>(n_iterations, n_allocations_6);
+ const bool passed_conversions = check_conversions();
+ output_test << 3 << " " << passed_3 << " " << n_allocations_3 << std::endl;
+ output_test << 6 << " " << passed_6 << " " << n_allocations_6 << std::endl;
+ output_test << passed_conversions << std::endl;
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!(passed_3 && passed_6 && passed_conversions))
+  {
+   std::cout << "The results of the fixed size matrices differ" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
@@ -0,0 +1,257 @@
+// IN THIS FILE: Benchmark of the cache-blocked matrix-matrix
+// multiplication kernels. The naive triple loop (previous
+// implementation of multiply_matrices()) is compared against each
+// micro-kernel supported by the CPU, the GFLOP/s of each one are
+// reported and the results are checked against the naive product
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The class to create matrices
+#include "../../../src/matrices/cc_matrix.h"
+// The kernels
+#include "../../../src/matrices/gemm_kernels.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > sizes;
+};
+
+// ==================================================================
+// Naive product C = A * B (the previous implementation of
+// multiply_matrices())
+// ==================================================================
+template<class T>
+void naive_gemm(const unsigned long n, const T *A, const T *B, T *C)
+{
+ for (unsigned long i = 0; i < n; i++)
+  {
+   for (unsigned long j = 0; j < n; j++)
+    {
+     C[i*n+j] = 0;
+     for (unsigned long k = 0; k < n; k++)
+      {
+       C[i*n+j]+= A[i*n+k] * B[k*n+j];
+      }
+    }
+  }
+}
+
+// ==================================================================
+// Maximum difference between two arrays relative to the largest
+// entry of the reference array
+// ==================================================================
+template<class T>
+double relative_difference(const unsigned long n_entries, const T *reference, const T *values)
+{
+ double max_diff = 0.0;
+ double max_reference = 0.0;
+ for (unsigned long i = 0; i < n_entries; i++)
+  {
+   max_diff = std::max(max_diff, double(std::fabs(reference[i] - values[i])));
+   max_reference = std::max(max_reference, double(std::fabs(reference[i])));
+  }
+ if (max_reference == 0.0)
+  {
+   return max_diff;
+  }
+ return max_diff / max_reference;
+}
+
+// ==================================================================
+// Compute the GFLOP/s for a square product of size n
+// ==================================================================
+double gflops(const unsigned long n, const double seconds)
+{
+ if (seconds <= 0.0)
+  {
+   return 0.0;
+  }
+ return 2.0 * double(n) * double(n) * double(n) / seconds * 1.0e-9;
+}
+
+// ==================================================================
+// Benchmark the float kernels by calling gemm() directly. Returns
+// true if all the kernels give the same result as the naive product
+// ==================================================================
+bool benchmark_float(const unsigned long n,
+                     const std::vector<GEMMKernels::Kernel_type> &kernels)
+{
+ std::vector<float> A(n*n);
+ std::vector<float> B(n*n);
+ std::vector<float> C_naive(n*n);
+ std::vector<float> C(n*n);
+ for (unsigned long i = 0; i < n*n; i++)
+  {
+   A[i] = float((i*7)%13) / 13.0f - 0.5f;
+   B[i] = float((i*5)%11) / 11.0f - 0.5f;
+  }
+ 
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ naive_gemm(n, &A[0], &B[0], &C_naive[0]);
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ double seconds = Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+ std::cout << "[float]  n = " << std::setw(5) << n << " naive   : "
+           << std::setw(10) << gflops(n, seconds) << " GFLOP/s" << std::endl;
+ 
+ bool passed = true;
+ for (unsigned i = 0; i < kernels.size(); i++)
+  {
+   GEMMKernels::set_kernel(kernels[i]);
+   initial_clock_time = Timing::cpu_clock_time();
+   GEMMKernels::gemm(n, n, n, &A[0], n, &B[0], n, &C[0], n);
+   final_clock_time = Timing::cpu_clock_time();
+   seconds = Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+   const double diff = relative_difference(n*n, &C_naive[0], &C[0]);
+   std::cout << "[float]  n = " << std::setw(5) << n << " "
+             << std::setw(8) << std::left << GEMMKernels::kernel_name(kernels[i])
+             << std::right << ": " << std::setw(10) << gflops(n, seconds)
+             << " GFLOP/s (relative difference: " << diff << ")" << std::endl;
+   if (diff > 1.0e-4)
+    {
+     passed = false;
+    }
+  }
+ 
+ return passed;
+}
+
+// ==================================================================
+// Benchmark the double kernels by calling multiply_matrices(). Returns
+// true if all the kernels give the same result as the naive product
+// ==================================================================
+bool benchmark_double(const unsigned long n,
+                      const std::vector<GEMMKernels::Kernel_type> &kernels)
+{
+ CCMatrix<double> A(n, n);
+ CCMatrix<double> B(n, n);
+ CCMatrix<double> C_naive(n, n);
+ double *A_pt = A.matrix_pt();
+ double *B_pt = B.matrix_pt();
+ for (unsigned long i = 0; i < n*n; i++)
+  {
+   A_pt[i] = double((i*7)%13) / 13.0 - 0.5;
+   B_pt[i] = double((i*5)%11) / 11.0 - 0.5;
+  }
+ 
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ naive_gemm(n, A_pt, B_pt, C_naive.matrix_pt());
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ double seconds = Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+ std::cout << "[double] n = " << std::setw(5) << n << " naive   : "
+           << std::setw(10) << gflops(n, seconds) << " GFLOP/s" << std::endl;
+ 
+ bool passed = true;
+ for (unsigned i = 0; i < kernels.size(); i++)
+  {
+   GEMMKernels::set_kernel(kernels[i]);
+   CCMatrix<double> C(n, n);
+   initial_clock_time = Timing::cpu_clock_time();
+   multiply_matrices(A, B, C);
+   final_clock_time = Timing::cpu_clock_time();
+   seconds = Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+   const double diff = relative_difference(n*n, C_naive.matrix_pt(), C.matrix_pt());
+   std::cout << "[double] n = " << std::setw(5) << n << " "
+             << std::setw(8) << std::left << GEMMKernels::kernel_name(kernels[i])
+             << std::right << ": " << std::setw(10) << gflops(n, seconds)
+             << " GFLOP/s (relative difference: " << diff << ")" << std::endl;
+   if (diff > 1.0e-12)
+    {
+     passed = false;
+    }
+  }
+ 
+ return passed;
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+ 
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the matrix-matrix multiplication kernels");
+ 
+ // Add arguments
+ 
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+ 
+ parser.add_argument(args.sizes, "--sizes")
+  .help("Sizes of the square matrices to multiply")
+  .nargs('+')
+  .default_value({"256", "512", "1024", "2048"});
+ 
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+ 
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+ 
+ // The sizes to benchmark, in test mode use sizes that are not
+ // multiples of the register blocks and larger than the cache blocks
+ std::vector<unsigned long> sizes = args.sizes.value();
+ if (args.test)
+  {
+   sizes.clear();
+   sizes.push_back(37);
+   sizes.push_back(130);
+   sizes.push_back(300);
+   sizes.push_back(530);
+  }
+ 
+ // Get the kernels supported by this CPU
+ std::vector<GEMMKernels::Kernel_type> kernels;
+ kernels.push_back(GEMMKernels::GENERIC);
+ if (GEMMKernels::is_kernel_supported(GEMMKernels::AVX2))
+  {
+   kernels.push_back(GEMMKernels::AVX2);
+  }
+ if (GEMMKernels::is_kernel_supported(GEMMKernels::AVX512))
+  {
+   kernels.push_back(GEMMKernels::AVX512);
+  }
+ if (GEMMKernels::is_kernel_supported(GEMMKernels::BLAS))
+  {
+   kernels.push_back(GEMMKernels::BLAS);
+  }
+ 
+ std::cout << "Kernel chosen by default: "
+           << GEMMKernels::kernel_name(GEMMKernels::kernel()) << std::endl;
+ 
+ bool all_passed = true;
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   const unsigned long n = sizes[i];
+   const bool passed_double = benchmark_double(n, kernels);
+   const bool passed_float = benchmark_float(n, kernels);
+   output_test << n << " " << passed_double << " " << passed_float << std::endl;
+   all_passed = all_passed && passed_double && passed_float;
+  }
+ 
+ // Restore the default kernel
+ GEMMKernels::set_kernel(GEMMKernels::AUTO);
+ 
+ // Close the output for test
+ output_test.close();
+ 
+ // Finalise scicellxx
+ finalise_scicellxx();
+ 
+ if (!all_passed)
+  {
+   std::cout << "The results of the kernels differ from the naive product" << std::endl;
+   return 1;
+  }
+ 
+ return 0;
+ 
+}
@@ -0,0 +1,271 @@
+// IN THIS FILE: Benchmark of vectors and matrices stored in float
+// whose reductions are accumulated in double (AccumulatorTraits)
+// against the same operations stored in double. The dot product, the
+// norm 2 and matrix times vector read half the memory when stored in
+// float. The accuracy of each version is measured against a long
+// double reference computed with the double entries: float storage
+// with float accumulation, float storage with double accumulation
+// (the default for float) and double storage
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The class to create matrices and vectors
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+// The kernels, to choose the accumulator
+#include "../../../src/matrices/parallel_kernels.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > sizes;
+ argparse::ArgValue<unsigned long> n_operations;
+};
+
+// ==================================================================
+// Seconds elapsed since the given time
+// ==================================================================
+double seconds_since(clock_t initial_clock_time)
+{
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ return Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+}
+
+// ==================================================================
+// Relative error of value with respect to reference
+// ==================================================================
+double relative_error(const double value, const long double reference)
+{
+ return double(std::fabs((value - reference) / reference));
+}
+
+// ==================================================================
+// Accuracy and time of the dot product and the norm 2 of vectors
+// with n entries. Returns true if accumulating in double gives
+// (almost) the accuracy of the storage in float
+// ==================================================================
+bool benchmark_reductions(const unsigned long n, const unsigned long n_repetitions)
+{
+ // The entries, not representable in float
+ CCVector<double> x(n);
+ CCVector<double> y(n);
+ x.set_as_column_vector(false);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   x(i) = 1.0 + 0.1 * std::sin(0.1 * i);
+   y(i) = 1.0 / 3.0 + 0.01 * std::cos(0.3 * i);
+  }
+ CCVector<float> x_f(n);
+ CCVector<float> y_f(n);
+ x_f.set_as_column_vector(false);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   x_f(i) = float(x(i));
+   y_f(i) = float(y(i));
+  }
+
+ // The references, with the double entries and with the entries
+ // rounded to float (the error of the accumulation only)
+ long double dot_reference = 0.0;
+ long double dot_reference_f = 0.0;
+ long double squares_reference = 0.0;
+ for (unsigned long i = 0; i < n; i++)
+  {
+   dot_reference+= (long double)(x(i)) * (long double)(y(i));
+   dot_reference_f+= (long double)(x_f(i)) * (long double)(y_f(i));
+   squares_reference+= (long double)(x(i)) * (long double)(x(i));
+  }
+ const long double norm_reference = std::sqrt(squares_reference);
+
+ // Double storage
+ double dot = 0.0;
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned long k = 0; k < n_repetitions; k++)
+  {
+   dot = x.dot(y);
+  }
+ const double seconds_double = seconds_since(initial_clock_time);
+ const double norm = x.norm_2();
+
+ // Float storage, float accumulation
+ float dot_ff = 0.0;
+ initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned long k = 0; k < n_repetitions; k++)
+  {
+   dot_ff = ParallelKernels::dot<float, float>(n, x_f.vector_pt(), y_f.vector_pt());
+  }
+ const double seconds_ff = seconds_since(initial_clock_time);
+ const float norm_ff = ParallelKernels::norm_2<float, float>(n, x_f.vector_pt());
+
+ // Float storage, double accumulation (the default for float)
+ float dot_fd = 0.0;
+ initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned long k = 0; k < n_repetitions; k++)
+  {
+   dot_fd = x_f.dot(y_f);
+  }
+ const double seconds_fd = seconds_since(initial_clock_time);
+ const float norm_fd = x_f.norm_2();
+
+ const double error_double = relative_error(dot, dot_reference);
+ const double error_ff = relative_error(dot_ff, dot_reference);
+ const double error_fd = relative_error(dot_fd, dot_reference);
+ const double error_ff_accumulation = relative_error(dot_ff, dot_reference_f);
+ const double error_fd_accumulation = relative_error(dot_fd, dot_reference_f);
+
+ std::cout << std::setw(9) << n << " dot"
+           << "  time double: " << std::setw(10) << seconds_double << " s"
+           << " float/float: " << std::setw(10) << seconds_ff << " s"
+           << " float/double: " << std::setw(10) << seconds_fd << " s" << std::endl;
+ std::cout << std::setw(9) << " " << "     error double: " << std::setw(11) << error_double
+           << " float/float: " << std::setw(11) << error_ff
+           << " float/double: " << std::setw(11) << error_fd << std::endl;
+ std::cout << std::setw(9) << " " << "     error of the accumulation"
+           << " float/float: " << std::setw(11) << error_ff_accumulation
+           << " float/double: " << std::setw(11) << error_fd_accumulation << std::endl;
+ std::cout << std::setw(9) << " " << " norm error double: "
+           << std::setw(11) << relative_error(norm, norm_reference)
+           << " float/float: " << std::setw(11) << relative_error(norm_ff, norm_reference)
+           << " float/double: " << std::setw(11) << relative_error(norm_fd, norm_reference)
+           << std::endl;
+
+ // The only error left with double accumulation is the rounding of
+ // the entries and of the result to float
+ return error_fd_accumulation < 1.0e-7 && error_fd <= 1.0e-6 &&
+  relative_error(norm_fd, norm_reference) <= 1.0e-6;
+}
+
+// ==================================================================
+// Accuracy and time of matrix times vector with an n X n matrix.
+// Returns true if the float version accumulated in double is within
+// the rounding of float of the double version
+// ==================================================================
+bool benchmark_matrix_times_vector(const unsigned long n, const unsigned long n_repetitions)
+{
+ CCMatrix<double> A(n, n);
+ CCVector<double> x(n);
+ CCMatrix<float> A_f(n, n);
+ CCVector<float> x_f(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   for (unsigned long j = 0; j < n; j++)
+    {
+     A(i, j) = 1.0 / (1.0 + i + j) + 0.1;
+     A_f(i, j) = float(A(i, j));
+    }
+   x(i) = 1.0 + 0.5 * std::sin(Real(i));
+   x_f(i) = float(x(i));
+  }
+
+ CCVector<double> y;
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned long k = 0; k < n_repetitions; k++)
+  {
+   multiply_matrix_times_vector(A, x, y);
+  }
+ const double seconds_double = seconds_since(initial_clock_time);
+
+ CCVector<float> y_f;
+ initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned long k = 0; k < n_repetitions; k++)
+  {
+   multiply_matrix_times_vector(A_f, x_f, y_f);
+  }
+ const double seconds_float = seconds_since(initial_clock_time);
+
+ double max_error = 0.0;
+ for (unsigned long i = 0; i < n; i++)
+  {
+   max_error = std::max(max_error, relative_error(y_f(i), y(i)));
+  }
+
+ std::cout << std::setw(9) << n << " matrix times vector"
+           << " time double: " << std::setw(10) << seconds_double << " s"
+           << " float/double: " << std::setw(10) << seconds_float << " s"
+           << " speedup: " << std::setw(8) << seconds_double / seconds_float
+           << " max relative difference: " << max_error << std::endl;
+
+ return max_error <= 1.0e-6;
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of float storage with double accumulation");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.sizes, "--sizes")
+  .help("Number of entries of the vectors")
+  .nargs('+')
+  .default_value({"1000", "100000", "10000000"});
+
+ parser.add_argument(args.n_operations, "--n_operations")
+  .help("Number of entries read for each size (the operations are repeated n_operations / size times)")
+  .default_value("1000000000");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ std::vector<unsigned long> sizes = args.sizes.value();
+ unsigned long n_operations = args.n_operations;
+ if (args.test)
+  {
+   sizes.clear();
+   sizes.push_back(1000);
+   sizes.push_back(100000);
+   n_operations = 1000000;
+  }
+
+ bool all_passed = true;
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   const unsigned long n = sizes[i];
+   const unsigned long n_repetitions = std::max(n_operations / n, 1UL);
+   const bool passed = benchmark_reductions(n, n_repetitions);
+   output_test << n << " " << passed << std::endl;
+   all_passed = all_passed && passed;
+  }
+
+ // Square matrices with about the same number of entries
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   const unsigned long n = std::max(static_cast<unsigned long>(std::sqrt(double(sizes[i]))), 1UL);
+   const unsigned long n_repetitions = std::max(n_operations / (n * n), 1UL);
+   const bool passed = benchmark_matrix_times_vector(n, n_repetitions);
+   output_test << n << " " << passed << std::endl;
+   all_passed = all_passed && passed;
+  }
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The errors of the float storage are larger than expected" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
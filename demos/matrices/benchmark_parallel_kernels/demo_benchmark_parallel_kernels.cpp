@@ -0,0 +1,219 @@
+// IN THIS FILE: Benchmark of the parallel kernels of vectors and
+// matrices (element-wise operations, dot product, norms and matrix
+// times vector). Each kernel is executed with an increasing number of
+// threads, the results are checked to be the same (bit by bit) as the
+// ones obtained with one thread
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The pool of threads
+#include "../../../src/general/thread_pool.h"
+// The classes to create vectors and matrices
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > sizes;
+ argparse::ArgValue<std::vector<unsigned> > threads;
+ argparse::ArgValue<unsigned long> threshold;
+ argparse::ArgValue<unsigned> repetitions;
+};
+
+// ==================================================================
+// The results of the kernels
+// ==================================================================
+struct Results
+{
+ CCVector<Real> sum;
+ CCVector<Real> product;
+ CCVector<Real> matrix_times_vector;
+ Real dot;
+ Real norm_1;
+ Real norm_2;
+ Real norm_inf;
+};
+
+// ==================================================================
+// Are the results the same (bit by bit)
+// ==================================================================
+bool same_results(const Results &reference, const Results &results)
+{
+ const unsigned long n = reference.sum.n_values();
+ const unsigned long m = reference.matrix_times_vector.n_values();
+ return
+  std::memcmp(reference.sum.vector_pt(), results.sum.vector_pt(), n*sizeof(Real)) == 0 &&
+  std::memcmp(reference.product.vector_pt(), results.product.vector_pt(), n*sizeof(Real)) == 0 &&
+  std::memcmp(reference.matrix_times_vector.vector_pt(),
+              results.matrix_times_vector.vector_pt(), m*sizeof(Real)) == 0 &&
+  std::memcmp(&reference.dot, &results.dot, sizeof(Real)) == 0 &&
+  std::memcmp(&reference.norm_1, &results.norm_1, sizeof(Real)) == 0 &&
+  std::memcmp(&reference.norm_2, &results.norm_2, sizeof(Real)) == 0 &&
+  std::memcmp(&reference.norm_inf, &results.norm_inf, sizeof(Real)) == 0;
+}
+
+// ==================================================================
+// Run the kernels on vectors of size n (and a matrix with n entries)
+// with the given number of threads. Returns the elapsed time
+// ==================================================================
+double run_kernels(const unsigned long n, const unsigned n_threads,
+                   const unsigned repetitions, Results &results)
+{
+ ThreadPool::set_n_threads(n_threads);
+
+ CCVector<Real> x(n);
+ CCVector<Real> y(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   x(i) = Real((i*7)%13) / 13.0 - 0.5;
+   y(i) = Real((i*5)%11) / 11.0 + 1.0e-3 * Real(i%1000);
+  }
+ CCVector<Real> x_row(x);
+ x_row.set_as_column_vector(false);
+
+ // A matrix with (about) n entries
+ const unsigned long n_columns = std::min(n, 1000ul);
+ const unsigned long n_rows = std::max(n / n_columns, 1ul);
+ CCMatrix<Real> A(n_rows, n_columns);
+ Real *A_pt = A.matrix_pt();
+ for (unsigned long i = 0; i < n_rows*n_columns; i++)
+  {
+   A_pt[i] = Real((i*3)%17) / 17.0;
+  }
+ CCVector<Real> z(n_columns);
+ for (unsigned long i = 0; i < n_columns; i++)
+  {
+   z(i) = y(i);
+  }
+
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ time_t initial_wall_time = Timing::wall_time();
+ for (unsigned r = 0; r < repetitions; r++)
+  {
+   add_vectors(x, y, results.sum);
+   multiply_element_by_element_vectors(x, y, results.product);
+   multiply_matrix_times_vector(A, z, results.matrix_times_vector);
+   results.dot = dot_vectors(x_row, y);
+   results.norm_1 = results.sum.norm_1();
+   results.norm_2 = results.sum.norm_2();
+   results.norm_inf = results.product.norm_inf();
+  }
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ time_t final_wall_time = Timing::wall_time();
+
+ // Report the wall time if it is large enough to be measured,
+ // otherwise the cpu time
+ const double wall_seconds = Timing::diff_wall_time(initial_wall_time, final_wall_time);
+ if (wall_seconds > 1.0)
+  {
+   return wall_seconds;
+  }
+ return Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the parallel kernels of vectors and matrices");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.sizes, "--sizes")
+  .help("Sizes of the vectors (and number of entries of the matrices)")
+  .nargs('+')
+  .default_value({"10000", "1000000", "10000000"});
+
+ parser.add_argument(args.threads, "--threads")
+  .help("Number of threads to use")
+  .nargs('+')
+  .default_value({"1", "2", "4", "8"});
+
+ parser.add_argument(args.threshold, "--threshold")
+  .help("Minimum number of operations to execute a kernel in parallel")
+  .default_value("32768");
+
+ parser.add_argument(args.repetitions, "--repetitions")
+  .help("Number of times the kernels are executed")
+  .default_value("10");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ std::vector<unsigned long> sizes = args.sizes.value();
+ std::vector<unsigned> threads = args.threads.value();
+ unsigned long threshold = args.threshold;
+ unsigned repetitions = args.repetitions;
+ if (args.test)
+  {
+   // Small sizes and a small threshold to use the threads anyway
+   sizes.clear();
+   sizes.push_back(1000);
+   sizes.push_back(50000);
+   threads.clear();
+   threads.push_back(1);
+   threads.push_back(2);
+   threads.push_back(3);
+   threads.push_back(4);
+   threshold = 512;
+   repetitions = 2;
+  }
+
+ ThreadPool::set_serial_threshold(threshold);
+
+ bool all_passed = true;
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   const unsigned long n = sizes[i];
+   Results reference;
+   const double reference_time = run_kernels(n, 1, repetitions, reference);
+   std::cout << "n = " << std::setw(10) << n << " threads: " << std::setw(3) << 1
+             << " time: " << std::setw(12) << reference_time << " s" << std::endl;
+   bool passed = true;
+   for (unsigned t = 0; t < threads.size(); t++)
+    {
+     Results results;
+     const double time = run_kernels(n, threads[t], repetitions, results);
+     const bool same = same_results(reference, results);
+     std::cout << "n = " << std::setw(10) << n << " threads: " << std::setw(3) << threads[t]
+               << " time: " << std::setw(12) << time << " s"
+               << " speed up: " << std::setw(8) << (time > 0.0 ? reference_time / time : 0.0)
+               << (same ? "" : " (DIFFERENT RESULTS)") << std::endl;
+     passed = passed && same;
+    }
+   output_test << n << " " << passed << std::endl;
+   all_passed = all_passed && passed;
+  }
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The results depend on the number of threads" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
@@ -0,0 +1,304 @@
+// IN THIS FILE: Benchmark of the summation methods of the reductions
+// of vectors (ReductionKernels). The dot product of vectors with
+// entries of very different magnitudes and signs is computed with the
+// ACCUMULATORS, KAHAN and PAIRWISE methods and compared against a
+// long double reference and a simple loop. The norm 2 is checked not
+// to overflow nor underflow for entries whose squares are out of the
+// range of Real (around 1e231 and 1e-231 in double), and the maximum,
+// minimum and norms of vectors and strided views are checked against
+// simple loops
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The class to create vectors and views
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_vector_view.h"
+// The kernels, to choose the summation method
+#include "../../../src/matrices/reduction_kernels.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > sizes;
+ argparse::ArgValue<unsigned long> n_operations;
+};
+
+// ==================================================================
+// Seconds elapsed since the given time
+// ==================================================================
+double seconds_since(clock_t initial_clock_time)
+{
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ return Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+}
+
+// ==================================================================
+// Relative error of value with respect to reference
+// ==================================================================
+double relative_error(const long double value, const long double reference)
+{
+ return double(std::fabs(value - reference) / std::fabs(reference));
+}
+
+// ==================================================================
+// Fill the vectors such that the products have magnitudes between
+// 1e-8 and 1e8 and consecutive pairs cancel up to 1e-6 of their
+// magnitude. The entries of y are powers of two, thus the products
+// are exact and only the summation introduces errors
+// ==================================================================
+void fill_ill_conditioned(CCVector<Real> &x, CCVector<Real> &y)
+{
+ const unsigned long n = x.n_values();
+ for (unsigned long i = 0; i < n; i++)
+  {
+   y(i) = (i % 3 == 0 ? 0.5 : (i % 3 == 1 ? 1.0 : 2.0));
+  }
+ for (unsigned long i = 0; i + 1 < n; i+=2)
+  {
+   const Real magnitude = std::pow(10.0, 8.0 * std::sin(Real(i) * 0.7));
+   x(i) = magnitude / y(i);
+   x(i+1) = -magnitude * (1.0 - 1.0e-6 * (1.0 + std::cos(Real(i)))) / y(i+1);
+  }
+ if (n % 2 == 1)
+  {
+   x(n-1) = 1.0;
+  }
+}
+
+// ==================================================================
+// Compute the dot product of vectors of size n with the three
+// summation methods. Returns true if all of them are within n * eps
+// of the reference and KAHAN within a few eps
+// ==================================================================
+bool benchmark_dot(const unsigned long n, const unsigned long n_operations)
+{
+ // The dot product is computed as row vector times column vector
+ CCVector<Real> x(n, false);
+ CCVector<Real> y(n);
+ fill_ill_conditioned(x, y);
+
+ // The reference in long double with compensated (Neumaier)
+ // summation, and the condition number of the sum
+ long double reference = 0.0;
+ long double compensation = 0.0;
+ long double sum_of_absolute_values = 0.0;
+ for (unsigned long i = 0; i < n; i++)
+  {
+   const long double product = (long double)(x(i)) * (long double)(y(i));
+   const long double t = reference + product;
+   if (std::fabs(reference) >= std::fabs(product))
+    {
+     compensation+= (reference - t) + product;
+    }
+   else
+    {
+     compensation+= (product - t) + reference;
+    }
+   reference = t;
+   sum_of_absolute_values+= std::fabs(product);
+  }
+ reference+= compensation;
+ const double condition_number = double(sum_of_absolute_values / std::fabs(reference));
+
+ const unsigned long repetitions = std::max(n_operations / n, 1UL);
+
+ // A simple loop through operator() (the accuracy of a sequential sum)
+ Real naive = 0.0;
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned long r = 0; r < repetitions; r++)
+  {
+   naive = 0.0;
+   for (unsigned long i = 0; i < n; i++)
+    {
+     naive+= x(i) * y(i);
+    }
+  }
+ const double time_naive = seconds_since(initial_clock_time) / repetitions;
+ std::cout << "n = " << n << " (condition number " << condition_number << ")\n"
+           << "  loop:         " << time_naive * 1.0e9 << " ns, relative error "
+           << relative_error(naive, reference) << std::endl;
+
+ const Real eps = std::numeric_limits<Real>::epsilon();
+ bool passed = true;
+ const ReductionKernels::Summation_method methods[3] =
+  {ReductionKernels::ACCUMULATORS, ReductionKernels::KAHAN, ReductionKernels::PAIRWISE};
+ for (unsigned m = 0; m < 3; m++)
+  {
+   ReductionKernels::set_summation_method(methods[m]);
+   Real dot = 0.0;
+   initial_clock_time = Timing::cpu_clock_time();
+   for (unsigned long r = 0; r < repetitions; r++)
+    {
+     dot = x.dot(y);
+    }
+   const double time = seconds_since(initial_clock_time) / repetitions;
+   const double error = relative_error(dot, reference);
+   std::cout << "  " << ReductionKernels::summation_method_name(methods[m]) << ": "
+             << time * 1.0e9 << " ns, relative error " << error << std::endl;
+   passed = passed && error <= n * eps * condition_number;
+   if (methods[m] == ReductionKernels::KAHAN)
+    {
+     passed = passed && error <= 4.0 * eps * condition_number;
+    }
+  }
+ ReductionKernels::set_summation_method(ReductionKernels::ACCUMULATORS);
+
+ return passed;
+}
+
+// ==================================================================
+// The norm 2 of n entries equal to value is |value| * sqrt(n), check
+// it with the three summation methods (within the roundings of a sum
+// of n entries)
+// ==================================================================
+bool check_scaled_norm_2(const unsigned long n, const Real value)
+{
+ const Real eps = std::numeric_limits<Real>::epsilon();
+ CCVector<Real> x(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   x(i) = (i % 2 == 0 ? value : -value);
+  }
+ const long double reference = std::fabs((long double)(value)) * std::sqrt((long double)(n));
+
+ bool passed = true;
+ const ReductionKernels::Summation_method methods[3] =
+  {ReductionKernels::ACCUMULATORS, ReductionKernels::KAHAN, ReductionKernels::PAIRWISE};
+ for (unsigned m = 0; m < 3; m++)
+  {
+   ReductionKernels::set_summation_method(methods[m]);
+   const Real norm = x.norm_2();
+   passed = passed && relative_error(norm, reference) <= n * eps;
+  }
+ ReductionKernels::set_summation_method(ReductionKernels::ACCUMULATORS);
+ return passed;
+}
+
+// ==================================================================
+// The maximum, minimum and norms of a vector and of a strided view
+// against simple loops (the sums within the roundings of a sum of n
+// entries)
+// ==================================================================
+bool check_vector_and_view(const unsigned long n)
+{
+ const Real eps = std::numeric_limits<Real>::epsilon();
+ CCVector<Real> x(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   x(i) = std::sin(Real(i) * 0.37) * (1.0 + Real(i % 17));
+  }
+
+ // Every third entry
+ const unsigned long stride = 3;
+ const unsigned long n_view = (n + stride - 1) / stride;
+ CCVectorView<Real> view(x.vector_pt(), n_view, stride);
+
+ bool passed = true;
+ for (unsigned v = 0; v < 2; v++)
+  {
+   const unsigned long m = (v == 0 ? n : n_view);
+   const unsigned long step = (v == 0 ? 1 : stride);
+   Real max = x(0);
+   Real min = x(0);
+   Real norm_inf = 0.0;
+   Real norm_1 = 0.0;
+   Real norm_2 = 0.0;
+   for (unsigned long i = 0; i < m; i++)
+    {
+     const Real value = x(i*step);
+     max = std::max(max, value);
+     min = std::min(min, value);
+     norm_inf = std::max(norm_inf, std::fabs(value));
+     norm_1+= std::fabs(value);
+     norm_2+= value * value;
+    }
+   norm_2 = std::sqrt(norm_2);
+
+   ACVector<Real> &vector = (v == 0 ? static_cast<ACVector<Real>&>(x) : static_cast<ACVector<Real>&>(view));
+   passed = passed && vector.max() == max && vector.min() == min &&
+    vector.norm_inf() == norm_inf &&
+    relative_error(vector.norm_1(), norm_1) <= n * eps &&
+    relative_error(vector.norm_2(), norm_2) <= n * eps;
+  }
+ return passed;
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the summation methods of the reductions");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.sizes, "--sizes")
+  .help("Number of entries of the vectors")
+  .nargs('+')
+  .default_value({"100", "10000", "1000000"});
+
+ parser.add_argument(args.n_operations, "--n_operations")
+  .help("Number of multiply-add operations for each size (the dot product is repeated n_operations / size times)")
+  .default_value("100000000");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ std::vector<unsigned long> sizes = args.sizes.value();
+ unsigned long n_operations = args.n_operations;
+ if (args.test)
+  {
+   sizes.clear();
+   sizes.push_back(100);
+   sizes.push_back(10000);
+   n_operations = 100000;
+  }
+
+ // Entries whose squares overflow and underflow (the three quarters
+ // of the exponent range of Real)
+ const Real large_value = std::pow(std::numeric_limits<Real>::max(), Real(0.75));
+ const Real small_value = std::pow(std::numeric_limits<Real>::min(), Real(0.75));
+
+ bool all_passed = true;
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   const unsigned long n = sizes[i];
+   const bool passed_dot = benchmark_dot(n, n_operations);
+   const bool passed_large = check_scaled_norm_2(n, large_value);
+   const bool passed_small = check_scaled_norm_2(n, small_value);
+   const bool passed_vector_and_view = check_vector_and_view(n);
+   output_test << n << " " << passed_dot << " " << passed_large << " "
+               << passed_small << " " << passed_vector_and_view << std::endl;
+   all_passed = all_passed && passed_dot && passed_large && passed_small && passed_vector_and_view;
+  }
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The reductions are not within the expected accuracy" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
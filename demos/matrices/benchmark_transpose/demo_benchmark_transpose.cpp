@@ -0,0 +1,183 @@
+// IN THIS FILE: Benchmark of the transpose of matrices. The previous
+// implementation (a loop that writes the transposed matrix with a
+// stride of n, plus a copy for the in-place version) is compared
+// against the cache-oblivious out-of-place transpose and the in-place
+// transposes of square (swap of tiles) and rectangular (cycle
+// following) matrices. The results of all versions are checked to be
+// the same
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The class to create matrices
+#include "../../../src/matrices/cc_matrix.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > sizes;
+};
+
+// ==================================================================
+// The previous implementation of the transpose
+// ==================================================================
+void strided_transpose(const CCMatrix<Real> &A, CCMatrix<Real> &B)
+{
+ const unsigned long n_rows = A.n_rows();
+ const unsigned long n_columns = A.n_columns();
+ B.allocate_memory(n_columns, n_rows);
+ const Real *A_pt = A.matrix_pt();
+ Real *B_pt = B.matrix_pt();
+ for (unsigned long i = 0; i < n_rows; i++)
+  {
+   for (unsigned long j = 0; j < n_columns; j++)
+    {
+     B_pt[j*n_rows+i] = A_pt[i*n_columns+j];
+    }
+  }
+}
+
+// ==================================================================
+// Fill the matrix with values that identify their position
+// ==================================================================
+void fill_matrix(CCMatrix<Real> &A)
+{
+ const unsigned long n_entries = A.n_rows() * A.n_columns();
+ Real *A_pt = A.matrix_pt();
+ for (unsigned long k = 0; k < n_entries; k++)
+  {
+   A_pt[k] = Real(k);
+  }
+}
+
+// ==================================================================
+// Are the matrices the same
+// ==================================================================
+bool same_matrices(const CCMatrix<Real> &A, const CCMatrix<Real> &B)
+{
+ if (A.n_rows() != B.n_rows() || A.n_columns() != B.n_columns())
+  {
+   return false;
+  }
+ return std::memcmp(A.matrix_pt(), B.matrix_pt(),
+                    A.n_rows() * A.n_columns() * sizeof(Real)) == 0;
+}
+
+// ==================================================================
+// Seconds elapsed since the given time
+// ==================================================================
+double seconds_since(clock_t initial_clock_time)
+{
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ return Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+}
+
+// ==================================================================
+// Benchmark the transposes of an m x n matrix. Returns true if all the
+// versions give the same result
+// ==================================================================
+bool benchmark_transpose(const unsigned long m, const unsigned long n)
+{
+ CCMatrix<Real> A(m, n);
+ fill_matrix(A);
+
+ // Reference
+ CCMatrix<Real> A_t_strided;
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ strided_transpose(A, A_t_strided);
+ const double seconds_strided = seconds_since(initial_clock_time);
+
+ // Out-of-place
+ CCMatrix<Real> A_t;
+ initial_clock_time = Timing::cpu_clock_time();
+ A.transpose(A_t);
+ const double seconds_out_of_place = seconds_since(initial_clock_time);
+ const bool passed_out_of_place = same_matrices(A_t_strided, A_t);
+
+ // In-place
+ initial_clock_time = Timing::cpu_clock_time();
+ A.transpose();
+ const double seconds_in_place = seconds_since(initial_clock_time);
+ const bool passed_in_place = same_matrices(A_t_strided, A);
+
+ const double giga_bytes = 2.0 * double(m) * double(n) * sizeof(Real) / 1.0e9;
+ std::cout << std::setw(6) << m << " x " << std::setw(6) << n
+           << " strided: " << std::setw(10) << seconds_strided << " s ("
+           << std::setw(6) << giga_bytes / seconds_strided << " GB/s)"
+           << " out-of-place: " << std::setw(10) << seconds_out_of_place << " s ("
+           << std::setw(6) << giga_bytes / seconds_out_of_place << " GB/s)"
+           << " in-place: " << std::setw(10) << seconds_in_place << " s ("
+           << std::setw(6) << giga_bytes / seconds_in_place << " GB/s)"
+           << ((passed_out_of_place && passed_in_place) ? "" : " (DIFFERENT RESULTS)")
+           << std::endl;
+
+ return passed_out_of_place && passed_in_place;
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the transpose of matrices");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.sizes, "--sizes")
+  .help("Number of rows of the matrices (square matrices and matrices with half the number of columns are transposed), 16384 requires about 6GB of memory")
+  .nargs('+')
+  .default_value({"1024", "2048", "4096", "8192"});
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ std::vector<unsigned long> sizes = args.sizes.value();
+ if (args.test)
+  {
+   sizes.clear();
+   sizes.push_back(37);
+   sizes.push_back(100);
+  }
+
+ bool all_passed = true;
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   const unsigned long n = sizes[i];
+   const bool passed_square = benchmark_transpose(n, n);
+   const bool passed_rectangular = benchmark_transpose(n, n / 2);
+   const bool passed_rectangular_transposed = benchmark_transpose(n / 2, n);
+   output_test << n << " " << passed_square << " " << passed_rectangular
+               << " " << passed_rectangular_transposed << std::endl;
+   all_passed = all_passed && passed_square && passed_rectangular &&
+    passed_rectangular_transposed;
+  }
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The results of the transposes differ" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
@@ -0,0 +1,252 @@
+// IN THIS FILE: Write matrices and vectors to binary files and read
+// them back by mapping the files into memory. The matrices and
+// vectors read use the mapped memory (no copies and no allocations),
+// files with wrong contents are rejected
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+
+// The class to create vectors and matrices
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+// The binary files
+#include "../../../src/matrices/cc_binary_file.h"
+
+using namespace scicellxx;
+
+// -------------------------------------------------------------------
+// Are the entries of both matrices equal
+// -------------------------------------------------------------------
+bool are_equal(const CCMatrix<Real> &A, const CCMatrix<Real> &B)
+{
+ if (A.n_rows() != B.n_rows() || A.n_columns() != B.n_columns())
+  {
+   return false;
+  }
+ for (unsigned long i = 0; i < A.n_rows(); i++)
+  {
+   for (unsigned long j = 0; j < A.n_columns(); j++)
+    {
+     if (A.value(i, j) != B.value(i, j))
+      {
+       return false;
+      }
+    }
+  }
+ return true;
+}
+
+// -------------------------------------------------------------------
+// Is the pointer within the mapped file
+// -------------------------------------------------------------------
+bool is_in_file(const void *pt, const CCBinaryFile &file)
+{
+ const char *data_pt = reinterpret_cast<const char*>(&file.header());
+ const char *char_pt = reinterpret_cast<const char*>(pt);
+ return char_pt >= data_pt && char_pt < data_pt + CCBinaryFile::Header_size +
+  file.header().Data_size;
+}
+
+// -------------------------------------------------------------------
+// Is the file rejected when read as a matrix with entries of type T
+// -------------------------------------------------------------------
+template<class T>
+bool is_rejected(const std::string &filename)
+{
+ try
+  {
+   CCBinaryFile file(filename);
+   CCMatrix<T> A;
+   file.map(A);
+  }
+ catch (const SciCellxxLibError &error)
+  {
+   return true;
+  }
+ return false;
+}
+
+// -------------------------------------------------------------------
+// Writes a file with only a header, of a matrix whose number of bytes
+// (rows * columns * entry size) overflows 64 bits and wraps to zero
+// -------------------------------------------------------------------
+void write_overflowing_header(const std::string &filename)
+{
+ CCBinaryFile::Header header;
+ std::memset(&header, 0, sizeof(header));
+ std::memcpy(header.Magic, "SCXXBIN", 8);
+ header.Version = CCBinaryFile::Version;
+ header.Endianness = 0x01020304;
+ header.Object = CCBinaryFile::MATRIX;
+ header.Entry_size = sizeof(Real);
+ header.N_rows = uint64_t(1) << 61;
+ header.N_columns = 8;
+ header.Data_offset = CCBinaryFile::Header_size;
+ header.Data_size = 0;
+ char padded_header[CCBinaryFile::Header_size];
+ std::memset(padded_header, 0, CCBinaryFile::Header_size);
+ std::memcpy(padded_header, &header, sizeof(header));
+ std::ofstream output_file(filename.c_str(), std::ios_base::out | std::ios_base::binary);
+ output_file.write(padded_header, CCBinaryFile::Header_size);
+ output_file.close();
+}
+
+// -------------------------------------------------------------------
+// 1 - Write and read a matrix stored by rows
+// 2 - Write and read a matrix stored by columns
+// 3 - Write and read a vector
+// 4 - Reject files with wrong contents
+// -------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ const unsigned long m = 3;
+ const unsigned long n = 4;
+ CCMatrix<Real> A(m, n);
+ for (unsigned long i = 0; i < m; i++)
+  {
+   for (unsigned long j = 0; j < n; j++)
+    {
+     A(i, j) = Real(i*n + j + 1) / 3.0;
+    }
+  }
+
+ // =============================================================
+ // Matrix stored by rows
+ // =============================================================
+ CCBinaryFile::write("matrix_rows.bin", A);
+ {
+  CCBinaryFile file("matrix_rows.bin");
+  CCMatrix<Real> A_read;
+  MemoryAllocator::reset_statistics();
+  file.map(A_read);
+  const bool no_allocations = MemoryAllocator::statistics().N_allocations == 0;
+  std::cout << std::endl << "Matrix stored by rows read from file" << std::endl << std::endl;
+  output_test << std::endl << "Matrix stored by rows read from file" << std::endl << std::endl;
+  A_read.output();
+  A_read.output(output_test);
+  std::cout << "Equal: " << are_equal(A, A_read)
+            << " Stored by columns: " << A_read.is_column_major()
+            << " Uses the mapped memory: " << is_in_file(A_read.matrix_pt(), file)
+            << " No allocations: " << no_allocations << std::endl;
+  output_test << "Equal: " << are_equal(A, A_read)
+              << " Stored by columns: " << A_read.is_column_major()
+              << " Uses the mapped memory: " << is_in_file(A_read.matrix_pt(), file)
+              << " No allocations: " << no_allocations << std::endl;
+
+  // Modifying the entries does not modify the file (private mapping)
+  A_read(0, 0) = -1.0;
+ }
+ {
+  CCBinaryFile file("matrix_rows.bin");
+  CCMatrix<Real> A_read;
+  file.map(A_read);
+  std::cout << "The file is not modified: " << (A_read(0, 0) == A(0, 0)) << std::endl;
+  output_test << "The file is not modified: " << (A_read(0, 0) == A(0, 0)) << std::endl;
+
+  // A copy of a mapped matrix owns its memory
+  CCMatrix<Real> A_copy(A_read);
+  std::cout << "The copy owns its memory: " << !A_copy.is_memory_shared() << std::endl;
+  output_test << "The copy owns its memory: " << !A_copy.is_memory_shared() << std::endl;
+ }
+
+ // =============================================================
+ // Matrix stored by columns
+ // =============================================================
+ CCMatrix<Real> A_c(A);
+ A_c.set_column_major(true);
+ CCBinaryFile::write("matrix_columns.bin", A_c);
+ {
+  CCBinaryFile file("matrix_columns.bin");
+  CCMatrix<Real> A_c_read;
+  file.map(A_c_read);
+  std::cout << std::endl << "Matrix stored by columns read from file" << std::endl << std::endl;
+  output_test << std::endl << "Matrix stored by columns read from file" << std::endl << std::endl;
+  A_c_read.output();
+  A_c_read.output(output_test);
+  std::cout << "Equal: " << are_equal(A, A_c_read)
+            << " Stored by columns: " << A_c_read.is_column_major()
+            << " Uses the mapped memory: " << is_in_file(A_c_read.matrix_pt(), file)
+            << std::endl;
+  output_test << "Equal: " << are_equal(A, A_c_read)
+              << " Stored by columns: " << A_c_read.is_column_major()
+              << " Uses the mapped memory: " << is_in_file(A_c_read.matrix_pt(), file)
+              << std::endl;
+ }
+
+ // =============================================================
+ // Vector
+ // =============================================================
+ CCVector<Real> x(5);
+ for (unsigned long i = 0; i < 5; i++)
+  {
+   x(i) = 1.0 / Real(i + 1);
+  }
+ CCBinaryFile::write("vector.bin", x);
+ {
+  CCBinaryFile file("vector.bin");
+  CCVector<Real> x_read;
+  file.map(x_read);
+  bool equal = x_read.n_values() == x.n_values();
+  for (unsigned long i = 0; equal && i < x.n_values(); i++)
+   {
+    equal = x_read(i) == x(i);
+   }
+  std::cout << std::endl << "Vector read from file" << std::endl << std::endl;
+  output_test << std::endl << "Vector read from file" << std::endl << std::endl;
+  x_read.output();
+  x_read.output(output_test);
+  std::cout << "Equal: " << equal
+            << " Uses the mapped memory: " << is_in_file(x_read.vector_pt(), file)
+            << std::endl;
+  output_test << "Equal: " << equal
+              << " Uses the mapped memory: " << is_in_file(x_read.vector_pt(), file)
+              << std::endl;
+ }
+
+ // =============================================================
+ // Wrong contents
+ // =============================================================
+ std::ofstream not_binary("not_binary.bin");
+ not_binary << "This file does not store a matrix in the binary format"
+            << " of the library, it is only text" << std::endl;
+ not_binary.close();
+ write_overflowing_header("overflow.bin");
+ const bool rejected[] = {is_rejected<Real>("not_binary.bin"),
+                          is_rejected<Real>("does_not_exist.bin"),
+                          is_rejected<Real>("vector.bin"),
+                          is_rejected<float>("matrix_rows.bin"),
+                          is_rejected<long>("matrix_rows.bin"),
+                          is_rejected<Real>("overflow.bin")};
+ const char *names[] = {"not a binary file", "missing file", "vector read as matrix",
+                        "wrong type of entries", "integer entries", "overflowing sizes"};
+ std::cout << std::endl << "Rejected files" << std::endl << std::endl;
+ output_test << std::endl << "Rejected files" << std::endl << std::endl;
+ for (unsigned i = 0; i < 6; i++)
+  {
+   std::cout << names[i] << ": " << rejected[i] << std::endl;
+   output_test << names[i] << ": " << rejected[i] << std::endl;
+  }
+
+ std::remove("matrix_rows.bin");
+ std::remove("matrix_columns.bin");
+ std::remove("vector.bin");
+ std::remove("not_binary.bin");
+ std::remove("overflow.bin");
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ return 0;
+
+}
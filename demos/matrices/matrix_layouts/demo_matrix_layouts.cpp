@@ -0,0 +1,226 @@
+#include <iostream>
+#include <cmath>
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+
+// The class to create vectors and matrices
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+// The factory to create matrices stored by columns
+#include "../../../src/matrices/cc_factory_matrices.h"
+// The linear solver
+#include "../../../src/linear_solvers/cc_lu_solver_numerical_recipes.h"
+
+#ifdef SCICELLXX_USES_ARMADILLO
+// Armadillo's matrices and vectors, they share the memory of column
+// major matrices and of vectors with no copies
+#include "../../../src/matrices/cc_matrix_armadillo.h"
+#include "../../../src/matrices/cc_vector_armadillo.h"
+// Armadillo's solver
+#include "../../../src/linear_solvers/cc_solver_armadillo.h"
+#endif // #ifdef SCICELLXX_USES_ARMADILLO
+
+using namespace scicellxx;
+
+// -------------------------------------------------------------------
+// Largest absolute difference between the entries of two matrices
+// (that may be stored in different order)
+// -------------------------------------------------------------------
+Real max_difference(const CCMatrix<Real> &A, const CCMatrix<Real> &B)
+{
+ Real max = 0.0;
+ for (unsigned long i = 0; i < A.n_rows(); i++)
+  {
+   for (unsigned long j = 0; j < A.n_columns(); j++)
+    {
+     max = std::max(max, std::fabs(A.value(i, j) - B.value(i, j)));
+    }
+  }
+ return max;
+}
+
+// -------------------------------------------------------------------
+// 1 - Change the order in which the entries of a matrix are stored
+// 2 - Operate with matrices stored by columns and compare with the
+//     same operations on matrices stored by rows
+// 3 - Solve a system whose matrix is stored by columns
+// -------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ // =============================================================
+ // Change the order of the entries
+ // =============================================================
+ const unsigned long m = 3;
+ const unsigned long n = 4;
+ CCMatrix<Real> A(m, n);
+ CCMatrix<Real> B(n, m);
+ for (unsigned long i = 0; i < m; i++)
+  {
+   for (unsigned long j = 0; j < n; j++)
+    {
+     A(i, j) = Real(i*n + j + 1);
+     B(j, i) = 1.0 - Real(i + 2*j);
+    }
+  }
+
+ CCMatrix<Real> A_c(A);
+ A_c.set_column_major(true);
+ CCVector<Real> A_c_storage(A_c.matrix_pt(), m*n);
+ std::cout << std::endl << "Matrix stored by columns and its storage" << std::endl << std::endl;
+ output_test << std::endl << "Matrix stored by columns and its storage" << std::endl << std::endl;
+ A_c.output();
+ A_c.output(output_test);
+ A_c_storage.output();
+ A_c_storage.output(output_test);
+
+ // =============================================================
+ // Operations on matrices stored by columns
+ // =============================================================
+ CCMatrix<Real> B_c(B);
+ B_c.set_column_major(true);
+
+ // Product
+ CCMatrix<Real> AB = A * B;
+ CCMatrix<Real> AB_c = A_c * B_c;
+
+ // Transposes (in place and into another matrix)
+ CCMatrix<Real> A_t;
+ A.transpose(A_t);
+ CCMatrix<Real> A_c_t;
+ A_c.transpose(A_c_t);
+ CCMatrix<Real> A_c_t_in_place(A_c);
+ A_c_t_in_place.transpose();
+
+ // Expressions
+ CCMatrix<Real> E = A + 2.0 * A;
+ CCMatrix<Real> E_c = A_c + 2.0 * A_c;
+
+ // Vertical concatenation
+ CCMatrix<Real> V;
+ CCMatrix<Real> V_c;
+ concatenate_matrices_vertically(A, A, V);
+ concatenate_matrices_vertically(A_c, A_c, V_c);
+
+ // Matrix times vector
+ CCVector<Real> x(n);
+ for (unsigned long j = 0; j < n; j++)
+  {
+   x(j) = 1.0 / Real(j + 1);
+  }
+ CCVector<Real> Ax;
+ CCVector<Real> A_cx;
+ multiply_matrix_times_vector(A, x, Ax);
+ multiply_matrix_times_vector(A_c, x, A_cx);
+ CCMatrix<Real> Ax_matrix(Ax);
+ CCMatrix<Real> A_cx_matrix(A_cx);
+
+ std::cout << std::endl << "Product of matrices stored by columns" << std::endl << std::endl;
+ output_test << std::endl << "Product of matrices stored by columns" << std::endl << std::endl;
+ AB_c.output();
+ AB_c.output(output_test);
+
+ std::cout << std::endl << "Differences with the matrices stored by rows" << std::endl << std::endl;
+ output_test << std::endl << "Differences with the matrices stored by rows" << std::endl << std::endl;
+ const Real differences[] = {max_difference(AB, AB_c),
+                             max_difference(A_t, A_c_t),
+                             max_difference(A_t, A_c_t_in_place),
+                             max_difference(E, E_c),
+                             max_difference(V, V_c),
+                             max_difference(Ax_matrix, A_cx_matrix)};
+ const char *names[] = {"product", "transpose", "transpose in place",
+                        "expression", "vertical concatenation",
+                        "matrix times vector"};
+ for (unsigned i = 0; i < 6; i++)
+  {
+   std::cout << names[i] << ": " << differences[i] << std::endl;
+   output_test << names[i] << ": " << differences[i] << std::endl;
+  }
+
+ // The results are stored by columns as the operands
+ std::cout << "The results are stored by columns: "
+           << (AB_c.is_column_major() && A_c_t.is_column_major() &&
+               E_c.is_column_major()) << std::endl;
+ output_test << "The results are stored by columns: "
+             << (AB_c.is_column_major() && A_c_t.is_column_major() &&
+                 E_c.is_column_major()) << std::endl;
+
+ // Operating matrices stored in different order is not allowed
+ bool mixed_order_rejected = false;
+ try
+  {
+   CCMatrix<Real> mixed;
+   multiply_matrices(A, B_c, mixed);
+  }
+ catch (const SciCellxxLibError &error)
+  {
+   mixed_order_rejected = true;
+  }
+ std::cout << "Matrices stored in different order are rejected: "
+           << mixed_order_rejected << std::endl;
+ output_test << "Matrices stored in different order are rejected: "
+             << mixed_order_rejected << std::endl;
+
+ // =============================================================
+ // Solve a system whose matrix is stored by columns
+ // =============================================================
+ CCFactoryMatrices<Real> factory_matrices;
+ ACMatrix<Real> *K_pt = factory_matrices.create_matrix("column_major", 3, 3);
+ Real K_entries[] = {4.0, 1.0, 0.0,
+                     1.0, 4.0, 1.0,
+                     0.0, 2.0, 4.0};
+ for (unsigned long i = 0; i < 3; i++)
+  {
+   for (unsigned long j = 0; j < 3; j++)
+    {
+     K_pt->value(i, j) = K_entries[i*3 + j];
+    }
+  }
+ CCVector<Real> rhs(3);
+ rhs(0) = 6.0;
+ rhs(1) = 12.0;
+ rhs(2) = 16.0;
+ CCVector<Real> solution(3);
+ CCLUSolverNumericalRecipes lu_solver;
+ lu_solver.solve(K_pt, &rhs, &solution);
+ std::cout << std::endl << "Solution of the system stored by columns" << std::endl << std::endl;
+ output_test << std::endl << "Solution of the system stored by columns" << std::endl << std::endl;
+ solution.output();
+ solution.output(output_test);
+
+#ifdef SCICELLXX_USES_ARMADILLO
+ // Armadillo's matrix and vectors share the memory of the matrix
+ // stored by columns, the right-hand side and the solution, no entries
+ // are copied
+ CCVector<Real> armadillo_solution(3);
+ CCMatrixArmadillo<Real> K_armadillo;
+ K_armadillo.share_matrix(*dynamic_cast<CCMatrix<Real>*>(K_pt));
+ CCVectorArmadillo<Real> rhs_armadillo;
+ rhs_armadillo.share_vector(rhs);
+ CCVectorArmadillo<Real> solution_armadillo;
+ solution_armadillo.share_vector(armadillo_solution);
+ CCSolverArmadillo armadillo_solver;
+ armadillo_solver.solve(&K_armadillo, &rhs_armadillo, &solution_armadillo);
+ std::cout << std::endl << "Solution computed by Armadillo" << std::endl << std::endl;
+ armadillo_solution.output();
+#endif // #ifdef SCICELLXX_USES_ARMADILLO
+
+ delete K_pt;
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ return 0;
+
+}
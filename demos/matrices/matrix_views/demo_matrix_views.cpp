@@ -0,0 +1,194 @@
+#include <iostream>
+#include <cmath>
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+
+// The class to create vectors and matrices
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+// Views of vectors and matrices
+#include "../../../src/matrices/cc_vector_view.h"
+#include "../../../src/matrices/cc_matrix_view.h"
+// The linear solver
+#include "../../../src/linear_solvers/cc_lu_solver_numerical_recipes.h"
+
+using namespace scicellxx;
+
+// -------------------------------------------------------------------
+// 1 - Rows, columns and sub-blocks of a matrix as views
+// 2 - Assemble a block-structured matrix [A B; C D] through views of
+//     its blocks and compare with the concatenation of the blocks
+// 3 - Operate on the state of each body of a multi-body state vector
+//     through views of its segments
+// 4 - Solve a system whose matrix is a sub-block of a larger matrix
+//     and whose solution is a segment of a larger vector
+// -------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ // =============================================================
+ // Rows, columns and sub-blocks
+ // =============================================================
+ const unsigned long n = 4;
+ CCMatrix<Real> M(n, n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   for (unsigned long j = 0; j < n; j++)
+    {
+     M(i, j) = Real(i*n + j);
+    }
+  }
+
+ CCMatrixView<Real> M_view(M);
+ CCVectorView<Real> row_2 = M_view.row(2);
+ CCVectorView<Real> column_1 = M_view.column(1);
+ std::cout << std::endl << "Row 2 and column 1" << std::endl << std::endl;
+ output_test << std::endl << "Row 2 and column 1" << std::endl << std::endl;
+ row_2.output();
+ row_2.output(output_test);
+ column_1.output();
+ column_1.output(output_test);
+ std::cout << "norm_2(column 1): " << column_1.norm_2() << std::endl;
+ output_test << "norm_2(column 1): " << column_1.norm_2() << std::endl;
+
+ // Scale the central 2 x 2 block, the entries of M are modified
+ CCMatrixView<Real> centre(M, 1, 1, 2, 2);
+ centre.scale(-1.0);
+ std::cout << std::endl << "Matrix with the central block scaled by -1"
+           << std::endl << std::endl;
+ output_test << std::endl << "Matrix with the central block scaled by -1"
+             << std::endl << std::endl;
+ M.output();
+ M.output(output_test);
+
+ // =============================================================
+ // Block-structured matrix
+ // =============================================================
+ const unsigned long m_a = 2;
+ const unsigned long m_c = 3;
+ const unsigned long n_a = 3;
+ const unsigned long n_b = 2;
+ CCMatrix<Real> A(m_a, n_a);
+ CCMatrix<Real> B(m_a, n_b);
+ CCMatrix<Real> C(m_c, n_a);
+ CCMatrix<Real> D(m_c, n_b);
+ A.fill_with_zeroes();
+ B.fill_with_zeroes();
+ C.fill_with_zeroes();
+ D.fill_with_zeroes();
+ for (unsigned long i = 0; i < m_a; i++)
+  {
+   for (unsigned long j = 0; j < n_a; j++) {A(i, j) = 1.0 + i + j;}
+   for (unsigned long j = 0; j < n_b; j++) {B(i, j) = 10.0 + i - j;}
+  }
+ for (unsigned long i = 0; i < m_c; i++)
+  {
+   for (unsigned long j = 0; j < n_a; j++) {C(i, j) = 1.0 - (i + 2.0*j);}
+   for (unsigned long j = 0; j < n_b; j++) {D(i, j) = 0.5 * (i + 1) * (j + 1);}
+  }
+
+ // Assemble through views of the blocks (no temporaries)
+ CCMatrix<Real> J(m_a + m_c, n_a + n_b);
+ CCMatrixView<Real> J_view(J);
+ J_view.block(0, 0, m_a, n_a).copy(A);
+ J_view.block(0, n_a, m_a, n_b).copy(B);
+ J_view.block(m_a, 0, m_c, n_a).copy(C);
+ J_view.block(m_a, n_a, m_c, n_b).copy(D);
+
+ // Assemble by concatenation
+ CCMatrix<Real> AB;
+ CCMatrix<Real> CD;
+ CCMatrix<Real> J_concatenated;
+ concatenate_matrices_horizontally(A, B, AB);
+ concatenate_matrices_horizontally(C, D, CD);
+ concatenate_matrices_vertically(AB, CD, J_concatenated);
+
+ CCMatrix<Real> J_difference;
+ J.substract_matrix(J_concatenated, J_difference);
+ std::cout << std::endl << "Block matrix assembled through views" << std::endl << std::endl;
+ output_test << std::endl << "Block matrix assembled through views" << std::endl << std::endl;
+ J.output();
+ J.output(output_test);
+ CCVector<Real> difference(J_difference.matrix_pt(),
+                           J_difference.n_rows()*J_difference.n_columns());
+ std::cout << "Difference with the concatenated matrix: "
+           << difference.norm_inf() << std::endl;
+ output_test << "Difference with the concatenated matrix: "
+             << difference.norm_inf() << std::endl;
+
+ // =============================================================
+ // Multi-body state vector, three bodies with position and
+ // velocity in 3D
+ // =============================================================
+ const unsigned long n_bodies = 3;
+ const unsigned long n_state = 6;
+ CCVector<Real> state(n_bodies*n_state);
+ CCVector<Real> rates(n_bodies*n_state);
+ for (unsigned long k = 0; k < n_bodies*n_state; k++)
+  {
+   state(k) = Real(k);
+   rates(k) = 1.0;
+  }
+
+ // Update each body with its own step size through views of its
+ // segment, the position of each body is a view with stride one and
+ // the x-components of all the bodies are a view with stride n_state
+ const Real h[] = {0.5, 0.25, 0.125};
+ for (unsigned long b = 0; b < n_bodies; b++)
+  {
+   CCVectorView<Real> body_state(state, b*n_state, n_state);
+   CCVectorView<Real> body_rates(rates, b*n_state, n_state);
+   body_state.axpy(h[b], body_rates);
+  }
+ CCVectorView<Real> x_components(state.vector_pt(), n_bodies, n_state);
+ std::cout << std::endl << "State after the update and x-components of the bodies"
+           << std::endl << std::endl;
+ output_test << std::endl << "State after the update and x-components of the bodies"
+             << std::endl << std::endl;
+ state.output();
+ state.output(output_test);
+ x_components.output();
+ x_components.output(output_test);
+
+ // =============================================================
+ // Solve a system on a sub-block
+ // =============================================================
+ CCMatrix<Real> big(4, 4);
+ Real big_entries[] = {9.0, 9.0, 9.0, 9.0,
+                       9.0, 4.0, 1.0, 9.0,
+                       9.0, 2.0, 3.0, 9.0,
+                       9.0, 9.0, 9.0, 9.0};
+ big.set_matrix(big_entries, 4, 4);
+ CCMatrixView<Real> system_matrix(big, 1, 1, 2, 2);
+ CCVector<Real> rhs(2);
+ rhs(0) = 6.0;
+ rhs(1) = 8.0;
+ CCVector<Real> solution(5);
+ solution.fill_with_zeroes();
+ CCVectorView<Real> solution_segment(solution, 2, 2);
+ CCLUSolverNumericalRecipes lu_solver;
+ lu_solver.solve(&system_matrix, &rhs, &solution_segment);
+ std::cout << std::endl << "Solution stored in a segment of a larger vector"
+           << std::endl << std::endl;
+ output_test << std::endl << "Solution stored in a segment of a larger vector"
+             << std::endl << std::endl;
+ solution.output();
+ solution.output(output_test);
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ return 0;
+
+}
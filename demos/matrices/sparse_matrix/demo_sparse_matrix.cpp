@@ -0,0 +1,215 @@
+#include <iostream>
+#include <cmath>
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+
+// The class to create vectors and matrices
+#include "../../../src/matrices/cc_vector.h"
+#include "../../../src/matrices/cc_matrix.h"
+#include "../../../src/matrices/cc_sparse_matrix.h"
+// The factory to create matrices
+#include "../../../src/matrices/cc_factory_matrices.h"
+
+using namespace scicellxx;
+
+// -------------------------------------------------------------------
+// Are the CSR arrays of a 2 X 3 matrix with four non-zero entries
+// rejected
+// -------------------------------------------------------------------
+bool is_rejected(const unsigned long *row_start_pt,
+                 const unsigned long *column_index_pt)
+{
+ const Real values[] = {1.0, 2.0, 3.0, 4.0};
+ try
+  {
+   CCSparseMatrix<Real> A(2, 3, 4, row_start_pt, column_index_pt, values);
+  }
+ catch (const SciCellxxLibError &error)
+  {
+   return true;
+  }
+ return false;
+}
+
+// -------------------------------------------------------------------
+// 1 - Create a sparse matrix (tridiagonal) from triplets
+// 2 - Sparse matrix times vector and sparse times dense matrix
+// 3 - Permute rows and columns
+// 4 - Create a sparse matrix from a dense one and by the factory
+// 5 - Reject inconsistent CSR arrays
+// -------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ // =============================================================
+ // Create a tridiagonal matrix from triplets, the diagonal entries
+ // are added twice to show that repeated entries are added
+ // =============================================================
+ const unsigned long n = 6;
+ CCSparseMatrixBuilder<Real> builder(n, n);
+ builder.reserve(4*n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   builder.add_entry(i, i, 1.0);
+   builder.add_entry(i, i, 1.0);
+   if (i > 0)
+    {
+     builder.add_entry(i, i-1, -1.0);
+    }
+   if (i + 1 < n)
+    {
+     builder.add_entry(i, i+1, -(i + 1.0));
+    }
+  }
+
+ CCSparseMatrix<Real> A;
+ builder.build(A);
+ std::cout << std::endl << "Sparse matrix (n_non_zeros: "
+           << A.n_non_zeros() << ")" << std::endl << std::endl;
+ output_test << std::endl << "Sparse matrix (n_non_zeros: "
+             << A.n_non_zeros() << ")" << std::endl << std::endl;
+ A.output(true);
+ A.output(output_test, true);
+
+ // Modify an entry in the sparsity pattern
+ A(0,0) = 4.0;
+ std::cout << std::endl << "Sparse matrix as dense" << std::endl << std::endl;
+ output_test << std::endl << "Sparse matrix as dense" << std::endl << std::endl;
+ A.output();
+ A.output(output_test);
+
+ // =============================================================
+ // Sparse matrix times vector
+ // =============================================================
+ CCVector<Real> x(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   x(i) = i + 1.0;
+  }
+ CCVector<Real> y;
+ multiply_matrix_times_vector(A, x, y);
+ std::cout << std::endl << "Sparse matrix times vector" << std::endl << std::endl;
+ output_test << std::endl << "Sparse matrix times vector" << std::endl << std::endl;
+ y.output();
+ y.output(output_test);
+
+ // Compare with the dense product
+ CCMatrix<Real> A_dense;
+ A.to_dense(A_dense);
+ CCVector<Real> y_dense;
+ multiply_matrix_times_vector(A_dense, x, y_dense);
+ Real max_difference = 0.0;
+ for (unsigned long i = 0; i < n; i++)
+  {
+   max_difference = std::max(max_difference, std::fabs(y(i) - y_dense(i)));
+  }
+ std::cout << std::endl << "Maximum difference with dense product: "
+           << max_difference << std::endl;
+ output_test << std::endl << "Maximum difference with dense product: "
+             << max_difference << std::endl;
+
+ // =============================================================
+ // Sparse matrix times dense matrix
+ // =============================================================
+ CCMatrix<Real> B(n, 2);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   B(i,0) = 1.0;
+   B(i,1) = i;
+  }
+ CCMatrix<Real> C;
+ multiply_matrices(A, B, C);
+ std::cout << std::endl << "Sparse matrix times dense matrix" << std::endl << std::endl;
+ output_test << std::endl << "Sparse matrix times dense matrix" << std::endl << std::endl;
+ C.output();
+ C.output(output_test);
+
+ // =============================================================
+ // Permutations
+ // =============================================================
+ A.permute_rows(0, 5);
+ std::cout << std::endl << "Permute rows 0 and 5" << std::endl << std::endl;
+ output_test << std::endl << "Permute rows 0 and 5" << std::endl << std::endl;
+ A.output();
+ A.output(output_test);
+
+ std::vector<std::pair<unsigned long, unsigned long> > permute_list;
+ permute_list.push_back(std::make_pair(0, 5));
+ permute_list.push_back(std::make_pair(1, 2));
+ A.permute_columns(permute_list);
+ std::cout << std::endl << "Permute columns (0, 5) and (1, 2)" << std::endl << std::endl;
+ output_test << std::endl << "Permute columns (0, 5) and (1, 2)" << std::endl << std::endl;
+ A.output();
+ A.output(output_test);
+
+ // =============================================================
+ // Sparse matrix from a dense matrix and by the factory
+ // =============================================================
+ Real dense_entries[] = {0.0, 2.0, 0.0,
+                         1.0, 0.0, 0.0,
+                         0.0, 0.0, 3.0};
+ CCSparseMatrix<Real> D(dense_entries, 3, 3);
+ std::cout << std::endl << "Sparse matrix from dense (n_non_zeros: "
+           << D.n_non_zeros() << ")" << std::endl << std::endl;
+ output_test << std::endl << "Sparse matrix from dense (n_non_zeros: "
+             << D.n_non_zeros() << ")" << std::endl << std::endl;
+ D.output(true);
+ D.output(output_test, true);
+
+ CCFactoryMatrices<Real> factory_matrices;
+ ACMatrix<Real> *E_pt = factory_matrices.create_matrix("sparse", 3, 3);
+ CCSparseMatrix<Real> *E_sparse_pt = dynamic_cast<CCSparseMatrix<Real>*>(E_pt);
+ E_sparse_pt->set_matrix(dense_entries, 3, 3);
+ // Entries out of the sparsity pattern are read as zero
+ const ACMatrix<Real> &E = *E_pt;
+ std::cout << std::endl << "Sparse matrix created by the factory (entry (2,2): "
+           << E.value(2,2) << ", entry (2,1): " << E.value(2,1) << ")"
+           << std::endl;
+ output_test << std::endl << "Sparse matrix created by the factory (entry (2,2): "
+             << E.value(2,2) << ", entry (2,1): " << E.value(2,1) << ")"
+             << std::endl;
+ delete E_pt;
+
+ // =============================================================
+ // Reject CSR arrays whose row start array decreases or whose
+ // column indices are not sorted, are repeated in a row or are out
+ // of range
+ // =============================================================
+ const unsigned long row_start[] = {0, 2, 4};
+ const unsigned long decreasing_row_start[] = {0, 5, 4};
+ const unsigned long sorted_columns[] = {0, 2, 1, 2};
+ const unsigned long unsorted_columns[] = {2, 0, 1, 2};
+ const unsigned long repeated_columns[] = {0, 2, 1, 1};
+ const unsigned long out_of_range_columns[] = {0, 2, 1, 3};
+ const bool rejected[] = {is_rejected(row_start, sorted_columns),
+                          is_rejected(decreasing_row_start, sorted_columns),
+                          is_rejected(row_start, unsorted_columns),
+                          is_rejected(row_start, repeated_columns),
+                          is_rejected(row_start, out_of_range_columns)};
+ const char *names[] = {"consistent arrays", "decreasing row start", "unsorted columns",
+                        "repeated columns", "columns out of range"};
+ std::cout << std::endl << "Rejected CSR arrays" << std::endl << std::endl;
+ output_test << std::endl << "Rejected CSR arrays" << std::endl << std::endl;
+ for (unsigned i = 0; i < 5; i++)
+  {
+   std::cout << names[i] << ": " << rejected[i] << std::endl;
+   output_test << names[i] << ": " << rejected[i] << std::endl;
+  }
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ return 0;
+
+}
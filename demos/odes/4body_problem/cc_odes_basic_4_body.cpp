@@ -13,6 +13,19 @@ namespace scicellxx
                             // body
     N_bodies(n_bodies)
  {  
+  // The positions of the bodies are stored in fixed size vectors
+  if (N_bodies > NBODIES)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "This implementation supports up to " << NBODIES
+                  << " bodies\n"
+                  << "n_bodies = " << N_bodies << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                           SCICELLXX_CURRENT_FUNCTION,
+                           SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
   // Resize the vector storing the masses
   M.resize(N_bodies);
   // Resize the vector storing the gravity
@@ -87,71 +100,45 @@ namespace scicellxx
   // dudt(22) z-velocity of the 4th body
   // dudt(23) z-acceleration of the 4th body
 
-  // A 3D matrix that stores the difference in position of each body
-  // within each body for each dimension
-  std::vector<std::vector<std::vector<Real> > > diff_positions(N_bodies);
-  
-  // Resize and compute the difference between each body's position
+  // The position of each body, the d-th coordinate of the i-th body
+  // is stored in u(6*i+2*d,0) and its velocity in u(6*i+2*d+1,0). The
+  // fixed vectors are stored in the stack, no memory is allocated
+  CCFixedVector<Real, DIM> positions[NBODIES];
   for (unsigned i = 0; i < N_bodies; i++)
    {
-    diff_positions[i].resize(N_bodies);
-    for (unsigned j = 0; j < N_bodies; j++)
+    for (unsigned d = 0; d < DIM; d++)
      {
-      diff_positions[i][j].resize(DIM);
-      diff_positions[i][j][0] = u(6*i+0,0) - u(6*j+0,0);
-      diff_positions[i][j][1] = u(6*i+2,0) - u(6*j+2,0);
-      diff_positions[i][j][2] = u(6*i+4,0) - u(6*j+4,0);
-     } // for (j < N_bodies)
+      positions[i](d) = u(6*i+2*d,0);
+     } // for (d < DIM)
    } // for (i < N_bodies)
-
-  // Store the sum of the difference between bodies positions
+  
+  // Compute the sum of the difference between bodies positions
   // multiplied by the masses of each body and the gravitational
   // constant
   // \sum_{j=1}^N, with i!=j G m_{j} (x_i-x_j) / ||x_i-x_j||^3
-  
-  std::vector<std::vector<Real> > norm_cubed(N_bodies);
   for (unsigned i = 0; i < N_bodies; i++)
    {
-    // Resize and initialise norm to zero
-    norm_cubed[i].resize(N_bodies, 0);
+    CCFixedVector<Real, DIM> acceleration;
     for (unsigned j = 0; j < N_bodies; j++)
      {
       if (i != j)
        {
+        const CCFixedVector<Real, DIM> diff_positions = positions[i] - positions[j];
+        const Real norm = diff_positions.norm_2();
+        const Real norm_cubed = norm * norm * norm;
         for (unsigned d = 0; d < DIM; d++)
          {
-          norm_cubed[i][j]+=(diff_positions[i][j][d]*diff_positions[i][j][d]);
+          acceleration(d)+= (m(j) * diff_positions(d)) / norm_cubed;
          } // for (d < DIM)
-        norm_cubed[i][j] = sqrt(norm_cubed[i][j]);
-        norm_cubed[i][j] = norm_cubed[i][j] * norm_cubed[i][j] * norm_cubed[i][j];
        } // if (i != j)
      } // for (j < N_bodies)
-   } // for (i < N_bodies) 
-  
-  dudt(0) = u(1,0);
-  dudt(1) = (((m(1) * diff_positions[0][1][0]) / norm_cubed[0][1]) + ((m(2) * diff_positions[0][2][0]) / norm_cubed[0][2]) + ((m(3) * diff_positions[0][3][0]) / norm_cubed[0][3])) * g(0);
-  dudt(2) = u(3,0);
-  dudt(3) = (((m(1) * diff_positions[0][1][1]) / norm_cubed[0][1]) + ((m(2) * diff_positions[0][2][1]) / norm_cubed[0][2]) + ((m(3) * diff_positions[0][3][1]) / norm_cubed[0][3])) * g(0);
-  dudt(4) = u(5,0);
-  dudt(5) = (((m(1) * diff_positions[0][1][2]) / norm_cubed[0][1]) + ((m(2) * diff_positions[0][2][2]) / norm_cubed[0][2]) + ((m(3) * diff_positions[0][3][2]) / norm_cubed[0][3])) * g(0);
-  dudt(6) = u(7,0);
-  dudt(7) = (((m(0) * diff_positions[1][0][0]) / norm_cubed[1][0]) + ((m(2) * diff_positions[1][2][0]) / norm_cubed[1][2]) + ((m(3) * diff_positions[1][3][0]) / norm_cubed[1][3])) * g(1);
-  dudt(8) = u(9,0);
-  dudt(9) = (((m(0) * diff_positions[1][0][1]) / norm_cubed[1][0]) + ((m(2) * diff_positions[1][2][1]) / norm_cubed[1][2]) + ((m(3) * diff_positions[1][3][1]) / norm_cubed[1][3])) * g(1);
-  dudt(10) = u(11,0);
-  dudt(11) = (((m(0) * diff_positions[1][0][2]) / norm_cubed[1][0]) + ((m(2) * diff_positions[1][2][2]) / norm_cubed[1][2]) + ((m(3) * diff_positions[1][3][2]) / norm_cubed[1][3])) * g(1);
-  dudt(12) = u(13,0);
-  dudt(13) = (((m(0) * diff_positions[2][0][0]) / norm_cubed[2][0]) + ((m(1) * diff_positions[2][1][0]) / norm_cubed[2][1]) + ((m(3) * diff_positions[2][3][0]) / norm_cubed[2][3])) * g(2);
-  dudt(14) = u(15,0);
-  dudt(15) = (((m(0) * diff_positions[2][0][1]) / norm_cubed[2][0]) + ((m(1) * diff_positions[2][1][1]) / norm_cubed[2][1]) + ((m(3) * diff_positions[2][3][1]) / norm_cubed[2][3])) * g(2);
-  dudt(16) = u(17,0);
-  dudt(17) = (((m(0) * diff_positions[2][0][2]) / norm_cubed[2][0]) + ((m(1) * diff_positions[2][1][2]) / norm_cubed[2][1]) + ((m(3) * diff_positions[2][3][2]) / norm_cubed[2][3])) * g(2);
-  dudt(18) = u(19,0);
-  dudt(19) = (((m(0) * diff_positions[3][0][0]) / norm_cubed[3][0]) + ((m(1) * diff_positions[3][1][0]) / norm_cubed[3][1]) + ((m(2) * diff_positions[3][2][0]) / norm_cubed[3][2])) * g(3);
-  dudt(20) = u(21,0);
-  dudt(21) = (((m(0) * diff_positions[3][0][1]) / norm_cubed[3][0]) + ((m(1) * diff_positions[3][1][1]) / norm_cubed[3][1]) + ((m(2) * diff_positions[3][2][1]) / norm_cubed[3][2])) * g(3);
-  dudt(22) = u(23,0);
-  dudt(23) = (((m(0) * diff_positions[3][0][2]) / norm_cubed[3][0]) + ((m(1) * diff_positions[3][1][2]) / norm_cubed[3][1]) + ((m(2) * diff_positions[3][2][2]) / norm_cubed[3][2])) * g(3);
+    
+    for (unsigned d = 0; d < DIM; d++)
+     {
+      dudt(6*i+2*d) = u(6*i+2*d+1,0);
+      dudt(6*i+2*d+1) = acceleration(d) * g(i);
+     } // for (d < DIM)
+   } // for (i < N_bodies)
   
 #if 0
    dudt(0) = u(1,0);
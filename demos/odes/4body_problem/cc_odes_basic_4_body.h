@@ -9,6 +9,8 @@
 #include "../../../src/data_structures/cc_data.h"
 // The class implementing the interfaces for the ODEs
 #include "../../../src/data_structures/ac_odes.h"
+// Fixed size vectors for the positions of the bodies
+#include "../../../src/matrices/cc_fixed_vector.h"
 
 // The dimension of the problem, the number of coordinates for the
 // n-bodies
@@ -0,0 +1,283 @@
+// IN THIS FILE: Benchmark of the pool of the factory of matrices and
+// vectors. The temporaries of a time step (or a Newton's iteration)
+// are created with create_vector() and deleted on each iteration,
+// and then taken from the pool with acquire_vector() and given back
+// by the handles. The number of calls to the allocator of the entries
+// and the number of objects created once the pool is warm are
+// reported. The predictor-corrector time steppers are checked to
+// create no vectors after their first time step
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The factory with the pool
+#include "../../../src/matrices/cc_factory_matrices.h"
+// The time steppers that use the pool of their factory
+#include "../../../src/time_steppers/cc_backward_euler_predictor_corrector_method.h"
+#include "../../../src/time_steppers/cc_adams_moulton_2_predictor_corrector_method.h"
+// The class used to store the values of u and dudt
+#include "../../../src/data_structures/cc_data.h"
+// The class implementing the interfaces for the ODEs
+#include "../../../src/data_structures/ac_odes.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > sizes;
+ argparse::ArgValue<unsigned> repetitions;
+};
+
+// ==================================================================
+// Decoupled decays du_i/dt = -(1 + i/n) u_i
+// ==================================================================
+class CCDecayODEs : public virtual ACODEs
+{
+
+public:
+
+ /// Constructor
+ CCDecayODEs(const unsigned n_odes)
+  : ACODEs(n_odes)
+ {
+
+ }
+
+ /// Empty destructor
+ virtual ~CCDecayODEs()
+ {
+
+ }
+
+ /// Evaluates the system of odes at time 't', using the history
+ /// values of u at index k
+ void evaluate_derivatives(const Real t, CCData &u, CCData &dudt, const unsigned k = 0)
+ {
+  const unsigned n = this->n_odes();
+  for (unsigned i = 0; i < n; i++)
+   {
+    dudt(i) = -(1.0 + Real(i) / Real(n)) * u(i,k);
+   }
+ }
+
+protected:
+
+ /// Copy constructor (we do not want this class to be
+ /// copiable). Check
+ /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+ CCDecayODEs(const CCDecayODEs &copy)
+  : ACODEs(copy)
+ {
+  BrokenCopy::broken_copy("CCDecayODEs");
+ }
+
+ /// Assignment operator (we do not want this class to be
+ /// copiable). Check
+ /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+ void operator=(const CCDecayODEs &copy)
+ {
+  BrokenCopy::broken_assign("CCDecayODEs");
+ }
+
+};
+
+// ==================================================================
+// Gives access to the counters of the pool of the time stepper
+// ==================================================================
+template<class TIME_STEPPER>
+class CCTimeStepperWithPoolCounters : public TIME_STEPPER
+{
+
+public:
+
+ /// The number of vectors created by the pool of the factory
+ unsigned long n_objects_created_for_pool() const
+ {return this->Factory_matrices_and_vectors.n_objects_created_for_pool();}
+
+};
+
+// ==================================================================
+// Seconds elapsed since the given time
+// ==================================================================
+double seconds_since(clock_t initial_clock_time)
+{
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ return Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+}
+
+// ==================================================================
+// Create and delete (or acquire and give back) the two vectors of
+// size n used on each iteration. Returns the number of calls to the
+// allocator per iteration once the pool is warm
+// ==================================================================
+double benchmark_temporaries(CCFactoryMatrices<Real> &factory,
+                             const unsigned long n,
+                             const unsigned repetitions,
+                             const bool use_pool,
+                             Real &sum)
+{
+ // Warm up the pool
+ {
+  CCFactoryMatrices<Real>::Pooled_vector dx = factory.acquire_vector("default", n);
+  CCFactoryMatrices<Real>::Pooled_vector error = factory.acquire_vector("default", n);
+ }
+
+ MemoryAllocator::reset_statistics();
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned r = 0; r < repetitions; r++)
+  {
+   if (use_pool)
+    {
+     CCFactoryMatrices<Real>::Pooled_vector dx = factory.acquire_vector("default", n);
+     CCFactoryMatrices<Real>::Pooled_vector error = factory.acquire_vector("default", n);
+     dx->value(r % n) = Real(r);
+     error->value(0) = dx->value(r % n);
+     sum+=error->value(0);
+    }
+   else
+    {
+     ACVector<Real> *dx_pt = factory.create_vector("default", n);
+     ACVector<Real> *error_pt = factory.create_vector("default", n);
+     dx_pt->value(r % n) = Real(r);
+     error_pt->value(0) = dx_pt->value(r % n);
+     sum+=error_pt->value(0);
+     delete dx_pt;
+     delete error_pt;
+    }
+  }
+ const double time = seconds_since(initial_clock_time);
+ const double n_allocations_per_iteration =
+  double(MemoryAllocator::statistics().N_allocations) / double(repetitions);
+
+ std::cout << "n = " << n << " (" << (use_pool ? "pool" : "create/delete") << "): "
+           << time / repetitions * 1.0e9 << " ns per iteration, "
+           << n_allocations_per_iteration << " allocations per iteration" << std::endl;
+
+ return n_allocations_per_iteration;
+}
+
+// ==================================================================
+// Performs n_steps time steps with the given time stepper and returns
+// the number of vectors created after the first time step
+// ==================================================================
+template<class TIME_STEPPER>
+unsigned long objects_created_after_first_step(const unsigned n_odes,
+                                               const unsigned n_steps)
+{
+ CCDecayODEs odes(n_odes);
+ CCTimeStepperWithPoolCounters<TIME_STEPPER> time_stepper;
+ CCData u(n_odes, time_stepper.n_history_values());
+ for (unsigned i = 0; i < n_odes; i++)
+  {
+   u(i) = 1.0;
+  }
+
+ const Real h = 1.0e-3;
+ Real t = 0.0;
+ time_stepper.time_step(odes, h, t, u);
+ t+=h;
+ const unsigned long n_objects_after_first_step = time_stepper.n_objects_created_for_pool();
+ for (unsigned s = 1; s < n_steps; s++)
+  {
+   time_stepper.time_step(odes, h, t, u);
+   t+=h;
+  }
+
+ return time_stepper.n_objects_created_for_pool() - n_objects_after_first_step;
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the pool of the factory of matrices and vectors");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.sizes, "--sizes")
+  .help("Number of entries of the temporary vectors")
+  .nargs('+')
+  .default_value({"10", "1000", "100000"});
+
+ parser.add_argument(args.repetitions, "--repetitions")
+  .help("Number of iterations for each size")
+  .default_value("100000");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ std::vector<unsigned long> sizes = args.sizes.value();
+ unsigned repetitions = args.repetitions;
+ if (args.test)
+  {
+   sizes.clear();
+   sizes.push_back(10);
+   sizes.push_back(1000);
+   repetitions = 1000;
+  }
+
+ std::cout << "Allocator: " << MemoryAllocator::allocator_name(MemoryAllocator::allocator()) << std::endl;
+
+ bool all_passed = true;
+
+ // Keep the result such that the compiler does not remove the loops
+ Real sum = 0.0;
+
+ CCFactoryMatrices<Real> factory;
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   const unsigned long n = sizes[i];
+   const double n_allocations_create = benchmark_temporaries(factory, n, repetitions, false, sum);
+   const double n_allocations_pool = benchmark_temporaries(factory, n, repetitions, true, sum);
+   output_test << n << " " << n_allocations_create << " " << n_allocations_pool << std::endl;
+   all_passed = all_passed && n_allocations_pool == 0.0;
+  }
+
+ // Two vectors per size were created by the pool (in the warm up)
+ const bool passed_pool = factory.n_objects_created_for_pool() == 2 * sizes.size() &&
+  factory.n_objects_in_pool() == 2 * sizes.size();
+ output_test << passed_pool << std::endl;
+ all_passed = all_passed && passed_pool;
+
+ // The predictor-corrector methods create no vectors after the first
+ // time step
+ const unsigned long n_objects_bepc =
+  objects_created_after_first_step<CCBackwardEulerPCMethod>(100, 50);
+ const unsigned long n_objects_am2pc =
+  objects_created_after_first_step<CCAdamsMoulton2PCMethod>(100, 50);
+ std::cout << "Vectors created after the first time step (BEPC, AM2PC): "
+           << n_objects_bepc << " " << n_objects_am2pc << std::endl;
+ output_test << n_objects_bepc << " " << n_objects_am2pc << std::endl;
+ all_passed = all_passed && n_objects_bepc == 0 && n_objects_am2pc == 0;
+
+ std::cout << "(sum " << sum << ")" << std::endl;
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The pool created objects once warm" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
@@ -0,0 +1,450 @@
+// IN THIS FILE: Benchmark of the reuse of the Jacobian (and its
+// factorisation) by Newton's method of the implicit time steppers. A
+// stiff reaction-diffusion system (the method of lines for Fisher's
+// equation) is integrated by the Backward Euler (BDF 1), BDF 2 and
+// Adams-Moulton 2 methods computing and factorising the Jacobian at
+// each Newton's iteration and reusing it across iterations and time
+// steps. The time step is halved at half the integration to check
+// that the Jacobian is recomputed. The solutions are checked to agree
+// and the number of Jacobians and factorisations to be reduced. The
+// cache of factorisations of the linear solvers is also checked
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+
+// The implicit time steppers
+#include "../../../src/time_steppers/cc_backward_euler_method.h"
+#include "../../../src/time_steppers/cc_bdf_2_method.h"
+#include "../../../src/time_steppers/cc_adams_moulton_2_method.h"
+
+// The class used to store the values of u and dudt
+#include "../../../src/data_structures/cc_data.h"
+// The class implementing the interfaces for the ODEs
+#include "../../../src/data_structures/ac_odes.h"
+
+// The base class for the specification of the Jacobian of the ODEs
+#include "../../../src/time_steppers/ac_jacobian_and_residual_for_implicit_time_stepper.h"
+
+// The linear solvers and the matrices for the check of the cache
+#include "../../../src/linear_solvers/cc_factory_linear_solver.h"
+#include "../../../src/matrices/cc_matrix.h"
+#include "../../../src/matrices/cc_vector.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<unsigned> n_points;
+ argparse::ArgValue<unsigned> n_steps;
+ argparse::ArgValue<unsigned> maximum_jacobian_age;
+};
+
+// ==================================================================
+// Seconds elapsed since the given time
+// ==================================================================
+double seconds_since(clock_t initial_clock_time)
+{
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ return Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+}
+
+// =================================================================
+// Fisher's equation, du/dt = D u_xx + u (1 - u) in (0, 1) with u = 0
+// at the boundaries, discretised by centred differences on
+// n_points interior points. The diffusion coefficient over the
+// squared grid size is given instead of D, it sets the stiffness
+// =================================================================
+class CCFisherODEs : public virtual ACODEs
+{
+
+public:
+
+ /// Constructor
+ CCFisherODEs(const unsigned n_points, const Real diffusion_over_dx2)
+  : ACODEs(n_points),
+    Diffusion_over_dx2(diffusion_over_dx2)
+ { }
+
+ /// Empty destructor
+ virtual ~CCFisherODEs() { }
+
+ /// Evaluates the system of odes at time 't', using the history
+ /// values of u at index k
+ void evaluate_derivatives(const Real t, CCData &u, CCData &dudt, const unsigned k = 0)
+ {
+  const unsigned n = this->n_odes();
+  for (unsigned i = 0; i < n; i++)
+   {
+    const Real u_left = i > 0 ? u(i-1,k) : 0.0;
+    const Real u_right = i + 1 < n ? u(i+1,k) : 0.0;
+    dudt(i) = Diffusion_over_dx2 * (u_left - 2.0 * u(i,k) + u_right) +
+     u(i,k) * (1.0 - u(i,k));
+   }
+ }
+
+ /// The diffusion coefficient over the squared grid size
+ inline Real diffusion_over_dx2() const {return Diffusion_over_dx2;}
+
+protected:
+
+ /// Copy constructor (we do not want this class to be
+ /// copiable). Check
+ /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+ CCFisherODEs(const CCFisherODEs &copy)
+  : ACODEs(copy)
+ {
+  BrokenCopy::broken_copy("CCFisherODEs");
+ }
+
+ /// Assignment operator (we do not want this class to be
+ /// copiable. Check
+ /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+ void operator=(const CCFisherODEs &copy)
+ {
+  BrokenCopy::broken_assign("CCFisherODEs");
+ }
+
+ /// The diffusion coefficient over the squared grid size
+ Real Diffusion_over_dx2;
+
+};
+
+// =================================================================
+// The Jacobian of Fisher's equation (a tridiagonal matrix stored as a
+// dense one, as the implicit time steppers do)
+// =================================================================
+class CCJacobianStrategyForFisherODEs : public virtual ACJacobianAndResidualForImplicitTimeStepper
+{
+
+public:
+
+ // Empty constructor
+ CCJacobianStrategyForFisherODEs()
+  : ACJacobianAndResidualForImplicitTimeStepper() { }
+
+ // Empty destructor
+ ~CCJacobianStrategyForFisherODEs() { }
+
+ // In charge of computing the Jacobian
+ void compute_jacobian()
+ {
+  CCFisherODEs *odes_pt = dynamic_cast<CCFisherODEs*>(this->odes_pt());
+  CCData *u_pt = this->u_pt();
+  if (!this->data_for_jacobian_and_residual_has_been_set() || odes_pt == NULL || u_pt == NULL)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "You have not established the data required for\n"
+                  << "the computation of the Jacobian\n"
+                  << "You need to call the method\n"
+                  << "set_data_for_jacobian_and_residual()\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  const unsigned n = odes_pt->n_odes();
+  const unsigned k = this->history_index();
+  const Real d = odes_pt->diffusion_over_dx2();
+  this->Jacobian_pt->allocate_memory(n, n);
+  for (unsigned i = 0; i < n; i++)
+   {
+    for (unsigned j = 0; j < n; j++)
+     {
+      this->Jacobian_pt->value(i, j) = 0.0;
+     }
+    this->Jacobian_pt->value(i, i) = -2.0 * d + 1.0 - 2.0 * u_pt->value(i,k);
+    if (i > 0)
+     {
+      this->Jacobian_pt->value(i, i-1) = d;
+     }
+    if (i + 1 < n)
+     {
+      this->Jacobian_pt->value(i, i+1) = d;
+     }
+   }
+ }
+
+ // No residual computation
+ void compute_residual() { }
+
+private:
+
+ // Copy constructor (we do not want this class to be
+ // copiable). Check
+ // http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+ CCJacobianStrategyForFisherODEs(const CCJacobianStrategyForFisherODEs &copy)
+ {
+  BrokenCopy::broken_copy("CCJacobianStrategyForFisherODEs");
+ }
+
+ // Assignment operator (we do not want this class to be
+ // copiable. Check
+ // http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+ void operator=(const CCJacobianStrategyForFisherODEs &copy)
+ {
+  BrokenCopy::broken_assign("CCJacobianStrategyForFisherODEs");
+ }
+
+};
+
+// ==================================================================
+// The statistics of an integration
+// ==================================================================
+struct Statistics
+{
+ unsigned long N_jacobians;
+ unsigned long N_factorisations;
+ unsigned long N_iterations;
+ double Seconds;
+};
+
+// ==================================================================
+// Integrates Fisher's equation with the time stepper, the first half
+// of the steps with step size h and the second one with h / 2. The
+// solution is returned in u_final
+// ==================================================================
+template<class TIME_STEPPER>
+Statistics integrate(const unsigned n_points, const unsigned n_steps,
+                     const Real h, const bool reuse_jacobian,
+                     const unsigned maximum_jacobian_age,
+                     std::vector<Real> &u_final)
+{
+ // The step size h is the stability limit of Euler's method for the
+ // diffusion (h * 4 * D / dx^2 = 2), the initial guess given by
+ // Runge-Kutta 4 is still stable
+ const Real diffusion_over_dx2 = 0.5 / h;
+ CCFisherODEs odes(n_points, diffusion_over_dx2);
+ CCJacobianStrategyForFisherODEs jacobian_strategy;
+
+ TIME_STEPPER time_stepper;
+ time_stepper.set_strategy_for_odes_jacobian(&jacobian_strategy);
+ if (reuse_jacobian)
+  {
+   time_stepper.enable_jacobian_reuse();
+   time_stepper.newtons_method().set_maximum_jacobian_age(maximum_jacobian_age);
+  }
+
+ // The initial values, a bump in the middle of the domain
+ CCData u(n_points, time_stepper.n_history_values());
+ for (unsigned i = 0; i < n_points; i++)
+  {
+   const Real x = Real(i + 1) / Real(n_points + 1);
+   u(i) = 0.5 * std::sin(3.14159265358979 * x);
+  }
+
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ Real t = 0.0;
+ for (unsigned s = 0; s < n_steps; s++)
+  {
+   const Real h_step = s < n_steps / 2 ? h : 0.5 * h;
+   time_stepper.time_step(odes, h_step, t, u);
+   t+= h_step;
+  }
+
+ Statistics statistics;
+ statistics.Seconds = seconds_since(initial_clock_time);
+ statistics.N_jacobians = time_stepper.newtons_method().n_jacobian_computations();
+ statistics.N_factorisations = time_stepper.newtons_method().n_factorisations();
+ statistics.N_iterations = time_stepper.newtons_method().n_newton_iterations();
+
+ u_final.resize(n_points);
+ for (unsigned i = 0; i < n_points; i++)
+  {
+   u_final[i] = u(i);
+  }
+
+ return statistics;
+}
+
+// ==================================================================
+// Integrates with and without the reuse of the Jacobian. Returns true
+// if the solutions agree, each Jacobian is factorised once when it is
+// reused and there are fewer factorisations (if more than one was
+// required, the initial guess may already be a solution)
+// ==================================================================
+template<class TIME_STEPPER>
+bool benchmark_method(const std::string &method_name,
+                      const unsigned n_points, const unsigned n_steps,
+                      const unsigned maximum_jacobian_age)
+{
+ const Real h = 1.0e-2;
+ std::vector<Real> u_new_jacobian;
+ std::vector<Real> u_reused_jacobian;
+ const Statistics new_jacobian =
+  integrate<TIME_STEPPER>(n_points, n_steps, h, false, maximum_jacobian_age, u_new_jacobian);
+ const Statistics reused_jacobian =
+  integrate<TIME_STEPPER>(n_points, n_steps, h, true, maximum_jacobian_age, u_reused_jacobian);
+
+ Real max_difference = 0.0;
+ for (unsigned i = 0; i < n_points; i++)
+  {
+   max_difference = std::max(max_difference,
+                             std::fabs(u_new_jacobian[i] - u_reused_jacobian[i]));
+  }
+
+ const Real tolerance = 1000.0 * DEFAULT_NEWTON_ABSOLUTE_SOLVER_TOLERANCE;
+ const bool passed =
+  max_difference <= tolerance &&
+  new_jacobian.N_factorisations == new_jacobian.N_iterations &&
+  reused_jacobian.N_factorisations == reused_jacobian.N_jacobians &&
+  (reused_jacobian.N_factorisations < new_jacobian.N_factorisations ||
+   new_jacobian.N_factorisations <= 1);
+
+ std::cout << std::setw(16) << method_name
+           << " new Jacobian: " << std::setw(6) << new_jacobian.N_factorisations
+           << " LU / " << std::setw(6) << new_jacobian.N_iterations << " it "
+           << std::setw(10) << new_jacobian.Seconds << " s"
+           << " reused: " << std::setw(6) << reused_jacobian.N_factorisations
+           << " LU / " << std::setw(6) << reused_jacobian.N_iterations << " it "
+           << std::setw(10) << reused_jacobian.Seconds << " s"
+           << " speedup: " << std::setw(8) << new_jacobian.Seconds / reused_jacobian.Seconds
+           << " max difference: " << max_difference
+           << (passed ? "" : " (FAILED)") << std::endl;
+
+ return passed;
+}
+
+// ==================================================================
+// Checks that the linear solver only factorises a new version of the
+// matrix and that the cache is cleared when another matrix is solved
+// ==================================================================
+bool check_factorisation_cache()
+{
+ const unsigned long n = 20;
+ CCMatrix<Real> A(n, n);
+ CCMatrix<Real> B(n, n);
+ CCVector<Real> b(n);
+ CCVector<Real> x(n);
+ CCVector<Real> y(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   for (unsigned long j = 0; j < n; j++)
+    {
+     A(i, j) = 1.0 / (1.0 + i + j);
+     B(i, j) = i == j ? 2.0 : 0.0;
+    }
+   A(i, i)+= Real(n);
+   b(i) = 1.0 + i;
+  }
+
+ CCFactoryLinearSolver factory_linear_solver;
+ ACLinearSolver *linear_solver_pt = factory_linear_solver.create_linear_solver();
+
+ // The first solve factorises, the second one re-uses the
+ // factorisation and gives the same solution
+ bool passed = linear_solver_pt->solve_with_cached_factorisation(&A, 1, &b, &x);
+ passed = passed && !linear_solver_pt->solve_with_cached_factorisation(&A, 1, &b, &y);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   passed = passed && x(i) == y(i);
+  }
+
+ // A new version of the matrix is factorised
+ A(0, 0)*= 2.0;
+ passed = passed && linear_solver_pt->solve_with_cached_factorisation(&A, 2, &b, &x);
+ Real max_residual = 0.0;
+ for (unsigned long i = 0; i < n; i++)
+  {
+   Real residual = b(i);
+   for (unsigned long j = 0; j < n; j++)
+    {
+     residual-= A(i, j) * x(j);
+    }
+   max_residual = std::max(max_residual, std::fabs(residual));
+  }
+ passed = passed && max_residual <= 1000.0 * std::numeric_limits<Real>::epsilon() * n;
+
+ // Solving another matrix clears the cache
+ linear_solver_pt->solve(&B, &b, &y);
+ passed = passed && !linear_solver_pt->factorisation_is_cached(&A, 2);
+ passed = passed && linear_solver_pt->solve_with_cached_factorisation(&A, 2, &b, &y);
+
+ delete linear_solver_pt;
+
+ std::cout << "Factorisation cache: " << (passed ? "passed" : "FAILED") << std::endl;
+
+ return passed;
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the reuse of the Jacobian by the implicit time steppers");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with a small system for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.n_points, "--n_points")
+  .help("Number of interior points (odes)")
+  .default_value("500");
+
+ parser.add_argument(args.n_steps, "--n_steps")
+  .help("Number of time steps")
+  .default_value("200");
+
+ parser.add_argument(args.maximum_jacobian_age, "--maximum_jacobian_age")
+  .help("Maximum number of time steps that reuse a Jacobian")
+  .default_value("20");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ unsigned n_points = args.n_points;
+ unsigned n_steps = args.n_steps;
+ if (args.test)
+  {
+   n_points = 40;
+   n_steps = 40;
+  }
+
+ const unsigned maximum_jacobian_age = args.maximum_jacobian_age;
+ bool all_passed = true;
+
+ bool passed = benchmark_method<CCBackwardEulerMethod>("Backward Euler", n_points, n_steps, maximum_jacobian_age);
+ output_test << 1 << " " << passed << std::endl;
+ all_passed = all_passed && passed;
+
+ passed = benchmark_method<CCBDF2Method>("BDF 2", n_points, n_steps, maximum_jacobian_age);
+ output_test << 2 << " " << passed << std::endl;
+ all_passed = all_passed && passed;
+
+ passed = benchmark_method<CCAdamsMoulton2Method>("Adams-Moulton 2", n_points, n_steps, maximum_jacobian_age);
+ output_test << 3 << " " << passed << std::endl;
+ all_passed = all_passed && passed;
+
+ passed = check_factorisation_cache();
+ output_test << passed << std::endl;
+ all_passed = all_passed && passed;
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The reuse of the Jacobian failed" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
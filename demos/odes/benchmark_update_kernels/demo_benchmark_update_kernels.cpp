@@ -0,0 +1,236 @@
+// IN THIS FILE: Benchmark of the fused kernels used by the time
+// steppers to update the values. The previous implementation of a
+// stage of the Runge-Kutta 4(5) Dormand-Prince method (a loop that
+// accesses the values through CCData::operator()) is compared against
+// UpdateKernels::lincomb() on the history rows of the data. The
+// results are checked to be the same (the operations are performed
+// in the same order), the weighted RMS norm and the versions for
+// vectors of the library are checked against simple loops
+
+// Include general/common includes, utilities and initialisation
+#include "../../../src/general/common_includes.h"
+#include "../../../src/general/utilities.h"
+#include "../../../src/general/initialise.h"
+// The data whose history rows are updated
+#include "../../../src/data_structures/cc_data.h"
+// The vectors of the library
+#include "../../../src/matrices/cc_vector.h"
+// The fused kernels
+#include "../../../src/time_steppers/update_kernels.h"
+
+// Use the namespace of the framework
+using namespace scicellxx;
+
+struct Args {
+ argparse::ArgValue<bool> test;
+ argparse::ArgValue<std::vector<unsigned long> > sizes;
+ argparse::ArgValue<unsigned long> n_updates;
+};
+
+// ==================================================================
+// Seconds elapsed since the given time
+// ==================================================================
+double seconds_since(clock_t initial_clock_time)
+{
+ clock_t final_clock_time = Timing::cpu_clock_time();
+ return Timing::diff_cpu_clock_time(initial_clock_time, final_clock_time);
+}
+
+// ==================================================================
+// Benchmark the sixth stage of the Runge-Kutta 4(5) Dormand-Prince
+// method with n values. Returns true if both versions give the same
+// result
+// ==================================================================
+bool benchmark_stage(const unsigned n, const unsigned long n_iterations)
+{
+ const unsigned k = 0;
+ const Real hh = 1.0e-3;
+ CCData u(n, 2);
+ CCData K1(n);
+ CCData K2(n);
+ CCData K3(n);
+ CCData K4(n);
+ CCData K5(n);
+ for (unsigned i = 0; i < n; i++)
+  {
+   u(i, k) = 1.0 + std::sin(Real(i));
+   K1(i) = std::cos(Real(i));
+   K2(i) = 0.5 * K1(i);
+   K3(i) = K1(i) * K1(i);
+   K4(i) = 1.0 / (1.0 + i);
+   K5(i) = -0.25 * K3(i);
+  }
+ CCData u_copy(u);
+ CCData u_fused(u);
+
+ // Previous implementation, element by element
+ clock_t initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned long l = 0; l < n_iterations; l++)
+  {
+   for (unsigned i = 0; i < n; i++)
+    {
+     u_copy(i,k) = u(i,k)+hh*((9017.0/3168.0)*K1(i)-(355.0/33.0)*K2(i)+(46732.0/5247.0)*K3(i)+(49.0/176.0)*K4(i)-(5103.0/18656.0)*K5(i));
+    }
+  }
+ const double seconds_loop = seconds_since(initial_clock_time);
+
+ // Fused kernel on the history rows
+ const Real a6[] = {9017.0/3168.0, -355.0/33.0, 46732.0/5247.0,
+                    49.0/176.0, -5103.0/18656.0};
+ const Real *K_pt[] = {K1.values_pt(), K2.values_pt(), K3.values_pt(),
+                       K4.values_pt(), K5.values_pt()};
+ const Real *u_k_pt = u.history_values_row_pt(k);
+ Real *u_fused_k_pt = u_fused.history_values_row_pt(k);
+ initial_clock_time = Timing::cpu_clock_time();
+ for (unsigned long l = 0; l < n_iterations; l++)
+  {
+   UpdateKernels::lincomb(n, u_k_pt, hh, 5, a6, K_pt, u_fused_k_pt);
+  }
+ const double seconds_fused = seconds_since(initial_clock_time);
+
+ const bool passed =
+  std::memcmp(u_copy.history_values_row_pt(k), u_fused_k_pt, n * sizeof(Real)) == 0;
+
+ std::cout << std::setw(8) << n
+           << " loop: " << std::setw(10) << seconds_loop << " s"
+           << " fused: " << std::setw(10) << seconds_fused << " s"
+           << " speedup: " << std::setw(8) << seconds_loop / seconds_fused
+           << (passed ? "" : " (DIFFERENT RESULTS)") << std::endl;
+
+ return passed;
+}
+
+// ==================================================================
+// Check the weighted RMS norm and the versions for vectors of the
+// library against simple loops
+// ==================================================================
+bool check_kernels()
+{
+ const unsigned long n = 10;
+ CCVector<Real> x(n);
+ CCVector<Real> y(n);
+ CCVector<Real> z(n);
+ CCVector<Real> e(n);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   x(i) = 1.0 + i;
+   y(i) = 2.0 - i;
+   z(i) = 0.5 * i;
+   e(i) = 1.0e-6 * (i % 3);
+  }
+
+ // Weighted RMS norm
+ const Real atol = 1.0e-8;
+ const Real rtol = 1.0e-4;
+ Real total = 0.0;
+ for (unsigned long i = 0; i < n; i++)
+  {
+   const Real ratio = e(i) / (atol + rtol * std::max(std::fabs(x(i)), std::fabs(y(i))));
+   total+= ratio * ratio;
+  }
+ const Real expected_norm = std::sqrt(total / Real(n));
+ const Real norm = UpdateKernels::wrms_norm(e, x, y, atol, rtol);
+ bool passed = std::fabs(norm - expected_norm) <= 1.0e-14 * expected_norm;
+
+ // Linear combination, w = x + 0.5 * (2 * y - z)
+ CCVector<Real> w(y);
+ const Real c[] = {2.0, -1.0};
+ const ACVector<Real> *terms[] = {&y, &z};
+ UpdateKernels::lincomb(x, Real(0.5), 2, c, terms, w);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   passed = passed && w(i) == x(i) + 0.5 * (2.0 * y(i) - z(i));
+  }
+
+ // axpby, v = 2 * x + 3 * v with v a copy of z
+ CCVector<Real> v(z);
+ UpdateKernels::axpby(Real(2.0), x, Real(3.0), v);
+ for (unsigned long i = 0; i < n; i++)
+  {
+   passed = passed && v(i) == 2.0 * x(i) + 3.0 * z(i);
+  }
+
+ // Unsupported number of terms
+ bool rejected = false;
+ try
+  {
+   UpdateKernels::check_number_of_terms(UpdateKernels::Maximum_terms + 1);
+  }
+ catch (const SciCellxxLibError &error)
+  {
+   rejected = true;
+  }
+
+ return passed && rejected;
+}
+
+int main(int argc, const char** argv)
+{
+ // Initialise scicellxx
+ initialise_scicellxx();
+
+ // Instantiate parser
+ Args args;
+ auto parser = argparse::ArgumentParser(argv[0], "Benchmark of the fused kernels of the time steppers");
+
+ // Add arguments
+
+ // Optional
+ parser.add_argument(args.test, "--test")
+  .help("Run with small sizes for testing")
+  .default_value("false")
+  .action(argparse::Action::STORE_TRUE);
+
+ parser.add_argument(args.sizes, "--sizes")
+  .help("Number of values of the data")
+  .nargs('+')
+  .default_value({"100", "10000", "1000000"});
+
+ parser.add_argument(args.n_updates, "--n_updates")
+  .help("Number of values updated for each size (the stage is repeated n_updates / size times)")
+  .default_value("100000000");
+
+ // Parse the input arguments
+ parser.parse_args(argc, argv);
+
+ // Output for testing/validation
+ std::ofstream output_test("output_test.dat", std::ios_base::out);
+
+ std::vector<unsigned long> sizes = args.sizes.value();
+ unsigned long n_updates = args.n_updates;
+ if (args.test)
+  {
+   sizes.clear();
+   sizes.push_back(7);
+   sizes.push_back(1000);
+   n_updates = 100000;
+  }
+
+ bool all_passed = true;
+ for (unsigned i = 0; i < sizes.size(); i++)
+  {
+   const unsigned long n = sizes[i];
+   const unsigned long n_iterations = std::max(n_updates / n, 1UL);
+   const bool passed = benchmark_stage(n, n_iterations);
+   output_test << n << " " << passed << std::endl;
+   all_passed = all_passed && passed;
+  }
+ const bool passed_kernels = check_kernels();
+ output_test << passed_kernels << std::endl;
+ all_passed = all_passed && passed_kernels;
+
+ // Close the output for test
+ output_test.close();
+
+ // Finalise scicellxx
+ finalise_scicellxx();
+
+ if (!all_passed)
+  {
+   std::cout << "The results of the fused kernels differ" << std::endl;
+   return 1;
+  }
+
+ return 0;
+
+}
@@ -64,7 +64,7 @@ namespace scicellxx
   // Copy the data from the input vector to the values_pt vector
   set_values(values_pt);
   // Allocate memory for Status_pt
-  Status_pt = new Data_status[N_values];
+  Status_pt = MemoryAllocator::new_array<Data_status>(N_values);
   // ... and set them to undefined
   for (unsigned i = 0; i < N_values; i++)
    {
@@ -100,7 +100,7 @@ namespace scicellxx
   set_values(copy.values_pt());
   
   // Allocate memory for Status_pt
-  Status_pt = new Data_status[N_values];
+  Status_pt = MemoryAllocator::new_array<Data_status>(N_values);
   
   // Copy the status
   std::memcpy(Status_pt, copy.status_pt(), N_values*sizeof(Data_status));
@@ -110,6 +110,19 @@ namespace scicellxx
   
  }
  
+ /// ===================================================================
+ /// Move constructor
+ /// ===================================================================
+ CCData::CCData(CCData &&source_values)
+  : Is_values_empty(true), Is_status_empty(true), Delete_values_storage(true),
+    N_values(source_values.n_values()),
+    N_history_values(source_values.n_history_values()),
+    Values_pt(0), Status_pt(0)
+ {
+  // Take the storage of the source object
+  move_values(source_values);
+ }
+ 
  /// ===================================================================
  /// Destructor
  /// ===================================================================
@@ -161,6 +174,84 @@ namespace scicellxx
   return *this;
  }
  
+ /// ===================================================================
+ /// Move assignment operator
+ /// ===================================================================
+ CCData& CCData::operator=(CCData &&source_values)
+ {
+#ifdef SCICELLXX_RANGE_CHECK
+  if (N_values != source_values.n_values() ||
+      N_history_values != source_values.n_history_values())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The number of values or history values from the source\n"
+                  << "and the destination CCData object are not the same\n"
+                  << "N_values: " << N_values << "\n"
+                  << "source_values.n_values(): " << source_values.n_values() << "\n"
+                  << "N_history_values: " << N_history_values << "\n"
+                  << "source_values.n_history_values(): "
+                  << source_values.n_history_values() << "\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                           SCICELLXX_CURRENT_FUNCTION,
+                           SCICELLXX_EXCEPTION_LOCATION);
+   }
+#endif // #ifdef SCICELLXX_RANGE_CHECK
+  
+  // Check for self-assignment
+  if (this != &source_values)
+   {
+    // Clean-up and take the storage of the source object
+    clean_up();
+    move_values(source_values);
+   }
+  
+  // Return this (de-referenced pointer)
+  return *this;
+ }
+ 
+ /// ===================================================================
+ /// Takes the values and status storage of the source object. The
+ /// values storage is only transferred if the source object is allowed
+ /// to delete it, otherwise the values are copied. In both cases the
+ /// source object is left empty. THIS object should be empty
+ /// ===================================================================
+ void CCData::move_values(CCData &source_values)
+ {
+  if (!source_values.Is_values_empty)
+   {
+    if (source_values.Delete_values_storage)
+     {
+      // Transfer ownership
+      Values_pt = source_values.Values_pt;
+      Is_values_empty = false;
+      
+      // Leave the source object with no values
+      source_values.Values_pt = 0;
+      source_values.Is_values_empty = true;
+     }
+    else
+     {
+      // The values storage of the source object is managed somewhere
+      // else, copy the values
+      set_values(source_values.values_pt());
+     }
+   }
+  
+  // The status is always owned by the object, transfer it
+  if (!source_values.Is_status_empty)
+   {
+    Status_pt = source_values.Status_pt;
+    Is_status_empty = false;
+    
+    // Leave the source object with no status
+    source_values.Status_pt = 0;
+    source_values.Is_status_empty = true;
+   }
+  
+ }
+ 
  /// ===================================================================
  /// Transforms the input values vector to a Data class type
  /// ===================================================================
@@ -172,7 +263,7 @@ namespace scicellxx
   // Allocate memory for Values_pt vector. Values_pt[t*N_values+i],
   // the values are stored by row, i.e. the whole values at t-th
   // history is in row t
-  Values_pt = new Real[N_history_values*N_values];
+  Values_pt = MemoryAllocator::new_array<Real>(N_history_values*N_values);
   
   // Copy the values (an element by element copy, uff!!)
   std::memcpy(Values_pt, values_pt, N_history_values*N_values*sizeof(Real));
@@ -202,7 +293,7 @@ namespace scicellxx
   if (!Is_status_empty)
    {
     // Free memory for pin status
-    delete [] Status_pt;
+    MemoryAllocator::delete_array(Status_pt);
     // Mark the Status_pt vector as having no elements
     Is_status_empty = true;
    }
@@ -222,7 +313,7 @@ namespace scicellxx
   // values has been marked for deletion
   if (Delete_values_storage)
    {
-    delete [] Values_pt;
+    MemoryAllocator::delete_array(Values_pt);
     Values_pt = 0;
     
     // Mark as empty
@@ -458,9 +549,9 @@ namespace scicellxx
   clean_up();
   
   // Allocate memory for Values_pt
-  Values_pt = new Real[N_history_values*N_values];
+  Values_pt = MemoryAllocator::new_array<Real>(N_history_values*N_values);
   // Allocate memory for Status_pt
-  Status_pt = new Data_status[N_values];
+  Status_pt = MemoryAllocator::new_array<Data_status>(N_values);
   // Set status as undefined
   for (unsigned i = 0; i < N_values; i++)
    {
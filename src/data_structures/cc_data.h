@@ -6,6 +6,8 @@
 
 #include "../general/common_includes.h"
 #include "../general/utilities.h"
+// The allocator for the values and status
+#include "../general/memory_allocator.h"
 
 namespace scicellxx
 {
@@ -36,12 +38,20 @@ namespace scicellxx
   /// Copy constructor
   CCData(const CCData &copy);
   
+  /// Move constructor. Takes the values storage of the source object
+  /// if it is allowed to be deleted by it, otherwise the values are
+  /// copied. The source object is left empty
+  CCData(CCData &&source_values);
+  
   /// Destructor
   virtual ~CCData();
   
   /// Assignment operator
   CCData &operator=(const CCData &source_values);
   
+  /// Move assignment operator, same rules as in the move constructor
+  CCData &operator=(CCData &&source_values);
+  
   //// Get access using brackets as data(i). Read-only version
   inline virtual Real operator()(const unsigned &i) const
   {return value(i,0);}
@@ -156,6 +166,10 @@ namespace scicellxx
   /// for values. The deletion is true by default.
   bool Delete_values_storage;
   
+  /// Takes the values and status storage of the source object (used
+  /// by the move constructor and the move assignment operator)
+  void move_values(CCData &source_values);
+  
  private:
   
   /// The number of values
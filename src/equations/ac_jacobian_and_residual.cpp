@@ -7,6 +7,7 @@ namespace scicellxx
  /// Constructor
  // ===================================================================
  ACJacobianAndResidual::ACJacobianAndResidual()
+  : Jacobian_version(0)
  {
   // Create an instance of the factory for matrices and vectors
   CCFactoryMatrices<Real> factory_matrices_and_vectors;
@@ -40,6 +40,14 @@ namespace scicellxx
   /// Get access to the Jacobian
   inline ACMatrix<Real> *jacobian_pt() {return Jacobian_pt;}
   
+  /// The version of the Jacobian, the factorisations cached by the
+  /// linear solvers are keyed to it
+  inline unsigned long jacobian_version() const {return Jacobian_version;}
+  
+  /// Increases the version of the Jacobian, call it each time the
+  /// values of the Jacobian change (after compute_jacobian())
+  inline void increase_jacobian_version() {Jacobian_version++;}
+  
   /// In charge of computing the residual vector based on the
   /// particular strategy implemented in the derived class
   virtual void compute_residual() = 0;
@@ -56,6 +64,9 @@ namespace scicellxx
   ACVector<Real> *Residual_pt;
   
  private:
+  
+  /// The version of the Jacobian
+  unsigned long Jacobian_version;
    
   /// Copy constructor (we do not want this class to be
   /// copiable. Check
@@ -0,0 +1,17 @@
+#ifndef CMAKE_DEFINITIONS_H
+#define CMAKE_DEFINITIONS_H
+
+// This file is used as a template for CMake to create the file
+// cmake_definitions.h, the variables in between "@"s are substituted
+// for values assigned in the "CMakeLists.txt" files
+
+namespace scicellxx
+{
+ 
+#define MAJOR_VERSION 0
+#define MINOR_VERSION 6
+#define PATCH_LEVEL 0
+ 
+}
+
+#endif // #ifdef CMAKE_DEFINITIONS_H
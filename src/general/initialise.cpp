@@ -60,6 +60,9 @@ namespace scicellxx
   scicellxx_output << "Total wall time: " << total_wall_time << std::endl;
   scicellxx_output << "Total cpu clock time: " << total_cpu_clock_time << std::endl; 
   
+  // Return the memory kept by the pool allocator to the system
+  MemoryAllocator::release_pool();
+  
   scicellxx_output << "[DONE]: SciCellxx termination" << std::endl;
   // Everything was alright
   return true;
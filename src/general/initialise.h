@@ -3,6 +3,7 @@
 
 #include "common_includes.h"
 #include "utilities.h"
+#include "memory_allocator.h"
 
 namespace scicellxx
 {
@@ -0,0 +1,318 @@
+// IN THIS FILE: Implementation of the allocator used by CCVector,
+// CCMatrix and CCData
+
+#include "memory_allocator.h"
+
+#include <atomic>
+#include <cstdlib>
+
+namespace scicellxx
+{
+
+ namespace MemoryAllocator
+ {
+
+  // The data used by the allocator is only visible in this file. It is
+  // made of plain variables (no constructors or destructors) such that
+  // objects destroyed at program exit may still release their memory
+  namespace
+  {
+
+   // The strategy chosen at configure time
+#if defined(SCICELLXX_ALLOCATOR_POOL)
+   const Allocator_type Configured_allocator = POOL;
+#elif defined(SCICELLXX_ALLOCATOR_ALIGNED)
+   const Allocator_type Configured_allocator = ALIGNED;
+#else
+   const Allocator_type Configured_allocator = NEW;
+#endif
+
+   // Information stored right before the memory returned by
+   // allocate()
+   struct Block_header
+   {
+    // Number of bytes requested
+    unsigned long N_bytes;
+    // Size class of the block (N_size_classes if it is not handled by
+    // the pool)
+    unsigned long Size_class;
+    // The address returned by the system
+    void *Base_pt;
+    // Next block in the free list
+    Block_header *Next_pt;
+   };
+
+   // Size classes of the pool, the i-th class holds blocks of
+   // Smallest_block_size * 2^i bytes (from 64 bytes up to 32 MiB)
+   const unsigned long N_size_classes = 20;
+   const unsigned long Smallest_block_size = 64;
+
+   // Maximum number of bytes kept in the free lists, blocks released
+   // once this limit is reached are returned to the system
+   const unsigned long Max_cached_bytes = 256ul * 1024ul * 1024ul;
+
+   // Free lists of the pool
+   Block_header *Free_list_pt[N_size_classes];
+
+   // The counters
+   Statistics Counters;
+
+   // Lock to allow allocations from different threads
+   std::atomic_flag Lock = ATOMIC_FLAG_INIT;
+
+   // Acquires the lock on construction and releases it on destruction
+   class ScopedLock
+   {
+   public:
+    ScopedLock()
+    {
+     while (Lock.test_and_set(std::memory_order_acquire)) { }
+    }
+    ~ScopedLock()
+    {
+     Lock.clear(std::memory_order_release);
+    }
+   };
+
+   // Get the header of a block
+   inline Block_header *header(const void *pt)
+   {
+    return reinterpret_cast<Block_header*>(const_cast<char*>(static_cast<const char*>(pt))) - 1;
+   }
+
+   // Get the size class for the requested number of bytes,
+   // N_size_classes if it is too large for the pool
+   inline unsigned long size_class(const unsigned long n_bytes)
+   {
+    unsigned long c = 0;
+    unsigned long block_size = Smallest_block_size;
+    while (c < N_size_classes && block_size < n_bytes)
+     {
+      block_size<<= 1;
+      c++;
+     }
+    return c;
+   }
+
+   // Request memory to the system for a block with the given
+   // capacity, returns the address where the entries start
+   void *system_allocate(const unsigned long capacity)
+   {
+    char *base_pt = 0;
+    char *pt = 0;
+    if (Configured_allocator == NEW)
+     {
+      base_pt = static_cast<char*>(::operator new(capacity + sizeof(Block_header)));
+      pt = base_pt + sizeof(Block_header);
+     }
+    else
+     {
+      base_pt = static_cast<char*>(std::malloc(capacity + sizeof(Block_header) + Alignment - 1));
+      if (base_pt == 0)
+       {
+        throw std::bad_alloc();
+       }
+      // Move to the next aligned address leaving room for the header
+      const std::size_t address = reinterpret_cast<std::size_t>(base_pt + sizeof(Block_header));
+      pt = base_pt + sizeof(Block_header) + ((Alignment - address % Alignment) % Alignment);
+     }
+    header(pt)->Base_pt = base_pt;
+    Counters.N_system_allocations++;
+    return pt;
+   }
+
+   // Return the memory of a block to the system
+   void system_deallocate(Block_header *header_pt)
+   {
+    if (Configured_allocator == NEW)
+     {
+      ::operator delete(header_pt->Base_pt);
+     }
+    else
+     {
+      std::free(header_pt->Base_pt);
+     }
+   }
+
+  }
+
+  // ================================================================
+  // Returns the strategy chosen at configure time
+  // ================================================================
+  Allocator_type allocator()
+  {
+   return Configured_allocator;
+  }
+
+  // ================================================================
+  // Returns the name of the allocation strategy
+  // ================================================================
+  std::string allocator_name(const Allocator_type allocator_type)
+  {
+   if (allocator_type == NEW)
+    {
+     return std::string("new");
+    }
+   else if (allocator_type == ALIGNED)
+    {
+     return std::string("aligned");
+    }
+   return std::string("pool");
+  }
+
+  // ================================================================
+  // Reserves memory for n_bytes bytes
+  // ================================================================
+  void *allocate(const unsigned long n_bytes)
+  {
+   ScopedLock lock;
+
+   Counters.N_allocations++;
+   Counters.N_bytes_allocated+= n_bytes;
+   Counters.N_bytes_in_use+= n_bytes;
+   if (Counters.N_bytes_in_use > Counters.Peak_bytes_in_use)
+    {
+     Counters.Peak_bytes_in_use = Counters.N_bytes_in_use;
+    }
+
+   void *pt = 0;
+   unsigned long c = N_size_classes;
+   if (Configured_allocator == POOL)
+    {
+     c = size_class(n_bytes);
+     if (c < N_size_classes && Free_list_pt[c] != 0)
+      {
+       // Reuse a block from the free list
+       Block_header *header_pt = Free_list_pt[c];
+       Free_list_pt[c] = header_pt->Next_pt;
+       Counters.N_bytes_cached-= Smallest_block_size << c;
+       header_pt->N_bytes = n_bytes;
+       return header_pt + 1;
+      }
+     if (c < N_size_classes)
+      {
+       pt = system_allocate(Smallest_block_size << c);
+      }
+     else
+      {
+       pt = system_allocate(n_bytes);
+      }
+    }
+   else
+    {
+     pt = system_allocate(n_bytes);
+    }
+
+   Block_header *header_pt = header(pt);
+   header_pt->N_bytes = n_bytes;
+   header_pt->Size_class = c;
+   header_pt->Next_pt = 0;
+   return pt;
+  }
+
+  // ================================================================
+  // Releases memory obtained with allocate()
+  // ================================================================
+  void deallocate(void *pt)
+  {
+   if (pt == 0)
+    {
+     return;
+    }
+
+   ScopedLock lock;
+
+   Block_header *header_pt = header(pt);
+   Counters.N_deallocations++;
+   Counters.N_bytes_in_use-= header_pt->N_bytes;
+
+   const unsigned long c = header_pt->Size_class;
+   if (c < N_size_classes &&
+       Counters.N_bytes_cached + (Smallest_block_size << c) <= Max_cached_bytes)
+    {
+     // Keep the block in the free list
+     header_pt->Next_pt = Free_list_pt[c];
+     Free_list_pt[c] = header_pt;
+     Counters.N_bytes_cached+= Smallest_block_size << c;
+    }
+   else
+    {
+     system_deallocate(header_pt);
+    }
+  }
+
+  // ================================================================
+  // Returns the number of bytes requested when the memory was
+  // obtained with allocate()
+  // ================================================================
+  unsigned long allocated_bytes(const void *pt)
+  {
+   if (pt == 0)
+    {
+     return 0;
+    }
+   return header(pt)->N_bytes;
+  }
+
+  // ================================================================
+  // Returns the memory held in the free lists of the pool to the
+  // system
+  // ================================================================
+  void release_pool()
+  {
+   ScopedLock lock;
+
+   for (unsigned long c = 0; c < N_size_classes; c++)
+    {
+     while (Free_list_pt[c] != 0)
+      {
+       Block_header *header_pt = Free_list_pt[c];
+       Free_list_pt[c] = header_pt->Next_pt;
+       system_deallocate(header_pt);
+      }
+    }
+   Counters.N_bytes_cached = 0;
+  }
+
+  // ================================================================
+  // Returns the counters of the allocations
+  // ================================================================
+  Statistics statistics()
+  {
+   ScopedLock lock;
+   return Counters;
+  }
+
+  // ================================================================
+  // Set all the counters to zero (except the ones of bytes in use and
+  // cached by the pool)
+  // ================================================================
+  void reset_statistics()
+  {
+   ScopedLock lock;
+   Counters.N_allocations = 0;
+   Counters.N_deallocations = 0;
+   Counters.N_system_allocations = 0;
+   Counters.N_bytes_allocated = 0;
+   Counters.Peak_bytes_in_use = Counters.N_bytes_in_use;
+  }
+
+  // ================================================================
+  // Output the counters of the allocations
+  // ================================================================
+  void output_statistics(std::ostream &out)
+  {
+   const Statistics counters = statistics();
+   out << "Allocator: " << allocator_name(allocator()) << "\n"
+       << "Number of allocations: " << counters.N_allocations << "\n"
+       << "Number of deallocations: " << counters.N_deallocations << "\n"
+       << "Number of system allocations: " << counters.N_system_allocations << "\n"
+       << "Bytes allocated: " << counters.N_bytes_allocated << "\n"
+       << "Bytes in use: " << counters.N_bytes_in_use << "\n"
+       << "Peak bytes in use: " << counters.Peak_bytes_in_use << "\n"
+       << "Bytes cached by the pool: " << counters.N_bytes_cached << std::endl;
+  }
+
+ }
+
+}
@@ -0,0 +1,141 @@
+// IN THIS FILE: The allocator used by CCVector, CCMatrix and CCData
+// to reserve the memory for their entries. The strategy is chosen at
+// configure time (SCICELLXX_ALLOCATOR in the configuration file):
+//
+// - NEW: memory is requested to the system with operator new (the
+//   previous behaviour of the library)
+//
+// - ALIGNED: the entries start at a 64 bytes boundary (the size of a
+//   cache line and of an AVX-512 register)
+//
+// - POOL: as ALIGNED, but the released buffers are kept in free lists
+//   (one per size class) and reused by later allocations of a similar
+//   size instead of being returned to the system. This avoids the
+//   system calls for the many short-lived vectors and matrices
+//   created on each time step
+//
+// All the strategies keep counters of the number of allocations and
+// of the number of bytes in use
+
+// Check whether the namespace has been already defined
+#ifndef MEMORY_ALLOCATOR_H
+#define MEMORY_ALLOCATOR_H
+
+#include "common_includes.h"
+
+#include <new>
+#include <type_traits>
+
+namespace scicellxx
+{
+
+ // ==================================================================
+ /// Allocation of the memory for the entries of vectors, matrices and
+ /// data
+ // ==================================================================
+ namespace MemoryAllocator
+ {
+
+  /// Enumerator with the available allocation strategies
+  enum Allocator_type {NEW, ALIGNED, POOL};
+
+  /// The alignment (in bytes) of the memory returned by the ALIGNED
+  /// and POOL strategies
+  const unsigned long Alignment = 64;
+
+  /// Counters of the allocations performed
+  struct Statistics
+  {
+   // Number of calls to allocate()
+   unsigned long N_allocations;
+   // Number of calls to deallocate()
+   unsigned long N_deallocations;
+   // Number of allocations that requested memory to the system (for
+   // the POOL strategy these are the allocations not served by the
+   // free lists)
+   unsigned long N_system_allocations;
+   // Total number of bytes requested by allocate()
+   unsigned long N_bytes_allocated;
+   // Number of bytes currently in use (allocated but not deallocated)
+   unsigned long N_bytes_in_use;
+   // Maximum number of bytes in use at any time
+   unsigned long Peak_bytes_in_use;
+   // Number of bytes held in the free lists of the pool
+   unsigned long N_bytes_cached;
+  };
+
+  /// Returns the strategy chosen at configure time
+  Allocator_type allocator();
+
+  /// Returns the name of the allocation strategy
+  std::string allocator_name(const Allocator_type allocator_type);
+
+  /// Reserves memory for n_bytes bytes
+  void *allocate(const unsigned long n_bytes);
+
+  /// Releases memory obtained with allocate()
+  void deallocate(void *pt);
+
+  /// Returns the number of bytes requested when the memory was
+  /// obtained with allocate()
+  unsigned long allocated_bytes(const void *pt);
+
+  /// Returns the memory held in the free lists of the pool to the
+  /// system
+  void release_pool();
+
+  /// Returns the counters of the allocations
+  Statistics statistics();
+
+  /// Set all the counters to zero (except the ones of bytes in use
+  /// and cached by the pool)
+  void reset_statistics();
+
+  /// Output the counters of the allocations
+  void output_statistics(std::ostream &out);
+
+  // ================================================================
+  /// Reserves memory for n entries of type T, the entries are default
+  /// initialised as with new T[n]
+  // ================================================================
+  template<class T>
+   T *new_array(const unsigned long n)
+   {
+    T *pt = static_cast<T*>(allocate(n*sizeof(T)));
+    if (!std::is_trivially_default_constructible<T>::value)
+     {
+      for (unsigned long i = 0; i < n; i++)
+       {
+        new (pt + i) T;
+       }
+     }
+    return pt;
+   }
+
+  // ================================================================
+  /// Releases memory obtained with new_array(), the entries are
+  /// destroyed as with delete [] pt
+  // ================================================================
+  template<class T>
+   void delete_array(T *pt)
+   {
+    if (pt == 0)
+     {
+      return;
+     }
+    if (!std::is_trivially_destructible<T>::value)
+     {
+      const unsigned long n = allocated_bytes(pt) / sizeof(T);
+      for (unsigned long i = 0; i < n; i++)
+       {
+        pt[i].~T();
+       }
+     }
+    deallocate(pt);
+   }
+
+ }
+
+}
+
+#endif // #ifndef MEMORY_ALLOCATOR_H
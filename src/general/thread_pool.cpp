@@ -0,0 +1,267 @@
+// IN THIS FILE: Implementation of the pool of threads shared by the
+// parallel kernels
+
+#include "thread_pool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace scicellxx
+{
+
+ namespace ThreadPool
+ {
+
+  // The state of the pool is only visible in this file
+  namespace
+  {
+
+   // A call to run(), lives in the stack of the calling thread
+   struct Job
+   {
+    // The work to do on each chunk
+    const std::function<void(const unsigned long, const unsigned long)> *Task_pt;
+    // The size of the range
+    unsigned long N;
+    // The number of chunks in which the range is split
+    unsigned long N_chunks;
+    // The next chunk to work on
+    std::atomic<unsigned long> Next_chunk;
+    // Number of threads of the pool working on the job (protected by
+    // the mutex of the pool)
+    unsigned long N_workers;
+   };
+
+   // Work on the chunks of the job until all of them are taken
+   void work_on_chunks(Job &job)
+   {
+    unsigned long c = job.Next_chunk.fetch_add(1);
+    while (c < job.N_chunks)
+     {
+      const unsigned long begin = (job.N / job.N_chunks) * c +
+       std::min(c, job.N % job.N_chunks);
+      const unsigned long end = begin + job.N / job.N_chunks +
+       (c < job.N % job.N_chunks ? 1 : 0);
+      (*job.Task_pt)(begin, end);
+      c = job.Next_chunk.fetch_add(1);
+     }
+   }
+
+   // Is the current thread a thread of the pool
+   thread_local bool Is_thread_of_the_pool = false;
+
+   // ===============================================================
+   // The threads and the synchronisation variables
+   // ===============================================================
+   class Pool
+   {
+   public:
+
+    Pool()
+     : N_threads(0), Serial_threshold(32768), Job_pt(0), Generation(0), Stop(false)
+    {
+     const unsigned n_hardware_threads = std::thread::hardware_concurrency();
+     N_threads = (n_hardware_threads == 0 ? 1 : n_hardware_threads);
+    }
+
+    // Wait for the threads to finish
+    ~Pool()
+    {
+     stop_threads();
+    }
+
+    // Wake up the threads and wait for them to finish
+    void stop_threads()
+    {
+     {
+      std::lock_guard<std::mutex> lock(Mutex);
+      Stop = true;
+     }
+     Work_condition.notify_all();
+     for (unsigned i = 0; i < Threads.size(); i++)
+      {
+       Threads[i].join();
+      }
+     Threads.clear();
+     Stop = false;
+    }
+
+    // Create the threads (the calling thread is not counted)
+    void start_threads()
+    {
+     for (unsigned i = 1; i < N_threads; i++)
+      {
+       Threads.push_back(std::thread(&Pool::wait_for_work, this));
+      }
+    }
+
+    // The loop executed by the threads of the pool
+    void wait_for_work()
+    {
+     Is_thread_of_the_pool = true;
+     unsigned long last_generation = 0;
+     std::unique_lock<std::mutex> lock(Mutex);
+     while (true)
+      {
+       Work_condition.wait(lock, [&]{return Stop || (Job_pt != 0 && Generation != last_generation);});
+       if (Stop)
+        {
+         return;
+        }
+       last_generation = Generation;
+       Job *job_pt = Job_pt;
+       job_pt->N_workers++;
+       lock.unlock();
+       work_on_chunks(*job_pt);
+       lock.lock();
+       job_pt->N_workers--;
+       if (job_pt->N_workers == 0)
+        {
+         Done_condition.notify_all();
+        }
+      }
+    }
+
+    // Executes the task on the chunks of [0, n)
+    void run(const unsigned long n,
+             const std::function<void(const unsigned long, const unsigned long)> &task)
+    {
+     // Only one job at a time, nested calls or calls from other
+     // threads while the pool is busy are executed serially
+     std::unique_lock<std::mutex> run_lock(Run_mutex, std::try_to_lock);
+     if (!run_lock.owns_lock() || Is_thread_of_the_pool || N_threads < 2 || n < 2)
+      {
+       task(0, n);
+       return;
+      }
+
+     if (Threads.size() + 1 != N_threads)
+      {
+       start_threads();
+      }
+
+     // A few chunks per thread to balance the work
+     Job job;
+     job.Task_pt = &task;
+     job.N = n;
+     job.N_chunks = std::min(n, 4ul * N_threads);
+     job.Next_chunk.store(0);
+     job.N_workers = 0;
+
+     {
+      std::lock_guard<std::mutex> lock(Mutex);
+      Job_pt = &job;
+      Generation++;
+     }
+     Work_condition.notify_all();
+
+     // Work as any other thread of the pool
+     work_on_chunks(job);
+
+     // Wait for the threads still working on the job, no other
+     // thread may join once the job is removed
+     std::unique_lock<std::mutex> lock(Mutex);
+     Done_condition.wait(lock, [&]{return job.N_workers == 0;});
+     Job_pt = 0;
+    }
+
+    // Change the number of threads
+    void set_n_threads(const unsigned n)
+    {
+     std::lock_guard<std::mutex> run_lock(Run_mutex);
+     stop_threads();
+     N_threads = (n == 0 ? 1 : n);
+    }
+
+    // Number of threads (including the calling thread)
+    std::atomic<unsigned> N_threads;
+
+    // Minimum number of operations to work in parallel
+    std::atomic<unsigned long> Serial_threshold;
+
+   private:
+
+    // The threads of the pool
+    std::vector<std::thread> Threads;
+
+    // Only one call to run() at a time
+    std::mutex Run_mutex;
+
+    // Protects the job, the generation and the stop flag
+    std::mutex Mutex;
+
+    // Signal the threads that there is a new job (or to stop)
+    std::condition_variable Work_condition;
+
+    // Signal that the threads finished working on a job
+    std::condition_variable Done_condition;
+
+    // The current job
+    Job *Job_pt;
+
+    // Incremented with each new job
+    unsigned long Generation;
+
+    // Indicates the threads to finish
+    bool Stop;
+
+   };
+
+   // The pool shared by the library
+   Pool &pool()
+   {
+    static Pool shared_pool;
+    return shared_pool;
+   }
+
+  }
+
+  // ================================================================
+  // Returns the number of threads used by the parallel kernels
+  // ================================================================
+  unsigned n_threads()
+  {
+   return pool().N_threads;
+  }
+
+  // ================================================================
+  // Set the number of threads used by the parallel kernels
+  // ================================================================
+  void set_n_threads(const unsigned n)
+  {
+   pool().set_n_threads(n);
+  }
+
+  // ================================================================
+  // Returns the minimum number of operations to execute a kernel in
+  // parallel
+  // ================================================================
+  unsigned long serial_threshold()
+  {
+   return pool().Serial_threshold.load(std::memory_order_relaxed);
+  }
+
+  // ================================================================
+  // Set the minimum number of operations to execute a kernel in
+  // parallel
+  // ================================================================
+  void set_serial_threshold(const unsigned long n)
+  {
+   pool().Serial_threshold.store(n, std::memory_order_relaxed);
+  }
+
+  // ================================================================
+  // Calls task(begin, end) for the chunks of [0, n) in the threads of
+  // the pool
+  // ================================================================
+  void run(const unsigned long n,
+           const std::function<void(const unsigned long, const unsigned long)> &task)
+  {
+   pool().run(n, task);
+  }
+
+ }
+
+}
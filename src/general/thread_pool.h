@@ -0,0 +1,128 @@
+// IN THIS FILE: The pool of threads shared by the parallel kernels of
+// the library (element-wise operations and reductions on vectors and
+// matrices). The threads are created the first time they are needed
+// and kept waiting for work until the program finishes.
+//
+// Operations with less than serial_threshold() entries are executed
+// by the calling thread, the cost of waking up the threads is larger
+// than the gain for them.
+//
+// Reductions are computed by blocks of Reduction_block_size entries,
+// the partial result of each block is combined in order by the
+// calling thread. The blocks do not depend on the number of threads,
+// thus the result of a reduction is the same (bit by bit) whatever
+// the number of threads used
+
+// Check whether the namespace has been already defined
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "common_includes.h"
+
+#include <functional>
+
+namespace scicellxx
+{
+
+ // ==================================================================
+ /// The pool of threads used by the parallel kernels
+ // ==================================================================
+ namespace ThreadPool
+ {
+
+  /// Number of entries in each block of a reduction
+  const unsigned long Reduction_block_size = 4096;
+
+  /// Returns the number of threads used by the parallel kernels
+  /// (including the calling thread). By default the number of
+  /// hardware threads
+  unsigned n_threads();
+
+  /// Set the number of threads used by the parallel kernels (including
+  /// the calling thread), one disables the parallel execution
+  void set_n_threads(const unsigned n);
+
+  /// Returns the minimum number of operations (usually entries) to
+  /// execute a kernel in parallel
+  unsigned long serial_threshold();
+
+  /// Set the minimum number of operations to execute a kernel in
+  /// parallel
+  void set_serial_threshold(const unsigned long n);
+
+  /// Splits the range [0, n) in chunks and calls task(begin, end) for
+  /// each of them in the threads of the pool. The calling thread also
+  /// works on the chunks and returns once all of them are done. Calls
+  /// made from inside a task (or while other thread is using the pool)
+  /// are executed by the calling thread. The tasks must not throw
+  void run(const unsigned long n,
+           const std::function<void(const unsigned long, const unsigned long)> &task);
+
+  // ================================================================
+  /// Calls task(begin, end) on chunks of the range [0, n). The chunks
+  /// are executed in parallel if the number of operations
+  /// (n * n_operations_per_index) is at least serial_threshold(),
+  /// otherwise task(0, n) is called by the calling thread
+  // ================================================================
+  template<class TASK>
+   inline void parallel_for(const unsigned long n, const TASK &task,
+                            const unsigned long n_operations_per_index = 1)
+   {
+    if (n_threads() < 2 || n * n_operations_per_index < serial_threshold())
+     {
+      task(0, n);
+     }
+    else
+     {
+      run(n, task);
+     }
+   }
+
+  // ================================================================
+  /// Deterministic reduction of the range [0, n). block_reduce(begin,
+  /// end) returns the partial result of the entries of one block
+  /// (blocks of Reduction_block_size entries) and combine(a, b) joins
+  /// two partial results. The partial results of the blocks are
+  /// combined in order starting from initial_value, the result does
+  /// not depend on the number of threads
+  // ================================================================
+  template<class T, class BLOCK_REDUCE, class COMBINE>
+   inline T parallel_reduce(const unsigned long n, const T initial_value,
+                            const BLOCK_REDUCE &block_reduce,
+                            const COMBINE &combine)
+   {
+    // Only one block, no need for temporary storage
+    if (n <= Reduction_block_size)
+     {
+      return combine(initial_value, block_reduce(0, n));
+     }
+
+    // The partial results of the blocks
+    const unsigned long n_blocks = (n + Reduction_block_size - 1) / Reduction_block_size;
+    std::vector<T> partial_results(n_blocks);
+    T *partial_results_pt = &partial_results[0];
+    parallel_for(n_blocks,
+                 [=, &block_reduce](const unsigned long begin, const unsigned long end)
+                 {
+                  for (unsigned long b = begin; b < end; b++)
+                   {
+                    const unsigned long first = b * Reduction_block_size;
+                    const unsigned long last = std::min(n, first + Reduction_block_size);
+                    partial_results_pt[b] = block_reduce(first, last);
+                   }
+                 }, Reduction_block_size);
+
+    // Combine the partial results in order
+    T result = initial_value;
+    for (unsigned long b = 0; b < n_blocks; b++)
+     {
+      result = combine(result, partial_results_pt[b]);
+     }
+    return result;
+   }
+
+ }
+
+}
+
+#endif // #ifndef THREAD_POOL_H
@@ -0,0 +1,322 @@
+/// IN THIS FILE: Implementation of an abstract class for direct
+/// solvers, the checks of the sizes and the copies of the right-hand
+/// sides and solutions are done here
+
+#include "ac_direct_linear_solver.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ /// Empty constructor
+ // ===================================================================
+ ACDirectLinearSolver::ACDirectLinearSolver()
+  : ACLinearSolver(), Resolve_enabled(false) { }
+
+ // ===================================================================
+ /// Constructor where we specify the matrix A
+ // ===================================================================
+ ACDirectLinearSolver::ACDirectLinearSolver(ACMatrix<Real> *const A_mat_pt)
+  : ACLinearSolver(A_mat_pt), Resolve_enabled(false) { }
+
+ // ===================================================================
+ /// Empty destructor
+ // ===================================================================
+ ACDirectLinearSolver::~ACDirectLinearSolver() { }
+
+ // ===================================================================
+ /// Solves a system of equations with input A_mat. We specify the
+ /// right-hand side B and the X matrices where the results are
+ /// returned
+ // ===================================================================
+ void ACDirectLinearSolver::solve(ACMatrix<Real> *const A_mat_pt,
+                                  const ACMatrix<Real> *const B_pt,
+                                  ACMatrix<Real> *const X_pt)
+ {
+  // Set the matrix and its size
+  set_matrix_A(A_mat_pt);
+
+  // Solve
+  solve(B_pt, X_pt);
+ }
+
+ // ===================================================================
+ /// Solves a system of equations with input A_mat. We specify the
+ /// right-hand side b and the x vector where the result is returned
+ // ===================================================================
+ void ACDirectLinearSolver::solve(ACMatrix<Real> *const A_mat_pt,
+                                  const ACVector<Real> *const b_pt,
+                                  ACVector<Real> *const x_pt)
+ {
+  // Set the matrix and its size
+  set_matrix_A(A_mat_pt);
+
+  // Solve
+  solve(b_pt, x_pt);
+ }
+
+ // ===================================================================
+ /// Solve a system of equations with the already stored matrix A. We
+ /// specify the right-hand side B and the X matrices where the results
+ /// are returned
+ // ===================================================================
+ void ACDirectLinearSolver::solve(const ACMatrix<Real> *const B_pt,
+                                  ACMatrix<Real> *const X_pt)
+ {
+  // Check the matrix, the right-hand side and the solution
+  check_square_matrix_has_been_set();
+  check_and_allocate(B_pt, X_pt);
+
+  // Factorise
+  factorise();
+
+  // ... and do back substitution
+  back_substitution(B_pt, X_pt);
+ }
+
+ // ===================================================================
+ /// Solve a system of equations with the already stored matrix A. We
+ /// specify the right-hand side b and the x vectors where the result
+ /// is returned
+ // ===================================================================
+ void ACDirectLinearSolver::solve(const ACVector<Real> *const b_pt,
+                                  ACVector<Real> *const x_pt)
+ {
+  // Check the matrix, the right-hand side and the solution
+  check_square_matrix_has_been_set();
+  check_and_allocate(b_pt, x_pt);
+
+  // Factorise
+  factorise();
+
+  // ... and do back substitution
+  back_substitution(b_pt, x_pt);
+ }
+
+ // ===================================================================
+ /// Re-solve a system of equations with the already stored matrix A,
+ /// reusing its factorisation
+ // ===================================================================
+ void ACDirectLinearSolver::resolve(const ACMatrix<Real> *const B_pt,
+                                    ACMatrix<Real> *const X_pt)
+ {
+  // We can only do back-substitution if a matrix has been factorised
+  if (!Resolve_enabled)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "Resolve is not enabled.\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  check_and_allocate(B_pt, X_pt);
+  back_substitution(B_pt, X_pt);
+ }
+
+ // ===================================================================
+ /// Re-solve a system of equations with the already stored matrix A,
+ /// reusing its factorisation
+ // ===================================================================
+ void ACDirectLinearSolver::resolve(const ACVector<Real> *const b_pt,
+                                    ACVector<Real> *const x_pt)
+ {
+  // We can only do back-substitution if a matrix has been factorised
+  if (!Resolve_enabled)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "Resolve is not enabled.\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  check_and_allocate(b_pt, x_pt);
+  back_substitution(b_pt, x_pt);
+ }
+
+ // ===================================================================
+ /// Performs the factorisation of the input matrix, the factorisation
+ /// is internally stored such that it can be re-used when calling
+ /// resolve
+ // ===================================================================
+ void ACDirectLinearSolver::factorise(ACMatrix<Real> *const A_mat_pt)
+ {
+  // Set the matrix and its size
+  set_matrix_A(A_mat_pt);
+
+  // Factorise
+  factorise();
+ }
+
+ // ===================================================================
+ /// Copies the right-hand sides by rows into the solution (or into the
+ /// work block if the solution is not stored by rows), calls
+ /// block_back_substitution() and copies the results into the
+ /// solution. A single right-hand side is solved as a vector
+ // ===================================================================
+ void ACDirectLinearSolver::back_substitution(const ACMatrix<Real> *const B_pt,
+                                              ACMatrix<Real> *const X_pt)
+ {
+  const unsigned long n_rows = B_pt->n_rows();
+  const unsigned long n_rhs = B_pt->n_columns();
+
+  // Get the memory of the right-hand side and the solution matrices,
+  // they are copied in and out directly when available
+  const CCMatrixSpan<Real> B = B_pt->span();
+  const CCMatrixSpan<Real> X = X_pt->span();
+
+  // A single right-hand side is solved on the work vector
+  if (n_rhs == 1)
+   {
+    Work.resize(n_rows);
+    Real *x = Work.empty() ? 0 : &Work[0];
+    if (!B.is_empty())
+     {
+      BulkKernels::copy(n_rows, B.Data_pt, B.Row_stride, x, 1);
+     }
+    else
+     {
+      for (unsigned long i = 0; i < n_rows; i++)
+       {
+        x[i] = B_pt->value(i, 0);
+       }
+     }
+
+    back_substitution(x);
+
+    if (!X.is_empty())
+     {
+      BulkKernels::copy(n_rows, x, 1, X.Data_pt, X.Row_stride);
+     }
+    else
+     {
+      for (unsigned long i = 0; i < n_rows; i++)
+       {
+        X_pt->value(i, 0) = x[i];
+       }
+     }
+    return;
+   }
+
+  // The right-hand sides are solved in the memory of the solution
+  // when it is stored by rows, otherwise in the work block
+  const bool solve_in_solution = !X.is_empty() && X.is_row_major();
+  Real *x = 0;
+  unsigned long ldx = n_rhs;
+  if (solve_in_solution)
+   {
+    x = X.Data_pt;
+    ldx = X.Row_stride;
+   }
+  else
+   {
+    Work_block.resize(n_rows * n_rhs);
+    x = Work_block.empty() ? 0 : &Work_block[0];
+   }
+
+  // Copy the right-hand sides by rows
+  for (unsigned long i = 0; i < n_rows; i++)
+   {
+    if (!B.is_empty())
+     {
+      BulkKernels::copy(n_rhs, B.Data_pt + i*B.Row_stride, B.Column_stride, x + i*ldx, 1);
+     }
+    else
+     {
+      for (unsigned long j = 0; j < n_rhs; j++)
+       {
+        x[i*ldx + j] = B_pt->value(i, j);
+       }
+     }
+   }
+
+  block_back_substitution(x, n_rhs, ldx);
+
+  if (solve_in_solution)
+   {
+    return;
+   }
+
+  // Copy the solutions
+  for (unsigned long i = 0; i < n_rows; i++)
+   {
+    if (!X.is_empty())
+     {
+      BulkKernels::copy(n_rhs, x + i*ldx, 1, X.Data_pt + i*X.Row_stride, X.Column_stride);
+     }
+    else
+     {
+      for (unsigned long j = 0; j < n_rhs; j++)
+       {
+        X_pt->value(i, j) = x[i*ldx + j];
+       }
+     }
+   }
+ }
+
+ // ===================================================================
+ /// Solves with the factorised matrix for n_rhs right-hand sides
+ /// stored by rows in X, back_substitution() is called on each column
+ /// (copied into the work vector)
+ // ===================================================================
+ void ACDirectLinearSolver::block_back_substitution(Real *X,
+                                                    const unsigned long n_rhs,
+                                                    const unsigned long ldx)
+ {
+  const unsigned long n_rows = this->A_pt->n_rows();
+  Work.resize(n_rows);
+  Real *x = Work.empty() ? 0 : &Work[0];
+  for (unsigned long j = 0; j < n_rhs; j++)
+   {
+    BulkKernels::copy(n_rows, X + j, ldx, x, 1);
+    back_substitution(x);
+    BulkKernels::copy(n_rows, x, 1, X + j, ldx);
+   }
+ }
+
+ // ===================================================================
+ /// Copies the right-hand side into the work vector, calls
+ /// back_substitution() and copies the result into the solution
+ // ===================================================================
+ void ACDirectLinearSolver::back_substitution(const ACVector<Real> *const b_pt,
+                                              ACVector<Real> *const x_pt)
+ {
+  const unsigned long n_rows = b_pt->n_values();
+  Work.resize(n_rows);
+  Real *x = Work.empty() ? 0 : &Work[0];
+
+  // Get the memory of the right-hand side and the solution vectors,
+  // they are copied in and out directly when available
+  const CCVectorSpan<Real> b = b_pt->span();
+  const CCVectorSpan<Real> x_output = x_pt->span();
+  if (!b.is_empty())
+   {
+    BulkKernels::copy(n_rows, b.Data_pt, b.Stride, x, 1);
+   }
+  else
+   {
+    for (unsigned long i = 0; i < n_rows; i++)
+     {
+      x[i] = b_pt->value(i);
+     }
+   }
+
+  back_substitution(x);
+
+  if (!x_output.is_empty())
+   {
+    BulkKernels::copy(n_rows, x, 1, x_output.Data_pt, x_output.Stride);
+   }
+  else
+   {
+    for (unsigned long i = 0; i < n_rows; i++)
+     {
+      x_pt->value(i) = x[i];
+     }
+   }
+ }
+
+}
@@ -0,0 +1,133 @@
+/// IN THIS FILE: The definition of an abstract class for direct
+/// solvers that factorise the matrix once and then solve each
+/// right-hand side in place on a contiguous work vector. The checks
+/// of the sizes, the allocation of the solutions and the copies of the
+/// right-hand sides are done here, concrete solvers only implement
+/// factorise() and back_substitution() on raw memory (and may
+/// implement block_back_substitution() to solve many right-hand sides
+/// at once)
+
+// Check whether the class has been already defined
+#ifndef ACDIRECTLINEARSOLVER_H
+#define ACDIRECTLINEARSOLVER_H
+
+// Include the header from inherited class
+#include "ac_linear_solver.h"
+
+namespace scicellxx
+{
+
+ /// Abstract class for direct linear solvers, the factorisation of the
+ /// matrix is kept such that it can be re-used by resolve()
+ class ACDirectLinearSolver : public virtual ACLinearSolver
+ {
+
+ public:
+
+  /// Empty constructor
+  ACDirectLinearSolver();
+
+  /// Constructor where we specify the matrix A
+  ACDirectLinearSolver(ACMatrix<Real> *const A_mat_pt);
+
+  /// Empty destructor
+  virtual ~ACDirectLinearSolver();
+
+  /// Solves a system of equations with input A_mat. We specify the
+  /// right-hand side B and the X matrices where the results are
+  /// returned
+  void solve(ACMatrix<Real> *const A_mat_pt, const ACMatrix<Real> *const B_pt, ACMatrix<Real> *const X_pt);
+
+  /// Solves a system of equations with input A_mat. We specify the
+  /// right-hand side b and the x vector where the result is returned
+  void solve(ACMatrix<Real> *const A_mat_pt, const ACVector<Real> *const b_pt, ACVector<Real> *const x_pt);
+
+  /// Solve a system of equations with the already stored matrix A. We
+  /// specify the right-hand side B and the X matrices where the
+  /// results are returned
+  void solve(const ACMatrix<Real> *const B_pt, ACMatrix<Real> *const X_pt);
+
+  /// Solve a system of equations with the already stored matrix A. We
+  /// specify the right-hand side b and the x vectors where the result
+  /// is returned
+  void solve(const ACVector<Real> *const b_pt, ACVector<Real> *const x_pt);
+
+  /// Re-solve a system of equations with the already stored matrix A,
+  /// reusing its factorisation
+  void resolve(const ACMatrix<Real> *const B_pt, ACMatrix<Real> *const X_pt);
+
+  /// Re-solve a system of equations with the already stored matrix A,
+  /// reusing its factorisation
+  void resolve(const ACVector<Real> *const b_pt, ACVector<Real> *const x_pt);
+
+  /// Performs the factorisation of the input matrix, the
+  /// factorisation is internally stored such that it can be re-used
+  /// when calling resolve
+  void factorise(ACMatrix<Real> *const A_mat_pt);
+
+  /// Performs the factorisation of the already stored matrix A, the
+  /// factorisation is internally stored such that it can be re-used
+  /// when calling resolve. Implementations MUST set Resolve_enabled
+  virtual void factorise() = 0;
+
+ protected:
+
+  /// The factorisation is kept by factorise() and re-used by resolve()
+  inline bool resolve_is_implemented() const {return true;}
+
+  /// Solves with the factorised matrix, x stores the right-hand side
+  /// on input and the solution on output (n_rows() entries)
+  virtual void back_substitution(Real *x) = 0;
+
+  /// Solves with the factorised matrix for n_rhs right-hand sides, X
+  /// stores them by rows on input and the solutions on output (ldx
+  /// entries between two consecutive rows). Concrete solvers may
+  /// implement blocked substitutions, by default back_substitution()
+  /// is called on each column
+  virtual void block_back_substitution(Real *X, const unsigned long n_rhs,
+                                       const unsigned long ldx);
+
+  /// Copies the right-hand sides by rows into the solution (or into
+  /// the work block if the solution is not stored by rows), calls
+  /// block_back_substitution() and copies the results into the
+  /// solution. A single right-hand side is solved as a vector
+  void back_substitution(const ACMatrix<Real> *const B_pt, ACMatrix<Real> *const X_pt);
+
+  /// Copies the right-hand side into the work vector, calls
+  /// back_substitution() and copies the result into the solution
+  void back_substitution(const ACVector<Real> *const b_pt, ACVector<Real> *const x_pt);
+
+  /// Flag to indicate whether resolve is enabled (only after calling
+  /// factorise)
+  bool Resolve_enabled;
+
+  /// The work vector used by the back substitution
+  std::vector<Real> Work;
+
+  /// The right-hand sides stored by rows when the solution is not
+  std::vector<Real> Work_block;
+
+ private:
+
+  /// Copy constructor (we do not want this class to be
+  /// copiable). Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  ACDirectLinearSolver(const ACDirectLinearSolver &copy)
+   : ACLinearSolver(), Resolve_enabled(false)
+   {
+    BrokenCopy::broken_copy("ACDirectLinearSolver");
+   }
+
+  /// Assignment operator (we do not want this class to be
+  /// copiable. Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  void operator=(const ACDirectLinearSolver &copy)
+   {
+    BrokenCopy::broken_assign("ACDirectLinearSolver");
+   }
+
+ };
+
+}
+
+#endif // #ifndef ACDIRECTLINEARSOLVER_H
@@ -0,0 +1,513 @@
+/// IN THIS FILE: Implementation of an abstract class for iterative
+/// (Krylov) solvers, the checks of the sizes, the copies of the
+/// right-hand sides and solutions, the products matrix times vector
+/// and the convergence history are done here
+
+#include "ac_iterative_linear_solver.h"
+
+// The dot products, norms and products of dense matrices
+#include "../matrices/parallel_kernels.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ /// Empty constructor
+ // ===================================================================
+ ACIterativeLinearSolver::ACIterativeLinearSolver()
+  : ACLinearSolver(), N(0),
+    Maximum_number_of_iterations(DEFAULT_MAXIMUM_ITERATIVE_SOLVER_ITERATIONS),
+    N_iterations(0), Sparse_pt(0), Tolerance(DEFAULT_ITERATIVE_SOLVER_TOLERANCE),
+    Preconditioner_pt(0), Use_initial_guess(false), Resolve_enabled(false),
+    Converged(false), Norm_b(0.0) { }
+
+ // ===================================================================
+ /// Constructor where we specify the matrix A
+ // ===================================================================
+ ACIterativeLinearSolver::ACIterativeLinearSolver(ACMatrix<Real> *const A_mat_pt)
+  : ACLinearSolver(A_mat_pt), N(0),
+    Maximum_number_of_iterations(DEFAULT_MAXIMUM_ITERATIVE_SOLVER_ITERATIONS),
+    N_iterations(0), Sparse_pt(0), Tolerance(DEFAULT_ITERATIVE_SOLVER_TOLERANCE),
+    Preconditioner_pt(0), Use_initial_guess(false), Resolve_enabled(false),
+    Converged(false), Norm_b(0.0) { }
+
+ // ===================================================================
+ /// Empty destructor
+ // ===================================================================
+ ACIterativeLinearSolver::~ACIterativeLinearSolver() { }
+
+ // ===================================================================
+ /// Solves a system of equations with input A_mat. We specify the
+ /// right-hand side B and the X matrices where the results are
+ /// returned
+ // ===================================================================
+ void ACIterativeLinearSolver::solve(ACMatrix<Real> *const A_mat_pt,
+                                     const ACMatrix<Real> *const B_pt,
+                                     ACMatrix<Real> *const X_pt)
+ {
+  // Set the matrix and its size
+  set_matrix_A(A_mat_pt);
+
+  // Solve
+  solve(B_pt, X_pt);
+ }
+
+ // ===================================================================
+ /// Solves a system of equations with input A_mat. We specify the
+ /// right-hand side b and the x vector where the result is returned
+ // ===================================================================
+ void ACIterativeLinearSolver::solve(ACMatrix<Real> *const A_mat_pt,
+                                     const ACVector<Real> *const b_pt,
+                                     ACVector<Real> *const x_pt)
+ {
+  // Set the matrix and its size
+  set_matrix_A(A_mat_pt);
+
+  // Solve
+  solve(b_pt, x_pt);
+ }
+
+ // ===================================================================
+ /// Solve a system of equations with the already stored matrix A. We
+ /// specify the right-hand side B and the X matrices where the results
+ /// are returned
+ // ===================================================================
+ void ACIterativeLinearSolver::solve(const ACMatrix<Real> *const B_pt,
+                                     ACMatrix<Real> *const X_pt)
+ {
+  // Check the matrix, the right-hand side and the solution
+  check_square_matrix_has_been_set();
+  check_and_allocate(B_pt, X_pt);
+
+  // Set up the preconditioner and iterate
+  setup(true);
+  solve_right_hand_sides(B_pt, X_pt);
+ }
+
+ // ===================================================================
+ /// Solve a system of equations with the already stored matrix A. We
+ /// specify the right-hand side b and the x vectors where the result
+ /// is returned
+ // ===================================================================
+ void ACIterativeLinearSolver::solve(const ACVector<Real> *const b_pt,
+                                     ACVector<Real> *const x_pt)
+ {
+  // Check the matrix, the right-hand side and the solution
+  check_square_matrix_has_been_set();
+  check_and_allocate(b_pt, x_pt);
+
+  // Set up the preconditioner and iterate
+  setup(true);
+  solve_right_hand_sides(b_pt, x_pt);
+ }
+
+ // ===================================================================
+ /// Re-solve a system of equations with the already stored matrix A,
+ /// reusing its preconditioner
+ // ===================================================================
+ void ACIterativeLinearSolver::resolve(const ACMatrix<Real> *const B_pt,
+                                       ACMatrix<Real> *const X_pt)
+ {
+  // The preconditioner is only available after a solve
+  if (!Resolve_enabled)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "Resolve is not enabled.\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  check_and_allocate(B_pt, X_pt);
+  setup(false);
+  solve_right_hand_sides(B_pt, X_pt);
+ }
+
+ // ===================================================================
+ /// Re-solve a system of equations with the already stored matrix A,
+ /// reusing its preconditioner
+ // ===================================================================
+ void ACIterativeLinearSolver::resolve(const ACVector<Real> *const b_pt,
+                                       ACVector<Real> *const x_pt)
+ {
+  // The preconditioner is only available after a solve
+  if (!Resolve_enabled)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "Resolve is not enabled.\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  check_and_allocate(b_pt, x_pt);
+  setup(false);
+  solve_right_hand_sides(b_pt, x_pt);
+ }
+
+ // ===================================================================
+ /// Set the tolerance of the norm of the residual relative to that of
+ /// the right-hand side
+ // ===================================================================
+ void ACIterativeLinearSolver::set_tolerance(const Real tolerance)
+ {
+  if (!(tolerance > 0.0))
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The tolerance must be positive\n"
+                  << "tolerance = " << tolerance << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  Tolerance = tolerance;
+ }
+
+ // ===================================================================
+ /// Set the maximum number of iterations per right-hand side
+ // ===================================================================
+ void ACIterativeLinearSolver::
+ set_maximum_number_of_iterations(const unsigned long maximum_number_of_iterations)
+ {
+  Maximum_number_of_iterations = maximum_number_of_iterations;
+ }
+
+ // ===================================================================
+ /// Set the preconditioner (it is not deleted by the solver), pass
+ /// NULL to iterate with no preconditioner
+ // ===================================================================
+ void ACIterativeLinearSolver::set_preconditioner(ACPreconditioner *preconditioner_pt)
+ {
+  Preconditioner_pt = preconditioner_pt;
+
+  // The new preconditioner has not been set up
+  Resolve_enabled = false;
+ }
+
+ // ===================================================================
+ /// y = A x. Sparse matrices visit their non-zero entries, dense
+ /// matrices their memory (by rows or by columns), other matrices are
+ /// read entry by entry. The rows of y are computed in parallel
+ // ===================================================================
+ void ACIterativeLinearSolver::matrix_times_vector(const Real *x, Real *y) const
+ {
+  typedef AccumulatorTraits<Real>::Accumulator_type A;
+  const unsigned long n = N;
+
+  if (Sparse_pt != 0)
+   {
+    const unsigned long *row_start = Sparse_pt->row_start_pt();
+    const unsigned long *column_index = Sparse_pt->column_index_pt();
+    const Real *values = Sparse_pt->values_pt();
+    if (Sparse_pt->n_non_zeros() == 0)
+     {
+      std::fill(y, y + n, Real(0.0));
+      return;
+     }
+    ThreadPool::parallel_for(n, [=](const unsigned long begin, const unsigned long end)
+                             {
+                              for (unsigned long i = begin; i < end; i++)
+                               {
+                                A sum = 0.0;
+                                for (unsigned long p = row_start[i]; p < row_start[i+1]; p++)
+                                 {
+                                  sum+= A(values[p]) * A(x[column_index[p]]);
+                                 }
+                                y[i] = Real(sum);
+                               }
+                             }, Sparse_pt->n_non_zeros() / n + 1);
+   }
+  else if (!Dense.is_empty() && Dense.is_row_major())
+   {
+    const CCMatrixSpan<Real> matrix = Dense;
+    ThreadPool::parallel_for(n, [=](const unsigned long begin, const unsigned long end)
+                             {
+                              for (unsigned long i = begin; i < end; i++)
+                               {
+                                y[i] = Real(ParallelKernels::serial_dot<Real, A>(n, matrix.row(i).Data_pt, x));
+                               }
+                             }, n);
+   }
+  else if (!Dense.is_empty())
+   {
+    // Column major, each thread adds the columns to its rows
+    const CCMatrixSpan<Real> matrix = Dense;
+    ThreadPool::parallel_for(n, [=](const unsigned long begin, const unsigned long end)
+                             {
+                              std::fill(y + begin, y + end, Real(0.0));
+                              for (unsigned long j = 0; j < n; j++)
+                               {
+                                BulkKernels::axpy(end - begin, x[j], &matrix(begin, j),
+                                                  matrix.Row_stride, y + begin, 1);
+                               }
+                             }, n);
+   }
+  else
+   {
+    const ACMatrix<Real> *matrix_pt = this->A_pt;
+    ThreadPool::parallel_for(n, [=](const unsigned long begin, const unsigned long end)
+                             {
+                              for (unsigned long i = begin; i < end; i++)
+                               {
+                                A sum = 0.0;
+                                for (unsigned long j = 0; j < n; j++)
+                                 {
+                                  sum+= A(matrix_pt->value(i, j)) * A(x[j]);
+                                 }
+                                y[i] = Real(sum);
+                               }
+                             }, n);
+   }
+ }
+
+ // ===================================================================
+ /// r = b - A x
+ // ===================================================================
+ void ACIterativeLinearSolver::compute_residual(const Real *b, const Real *x,
+                                                Real *r) const
+ {
+  matrix_times_vector(x, r);
+  ParallelKernels::substract(N, b, r, r);
+ }
+
+ // ===================================================================
+ /// z = M^{-1} r, a copy of r with no preconditioner
+ // ===================================================================
+ void ACIterativeLinearSolver::apply_preconditioner(const Real *r, Real *z) const
+ {
+  if (Preconditioner_pt != 0)
+   {
+    Preconditioner_pt->apply(r, z);
+   }
+  else
+   {
+    std::copy(r, r + N, z);
+   }
+ }
+
+ // ===================================================================
+ /// Returns x^T y
+ // ===================================================================
+ Real ACIterativeLinearSolver::dot(const Real *x, const Real *y) const
+ {
+  return Real(ParallelKernels::dot(N, x, y));
+ }
+
+ // ===================================================================
+ /// Returns ||x||
+ // ===================================================================
+ Real ACIterativeLinearSolver::norm_2(const Real *x) const
+ {
+  return Real(ParallelKernels::norm_2(N, x));
+ }
+
+ // ===================================================================
+ /// y = y + alpha * x, in parallel
+ // ===================================================================
+ void ACIterativeLinearSolver::axpy(const Real alpha, const Real *x, Real *y) const
+ {
+  ThreadPool::parallel_for(N, [=](const unsigned long begin, const unsigned long end)
+                           {
+                            BulkKernels::axpy(end - begin, alpha, x + begin, 1, y + begin, 1);
+                           });
+ }
+
+ // ===================================================================
+ /// Restarts the history with the norm of the initial residual,
+ /// returns whether it is already small enough
+ // ===================================================================
+ bool ACIterativeLinearSolver::start_iterations(const Real residual_norm)
+ {
+  N_iterations = 0;
+  Residual_history.clear();
+  Converged = false;
+  Residual_history.push_back(residual_norm / Norm_b);
+  Converged = Residual_history.back() <= Tolerance;
+  return Converged;
+ }
+
+ // ===================================================================
+ /// Counts one iteration and adds the norm of its residual to the
+ /// history, returns whether it is small enough. An error is thrown if
+ /// the norm is not finite
+ // ===================================================================
+ bool ACIterativeLinearSolver::residual_has_converged(const Real residual_norm)
+ {
+  N_iterations++;
+  Residual_history.push_back(residual_norm / Norm_b);
+  if (!std::isfinite(residual_norm))
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The norm of the residual is not finite at iteration "
+                  << N_iterations << "\n"
+                  << "residual_norm = " << residual_norm << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  Converged = Residual_history.back() <= Tolerance;
+  return Converged;
+ }
+
+ // ===================================================================
+ /// Throws an error for a breakdown of the iterations (a division by
+ /// zero), the name of the method and the quantity are reported
+ // ===================================================================
+ void ACIterativeLinearSolver::breakdown(const std::string &method,
+                                         const std::string &quantity) const
+ {
+  // Error message
+  std::ostringstream error_message;
+  error_message << "Breakdown of " << method << " at iteration "
+                << N_iterations << ", " << quantity << " is zero\n"
+                << "Relative residual: " << Residual_history.back() << "\n"
+                << "Try another method or preconditioner" << std::endl;
+  throw SciCellxxLibError(error_message.str(),
+                          SCICELLXX_CURRENT_FUNCTION,
+                          SCICELLXX_EXCEPTION_LOCATION);
+ }
+
+ // ===================================================================
+ /// Sets up the mat-vec (and the preconditioner if requested) for the
+ /// stored matrix
+ // ===================================================================
+ void ACIterativeLinearSolver::setup(const bool setup_preconditioner)
+ {
+  N = this->A_pt->n_rows();
+  Sparse_pt = dynamic_cast<const CCSparseMatrix<Real>*>(this->A_pt);
+  Dense = this->A_pt->span();
+
+  if (setup_preconditioner && Preconditioner_pt != 0)
+   {
+    Preconditioner_pt->setup(this->A_pt);
+   }
+  Resolve_enabled = true;
+ }
+
+ // ===================================================================
+ /// Solves each right-hand side on the work vectors
+ // ===================================================================
+ void ACIterativeLinearSolver::solve_right_hand_sides(const ACMatrix<Real> *const B_pt,
+                                                      ACMatrix<Real> *const X_pt)
+ {
+  const unsigned long n_rhs = B_pt->n_columns();
+  Work_b.resize(N);
+  Work_x.resize(N);
+  Real *b = Work_b.empty() ? 0 : &Work_b[0];
+  Real *x = Work_x.empty() ? 0 : &Work_x[0];
+
+  // Get the memory of the right-hand side and the solution matrices,
+  // the columns are copied in and out directly when available
+  const CCMatrixSpan<Real> B = B_pt->span();
+  const CCMatrixSpan<Real> X = X_pt->span();
+  for (unsigned long j = 0; j < n_rhs; j++)
+   {
+    for (unsigned long i = 0; i < N; i++)
+     {
+      b[i] = B.is_empty() ? B_pt->value(i, j) : B(i, j);
+      x[i] = !Use_initial_guess ? Real(0.0) : (X.is_empty() ? X_pt->value(i, j) : X(i, j));
+     }
+
+    iterate_on_work_vectors();
+
+    for (unsigned long i = 0; i < N; i++)
+     {
+      if (!X.is_empty())
+       {
+        X(i, j) = x[i];
+       }
+      else
+       {
+        X_pt->value(i, j) = x[i];
+       }
+     }
+
+    check_convergence();
+   }
+ }
+
+ // ===================================================================
+ /// Solves the right-hand side on the work vectors
+ // ===================================================================
+ void ACIterativeLinearSolver::solve_right_hand_sides(const ACVector<Real> *const b_pt,
+                                                      ACVector<Real> *const x_pt)
+ {
+  Work_b.resize(N);
+  Work_x.resize(N);
+  Real *b = Work_b.empty() ? 0 : &Work_b[0];
+  Real *x = Work_x.empty() ? 0 : &Work_x[0];
+
+  // Get the memory of the right-hand side and the solution vectors,
+  // they are copied in and out directly when available
+  const CCVectorSpan<Real> b_input = b_pt->span();
+  const CCVectorSpan<Real> x_output = x_pt->span();
+  for (unsigned long i = 0; i < N; i++)
+   {
+    b[i] = b_input.is_empty() ? b_pt->value(i) : b_input[i];
+    x[i] = !Use_initial_guess ? Real(0.0) : (x_output.is_empty() ? x_pt->value(i) : x_output[i]);
+   }
+
+  iterate_on_work_vectors();
+
+  for (unsigned long i = 0; i < N; i++)
+   {
+    if (!x_output.is_empty())
+     {
+      x_output[i] = x[i];
+     }
+    else
+     {
+      x_pt->value(i) = x[i];
+     }
+   }
+
+  check_convergence();
+ }
+
+ // ===================================================================
+ /// Calls iterate() on the work vectors, the solution is zero for a
+ /// zero right-hand side
+ // ===================================================================
+ void ACIterativeLinearSolver::iterate_on_work_vectors()
+ {
+  Real *b = Work_b.empty() ? 0 : &Work_b[0];
+  Real *x = Work_x.empty() ? 0 : &Work_x[0];
+  Norm_b = norm_2(b);
+  if (Norm_b == 0.0)
+   {
+    std::fill(Work_x.begin(), Work_x.end(), Real(0.0));
+    N_iterations = 0;
+    Residual_history.assign(1, Real(0.0));
+    Converged = true;
+    return;
+   }
+
+  iterate(b, x);
+ }
+
+ // ===================================================================
+ /// Throws an error if the last right-hand side did not converge
+ // ===================================================================
+ void ACIterativeLinearSolver::check_convergence() const
+ {
+  if (!Converged)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The iterative solver did not converge in "
+                  << N_iterations << " iterations\n"
+                  << "Relative residual: " << Residual_history.back() << "\n"
+                  << "Tolerance: " << Tolerance << "\n"
+                  << "Increase the maximum number of iterations or use\n"
+                  << "a preconditioner" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+ }
+
+}
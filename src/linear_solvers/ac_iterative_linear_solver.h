@@ -0,0 +1,254 @@
+/// IN THIS FILE: The definition of an abstract class for iterative
+/// (Krylov) solvers. They only access the matrix by products matrix
+/// times vector, thus any square ACMatrix can be used (dense or
+/// sparse). The checks of the sizes, the copies of the right-hand
+/// sides and solutions, the preconditioner and the convergence
+/// history are handled here, concrete solvers only implement
+/// iterate() on raw memory
+
+// Check whether the class has been already defined
+#ifndef ACITERATIVELINEARSOLVER_H
+#define ACITERATIVELINEARSOLVER_H
+
+// Include the header from inherited class
+#include "ac_linear_solver.h"
+
+// The preconditioners
+#include "ac_preconditioner.h"
+
+// The compressed rows of sparse matrices
+#include "../matrices/cc_sparse_matrix.h"
+
+namespace scicellxx
+{
+
+#ifdef TYPEDEF_REAL_IS_DOUBLE
+#define DEFAULT_ITERATIVE_SOLVER_TOLERANCE 1.0e-10
+#else
+#define DEFAULT_ITERATIVE_SOLVER_TOLERANCE 1.0e-5
+#endif // #ifdef TYPEDEF_REAL_IS_DOUBLE
+#define DEFAULT_MAXIMUM_ITERATIVE_SOLVER_ITERATIONS 1000
+
+ /// Abstract class for iterative linear solvers. A system is solved
+ /// when the norm 2 of its residual, b - A x, is at most Tolerance
+ /// times that of the right-hand side. The iterations start from zero
+ /// unless the initial guess is enabled, then the input solution is
+ /// used. An error is thrown when a system is not solved in
+ /// Maximum_number_of_iterations iterations (the last iterate is
+ /// returned in the solution before), as Newton's method does.
+ ///
+ /// The preconditioner is not owned by the solver, it is set up each
+ /// time the matrix is solved and re-used by resolve(). The number of
+ /// iterations and the history of the relative residual norms,
+ /// ||r_k|| / ||b|| with k = 0 for the initial guess, refer to the
+ /// last right-hand side solved (each column of a matrix of
+ /// right-hand sides is solved on its own)
+ class ACIterativeLinearSolver : public virtual ACLinearSolver
+ {
+
+ public:
+
+  /// Empty constructor
+  ACIterativeLinearSolver();
+
+  /// Constructor where we specify the matrix A
+  ACIterativeLinearSolver(ACMatrix<Real> *const A_mat_pt);
+
+  /// Empty destructor
+  virtual ~ACIterativeLinearSolver();
+
+  /// Solves a system of equations with input A_mat. We specify the
+  /// right-hand side B and the X matrices where the results are
+  /// returned
+  void solve(ACMatrix<Real> *const A_mat_pt, const ACMatrix<Real> *const B_pt, ACMatrix<Real> *const X_pt);
+
+  /// Solves a system of equations with input A_mat. We specify the
+  /// right-hand side b and the x vector where the result is returned
+  void solve(ACMatrix<Real> *const A_mat_pt, const ACVector<Real> *const b_pt, ACVector<Real> *const x_pt);
+
+  /// Solve a system of equations with the already stored matrix A. We
+  /// specify the right-hand side B and the X matrices where the
+  /// results are returned
+  void solve(const ACMatrix<Real> *const B_pt, ACMatrix<Real> *const X_pt);
+
+  /// Solve a system of equations with the already stored matrix A. We
+  /// specify the right-hand side b and the x vectors where the result
+  /// is returned
+  void solve(const ACVector<Real> *const b_pt, ACVector<Real> *const x_pt);
+
+  /// Re-solve a system of equations with the already stored matrix A,
+  /// reusing its preconditioner
+  void resolve(const ACMatrix<Real> *const B_pt, ACMatrix<Real> *const X_pt);
+
+  /// Re-solve a system of equations with the already stored matrix A,
+  /// reusing its preconditioner
+  void resolve(const ACVector<Real> *const b_pt, ACVector<Real> *const x_pt);
+
+  /// Set the tolerance of the norm of the residual relative to that of
+  /// the right-hand side
+  void set_tolerance(const Real tolerance);
+
+  /// The tolerance of the relative residual
+  inline Real tolerance() const {return Tolerance;}
+
+  /// Set the maximum number of iterations per right-hand side
+  void set_maximum_number_of_iterations(const unsigned long maximum_number_of_iterations);
+
+  /// The maximum number of iterations per right-hand side
+  inline unsigned long maximum_number_of_iterations() const
+  {return Maximum_number_of_iterations;}
+
+  /// Set the preconditioner (it is not deleted by the solver), pass
+  /// NULL to iterate with no preconditioner
+  void set_preconditioner(ACPreconditioner *preconditioner_pt);
+
+  /// The preconditioner, NULL if none
+  inline ACPreconditioner *preconditioner_pt() const {return Preconditioner_pt;}
+
+  /// Use the input solution as the initial guess
+  inline void enable_initial_guess() {Use_initial_guess = true;}
+
+  /// Start the iterations from zero (default)
+  inline void disable_initial_guess() {Use_initial_guess = false;}
+
+  /// The number of iterations of the last right-hand side solved
+  inline unsigned long n_iterations() const {return N_iterations;}
+
+  /// The relative residual norms of the last right-hand side solved,
+  /// one for the initial guess and one per iteration
+  inline const std::vector<Real> &residual_history() const {return Residual_history;}
+
+ protected:
+
+  /// The preconditioner is kept by solve() and re-used by resolve()
+  inline bool resolve_is_implemented() const {return true;}
+
+  /// Solves A x = b with the already stored matrix and the already set
+  /// up preconditioner, x stores the initial guess on input and the
+  /// solution on output. Implementations MUST call
+  /// start_iterations() with the initial residual and
+  /// residual_has_converged() once per iteration while
+  /// iterations_left()
+  virtual void iterate(const Real *b, Real *x) = 0;
+
+  /// y = A x
+  void matrix_times_vector(const Real *x, Real *y) const;
+
+  /// r = b - A x
+  void compute_residual(const Real *b, const Real *x, Real *r) const;
+
+  /// z = M^{-1} r, a copy of r with no preconditioner
+  void apply_preconditioner(const Real *r, Real *z) const;
+
+  /// Returns x^T y
+  Real dot(const Real *x, const Real *y) const;
+
+  /// Returns ||x||
+  Real norm_2(const Real *x) const;
+
+  /// y = y + alpha * x, in parallel
+  void axpy(const Real alpha, const Real *x, Real *y) const;
+
+  /// Restarts the history with the norm of the initial residual,
+  /// returns whether it is already small enough
+  bool start_iterations(const Real residual_norm);
+
+  /// Counts one iteration and adds the norm of its residual to the
+  /// history, returns whether it is small enough. An error is thrown
+  /// if the norm is not finite
+  bool residual_has_converged(const Real residual_norm);
+
+  /// Returns whether the norm of a residual is small enough, without
+  /// counting an iteration
+  inline bool residual_is_small(const Real residual_norm) const
+  {return residual_norm <= Tolerance * Norm_b;}
+
+  /// Returns whether more iterations are allowed
+  inline bool iterations_left() const
+  {return N_iterations < Maximum_number_of_iterations;}
+
+  /// Throws an error for a breakdown of the iterations (a division by
+  /// zero), the name of the method and the quantity are reported
+  void breakdown(const std::string &method, const std::string &quantity) const;
+
+  /// The number of rows of the matrix
+  unsigned long N;
+
+  /// The maximum number of iterations per right-hand side
+  unsigned long Maximum_number_of_iterations;
+
+  /// The number of iterations of the last right-hand side
+  unsigned long N_iterations;
+
+ private:
+
+  /// Sets up the mat-vec (and the preconditioner if requested) for the
+  /// stored matrix
+  void setup(const bool setup_preconditioner);
+
+  /// Solves each right-hand side on the work vectors
+  void solve_right_hand_sides(const ACMatrix<Real> *const B_pt, ACMatrix<Real> *const X_pt);
+
+  /// Solves the right-hand side on the work vectors
+  void solve_right_hand_sides(const ACVector<Real> *const b_pt, ACVector<Real> *const x_pt);
+
+  /// Calls iterate() on the work vectors, the solution is zero for a
+  /// zero right-hand side
+  void iterate_on_work_vectors();
+
+  /// Throws an error if the last right-hand side did not converge
+  void check_convergence() const;
+
+  /// The matrix as a sparse matrix, NULL if it is not sparse
+  const CCSparseMatrix<Real> *Sparse_pt;
+
+  /// The memory of a dense matrix, empty if not available
+  CCMatrixSpan<Real> Dense;
+
+  /// The tolerance of the relative residual
+  Real Tolerance;
+
+  /// The preconditioner, NULL if none
+  ACPreconditioner *Preconditioner_pt;
+
+  /// Flag to indicate whether the input solution is the initial guess
+  bool Use_initial_guess;
+
+  /// Flag to indicate whether resolve is enabled (only after a solve)
+  bool Resolve_enabled;
+
+  /// The relative residual norms of the last right-hand side
+  std::vector<Real> Residual_history;
+
+  /// Flag to indicate whether the last right-hand side converged
+  bool Converged;
+
+  /// The norm of the right-hand side being solved
+  Real Norm_b;
+
+  /// The right-hand side and the solution being solved
+  std::vector<Real> Work_b;
+  std::vector<Real> Work_x;
+
+  /// Copy constructor (we do not want this class to be
+  /// copiable). Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  ACIterativeLinearSolver(const ACIterativeLinearSolver &copy)
+   : ACLinearSolver()
+   {
+    BrokenCopy::broken_copy("ACIterativeLinearSolver");
+   }
+
+  /// Assignment operator (we do not want this class to be
+  /// copiable. Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  void operator=(const ACIterativeLinearSolver &copy)
+   {
+    BrokenCopy::broken_assign("ACIterativeLinearSolver");
+   }
+
+ };
+
+}
+
+#endif // #ifndef ACITERATIVELINEARSOLVER_H
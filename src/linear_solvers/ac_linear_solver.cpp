@@ -11,13 +11,20 @@ namespace scicellxx
  /// Constructor
  // ===================================================================
  ACLinearSolver::ACLinearSolver() 
-  : Matrix_A_has_been_set(false)
+  : Matrix_A_has_been_set(false),
+    Factorisation_is_cached(false),
+    Cached_matrix_pt(0),
+    Cached_matrix_version(0)
  { }
  
  // ===================================================================
  /// Constructor where we specify the matrix A of size m X n
  // ===================================================================
  ACLinearSolver::ACLinearSolver(ACMatrix<Real> *const matrix_pt)
+  : Matrix_A_has_been_set(false),
+    Factorisation_is_cached(false),
+    Cached_matrix_pt(0),
+    Cached_matrix_version(0)
  {
   set_matrix_A(matrix_pt);
   
@@ -45,6 +52,9 @@ namespace scicellxx
   // Set matrix A
   A_pt = matrix_pt;
   
+  // The cached factorisation (if any) is no longer that of the matrix
+  Factorisation_is_cached = false;
+  
   // Set the flag to indicate that the matrix A has been set
   Matrix_A_has_been_set = true;
  }
@@ -70,4 +80,180 @@ namespace scicellxx
  
  }
 
+ // ===================================================================
+ /// Solves a system of equations with input A_mat whose values are
+ /// identified by matrix_version. The factorisation (or
+ /// preconditioner) of the same matrix and version is re-used by
+ /// calling resolve(), otherwise solve() is called and its
+ /// factorisation is cached for the next calls. Solvers that can not
+ /// resolve always call solve(). Returns whether the matrix was
+ /// factorised
+ // ===================================================================
+ bool ACLinearSolver::solve_with_cached_factorisation(ACMatrix<Real> *const A_mat_pt,
+                                                      const unsigned long matrix_version,
+                                                      const ACVector<Real> *const b_pt,
+                                                      ACVector<Real> *const x_pt)
+ {
+  // Only back substitution when the factorisation is that of the
+  // matrix
+  if (factorisation_is_cached(A_mat_pt, matrix_version))
+   {
+    resolve(b_pt, x_pt);
+    return false;
+   }
+  
+  // Factorise and solve (this clears the cached factorisation)
+  solve(A_mat_pt, b_pt, x_pt);
+  
+  // Keep the factorisation for the next calls
+  if (resolve_is_implemented())
+   {
+    Factorisation_is_cached = true;
+    Cached_matrix_pt = A_mat_pt;
+    Cached_matrix_version = matrix_version;
+   }
+  
+  return true;
+ }
+ 
+ // ===================================================================
+ /// Returns whether the factorisation of the input matrix and version
+ /// is cached
+ // ===================================================================
+ bool ACLinearSolver::factorisation_is_cached(const ACMatrix<Real> *const A_mat_pt,
+                                              const unsigned long matrix_version) const
+ {
+  return Factorisation_is_cached && Matrix_A_has_been_set &&
+   A_pt == A_mat_pt && Cached_matrix_pt == A_mat_pt &&
+   Cached_matrix_version == matrix_version;
+ }
+
+ // ===================================================================
+ /// Checks that the matrix has been set and that it is square
+ // ===================================================================
+ void ACLinearSolver::check_square_matrix_has_been_set() const
+ {
+  if (!this->Matrix_A_has_been_set)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "You have not specified any matrix for the system of\n"
+                  << "equations. Set one matrix first by calling the\n"
+                  << "set_matrix_A() method or use the solve() method where\n"
+                  << "you can specify the matrix associated to the system\n"
+                  << "of equations." << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  const unsigned long n_rows = this->A_pt->n_rows();
+  const unsigned long n_columns = this->A_pt->n_columns();
+  if (n_rows != n_columns)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix is not square." << std::endl
+                  << "The matrix is of size: " << n_rows << " x "
+                  << n_columns << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+ }
+
+ // ===================================================================
+ /// Checks the sizes of the right-hand side and the solution,
+ /// allocates the solution if it has no memory
+ // ===================================================================
+ void ACLinearSolver::check_and_allocate(const ACMatrix<Real> *const B_pt,
+                                               ACMatrix<Real> *const X_pt) const
+ {
+  if (this->A_pt->n_columns() != B_pt->n_rows())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The number of columns of the matrix and the number "
+                  << "of rows of the rhs matrix are not the same:\n"
+                  << "A_pt->n_columns() = (" << this->A_pt->n_columns() << ")\n"
+                  << "B_pt->n_rows() = (" << B_pt->n_rows() << ")\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check whether the solution matrix has allocated memory,
+  // otherwise allocate it here!!!
+  if (!X_pt->is_own_memory_allocated())
+   {
+    X_pt->allocate_memory(this->A_pt->n_rows(), B_pt->n_columns());
+   }
+  else if (this->A_pt->n_rows() != X_pt->n_rows() ||
+           B_pt->n_columns() != X_pt->n_columns())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The size of the solution matrix is not appropiate:\n"
+                  << "A_pt->n_rows() = (" << this->A_pt->n_rows() << ")\n"
+                  << "B_pt->n_columns() = (" << B_pt->n_columns() << ")\n"
+                  << "dim(X) = (" << X_pt->n_rows() << ", "
+                  << X_pt->n_columns() << ")\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+ }
+
+ // ===================================================================
+ /// Checks the sizes of the right-hand side and the solution,
+ /// allocates the solution if it has no memory
+ // ===================================================================
+ void ACLinearSolver::check_and_allocate(const ACVector<Real> *const b_pt,
+                                               ACVector<Real> *const x_pt) const
+ {
+  if (this->A_pt->n_columns() != b_pt->n_values())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The number of columns of the matrix and the number "
+                  << "of rows of the rhs vector are not the same:\n"
+                  << "A_pt->n_columns() = (" << this->A_pt->n_columns() << ")\n"
+                  << "b_pt->n_values() = (" << b_pt->n_values() << ")\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check whether the solution vector is a column vector
+  if (!x_pt->is_column_vector())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The solution vector is not a column vector\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check whether the solution vector has allocated memory,
+  // otherwise allocate it here!!!
+  if (!x_pt->is_own_memory_allocated())
+   {
+    x_pt->allocate_memory(this->A_pt->n_rows());
+   }
+  else if (this->A_pt->n_rows() != x_pt->n_values())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The number of rows of the matrix and the number "
+                  << "of rows of the solution vector are not the same:\n"
+                  << "A_pt->n_rows() = (" << this->A_pt->n_rows() << ")\n"
+                  << "x_pt->n_values() = (" << x_pt->n_values() << ")\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+ }
+
 }
@@ -103,15 +103,59 @@ namespace scicellxx
                           SCICELLXX_EXCEPTION_LOCATION);
   }
   
+  /// Solves a system of equations with input A_mat whose values are
+  /// identified by matrix_version (increase it each time the values
+  /// of the matrix change). The factorisation (or preconditioner) of
+  /// the same matrix and version is re-used by calling resolve(),
+  /// otherwise solve() is called and its factorisation is cached for
+  /// the next calls. Solvers that can not resolve always call
+  /// solve(). Returns whether the matrix was factorised
+  bool solve_with_cached_factorisation(ACMatrix<Real> *const A_mat_pt,
+                                       const unsigned long matrix_version,
+                                       const ACVector<Real> *const b_pt,
+                                       ACVector<Real> *const x_pt);
+  
+  /// Returns whether the factorisation of the input matrix and version
+  /// is cached
+  bool factorisation_is_cached(const ACMatrix<Real> *const A_mat_pt,
+                               const unsigned long matrix_version) const;
+  
+  /// Forgets the cached factorisation, the next call to
+  /// solve_with_cached_factorisation() factorises the matrix
+  inline void clear_cached_factorisation() {Factorisation_is_cached = false;}
+  
  protected:
   
+  /// Returns whether resolve() is implemented, the factorisations of
+  /// solvers that do not implement it are not cached
+  virtual bool resolve_is_implemented() const {return false;}
+  
   /// The matrix A
   ACMatrix<Real> *A_pt;
   
   /// Flag to indicate whether the matrix A has been set
   bool Matrix_A_has_been_set;
+
+  /// Checks that the matrix has been set and that it is square
+  void check_square_matrix_has_been_set() const;
+
+  /// Checks the sizes of the right-hand side and the solution,
+  /// allocates the solution if it has no memory
+  void check_and_allocate(const ACMatrix<Real> *const B_pt, ACMatrix<Real> *const X_pt) const;
+
+  /// Checks the sizes of the right-hand side and the solution,
+  /// allocates the solution if it has no memory
+  void check_and_allocate(const ACVector<Real> *const b_pt, ACVector<Real> *const x_pt) const;
   
  private:
+  
+  /// Flag to indicate whether there is a cached factorisation, it is
+  /// cleared each time a matrix is set
+  bool Factorisation_is_cached;
+  
+  /// The matrix and the version of the cached factorisation
+  const ACMatrix<Real> *Cached_matrix_pt;
+  unsigned long Cached_matrix_version;
  
   /// Copy constructor (we do not want this class to be copiable). Check
   /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
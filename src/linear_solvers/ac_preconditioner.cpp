@@ -0,0 +1,128 @@
+/// IN THIS FILE: Implementation of an abstract class for the
+/// preconditioners of the iterative linear solvers
+
+#include "ac_preconditioner.h"
+
+// The compressed rows of sparse matrices
+#include "../matrices/cc_sparse_matrix.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ /// Empty constructor
+ // ===================================================================
+ ACPreconditioner::ACPreconditioner()
+  : N(0) { }
+
+ // ===================================================================
+ /// Empty destructor
+ // ===================================================================
+ ACPreconditioner::~ACPreconditioner() { }
+
+ // ===================================================================
+ /// Checks that the matrix is square and stores its number of rows
+ // ===================================================================
+ void ACPreconditioner::check_square_matrix(const ACMatrix<Real> *const A_mat_pt)
+ {
+  const unsigned long n_rows = A_mat_pt->n_rows();
+  const unsigned long n_columns = A_mat_pt->n_columns();
+  if (n_rows != n_columns)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix is not square." << std::endl
+                  << "The matrix is of size: " << n_rows << " x "
+                  << n_columns << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  N = n_rows;
+ }
+
+ // ===================================================================
+ /// Copies the non-zero entries of the matrix in compressed sparse row
+ /// format, the column indices of each row are sorted. Sparse matrices
+ /// are copied with their sparsity pattern
+ // ===================================================================
+ void ACPreconditioner::copy_to_compressed_rows(const ACMatrix<Real> *const A_mat_pt,
+                                                std::vector<unsigned long> &row_start,
+                                                std::vector<unsigned long> &column_index,
+                                                std::vector<Real> &values) const
+ {
+  const unsigned long n_rows = A_mat_pt->n_rows();
+  const unsigned long n_columns = A_mat_pt->n_columns();
+  row_start.assign(n_rows + 1, 0);
+  column_index.clear();
+  values.clear();
+
+  // Sparse matrices are already stored by compressed rows
+  const CCSparseMatrix<Real> *sparse_pt =
+   dynamic_cast<const CCSparseMatrix<Real>*>(A_mat_pt);
+  if (sparse_pt != 0)
+   {
+    const unsigned long n_non_zeros = sparse_pt->n_non_zeros();
+    if (n_non_zeros > 0)
+     {
+      const unsigned long *row_start_pt = sparse_pt->row_start_pt();
+      const unsigned long *column_index_pt = sparse_pt->column_index_pt();
+      const Real *values_pt = sparse_pt->values_pt();
+      row_start.assign(row_start_pt, row_start_pt + n_rows + 1);
+      column_index.assign(column_index_pt, column_index_pt + n_non_zeros);
+      values.assign(values_pt, values_pt + n_non_zeros);
+     }
+    return;
+   }
+
+  // Dense matrices, read by their span when they have one
+  const CCMatrixSpan<Real> A = A_mat_pt->span();
+  for (unsigned long i = 0; i < n_rows; i++)
+   {
+    for (unsigned long j = 0; j < n_columns; j++)
+     {
+      const Real a_ij = A.is_empty() ? A_mat_pt->value(i, j) : A(i, j);
+      if (a_ij != 0.0)
+       {
+        column_index.push_back(j);
+        values.push_back(a_ij);
+       }
+     }
+    row_start[i+1] = column_index.size();
+   }
+ }
+
+ // ===================================================================
+ /// Returns in diagonal_position the position of the diagonal entry of
+ /// each row of the compressed rows, an error is thrown if a diagonal
+ /// entry is zero or out of the sparsity pattern
+ // ===================================================================
+ void ACPreconditioner::find_diagonal(const std::vector<unsigned long> &row_start,
+                                      const std::vector<unsigned long> &column_index,
+                                      const std::vector<Real> &values,
+                                      std::vector<unsigned long> &diagonal_position) const
+ {
+  const unsigned long n_rows = row_start.size() - 1;
+  diagonal_position.resize(n_rows);
+  for (unsigned long i = 0; i < n_rows; i++)
+   {
+    // The column indices are sorted, search for the diagonal
+    const unsigned long *begin = column_index.data() + row_start[i];
+    const unsigned long *end = column_index.data() + row_start[i+1];
+    const unsigned long *diagonal = std::lower_bound(begin, end, i);
+    if (diagonal == end || *diagonal != i ||
+        values[diagonal - column_index.data()] == 0.0)
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The diagonal entry of row " << i << " is zero, the\n"
+                    << "preconditioner can not be computed" << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+    diagonal_position[i] = diagonal - column_index.data();
+   }
+ }
+
+}
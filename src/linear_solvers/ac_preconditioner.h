@@ -0,0 +1,90 @@
+/// IN THIS FILE: The definition of an abstract class for the
+/// preconditioners of the iterative (Krylov) linear solvers. A
+/// preconditioner is set up once per matrix and then applied to many
+/// vectors, z = M^{-1} r, on raw memory
+
+// Check whether the class has been already defined
+#ifndef ACPRECONDITIONER_H
+#define ACPRECONDITIONER_H
+
+#include "../general/common_includes.h"
+#include "../general/utilities.h"
+
+#include "../matrices/ac_matrix.h"
+
+namespace scicellxx
+{
+
+ /// Abstract class for preconditioners, concrete preconditioners MUST
+ /// implement setup() and apply(). The matrix may be any square
+ /// ACMatrix, sparse matrices are read through their compressed rows
+ /// and dense ones through their spans (only the non-zero entries are
+ /// kept)
+ class ACPreconditioner
+ {
+
+ public:
+
+  /// Empty constructor
+  ACPreconditioner();
+
+  /// Empty destructor
+  virtual ~ACPreconditioner();
+
+  /// Computes the preconditioner of the input matrix
+  virtual void setup(const ACMatrix<Real> *const A_mat_pt) = 0;
+
+  /// Applies the preconditioner, z = M^{-1} r, r and z have n_rows()
+  /// entries and must not overlap
+  virtual void apply(const Real *r, Real *z) const = 0;
+
+  /// The number of rows of the matrix used in setup()
+  inline unsigned long n_rows() const {return N;}
+
+ protected:
+
+  /// Checks that the matrix is square and stores its number of rows
+  void check_square_matrix(const ACMatrix<Real> *const A_mat_pt);
+
+  /// Copies the non-zero entries of the matrix in compressed sparse
+  /// row format, the column indices of each row are sorted. Sparse
+  /// matrices are copied with their sparsity pattern
+  void copy_to_compressed_rows(const ACMatrix<Real> *const A_mat_pt,
+                               std::vector<unsigned long> &row_start,
+                               std::vector<unsigned long> &column_index,
+                               std::vector<Real> &values) const;
+
+  /// Returns in diagonal_position the position of the diagonal entry
+  /// of each row of the compressed rows, an error is thrown if a
+  /// diagonal entry is zero or out of the sparsity pattern
+  void find_diagonal(const std::vector<unsigned long> &row_start,
+                     const std::vector<unsigned long> &column_index,
+                     const std::vector<Real> &values,
+                     std::vector<unsigned long> &diagonal_position) const;
+
+  /// The number of rows of the matrix
+  unsigned long N;
+
+ private:
+
+  /// Copy constructor (we do not want this class to be
+  /// copiable). Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  ACPreconditioner(const ACPreconditioner &copy)
+   {
+    BrokenCopy::broken_copy("ACPreconditioner");
+   }
+
+  /// Assignment operator (we do not want this class to be
+  /// copiable. Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  void operator=(const ACPreconditioner &copy)
+   {
+    BrokenCopy::broken_assign("ACPreconditioner");
+   }
+
+ };
+
+}
+
+#endif // #ifndef ACPRECONDITIONER_H
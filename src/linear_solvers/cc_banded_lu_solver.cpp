@@ -0,0 +1,177 @@
+/// IN THIS FILE: Implementation of a concrete class to solve systems
+/// of equations with banded matrices by LU decomposition with partial
+/// pivoting
+
+#include "cc_banded_lu_solver.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ /// Empty constructor
+ // ===================================================================
+ CCBandedLUSolver::CCBandedLUSolver()
+  : ACLinearSolver(), ACDirectLinearSolver(), KL(0), KU(0) { }
+
+ // ===================================================================
+ /// Constructor where we specify the matrix A
+ // ===================================================================
+ CCBandedLUSolver::CCBandedLUSolver(ACMatrix<Real> *const A_mat_pt)
+  : ACLinearSolver(A_mat_pt), ACDirectLinearSolver(A_mat_pt), KL(0), KU(0) { }
+
+ // ===================================================================
+ /// Empty destructor
+ // ===================================================================
+ CCBandedLUSolver::~CCBandedLUSolver() { }
+
+ // ===================================================================
+ /// Performs the LU factorisation of the already stored matrix A, the
+ /// factorisation is internally stored such that it can be re-used
+ /// when calling resolve
+ // ===================================================================
+ void CCBandedLUSolver::factorise()
+ {
+  check_square_matrix_has_been_set();
+
+  // Only banded matrices are supported
+  const CCBandedMatrix<Real> *banded_pt =
+   dynamic_cast<const CCBandedMatrix<Real>*>(this->A_pt);
+  if (banded_pt == 0)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The banded LU solver only works with banded matrices\n"
+                  << "(CCBandedMatrix). Use a dense solver for other matrices"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  const unsigned long n = banded_pt->n_rows();
+  KL = banded_pt->n_lower_diagonals();
+  KU = banded_pt->n_upper_diagonals();
+  const unsigned long band_width = banded_pt->band_width();
+  // Extra KL diagonals above the band store the fill-in
+  const unsigned long width = 2*KL + KU + 1;
+
+  // Copy the band, the (i, j) entry is at the same position within
+  // the row in both storages
+  LU.assign(n * width, Real(0));
+  Pivots.resize(n);
+  const Real *band_pt = banded_pt->band_pt();
+  for (unsigned long i = 0; i < n; i++)
+   {
+    std::copy(band_pt + i*band_width, band_pt + (i+1)*band_width, &LU[i*width]);
+   }
+
+  Real *lu = LU.empty() ? 0 : &LU[0];
+  for (unsigned long k = 0; k < n; k++)
+   {
+    // The rows and columns modified at this step
+    const unsigned long i_end = std::min(n, k + KL + 1);
+    const unsigned long j_end = std::min(n, k + KL + KU + 1);
+
+    // Find the pivot within the KL rows below the diagonal
+    unsigned long p = k;
+    Real max_pivot = std::fabs(lu[k*width + KL]);
+    for (unsigned long i = k + 1; i < i_end; i++)
+     {
+      const Real candidate = std::fabs(lu[i*width + k + KL - i]);
+      if (candidate > max_pivot)
+       {
+        max_pivot = candidate;
+        p = i;
+       }
+     }
+    Pivots[k] = p;
+
+    if (max_pivot == Real(0))
+     {
+      Resolve_enabled = false;
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The matrix is singular, zero pivot in column "
+                    << k << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+
+    // The rows are stored with an offset, row_pt[j] is the (i, j)
+    // entry
+    Real *row_k = lu + k*width + KL - k;
+    if (p != k)
+     {
+      Real *row_p = lu + p*width + KL - p;
+      for (unsigned long j = k; j < j_end; j++)
+       {
+        std::swap(row_k[j], row_p[j]);
+       }
+     }
+
+    // Eliminate the entries below the pivot, the multipliers are
+    // stored in their place
+    const Real inverse_pivot = Real(1) / row_k[k];
+    for (unsigned long i = k + 1; i < i_end; i++)
+     {
+      Real *row_i = lu + i*width + KL - i;
+      const Real multiplier = row_i[k] * inverse_pivot;
+      row_i[k] = multiplier;
+      if (multiplier != Real(0))
+       {
+        for (unsigned long j = k + 1; j < j_end; j++)
+         {
+          row_i[j]-= multiplier * row_k[j];
+         }
+       }
+     }
+   }
+
+  // Set the flag to indicate that resolve is enabled since we have
+  // computed the LU decomposition
+  Resolve_enabled = true;
+ }
+
+ // ===================================================================
+ /// Solves with the factorised matrix, x stores the right-hand side on
+ /// input and the solution on output
+ // ===================================================================
+ void CCBandedLUSolver::back_substitution(Real *x)
+ {
+  const unsigned long n = Pivots.size();
+  const unsigned long width = 2*KL + KU + 1;
+  const Real *lu = LU.empty() ? 0 : &LU[0];
+
+  // Forward substitution with L, the interchanges are applied in the
+  // same order as in the factorisation
+  for (unsigned long k = 0; k < n; k++)
+   {
+    const unsigned long p = Pivots[k];
+    if (p != k)
+     {
+      std::swap(x[k], x[p]);
+     }
+    const Real x_k = x[k];
+    const unsigned long i_end = std::min(n, k + KL + 1);
+    for (unsigned long i = k + 1; i < i_end; i++)
+     {
+      x[i]-= lu[i*width + k + KL - i] * x_k;
+     }
+   }
+
+  // Backward substitution with U
+  for (unsigned long i = n; i-- > 0; )
+   {
+    const Real *row_i = lu + i*width + KL - i;
+    const unsigned long j_end = std::min(n, i + KL + KU + 1);
+    Real sum = x[i];
+    for (unsigned long j = i + 1; j < j_end; j++)
+     {
+      sum-= row_i[j] * x[j];
+     }
+    x[i] = sum / row_i[i];
+   }
+ }
+
+}
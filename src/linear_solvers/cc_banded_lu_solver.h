@@ -0,0 +1,89 @@
+/// IN THIS FILE: The definition of the concrete class CCBandedLUSolver
+/// to solve systems of equations whose matrix is banded
+/// (CCBandedMatrix) by LU decomposition with partial pivoting. Only the
+/// band is factorised, the cost is O(n * KL * (KL + KU)) instead of
+/// O(n^3), and the memory O(n * (2*KL + KU + 1)) instead of O(n^2)
+
+// Check whether the class has been already defined
+#ifndef CCBANDEDLUSOLVER_H
+#define CCBANDEDLUSOLVER_H
+
+// Include the header from inherited class
+#include "ac_direct_linear_solver.h"
+
+// The banded matrices
+#include "../matrices/cc_banded_matrix.h"
+
+namespace scicellxx
+{
+
+ /// A concrete class to solve linear systems of equations with banded
+ /// matrices. The rows interchanged by partial pivoting are within
+ /// the KL rows below the diagonal, thus the U factor has at most KL +
+ /// KU diagonals above the main diagonal (the fill-in), and the L
+ /// factor KL diagonals below it. The factorisation is stored by rows
+ /// with 2*KL + KU + 1 entries per row, the (i, j) entry at
+ /// LU[i * (2*KL + KU + 1) + (j - i + KL)]
+ class CCBandedLUSolver : public virtual ACDirectLinearSolver
+ {
+
+ public:
+
+  /// Empty constructor
+  CCBandedLUSolver();
+
+  /// Constructor where we specify the matrix A (a CCBandedMatrix)
+  CCBandedLUSolver(ACMatrix<Real> *const A_mat_pt);
+
+  /// Empty destructor
+  ~CCBandedLUSolver();
+
+  /// Performs the LU factorisation of the already stored matrix A,
+  /// the factorisation is internally stored such that it can be
+  /// re-used when calling resolve
+  void factorise();
+
+ protected:
+
+  /// Solves with the factorised matrix, x stores the right-hand side
+  /// on input and the solution on output
+  void back_substitution(Real *x);
+
+  // Bring the overloaded versions from the base class
+  using ACDirectLinearSolver::back_substitution;
+
+  /// The number of diagonals below and above the main diagonal of the
+  /// factorised matrix
+  unsigned long KL;
+  unsigned long KU;
+
+  /// The L and U factors, stored by rows
+  std::vector<Real> LU;
+
+  /// The row interchanged with row k at the k-th step
+  std::vector<unsigned long> Pivots;
+
+ private:
+
+  /// Copy constructor (we do not want this class to be
+  /// copiable). Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  CCBandedLUSolver(const CCBandedLUSolver &copy)
+   : ACLinearSolver(), ACDirectLinearSolver()
+   {
+    BrokenCopy::broken_copy("CCBandedLUSolver");
+   }
+
+  /// Assignment operator (we do not want this class to be
+  /// copiable. Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  void operator=(const CCBandedLUSolver &copy)
+   {
+    BrokenCopy::broken_assign("CCBandedLUSolver");
+   }
+
+ };
+
+}
+
+#endif // #ifndef CCBANDEDLUSOLVER_H
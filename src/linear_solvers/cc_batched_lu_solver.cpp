@@ -0,0 +1,306 @@
+/// IN THIS FILE: Implementation of a concrete class to solve batches
+/// of small systems of equations by LU decomposition with partial
+/// pivoting
+
+#include "cc_batched_lu_solver.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ /// Empty constructor
+ // ===================================================================
+ CCBatchedLUSolver::CCBatchedLUSolver()
+  : Resolve_enabled(false) { }
+
+ // ===================================================================
+ /// Empty destructor
+ // ===================================================================
+ CCBatchedLUSolver::~CCBatchedLUSolver() { }
+
+ // ===================================================================
+ /// Solves the systems of equations A_b x_b = b_b of the batch
+ // ===================================================================
+ void CCBatchedLUSolver::solve(const CCMatrixBatch<Real> &A,
+                               const CCVectorBatch<Real> &b,
+                               CCVectorBatch<Real> &x)
+ {
+  factorise(A);
+  resolve(b, x);
+ }
+
+ // ===================================================================
+ /// Performs the LU factorisation of the matrices of the batch, the
+ /// factorisation is internally stored such that it can be re-used
+ /// when calling resolve
+ // ===================================================================
+ void CCBatchedLUSolver::factorise(const CCMatrixBatch<Real> &A)
+ {
+  Resolve_enabled = false;
+
+  if (A.data_pt() == 0 || A.n_rows() != A.n_columns())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The batch of matrices has no memory allocated or its\n"
+                  << "matrices are not square\n"
+                  << "Size of the matrices: " << A.n_rows() << " X "
+                  << A.n_columns() << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // The factorisation overwrites a copy of the batch
+  LU = A;
+  const unsigned long n_batch = LU.n_batch();
+  const unsigned long n = LU.n_rows();
+  Permutation.assign(n * n_batch, 0);
+  Singular.assign(n_batch, 0);
+
+  const unsigned long n_groups = (n_batch + Batch_group_size - 1) / Batch_group_size;
+  ThreadPool::parallel_for(n_groups, [this, n_batch](const unsigned long begin, const unsigned long end)
+                           {
+                            for (unsigned long g = begin; g < end; g++)
+                             {
+                              const unsigned long first = g * Batch_group_size;
+                              factorise_group(first, std::min(Batch_group_size, n_batch - first));
+                             }
+                           }, Batch_group_size * n * n * n);
+
+  // The tasks do not throw, check the singular members now
+  unsigned long n_singular = 0;
+  std::ostringstream singular_members;
+  for (unsigned long b = 0; b < n_batch; b++)
+   {
+    if (Singular[b])
+     {
+      if (n_singular < 10)
+       {
+        singular_members << " " << b;
+       }
+      n_singular++;
+     }
+   }
+  if (n_singular > 0)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrices of " << n_singular << " members of the batch are\n"
+                  << "singular (zero pivot). Singular members:"
+                  << singular_members.str() << (n_singular > 10 ? " ..." : "")
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  Resolve_enabled = true;
+ }
+
+ // ===================================================================
+ /// Re-solve the systems of equations with the already factorised
+ /// batch of matrices
+ // ===================================================================
+ void CCBatchedLUSolver::resolve(const CCVectorBatch<Real> &b,
+                                 CCVectorBatch<Real> &x)
+ {
+  if (!Resolve_enabled)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "Resolve is not enabled.\n"
+                  << "You need to call factorise() before resolve()"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  const unsigned long n_batch = LU.n_batch();
+  const unsigned long n = LU.n_rows();
+  if (b.n_batch() != n_batch || b.n_values() != n)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The right-hand sides do not match the factorised batch\n"
+                  << "Factorised batch: " << n_batch << " matrices of size "
+                  << n << " X " << n << "\n"
+                  << "Right-hand sides: " << b.n_batch() << " vectors of size "
+                  << b.n_values() << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  if (&x != &b)
+   {
+    x = b;
+   }
+
+  Real *x_pt = x.data_pt();
+  const unsigned long n_groups = (n_batch + Batch_group_size - 1) / Batch_group_size;
+  ThreadPool::parallel_for(n_groups, [this, n_batch, x_pt](const unsigned long begin, const unsigned long end)
+                           {
+                            for (unsigned long g = begin; g < end; g++)
+                             {
+                              const unsigned long first = g * Batch_group_size;
+                              back_substitution_group(first, std::min(Batch_group_size, n_batch - first), x_pt);
+                             }
+                           }, Batch_group_size * n * n);
+ }
+
+ // ===================================================================
+ /// Factorises the members of the batch in [first, first + size). The
+ /// pivot search, the division by the pivot and the update of the
+ /// trailing submatrix are selections and arithmetic on the lanes of
+ /// the group, only the interchange of rows depends on the pivot of
+ /// each member
+ // ===================================================================
+ void CCBatchedLUSolver::factorise_group(const unsigned long first,
+                                         const unsigned long size)
+ {
+  const unsigned long n_batch = LU.n_batch();
+  const unsigned long n = LU.n_rows();
+  Real *a = LU.data_pt() + first;
+  unsigned long *permutation = &Permutation[0] + first;
+  unsigned char *singular = &Singular[0] + first;
+
+  Real max_pivot[Batch_group_size];
+  unsigned long pivot_row[Batch_group_size];
+  Real inverse_pivot[Batch_group_size];
+
+  for (unsigned long k = 0; k < n; k++)
+   {
+    // Find the largest entry in column k on or below the diagonal
+    const Real *a_kk = a + (k * n + k) * n_batch;
+    for (unsigned long l = 0; l < size; l++)
+     {
+      max_pivot[l] = std::fabs(a_kk[l]);
+      pivot_row[l] = k;
+     }
+    for (unsigned long i = k + 1; i < n; i++)
+     {
+      const Real *a_ik = a + (i * n + k) * n_batch;
+      for (unsigned long l = 0; l < size; l++)
+       {
+        const Real candidate = std::fabs(a_ik[l]);
+        const bool is_larger = candidate > max_pivot[l];
+        max_pivot[l] = is_larger ? candidate : max_pivot[l];
+        pivot_row[l] = is_larger ? i : pivot_row[l];
+       }
+     }
+
+    // Interchange the rows of each member (the whole row, the
+    // multipliers of the previous columns are also interchanged)
+    for (unsigned long l = 0; l < size; l++)
+     {
+      permutation[k * n_batch + l] = pivot_row[l];
+      if (pivot_row[l] != k)
+       {
+        Real *row_k = a + k * n * n_batch + l;
+        Real *row_p = a + pivot_row[l] * n * n_batch + l;
+        for (unsigned long j = 0; j < n; j++)
+         {
+          std::swap(row_k[j * n_batch], row_p[j * n_batch]);
+         }
+       }
+     }
+
+    // A zero pivot marks the member as singular, its multipliers are
+    // set to zero such that the other members are not affected
+    for (unsigned long l = 0; l < size; l++)
+     {
+      const bool is_zero = max_pivot[l] == Real(0);
+      singular[l] = is_zero ? 1 : singular[l];
+      inverse_pivot[l] = is_zero ? Real(0) : Real(1) / a_kk[l];
+     }
+
+    // Compute the multipliers and update the trailing submatrix
+    const Real *a_k = a + k * n * n_batch;
+    for (unsigned long i = k + 1; i < n; i++)
+     {
+      Real *a_i = a + i * n * n_batch;
+      Real *multiplier = a_i + k * n_batch;
+      for (unsigned long l = 0; l < size; l++)
+       {
+        multiplier[l]*= inverse_pivot[l];
+       }
+      for (unsigned long j = k + 1; j < n; j++)
+       {
+        Real *a_ij = a_i + j * n_batch;
+        const Real *a_kj = a_k + j * n_batch;
+        for (unsigned long l = 0; l < size; l++)
+         {
+          a_ij[l]-= multiplier[l] * a_kj[l];
+         }
+       }
+     }
+   }
+ }
+
+ // ===================================================================
+ /// Solves with the factorised members of the batch in [first, first
+ /// + size), x stores the right-hand sides on input and the solutions
+ /// on output
+ // ===================================================================
+ void CCBatchedLUSolver::back_substitution_group(const unsigned long first,
+                                                 const unsigned long size,
+                                                 Real *x)
+ {
+  const unsigned long n_batch = LU.n_batch();
+  const unsigned long n = LU.n_rows();
+  const Real *a = LU.data_pt() + first;
+  const unsigned long *permutation = &Permutation[0] + first;
+  x+= first;
+
+  // Apply the interchanges of rows
+  for (unsigned long k = 0; k < n; k++)
+   {
+    for (unsigned long l = 0; l < size; l++)
+     {
+      const unsigned long p = permutation[k * n_batch + l];
+      if (p != k)
+       {
+        std::swap(x[k * n_batch + l], x[p * n_batch + l]);
+       }
+     }
+   }
+
+  // Forward substitution with L (unit diagonal)
+  for (unsigned long i = 1; i < n; i++)
+   {
+    Real *x_i = x + i * n_batch;
+    for (unsigned long k = 0; k < i; k++)
+     {
+      const Real *l_ik = a + (i * n + k) * n_batch;
+      const Real *x_k = x + k * n_batch;
+      for (unsigned long l = 0; l < size; l++)
+       {
+        x_i[l]-= l_ik[l] * x_k[l];
+       }
+     }
+   }
+
+  // Backward substitution with U
+  for (unsigned long i = n; i-- > 0; )
+   {
+    Real *x_i = x + i * n_batch;
+    for (unsigned long k = i + 1; k < n; k++)
+     {
+      const Real *u_ik = a + (i * n + k) * n_batch;
+      const Real *x_k = x + k * n_batch;
+      for (unsigned long l = 0; l < size; l++)
+       {
+        x_i[l]-= u_ik[l] * x_k[l];
+       }
+     }
+    const Real *u_ii = a + (i * n + i) * n_batch;
+    for (unsigned long l = 0; l < size; l++)
+     {
+      x_i[l]/= u_ii[l];
+     }
+   }
+ }
+
+}
@@ -0,0 +1,115 @@
+/// IN THIS FILE: The definition of the concrete class
+/// CCBatchedLUSolver to solve many independent small systems of
+/// equations of the same size at once (a batch, CCMatrixBatch) by LU
+/// decomposition with partial pivoting. The entries of the batch are
+/// interleaved, each step of the factorisation and of the
+/// substitutions is applied to all the members of the batch in the
+/// innermost loop, thus the members run in the SIMD lanes instead of
+/// the short rows of each small matrix
+
+// Check whether the class has been already defined
+#ifndef CCBATCHEDLUSOLVER_H
+#define CCBATCHEDLUSOLVER_H
+
+#include "../general/common_includes.h"
+#include "../general/utilities.h"
+
+// The batches of matrices and vectors
+#include "../matrices/cc_matrix_batch.h"
+
+namespace scicellxx
+{
+
+ /// A concrete class to solve batches of linear systems of equations.
+ /// It does not implement the ACLinearSolver interface, which works
+ /// with a single matrix, but it follows it: the batch is factorised
+ /// once and the factorisation is re-used by resolve(). Each member of
+ /// the batch chooses its own pivots, the permutation of the b-th
+ /// member is stored interleaved as the entries, at Permutation[k *
+ /// n_batch + b]. The groups of members (Batch_group_size) are
+ /// factorised in parallel by the pool of threads. An error naming
+ /// the singular members of the batch is thrown if any of them has a
+ /// zero pivot
+ class CCBatchedLUSolver
+ {
+
+ public:
+
+  /// Empty constructor
+  CCBatchedLUSolver();
+
+  /// Empty destructor
+  virtual ~CCBatchedLUSolver();
+
+  /// Solves the systems of equations A_b x_b = b_b of the batch
+  void solve(const CCMatrixBatch<Real> &A, const CCVectorBatch<Real> &b,
+             CCVectorBatch<Real> &x);
+
+  /// Performs the LU factorisation of the matrices of the batch, the
+  /// factorisation is internally stored such that it can be re-used
+  /// when calling resolve
+  void factorise(const CCMatrixBatch<Real> &A);
+
+  /// Re-solve the systems of equations with the already factorised
+  /// batch of matrices. The right-hand sides and the solutions may be
+  /// the same batch of vectors
+  void resolve(const CCVectorBatch<Real> &b, CCVectorBatch<Real> &x);
+
+  /// The number of members of the factorised batch
+  inline unsigned long n_batch() const {return LU.n_batch();}
+
+  /// The number of rows of the factorised matrices
+  inline unsigned long n_rows() const {return LU.n_rows();}
+
+  /// Get access to the L and U factors of the batch, interleaved as
+  /// the input matrices (the unit diagonal of L is not stored)
+  inline const CCMatrixBatch<Real> &lu() const {return LU;}
+
+ protected:
+
+  /// Factorises the members of the batch in [first, first + size)
+  void factorise_group(const unsigned long first, const unsigned long size);
+
+  /// Solves with the factorised members of the batch in [first, first
+  /// + size), x stores the right-hand sides on input and the
+  /// solutions on output
+  void back_substitution_group(const unsigned long first, const unsigned long size,
+                               Real *x);
+
+  /// The L and U factors of the batch
+  CCMatrixBatch<Real> LU;
+
+  /// The rows interchanged at each step of the factorisation,
+  /// interleaved
+  std::vector<unsigned long> Permutation;
+
+  /// Flags for the members of the batch with a zero pivot
+  std::vector<unsigned char> Singular;
+
+  /// Flag to indicate whether resolve is enabled (only after calling
+  /// factorise)
+  bool Resolve_enabled;
+
+ private:
+
+  /// Copy constructor (we do not want this class to be
+  /// copiable). Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  CCBatchedLUSolver(const CCBatchedLUSolver &copy)
+   {
+    BrokenCopy::broken_copy("CCBatchedLUSolver");
+   }
+
+  /// Assignment operator (we do not want this class to be
+  /// copiable. Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  void operator=(const CCBatchedLUSolver &copy)
+   {
+    BrokenCopy::broken_assign("CCBatchedLUSolver");
+   }
+
+ };
+
+}
+
+#endif // #ifndef CCBATCHEDLUSOLVER_H
@@ -0,0 +1,145 @@
+/// IN THIS FILE: Implementation of a concrete class to solve systems
+/// of equations with general matrices by the biconjugate gradient
+/// stabilised method
+
+#include "cc_bicgstab_solver.h"
+
+// The parallel loops to update the vectors
+#include "../general/thread_pool.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ /// Empty constructor
+ // ===================================================================
+ CCBiCGStabSolver::CCBiCGStabSolver()
+  : ACLinearSolver(), ACIterativeLinearSolver() { }
+
+ // ===================================================================
+ /// Constructor where we specify the matrix A
+ // ===================================================================
+ CCBiCGStabSolver::CCBiCGStabSolver(ACMatrix<Real> *const A_mat_pt)
+  : ACLinearSolver(A_mat_pt), ACIterativeLinearSolver(A_mat_pt) { }
+
+ // ===================================================================
+ /// Empty destructor
+ // ===================================================================
+ CCBiCGStabSolver::~CCBiCGStabSolver() { }
+
+ // ===================================================================
+ /// Solves A x = b by preconditioned BiCGStab, the shadow residual is
+ /// the initial residual. The norm of the residual may grow by orders
+ /// of magnitude before it decreases (non-normal matrices), then the
+ /// updated residual drifts from the true one. A small updated
+ /// residual is thus confirmed with the true one, the iterations
+ /// restart from it otherwise
+ // ===================================================================
+ void CCBiCGStabSolver::iterate(const Real *b, Real *x)
+ {
+  R.resize(N);
+  R_shadow.resize(N);
+  P.resize(N);
+  P_hat.resize(N);
+  V.resize(N);
+  S.resize(N);
+  S_hat.resize(N);
+  T.resize(N);
+  Real *r = R.data();
+  Real *p = P.data();
+  Real *p_hat = P_hat.data();
+  Real *v = V.data();
+  Real *s = S.data();
+  Real *s_hat = S_hat.data();
+  Real *t = T.data();
+
+  compute_residual(b, x, r);
+  if (start_iterations(norm_2(r)))
+   {
+    return;
+   }
+
+  Real rho = 1.0;
+  Real alpha = 1.0;
+  Real omega = 1.0;
+  bool restart = true;
+  while (iterations_left())
+   {
+    // (Re)start from the current residual
+    if (restart)
+     {
+      std::copy(r, r + N, R_shadow.data());
+      std::fill(p, p + N, Real(0.0));
+      std::fill(v, v + N, Real(0.0));
+      rho = 1.0;
+      alpha = 1.0;
+      omega = 1.0;
+      restart = false;
+     }
+
+    // The new search direction, p = r + beta (p - omega v)
+    const Real rho_new = dot(R_shadow.data(), r);
+    if (rho_new == 0.0)
+     {
+      breakdown("BiCGStab", "the product of the residual and the shadow residual");
+     }
+    const Real beta = (rho_new / rho) * (alpha / omega);
+    rho = rho_new;
+    ThreadPool::parallel_for(N, [=](const unsigned long begin, const unsigned long end)
+                             {
+                              for (unsigned long i = begin; i < end; i++)
+                               {
+                                p[i] = r[i] + beta * (p[i] - omega * v[i]);
+                               }
+                             });
+
+    // The BiCG step, s = r - alpha A M^{-1} p
+    apply_preconditioner(p, p_hat);
+    matrix_times_vector(p_hat, v);
+    const Real shadow_v = dot(R_shadow.data(), v);
+    if (shadow_v == 0.0)
+     {
+      breakdown("BiCGStab", "the product of the shadow residual and A M^{-1} p");
+     }
+    alpha = rho / shadow_v;
+    std::copy(r, r + N, s);
+    axpy(-alpha, v, s);
+    axpy(alpha, p_hat, x);
+    if (residual_is_small(norm_2(s)))
+     {
+      compute_residual(b, x, r);
+      if (residual_has_converged(norm_2(r)))
+       {
+        return;
+       }
+      restart = true;
+      continue;
+     }
+
+    // The stabilisation step, minimises the residual along A M^{-1} s
+    apply_preconditioner(s, s_hat);
+    matrix_times_vector(s_hat, t);
+    const Real t_t = dot(t, t);
+    omega = t_t == 0.0 ? Real(0.0) : dot(t, s) / t_t;
+    axpy(omega, s_hat, x);
+    std::copy(s, s + N, r);
+    axpy(-omega, t, r);
+    Real norm_r = norm_2(r);
+    if (residual_is_small(norm_r))
+     {
+      compute_residual(b, x, r);
+      norm_r = norm_2(r);
+      restart = true;
+     }
+    if (residual_has_converged(norm_r))
+     {
+      return;
+     }
+    if (omega == 0.0 && !restart)
+     {
+      breakdown("BiCGStab", "the stabilisation step omega");
+     }
+   }
+ }
+
+}
@@ -0,0 +1,78 @@
+/// IN THIS FILE: The definition of the concrete class CCBiCGStabSolver
+/// to solve systems of equations with general (non-symmetric) matrices
+/// by the biconjugate gradient stabilised method
+
+// Check whether the class has been already defined
+#ifndef CCBICGSTABSOLVER_H
+#define CCBICGSTABSOLVER_H
+
+// Include the header from inherited class
+#include "ac_iterative_linear_solver.h"
+
+namespace scicellxx
+{
+
+ /// BiCGStab of van der Vorst with right preconditioning. Each
+ /// iteration costs two mat-vecs, two applications of the
+ /// preconditioner and four dot products, the memory is fixed (eight
+ /// vectors) as opposed to that of GMRES, but the residual does not
+ /// decrease monotonically. An error is thrown at a breakdown (the
+ /// shadow residual orthogonal to the residual, or a zero
+ /// stabilisation step)
+ class CCBiCGStabSolver : public virtual ACIterativeLinearSolver
+ {
+
+ public:
+
+  /// Empty constructor
+  CCBiCGStabSolver();
+
+  /// Constructor where we specify the matrix A
+  CCBiCGStabSolver(ACMatrix<Real> *const A_mat_pt);
+
+  /// Empty destructor
+  ~CCBiCGStabSolver();
+
+ protected:
+
+  /// Solves A x = b by preconditioned BiCGStab
+  void iterate(const Real *b, Real *x);
+
+  /// The residual, the shadow residual, the search direction and its
+  /// preconditioned version, the product of the matrix and the
+  /// preconditioned search direction, the intermediate residual (s)
+  /// and its preconditioned version, and the product of the matrix
+  /// and the preconditioned s
+  std::vector<Real> R;
+  std::vector<Real> R_shadow;
+  std::vector<Real> P;
+  std::vector<Real> P_hat;
+  std::vector<Real> V;
+  std::vector<Real> S;
+  std::vector<Real> S_hat;
+  std::vector<Real> T;
+
+ private:
+
+  /// Copy constructor (we do not want this class to be
+  /// copiable). Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  CCBiCGStabSolver(const CCBiCGStabSolver &copy)
+   : ACLinearSolver(), ACIterativeLinearSolver()
+   {
+    BrokenCopy::broken_copy("CCBiCGStabSolver");
+   }
+
+  /// Assignment operator (we do not want this class to be
+  /// copiable. Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  void operator=(const CCBiCGStabSolver &copy)
+   {
+    BrokenCopy::broken_assign("CCBiCGStabSolver");
+   }
+
+ };
+
+}
+
+#endif // #ifndef CCBICGSTABSOLVER_H
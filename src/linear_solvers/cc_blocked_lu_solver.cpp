@@ -0,0 +1,431 @@
+/// IN THIS FILE: Implementation of a concrete class to solve systems
+/// of equations by blocked LU decomposition with partial pivoting
+
+#include "cc_blocked_lu_solver.h"
+
+// The products of matrices for the trailing updates
+#include "../matrices/gemm_kernels.h"
+// The dot products of the substitutions
+#include "../matrices/parallel_kernels.h"
+
+namespace scicellxx
+{
+
+ // The definition of the static constants (they are used by reference)
+ const unsigned long CCBlockedLUSolver::Panel_base_width;
+ const unsigned long CCBlockedLUSolver::Substitution_block_size;
+
+ // ===================================================================
+ /// Empty constructor
+ // ===================================================================
+ CCBlockedLUSolver::CCBlockedLUSolver()
+  : ACLinearSolver(), ACDirectLinearSolver(), LU_pt(0), N(0),
+    Block_size(256), Factorise_in_place(false),
+    Pivot_tolerance(0.0), Minimum_pivot(0.0) { }
+
+ // ===================================================================
+ /// Constructor where we specify the matrix A
+ // ===================================================================
+ CCBlockedLUSolver::CCBlockedLUSolver(ACMatrix<Real> *const A_mat_pt)
+  : ACLinearSolver(A_mat_pt), ACDirectLinearSolver(A_mat_pt), LU_pt(0), N(0),
+    Block_size(256), Factorise_in_place(false),
+    Pivot_tolerance(0.0), Minimum_pivot(0.0) { }
+
+ // ===================================================================
+ /// Empty destructor
+ // ===================================================================
+ CCBlockedLUSolver::~CCBlockedLUSolver() { }
+
+ // ===================================================================
+ /// Set the number of columns of each panel
+ // ===================================================================
+ void CCBlockedLUSolver::set_block_size(const unsigned long block_size)
+ {
+  if (block_size == 0)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The block size must be at least one" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  Block_size = block_size;
+ }
+
+ // ===================================================================
+ /// Set the tolerance of the pivots relative to N times the largest
+ /// absolute entry of the matrix
+ // ===================================================================
+ void CCBlockedLUSolver::set_pivot_tolerance(const Real pivot_tolerance)
+ {
+  if (!(pivot_tolerance >= 0.0))
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The pivot tolerance must not be negative\n"
+                  << "Pivot tolerance: " << pivot_tolerance << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  Pivot_tolerance = pivot_tolerance;
+ }
+
+ // ===================================================================
+ /// Performs the LU factorisation of the already stored matrix A, the
+ /// factorisation is internally stored such that it can be re-used
+ /// when calling resolve
+ // ===================================================================
+ void CCBlockedLUSolver::factorise()
+ {
+  check_square_matrix_has_been_set();
+  Resolve_enabled = false;
+
+  N = this->A_pt->n_rows();
+  CCMatrix<Real> *dense_pt = dynamic_cast<CCMatrix<Real>*>(this->A_pt);
+  const bool is_dense_by_rows = dense_pt != 0 && !dense_pt->is_column_major() &&
+   dense_pt->matrix_pt() != 0;
+
+  if (Factorise_in_place)
+   {
+    if (!is_dense_by_rows)
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The factorisation in place works with dense matrices\n"
+                    << "stored by rows (CCMatrix), disable it to factorise a\n"
+                    << "copy of any other matrix" << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+    LU_pt = dense_pt->matrix_pt();
+   }
+  else
+   {
+    LU_copy.resize(N * N);
+    LU_pt = LU_copy.empty() ? 0 : &LU_copy[0];
+    if (is_dense_by_rows)
+     {
+      std::copy(dense_pt->matrix_pt(), dense_pt->matrix_pt() + N * N, LU_pt);
+     }
+    else
+     {
+      for (unsigned long i = 0; i < N; i++)
+       {
+        for (unsigned long j = 0; j < N; j++)
+         {
+          LU_pt[i * N + j] = this->A_pt->value(i, j);
+         }
+       }
+     }
+   }
+  Pivots.resize(N);
+
+  // The pivots left by the rounding errors of a singular matrix are
+  // of the order of eps times its entries
+  Minimum_pivot = 0.0;
+  if (Pivot_tolerance > 0.0)
+   {
+    Minimum_pivot = Pivot_tolerance * Real(N) *
+     ParallelKernels::max_absolute_value(N * N, LU_pt);
+   }
+
+  // Right-looking blocked factorisation
+  for (unsigned long k0 = 0; k0 < N; k0+=Block_size)
+   {
+    const unsigned long kb = std::min(Block_size, N - k0);
+    const unsigned long c0 = k0 + kb;
+
+    // Factorise the panel (the columns [k0, k0 + kb))
+    factorise_panel(k0, kb);
+
+    // The rows of U to the right of the panel, then update the
+    // trailing submatrix
+    solve_with_l_block(k0, kb, c0, N - c0);
+    update_trailing(c0, c0, k0, N - c0, N - c0, kb);
+   }
+
+  // Set the flag to indicate that resolve is enabled since we have
+  // computed the factorisation
+  Resolve_enabled = true;
+ }
+
+ // ===================================================================
+ /// Factorises the columns [j0, j0 + width) of the rows [j0, N),
+ /// recursively splitting the columns in halves. The left half is
+ /// factorised, the right half is updated with it (triangular solve
+ /// and GEMM) and then factorised
+ // ===================================================================
+ void CCBlockedLUSolver::factorise_panel(const unsigned long j0,
+                                         const unsigned long width)
+ {
+  if (width <= Panel_base_width)
+   {
+    factorise_panel_by_columns(j0, width);
+    return;
+   }
+
+  const unsigned long w1 = width / 2;
+  const unsigned long w2 = width - w1;
+  factorise_panel(j0, w1);
+  solve_with_l_block(j0, w1, j0 + w1, w2);
+  update_trailing(j0 + w1, j0 + w1, j0, N - j0 - w1, w2, w1);
+  factorise_panel(j0 + w1, w2);
+ }
+
+ // ===================================================================
+ /// Factorises the columns [j0, j0 + width) column by column (rank
+ /// one updates restricted to the columns of the panel)
+ // ===================================================================
+ void CCBlockedLUSolver::factorise_panel_by_columns(const unsigned long j0,
+                                                    const unsigned long width)
+ {
+  Real *a = LU_pt;
+  const unsigned long n = N;
+  const unsigned long j_end = j0 + width;
+  for (unsigned long j = j0; j < j_end; j++)
+   {
+    // Find the largest entry in column j on or below the diagonal
+    unsigned long p = j;
+    Real max_pivot = std::fabs(a[j * n + j]);
+    for (unsigned long i = j + 1; i < n; i++)
+     {
+      const Real candidate = std::fabs(a[i * n + j]);
+      if (candidate > max_pivot)
+       {
+        max_pivot = candidate;
+        p = i;
+       }
+     }
+    Pivots[j] = p;
+
+    if (max_pivot <= Minimum_pivot)
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The matrix is singular, the largest pivot in column "
+                    << j << " is\n"
+                    << "at most the minimum pivot\n"
+                    << "Largest pivot: " << max_pivot << "\n"
+                    << "Minimum pivot: " << Minimum_pivot << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+
+    // Interchange the whole rows, the multipliers of the previous
+    // columns and the entries not yet factorised are interchanged too
+    if (p != j)
+     {
+      std::swap_ranges(a + j * n, a + (j + 1) * n, a + p * n);
+     }
+
+    // Compute the multipliers and update the rest of the panel
+    const Real inverse_pivot = Real(1) / a[j * n + j];
+    const Real *row_j = a + j * n;
+    ThreadPool::parallel_for(n - j - 1, [=](const unsigned long begin, const unsigned long end)
+                             {
+                              for (unsigned long i = j + 1 + begin; i < j + 1 + end; i++)
+                               {
+                                Real *row_i = a + i * n;
+                                const Real multiplier = row_i[j] * inverse_pivot;
+                                row_i[j] = multiplier;
+                                for (unsigned long c = j + 1; c < j_end; c++)
+                                 {
+                                  row_i[c]-= multiplier * row_j[c];
+                                 }
+                               }
+                             }, j_end - j);
+   }
+ }
+
+ // ===================================================================
+ /// Computes the rows [j0, j0 + kb) of U in the columns [c0, c0 + nc)
+ /// by solving with the unit lower triangular block of L at (j0,
+ /// j0). Each row is updated with the rows above it, the columns are
+ /// split among the threads
+ // ===================================================================
+ void CCBlockedLUSolver::solve_with_l_block(const unsigned long j0,
+                                            const unsigned long kb,
+                                            const unsigned long c0,
+                                            const unsigned long nc)
+ {
+  Real *a = LU_pt;
+  const unsigned long n = N;
+  ThreadPool::parallel_for(nc, [=](const unsigned long begin, const unsigned long end)
+                           {
+                            for (unsigned long i = j0 + 1; i < j0 + kb; i++)
+                             {
+                              Real *row_i = a + i * n + c0;
+                              for (unsigned long p = j0; p < i; p++)
+                               {
+                                const Real l_ip = a[i * n + p];
+                                const Real *row_p = a + p * n + c0;
+                                for (unsigned long c = begin; c < end; c++)
+                                 {
+                                  row_i[c]-= l_ip * row_p[c];
+                                 }
+                               }
+                             }
+                           }, kb * kb / 2);
+ }
+
+ // ===================================================================
+ /// Updates the trailing submatrix of size m X n at (i0, c0), A(i0:,
+ /// c0:) -= L(i0:, j0:j0+k) * U(j0:j0+k, c0:). The rows are split
+ /// among the threads, each of them calls GEMM on its slab
+ // ===================================================================
+ void CCBlockedLUSolver::update_trailing(const unsigned long i0,
+                                         const unsigned long c0,
+                                         const unsigned long j0,
+                                         const unsigned long m,
+                                         const unsigned long n,
+                                         const unsigned long k)
+ {
+  if (m == 0 || n == 0 || k == 0)
+   {
+    return;
+   }
+  Real *a = LU_pt;
+  const unsigned long lda = N;
+  ThreadPool::parallel_for(m, [=](const unsigned long begin, const unsigned long end)
+                           {
+                            GEMMKernels::gemm_update(end - begin, n, k, Real(-1),
+                                                     a + (i0 + begin) * lda + j0, lda,
+                                                     a + j0 * lda + c0, lda,
+                                                     a + (i0 + begin) * lda + c0, lda);
+                           }, n * k);
+ }
+
+ // ===================================================================
+ /// Solves with the factorised matrix, x stores the right-hand side on
+ /// input and the solution on output
+ // ===================================================================
+ void CCBlockedLUSolver::back_substitution(Real *x)
+ {
+  const Real *a = LU_pt;
+
+  // Apply the interchanges of rows
+  for (unsigned long j = 0; j < N; j++)
+   {
+    if (Pivots[j] != j)
+     {
+      std::swap(x[j], x[Pivots[j]]);
+     }
+   }
+
+  // Forward substitution with L (unit diagonal), a dot product with
+  // each row
+  for (unsigned long i = 1; i < N; i++)
+   {
+    x[i]-= ParallelKernels::serial_dot<Real, Real>(i, a + i * N, x);
+   }
+
+  // Backward substitution with U
+  for (unsigned long i = N; i-- > 0; )
+   {
+    const Real *row_i = a + i * N;
+    x[i] = (x[i] - ParallelKernels::serial_dot<Real, Real>(N - i - 1, row_i + i + 1, x + i + 1)) /
+     row_i[i];
+   }
+ }
+
+ // ===================================================================
+ /// Solves with the factorised matrix for n_rhs right-hand sides
+ /// stored by rows in X. The rows are interchanged, then the forward
+ /// (L) and backward (U) substitutions work by blocks of rows: each
+ /// block is updated with the rows already solved by GEMM and then
+ /// solved with the diagonal block of the factor (axpys of rows). The
+ /// right-hand sides are split among the threads
+ // ===================================================================
+ void CCBlockedLUSolver::block_back_substitution(Real *X,
+                                                 const unsigned long n_rhs,
+                                                 const unsigned long ldx)
+ {
+  if (N == 0 || n_rhs == 0)
+   {
+    return;
+   }
+  const Real *a = LU_pt;
+  const unsigned long n = N;
+  const unsigned long *pivots = &Pivots[0];
+  const unsigned long nb = Substitution_block_size;
+  ThreadPool::parallel_for(n_rhs, [=](const unsigned long begin, const unsigned long end)
+                           {
+                            const unsigned long nc = end - begin;
+                            Real *x = X + begin;
+
+                            // Apply the interchanges of rows
+                            for (unsigned long j = 0; j < n; j++)
+                             {
+                              if (pivots[j] != j)
+                               {
+                                std::swap_ranges(x + j * ldx, x + j * ldx + nc, x + pivots[j] * ldx);
+                               }
+                             }
+
+                            // Forward substitution with L (unit diagonal)
+                            for (unsigned long i0 = 0; i0 < n; i0+=nb)
+                             {
+                              const unsigned long ib = std::min(nb, n - i0);
+                              if (i0 > 0)
+                               {
+                                GEMMKernels::gemm_update(ib, nc, i0, Real(-1),
+                                                         a + i0 * n, n,
+                                                         x, ldx,
+                                                         x + i0 * ldx, ldx);
+                               }
+                              for (unsigned long i = i0 + 1; i < i0 + ib; i++)
+                               {
+                                Real *row_i = x + i * ldx;
+                                for (unsigned long p = i0; p < i; p++)
+                                 {
+                                  const Real l_ip = a[i * n + p];
+                                  const Real *row_p = x + p * ldx;
+                                  for (unsigned long c = 0; c < nc; c++)
+                                   {
+                                    row_i[c]-= l_ip * row_p[c];
+                                   }
+                                 }
+                               }
+                             }
+
+                            // Backward substitution with U, from the last
+                            // block of rows
+                            for (unsigned long i1 = n; i1 > 0; )
+                             {
+                              const unsigned long ib = (i1 - 1) % nb + 1;
+                              const unsigned long i0 = i1 - ib;
+                              if (i1 < n)
+                               {
+                                GEMMKernels::gemm_update(ib, nc, n - i1, Real(-1),
+                                                         a + i0 * n + i1, n,
+                                                         x + i1 * ldx, ldx,
+                                                         x + i0 * ldx, ldx);
+                               }
+                              for (unsigned long i = i1; i-- > i0; )
+                               {
+                                Real *row_i = x + i * ldx;
+                                for (unsigned long p = i + 1; p < i1; p++)
+                                 {
+                                  const Real u_ip = a[i * n + p];
+                                  const Real *row_p = x + p * ldx;
+                                  for (unsigned long c = 0; c < nc; c++)
+                                   {
+                                    row_i[c]-= u_ip * row_p[c];
+                                   }
+                                 }
+                                const Real inverse_diagonal = Real(1) / a[i * n + i];
+                                for (unsigned long c = 0; c < nc; c++)
+                                 {
+                                  row_i[c]*= inverse_diagonal;
+                                 }
+                               }
+                              i1 = i0;
+                             }
+                           }, n * n);
+ }
+
+}
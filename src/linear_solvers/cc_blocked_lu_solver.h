@@ -0,0 +1,179 @@
+/// IN THIS FILE: The definition of the concrete class
+/// CCBlockedLUSolver to solve systems of equations by LU decomposition
+/// with partial pivoting. The factorisation is right-looking and
+/// blocked: each block of columns (the panel) is factorised, then the
+/// rows of U to its right are computed by a triangular solve and the
+/// trailing submatrix is updated by a matrix-matrix product (the GEMM
+/// kernels, in parallel by slabs of rows). Most of the O(n^3)
+/// operations are in the trailing updates, thus the factorisation
+/// runs close to the speed of GEMM instead of the speed of memory. The
+/// substitutions of many right-hand sides are also blocked (as TRSM)
+
+// Check whether the class has been already defined
+#ifndef CCBLOCKEDLUSOLVER_H
+#define CCBLOCKEDLUSOLVER_H
+
+// Include the header from inherited class
+#include "ac_direct_linear_solver.h"
+
+// The dense matrices, factorised in place
+#include "../matrices/cc_matrix.h"
+
+namespace scicellxx
+{
+
+ /// A concrete class to solve linear systems of equations with dense
+ /// matrices. The L and U factors are stored by rows as the input
+ /// matrix (the unit diagonal of L is not stored), Pivots[j] is the
+ /// row interchanged with row j at step j. The panels are factorised
+ /// recursively, halving the columns down to Panel_base_width columns
+ /// such that the panels are also updated by GEMM.
+ ///
+ /// By default the matrix is copied into the solver (the copy is kept
+ /// between factorisations, no memory is allocated if the size does
+ /// not change). With enable_factorise_in_place() a CCMatrix stored by
+ /// rows is overwritten by its factors, no copy is made, the matrix
+ /// must not be modified while the factorisation is used by resolve()
+ ///
+ /// The matrix is rejected as singular when a pivot is at most
+ /// Pivot_tolerance * N times its largest absolute entry. By default
+ /// Pivot_tolerance is zero and only zero pivots are rejected (as
+ /// getrf in LAPACK), badly scaled matrices are factorised. Set it to
+ /// about the machine epsilon to reject also the pivots left by the
+ /// rounding errors of a singular matrix
+ class CCBlockedLUSolver : public virtual ACDirectLinearSolver
+ {
+
+ public:
+
+  /// Empty constructor
+  CCBlockedLUSolver();
+
+  /// Constructor where we specify the matrix A
+  CCBlockedLUSolver(ACMatrix<Real> *const A_mat_pt);
+
+  /// Empty destructor
+  ~CCBlockedLUSolver();
+
+  /// Performs the LU factorisation of the already stored matrix A,
+  /// the factorisation is internally stored such that it can be
+  /// re-used when calling resolve
+  void factorise();
+
+  // Bring the version that sets the matrix from the base class
+  using ACDirectLinearSolver::factorise;
+
+  /// Overwrite the matrix (a CCMatrix stored by rows) with its factors
+  inline void enable_factorise_in_place() {Factorise_in_place = true;}
+
+  /// Factorise a copy of the matrix (the default)
+  inline void disable_factorise_in_place() {Factorise_in_place = false;}
+
+  /// Is the matrix overwritten by its factors
+  inline bool is_factorise_in_place_enabled() const {return Factorise_in_place;}
+
+  /// Set the number of columns of each panel
+  void set_block_size(const unsigned long block_size);
+
+  /// The number of columns of each panel
+  inline unsigned long block_size() const {return Block_size;}
+
+  /// Set the tolerance of the pivots relative to N times the largest
+  /// absolute entry of the matrix (zero rejects only zero pivots)
+  void set_pivot_tolerance(const Real pivot_tolerance);
+
+  /// The tolerance of the pivots
+  inline Real pivot_tolerance() const {return Pivot_tolerance;}
+
+  /// Panels with at most this number of columns are factorised column
+  /// by column
+  static const unsigned long Panel_base_width = 16;
+
+  /// The number of rows of the blocks of the substitutions of many
+  /// right-hand sides
+  static const unsigned long Substitution_block_size = 64;
+
+ protected:
+
+  /// Solves with the factorised matrix, x stores the right-hand side
+  /// on input and the solution on output
+  void back_substitution(Real *x);
+
+  // Bring the overloaded versions from the base class
+  using ACDirectLinearSolver::back_substitution;
+
+  /// Solves with the factorised matrix for n_rhs right-hand sides
+  /// stored by rows in X. Each block of rows is updated with the rows
+  /// already solved by GEMM and then solved with the diagonal block of
+  /// L (or U), the right-hand sides are split among the threads
+  void block_back_substitution(Real *X, const unsigned long n_rhs,
+                               const unsigned long ldx);
+
+  /// Factorises the columns [j0, j0 + width) of the rows [j0, N), the
+  /// interchanges of rows are applied to the whole rows
+  void factorise_panel(const unsigned long j0, const unsigned long width);
+
+  /// Factorises the columns [j0, j0 + width) column by column
+  void factorise_panel_by_columns(const unsigned long j0, const unsigned long width);
+
+  /// Computes the rows [j0, j0 + kb) of U in the columns [c0, c0 + nc)
+  /// by solving with the unit lower triangular block of L at (j0, j0)
+  void solve_with_l_block(const unsigned long j0, const unsigned long kb,
+                          const unsigned long c0, const unsigned long nc);
+
+  /// Updates the trailing submatrix of size m X n at (i0, c0), A(i0:,
+  /// c0:) -= L(i0:, j0:j0+k) * U(j0:j0+k, c0:)
+  void update_trailing(const unsigned long i0, const unsigned long c0,
+                       const unsigned long j0, const unsigned long m,
+                       const unsigned long n, const unsigned long k);
+
+  /// The copy of the matrix when it is not factorised in place
+  std::vector<Real> LU_copy;
+
+  /// The L and U factors (the copy or the entries of the matrix)
+  Real *LU_pt;
+
+  /// The rows interchanged at each step of the factorisation
+  std::vector<unsigned long> Pivots;
+
+  /// The number of rows of the factorised matrix
+  unsigned long N;
+
+  /// The number of columns of each panel
+  unsigned long Block_size;
+
+  /// Is the matrix overwritten by its factors
+  bool Factorise_in_place;
+
+  /// The tolerance of the pivots relative to N times the largest
+  /// absolute entry of the matrix
+  Real Pivot_tolerance;
+
+  /// The pivots with absolute value at most this one are rejected (set
+  /// by factorise())
+  Real Minimum_pivot;
+
+ private:
+
+  /// Copy constructor (we do not want this class to be
+  /// copiable). Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  CCBlockedLUSolver(const CCBlockedLUSolver &copy)
+   : ACLinearSolver(), ACDirectLinearSolver()
+   {
+    BrokenCopy::broken_copy("CCBlockedLUSolver");
+   }
+
+  /// Assignment operator (we do not want this class to be
+  /// copiable. Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  void operator=(const CCBlockedLUSolver &copy)
+   {
+    BrokenCopy::broken_assign("CCBlockedLUSolver");
+   }
+
+ };
+
+}
+
+#endif // #ifndef CCBLOCKEDLUSOLVER_H
@@ -0,0 +1,102 @@
+/// IN THIS FILE: Implementation of a concrete class to solve systems
+/// of equations with symmetric positive definite matrices by the
+/// preconditioned conjugate gradient method
+
+#include "cc_cg_solver.h"
+
+// The parallel loop to update the search direction
+#include "../general/thread_pool.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ /// Empty constructor
+ // ===================================================================
+ CCCGSolver::CCCGSolver()
+  : ACLinearSolver(), ACIterativeLinearSolver() { }
+
+ // ===================================================================
+ /// Constructor where we specify the matrix A
+ // ===================================================================
+ CCCGSolver::CCCGSolver(ACMatrix<Real> *const A_mat_pt)
+  : ACLinearSolver(A_mat_pt), ACIterativeLinearSolver(A_mat_pt) { }
+
+ // ===================================================================
+ /// Empty destructor
+ // ===================================================================
+ CCCGSolver::~CCCGSolver() { }
+
+ // ===================================================================
+ /// Solves A x = b by preconditioned conjugate gradients. A small
+ /// updated residual is confirmed with the true one (they drift apart
+ /// by roundings), the iterations restart from it otherwise
+ // ===================================================================
+ void CCCGSolver::iterate(const Real *b, Real *x)
+ {
+  R.resize(N);
+  Z.resize(N);
+  P.resize(N);
+  Q.resize(N);
+  Real *r = R.data();
+  Real *z = Z.data();
+  Real *p = P.data();
+  Real *q = Q.data();
+
+  // r = b - A x, p = z = M^{-1} r
+  compute_residual(b, x, r);
+  if (start_iterations(norm_2(r)))
+   {
+    return;
+   }
+  apply_preconditioner(r, z);
+  std::copy(z, z + N, p);
+  Real rho = dot(r, z);
+
+  while (iterations_left())
+   {
+    // The step along the search direction
+    matrix_times_vector(p, q);
+    const Real curvature = dot(p, q);
+    if (!(curvature > 0.0))
+     {
+      breakdown("CG (the matrix or the preconditioner is not positive definite)",
+                "p^T A p");
+     }
+    const Real alpha = rho / curvature;
+    axpy(alpha, p, x);
+    axpy(-alpha, q, r);
+    Real norm_r = norm_2(r);
+    bool restart = false;
+    if (residual_is_small(norm_r))
+     {
+      compute_residual(b, x, r);
+      norm_r = norm_2(r);
+      restart = true;
+     }
+    if (residual_has_converged(norm_r))
+     {
+      return;
+     }
+
+    // The new search direction, A-conjugate to the previous ones (the
+    // preconditioned residual after a restart)
+    apply_preconditioner(r, z);
+    const Real rho_new = dot(r, z);
+    if (rho_new == 0.0)
+     {
+      breakdown("CG", "r^T M^{-1} r");
+     }
+    const Real beta = restart ? Real(0.0) : rho_new / rho;
+    rho = rho_new;
+    ThreadPool::parallel_for(N, [=](const unsigned long begin, const unsigned long end)
+                             {
+                              for (unsigned long i = begin; i < end; i++)
+                               {
+                                p[i] = z[i] + beta * p[i];
+                               }
+                             });
+   }
+ }
+
+}
@@ -0,0 +1,70 @@
+/// IN THIS FILE: The definition of the concrete class CCCGSolver to
+/// solve systems of equations whose matrix is symmetric positive
+/// definite by the (preconditioned) conjugate gradient method
+
+// Check whether the class has been already defined
+#ifndef CCCGSOLVER_H
+#define CCCGSOLVER_H
+
+// Include the header from inherited class
+#include "ac_iterative_linear_solver.h"
+
+namespace scicellxx
+{
+
+ /// The preconditioned conjugate gradient method. Each iteration
+ /// costs one mat-vec, one application of the preconditioner, two dot
+ /// products and three axpys, and it keeps four vectors. The matrix
+ /// and the preconditioner must be symmetric positive definite (Jacobi,
+ /// SSOR or ILU(0) of a symmetric M-matrix), an error is thrown if a
+ /// direction of non-positive curvature is found
+ class CCCGSolver : public virtual ACIterativeLinearSolver
+ {
+
+ public:
+
+  /// Empty constructor
+  CCCGSolver();
+
+  /// Constructor where we specify the matrix A
+  CCCGSolver(ACMatrix<Real> *const A_mat_pt);
+
+  /// Empty destructor
+  ~CCCGSolver();
+
+ protected:
+
+  /// Solves A x = b by preconditioned conjugate gradients
+  void iterate(const Real *b, Real *x);
+
+  /// The residual, the preconditioned residual, the search direction
+  /// and the product of the matrix and the search direction
+  std::vector<Real> R;
+  std::vector<Real> Z;
+  std::vector<Real> P;
+  std::vector<Real> Q;
+
+ private:
+
+  /// Copy constructor (we do not want this class to be
+  /// copiable). Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  CCCGSolver(const CCCGSolver &copy)
+   : ACLinearSolver(), ACIterativeLinearSolver()
+   {
+    BrokenCopy::broken_copy("CCCGSolver");
+   }
+
+  /// Assignment operator (we do not want this class to be
+  /// copiable. Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  void operator=(const CCCGSolver &copy)
+   {
+    BrokenCopy::broken_assign("CCCGSolver");
+   }
+
+ };
+
+}
+
+#endif // #ifndef CCCGSOLVER_H
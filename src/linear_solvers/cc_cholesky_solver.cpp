@@ -0,0 +1,376 @@
+/// IN THIS FILE: Implementation of a concrete class to solve systems
+/// of equations with symmetric positive definite matrices by the
+/// Cholesky factorisation
+
+#include "cc_cholesky_solver.h"
+
+// The products of matrices for the updates of the panels
+#include "../matrices/gemm_kernels.h"
+// The dot products of the substitutions
+#include "../matrices/parallel_kernels.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ /// Empty constructor
+ // ===================================================================
+ CCCholeskySolver::CCCholeskySolver()
+  : ACLinearSolver(), ACDirectLinearSolver(), N(0), Block_size(64) { }
+
+ // ===================================================================
+ /// Constructor where we specify the matrix A
+ // ===================================================================
+ CCCholeskySolver::CCCholeskySolver(ACMatrix<Real> *const A_mat_pt)
+  : ACLinearSolver(A_mat_pt), ACDirectLinearSolver(A_mat_pt), N(0),
+    Block_size(64) { }
+
+ // ===================================================================
+ /// Empty destructor
+ // ===================================================================
+ CCCholeskySolver::~CCCholeskySolver() { }
+
+ // ===================================================================
+ /// Set the number of columns of each panel
+ // ===================================================================
+ void CCCholeskySolver::set_block_size(const unsigned long block_size)
+ {
+  if (block_size == 0)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The block size must be at least one" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  Block_size = block_size;
+ }
+
+ // ===================================================================
+ /// Performs the Cholesky factorisation of the already stored matrix
+ /// A, the factorisation is internally stored such that it can be
+ /// re-used when calling resolve
+ // ===================================================================
+ void CCCholeskySolver::factorise()
+ {
+  check_square_matrix_has_been_set();
+  Resolve_enabled = false;
+
+  // The layout of the panels, the columns of the panel [j0, j0 + w)
+  // have j0 + w entries
+  N = this->A_pt->n_rows();
+  Column_offset.resize(N);
+  unsigned long n_entries = 0;
+  for (unsigned long j0 = 0; j0 < N; j0+=Block_size)
+   {
+    const unsigned long w = std::min(Block_size, N - j0);
+    for (unsigned long c = 0; c < w; c++)
+     {
+      Column_offset[j0 + c] = n_entries + c * (j0 + w);
+     }
+    n_entries+= w * (j0 + w);
+   }
+
+  // The upper triangle of the matrix is copied into the panels
+  U.assign(n_entries, Real(0));
+  if (N > 0)
+   {
+    copy_upper_triangle(*(this->A_pt), &U[0], &Column_offset[0]);
+   }
+  Panel_by_rows.resize(N * std::min(Block_size, N));
+
+  for (unsigned long j0 = 0; j0 < N; j0+=Block_size)
+   {
+    const unsigned long w = std::min(Block_size, N - j0);
+    update_panel(j0, w);
+    factorise_diagonal_block(j0, w);
+   }
+
+  // Set the flag to indicate that resolve is enabled since we have
+  // computed the factorisation
+  Resolve_enabled = true;
+ }
+
+ // ===================================================================
+ /// Computes the rows [0, j0) of the panel of the columns [j0, j0 + w)
+ /// from the previous panels. The panel is transposed in Panel_by_rows,
+ /// for each previous panel I its rows are updated by GEMM, U(I, J) -=
+ /// U(0:i0, I)^T U(0:i0, J), and solved with the transpose of the
+ /// diagonal block of I. The diagonal block of the panel is then
+ /// updated by GEMM with the computed rows. The columns of the panel
+ /// are split among the threads
+ // ===================================================================
+ void CCCholeskySolver::update_panel(const unsigned long j0, const unsigned long w)
+ {
+  Real *u = &U[0];
+  Real *t = &Panel_by_rows[0];
+  const unsigned long ld = j0 + w;
+  Real *panel = u + Column_offset[j0];
+  const unsigned long block_size = Block_size;
+  const unsigned long *column_offset = &Column_offset[0];
+
+  // The panel stored by rows
+  for (unsigned long c = 0; c < w; c++)
+   {
+    const Real *column_pt = panel + c * ld;
+    for (unsigned long p = 0; p < ld; p++)
+     {
+      t[p * w + c] = column_pt[p];
+     }
+   }
+
+  ThreadPool::parallel_for(w, [=](const unsigned long begin, const unsigned long end)
+                           {
+                            for (unsigned long i0 = 0; i0 < j0; i0+=block_size)
+                             {
+                              // The previous panels have all the columns
+                              const unsigned long ld_i = i0 + block_size;
+                              const Real *panel_i = u + column_offset[i0];
+                              if (i0 > 0)
+                               {
+                                GEMMKernels::gemm_update(block_size, end - begin, i0, Real(-1),
+                                                         panel_i, ld_i,
+                                                         t + begin, w,
+                                                         t + i0 * w + begin, w);
+                               }
+                              for (unsigned long r = 0; r < block_size; r++)
+                               {
+                                const Real *column_r = panel_i + r * ld_i;
+                                Real *row = t + (i0 + r) * w;
+                                for (unsigned long p = i0; p < i0 + r; p++)
+                                 {
+                                  const Real u_pr = column_r[p];
+                                  const Real *row_p = t + p * w;
+                                  for (unsigned long c = begin; c < end; c++)
+                                   {
+                                    row[c]-= u_pr * row_p[c];
+                                   }
+                                 }
+                                const Real inverse_diagonal = Real(1) / column_r[i0 + r];
+                                for (unsigned long c = begin; c < end; c++)
+                                 {
+                                  row[c]*= inverse_diagonal;
+                                 }
+                               }
+                             }
+                            // Store the computed rows in the panel
+                            for (unsigned long c = begin; c < end; c++)
+                             {
+                              Real *column_pt = panel + c * ld;
+                              for (unsigned long p = 0; p < j0; p++)
+                               {
+                                column_pt[p] = t[p * w + c];
+                               }
+                             }
+                           }, j0 * j0 / 2 + 1);
+
+  // The diagonal block, U(J, J) -= U(0:j0, J)^T U(0:j0, J), the
+  // columns of the panel are the rows of U(0:j0, J)^T
+  if (j0 > 0)
+   {
+    ThreadPool::parallel_for(w, [=](const unsigned long begin, const unsigned long end)
+                             {
+                              GEMMKernels::gemm_update(w, end - begin, j0, Real(-1),
+                                                       panel, ld,
+                                                       t + begin, w,
+                                                       t + j0 * w + begin, w);
+                             }, w * j0);
+   }
+ }
+
+ // ===================================================================
+ /// Factorises the diagonal block of the panel of the columns [j0, j0
+ /// + w) (in Panel_by_rows) column by column: column c solves U(0:c,
+ /// 0:c)^T u_c = a_c, then the diagonal entry is the square root of
+ /// what is left of a_cc. The block is then stored in U
+ // ===================================================================
+ void CCCholeskySolver::factorise_diagonal_block(const unsigned long j0, const unsigned long w)
+ {
+  Real *d = &Panel_by_rows[0] + j0 * w;
+  for (unsigned long c = 0; c < w; c++)
+   {
+    Real sum_of_squares = 0.0;
+    for (unsigned long r = 0; r < c; r++)
+     {
+      Real sum = d[r * w + c];
+      for (unsigned long p = 0; p < r; p++)
+       {
+        sum-= d[p * w + r] * d[p * w + c];
+       }
+      d[r * w + c] = sum / d[r * w + r];
+      sum_of_squares+= d[r * w + c] * d[r * w + c];
+     }
+
+    const Real diagonal = d[c * w + c] - sum_of_squares;
+    if (!(diagonal > Real(0)))
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The matrix is not positive definite, non positive\n"
+                    << "pivot in column " << j0 + c << ": " << diagonal << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+    d[c * w + c] = std::sqrt(diagonal);
+   }
+
+  Real *panel = &U[0] + Column_offset[j0];
+  const unsigned long ld = j0 + w;
+  for (unsigned long c = 0; c < w; c++)
+   {
+    for (unsigned long r = 0; r <= c; r++)
+     {
+      panel[c * ld + j0 + r] = d[r * w + c];
+     }
+   }
+ }
+
+ // ===================================================================
+ /// Solves with the factorised matrix, x stores the right-hand side on
+ /// input and the solution on output
+ // ===================================================================
+ void CCCholeskySolver::back_substitution(Real *x)
+ {
+  const Real *u = U.empty() ? 0 : &U[0];
+
+  // Forward substitution with U^T, a dot product with each column
+  for (unsigned long j = 0; j < N; j++)
+   {
+    const Real *column_j = u + Column_offset[j];
+    x[j] = (x[j] - ParallelKernels::serial_dot<Real, Real>(j, column_j, x)) / column_j[j];
+   }
+
+  // Backward substitution with U, an axpy with each column
+  for (unsigned long j = N; j-- > 0; )
+   {
+    const Real *column_j = u + Column_offset[j];
+    const Real x_j = x[j] / column_j[j];
+    x[j] = x_j;
+    for (unsigned long k = 0; k < j; k++)
+     {
+      x[k]-= column_j[k] * x_j;
+     }
+   }
+ }
+
+ // ===================================================================
+ /// Solves with the factorised matrix for n_rhs right-hand sides
+ /// stored by rows in X, by panels. Forward substitution with U^T: the
+ /// rows of each panel are updated by GEMM with the rows of the
+ /// previous panels (the columns of the panel are the rows of U^T) and
+ /// then solved with the transpose of its diagonal block. Backward
+ /// substitution with U: the rows of each panel are solved with its
+ /// diagonal block and the rows above are updated by GEMM with the
+ /// panel transposed in Panel_by_rows. The right-hand sides are split
+ /// among the threads
+ // ===================================================================
+ void CCCholeskySolver::block_back_substitution(Real *X,
+                                                const unsigned long n_rhs,
+                                                const unsigned long ldx)
+ {
+  if (N == 0 || n_rhs == 0)
+   {
+    return;
+   }
+  const Real *u = &U[0];
+  const unsigned long n = N;
+  const unsigned long block_size = Block_size;
+  const unsigned long *column_offset = &Column_offset[0];
+
+  // Forward substitution with U^T
+  ThreadPool::parallel_for(n_rhs, [=](const unsigned long begin, const unsigned long end)
+                           {
+                            const unsigned long nc = end - begin;
+                            Real *x = X + begin;
+                            for (unsigned long j0 = 0; j0 < n; j0+=block_size)
+                             {
+                              const unsigned long w = std::min(block_size, n - j0);
+                              const unsigned long ld = j0 + w;
+                              const Real *panel = u + column_offset[j0];
+                              Real *x_j0 = x + j0 * ldx;
+                              if (j0 > 0)
+                               {
+                                GEMMKernels::gemm_update(w, nc, j0, Real(-1),
+                                                         panel, ld,
+                                                         x, ldx,
+                                                         x_j0, ldx);
+                               }
+                              for (unsigned long c = 0; c < w; c++)
+                               {
+                                const Real *column_c = panel + c * ld;
+                                Real *row_c = x_j0 + c * ldx;
+                                for (unsigned long r = 0; r < c; r++)
+                                 {
+                                  const Real u_rc = column_c[j0 + r];
+                                  const Real *row_r = x_j0 + r * ldx;
+                                  for (unsigned long k = 0; k < nc; k++)
+                                   {
+                                    row_c[k]-= u_rc * row_r[k];
+                                   }
+                                 }
+                                const Real inverse_diagonal = Real(1) / column_c[j0 + c];
+                                for (unsigned long k = 0; k < nc; k++)
+                                 {
+                                  row_c[k]*= inverse_diagonal;
+                                 }
+                               }
+                             }
+                           }, n * n / 2 + 1);
+
+  // Backward substitution with U, from the last panel
+  const unsigned long n_panels = (n - 1) / block_size + 1;
+  for (unsigned long l = n_panels; l-- > 0; )
+   {
+    const unsigned long j0 = l * block_size;
+    const unsigned long w = std::min(block_size, n - j0);
+    const unsigned long ld = j0 + w;
+    const Real *panel = u + column_offset[j0];
+
+    // The rows [0, j0) of the panel stored by rows
+    Real *t = &Panel_by_rows[0];
+    for (unsigned long c = 0; c < w; c++)
+     {
+      const Real *column_c = panel + c * ld;
+      for (unsigned long p = 0; p < j0; p++)
+       {
+        t[p * w + c] = column_c[p];
+       }
+     }
+
+    ThreadPool::parallel_for(n_rhs, [=](const unsigned long begin, const unsigned long end)
+                             {
+                              const unsigned long nc = end - begin;
+                              Real *x = X + begin;
+                              Real *x_j0 = x + j0 * ldx;
+                              for (unsigned long c = w; c-- > 0; )
+                               {
+                                Real *row_c = x_j0 + c * ldx;
+                                for (unsigned long r = c + 1; r < w; r++)
+                                 {
+                                  const Real u_cr = panel[r * ld + j0 + c];
+                                  const Real *row_r = x_j0 + r * ldx;
+                                  for (unsigned long k = 0; k < nc; k++)
+                                   {
+                                    row_c[k]-= u_cr * row_r[k];
+                                   }
+                                 }
+                                const Real inverse_diagonal = Real(1) / panel[c * ld + j0 + c];
+                                for (unsigned long k = 0; k < nc; k++)
+                                 {
+                                  row_c[k]*= inverse_diagonal;
+                                 }
+                               }
+                              if (j0 > 0)
+                               {
+                                GEMMKernels::gemm_update(j0, nc, w, Real(-1),
+                                                         t, w,
+                                                         x_j0, ldx,
+                                                         x, ldx);
+                               }
+                             }, ld * w);
+   }
+ }
+
+}
@@ -0,0 +1,129 @@
+/// IN THIS FILE: The definition of the concrete class CCCholeskySolver
+/// to solve systems of equations whose matrix is symmetric positive
+/// definite by the Cholesky factorisation A = U^T U. The cost is n^3 /
+/// 3 operations (half of LU) and the factor U is stored by panels of
+/// columns of its upper triangle, thus the memory is close to the n *
+/// (n + 1) / 2 entries of the packed storage. The matrix may be given
+/// in packed storage (CCSymmetricMatrix) or as any other square matrix,
+/// only its upper triangle is read
+
+// Check whether the class has been already defined
+#ifndef CCCHOLESKYSOLVER_H
+#define CCCHOLESKYSOLVER_H
+
+// Include the header from inherited class
+#include "ac_direct_linear_solver.h"
+
+// The symmetric matrices
+#include "../matrices/cc_symmetric_matrix.h"
+
+namespace scicellxx
+{
+
+ /// A concrete class to solve linear systems of equations with
+ /// symmetric positive definite matrices. The columns of the upper
+ /// triangular factor U are grouped in panels of Block_size columns,
+ /// the panel of the columns [j0, j0 + w) stores the rows [0, j0 + w)
+ /// of each column one after the other (the entries below the
+ /// diagonal of its diagonal block are zero), column j of U starts at
+ /// Column_offset[j]. The factorisation is left-looking and blocked:
+ /// the rows of U above the diagonal block of each panel are computed
+ /// from the previous panels by GEMM and triangular solves, then the
+ /// diagonal block is factorised. The substitutions work on dot
+ /// products and axpys of contiguous columns. An error is thrown if
+ /// the matrix is not positive definite, use CCLDLTSolver for
+ /// symmetric indefinite matrices
+ class CCCholeskySolver : public virtual ACDirectLinearSolver
+ {
+
+ public:
+
+  /// Empty constructor
+  CCCholeskySolver();
+
+  /// Constructor where we specify the matrix A
+  CCCholeskySolver(ACMatrix<Real> *const A_mat_pt);
+
+  /// Empty destructor
+  ~CCCholeskySolver();
+
+  /// Performs the Cholesky factorisation of the already stored matrix
+  /// A, the factorisation is internally stored such that it can be
+  /// re-used when calling resolve
+  void factorise();
+
+  // Bring the version that sets the matrix from the base class
+  using ACDirectLinearSolver::factorise;
+
+  /// Set the number of columns of each panel
+  void set_block_size(const unsigned long block_size);
+
+  /// The number of columns of each panel
+  inline unsigned long block_size() const {return Block_size;}
+
+ protected:
+
+  /// Solves with the factorised matrix, x stores the right-hand side
+  /// on input and the solution on output
+  void back_substitution(Real *x);
+
+  // Bring the overloaded versions from the base class
+  using ACDirectLinearSolver::back_substitution;
+
+  /// Solves with the factorised matrix for n_rhs right-hand sides
+  /// stored by rows in X, by panels: the rows of each panel are
+  /// updated by GEMM and then solved with its diagonal block, the
+  /// right-hand sides are split among the threads
+  void block_back_substitution(Real *X, const unsigned long n_rhs,
+                               const unsigned long ldx);
+
+  /// Computes the rows [0, j0) of the panel of the columns [j0, j0 +
+  /// w) from the previous panels, the panel is transposed in
+  /// Panel_by_rows where its rows [j0, j0 + w) are also updated
+  void update_panel(const unsigned long j0, const unsigned long w);
+
+  /// Factorises the diagonal block of the panel of the columns [j0, j0
+  /// + w) (in Panel_by_rows) and stores it in U
+  void factorise_diagonal_block(const unsigned long j0, const unsigned long w);
+
+  /// The panels of the upper triangular factor
+  std::vector<Real> U;
+
+  /// The position in U of the first entry of each column
+  std::vector<unsigned long> Column_offset;
+
+  /// The panel being factorised stored by rows, (j0 + w) X w entries
+  /// (also the rows [0, j0) of the panel used by the backward
+  /// substitution of many right-hand sides)
+  std::vector<Real> Panel_by_rows;
+
+  /// The number of rows of the factorised matrix
+  unsigned long N;
+
+  /// The number of columns of each panel
+  unsigned long Block_size;
+
+ private:
+
+  /// Copy constructor (we do not want this class to be
+  /// copiable). Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  CCCholeskySolver(const CCCholeskySolver &copy)
+   : ACLinearSolver(), ACDirectLinearSolver()
+   {
+    BrokenCopy::broken_copy("CCCholeskySolver");
+   }
+
+  /// Assignment operator (we do not want this class to be
+  /// copiable. Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  void operator=(const CCCholeskySolver &copy)
+   {
+    BrokenCopy::broken_assign("CCCholeskySolver");
+   }
+
+ };
+
+}
+
+#endif // #ifndef CCCHOLESKYSOLVER_H
@@ -34,7 +34,7 @@ namespace scicellxx
 #ifdef SCICELLXX_USES_ARMADILLO
   return new CCSolverArmadillo();
 #else
-  return new CCLUSolverNumericalRecipes();
+  return new CCBlockedLUSolver();
 #endif // #ifdef SCICELLXX_USES_ARMADILLO
  }
  
@@ -55,6 +55,47 @@ namespace scicellxx
    {
     return new CCLUSolverNumericalRecipes();
    }
+  // Blocked LU solver for dense matrices
+  else if (linear_solver_name.compare("blocked_lu")==0)
+   {
+    return new CCBlockedLUSolver();
+   }
+  // LU solver for banded matrices
+  else if (linear_solver_name.compare("banded_lu")==0)
+   {
+    return new CCBandedLUSolver();
+   }
+  // Thomas algorithm for tridiagonal matrices
+  else if (linear_solver_name.compare("thomas")==0)
+   {
+    return new CCThomasSolver();
+   }
+  // Cholesky solver for symmetric positive definite matrices
+  else if (linear_solver_name.compare("cholesky")==0)
+   {
+    return new CCCholeskySolver();
+   }
+  // LDL^T solver (Bunch-Kaufman pivoting) for symmetric indefinite
+  // matrices
+  else if (linear_solver_name.compare("ldlt")==0)
+   {
+    return new CCLDLTSolver();
+   }
+  // Conjugate gradient for symmetric positive definite matrices
+  else if (linear_solver_name.compare("cg")==0)
+   {
+    return new CCCGSolver();
+   }
+  // Restarted GMRES for general matrices
+  else if (linear_solver_name.compare("gmres")==0)
+   {
+    return new CCGMRESSolver();
+   }
+  // BiCGStab for general matrices
+  else if (linear_solver_name.compare("bicgstab")==0)
+   {
+    return new CCBiCGStabSolver();
+   }
 #ifdef SCICELLXX_USES_ARMADILLO
   // Linear solver from Armadillo
   else if (linear_solver_name.compare("armadillo")==0)
@@ -69,6 +110,14 @@ namespace scicellxx
                   << "Please implement it yourself or select another one\n\n"
                   << "Availables ones\n"
                   << "- LU linear solver from Numerical Recipes (numerical_recipes)\n"
+                  << "- Blocked LU linear solver for dense matrices (blocked_lu)\n"
+                  << "- LU linear solver for banded matrices (banded_lu)\n"
+                  << "- Thomas algorithm for tridiagonal matrices (thomas)\n"
+                  << "- Cholesky solver for symmetric positive definite matrices (cholesky)\n"
+                  << "- LDL^T solver for symmetric indefinite matrices (ldlt)\n"
+                  << "- Conjugate gradient for symmetric positive definite matrices (cg)\n"
+                  << "- Restarted GMRES iterative solver (gmres)\n"
+                  << "- BiCGStab iterative solver (bicgstab)\n"
                   << "- Armadillo Linear Solver (armadillo) - only if support for armadiilo library is enabled\n"
                   << std::endl;
     throw SciCellxxLibError(error_message.str(),
@@ -7,6 +7,18 @@
 // Include the linear solver
 #include "ac_linear_solver.h"
 #include "cc_lu_solver_numerical_recipes.h"
+#include "cc_blocked_lu_solver.h"
+#include "cc_banded_lu_solver.h"
+#include "cc_thomas_solver.h"
+#include "cc_cholesky_solver.h"
+#include "cc_ldlt_solver.h"
+#include "cc_cg_solver.h"
+#include "cc_gmres_solver.h"
+#include "cc_bicgstab_solver.h"
+// The preconditioners of the iterative solvers
+#include "cc_jacobi_preconditioner.h"
+#include "cc_ssor_preconditioner.h"
+#include "cc_ilu0_preconditioner.h"
 #ifdef SCICELLXX_USES_ARMADILLO
 #include "cc_solver_armadillo.h"
 #endif // #ifdef SCICELLXX_USES_ARMADILO
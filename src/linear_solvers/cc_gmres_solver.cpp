@@ -0,0 +1,158 @@
+/// IN THIS FILE: Implementation of a concrete class to solve systems
+/// of equations with general matrices by the restarted generalised
+/// minimal residual method, GMRES(m)
+
+#include "cc_gmres_solver.h"
+
+// The scaling of the basis vectors
+#include "../matrices/cc_span.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ /// Empty constructor
+ // ===================================================================
+ CCGMRESSolver::CCGMRESSolver()
+  : ACLinearSolver(), ACIterativeLinearSolver(), Restart(30) { }
+
+ // ===================================================================
+ /// Constructor where we specify the matrix A
+ // ===================================================================
+ CCGMRESSolver::CCGMRESSolver(ACMatrix<Real> *const A_mat_pt)
+  : ACLinearSolver(A_mat_pt), ACIterativeLinearSolver(A_mat_pt),
+    Restart(30) { }
+
+ // ===================================================================
+ /// Empty destructor
+ // ===================================================================
+ CCGMRESSolver::~CCGMRESSolver() { }
+
+ // ===================================================================
+ /// Set the number of iterations between restarts (the size of the
+ /// Krylov basis)
+ // ===================================================================
+ void CCGMRESSolver::set_restart(const unsigned long restart)
+ {
+  if (restart == 0)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The number of iterations between restarts must be\n"
+                  << "positive" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  Restart = restart;
+ }
+
+ // ===================================================================
+ /// Solves A x = b by GMRES(m). Each cycle builds the Arnoldi basis of
+ /// A M^{-1} from the current residual, iteration j adds the column j
+ /// of H and rotates it to triangular form, then x is updated with
+ /// the solution of the least squares problem
+ // ===================================================================
+ void CCGMRESSolver::iterate(const Real *b, Real *x)
+ {
+  const unsigned long m = Restart;
+  V.resize((m + 1) * N);
+  H.resize((m + 1) * m);
+  Cosines.resize(m);
+  Sines.resize(m);
+  G.resize(m + 1);
+  Z.resize(N);
+  U.resize(N);
+  Real *z = Z.data();
+  Real *u = U.data();
+
+  // The initial residual is the first basis vector
+  compute_residual(b, x, V.data());
+  Real beta = norm_2(V.data());
+  bool converged = start_iterations(beta);
+
+  while (!converged && iterations_left())
+   {
+    BulkKernels::scale(N, Real(1.0) / beta, V.data(), 1);
+    std::fill(G.begin(), G.end(), Real(0.0));
+    G[0] = beta;
+
+    // The Arnoldi iterations of this cycle
+    unsigned long k = 0;
+    while (k < m && iterations_left())
+     {
+      const unsigned long j = k;
+      Real *h = H.data() + j * (m + 1);
+      Real *w = V.data() + (j + 1) * N;
+      apply_preconditioner(V.data() + j * N, z);
+      matrix_times_vector(z, w);
+
+      // Modified Gram-Schmidt
+      for (unsigned long i = 0; i <= j; i++)
+       {
+        h[i] = dot(w, V.data() + i * N);
+        axpy(-h[i], V.data() + i * N, w);
+       }
+      h[j+1] = norm_2(w);
+      if (h[j+1] != 0.0)
+       {
+        BulkKernels::scale(N, Real(1.0) / h[j+1], w, 1);
+       }
+
+      // Apply the previous rotations to the new column and compute
+      // the rotation that zeroes its sub-diagonal entry
+      for (unsigned long i = 0; i < j; i++)
+       {
+        const Real h_i = h[i];
+        h[i] = Cosines[i] * h_i + Sines[i] * h[i+1];
+        h[i+1] = -Sines[i] * h_i + Cosines[i] * h[i+1];
+       }
+      const Real radius = std::sqrt(h[j] * h[j] + h[j+1] * h[j+1]);
+      if (radius == 0.0)
+       {
+        breakdown("GMRES", "the column of the Hessenberg matrix");
+       }
+      Cosines[j] = h[j] / radius;
+      Sines[j] = h[j+1] / radius;
+      h[j] = radius;
+      h[j+1] = 0.0;
+      G[j+1] = -Sines[j] * G[j];
+      G[j] = Cosines[j] * G[j];
+      k++;
+
+      converged = residual_has_converged(std::fabs(G[j+1]));
+      if (converged)
+       {
+        break;
+       }
+     }
+
+    // Solve the triangular system H y = G (in G) and update x with
+    // M^{-1} V y
+    for (unsigned long i = k; i-- > 0; )
+     {
+      Real sum = G[i];
+      for (unsigned long l = i + 1; l < k; l++)
+       {
+        sum-= H[i + l * (m + 1)] * G[l];
+       }
+      G[i] = sum / H[i + i * (m + 1)];
+     }
+    std::fill(u, u + N, Real(0.0));
+    for (unsigned long i = 0; i < k; i++)
+     {
+      axpy(G[i], V.data() + i * N, u);
+     }
+    apply_preconditioner(u, z);
+    axpy(Real(1.0), z, x);
+
+    // Restart from the true residual
+    if (!converged && iterations_left())
+     {
+      compute_residual(b, x, V.data());
+      beta = norm_2(V.data());
+     }
+   }
+ }
+
+}
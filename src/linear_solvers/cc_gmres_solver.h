@@ -0,0 +1,94 @@
+/// IN THIS FILE: The definition of the concrete class CCGMRESSolver to
+/// solve systems of equations with general (non-symmetric) matrices by
+/// the restarted generalised minimal residual method, GMRES(m)
+
+// Check whether the class has been already defined
+#ifndef CCGMRESSOLVER_H
+#define CCGMRESSOLVER_H
+
+// Include the header from inherited class
+#include "ac_iterative_linear_solver.h"
+
+namespace scicellxx
+{
+
+ /// GMRES(m) with right preconditioning, A M^{-1} u = b with x = M^{-1}
+ /// u, thus the residual minimised is that of the original system. The
+ /// Arnoldi basis is orthogonalised by modified Gram-Schmidt and the
+ /// Hessenberg matrix is reduced by Givens rotations as it grows, such
+ /// that the norm of the residual is known at each iteration without
+ /// computing x. The method restarts after Restart iterations from the
+ /// current x, the memory is (Restart + 1) vectors of the size of the
+ /// system
+ class CCGMRESSolver : public virtual ACIterativeLinearSolver
+ {
+
+ public:
+
+  /// Empty constructor
+  CCGMRESSolver();
+
+  /// Constructor where we specify the matrix A
+  CCGMRESSolver(ACMatrix<Real> *const A_mat_pt);
+
+  /// Empty destructor
+  ~CCGMRESSolver();
+
+  /// Set the number of iterations between restarts (the size of the
+  /// Krylov basis)
+  void set_restart(const unsigned long restart);
+
+  /// The number of iterations between restarts
+  inline unsigned long restart() const {return Restart;}
+
+ protected:
+
+  /// Solves A x = b by GMRES(m)
+  void iterate(const Real *b, Real *x);
+
+  /// The number of iterations between restarts
+  unsigned long Restart;
+
+  /// The Arnoldi basis, vector i is stored in V[i * N, (i + 1) * N)
+  std::vector<Real> V;
+
+  /// The upper Hessenberg matrix reduced to triangular, stored by
+  /// columns with (Restart + 1) rows
+  std::vector<Real> H;
+
+  /// The cosines and sines of the Givens rotations
+  std::vector<Real> Cosines;
+  std::vector<Real> Sines;
+
+  /// The right-hand side of the least squares problem, its last entry
+  /// is the norm of the residual
+  std::vector<Real> G;
+
+  /// The preconditioned basis vector and the update of the solution
+  std::vector<Real> Z;
+  std::vector<Real> U;
+
+ private:
+
+  /// Copy constructor (we do not want this class to be
+  /// copiable). Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  CCGMRESSolver(const CCGMRESSolver &copy)
+   : ACLinearSolver(), ACIterativeLinearSolver()
+   {
+    BrokenCopy::broken_copy("CCGMRESSolver");
+   }
+
+  /// Assignment operator (we do not want this class to be
+  /// copiable. Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  void operator=(const CCGMRESSolver &copy)
+   {
+    BrokenCopy::broken_assign("CCGMRESSolver");
+   }
+
+ };
+
+}
+
+#endif // #ifndef CCGMRESSOLVER_H
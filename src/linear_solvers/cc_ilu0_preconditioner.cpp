@@ -0,0 +1,114 @@
+/// IN THIS FILE: Implementation of the incomplete LU factorisation
+/// with no fill-in, ILU(0)
+
+#include "cc_ilu0_preconditioner.h"
+
+// The type used to accumulate the sums of the substitutions
+#include "../matrices/accumulator_traits.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ /// Empty constructor
+ // ===================================================================
+ CCILU0Preconditioner::CCILU0Preconditioner()
+  : ACPreconditioner() { }
+
+ // ===================================================================
+ /// Empty destructor
+ // ===================================================================
+ CCILU0Preconditioner::~CCILU0Preconditioner() { }
+
+ // ===================================================================
+ /// Computes the incomplete factorisation of the input matrix. Row i
+ /// is eliminated with the rows k < i in its pattern (IKJ variant),
+ /// only the entries of row i in the pattern are updated, they are
+ /// found by the position of their columns in row i
+ // ===================================================================
+ void CCILU0Preconditioner::setup(const ACMatrix<Real> *const A_mat_pt)
+ {
+  check_square_matrix(A_mat_pt);
+  copy_to_compressed_rows(A_mat_pt, Row_start, Column_index, LU);
+  find_diagonal(Row_start, Column_index, LU, Diagonal_position);
+
+  // The position in LU of each column of the current row, N for
+  // the columns out of its pattern
+  std::vector<unsigned long> position(N, N);
+  for (unsigned long i = 0; i < N; i++)
+   {
+    for (unsigned long p = Row_start[i]; p < Row_start[i+1]; p++)
+     {
+      position[Column_index[p]] = p;
+     }
+
+    // Eliminate with the previous rows in the pattern
+    for (unsigned long p = Row_start[i]; p < Diagonal_position[i]; p++)
+     {
+      const unsigned long k = Column_index[p];
+      const Real l_ik = LU[p] / LU[Diagonal_position[k]];
+      LU[p] = l_ik;
+      for (unsigned long q = Diagonal_position[k] + 1; q < Row_start[k+1]; q++)
+       {
+        const unsigned long j = position[Column_index[q]];
+        if (j != N)
+         {
+          LU[j]-= l_ik * LU[q];
+         }
+       }
+     }
+
+    if (LU[Diagonal_position[i]] == 0.0)
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "Zero pivot in row " << i << " of the incomplete LU\n"
+                    << "factorisation" << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+
+    for (unsigned long p = Row_start[i]; p < Row_start[i+1]; p++)
+     {
+      position[Column_index[p]] = N;
+     }
+   }
+ }
+
+ // ===================================================================
+ /// Applies the preconditioner, solves L y = r and then U z = y, both
+ /// in z
+ // ===================================================================
+ void CCILU0Preconditioner::apply(const Real *r, Real *z) const
+ {
+  typedef AccumulatorTraits<Real>::Accumulator_type A;
+  const unsigned long *row_start = Row_start.data();
+  const unsigned long *column_index = Column_index.data();
+  const Real *lu = LU.data();
+
+  // Forward substitution with the unit lower triangular factor
+  for (unsigned long i = 0; i < N; i++)
+   {
+    A sum = r[i];
+    for (unsigned long p = row_start[i]; p < Diagonal_position[i]; p++)
+     {
+      sum-= A(lu[p]) * A(z[column_index[p]]);
+     }
+    z[i] = Real(sum);
+   }
+
+  // Backward substitution with the upper triangular factor
+  for (unsigned long i = N; i-- > 0; )
+   {
+    const unsigned long diagonal = Diagonal_position[i];
+    A sum = z[i];
+    for (unsigned long p = diagonal + 1; p < row_start[i+1]; p++)
+     {
+      sum-= A(lu[p]) * A(z[column_index[p]]);
+     }
+    z[i] = Real(sum / A(lu[diagonal]));
+   }
+ }
+
+}
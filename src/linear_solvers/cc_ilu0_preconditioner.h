@@ -0,0 +1,74 @@
+/// IN THIS FILE: The definition of the concrete class
+/// CCILU0Preconditioner, the incomplete LU factorisation with no
+/// fill-in of the iterative linear solvers
+
+// Check whether the class has been already defined
+#ifndef CCILU0PRECONDITIONER_H
+#define CCILU0PRECONDITIONER_H
+
+// Include the header from inherited class
+#include "ac_preconditioner.h"
+
+namespace scicellxx
+{
+
+ /// The ILU(0) preconditioner, M = L U with L unit lower triangular
+ /// and U upper triangular, both with the sparsity pattern of the
+ /// matrix: the entries of the LU factorisation out of the pattern
+ /// (the fill-in) are dropped. The factors overwrite a copy of the
+ /// non-zero entries of the matrix in compressed sparse row format,
+ /// thus its memory is that of the matrix. For dense matrices the
+ /// pattern is that of their non-zero entries. No pivoting is done, an
+ /// error is thrown if a pivot is zero
+ class CCILU0Preconditioner : public virtual ACPreconditioner
+ {
+
+ public:
+
+  /// Empty constructor
+  CCILU0Preconditioner();
+
+  /// Empty destructor
+  ~CCILU0Preconditioner();
+
+  /// Computes the incomplete factorisation of the input matrix
+  void setup(const ACMatrix<Real> *const A_mat_pt);
+
+  /// Applies the preconditioner, solves L U z = r
+  void apply(const Real *r, Real *z) const;
+
+ protected:
+
+  /// The factors L (strictly below the diagonal) and U in compressed
+  /// sparse row format
+  std::vector<unsigned long> Row_start;
+  std::vector<unsigned long> Column_index;
+  std::vector<Real> LU;
+
+  /// The position of the diagonal entry of each row in LU
+  std::vector<unsigned long> Diagonal_position;
+
+ private:
+
+  /// Copy constructor (we do not want this class to be
+  /// copiable). Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  CCILU0Preconditioner(const CCILU0Preconditioner &copy)
+   : ACPreconditioner()
+   {
+    BrokenCopy::broken_copy("CCILU0Preconditioner");
+   }
+
+  /// Assignment operator (we do not want this class to be
+  /// copiable. Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  void operator=(const CCILU0Preconditioner &copy)
+   {
+    BrokenCopy::broken_assign("CCILU0Preconditioner");
+   }
+
+ };
+
+}
+
+#endif // #ifndef CCILU0PRECONDITIONER_H
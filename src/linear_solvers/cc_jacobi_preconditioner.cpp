@@ -0,0 +1,56 @@
+/// IN THIS FILE: Implementation of the diagonal (Jacobi)
+/// preconditioner
+
+#include "cc_jacobi_preconditioner.h"
+
+// The products element by element
+#include "../matrices/parallel_kernels.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ /// Empty constructor
+ // ===================================================================
+ CCJacobiPreconditioner::CCJacobiPreconditioner()
+  : ACPreconditioner() { }
+
+ // ===================================================================
+ /// Empty destructor
+ // ===================================================================
+ CCJacobiPreconditioner::~CCJacobiPreconditioner() { }
+
+ // ===================================================================
+ /// Computes the inverse of the diagonal of the input matrix
+ // ===================================================================
+ void CCJacobiPreconditioner::setup(const ACMatrix<Real> *const A_mat_pt)
+ {
+  check_square_matrix(A_mat_pt);
+
+  Inverse_diagonal.resize(N);
+  for (unsigned long i = 0; i < N; i++)
+   {
+    const Real a_ii = A_mat_pt->value(i, i);
+    if (a_ii == 0.0)
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The diagonal entry of row " << i << " is zero, the\n"
+                    << "Jacobi preconditioner can not be computed" << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+    Inverse_diagonal[i] = 1.0 / a_ii;
+   }
+ }
+
+ // ===================================================================
+ /// Applies the preconditioner, z = D^{-1} r
+ // ===================================================================
+ void CCJacobiPreconditioner::apply(const Real *r, Real *z) const
+ {
+  ParallelKernels::multiply_element_by_element(N, Inverse_diagonal.data(), r, z);
+ }
+
+}
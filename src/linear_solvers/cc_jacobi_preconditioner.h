@@ -0,0 +1,64 @@
+/// IN THIS FILE: The definition of the concrete class
+/// CCJacobiPreconditioner, the diagonal (Jacobi) preconditioner of
+/// the iterative linear solvers
+
+// Check whether the class has been already defined
+#ifndef CCJACOBIPRECONDITIONER_H
+#define CCJACOBIPRECONDITIONER_H
+
+// Include the header from inherited class
+#include "ac_preconditioner.h"
+
+namespace scicellxx
+{
+
+ /// The Jacobi preconditioner, M = diag(A). It is the cheapest to set
+ /// up and apply (in parallel, one product per entry) and it removes
+ /// the bad scaling of the rows, an error is thrown if an entry of the
+ /// diagonal is zero
+ class CCJacobiPreconditioner : public virtual ACPreconditioner
+ {
+
+ public:
+
+  /// Empty constructor
+  CCJacobiPreconditioner();
+
+  /// Empty destructor
+  ~CCJacobiPreconditioner();
+
+  /// Computes the inverse of the diagonal of the input matrix
+  void setup(const ACMatrix<Real> *const A_mat_pt);
+
+  /// Applies the preconditioner, z = D^{-1} r
+  void apply(const Real *r, Real *z) const;
+
+ protected:
+
+  /// The inverse of the entries of the diagonal
+  std::vector<Real> Inverse_diagonal;
+
+ private:
+
+  /// Copy constructor (we do not want this class to be
+  /// copiable). Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  CCJacobiPreconditioner(const CCJacobiPreconditioner &copy)
+   : ACPreconditioner()
+   {
+    BrokenCopy::broken_copy("CCJacobiPreconditioner");
+   }
+
+  /// Assignment operator (we do not want this class to be
+  /// copiable. Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  void operator=(const CCJacobiPreconditioner &copy)
+   {
+    BrokenCopy::broken_assign("CCJacobiPreconditioner");
+   }
+
+ };
+
+}
+
+#endif // #ifndef CCJACOBIPRECONDITIONER_H
@@ -0,0 +1,457 @@
+/// IN THIS FILE: Implementation of a concrete class to solve systems
+/// of equations with symmetric (indefinite) matrices by the blocked
+/// LDL^T factorisation with the symmetric pivoting of Bunch and
+/// Kaufman
+
+#include "cc_ldlt_solver.h"
+
+// The products of matrices for the trailing updates
+#include "../matrices/gemm_kernels.h"
+// The dot products of the updates of the columns and the
+// substitutions
+#include "../matrices/parallel_kernels.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ /// Empty constructor
+ // ===================================================================
+ CCLDLTSolver::CCLDLTSolver()
+  : ACLinearSolver(), ACDirectLinearSolver(), N(0), Block_size(64) { }
+
+ // ===================================================================
+ /// Constructor where we specify the matrix A
+ // ===================================================================
+ CCLDLTSolver::CCLDLTSolver(ACMatrix<Real> *const A_mat_pt)
+  : ACLinearSolver(A_mat_pt), ACDirectLinearSolver(A_mat_pt), N(0),
+    Block_size(64) { }
+
+ // ===================================================================
+ /// Empty destructor
+ // ===================================================================
+ CCLDLTSolver::~CCLDLTSolver() { }
+
+ // ===================================================================
+ /// Set the number of columns of each panel
+ // ===================================================================
+ void CCLDLTSolver::set_block_size(const unsigned long block_size)
+ {
+  // A panel has room for at least a 2 X 2 block
+  if (block_size < 2)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The block size must be at least two" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  Block_size = block_size;
+ }
+
+ // ===================================================================
+ /// Performs the LDL^T factorisation of the already stored matrix A,
+ /// the factorisation is internally stored such that it can be re-used
+ /// when calling resolve
+ // ===================================================================
+ void CCLDLTSolver::factorise()
+ {
+  check_square_matrix_has_been_set();
+  Resolve_enabled = false;
+
+  // The upper triangle of the matrix is copied into the lower
+  // triangle of the array, column j of the upper triangle is the
+  // beginning of row j
+  N = this->A_pt->n_rows();
+  LD.resize(N * N);
+  if (N > 0)
+   {
+    std::vector<unsigned long> row_offset(N);
+    for (unsigned long i = 0; i < N; i++)
+     {
+      row_offset[i] = i * N;
+     }
+    copy_upper_triangle(*(this->A_pt), &LD[0], &row_offset[0]);
+   }
+  Pivots.resize(N);
+  Pivot_block_size.assign(N, 1);
+  // The last panel may have one column more than Block_size
+  W_by_columns.resize((Block_size + 1) * N);
+
+  unsigned long k0 = 0;
+  while (k0 < N)
+   {
+    const unsigned long k = factorise_panel(k0);
+    update_trailing(k0, k);
+    k0 = k;
+   }
+
+  // Set the flag to indicate that resolve is enabled since we have
+  // computed the factorisation
+  Resolve_enabled = true;
+ }
+
+ // ===================================================================
+ /// Factorises the columns of the panel starting at column k0. At
+ /// step k the pivot is chosen as in Bunch and Kaufman (1977): the
+ /// diagonal entry if it is large enough compared with the largest
+ /// entry of its column, otherwise the diagonal entry of the row of
+ /// that largest entry or a 2 X 2 block with it. The growth of the
+ /// entries is bounded as with partial pivoting and the symmetry is
+ /// kept. The columns of the trailing submatrix are not updated, the
+ /// column k (and the column of the candidate pivot) are updated on
+ /// the fly in W with the previous columns of the panel. The last
+ /// panel takes all the remaining columns
+ // ===================================================================
+ unsigned long CCLDLTSolver::factorise_panel(const unsigned long k0)
+ {
+  Real *a = &LD[0];
+  Real *w = &W_by_columns[0];
+  const unsigned long n = N;
+  const bool is_last_panel = n - k0 <= Block_size;
+  const Real alpha = (Real(1) + std::sqrt(Real(17))) / Real(8);
+
+  unsigned long k = k0;
+  while (k < n && (is_last_panel || k - k0 < Block_size - 1))
+   {
+    const unsigned long c = k - k0;
+    Real *w_k = w + c * n;
+
+    // The column k updated with the previous columns of the panel
+    for (unsigned long i = k; i < n; i++)
+     {
+      w_k[i] = a[i * n + k];
+     }
+    update_column_of_w(k0, k, c, k);
+
+    // The largest entry below the diagonal in column k
+    const Real abs_akk = std::fabs(w_k[k]);
+    unsigned long i_max = k;
+    Real col_max = 0.0;
+    for (unsigned long i = k + 1; i < n; i++)
+     {
+      const Real candidate = std::fabs(w_k[i]);
+      if (candidate > col_max)
+       {
+        col_max = candidate;
+        i_max = i;
+       }
+     }
+
+    if (std::max(abs_akk, col_max) == Real(0))
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The matrix is singular, zero pivot in column "
+                    << k << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+
+    unsigned long pivot = k;
+    unsigned long step = 1;
+    Real *w_k1 = w + (c + 1) * n;
+    if (abs_akk < alpha * col_max)
+     {
+      // The column i_max updated with the previous columns of the
+      // panel, its entries in the rows [k, i_max) are in row i_max
+      for (unsigned long j = k; j < i_max; j++)
+       {
+        w_k1[j] = a[i_max * n + j];
+       }
+      for (unsigned long i = i_max; i < n; i++)
+       {
+        w_k1[i] = a[i * n + i_max];
+       }
+      update_column_of_w(k0, k, c + 1, i_max);
+
+      // The largest off-diagonal entry in row (and column) i_max
+      Real row_max = 0.0;
+      for (unsigned long j = k; j < n; j++)
+       {
+        if (j != i_max)
+         {
+          row_max = std::max(row_max, Real(std::fabs(w_k1[j])));
+         }
+       }
+
+      if (abs_akk * row_max >= alpha * col_max * col_max)
+       {
+        pivot = k;
+       }
+      else if (std::fabs(w_k1[i_max]) >= alpha * row_max)
+       {
+        pivot = i_max;
+        std::copy(w_k1 + k, w_k1 + n, w_k + k);
+       }
+      else
+       {
+        pivot = i_max;
+        step = 2;
+       }
+     }
+
+    // Bring the pivot to the last row and column of the block
+    const unsigned long kk = k + step - 1;
+    Pivots[k] = k;
+    Pivots[kk] = pivot;
+    if (pivot != kk)
+     {
+      // The column kk of the trailing submatrix (not updated) is
+      // moved to column pivot, column kk is overwritten by the factor
+      a[pivot * n + pivot] = a[kk * n + kk];
+      for (unsigned long j = kk + 1; j < pivot; j++)
+       {
+        a[pivot * n + j] = a[j * n + kk];
+       }
+      for (unsigned long i = pivot + 1; i < n; i++)
+       {
+        a[i * n + pivot] = a[i * n + kk];
+       }
+      // Interchange the rows of L of the previous columns and the rows
+      // of W
+      std::swap_ranges(a + kk * n, a + kk * n + kk, a + pivot * n);
+      for (unsigned long r = 0; r < c + step; r++)
+       {
+        std::swap(w[r * n + kk], w[r * n + pivot]);
+       }
+     }
+
+    if (step == 1)
+     {
+      // L(i, k) = W(i, k) / d
+      a[k * n + k] = w_k[k];
+      const Real inverse_d = Real(1) / w_k[k];
+      for (unsigned long i = k + 1; i < n; i++)
+       {
+        a[i * n + k] = w_k[i] * inverse_d;
+       }
+     }
+    else
+     {
+      // The multipliers solve [L(i, k) L(i, k + 1)] D = [W(i, k) W(i,
+      // k + 1)], D is scaled by its off-diagonal entry as in LAPACK
+      const Real d21 = w_k[k + 1];
+      const Real d11 = w_k1[k + 1] / d21;
+      const Real d22 = w_k[k] / d21;
+      const Real scaling = (Real(1) / (d11 * d22 - Real(1))) / d21;
+      for (unsigned long i = k + 2; i < n; i++)
+       {
+        a[i * n + k] = scaling * (d11 * w_k[i] - w_k1[i]);
+        a[i * n + k + 1] = scaling * (d22 * w_k1[i] - w_k[i]);
+       }
+      a[k * n + k] = w_k[k];
+      a[(k + 1) * n + k] = w_k[k + 1];
+      a[(k + 1) * n + k + 1] = w_k1[k + 1];
+      Pivot_block_size[k] = 2;
+      Pivot_block_size[k + 1] = 2;
+     }
+
+    k+= step;
+   }
+
+  return k;
+ }
+
+ // ===================================================================
+ /// Updates the entries in the rows [k, N) of column c of W with the
+ /// columns [k0, k) of L, W(i, c) -= L(i, k0:k) W(r, 0:k-k0)^T. The
+ /// rows of L are contiguous, the row r of W is gathered first
+ // ===================================================================
+ void CCLDLTSolver::update_column_of_w(const unsigned long k0, const unsigned long k,
+                                       const unsigned long c, const unsigned long r)
+ {
+  const unsigned long kb = k - k0;
+  if (kb == 0)
+   {
+    return;
+   }
+  const unsigned long n = N;
+  const Real *a = &LD[0];
+  const Real *w = &W_by_columns[0];
+  std::vector<Real> w_r(kb);
+  for (unsigned long p = 0; p < kb; p++)
+   {
+    w_r[p] = w[p * n + r];
+   }
+  const Real *w_r_pt = &w_r[0];
+  Real *w_c = &W_by_columns[0] + c * n;
+  ThreadPool::parallel_for(n - k, [=](const unsigned long begin, const unsigned long end)
+                           {
+                            for (unsigned long i = k + begin; i < k + end; i++)
+                             {
+                              w_c[i]-= ParallelKernels::serial_dot<Real, Real>(kb, a + i * n + k0, w_r_pt);
+                             }
+                           }, kb);
+ }
+
+ // ===================================================================
+ /// Updates the lower triangle of the trailing submatrix after the
+ /// panel [k0, k), A(k:, k:) -= L(k:, k0:k) W(k:, 0:k-k0)^T. The rows
+ /// are split among the threads, each of them calls GEMM on its slab
+ /// up to the diagonal (the columns of W are the rows of W^T)
+ // ===================================================================
+ void CCLDLTSolver::update_trailing(const unsigned long k0, const unsigned long k)
+ {
+  const unsigned long kb = k - k0;
+  if (k >= N || kb == 0)
+   {
+    return;
+   }
+  const unsigned long n = N;
+  Real *a = &LD[0];
+  const Real *w = &W_by_columns[0];
+  ThreadPool::parallel_for(n - k, [=](const unsigned long begin, const unsigned long end)
+                           {
+                            GEMMKernels::gemm_update(end - begin, end, kb, Real(-1),
+                                                     a + (k + begin) * n + k0, n,
+                                                     w + k, n,
+                                                     a + (k + begin) * n + k, n);
+                           }, (n - k) * kb / 2);
+ }
+
+ // ===================================================================
+ /// The inertia of the factorised matrix, the number of positive and
+ /// negative eigenvalues (those of D by Sylvester's law of inertia)
+ // ===================================================================
+ void CCLDLTSolver::inertia(unsigned long &n_positive, unsigned long &n_negative) const
+ {
+  if (!Resolve_enabled)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix has not been factorised.\n"
+                  << "You need to call factorise() before inertia()"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  n_positive = 0;
+  n_negative = 0;
+  unsigned long k = 0;
+  while (k < N)
+   {
+    const Real d11 = LD[k * N + k];
+    if (Pivot_block_size[k] == 1)
+     {
+      n_positive+= d11 > Real(0) ? 1 : 0;
+      n_negative+= d11 < Real(0) ? 1 : 0;
+      k++;
+     }
+    else
+     {
+      const Real d21 = LD[(k + 1) * N + k];
+      const Real d22 = LD[(k + 1) * N + k + 1];
+      const Real determinant = d11 * d22 - d21 * d21;
+      if (determinant < Real(0))
+       {
+        n_positive++;
+        n_negative++;
+       }
+      else if (d11 + d22 > Real(0))
+       {
+        n_positive+= 2;
+       }
+      else
+       {
+        n_negative+= 2;
+       }
+      k+= 2;
+     }
+   }
+ }
+
+ // ===================================================================
+ /// Solves with the factorised matrix, x stores the right-hand side on
+ /// input and the solution on output
+ // ===================================================================
+ void CCLDLTSolver::back_substitution(Real *x)
+ {
+  const Real *ld = LD.empty() ? 0 : &LD[0];
+
+  // Apply the interchanges
+  for (unsigned long k = 0; k < N; k++)
+   {
+    if (Pivots[k] != k)
+     {
+      std::swap(x[k], x[Pivots[k]]);
+     }
+   }
+
+  // Forward substitution with L (unit diagonal) by blocks of D, the
+  // entry below the diagonal of a 2 X 2 block belongs to D
+  unsigned long k = 0;
+  while (k < N)
+   {
+    x[k]-= ParallelKernels::serial_dot<Real, Real>(k, ld + k * N, x);
+    if (Pivot_block_size[k] == 2)
+     {
+      x[k + 1]-= ParallelKernels::serial_dot<Real, Real>(k, ld + (k + 1) * N, x);
+      k+= 2;
+     }
+    else
+     {
+      k++;
+     }
+   }
+
+  // Solve with the blocks of D (a 2 X 2 block scaled by its
+  // off-diagonal entry as in LAPACK)
+  k = 0;
+  while (k < N)
+   {
+    if (Pivot_block_size[k] == 1)
+     {
+      x[k]/= ld[k * N + k];
+      k++;
+     }
+    else
+     {
+      const Real d21 = ld[(k + 1) * N + k];
+      const Real d11 = ld[k * N + k] / d21;
+      const Real d22 = ld[(k + 1) * N + k + 1] / d21;
+      const Real denominator = d11 * d22 - Real(1);
+      const Real b1 = x[k] / d21;
+      const Real b2 = x[k + 1] / d21;
+      x[k] = (d22 * b1 - b2) / denominator;
+      x[k + 1] = (d11 * b2 - b1) / denominator;
+      k+= 2;
+     }
+   }
+
+  // Backward substitution with L^T, an axpy with each row of L. The
+  // blocks cover the diagonal, thus going backwards the last entry of
+  // a 2 X 2 block is found first
+  unsigned long i = N;
+  while (i > 0)
+   {
+    const unsigned long step = Pivot_block_size[i - 1];
+    const unsigned long k0 = i - step;
+    for (unsigned long r = k0; r < i; r++)
+     {
+      const Real *row_r = ld + r * N;
+      const Real x_r = x[r];
+      for (unsigned long j = 0; j < k0; j++)
+       {
+        x[j]-= row_r[j] * x_r;
+       }
+     }
+    i = k0;
+   }
+
+  // Undo the interchanges
+  k = N;
+  while (k-- > 0)
+   {
+    if (Pivots[k] != k)
+     {
+      std::swap(x[k], x[Pivots[k]]);
+     }
+   }
+ }
+
+}
@@ -0,0 +1,139 @@
+/// IN THIS FILE: The definition of the concrete class CCLDLTSolver to
+/// solve systems of equations whose matrix is symmetric, but not
+/// necessarily positive definite, by the factorisation P A P^T = L D
+/// L^T with the symmetric pivoting of Bunch and Kaufman. D is block
+/// diagonal with 1 X 1 and 2 X 2 blocks, thus indefinite matrices (and
+/// positive semi-definite ones whose Cholesky factorisation breaks down
+/// by rounding) are factorised stably at the cost of Cholesky, n^3 / 3
+/// operations. The factorisation is blocked, the updates of the
+/// trailing submatrix are delayed and done by GEMM once per panel
+
+// Check whether the class has been already defined
+#ifndef CCLDLTSOLVER_H
+#define CCLDLTSOLVER_H
+
+// Include the header from inherited class
+#include "ac_direct_linear_solver.h"
+
+// The symmetric matrices
+#include "../matrices/cc_symmetric_matrix.h"
+
+namespace scicellxx
+{
+
+ /// A concrete class to solve linear systems of equations with
+ /// symmetric matrices. The matrix may be given in packed storage
+ /// (CCSymmetricMatrix) or as any other square matrix, only its upper
+ /// triangle is read. Its lower triangle is copied by rows into an n X
+ /// n array and overwritten by the unit lower triangular L and the
+ /// blocks of D. Pivots[k] is the row and column interchanged at step
+ /// k (with k + 1 for a 2 X 2 block), Pivot_block_size[k] is the size
+ /// of the block of D that includes the k-th entry of the diagonal.
+ ///
+ /// Each panel of Block_size columns is factorised with the updates
+ /// of its columns computed on the fly (W = L D of the panel, as
+ /// LAPACK's dsytrf), then the trailing submatrix is updated once, A22
+ /// -= L21 W21^T, by GEMM in parallel by slabs of rows. An error is
+ /// thrown if a column of the matrix is zero at its step (the matrix
+ /// is singular)
+ class CCLDLTSolver : public virtual ACDirectLinearSolver
+ {
+
+ public:
+
+  /// Empty constructor
+  CCLDLTSolver();
+
+  /// Constructor where we specify the matrix A
+  CCLDLTSolver(ACMatrix<Real> *const A_mat_pt);
+
+  /// Empty destructor
+  ~CCLDLTSolver();
+
+  /// Performs the LDL^T factorisation of the already stored matrix A,
+  /// the factorisation is internally stored such that it can be
+  /// re-used when calling resolve
+  void factorise();
+
+  // Bring the version that sets the matrix from the base class
+  using ACDirectLinearSolver::factorise;
+
+  /// Set the number of columns of each panel
+  void set_block_size(const unsigned long block_size);
+
+  /// The number of columns of each panel
+  inline unsigned long block_size() const {return Block_size;}
+
+  /// The inertia of the factorised matrix, the number of positive and
+  /// negative eigenvalues (those of D by Sylvester's law of inertia)
+  void inertia(unsigned long &n_positive, unsigned long &n_negative) const;
+
+ protected:
+
+  /// Solves with the factorised matrix, x stores the right-hand side
+  /// on input and the solution on output
+  void back_substitution(Real *x);
+
+  // Bring the overloaded versions from the base class
+  using ACDirectLinearSolver::back_substitution;
+
+  /// Factorises the columns of the panel starting at column k0, the
+  /// columns of W are the updated columns of the panel. Returns the
+  /// first column not factorised (the panel may end one column
+  /// earlier to leave room for a 2 X 2 block)
+  unsigned long factorise_panel(const unsigned long k0);
+
+  /// Updates the entries in the rows [k0, N) of column c of W with the
+  /// columns [k0, k) of L, W(i, c) -= L(i, k0:k) W(r, 0:k-k0)^T for i
+  /// >= k, r is the row of W with the multipliers
+  void update_column_of_w(const unsigned long k0, const unsigned long k,
+                          const unsigned long c, const unsigned long r);
+
+  /// Updates the lower triangle of the trailing submatrix after the
+  /// panel [k0, k), A(k:, k:) -= L(k:, k0:k) W(k:, 0:k-k0)^T
+  void update_trailing(const unsigned long k0, const unsigned long k);
+
+  /// The factors L and D, the lower triangle of an N X N array stored
+  /// by rows
+  std::vector<Real> LD;
+
+  /// The updated columns of the panel, column c of W is stored in
+  /// W_by_columns[c * N, (c + 1) * N)
+  std::vector<Real> W_by_columns;
+
+  /// The row and column interchanged at each step
+  std::vector<unsigned long> Pivots;
+
+  /// The size of the block of D of each entry of the diagonal (1 or 2)
+  std::vector<unsigned char> Pivot_block_size;
+
+  /// The number of rows of the factorised matrix
+  unsigned long N;
+
+  /// The number of columns of each panel
+  unsigned long Block_size;
+
+ private:
+
+  /// Copy constructor (we do not want this class to be
+  /// copiable). Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  CCLDLTSolver(const CCLDLTSolver &copy)
+   : ACLinearSolver(), ACDirectLinearSolver()
+   {
+    BrokenCopy::broken_copy("CCLDLTSolver");
+   }
+
+  /// Assignment operator (we do not want this class to be
+  /// copiable. Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  void operator=(const CCLDLTSolver &copy)
+   {
+    BrokenCopy::broken_assign("CCLDLTSolver");
+   }
+
+ };
+
+}
+
+#endif // #ifndef CCLDLTSOLVER_H
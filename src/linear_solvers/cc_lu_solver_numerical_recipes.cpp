@@ -413,9 +413,35 @@ namespace scicellxx
    }
   
   // The matrix used as input and output, after calling ludcmp it has
-  // the LU factorisation
-  lu_a = new Mat_DP(this->A_pt->matrix_pt(), n_rows, n_columns);
-  
+  // the LU factorisation (always in double, the entries are converted
+  // in the single precision build). Matrices stored by rows with no
+  // padding are copied as a single block, the others (views of
+  // sub-blocks for example) are copied row by row
+  const CCMatrixSpan<Real> A = this->A_pt->span();
+  lu_a = new Mat_DP(n_rows, n_columns);
+  if (!A.is_empty() && A.is_row_major() && A.is_contiguous())
+   {
+    BulkKernels::copy(n_rows*n_columns, A.Data_pt, 1, (*lu_a)[0], 1);
+   }
+  else
+   {
+    for (unsigned long i = 0; i < n_rows; i++)
+     {
+      if (!A.is_empty())
+       {
+        BulkKernels::copy(n_columns, A.Data_pt + i*A.Row_stride,
+                          A.Column_stride, (*lu_a)[i], 1);
+       }
+      else
+       {
+        for (unsigned long j = 0; j < n_columns; j++)
+         {
+          (*lu_a)[i][j] = this->A_pt->value(i, j);
+         }
+       }
+     }
+   }
+
   // Output vector of size n x 1 that records the row permutations
   // performed by partial pivoting.
   lu_indx = new Vec_INT(n_rows);
@@ -461,22 +487,41 @@ namespace scicellxx
   
   // The solution vector size n x 1 (Numerical Recipes definition)
   Vec_DP x(n_rows);
- 
+  
+  // Get the memory of the right-hand side and the solution matrices,
+  // the columns are copied in and out directly when available
+  const CCMatrixSpan<Real> B = B_pt->span();
+  const CCMatrixSpan<Real> X = X_output_pt->span();
+  
   // Copy the right-hand side into the solution vectors
   for (unsigned j = 0; j < n_rhs; j++)
    {
-    for (unsigned i = 0; i < n_rows; i++)
+    if (!B.is_empty())
      {
-      x[i] = (*B_pt)(i,j);
+      BulkKernels::copy(n_rows, B.Data_pt + j*B.Column_stride, B.Row_stride, &x[0], 1);
      }
-   
+    else
+     {
+      for (unsigned i = 0; i < n_rows; i++)
+       {
+        x[i] = (*B_pt)(i,j);
+       }
+     }
+    
     // Back-substitution
     NR::lubksb(*lu_a, *lu_indx, x);
-   
+    
     // Copy the solution into the output vector
-    for (unsigned i = 0; i < n_rows; i++)
+    if (!X.is_empty())
+     {
+      BulkKernels::copy(n_rows, &x[0], 1, X.Data_pt + j*X.Column_stride, X.Row_stride);
+     }
+    else
      {
-      (*X_output_pt)(i, j) =  x[i];
+      for (unsigned i = 0; i < n_rows; i++)
+       {
+        (*X_output_pt)(i, j) =  x[i];
+       }
      }
     
    }
@@ -497,19 +542,38 @@ namespace scicellxx
   // The solution vector size n x 1 (Numerical Recipes definition)
   Vec_DP x(n_rows);
   
+  // Get the memory of the right-hand side and the solution vectors,
+  // they are copied in and out directly when available
+  const CCVectorSpan<Real> b = b_pt->span();
+  const CCVectorSpan<Real> x_output = x_output_pt->span();
+  
   // Copy the right-hand side into the solution vector
-  for (unsigned i = 0; i < n_rows; i++)
+  if (!b.is_empty())
    {
-    x[i] = (*b_pt)(i);
+    BulkKernels::copy(n_rows, b.Data_pt, b.Stride, &x[0], 1);
    }
-   
+  else
+   {
+    for (unsigned i = 0; i < n_rows; i++)
+     {
+      x[i] = (*b_pt)(i);
+     }
+   }
+  
   // Back-substitution
   NR::lubksb(*lu_a, *lu_indx, x);
   
   // Copy the solution into the output vector
-  for (unsigned i = 0; i < n_rows; i++)
+  if (!x_output.is_empty())
    {
-    (*x_output_pt)(i) =  x[i];
+    BulkKernels::copy(n_rows, &x[0], 1, x_output.Data_pt, x_output.Stride);
+   }
+  else
+   {
+    for (unsigned i = 0; i < n_rows; i++)
+     {
+      (*x_output_pt)(i) =  x[i];
+     }
    }
   
  }
@@ -97,6 +97,9 @@ namespace scicellxx
   
  protected:
   
+  /// The factorisation is kept by factorise() and re-used by resolve()
+  inline bool resolve_is_implemented() const {return true;}
+  
   /// Flag to indicate whether resolve is enabled (only after calling
   /// factorise)
   bool Resolve_enabled;
@@ -0,0 +1,92 @@
+/// IN THIS FILE: Implementation of the symmetric successive
+/// over-relaxation (SSOR) preconditioner
+
+#include "cc_ssor_preconditioner.h"
+
+// The type used to accumulate the sums of the sweeps
+#include "../matrices/accumulator_traits.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ /// Constructor, the relaxation factor must be in (0, 2)
+ // ===================================================================
+ CCSSORPreconditioner::CCSSORPreconditioner(const Real omega)
+  : ACPreconditioner()
+ {
+  set_omega(omega);
+ }
+
+ // ===================================================================
+ /// Empty destructor
+ // ===================================================================
+ CCSSORPreconditioner::~CCSSORPreconditioner() { }
+
+ // ===================================================================
+ /// Set the relaxation factor, it must be in (0, 2)
+ // ===================================================================
+ void CCSSORPreconditioner::set_omega(const Real omega)
+ {
+  if (!(omega > 0.0 && omega < 2.0))
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The relaxation factor of SSOR must be in (0, 2)\n"
+                  << "omega = " << omega << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  Omega = omega;
+ }
+
+ // ===================================================================
+ /// Copies the non-zero entries of the input matrix
+ // ===================================================================
+ void CCSSORPreconditioner::setup(const ACMatrix<Real> *const A_mat_pt)
+ {
+  check_square_matrix(A_mat_pt);
+  copy_to_compressed_rows(A_mat_pt, Row_start, Column_index, Values);
+  find_diagonal(Row_start, Column_index, Values, Diagonal_position);
+ }
+
+ // ===================================================================
+ /// Applies the preconditioner, z = M^{-1} r. The forward sweep solves
+ /// (D + omega L) y = omega (2 - omega) r, the backward one (D + omega
+ /// U) z = D y, both in z
+ // ===================================================================
+ void CCSSORPreconditioner::apply(const Real *r, Real *z) const
+ {
+  typedef AccumulatorTraits<Real>::Accumulator_type A;
+  const unsigned long *row_start = Row_start.data();
+  const unsigned long *column_index = Column_index.data();
+  const Real *values = Values.data();
+  const Real scaling = Omega * (2.0 - Omega);
+
+  // Forward sweep, the columns before the diagonal
+  for (unsigned long i = 0; i < N; i++)
+   {
+    const unsigned long diagonal = Diagonal_position[i];
+    A sum = 0.0;
+    for (unsigned long p = row_start[i]; p < diagonal; p++)
+     {
+      sum+= A(values[p]) * A(z[column_index[p]]);
+     }
+    z[i] = Real((A(scaling) * A(r[i]) - A(Omega) * sum) / A(values[diagonal]));
+   }
+
+  // Backward sweep, the columns after the diagonal
+  for (unsigned long i = N; i-- > 0; )
+   {
+    const unsigned long diagonal = Diagonal_position[i];
+    A sum = 0.0;
+    for (unsigned long p = diagonal + 1; p < row_start[i+1]; p++)
+     {
+      sum+= A(values[p]) * A(z[column_index[p]]);
+     }
+    z[i]-= Real(A(Omega) * sum / A(values[diagonal]));
+   }
+ }
+
+}
@@ -0,0 +1,83 @@
+/// IN THIS FILE: The definition of the concrete class
+/// CCSSORPreconditioner, the symmetric successive over-relaxation
+/// preconditioner of the iterative linear solvers
+
+// Check whether the class has been already defined
+#ifndef CCSSORPRECONDITIONER_H
+#define CCSSORPRECONDITIONER_H
+
+// Include the header from inherited class
+#include "ac_preconditioner.h"
+
+namespace scicellxx
+{
+
+ /// The SSOR preconditioner, with A = L + D + U,
+ ///
+ /// M = (D + omega L) D^{-1} (D + omega U) / (omega (2 - omega)),
+ ///
+ /// applied by a forward and a backward sweep over the non-zero
+ /// entries of the matrix (stored by compressed rows). M is symmetric
+ /// positive definite for symmetric positive definite matrices and
+ /// omega in (0, 2), thus it may be used with CG. The sweeps are
+ /// sequential, each of them costs one mat-vec
+ class CCSSORPreconditioner : public virtual ACPreconditioner
+ {
+
+ public:
+
+  /// Constructor, the relaxation factor must be in (0, 2)
+  CCSSORPreconditioner(const Real omega = 1.0);
+
+  /// Empty destructor
+  ~CCSSORPreconditioner();
+
+  /// Set the relaxation factor, it must be in (0, 2)
+  void set_omega(const Real omega);
+
+  /// The relaxation factor
+  inline Real omega() const {return Omega;}
+
+  /// Copies the non-zero entries of the input matrix
+  void setup(const ACMatrix<Real> *const A_mat_pt);
+
+  /// Applies the preconditioner, z = M^{-1} r
+  void apply(const Real *r, Real *z) const;
+
+ protected:
+
+  /// The relaxation factor
+  Real Omega;
+
+  /// The matrix in compressed sparse row format
+  std::vector<unsigned long> Row_start;
+  std::vector<unsigned long> Column_index;
+  std::vector<Real> Values;
+
+  /// The position of the diagonal entry of each row in Values
+  std::vector<unsigned long> Diagonal_position;
+
+ private:
+
+  /// Copy constructor (we do not want this class to be
+  /// copiable). Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  CCSSORPreconditioner(const CCSSORPreconditioner &copy)
+   : ACPreconditioner()
+   {
+    BrokenCopy::broken_copy("CCSSORPreconditioner");
+   }
+
+  /// Assignment operator (we do not want this class to be
+  /// copiable. Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  void operator=(const CCSSORPreconditioner &copy)
+   {
+    BrokenCopy::broken_assign("CCSSORPreconditioner");
+   }
+
+ };
+
+}
+
+#endif // #ifndef CCSSORPRECONDITIONER_H
@@ -0,0 +1,118 @@
+/// IN THIS FILE: Implementation of a concrete class to solve systems
+/// of equations with tridiagonal matrices by the Thomas algorithm
+
+#include "cc_thomas_solver.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ /// Empty constructor
+ // ===================================================================
+ CCThomasSolver::CCThomasSolver()
+  : ACLinearSolver(), ACDirectLinearSolver() { }
+
+ // ===================================================================
+ /// Constructor where we specify the matrix A
+ // ===================================================================
+ CCThomasSolver::CCThomasSolver(ACMatrix<Real> *const A_mat_pt)
+  : ACLinearSolver(A_mat_pt), ACDirectLinearSolver(A_mat_pt) { }
+
+ // ===================================================================
+ /// Empty destructor
+ // ===================================================================
+ CCThomasSolver::~CCThomasSolver() { }
+
+ // ===================================================================
+ /// Performs the factorisation of the already stored matrix A, the
+ /// factorisation is internally stored such that it can be re-used
+ /// when calling resolve
+ // ===================================================================
+ void CCThomasSolver::factorise()
+ {
+  check_square_matrix_has_been_set();
+
+  // Only tridiagonal banded matrices are supported
+  const CCBandedMatrix<Real> *banded_pt =
+   dynamic_cast<const CCBandedMatrix<Real>*>(this->A_pt);
+  if (banded_pt == 0 || banded_pt->n_lower_diagonals() > 1 ||
+      banded_pt->n_upper_diagonals() > 1)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The Thomas solver only works with tridiagonal matrices\n"
+                  << "(CCBandedMatrix with at most one diagonal below and one\n"
+                  << "above the main diagonal). Use the banded LU solver for\n"
+                  << "matrices with more diagonals" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  const unsigned long n = banded_pt->n_rows();
+  Multipliers.assign(n, Real(0));
+  Diagonal.resize(n);
+  Upper.assign(n, Real(0));
+  for (unsigned long i = 0; i < n; i++)
+   {
+    Diagonal[i] = banded_pt->value(i, i);
+    if (i + 1 < n)
+     {
+      Upper[i] = banded_pt->value(i, i + 1);
+     }
+   }
+
+  for (unsigned long i = 0; i < n; i++)
+   {
+    if (i > 0)
+     {
+      Multipliers[i] = banded_pt->value(i, i - 1) / Diagonal[i-1];
+      Diagonal[i]-= Multipliers[i] * Upper[i-1];
+     }
+
+    if (Diagonal[i] == Real(0))
+     {
+      Resolve_enabled = false;
+      // Error message
+      std::ostringstream error_message;
+      error_message << "Zero pivot in row " << i << ". The Thomas algorithm\n"
+                    << "does not pivot, use the banded LU solver for this matrix"
+                    << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+   }
+
+  // Set the flag to indicate that resolve is enabled since we have
+  // computed the factorisation
+  Resolve_enabled = true;
+ }
+
+ // ===================================================================
+ /// Solves with the factorised matrix, x stores the right-hand side on
+ /// input and the solution on output
+ // ===================================================================
+ void CCThomasSolver::back_substitution(Real *x)
+ {
+  const unsigned long n = Diagonal.size();
+  if (n == 0)
+   {
+    return;
+   }
+
+  // Forward elimination
+  for (unsigned long i = 1; i < n; i++)
+   {
+    x[i]-= Multipliers[i] * x[i-1];
+   }
+
+  // Backward substitution
+  x[n-1]/= Diagonal[n-1];
+  for (unsigned long i = n - 1; i-- > 0; )
+   {
+    x[i] = (x[i] - Upper[i] * x[i+1]) / Diagonal[i];
+   }
+ }
+
+}
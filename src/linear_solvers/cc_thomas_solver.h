@@ -0,0 +1,87 @@
+/// IN THIS FILE: The definition of the concrete class CCThomasSolver
+/// to solve systems of equations whose matrix is tridiagonal with the
+/// Thomas algorithm (Gaussian elimination with no pivoting), O(n)
+/// operations and memory
+
+// Check whether the class has been already defined
+#ifndef CCTHOMASSOLVER_H
+#define CCTHOMASSOLVER_H
+
+// Include the header from inherited class
+#include "ac_direct_linear_solver.h"
+
+// The banded matrices
+#include "../matrices/cc_banded_matrix.h"
+
+namespace scicellxx
+{
+
+ /// A concrete class to solve linear systems of equations with
+ /// tridiagonal matrices (CCBandedMatrix with at most one diagonal
+ /// below and one above the main diagonal). There is no pivoting, thus
+ /// the matrix should be diagonally dominant or symmetric positive
+ /// definite; an error is thrown when a zero pivot is found, use the
+ /// banded LU solver for those matrices
+ class CCThomasSolver : public virtual ACDirectLinearSolver
+ {
+
+ public:
+
+  /// Empty constructor
+  CCThomasSolver();
+
+  /// Constructor where we specify the matrix A (a CCBandedMatrix)
+  CCThomasSolver(ACMatrix<Real> *const A_mat_pt);
+
+  /// Empty destructor
+  ~CCThomasSolver();
+
+  /// Performs the factorisation of the already stored matrix A, the
+  /// factorisation is internally stored such that it can be re-used
+  /// when calling resolve
+  void factorise();
+
+ protected:
+
+  /// Solves with the factorised matrix, x stores the right-hand side
+  /// on input and the solution on output
+  void back_substitution(Real *x);
+
+  // Bring the overloaded versions from the base class
+  using ACDirectLinearSolver::back_substitution;
+
+  /// The multipliers of the elimination, Multipliers[i] eliminates
+  /// the (i, i-1) entry
+  std::vector<Real> Multipliers;
+
+  /// The diagonal after the elimination
+  std::vector<Real> Diagonal;
+
+  /// The diagonal above the main diagonal, Upper[i] is the (i, i+1)
+  /// entry
+  std::vector<Real> Upper;
+
+ private:
+
+  /// Copy constructor (we do not want this class to be
+  /// copiable). Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  CCThomasSolver(const CCThomasSolver &copy)
+   : ACLinearSolver(), ACDirectLinearSolver()
+   {
+    BrokenCopy::broken_copy("CCThomasSolver");
+   }
+
+  /// Assignment operator (we do not want this class to be
+  /// copiable. Check
+  /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
+  void operator=(const CCThomasSolver &copy)
+   {
+    BrokenCopy::broken_assign("CCThomasSolver");
+   }
+
+ };
+
+}
+
+#endif // #ifndef CCTHOMASSOLVER_H
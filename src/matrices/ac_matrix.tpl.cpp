@@ -29,4 +29,194 @@ namespace scicellxx
  ACMatrix<T>::~ACMatrix()
  { }
  
+ // ===================================================================
+ // Copy the entries of the source matrix, memory is allocated if this
+ // matrix has none, otherwise the sizes should match
+ // ===================================================================
+ template<class T>
+ void ACMatrix<T>::copy(const ACMatrix<T> &source_matrix)
+ {
+  // Check that the source matrix has memory allocated
+  if (!source_matrix.is_own_memory_allocated())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The source matrix has no memory allocated"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  const unsigned long n_rows = source_matrix.n_rows();
+  const unsigned long n_columns = source_matrix.n_columns();
+  if (!this->is_own_memory_allocated())
+   {
+    allocate_memory(n_rows, n_columns);
+   }
+  else if (this->n_rows() != n_rows || this->n_columns() != n_columns)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The dimension of the matrices is not the same:\n"
+                  << "dim(this) = (" << this->n_rows() << ", "
+                  << this->n_columns() << ")\n"
+                  << "dim(source_matrix) = (" << n_rows << ", "
+                  << n_columns << ")\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  const CCMatrixSpan<T> x = source_matrix.span();
+  const CCMatrixSpan<T> y = span();
+  if (!x.is_empty() && !y.is_empty())
+   {
+    // Same layout and no padding, copy as a single block
+    if (x.is_contiguous() && y.is_contiguous() &&
+        x.is_row_major() == y.is_row_major())
+     {
+      BulkKernels::copy(n_rows*n_columns, x.Data_pt, 1, y.Data_pt, 1);
+     }
+    else
+     {
+      for (unsigned long i = 0; i < n_rows; i++)
+       {
+        BulkKernels::copy(n_columns, x.Data_pt + i*x.Row_stride, x.Column_stride,
+                          y.Data_pt + i*y.Row_stride, y.Column_stride);
+       }
+     }
+   }
+  else
+   {
+    for (unsigned long i = 0; i < n_rows; i++)
+     {
+      for (unsigned long j = 0; j < n_columns; j++)
+       {
+        value(i,j) = source_matrix.value(i,j);
+       }
+     }
+   }
+  
+ }
+ 
+ // ===================================================================
+ // this = this + alpha * x
+ // ===================================================================
+ template<class T>
+ void ACMatrix<T>::axpy(const T alpha, const ACMatrix<T> &x)
+ {
+  // Check that both matrices have memory allocated
+  if (!this->is_own_memory_allocated() || !x.is_own_memory_allocated())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "One of the matrices to operate with has no memory allocated\n"
+                  << "this->is_own_memory_allocated() = "
+                  << this->is_own_memory_allocated() << "\n"
+                  << "x.is_own_memory_allocated() = "
+                  << x.is_own_memory_allocated() << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  const unsigned long n_rows = this->n_rows();
+  const unsigned long n_columns = this->n_columns();
+  if (x.n_rows() != n_rows || x.n_columns() != n_columns)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The dimension of the matrices is not the same:\n"
+                  << "dim(this) = (" << n_rows << ", " << n_columns << ")\n"
+                  << "dim(x) = (" << x.n_rows() << ", "
+                  << x.n_columns() << ")\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  const CCMatrixSpan<T> x_span = x.span();
+  const CCMatrixSpan<T> y_span = span();
+  if (!x_span.is_empty() && !y_span.is_empty())
+   {
+    // Same layout and no padding, operate on a single block
+    if (x_span.is_contiguous() && y_span.is_contiguous() &&
+        x_span.is_row_major() == y_span.is_row_major())
+     {
+      BulkKernels::axpy(n_rows*n_columns, alpha, x_span.Data_pt, 1,
+                        y_span.Data_pt, 1);
+     }
+    else
+     {
+      for (unsigned long i = 0; i < n_rows; i++)
+       {
+        BulkKernels::axpy(n_columns, alpha,
+                          x_span.Data_pt + i*x_span.Row_stride, x_span.Column_stride,
+                          y_span.Data_pt + i*y_span.Row_stride, y_span.Column_stride);
+       }
+     }
+   }
+  else
+   {
+    for (unsigned long i = 0; i < n_rows; i++)
+     {
+      for (unsigned long j = 0; j < n_columns; j++)
+       {
+        value(i,j)+= alpha * x.value(i,j);
+       }
+     }
+   }
+  
+ }
+ 
+ // ===================================================================
+ // this = alpha * this
+ // ===================================================================
+ template<class T>
+ void ACMatrix<T>::scale(const T alpha)
+ {
+  // Check that the matrix has memory allocated
+  if (!this->is_own_memory_allocated())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix has no memory allocated"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  const unsigned long n_rows = this->n_rows();
+  const unsigned long n_columns = this->n_columns();
+  const CCMatrixSpan<T> x = span();
+  if (!x.is_empty())
+   {
+    if (x.is_contiguous())
+     {
+      BulkKernels::scale(n_rows*n_columns, alpha, x.Data_pt, 1);
+     }
+    else
+     {
+      for (unsigned long i = 0; i < n_rows; i++)
+       {
+        BulkKernels::scale(n_columns, alpha, x.Data_pt + i*x.Row_stride,
+                           x.Column_stride);
+       }
+     }
+   }
+  else
+   {
+    for (unsigned long i = 0; i < n_rows; i++)
+     {
+      for (unsigned long j = 0; j < n_columns; j++)
+       {
+        value(i,j)*= alpha;
+       }
+     }
+   }
+  
+ }
+ 
 }
@@ -9,6 +9,9 @@
 #include "../general/common_includes.h"
 #include "../general/utilities.h"
 
+// The spans and the kernels for the bulk operations
+#include "cc_span.h"
+
 #ifdef SCICELLXX_USES_ARMADILLO
 // Add Armadillo's includes (only for the arma_matrix_pt() method)
 #include <armadillo>
@@ -130,6 +133,24 @@ namespace scicellxx
    // Disables the deletion of the matrix by itself
    inline void disable_delete_matrix() {Delete_matrix=false;}
    
+   // Get the span with the memory where the entries are stored (and
+   // its layout). The bulk operations below call it once and then
+   // work on the raw memory. Returns an empty span by default,
+   // matrices that do not store their entries in a single block of
+   // memory use the value() methods instead
+   virtual CCMatrixSpan<T> span() const
+   {return CCMatrixSpan<T>();}
+   
+   // Copy the entries of the source matrix, memory is allocated if
+   // this matrix has none, otherwise the sizes should match
+   void copy(const ACMatrix<T> &source_matrix);
+   
+   // this = this + alpha * x
+   void axpy(const T alpha, const ACMatrix<T> &x);
+   
+   // this = alpha * this
+   void scale(const T alpha);
+   
    // Get access to the Matrix_pt
    virtual T *matrix_pt() const
    {
@@ -30,4 +30,144 @@ template<class T>
 ACVector<T>::~ACVector()
 { }
  
+ // ===================================================================
+ // Copy the entries of the source vector, memory is allocated if this
+ // vector has none, otherwise the sizes should match
+ // ===================================================================
+ template<class T>
+ void ACVector<T>::copy(const ACVector<T> &source_vector)
+ {
+  // Check that the source vector has memory allocated
+  if (!source_vector.is_own_memory_allocated())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The source vector has no memory allocated"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  const unsigned long n_values = source_vector.n_values();
+  if (!this->is_own_memory_allocated())
+   {
+    allocate_memory(n_values);
+    set_as_column_vector(source_vector.is_column_vector());
+   }
+  else if (this->n_values() != n_values)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The size of the vectors is not the same:\n"
+                  << "dim(this) = (" << this->n_values() << ")\n"
+                  << "dim(source_vector) = (" << n_values << ")\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  const CCVectorSpan<T> x = source_vector.span();
+  const CCVectorSpan<T> y = span();
+  if (!x.is_empty() && !y.is_empty())
+   {
+    BulkKernels::copy(n_values, x.Data_pt, x.Stride, y.Data_pt, y.Stride);
+   }
+  else
+   {
+    for (unsigned long i = 0; i < n_values; i++)
+     {
+      value(i) = source_vector.value(i);
+     }
+   }
+  
+ }
+ 
+ // ===================================================================
+ // this = this + alpha * x
+ // ===================================================================
+ template<class T>
+ void ACVector<T>::axpy(const T alpha, const ACVector<T> &x)
+ {
+  // Check that both vectors have memory allocated
+  if (!this->is_own_memory_allocated() || !x.is_own_memory_allocated())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "One of the vectors to operate with has no memory allocated\n"
+                  << "this->is_own_memory_allocated() = "
+                  << this->is_own_memory_allocated() << "\n"
+                  << "x.is_own_memory_allocated() = "
+                  << x.is_own_memory_allocated() << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  const unsigned long n_values = this->n_values();
+  if (x.n_values() != n_values)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The size of the vectors is not the same:\n"
+                  << "dim(this) = (" << n_values << ")\n"
+                  << "dim(x) = (" << x.n_values() << ")\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  const CCVectorSpan<T> x_span = x.span();
+  const CCVectorSpan<T> y_span = span();
+  if (!x_span.is_empty() && !y_span.is_empty())
+   {
+    BulkKernels::axpy(n_values, alpha, x_span.Data_pt, x_span.Stride,
+                      y_span.Data_pt, y_span.Stride);
+   }
+  else
+   {
+    for (unsigned long i = 0; i < n_values; i++)
+     {
+      value(i)+= alpha * x.value(i);
+     }
+   }
+  
+ }
+ 
+ // ===================================================================
+ // this = alpha * this
+ // ===================================================================
+ template<class T>
+ void ACVector<T>::scale(const T alpha)
+ {
+  // Check that the vector has memory allocated
+  if (!this->is_own_memory_allocated())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The vector has no memory allocated"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  const unsigned long n_values = this->n_values();
+  const CCVectorSpan<T> x = span();
+  if (!x.is_empty())
+   {
+    BulkKernels::scale(n_values, alpha, x.Data_pt, x.Stride);
+   }
+  else
+   {
+    for (unsigned long i = 0; i < n_values; i++)
+     {
+      value(i)*= alpha;
+     }
+   }
+  
+ }
+ 
 }
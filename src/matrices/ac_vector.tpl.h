@@ -9,6 +9,9 @@
 #include "../general/common_includes.h"
 #include "../general/utilities.h"
 
+// The spans and the kernels for the bulk operations
+#include "cc_span.h"
+
 #ifdef SCICELLXX_USES_ARMADILLO
 // Add Armadillo's includes (only for the arma_vector methods)
 #include <armadillo>
@@ -142,6 +145,24 @@ namespace scicellxx
    // Computes the minimum value
    virtual T min() = 0;
    
+   // Get the span with the memory where the entries are stored. The
+   // bulk operations below call it once and then work on the raw
+   // memory. Returns an empty span by default, vectors that do not
+   // store their entries in a single block of memory use the value()
+   // methods instead
+   virtual CCVectorSpan<T> span() const
+   {return CCVectorSpan<T>();}
+   
+   // Copy the entries of the source vector, memory is allocated if
+   // this vector has none, otherwise the sizes should match
+   void copy(const ACVector<T> &source_vector);
+   
+   // this = this + alpha * x
+   void axpy(const T alpha, const ACVector<T> &x);
+   
+   // this = alpha * this
+   void scale(const T alpha);
+   
    // Get access to the Vector_pt
    virtual T *vector_pt() const
    {
@@ -0,0 +1,36 @@
+// IN THIS FILE: The type used to accumulate reductions (dot
+// products, norms, sums) of entries of type T. Matrices and vectors
+// stored in float halve the memory traffic of the kernels, but the
+// sums of many float values lose accuracy quickly, thus the kernels
+// accumulate them in double and round the result once at the end.
+// Other types accumulate in their own type, the results of the double
+// build are not modified
+
+// Check whether the class has been already defined
+#ifndef ACCUMULATORTRAITS_H
+#define ACCUMULATORTRAITS_H
+
+namespace scicellxx
+{
+
+ // ==================================================================
+ /// The type used to accumulate sums of entries of type T
+ // ==================================================================
+ template<class T>
+  struct AccumulatorTraits
+  {
+   typedef T Accumulator_type;
+  };
+
+ // ==================================================================
+ /// Sums of float entries are accumulated in double
+ // ==================================================================
+ template<>
+  struct AccumulatorTraits<float>
+  {
+   typedef double Accumulator_type;
+  };
+
+}
+
+#endif // #ifndef ACCUMULATORTRAITS_H
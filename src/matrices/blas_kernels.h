@@ -0,0 +1,389 @@
+// IN THIS FILE: Interface to an optimised BLAS library (CBLAS
+// interface, OpenBLAS or the reference BLAS for example) used by the
+// kernels of CCMatrix and CCVector when the library is configured
+// with SCICELLXX_USES_BLAS. Each function returns true if the
+// operation was computed by BLAS. Only float and double are supported
+// by BLAS, the templated versions return false such that the caller
+// falls back to the native kernels for any other type (and when the
+// library is configured without BLAS)
+//
+// All the matrices are stored by rows, lda is the number of entries
+// between two consecutive rows of A (and so on), incx is the number of
+// entries between two consecutive entries of x
+//
+// The functions are inline, the objects that instantiate CCMatrix and
+// CCVector call BLAS directly and only need the BLAS library at link
+// time
+
+// Check whether the namespace has been already defined
+#ifndef BLAS_KERNELS_H
+#define BLAS_KERNELS_H
+
+#include "../general/common_includes.h"
+#include "../general/utilities.h"
+
+#ifdef SCICELLXX_USES_BLAS
+#include <cblas.h>
+#endif // #ifdef SCICELLXX_USES_BLAS
+
+namespace scicellxx
+{
+
+ // ==================================================================
+ /// Kernels computed by an optimised BLAS library
+ // ==================================================================
+ namespace BLASKernels
+ {
+
+  /// Is the library configured to use BLAS
+  inline bool is_available()
+  {
+#ifdef SCICELLXX_USES_BLAS
+   return true;
+#else
+   return false;
+#endif // #ifdef SCICELLXX_USES_BLAS
+  }
+
+  // ================================================================
+  /// C = A * B, A is of size m x k, B of size k x n and C of size m x
+  /// n. Not supported for this type
+  // ================================================================
+  template<class T>
+   inline bool gemm(const unsigned long, const unsigned long,
+                    const unsigned long,
+                    const T *, const unsigned long,
+                    const T *, const unsigned long,
+                    T *, const unsigned long)
+   {return false;}
+
+  // ================================================================
+  /// C = alpha * A * B + beta * C, A is of size m x k, B of size k x n
+  /// and C of size m x n. Not supported for this type
+  // ================================================================
+  template<class T>
+   inline bool gemm(const unsigned long, const unsigned long,
+                    const unsigned long, const T,
+                    const T *, const unsigned long,
+                    const T *, const unsigned long,
+                    const T, T *, const unsigned long)
+   {return false;}
+
+  // ================================================================
+  /// y = A * x, A is of size m x n. Not supported for this type
+  // ================================================================
+  template<class T>
+   inline bool gemv(const unsigned long, const unsigned long,
+                    const T *, const unsigned long,
+                    const T *, const unsigned long,
+                    T *, const unsigned long)
+   {return false;}
+
+  // ================================================================
+  /// result = x^T * y, accumulated in the type of result. Not
+  /// supported for this type
+  // ================================================================
+  template<class T, class A>
+   inline bool dot(const unsigned long,
+                   const T *, const unsigned long,
+                   const T *, const unsigned long,
+                   A &)
+   {return false;}
+
+  // ================================================================
+  /// result = ||x||_2, accumulated in the type of result. Not
+  /// supported for this type
+  // ================================================================
+  template<class T, class A>
+   inline bool nrm2(const unsigned long, const T *, const unsigned long,
+                    A &)
+   {return false;}
+
+  // ================================================================
+  /// y = y + alpha * x. Not supported for this type
+  // ================================================================
+  template<class T>
+   inline bool axpy(const unsigned long, const T,
+                    const T *, const unsigned long,
+                    T *, const unsigned long)
+   {return false;}
+
+  // ================================================================
+  /// x = alpha * x. Not supported for this type
+  // ================================================================
+  template<class T>
+   inline bool scal(const unsigned long, const T, T *, const unsigned long)
+   {return false;}
+
+#ifdef SCICELLXX_USES_BLAS
+
+  // ================================================================
+  /// The sizes are passed to BLAS as int, larger sizes are computed by
+  /// the native kernels (as empty matrices, BLAS rejects leading
+  /// dimensions equal to zero)
+  // ================================================================
+  inline bool fits_in_int(const unsigned long a, const unsigned long b = 0,
+                          const unsigned long c = 0, const unsigned long d = 0)
+  {
+   const unsigned long max_int = static_cast<unsigned long>(std::numeric_limits<int>::max());
+   return a <= max_int && b <= max_int && c <= max_int && d <= max_int;
+  }
+
+  // ================================================================
+  /// C = A * B (cblas_dgemm)
+  // ================================================================
+  inline bool gemm(const unsigned long m, const unsigned long n,
+                   const unsigned long k,
+                   const double *A, const unsigned long lda,
+                   const double *B, const unsigned long ldb,
+                   double *C, const unsigned long ldc)
+  {
+   if (m == 0 || n == 0 || k == 0 ||
+       !fits_in_int(m, n, k) || !fits_in_int(lda, ldb, ldc))
+    {
+     return false;
+    }
+   cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+               int(m), int(n), int(k), 1.0, A, int(lda), B, int(ldb),
+               0.0, C, int(ldc));
+   return true;
+  }
+
+  // ================================================================
+  /// C = A * B (cblas_sgemm)
+  // ================================================================
+  inline bool gemm(const unsigned long m, const unsigned long n,
+                   const unsigned long k,
+                   const float *A, const unsigned long lda,
+                   const float *B, const unsigned long ldb,
+                   float *C, const unsigned long ldc)
+  {
+   if (m == 0 || n == 0 || k == 0 ||
+       !fits_in_int(m, n, k) || !fits_in_int(lda, ldb, ldc))
+    {
+     return false;
+    }
+   cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+               int(m), int(n), int(k), 1.0f, A, int(lda), B, int(ldb),
+               0.0f, C, int(ldc));
+   return true;
+  }
+
+  // ================================================================
+  /// C = alpha * A * B + beta * C (cblas_dgemm)
+  // ================================================================
+  inline bool gemm(const unsigned long m, const unsigned long n,
+                   const unsigned long k, const double alpha,
+                   const double *A, const unsigned long lda,
+                   const double *B, const unsigned long ldb,
+                   const double beta, double *C, const unsigned long ldc)
+  {
+   if (m == 0 || n == 0 || k == 0 ||
+       !fits_in_int(m, n, k) || !fits_in_int(lda, ldb, ldc))
+    {
+     return false;
+    }
+   cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+               int(m), int(n), int(k), alpha, A, int(lda), B, int(ldb),
+               beta, C, int(ldc));
+   return true;
+  }
+
+  // ================================================================
+  /// C = alpha * A * B + beta * C (cblas_sgemm)
+  // ================================================================
+  inline bool gemm(const unsigned long m, const unsigned long n,
+                   const unsigned long k, const float alpha,
+                   const float *A, const unsigned long lda,
+                   const float *B, const unsigned long ldb,
+                   const float beta, float *C, const unsigned long ldc)
+  {
+   if (m == 0 || n == 0 || k == 0 ||
+       !fits_in_int(m, n, k) || !fits_in_int(lda, ldb, ldc))
+    {
+     return false;
+    }
+   cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+               int(m), int(n), int(k), alpha, A, int(lda), B, int(ldb),
+               beta, C, int(ldc));
+   return true;
+  }
+
+  // ================================================================
+  /// y = A * x (cblas_dgemv)
+  // ================================================================
+  inline bool gemv(const unsigned long m, const unsigned long n,
+                   const double *A, const unsigned long lda,
+                   const double *x, const unsigned long incx,
+                   double *y, const unsigned long incy)
+  {
+   if (m == 0 || n == 0 ||
+       !fits_in_int(m, n, lda) || !fits_in_int(incx, incy))
+    {
+     return false;
+    }
+   cblas_dgemv(CblasRowMajor, CblasNoTrans, int(m), int(n), 1.0, A, int(lda),
+               x, int(incx), 0.0, y, int(incy));
+   return true;
+  }
+
+  // ================================================================
+  /// y = A * x (cblas_sgemv)
+  // ================================================================
+  inline bool gemv(const unsigned long m, const unsigned long n,
+                   const float *A, const unsigned long lda,
+                   const float *x, const unsigned long incx,
+                   float *y, const unsigned long incy)
+  {
+   if (m == 0 || n == 0 ||
+       !fits_in_int(m, n, lda) || !fits_in_int(incx, incy))
+    {
+     return false;
+    }
+   cblas_sgemv(CblasRowMajor, CblasNoTrans, int(m), int(n), 1.0f, A, int(lda),
+               x, int(incx), 0.0f, y, int(incy));
+   return true;
+  }
+
+  // ================================================================
+  /// result = x^T * y (cblas_ddot)
+  // ================================================================
+  inline bool dot(const unsigned long n,
+                  const double *x, const unsigned long incx,
+                  const double *y, const unsigned long incy,
+                  double &result)
+  {
+   if (!fits_in_int(n, incx, incy))
+    {
+     return false;
+    }
+   result = cblas_ddot(int(n), x, int(incx), y, int(incy));
+   return true;
+  }
+
+  // ================================================================
+  /// result = x^T * y (cblas_sdot)
+  // ================================================================
+  inline bool dot(const unsigned long n,
+                  const float *x, const unsigned long incx,
+                  const float *y, const unsigned long incy,
+                  float &result)
+  {
+   if (!fits_in_int(n, incx, incy))
+    {
+     return false;
+    }
+   result = cblas_sdot(int(n), x, int(incx), y, int(incy));
+   return true;
+  }
+
+  // ================================================================
+  /// result = x^T * y with float entries accumulated in double
+  /// (cblas_dsdot)
+  // ================================================================
+  inline bool dot(const unsigned long n,
+                  const float *x, const unsigned long incx,
+                  const float *y, const unsigned long incy,
+                  double &result)
+  {
+   if (!fits_in_int(n, incx, incy))
+    {
+     return false;
+    }
+   result = cblas_dsdot(int(n), x, int(incx), y, int(incy));
+   return true;
+  }
+
+  // ================================================================
+  /// result = ||x||_2 (cblas_dnrm2)
+  // ================================================================
+  inline bool nrm2(const unsigned long n, const double *x, const unsigned long incx,
+                   double &result)
+  {
+   if (!fits_in_int(n, incx))
+    {
+     return false;
+    }
+   result = cblas_dnrm2(int(n), x, int(incx));
+   return true;
+  }
+
+  // ================================================================
+  /// result = ||x||_2 (cblas_snrm2)
+  // ================================================================
+  inline bool nrm2(const unsigned long n, const float *x, const unsigned long incx,
+                   float &result)
+  {
+   if (!fits_in_int(n, incx))
+    {
+     return false;
+    }
+   result = cblas_snrm2(int(n), x, int(incx));
+   return true;
+  }
+
+  // ================================================================
+  /// y = y + alpha * x (cblas_daxpy)
+  // ================================================================
+  inline bool axpy(const unsigned long n, const double alpha,
+                   const double *x, const unsigned long incx,
+                   double *y, const unsigned long incy)
+  {
+   if (!fits_in_int(n, incx, incy))
+    {
+     return false;
+    }
+   cblas_daxpy(int(n), alpha, x, int(incx), y, int(incy));
+   return true;
+  }
+
+  // ================================================================
+  /// y = y + alpha * x (cblas_saxpy)
+  // ================================================================
+  inline bool axpy(const unsigned long n, const float alpha,
+                   const float *x, const unsigned long incx,
+                   float *y, const unsigned long incy)
+  {
+   if (!fits_in_int(n, incx, incy))
+    {
+     return false;
+    }
+   cblas_saxpy(int(n), alpha, x, int(incx), y, int(incy));
+   return true;
+  }
+
+  // ================================================================
+  /// x = alpha * x (cblas_dscal)
+  // ================================================================
+  inline bool scal(const unsigned long n, const double alpha,
+                   double *x, const unsigned long incx)
+  {
+   if (!fits_in_int(n, incx))
+    {
+     return false;
+    }
+   cblas_dscal(int(n), alpha, x, int(incx));
+   return true;
+  }
+
+  // ================================================================
+  /// x = alpha * x (cblas_sscal)
+  // ================================================================
+  inline bool scal(const unsigned long n, const float alpha,
+                   float *x, const unsigned long incx)
+  {
+   if (!fits_in_int(n, incx))
+    {
+     return false;
+    }
+   cblas_sscal(int(n), alpha, x, int(incx));
+   return true;
+  }
+
+#endif // #ifdef SCICELLXX_USES_BLAS
+
+ }
+
+}
+
+#endif // #ifndef BLAS_KERNELS_H
@@ -0,0 +1,7 @@
+// Include header and tpl.cpp files implementing templates. We may use
+// this file to force the instantiation of specific templates
+#ifndef CCBANDEDMATRIX_H
+#define CCBANDEDMATRIX_H
+#include "cc_banded_matrix.tpl.h"
+#include "cc_banded_matrix.tpl.cpp"
+#endif // #ifndef CCBANDEDMATRIX_H
@@ -0,0 +1,669 @@
+// IN THIS FILE: Implementation of a concrete class to represent
+// banded matrices
+
+#include "cc_banded_matrix.tpl.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ // Empty constructor
+ // ===================================================================
+ template<class T>
+ CCBandedMatrix<T>::CCBandedMatrix()
+  : ACMatrix<T>(), KL(0), KU(0), Band_pt(0)
+ { }
+
+ // ===================================================================
+ // Constructor to create an n X n zero matrix with kl diagonals below
+ // the main diagonal and ku diagonals above it
+ // ===================================================================
+ template<class T>
+ CCBandedMatrix<T>::CCBandedMatrix(const unsigned long n, const unsigned long kl,
+                                   const unsigned long ku)
+  : ACMatrix<T>(n, n), KL(kl), KU(ku), Band_pt(0)
+ {
+  allocate_memory(n, n, kl, ku);
+ }
+
+ // ===================================================================
+ // Constructor to create an m X n zero matrix with kl diagonals below
+ // the main diagonal and ku diagonals above it
+ // ===================================================================
+ template<class T>
+ CCBandedMatrix<T>::CCBandedMatrix(const unsigned long m, const unsigned long n,
+                                   const unsigned long kl, const unsigned long ku)
+  : ACMatrix<T>(m, n), KL(kl), KU(ku), Band_pt(0)
+ {
+  allocate_memory(m, n, kl, ku);
+ }
+
+ // ===================================================================
+ // Copy constructor
+ // ===================================================================
+ template<class T>
+ CCBandedMatrix<T>::CCBandedMatrix(const CCBandedMatrix<T> &copy)
+  : ACMatrix<T>(copy.n_rows(), copy.n_columns()), KL(copy.n_lower_diagonals()),
+    KU(copy.n_upper_diagonals()), Band_pt(0)
+ {
+  if (copy.is_own_memory_allocated())
+   {
+    allocate_memory(copy.n_rows(), copy.n_columns(),
+                    copy.n_lower_diagonals(), copy.n_upper_diagonals());
+    std::copy(copy.band_pt(), copy.band_pt() + this->NRows * band_width(), Band_pt);
+   }
+ }
+
+ // ===================================================================
+ // Move constructor
+ // ===================================================================
+ template<class T>
+ CCBandedMatrix<T>::CCBandedMatrix(CCBandedMatrix<T> &&source_matrix)
+  : ACMatrix<T>(), KL(0), KU(0), Band_pt(0)
+ {
+  // Take the memory of the source matrix
+  move_matrix(source_matrix);
+ }
+
+ // ===================================================================
+ // Destructor
+ // ===================================================================
+ template<class T>
+ CCBandedMatrix<T>::~CCBandedMatrix()
+ {
+  // Deallocate memory
+  clean_up();
+ }
+
+ // ===================================================================
+ // Assignment operator
+ // ===================================================================
+ template<class T>
+ CCBandedMatrix<T>& CCBandedMatrix<T>::operator=(const CCBandedMatrix<T> &source_matrix)
+ {
+  // Check for self-assignment
+  if (this != &source_matrix)
+   {
+    // Clean-up and set values
+    allocate_memory(source_matrix.n_rows(), source_matrix.n_columns(),
+                    source_matrix.n_lower_diagonals(),
+                    source_matrix.n_upper_diagonals());
+    std::copy(source_matrix.band_pt(),
+              source_matrix.band_pt() + this->NRows * band_width(), Band_pt);
+   }
+
+  // Return this (de-referenced pointer)
+  return *this;
+ }
+
+ // ===================================================================
+ // Move assignment operator
+ // ===================================================================
+ template<class T>
+ CCBandedMatrix<T>& CCBandedMatrix<T>::operator=(CCBandedMatrix<T> &&source_matrix)
+ {
+  // Check for self-assignment
+  if (this != &source_matrix)
+   {
+    // Clean-up and take the memory of the source matrix
+    clean_up();
+    move_matrix(source_matrix);
+   }
+
+  // Return this (de-referenced pointer)
+  return *this;
+ }
+
+ // ===================================================================
+ // Allows to create a matrix with the given size, the number of
+ // diagonals is kept
+ // ===================================================================
+ template<class T>
+ void CCBandedMatrix<T>::allocate_memory(const unsigned long m,
+                                         const unsigned long n)
+ {
+  allocate_memory(m, n, KL, KU);
+ }
+
+ // ===================================================================
+ // Allows to create a matrix with the given size and number of
+ // diagonals below (kl) and above (ku) the main diagonal
+ // ===================================================================
+ template<class T>
+ void CCBandedMatrix<T>::allocate_memory(const unsigned long m, const unsigned long n,
+                                         const unsigned long kl, const unsigned long ku)
+ {
+  // Clean any possibly stored data
+  clean_up();
+
+  // Set the size of the matrix and of the band
+  this->NRows = m;
+  this->NColumns = n;
+  KL = kl;
+  KU = ku;
+
+  // Allocate the band, all the entries are zero
+  const unsigned long n_entries = m * band_width();
+  Band_pt = MemoryAllocator::new_array<T>(n_entries);
+  std::fill(Band_pt, Band_pt + n_entries, T(0));
+
+  // Mark the matrix as allocated its own memory
+  this->Is_own_memory_allocated=true;
+ }
+
+ // ===================================================================
+ // Fills the band with zeroes
+ // ===================================================================
+ template<class T>
+ void CCBandedMatrix<T>::fill_with_zeroes()
+ {
+  // Check that the matrix has memory allocated
+  if (this->Is_own_memory_allocated)
+   {
+    std::fill(Band_pt, Band_pt + this->NRows * band_width(), T(0));
+   }
+  else
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix has no memory allocated\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+ }
+
+ // ===================================================================
+ // Transforms the input DENSE matrix to a banded matrix, the number
+ // of diagonals is the smallest one that contains all the non-zero
+ // entries
+ // ===================================================================
+ template<class T>
+ void CCBandedMatrix<T>::set_matrix(const T *matrix_pt,
+                                    const unsigned long m,
+                                    const unsigned long n)
+ {
+  // Find the band that contains the non-zero entries
+  unsigned long kl = 0;
+  unsigned long ku = 0;
+  for (unsigned long i = 0; i < m; i++)
+   {
+    for (unsigned long j = 0; j < n; j++)
+     {
+      if (matrix_pt[i*n + j] != T(0))
+       {
+        if (i > j)
+         {
+          kl = std::max(kl, i - j);
+         }
+        else
+         {
+          ku = std::max(ku, j - i);
+         }
+       }
+     }
+   }
+
+  // Allocate and copy the entries within the band
+  allocate_memory(m, n, kl, ku);
+  for (unsigned long i = 0; i < m; i++)
+   {
+    const unsigned long j_begin = i > kl ? i - kl : 0;
+    const unsigned long j_end = std::min(n, i + ku + 1);
+    for (unsigned long j = j_begin; j < j_end; j++)
+     {
+      Band_pt[i*band_width() + (j + KL - i)] = matrix_pt[i*n + j];
+     }
+   }
+ }
+
+ // ===================================================================
+ // Clean up for any dynamically stored data
+ // ===================================================================
+ template<class T>
+ void CCBandedMatrix<T>::clean_up()
+ {
+  // Check whether the Matrix allocated its own memory
+  if (this->Is_own_memory_allocated)
+   {
+    // Mark the matrix as deleteable
+    this->Delete_matrix = true;
+    // Free the memory allocated for the matrix
+    free_memory_for_matrix();
+   }
+  else // If empty
+   {
+    // Set the pointer to NULL
+    Band_pt = 0;
+   }
+
+ }
+
+ // ===================================================================
+ // Free allocated memory for matrix
+ // ===================================================================
+ template<class T>
+ void CCBandedMatrix<T>::free_memory_for_matrix()
+ {
+  // Is the matrix allowed for deletion. If this method is called from
+  // an external source we need to check whether the matrix has been
+  // marked for deletion
+  if (this->Delete_matrix)
+   {
+    MemoryAllocator::delete_array(Band_pt);
+    Band_pt = 0;
+
+    // Mark the matrix as not having allocated memory
+    this->Is_own_memory_allocated=false;
+
+   } // if (Delete_matrix)
+  else
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "You are trying to free the memory of a matrix that is\n"
+                  << "not marked as deletable" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+ }
+
+ // ===================================================================
+ // Get the specified value from the matrix (read-only), returns zero
+ // for entries out of the band
+ // ===================================================================
+ template<class T>
+ const T CCBandedMatrix<T>::value(const unsigned long i, const unsigned long j) const
+ {
+#ifdef SCICELLXX_RANGE_CHECK
+  if (i >= this->n_rows() || j >= this->n_columns())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The entry you are trying to access is out of range\n"
+                  << "Number of rows: " << this->n_rows() << std::endl
+                  << "Number of columns: " << this->n_columns() << std::endl
+                  << "Requested entry: (" << i << ", " << j << ")" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+#endif // #ifdef SCICELLXX_RANGE_CHECK
+
+  if (!is_in_band(i, j))
+   {
+    return T(0);
+   }
+  return Band_pt[i*band_width() + (j + KL - i)];
+ }
+
+ // ===================================================================
+ // Set values in the matrix (write version). Only the entries within
+ // the band can be modified
+ // ===================================================================
+ template<class T>
+ T &CCBandedMatrix<T>::value(const unsigned long i, const unsigned long j)
+ {
+#ifdef SCICELLXX_RANGE_CHECK
+  if (i >= this->n_rows() || j >= this->n_columns())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The entry you are trying to access is out of range\n"
+                  << "Number of rows: " << this->n_rows() << std::endl
+                  << "Number of columns: " << this->n_columns() << std::endl
+                  << "Requested entry: (" << i << ", " << j << ")" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+#endif // #ifdef SCICELLXX_RANGE_CHECK
+
+  if (!is_in_band(i, j))
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The entry you are trying to modify is out of the band\n"
+                  << "of the matrix\n"
+                  << "Requested entry: (" << i << ", " << j << ")\n"
+                  << "Diagonals below the main diagonal: " << KL << "\n"
+                  << "Diagonals above the main diagonal: " << KU << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  return Band_pt[i*band_width() + (j + KL - i)];
+ }
+
+ // ===================================================================
+ // Throws an error indicating that permutations are not supported
+ // ===================================================================
+ template<class T>
+ void CCBandedMatrix<T>::error_permutations_not_supported() const
+ {
+  // Error message
+  std::ostringstream error_message;
+  error_message << "Permutations of rows or columns are not supported by\n"
+                << "banded matrices, the permuted matrix is not banded in\n"
+                << "general. Copy the matrix into a dense matrix with\n"
+                << "to_dense() if you need to permute it" << std::endl;
+  throw SciCellxxLibError(error_message.str(),
+                          SCICELLXX_CURRENT_FUNCTION,
+                          SCICELLXX_EXCEPTION_LOCATION);
+ }
+
+ // ===================================================================
+ // Permute the rows in the list
+ // ===================================================================
+ template<class T>
+ void CCBandedMatrix<T>::permute_rows(std::vector<std::pair<unsigned long, unsigned long> > &permute_list)
+ {
+  error_permutations_not_supported();
+ }
+
+ // ===================================================================
+ // Permute the columns in the list
+ // ===================================================================
+ template<class T>
+ void CCBandedMatrix<T>::permute_columns(std::vector<std::pair<unsigned long, unsigned long> > &permute_list)
+ {
+  error_permutations_not_supported();
+ }
+
+ // ===================================================================
+ // Permute rows i and j
+ // ===================================================================
+ template<class T>
+ void CCBandedMatrix<T>::permute_rows(const unsigned long &i, const unsigned long &j)
+ {
+  error_permutations_not_supported();
+ }
+
+ // ===================================================================
+ // Permute columns i and j
+ // ===================================================================
+ template<class T>
+ void CCBandedMatrix<T>::permute_columns(const unsigned long &i, const unsigned long &j)
+ {
+  error_permutations_not_supported();
+ }
+
+ // ===================================================================
+ // Takes the memory of the source matrix
+ // ===================================================================
+ template<class T>
+ void CCBandedMatrix<T>::move_matrix(CCBandedMatrix<T> &source_matrix)
+ {
+  this->NRows = source_matrix.NRows;
+  this->NColumns = source_matrix.NColumns;
+  KL = source_matrix.KL;
+  KU = source_matrix.KU;
+  if (source_matrix.is_own_memory_allocated())
+   {
+    if (source_matrix.delete_matrix())
+     {
+      // Transfer ownership
+      Band_pt = source_matrix.Band_pt;
+      this->Is_own_memory_allocated = true;
+
+      // Leave the source matrix with no memory
+      source_matrix.Band_pt = 0;
+      source_matrix.Is_own_memory_allocated = false;
+     }
+    else
+     {
+      // The memory of the source matrix is managed somewhere else,
+      // copy the entries
+      allocate_memory(source_matrix.n_rows(), source_matrix.n_columns(),
+                      source_matrix.n_lower_diagonals(),
+                      source_matrix.n_upper_diagonals());
+      std::copy(source_matrix.band_pt(),
+                source_matrix.band_pt() + this->NRows * band_width(), Band_pt);
+     }
+   }
+
+ }
+
+ // ===================================================================
+ // Output the matrix
+ // ===================================================================
+ template<class T>
+ void CCBandedMatrix<T>::output(bool output_indexes) const
+ {
+  if (!this->Is_own_memory_allocated)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix has no memory allocated. It is empty" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  else
+   {
+    // Check whether we should output the indexes (only the entries
+    // within the band are output)
+    if (output_indexes)
+     {
+      for (unsigned long i = 0; i < this->NRows; i++)
+       {
+        const unsigned long j_begin = i > KL ? i - KL : 0;
+        const unsigned long j_end = std::min(this->NColumns, i + KU + 1);
+        for (unsigned long j = j_begin; j < j_end; j++)
+         {
+          std::cout << "(" << i << ", " << j << "): "
+                    << value(i, j)
+                    << std::endl;
+         } // for (j < j_end)
+       } // for (i < this->NRows)
+     } // if (output_indexes)
+    else
+     {
+      for (unsigned long i = 0; i < this->NRows; i++)
+       {
+        for (unsigned long j = 0; j < this->NColumns; j++)
+         {
+          std::cout << value(i,j) << " ";
+         } // for (j < this->NColumns)
+        std::cout << std::endl;
+       } // for (i < this->NRows)
+     } // else if (output_indexes)
+
+   }
+
+ }
+
+ // ===================================================================
+ // Output the matrix
+ // ===================================================================
+ template<class T>
+ void CCBandedMatrix<T>::output(std::ofstream &outfile,
+                                bool output_indexes) const
+ {
+  if (!this->Is_own_memory_allocated)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix has no memory allocated. It is empty" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  else
+   {
+    // Check whether we should output the indexes (only the entries
+    // within the band are output)
+    if (output_indexes)
+     {
+      for (unsigned long i = 0; i < this->NRows; i++)
+       {
+        const unsigned long j_begin = i > KL ? i - KL : 0;
+        const unsigned long j_end = std::min(this->NColumns, i + KU + 1);
+        for (unsigned long j = j_begin; j < j_end; j++)
+         {
+          outfile << "(" << i << ", " << j << "): "
+                  << value(i, j)
+                  << std::endl;
+         } // for (j < j_end)
+       } // for (i < this->NRows)
+     } // if (output_indexes)
+    else
+     {
+      for (unsigned long i = 0; i < this->NRows; i++)
+       {
+        for (unsigned long j = 0; j < this->NColumns; j++)
+         {
+          outfile << value(i,j) << " ";
+         } // for (j < this->NColumns)
+        outfile << std::endl;
+       } // for (i < this->NRows)
+     } // else if (output_indexes)
+
+   }
+
+ }
+
+ // ===================================================================
+ // Copy the matrix into a dense matrix
+ // ===================================================================
+ template<class T>
+ void CCBandedMatrix<T>::to_dense(CCMatrix<T> &dense_matrix) const
+ {
+  const unsigned long n_rows = this->NRows;
+  const unsigned long n_columns = this->NColumns;
+  dense_matrix.allocate_memory(n_rows, n_columns);
+  dense_matrix.fill_with_zeroes();
+  // The dense matrix may be stored by rows or by columns
+  const CCMatrixSpan<T> dense = dense_matrix.span();
+  for (unsigned long i = 0; i < n_rows; i++)
+   {
+    const unsigned long j_begin = i > KL ? i - KL : 0;
+    const unsigned long j_end = std::min(n_columns, i + KU + 1);
+    for (unsigned long j = j_begin; j < j_end; j++)
+     {
+      dense(i, j) = Band_pt[i*band_width() + (j + KL - i)];
+     }
+   }
+ }
+
+ // ================================================================
+ // Multiply banded matrix times vector
+ // ================================================================
+ template<class T>
+ void multiply_matrix_times_vector(const CCBandedMatrix<T> &matrix,
+                                   const CCVector<T> &vector,
+                                   CCVector<T> &solution_vector)
+ {
+  // Check that the matrix and the vector have memory allocated
+  if (!matrix.is_own_memory_allocated() || !vector.is_own_memory_allocated())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "Either the matrix or the vector have no memory allocated\n"
+                  << "matrix.is_own_memory_allocated() = "
+                  << matrix.is_own_memory_allocated() << "\n"
+                  << "vector.is_own_memory_allocated() = "
+                  << vector.is_own_memory_allocated() << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check whether the vector is a column vector
+  if (!vector.is_column_vector())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The vector to multiply the matrix is not a column vector\n"
+                  << "vector.is_column_vector(): " << vector.is_column_vector()
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check that the dimension of the vector and the matrix allow the
+  // operation
+  const unsigned long n_rows_matrix = matrix.n_rows();
+  const unsigned long n_columns_matrix = matrix.n_columns();
+  const unsigned long n_rows_vector = vector.n_values();
+  if (n_columns_matrix != n_rows_vector)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The dimension of the matrix and the vector does\n"
+                  << "not allow multiplication:\n"
+                  << "dim(matrix) = (" << n_rows_matrix << ", "
+                  << n_columns_matrix << ")\n"
+                  << "dim(vector) = (" << n_rows_vector << ", 1)\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check whether the solution vector is a column vector
+  if (!solution_vector.is_column_vector())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The solution vector is not a column vector\n"
+                  << "solution_vector.is_column_vector(): "
+                  << solution_vector.is_column_vector()
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check whether the solution vector has allocated memory, otherwise
+  // allocate it here!!!
+  if (!solution_vector.is_own_memory_allocated())
+   {
+    solution_vector.allocate_memory(n_rows_matrix);
+   }
+  else if (solution_vector.n_values() != n_rows_matrix)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The dimension of the solution vector is not appropiate for\n"
+                  << "the operation:\n"
+                  << "dim(matrix) = (" << n_rows_matrix << ", "
+                  << n_columns_matrix << ")\n"
+                  << "dim(solution_vector) = (" << solution_vector.n_values()
+                  << ", 1)\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Get the band and both the vector and the solution pointers
+  const unsigned long kl = matrix.n_lower_diagonals();
+  const unsigned long ku = matrix.n_upper_diagonals();
+  const unsigned long width = matrix.band_width();
+  const T *band_pt = matrix.band_pt();
+  const T *vector_pt = vector.vector_pt();
+  T *solution_vector_pt = solution_vector.vector_pt();
+
+  // Perform the multiplication (only the entries within the band are
+  // visited), each row is accumulated in double for float entries
+  typedef typename AccumulatorTraits<T>::Accumulator_type A;
+  for (unsigned long i = 0; i < n_rows_matrix; i++)
+   {
+    const unsigned long j_begin = i > kl ? i - kl : 0;
+    const unsigned long j_end = std::min(n_columns_matrix, i + ku + 1);
+    const T *row_pt = band_pt + i*width + kl - i;
+    A sum = 0;
+    for (unsigned long j = j_begin; j < j_end; j++)
+     {
+      sum+= A(row_pt[j]) * A(vector_pt[j]);
+     }
+    solution_vector_pt[i] = T(sum);
+   }
+
+ }
+
+}
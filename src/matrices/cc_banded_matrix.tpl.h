@@ -0,0 +1,171 @@
+// IN THIS FILE: The definition of a concrete class to store and work
+// with banded matrices. Only the entries within the band (KL diagonals
+// below the main diagonal and KU diagonals above it) are stored, thus
+// the memory is O(n * (KL + KU + 1)) instead of O(n^2)
+
+// Check whether the class has been already defined
+#ifndef CCBANDEDMATRIX_TPL_H
+#define CCBANDEDMATRIX_TPL_H
+
+// The parent class
+#include "ac_matrix.h"
+// We include the cc_vector and cc_matrix classes to deal with
+// banded-dense operations
+#include "cc_vector.h"
+#include "cc_matrix.h"
+// The allocator for the entries of the band
+#include "../general/memory_allocator.h"
+// The type used to accumulate the products of matrix times vector
+#include "accumulator_traits.h"
+
+namespace scicellxx
+{
+
+ /// @class CCBandedMatrix cc_banded_matrix.h
+
+ // Concrete class to represent banded matrices. The band is stored by
+ // rows, each row stores KL + KU + 1 entries (the width of the band)
+ // such that the (i, j) entry, with i - KL <= j <= i + KU, is stored
+ // at Band_pt[i * (KL + KU + 1) + (j - i + KL)]. The positions of the
+ // first and last rows that fall out of the matrix are stored but
+ // never used. A tridiagonal matrix has KL = KU = 1
+ template<class T>
+ class CCBandedMatrix : public virtual ACMatrix<T>
+ {
+
+ public:
+
+  // Empty constructor
+  CCBandedMatrix();
+
+  // Constructor to create an n X n zero matrix with kl diagonals below
+  // the main diagonal and ku diagonals above it
+  CCBandedMatrix(const unsigned long n, const unsigned long kl,
+                 const unsigned long ku);
+
+  // Constructor to create an m X n zero matrix with kl diagonals below
+  // the main diagonal and ku diagonals above it
+  CCBandedMatrix(const unsigned long m, const unsigned long n,
+                 const unsigned long kl, const unsigned long ku);
+
+  // Copy constructor
+  CCBandedMatrix(const CCBandedMatrix &copy);
+
+  // Move constructor, the source matrix is left empty
+  CCBandedMatrix(CCBandedMatrix &&source_matrix);
+
+  // Destructor
+  virtual ~CCBandedMatrix();
+
+  // Assignment operator
+  CCBandedMatrix &operator=(const CCBandedMatrix &source_matrix);
+
+  // Move assignment operator, the source matrix is left empty
+  CCBandedMatrix &operator=(CCBandedMatrix &&source_matrix);
+
+  // Allows to create a matrix with the given size, the number of
+  // diagonals is kept
+  void allocate_memory(const unsigned long m,
+                       const unsigned long n);
+
+  // Allows to create a matrix with the given size and number of
+  // diagonals below (kl) and above (ku) the main diagonal
+  void allocate_memory(const unsigned long m, const unsigned long n,
+                       const unsigned long kl, const unsigned long ku);
+
+  // Fills the band with zeroes
+  void fill_with_zeroes();
+
+  // Transforms the input DENSE matrix to a banded matrix, the number
+  // of diagonals is the smallest one that contains all the non-zero
+  // entries
+  void set_matrix(const T *matrix_pt,
+                  const unsigned long m,
+                  const unsigned long n);
+
+  // Clean up for any dynamically stored data
+  void clean_up();
+
+  // Free allocated memory for matrix
+  void free_memory_for_matrix();
+
+  // Get the specified value from the matrix (read-only), returns zero
+  // for entries out of the band
+  const T value(const unsigned long i, const unsigned long j) const;
+
+  // Set values in the matrix (write version). Only the entries within
+  // the band can be modified
+  T &value(const unsigned long i, const unsigned long j);
+
+  /// Permute the rows in the list (not supported, the band is not
+  /// kept by general permutations)
+  void permute_rows(std::vector<std::pair<unsigned long, unsigned long> > &permute_list);
+
+  /// Permute the columns in the list (not supported)
+  void permute_columns(std::vector<std::pair<unsigned long, unsigned long> > &permute_list);
+
+  /// Permute rows i and j (not supported)
+  void permute_rows(const unsigned long &i, const unsigned long &j);
+
+  /// Permute columns i and j (not supported)
+  void permute_columns(const unsigned long &i, const unsigned long &j);
+
+  // Output the matrix
+  void output(bool output_indexes = false) const;
+
+  // Output to file
+  void output(std::ofstream &outfile, bool output_indexes = false) const;
+
+  // Copy the matrix into a dense matrix
+  void to_dense(CCMatrix<T> &dense_matrix) const;
+
+  // Is the (i, j) entry within the band
+  inline bool is_in_band(const unsigned long i, const unsigned long j) const
+  {return j + KL >= i && j <= i + KU;}
+
+  // The number of diagonals below the main diagonal
+  inline unsigned long n_lower_diagonals() const {return KL;}
+
+  // The number of diagonals above the main diagonal
+  inline unsigned long n_upper_diagonals() const {return KU;}
+
+  // The number of entries stored per row (KL + KU + 1)
+  inline unsigned long band_width() const {return KL + KU + 1;}
+
+  // Get access to the Band_pt
+  inline T *band_pt() const {return Band_pt;}
+
+ protected:
+
+  // Throws an error indicating that permutations are not supported
+  void error_permutations_not_supported() const;
+
+  // Takes the memory of the source matrix (used by the move
+  // constructor and the move assignment operator)
+  void move_matrix(CCBandedMatrix &source_matrix);
+
+  // The number of diagonals below the main diagonal
+  unsigned long KL;
+
+  // The number of diagonals above the main diagonal
+  unsigned long KU;
+
+  // The entries of the band, stored by rows (size NRows * (KL + KU +
+  // 1))
+  T *Band_pt;
+
+ };
+
+ // ================================================================
+ // Extra methods to work with banded matrices and vectors
+ // ================================================================
+
+ // Multiply banded matrix times vector, O(n * (KL + KU + 1))
+ template<class T>
+  void multiply_matrix_times_vector(const CCBandedMatrix<T> &matrix,
+                                    const CCVector<T> &vector,
+                                    CCVector<T> &solution_vector);
+
+}
+
+#endif // #ifndef CCBANDEDMATRIX_TPL_H
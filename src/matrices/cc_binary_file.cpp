@@ -0,0 +1,203 @@
+// IN THIS FILE: Implementation of the non-template methods of the
+// class to read and write binary files with dense matrices and
+// vectors
+
+#include "cc_binary_file.h"
+
+// Map files into memory (POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+
+namespace scicellxx
+{
+
+ // The static constants (odr-used by the header checks)
+ const uint32_t CCBinaryFile::Version;
+ const uint64_t CCBinaryFile::Header_size;
+
+ // ===================================================================
+ // Constructor, maps the file into memory and checks its header
+ // ===================================================================
+ CCBinaryFile::CCBinaryFile(const std::string &filename)
+  : Filename(filename), Data_pt(0), File_size(0)
+ {
+  const int file_descriptor = open(filename.c_str(), O_RDONLY);
+  if (file_descriptor < 0)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The file could not be opened\n"
+                  << "File: " << filename << "\n"
+                  << "Error: " << std::strerror(errno) << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  struct stat file_status;
+  if (fstat(file_descriptor, &file_status) != 0 ||
+      uint64_t(file_status.st_size) < Header_size)
+   {
+    close(file_descriptor);
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The file is too small to store the header of the\n"
+                  << "binary format of matrices and vectors\n"
+                  << "File: " << filename << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  File_size = file_status.st_size;
+
+  // Private mapping, the pages are copied only if they are modified
+  // (the file is never modified)
+  void *mapped_pt = mmap(0, File_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                         file_descriptor, 0);
+  // The mapping is kept after closing the file
+  close(file_descriptor);
+  if (mapped_pt == MAP_FAILED)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The file could not be mapped into memory\n"
+                  << "File: " << filename << "\n"
+                  << "Error: " << std::strerror(errno) << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  Data_pt = static_cast<char*>(mapped_pt);
+
+  try
+   {
+    check_header();
+   }
+  catch (...)
+   {
+    munmap(Data_pt, File_size);
+    Data_pt = 0;
+    throw;
+   }
+
+ }
+
+ // ===================================================================
+ // Destructor, unmaps the file
+ // ===================================================================
+ CCBinaryFile::~CCBinaryFile()
+ {
+  if (Data_pt != 0)
+   {
+    munmap(Data_pt, File_size);
+    Data_pt = 0;
+   }
+ }
+
+ // ===================================================================
+ // Checks the entries of the header against the size of the file
+ // ===================================================================
+ void CCBinaryFile::check_header() const
+ {
+  const Header &h = header();
+
+  // The number of bytes of the entries, rows * columns * entry size,
+  // must fit in 64 bits (otherwise a huge matrix would pass the check
+  // of the size of the file and be read out of the mapping)
+  const uint64_t max_size = std::numeric_limits<uint64_t>::max();
+  const bool sizes_overflow =
+   (h.N_columns != 0 && h.N_rows > max_size / h.N_columns) ||
+   (h.Entry_size != 0 && h.N_rows * h.N_columns > max_size / h.Entry_size);
+
+  std::ostringstream error_message;
+  if (std::memcmp(h.Magic, "SCXXBIN", 8) != 0)
+   {
+    error_message << "The file does not store a matrix or a vector in the\n"
+                  << "binary format of the library (wrong magic number)\n";
+   }
+  else if (h.Version != Version)
+   {
+    error_message << "The version of the format of the file is not supported\n"
+                  << "Version of the file: " << h.Version << "\n"
+                  << "Supported version: " << Version << "\n";
+   }
+  else if (h.Endianness != 0x01020304)
+   {
+    error_message << "The file was written by a machine with different\n"
+                  << "endianness\n";
+   }
+  else if (h.Object != VECTOR && h.Object != MATRIX)
+   {
+    error_message << "The object stored in the file is not known\n"
+                  << "Object: " << h.Object << "\n";
+   }
+  else if (h.Entry_size == 0 || sizes_overflow ||
+           h.Data_size != h.N_rows * h.N_columns * h.Entry_size ||
+           h.Data_offset < Header_size || h.Data_offset % Header_size != 0 ||
+           h.Data_offset > File_size || h.Data_size > File_size - h.Data_offset)
+   {
+    error_message << "The sizes in the header do not agree with the size of\n"
+                  << "the file\n"
+                  << "Rows: " << h.N_rows << " Columns: " << h.N_columns
+                  << " Entry size: " << h.Entry_size << "\n"
+                  << "Data offset: " << h.Data_offset
+                  << " Data size: " << h.Data_size << "\n"
+                  << "File size: " << File_size << "\n";
+   }
+  else
+   {
+    return;
+   }
+
+  error_message << "File: " << Filename << std::endl;
+  throw SciCellxxLibError(error_message.str(),
+                          SCICELLXX_CURRENT_FUNCTION,
+                          SCICELLXX_EXCEPTION_LOCATION);
+ }
+
+ // ===================================================================
+ // Writes the header and the entries
+ // ===================================================================
+ void CCBinaryFile::write_file(const std::string &filename, const Header &header,
+                               const std::vector<std::pair<const char*, uint64_t> > &blocks)
+ {
+  std::ofstream output_file(filename.c_str(), std::ios_base::out | std::ios_base::binary);
+  if (!output_file.is_open())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The file could not be created\n"
+                  << "File: " << filename << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Header padded with zeros up to the start of the entries
+  char padded_header[Header_size];
+  std::memset(padded_header, 0, Header_size);
+  std::memcpy(padded_header, &header, sizeof(Header));
+  output_file.write(padded_header, Header_size);
+
+  for (unsigned i = 0; i < blocks.size(); i++)
+   {
+    output_file.write(blocks[i].first, blocks[i].second);
+   }
+
+  output_file.close();
+  if (output_file.fail())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The file could not be written\n"
+                  << "File: " << filename << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+ }
+
+}
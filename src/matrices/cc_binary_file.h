@@ -0,0 +1,332 @@
+// IN THIS FILE: A versioned binary format to store dense matrices and
+// vectors on disk, and the class to read it by mapping the file into
+// memory. The file has a header of 64 bytes followed by the raw
+// entries in the order in which they are stored in memory
+//
+// offset  size  content
+//      0     8  magic number "SCXXBIN\0"
+//      8     4  version of the format (Version)
+//     12     4  endianness mark (0x01020304 written by the host)
+//     16     4  object (0 vector, 1 matrix)
+//     20     4  kind of the entries (0 floating point, 1 signed
+//               integer, 2 unsigned integer)
+//     24     4  size in bytes of each entry
+//     28     4  flags (bit 0: matrix stored by columns, or column
+//               vector)
+//     32     8  number of rows (number of entries of a vector)
+//     40     8  number of columns (1 for a vector)
+//     48     8  offset of the entries from the start of the file
+//     56     8  size in bytes of the entries
+//
+// The entries start at a 64 bytes boundary. Reading a file maps it
+// into memory (copy-on-write) and makes a CCMatrix or CCVector use
+// the mapped pages directly, thus loading a large matrix only reads
+// the pages that are accessed and does not copy them. Modifying the
+// entries does not modify the file
+
+// Check whether the class has been already defined
+#ifndef CCBINARYFILE_H
+#define CCBINARYFILE_H
+
+#include "../general/common_includes.h"
+#include "../general/utilities.h"
+
+#include <cstdint>
+
+// The matrices and vectors stored and read
+#include "ac_matrix.h"
+#include "ac_vector.h"
+#include "cc_matrix.h"
+#include "cc_vector.h"
+
+namespace scicellxx
+{
+
+ /// @class CCBinaryFile cc_binary_file.h
+
+ /// Concrete class to read (by mapping into memory) files with a dense
+ /// matrix or vector, and to write them. The matrices and vectors
+ /// read from the file use the mapped memory, thus they must not be
+ /// used after the file object is destroyed
+ class CCBinaryFile
+ {
+
+ public:
+
+  /// The version of the format written by this class
+  static const uint32_t Version = 1;
+
+  /// The size of the header, the entries start after it
+  static const uint64_t Header_size = 64;
+
+  /// The header of the file
+  struct Header
+  {
+   char Magic[8];
+   uint32_t Version;
+   uint32_t Endianness;
+   uint32_t Object;
+   uint32_t Entry_kind;
+   uint32_t Entry_size;
+   uint32_t Flags;
+   uint64_t N_rows;
+   uint64_t N_columns;
+   uint64_t Data_offset;
+   uint64_t Data_size;
+  };
+
+  /// The objects that may be stored
+  enum Object_type {VECTOR = 0, MATRIX = 1};
+
+  /// Constructor, maps the file into memory and checks its header
+  CCBinaryFile(const std::string &filename);
+
+  /// Destructor, unmaps the file
+  virtual ~CCBinaryFile();
+
+  /// The header of the file
+  inline const Header &header() const {return *(reinterpret_cast<const Header*>(Data_pt));}
+
+  /// Is a matrix stored in the file
+  inline bool is_matrix() const {return header().Object == MATRIX;}
+
+  /// Is a vector stored in the file
+  inline bool is_vector() const {return header().Object == VECTOR;}
+
+  /// Number of rows of the matrix (number of entries of the vector)
+  inline unsigned long n_rows() const {return header().N_rows;}
+
+  /// Number of columns of the matrix (1 for vectors)
+  inline unsigned long n_columns() const {return header().N_columns;}
+
+  /// Are the entries of the matrix stored by columns (is the vector a
+  /// column vector)
+  inline bool is_column_major() const {return (header().Flags & 1) != 0;}
+
+  /// Makes the matrix use the entries of the file (no copies). The
+  /// file must store a matrix with entries of type T
+  template<class T>
+   void map(CCMatrix<T> &matrix);
+
+  /// Makes the vector use the entries of the file (no copies). The
+  /// file must store a vector with entries of type T
+  template<class T>
+   void map(CCVector<T> &vector);
+
+  /// Writes the matrix to a file, the entries are written in the
+  /// order in which they are stored (by rows or by columns), matrices
+  /// whose entries are not stored in a single block are written by
+  /// rows
+  template<class T>
+   static void write(const std::string &filename, const ACMatrix<T> &matrix);
+
+  /// Writes the vector to a file
+  template<class T>
+   static void write(const std::string &filename, const ACVector<T> &vector);
+
+ protected:
+
+  /// Fills the header for the given object with entries of type T
+  template<class T>
+   static void fill_header(Header &header, const Object_type object,
+                           const unsigned long n_rows,
+                           const unsigned long n_columns,
+                           const bool column_major);
+
+  /// Checks that the file stores the given object with entries of
+  /// type T
+  template<class T>
+   void check_contents(const Object_type object) const;
+
+  /// Checks the entries of the header against the size of the file
+  void check_header() const;
+
+  /// Writes the header and the entries (given as blocks of bytes
+  /// which are written one after the other)
+  static void write_file(const std::string &filename, const Header &header,
+                         const std::vector<std::pair<const char*, uint64_t> > &blocks);
+
+  /// The kind of the entries (floating point, signed or unsigned
+  /// integer)
+  template<class T>
+   static inline uint32_t entry_kind()
+   {
+    return !std::numeric_limits<T>::is_integer ? 0 : (std::numeric_limits<T>::is_signed ? 1 : 2);
+   }
+
+  /// The name of the file
+  std::string Filename;
+
+  /// The start of the mapped file
+  char *Data_pt;
+
+  /// The size of the mapped file
+  uint64_t File_size;
+
+ private:
+
+  /// Copy constructor (we do not want this class to be copiable, the
+  /// mapping is released by the destructor)
+  CCBinaryFile(const CCBinaryFile &copy)
+   {
+    BrokenCopy::broken_copy("CCBinaryFile");
+   }
+
+  /// Assignment operator (we do not want this class to be copiable)
+  void operator=(const CCBinaryFile &copy)
+   {
+    BrokenCopy::broken_assign("CCBinaryFile");
+   }
+
+ };
+
+ // ===================================================================
+ // Makes the matrix use the entries of the file (no copies)
+ // ===================================================================
+ template<class T>
+  void CCBinaryFile::map(CCMatrix<T> &matrix)
+  {
+   check_contents<T>(MATRIX);
+   const Header &h = header();
+   matrix.share_matrix(reinterpret_cast<T*>(Data_pt + h.Data_offset),
+                       h.N_rows, h.N_columns, is_column_major());
+  }
+
+ // ===================================================================
+ // Makes the vector use the entries of the file (no copies)
+ // ===================================================================
+ template<class T>
+  void CCBinaryFile::map(CCVector<T> &vector)
+  {
+   check_contents<T>(VECTOR);
+   const Header &h = header();
+   vector.share_vector(reinterpret_cast<T*>(Data_pt + h.Data_offset),
+                       h.N_rows, is_column_major());
+  }
+
+ // ===================================================================
+ // Writes the matrix to a file
+ // ===================================================================
+ template<class T>
+  void CCBinaryFile::write(const std::string &filename, const ACMatrix<T> &matrix)
+  {
+   const unsigned long n_rows = matrix.n_rows();
+   const unsigned long n_columns = matrix.n_columns();
+   const CCMatrixSpan<T> A = matrix.span();
+   const bool contiguous = !A.is_empty() && A.is_contiguous();
+   const bool column_major = contiguous && !A.is_row_major();
+
+   Header header;
+   fill_header<T>(header, MATRIX, n_rows, n_columns, column_major);
+
+   std::vector<std::pair<const char*, uint64_t> > blocks;
+   std::vector<T> entries;
+   if (contiguous)
+    {
+     blocks.push_back(std::make_pair(reinterpret_cast<const char*>(A.Data_pt),
+                                     header.Data_size));
+    }
+   else
+    {
+     // Gather the entries by rows
+     entries.resize(n_rows * n_columns);
+     for (unsigned long i = 0; i < n_rows; i++)
+      {
+       for (unsigned long j = 0; j < n_columns; j++)
+        {
+         entries[i*n_columns + j] = A.is_empty() ? matrix.value(i, j) : A(i, j);
+        }
+      }
+     blocks.push_back(std::make_pair(reinterpret_cast<const char*>(entries.data()),
+                                     header.Data_size));
+    }
+
+   write_file(filename, header, blocks);
+  }
+
+ // ===================================================================
+ // Writes the vector to a file
+ // ===================================================================
+ template<class T>
+  void CCBinaryFile::write(const std::string &filename, const ACVector<T> &vector)
+  {
+   const unsigned long n_values = vector.n_values();
+   const CCVectorSpan<T> x = vector.span();
+
+   Header header;
+   fill_header<T>(header, VECTOR, n_values, 1, vector.is_column_vector());
+
+   std::vector<std::pair<const char*, uint64_t> > blocks;
+   std::vector<T> entries;
+   if (!x.is_empty() && (x.Stride == 1 || n_values <= 1))
+    {
+     blocks.push_back(std::make_pair(reinterpret_cast<const char*>(x.Data_pt),
+                                     header.Data_size));
+    }
+   else
+    {
+     entries.resize(n_values);
+     for (unsigned long i = 0; i < n_values; i++)
+      {
+       entries[i] = x.is_empty() ? vector.value(i) : x[i];
+      }
+     blocks.push_back(std::make_pair(reinterpret_cast<const char*>(entries.data()),
+                                     header.Data_size));
+    }
+
+   write_file(filename, header, blocks);
+  }
+
+ // ===================================================================
+ // Fills the header for the given object with entries of type T
+ // ===================================================================
+ template<class T>
+  void CCBinaryFile::fill_header(Header &header, const Object_type object,
+                                 const unsigned long n_rows,
+                                 const unsigned long n_columns,
+                                 const bool column_major)
+  {
+   std::memset(&header, 0, sizeof(Header));
+   std::memcpy(header.Magic, "SCXXBIN", 8);
+   header.Version = Version;
+   header.Endianness = 0x01020304;
+   header.Object = object;
+   header.Entry_kind = entry_kind<T>();
+   header.Entry_size = sizeof(T);
+   header.Flags = column_major ? 1 : 0;
+   header.N_rows = n_rows;
+   header.N_columns = n_columns;
+   header.Data_offset = Header_size;
+   header.Data_size = uint64_t(n_rows) * uint64_t(n_columns) * sizeof(T);
+  }
+
+ // ===================================================================
+ // Checks that the file stores the given object with entries of type
+ // T
+ // ===================================================================
+ template<class T>
+  void CCBinaryFile::check_contents(const Object_type object) const
+  {
+   const Header &h = header();
+   if (h.Object != uint32_t(object) || h.Entry_kind != entry_kind<T>() ||
+       h.Entry_size != sizeof(T))
+    {
+     // Error message
+     std::ostringstream error_message;
+     error_message << "The contents of the file are not the requested ones\n"
+                   << "File: " << Filename << "\n"
+                   << "Stored object: " << (h.Object == MATRIX ? "matrix" : "vector")
+                   << " with entries of kind " << h.Entry_kind
+                   << " and size " << h.Entry_size << "\n"
+                   << "Requested object: " << (object == MATRIX ? "matrix" : "vector")
+                   << " with entries of kind " << entry_kind<T>()
+                   << " and size " << sizeof(T) << std::endl;
+     throw SciCellxxLibError(error_message.str(),
+                             SCICELLXX_CURRENT_FUNCTION,
+                             SCICELLXX_EXCEPTION_LOCATION);
+    }
+  }
+
+}
+
+#endif // #ifndef CCBINARYFILE_H
@@ -0,0 +1,415 @@
+// IN THIS FILE: Expression templates for the element-wise arithmetic
+// (+, - and scalar *) of CCVector and CCMatrix. The operators do not
+// compute anything, they build a light-weight object that describes
+// the operation. The expression is evaluated entry by entry in a
+// single loop when it is assigned to a CCVector or a CCMatrix, thus
+// an expression such as u + h*k (or a + b - c) creates no temporary
+// vectors or matrices.
+//
+// Expressions store references to the vectors and matrices they
+// operate with, do not keep them (e.g. by means of auto) after the
+// operands go out of scope
+
+// Check whether the class has been already defined
+#ifndef CCEXPRESSIONS_H
+#define CCEXPRESSIONS_H
+
+#include "../general/common_includes.h"
+#include "../general/utilities.h"
+
+namespace scicellxx
+{
+
+ // Forward declaration of the classes that are the leaves of the
+ // expressions
+ template<class T>
+  class CCVector;
+
+ template<class T>
+  class CCMatrix;
+
+ // ==================================================================
+ // Helper to prevent the deduction of the scalar type in the scalar
+ // times expression operators, thus 2*v works for a CCVector<double>
+ // ==================================================================
+ template<class T>
+  struct CCExpressionScalar
+  {
+   typedef T type;
+  };
+
+ // ==================================================================
+ // Defines how the operands are stored in the nodes of an
+ // expression. Nodes are small and are stored by value (they are
+ // temporaries), vectors and matrices are stored by reference
+ // ==================================================================
+ template<class E>
+  struct CCExpressionOperand
+  {
+   typedef const E type;
+  };
+
+ template<class T>
+  struct CCExpressionOperand<CCVector<T> >
+  {
+   typedef const CCVector<T> &type;
+  };
+
+ template<class T>
+  struct CCExpressionOperand<CCMatrix<T> >
+  {
+   typedef const CCMatrix<T> &type;
+  };
+
+ // ==================================================================
+ // Element-wise operations used in the nodes of the expressions
+ // ==================================================================
+ struct CCExpressionAdd
+ {
+  template<class T>
+   static inline T apply(const T &left, const T &right)
+  {return left + right;}
+ };
+
+ struct CCExpressionSubstract
+ {
+  template<class T>
+   static inline T apply(const T &left, const T &right)
+  {return left - right;}
+ };
+
+ // ==================================================================
+ // ==================================================================
+ // Vector expressions
+ // ==================================================================
+ // ==================================================================
+
+ // ==================================================================
+ // Base class of all the vector expressions (including CCVector). The
+ // derived class E provides the methods entry(i), n_values() and
+ // is_column_vector()
+ // ==================================================================
+ template<class T, class E>
+  class CCVectorExpression
+  {
+
+  public:
+
+   // Get the derived expression
+   inline const E &expression() const
+   {return static_cast<const E&>(*this);}
+
+  };
+
+ // ==================================================================
+ // Element-wise binary operation of two vector expressions
+ // ==================================================================
+ template<class T, class L, class R, class OP>
+  class CCVectorBinaryExpression :
+  public CCVectorExpression<T, CCVectorBinaryExpression<T, L, R, OP> >
+  {
+
+  public:
+
+   // Constructor, checks that the operands have the same dimension
+   CCVectorBinaryExpression(const L &left, const R &right)
+    : Left(left), Right(right)
+    {
+     if (Left.n_values() != Right.n_values() ||
+         Left.is_column_vector() != Right.is_column_vector())
+      {
+       // Error message
+       std::ostringstream error_message;
+       error_message << "The dimension of the vectors is not the same or\n"
+                     << "one is a column vector and the other a row vector:\n"
+                     << "dim(left_vector) = (" << Left.n_values() << ")\n"
+                     << "dim(right_vector) = (" << Right.n_values() << ")\n"
+                     << "left_vector.is_column_vector() = "
+                     << Left.is_column_vector() << "\n"
+                     << "right_vector.is_column_vector() = "
+                     << Right.is_column_vector() << std::endl;
+       throw SciCellxxLibError(error_message.str(),
+                               SCICELLXX_CURRENT_FUNCTION,
+                               SCICELLXX_EXCEPTION_LOCATION);
+      }
+    }
+
+   // The i-th entry of the expression
+   inline T entry(const unsigned long i) const
+   {return OP::apply(Left.entry(i), Right.entry(i));}
+
+   // The number of entries of the expression
+   inline unsigned long n_values() const {return Left.n_values();}
+
+   // Is the result a column vector
+   inline bool is_column_vector() const {return Left.is_column_vector();}
+
+  private:
+
+   // The operands
+   typename CCExpressionOperand<L>::type Left;
+   typename CCExpressionOperand<R>::type Right;
+
+  };
+
+ // ==================================================================
+ // A vector expression times a scalar
+ // ==================================================================
+ template<class T, class E>
+  class CCVectorScaledExpression :
+  public CCVectorExpression<T, CCVectorScaledExpression<T, E> >
+  {
+
+  public:
+
+   // Constructor
+   CCVectorScaledExpression(const T scalar, const E &operand)
+    : Scalar(scalar), Operand(operand)
+    { }
+
+   // The i-th entry of the expression
+   inline T entry(const unsigned long i) const
+   {return Scalar * Operand.entry(i);}
+
+   // The number of entries of the expression
+   inline unsigned long n_values() const {return Operand.n_values();}
+
+   // Is the result a column vector
+   inline bool is_column_vector() const {return Operand.is_column_vector();}
+
+  private:
+
+   // The scalar
+   const T Scalar;
+
+   // The operand
+   typename CCExpressionOperand<E>::type Operand;
+
+  };
+
+ // ==================================================================
+ // Add operator
+ // ==================================================================
+ template<class T, class L, class R>
+  inline CCVectorBinaryExpression<T, L, R, CCExpressionAdd>
+  operator+(const CCVectorExpression<T, L> &left,
+            const CCVectorExpression<T, R> &right)
+ {
+  return CCVectorBinaryExpression<T, L, R, CCExpressionAdd>(left.expression(),
+                                                            right.expression());
+ }
+
+ // ==================================================================
+ // Substraction operator
+ // ==================================================================
+ template<class T, class L, class R>
+  inline CCVectorBinaryExpression<T, L, R, CCExpressionSubstract>
+  operator-(const CCVectorExpression<T, L> &left,
+            const CCVectorExpression<T, R> &right)
+ {
+  return CCVectorBinaryExpression<T, L, R, CCExpressionSubstract>(left.expression(),
+                                                                  right.expression());
+ }
+
+ // ==================================================================
+ // Scalar times vector expression
+ // ==================================================================
+ template<class T, class E>
+  inline CCVectorScaledExpression<T, E>
+  operator*(const typename CCExpressionScalar<T>::type scalar,
+            const CCVectorExpression<T, E> &operand)
+ {
+  return CCVectorScaledExpression<T, E>(scalar, operand.expression());
+ }
+
+ // ==================================================================
+ // Vector expression times scalar
+ // ==================================================================
+ template<class T, class E>
+  inline CCVectorScaledExpression<T, E>
+  operator*(const CCVectorExpression<T, E> &operand,
+            const typename CCExpressionScalar<T>::type scalar)
+ {
+  return CCVectorScaledExpression<T, E>(scalar, operand.expression());
+ }
+
+ // ==================================================================
+ // ==================================================================
+ // Matrix expressions
+ // ==================================================================
+ // ==================================================================
+
+ // ==================================================================
+ // Base class of all the matrix expressions (including CCMatrix). The
+ // derived class E provides the methods entry(k), n_rows(),
+ // n_columns() and is_column_major(), where k is the index of the
+ // entry in the storage order of the operands (row major unless
+ // is_column_major() is true)
+ // ==================================================================
+ template<class T, class E>
+  class CCMatrixExpression
+  {
+
+  public:
+
+   // Get the derived expression
+   inline const E &expression() const
+   {return static_cast<const E&>(*this);}
+
+  };
+
+ // ==================================================================
+ // Element-wise binary operation of two matrix expressions
+ // ==================================================================
+ template<class T, class L, class R, class OP>
+  class CCMatrixBinaryExpression :
+  public CCMatrixExpression<T, CCMatrixBinaryExpression<T, L, R, OP> >
+  {
+
+  public:
+
+   // Constructor, checks that the operands have the same dimension
+   // and the same storage order (the entries are combined by their
+   // position in memory)
+   CCMatrixBinaryExpression(const L &left, const R &right)
+    : Left(left), Right(right)
+    {
+     if (Left.n_rows() != Right.n_rows() ||
+         Left.n_columns() != Right.n_columns())
+      {
+       // Error message
+       std::ostringstream error_message;
+       error_message << "The dimension of the matrices is not the same:\n"
+                     << "dim(left_matrix) = (" << Left.n_rows() << ", "
+                     << Left.n_columns() << ")\n"
+                     << "dim(right_matrix) = (" << Right.n_rows() << ", "
+                     << Right.n_columns() << ")\n" << std::endl;
+       throw SciCellxxLibError(error_message.str(),
+                               SCICELLXX_CURRENT_FUNCTION,
+                               SCICELLXX_EXCEPTION_LOCATION);
+      }
+     
+     if (Left.is_column_major() != Right.is_column_major())
+      {
+       // Error message
+       std::ostringstream error_message;
+       error_message << "The matrices are not stored in the same order, change\n"
+                     << "the layout of one of them with set_column_major():\n"
+                     << "left_matrix.is_column_major() = "
+                     << Left.is_column_major() << "\n"
+                     << "right_matrix.is_column_major() = "
+                     << Right.is_column_major() << std::endl;
+       throw SciCellxxLibError(error_message.str(),
+                               SCICELLXX_CURRENT_FUNCTION,
+                               SCICELLXX_EXCEPTION_LOCATION);
+      }
+    }
+
+   // The k-th entry of the expression (storage order)
+   inline T entry(const unsigned long k) const
+   {return OP::apply(Left.entry(k), Right.entry(k));}
+
+   // The number of rows of the expression
+   inline unsigned long n_rows() const {return Left.n_rows();}
+
+   // The number of columns of the expression
+   inline unsigned long n_columns() const {return Left.n_columns();}
+
+   // Are the entries of the expression in column major order
+   inline bool is_column_major() const {return Left.is_column_major();}
+
+  private:
+
+   // The operands
+   typename CCExpressionOperand<L>::type Left;
+   typename CCExpressionOperand<R>::type Right;
+
+  };
+
+ // ==================================================================
+ // A matrix expression times a scalar
+ // ==================================================================
+ template<class T, class E>
+  class CCMatrixScaledExpression :
+  public CCMatrixExpression<T, CCMatrixScaledExpression<T, E> >
+  {
+
+  public:
+
+   // Constructor
+   CCMatrixScaledExpression(const T scalar, const E &operand)
+    : Scalar(scalar), Operand(operand)
+    { }
+
+   // The k-th entry of the expression (storage order)
+   inline T entry(const unsigned long k) const
+   {return Scalar * Operand.entry(k);}
+
+   // The number of rows of the expression
+   inline unsigned long n_rows() const {return Operand.n_rows();}
+
+   // The number of columns of the expression
+   inline unsigned long n_columns() const {return Operand.n_columns();}
+
+   // Are the entries of the expression in column major order
+   inline bool is_column_major() const {return Operand.is_column_major();}
+
+  private:
+
+   // The scalar
+   const T Scalar;
+
+   // The operand
+   typename CCExpressionOperand<E>::type Operand;
+
+  };
+
+ // ==================================================================
+ // Add operator
+ // ==================================================================
+ template<class T, class L, class R>
+  inline CCMatrixBinaryExpression<T, L, R, CCExpressionAdd>
+  operator+(const CCMatrixExpression<T, L> &left,
+            const CCMatrixExpression<T, R> &right)
+ {
+  return CCMatrixBinaryExpression<T, L, R, CCExpressionAdd>(left.expression(),
+                                                            right.expression());
+ }
+
+ // ==================================================================
+ // Substraction operator
+ // ==================================================================
+ template<class T, class L, class R>
+  inline CCMatrixBinaryExpression<T, L, R, CCExpressionSubstract>
+  operator-(const CCMatrixExpression<T, L> &left,
+            const CCMatrixExpression<T, R> &right)
+ {
+  return CCMatrixBinaryExpression<T, L, R, CCExpressionSubstract>(left.expression(),
+                                                                  right.expression());
+ }
+
+ // ==================================================================
+ // Scalar times matrix expression
+ // ==================================================================
+ template<class T, class E>
+  inline CCMatrixScaledExpression<T, E>
+  operator*(const typename CCExpressionScalar<T>::type scalar,
+            const CCMatrixExpression<T, E> &operand)
+ {
+  return CCMatrixScaledExpression<T, E>(scalar, operand.expression());
+ }
+
+ // ==================================================================
+ // Matrix expression times scalar
+ // ==================================================================
+ template<class T, class E>
+  inline CCMatrixScaledExpression<T, E>
+  operator*(const CCMatrixExpression<T, E> &operand,
+            const typename CCExpressionScalar<T>::type scalar)
+ {
+  return CCMatrixScaledExpression<T, E>(scalar, operand.expression());
+ }
+
+}
+
+#endif // #ifndef CCEXPRESSIONS_H
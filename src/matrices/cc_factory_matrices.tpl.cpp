@@ -8,17 +8,19 @@ namespace scicellxx
  // ===================================================================
  template<class T>
  CCFactoryMatrices<T>::CCFactoryMatrices()
+  : Pool_enabled(true),
+    N_objects_created_for_pool(0)
  { 
 
  }
 
  // ===================================================================
- /// Empty destructor
+ /// Destructor, deletes the objects in the pool
  // ===================================================================
  template<class T>
  CCFactoryMatrices<T>::~CCFactoryMatrices()
  { 
-
+  clear_pool();
  }
  
  // ===================================================================
@@ -71,6 +73,19 @@ namespace scicellxx
    {
     return new CCMatrix<T>();
    }
+  // Default type with the entries stored by columns (used by
+  // Armadillo's solver with no copies)
+  else if (matrix_type_name.compare("column_major")==0)
+   {
+    CCMatrix<T> *matrix_pt = new CCMatrix<T>();
+    matrix_pt->set_column_major(true);
+    return matrix_pt;
+   }
+  // Sparse type (CSR)
+  else if (matrix_type_name.compare("sparse")==0)
+   {
+    return new CCSparseMatrix<T>();
+   }
 #ifdef SCICELLXX_USES_ARMADILLO
   // Armadillo type
   else if (matrix_type_name.compare("armadillo")==0)
@@ -84,6 +99,8 @@ namespace scicellxx
     error_message << "The matrix time you want to use is not implemented yet.\n"
                   << "Please implement it yourself or select from the available ones\n\n"
                   << "- Default (default)\n"
+                  << "- Default stored by columns (column_major)\n"
+                  << "- Sparse CSR matrices (sparse)\n"
                   << "- Armadillo matrices (armadillo) - only supported when armadillo library is enabled\n"
                   << std::endl;
     throw SciCellxxLibError(error_message.str(),
@@ -111,6 +128,20 @@ namespace scicellxx
    {
     return new CCMatrix<T>(m, n);
    }
+  // Default type with the entries stored by columns (used by
+  // Armadillo's solver with no copies)
+  else if (matrix_type_name.compare("column_major")==0)
+   {
+    CCMatrix<T> *matrix_pt = new CCMatrix<T>();
+    matrix_pt->set_column_major(true);
+    matrix_pt->allocate_memory(m, n);
+    return matrix_pt;
+   }
+  // Sparse type (CSR)
+  else if (matrix_type_name.compare("sparse")==0)
+   {
+    return new CCSparseMatrix<T>(m, n);
+   }
 #ifdef SCICELLXX_USES_ARMADILLO
   // Armadillo type
   else if (matrix_type_name.compare("armadillo")==0)
@@ -124,6 +155,8 @@ namespace scicellxx
     error_message << "The matrix time you want to use is not implemented yet.\n"
                   << "Please implement it yourself or select from the availables ones\n\n"
                   << "- Default (default)\n"
+                  << "- Default stored by columns (column_major)\n"
+                  << "- Sparse CSR matrices (sparse)\n"
                   << "- Armadillo matrices (armadillo) - only supported when armadillo library is enabled\n"
                   << std::endl;
     throw SciCellxxLibError(error_message.str(),
@@ -203,7 +236,7 @@ namespace scicellxx
  /// Returns the specified vector pointer
  // ===================================================================
  template<class T>
- ACVector<T>* create_vector(std::string vector_type_name, const unsigned long n, bool is_column_vector)
+ ACVector<T>* CCFactoryMatrices<T>::create_vector(std::string vector_type_name, const unsigned long n, bool is_column_vector)
  {
     // Get the string and change it to lower case 
   std::transform(vector_type_name.begin(), vector_type_name.end(),
@@ -239,4 +272,235 @@ namespace scicellxx
   
  }
  
+// ===================================================================
+ /// Returns a handle to a vector with n entries (type based on
+ /// compilation options) taken from the pool
+ // ===================================================================
+ template<class T>
+ typename CCFactoryMatrices<T>::Pooled_vector
+ CCFactoryMatrices<T>::acquire_vector(const unsigned long n, bool is_column_vector)
+ {
+  // The vectors whose type is based on compilation options are kept
+  // in the free lists with no type name
+  const typename Pooled_vector::Pool_key key(std::string(), std::make_pair(n, 0ul));
+  
+  ACVector<T> *vector_pt = 0;
+  if (Pool_enabled)
+   {
+    typename std::map<typename Pooled_vector::Pool_key, std::vector<ACVector<T>*> >::iterator it =
+     Vector_pool.find(key);
+    if (it != Vector_pool.end() && !it->second.empty())
+     {
+      vector_pt = it->second.back();
+      it->second.pop_back();
+     }
+   }
+  
+  // Create a new one if the free list is empty
+  if (vector_pt == 0)
+   {
+    vector_pt = create_vector(n, is_column_vector);
+    N_objects_created_for_pool++;
+   }
+  
+  vector_pt->set_as_column_vector(is_column_vector);
+  
+  return Pooled_vector(this, vector_pt, key);
+ }
+ 
+ // ===================================================================
+ /// Returns a handle to a vector of the specified type with n entries
+ /// taken from the pool
+ // ===================================================================
+ template<class T>
+ typename CCFactoryMatrices<T>::Pooled_vector
+ CCFactoryMatrices<T>::acquire_vector(std::string vector_type_name, const unsigned long n, bool is_column_vector)
+ {
+  // Get the string and change it to lower case 
+  std::transform(vector_type_name.begin(), vector_type_name.end(),
+                 vector_type_name.begin(), ::tolower);
+  
+  const typename Pooled_vector::Pool_key key(vector_type_name, std::make_pair(n, 0ul));
+  
+  ACVector<T> *vector_pt = 0;
+  if (Pool_enabled)
+   {
+    typename std::map<typename Pooled_vector::Pool_key, std::vector<ACVector<T>*> >::iterator it =
+     Vector_pool.find(key);
+    if (it != Vector_pool.end() && !it->second.empty())
+     {
+      vector_pt = it->second.back();
+      it->second.pop_back();
+     }
+   }
+  
+  // Create a new one if the free list is empty
+  if (vector_pt == 0)
+   {
+    vector_pt = create_vector(vector_type_name, n, is_column_vector);
+    N_objects_created_for_pool++;
+   }
+  
+  vector_pt->set_as_column_vector(is_column_vector);
+  
+  return Pooled_vector(this, vector_pt, key);
+ }
+ 
+ // ===================================================================
+ /// Returns a handle to an m X n matrix (type based on compilation
+ /// options) taken from the pool
+ // ===================================================================
+ template<class T>
+ typename CCFactoryMatrices<T>::Pooled_matrix
+ CCFactoryMatrices<T>::acquire_matrix(const unsigned long m, const unsigned long n)
+ {
+  // The matrices whose type is based on compilation options are kept
+  // in the free lists with no type name
+  const typename Pooled_matrix::Pool_key key(std::string(), std::make_pair(m, n));
+  
+  ACMatrix<T> *matrix_pt = 0;
+  if (Pool_enabled)
+   {
+    typename std::map<typename Pooled_matrix::Pool_key, std::vector<ACMatrix<T>*> >::iterator it =
+     Matrix_pool.find(key);
+    if (it != Matrix_pool.end() && !it->second.empty())
+     {
+      matrix_pt = it->second.back();
+      it->second.pop_back();
+     }
+   }
+  
+  // Create a new one if the free list is empty
+  if (matrix_pt == 0)
+   {
+    matrix_pt = create_matrix(m, n);
+    N_objects_created_for_pool++;
+   }
+  
+  return Pooled_matrix(this, matrix_pt, key);
+ }
+ 
+ // ===================================================================
+ /// Returns a handle to an m X n matrix of the specified type taken
+ /// from the pool
+ // ===================================================================
+ template<class T>
+ typename CCFactoryMatrices<T>::Pooled_matrix
+ CCFactoryMatrices<T>::acquire_matrix(std::string matrix_type_name, const unsigned long m, const unsigned long n)
+ {
+  // Get the string and change it to lower case 
+  std::transform(matrix_type_name.begin(), matrix_type_name.end(),
+                 matrix_type_name.begin(), ::tolower);
+  
+  const typename Pooled_matrix::Pool_key key(matrix_type_name, std::make_pair(m, n));
+  
+  ACMatrix<T> *matrix_pt = 0;
+  if (Pool_enabled)
+   {
+    typename std::map<typename Pooled_matrix::Pool_key, std::vector<ACMatrix<T>*> >::iterator it =
+     Matrix_pool.find(key);
+    if (it != Matrix_pool.end() && !it->second.empty())
+     {
+      matrix_pt = it->second.back();
+      it->second.pop_back();
+     }
+   }
+  
+  // Create a new one if the free list is empty
+  if (matrix_pt == 0)
+   {
+    matrix_pt = create_matrix(matrix_type_name, m, n);
+    N_objects_created_for_pool++;
+   }
+  
+  return Pooled_matrix(this, matrix_pt, key);
+ }
+ 
+ // ===================================================================
+ /// Deletes the objects in the pool (the ones handed out are not
+ /// affected)
+ // ===================================================================
+ template<class T>
+ void CCFactoryMatrices<T>::clear_pool()
+ {
+  for (typename std::map<typename Pooled_vector::Pool_key, std::vector<ACVector<T>*> >::iterator it =
+        Vector_pool.begin(); it != Vector_pool.end(); it++)
+   {
+    for (unsigned long i = 0; i < it->second.size(); i++)
+     {
+      delete it->second[i];
+     }
+   }
+  Vector_pool.clear();
+  
+  for (typename std::map<typename Pooled_matrix::Pool_key, std::vector<ACMatrix<T>*> >::iterator it =
+        Matrix_pool.begin(); it != Matrix_pool.end(); it++)
+   {
+    for (unsigned long i = 0; i < it->second.size(); i++)
+     {
+      delete it->second[i];
+     }
+   }
+  Matrix_pool.clear();
+ }
+ 
+ // ===================================================================
+ /// The number of objects in the free lists of the pool
+ // ===================================================================
+ template<class T>
+ unsigned long CCFactoryMatrices<T>::n_objects_in_pool() const
+ {
+  unsigned long n_objects = 0;
+  for (typename std::map<typename Pooled_vector::Pool_key, std::vector<ACVector<T>*> >::const_iterator it =
+        Vector_pool.begin(); it != Vector_pool.end(); it++)
+   {
+    n_objects+=it->second.size();
+   }
+  for (typename std::map<typename Pooled_matrix::Pool_key, std::vector<ACMatrix<T>*> >::const_iterator it =
+        Matrix_pool.begin(); it != Matrix_pool.end(); it++)
+   {
+    n_objects+=it->second.size();
+   }
+  return n_objects;
+ }
+ 
+ // ===================================================================
+ /// Gives back a vector to the pool (called by the handles)
+ // ===================================================================
+ template<class T>
+ void CCFactoryMatrices<T>::give_back_to_pool(ACVector<T> *vector_pt,
+                                              const typename Pooled_vector::Pool_key &key)
+ {
+  // The user may have changed the size of the vector, only keep it
+  // if it still has the shape of its free list
+  if (Pool_enabled && vector_pt->n_values() == key.second.first)
+   {
+    Vector_pool[key].push_back(vector_pt);
+   }
+  else
+   {
+    delete vector_pt;
+   }
+ }
+ 
+ // ===================================================================
+ /// Gives back a matrix to the pool (called by the handles)
+ // ===================================================================
+ template<class T>
+ void CCFactoryMatrices<T>::give_back_to_pool(ACMatrix<T> *matrix_pt,
+                                              const typename Pooled_matrix::Pool_key &key)
+ {
+  // The user may have changed the shape of the matrix, only keep it
+  // if it still has the shape of its free list
+  if (Pool_enabled && matrix_pt->n_rows() == key.second.first &&
+      matrix_pt->n_columns() == key.second.second)
+   {
+    Matrix_pool[key].push_back(matrix_pt);
+   }
+  else
+   {
+    delete matrix_pt;
+   }
+ }
+ 
 }
@@ -9,6 +9,7 @@
 
 #include "../matrices/cc_vector.h"
 #include "../matrices/cc_matrix.h"
+#include "../matrices/cc_sparse_matrix.h"
 #ifdef SCICELLXX_USES_ARMADILLO
 #include "../matrices/cc_vector_armadillo.h"
 #include "../matrices/cc_matrix_armadillo.h"
@@ -17,6 +18,108 @@
 namespace scicellxx
 {
  
+ // Forward declaration of the factory, the handles give back their
+ // objects to it
+ template<class T> class CCFactoryMatrices;
+ 
+ /// @class CCPooledObject cc_factory_matrices.h
+ 
+ /// A handle to a vector or a matrix taken from the pool of a
+ /// factory (see CCFactoryMatrices::acquire_vector() and
+ /// CCFactoryMatrices::acquire_matrix()). The object is given back to
+ /// the pool when the handle is destroyed or released. Handles can
+ /// be moved but not copied, and MUST NOT outlive the factory that
+ /// created them
+ template<class T, class OBJECT>
+  class CCPooledObject
+  {
+   
+  public:
+   
+   /// The key of the free lists of the pool, the name of the type
+   /// and the shape of the object
+   typedef std::pair<std::string, std::pair<unsigned long, unsigned long> > Pool_key;
+   
+   /// Empty constructor, the handle holds no object
+   CCPooledObject()
+    : Factory_pt(0), Object_pt(0) { }
+   
+   /// Constructor used by the factory
+   CCPooledObject(CCFactoryMatrices<T> *factory_pt, OBJECT *object_pt, const Pool_key &key)
+    : Factory_pt(factory_pt), Object_pt(object_pt), Key(key) { }
+   
+   /// Move constructor, the source handle is left empty
+   CCPooledObject(CCPooledObject &&source)
+    : Factory_pt(source.Factory_pt), Object_pt(source.Object_pt), Key(source.Key)
+   {
+    source.Factory_pt = 0;
+    source.Object_pt = 0;
+   }
+   
+   /// Move assignment, the object held by this handle (if any) is
+   /// given back to its pool
+   CCPooledObject &operator=(CCPooledObject &&source)
+   {
+    if (this != &source)
+     {
+      release();
+      Factory_pt = source.Factory_pt;
+      Object_pt = source.Object_pt;
+      Key = source.Key;
+      source.Factory_pt = 0;
+      source.Object_pt = 0;
+     }
+    return *this;
+   }
+   
+   /// Destructor, gives back the object to the pool
+   ~CCPooledObject() {release();}
+   
+   /// Gives back the object to the pool, the handle is left empty
+   void release()
+   {
+    if (Object_pt != 0)
+     {
+      Factory_pt->give_back_to_pool(Object_pt, Key);
+     }
+    Factory_pt = 0;
+    Object_pt = 0;
+   }
+   
+   /// Get access to the object
+   inline OBJECT *pt() const {return Object_pt;}
+   
+   /// Get access to the object
+   inline OBJECT *operator->() const {return Object_pt;}
+   
+   /// Get access to the object
+   inline OBJECT &operator*() const {return *Object_pt;}
+   
+  private:
+   
+   /// Copy constructor (a pooled object has only one owner)
+   CCPooledObject(const CCPooledObject &copy)
+    {
+     BrokenCopy::broken_copy("CCPooledObject");
+    }
+   
+   /// Assignment operator (a pooled object has only one owner)
+   void operator=(const CCPooledObject &copy)
+    {
+     BrokenCopy::broken_assign("CCPooledObject");
+    }
+   
+   /// The factory that owns the pool
+   CCFactoryMatrices<T> *Factory_pt;
+   
+   /// The object taken from the pool
+   OBJECT *Object_pt;
+   
+   /// The free list where the object is given back
+   Pool_key Key;
+   
+  };
+ 
  /// @class CCFactoryMatrices cc_factory_matrices.h
  
  /// This class implements a factory for the instantiation of
@@ -31,7 +134,13 @@ namespace scicellxx
    /// Empty constructor
    CCFactoryMatrices();
    
-   /// Empty destructor
+   /// Handle to a vector taken from the pool
+   typedef CCPooledObject<T, ACVector<T> > Pooled_vector;
+   
+   /// Handle to a matrix taken from the pool
+   typedef CCPooledObject<T, ACMatrix<T> > Pooled_matrix;
+   
+   /// Destructor, deletes the objects in the pool
    virtual ~CCFactoryMatrices();
    
    /// Returns a matrix pointer (based on compilation options)
@@ -58,12 +167,57 @@ namespace scicellxx
    /// Returns the specified vector pointer
    ACVector<T>* create_vector(std::string vector_type_name, const unsigned long n, bool is_column_vector = true);
    
+   /// Returns a handle to a vector with n entries (type based on
+   /// compilation options) taken from the pool
+   Pooled_vector acquire_vector(const unsigned long n, bool is_column_vector = true);
+   
+   /// Returns a handle to a vector of the specified type with n
+   /// entries taken from the pool
+   Pooled_vector acquire_vector(std::string vector_type_name, const unsigned long n, bool is_column_vector = true);
+   
+   /// Returns a handle to an m X n matrix (type based on compilation
+   /// options) taken from the pool
+   Pooled_matrix acquire_matrix(const unsigned long m, const unsigned long n);
+   
+   /// Returns a handle to an m X n matrix of the specified type taken
+   /// from the pool
+   Pooled_matrix acquire_matrix(std::string matrix_type_name, const unsigned long m, const unsigned long n);
+   
+   /// Enables the pool (enabled by default)
+   inline void enable_pool() {Pool_enabled = true;}
+   
+   /// Disables the pool, the objects handed out are created on each
+   /// call and deleted by the handles. The objects already in the
+   /// pool are deleted
+   inline void disable_pool() {clear_pool(); Pool_enabled = false;}
+   
+   /// Is the pool enabled
+   inline bool is_pool_enabled() const {return Pool_enabled;}
+   
+   /// Deletes the objects in the pool (the ones handed out are not
+   /// affected)
+   void clear_pool();
+   
+   /// The number of objects created to be handed out by the pool
+   /// (calls not served by the free lists)
+   inline unsigned long n_objects_created_for_pool() const {return N_objects_created_for_pool;}
+   
+   /// The number of objects in the free lists of the pool
+   unsigned long n_objects_in_pool() const;
+   
+   /// Gives back a vector to the pool (called by the handles)
+   void give_back_to_pool(ACVector<T> *vector_pt, const typename Pooled_vector::Pool_key &key);
+   
+   /// Gives back a matrix to the pool (called by the handles)
+   void give_back_to_pool(ACMatrix<T> *matrix_pt, const typename Pooled_matrix::Pool_key &key);
+   
   protected:
    
    /// Copy constructor (we do not want this class to be
    /// copiable). Check
    /// http://www.learncpp.com/cpp-tutorial/912-shallow-vs-deep-copying/
    CCFactoryMatrices(const CCFactoryMatrices &copy)
+    : Pool_enabled(false), N_objects_created_for_pool(0)
     {
      BrokenCopy::broken_copy("CCFactoryMatrices");
     }
@@ -76,6 +230,18 @@ namespace scicellxx
      BrokenCopy::broken_assign("CCFactoryMatrices");
     }
    
+   /// Flag to indicate whether the pool is enabled
+   bool Pool_enabled;
+   
+   /// The number of objects created to be handed out by the pool
+   unsigned long N_objects_created_for_pool;
+   
+   /// The free lists of vectors, one per type and size
+   std::map<typename Pooled_vector::Pool_key, std::vector<ACVector<T>*> > Vector_pool;
+   
+   /// The free lists of matrices, one per type and shape
+   std::map<typename Pooled_matrix::Pool_key, std::vector<ACMatrix<T>*> > Matrix_pool;
+   
   };
  
 }
@@ -0,0 +1,245 @@
+// IN THIS FILE: The definition of a matrix whose size is known at
+// compile time. The entries are stored by rows in the object itself
+// (on the stack when the matrix is a local variable), thus creating
+// it does not allocate memory. The arithmetic operations are unrolled
+// at compile time. Intended for small matrices (3x3 rotations, 6x6
+// local Jacobians), use CCMatrix for larger ones. Conversions from
+// and to ACMatrix are provided, and view() gives an ACMatrix that
+// refers to the entries of the fixed matrix such that it can be
+// passed to any method of the library
+
+// Check whether the class has been already defined
+#ifndef CCFIXEDMATRIX_H
+#define CCFIXEDMATRIX_H
+
+#include "../general/common_includes.h"
+#include "../general/utilities.h"
+
+// The parent class of the matrices we convert from and to
+#include "ac_matrix.h"
+// The view used to pass the entries as an ACMatrix
+#include "cc_matrix_view.h"
+// Fixed vectors for matrix-vector operations
+#include "cc_fixed_vector.h"
+
+namespace scicellxx
+{
+
+ /// @class CCFixedMatrix cc_fixed_matrix.h
+
+ // Concrete class to represent M X N matrices, M and N are known at
+ // compile time. The (i,j) entry is stored at Entries[i*N + j]
+ template<class T, unsigned long M, unsigned long N>
+  class CCFixedMatrix
+  {
+
+  public:
+
+   // Empty constructor, the entries are set to zero
+   CCFixedMatrix()
+   {fill(T(0));}
+
+   // Constructor that sets all the entries to value
+   explicit CCFixedMatrix(const T value)
+   {fill(value);}
+
+   // Constructor that copies the M*N entries of values_pt (stored by
+   // rows)
+   explicit CCFixedMatrix(const T *values_pt)
+   {
+    CCUnroll<M*N>::apply([&](const unsigned long k) {Entries[k] = values_pt[k];});
+   }
+
+   // Constructor that copies the entries of a matrix of the library,
+   // the matrix should be of size M X N
+   explicit CCFixedMatrix(const ACMatrix<T> &matrix)
+   {copy_from(matrix);}
+
+   // The copy constructor, assignment and destructor are the default
+   // ones (copy the M*N entries)
+
+   // The identity matrix (only for square matrices)
+   static inline CCFixedMatrix identity()
+   {
+    static_assert(M == N, "The identity matrix must be square");
+    CCFixedMatrix result;
+    CCUnroll<N>::apply([&](const unsigned long i) {result(i, i) = T(1);});
+    return result;
+   }
+
+   // Number of rows
+   static inline unsigned long n_rows() {return M;}
+
+   // Number of columns
+   static inline unsigned long n_columns() {return N;}
+
+   // Get the (i,j) entry (read-only)
+   inline const T &operator()(const unsigned long i, const unsigned long j) const
+   {return Entries[i*N + j];}
+
+   // Get the (i,j) entry (read-write)
+   inline T &operator()(const unsigned long i, const unsigned long j)
+   {return Entries[i*N + j];}
+
+   // Get the pointer to the entries
+   inline T *data_pt() {return Entries;}
+
+   // Get the pointer to the entries (read-only)
+   inline const T *data_pt() const {return Entries;}
+
+   // Set all the entries to value
+   inline void fill(const T value)
+   {
+    CCUnroll<M*N>::apply([&](const unsigned long k) {Entries[k] = value;});
+   }
+
+   // this = this + matrix
+   inline CCFixedMatrix &operator+=(const CCFixedMatrix &matrix)
+   {
+    CCUnroll<M*N>::apply([&](const unsigned long k) {Entries[k]+= matrix.Entries[k];});
+    return *this;
+   }
+
+   // this = this - matrix
+   inline CCFixedMatrix &operator-=(const CCFixedMatrix &matrix)
+   {
+    CCUnroll<M*N>::apply([&](const unsigned long k) {Entries[k]-= matrix.Entries[k];});
+    return *this;
+   }
+
+   // this = alpha * this
+   inline CCFixedMatrix &operator*=(const T alpha)
+   {
+    CCUnroll<M*N>::apply([&](const unsigned long k) {Entries[k]*= alpha;});
+    return *this;
+   }
+
+   // this = this + alpha * x
+   inline void axpy(const T alpha, const CCFixedMatrix &x)
+   {
+    CCUnroll<M*N>::apply([&](const unsigned long k) {Entries[k]+= alpha * x.Entries[k];});
+   }
+
+   // Returns the transpose
+   inline CCFixedMatrix<T, N, M> transpose() const
+   {
+    CCFixedMatrix<T, N, M> result;
+    CCUnroll<M>::apply([&](const unsigned long i)
+                       {
+                        CCUnroll<N>::apply([&](const unsigned long j) {result(j, i) = (*this)(i, j);});
+                       });
+    return result;
+   }
+
+   // Copies the entries of a matrix of the library, the matrix
+   // should be of size M X N
+   void copy_from(const ACMatrix<T> &matrix)
+   {
+    if (matrix.n_rows() != M || matrix.n_columns() != N)
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The dimension of the matrix is not the same as the one\n"
+                    << "of the fixed matrix:\n"
+                    << "dim(matrix) = (" << matrix.n_rows() << ", "
+                    << matrix.n_columns() << ")\n"
+                    << "dim(this) = (" << M << ", " << N << ")" << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+    CCMatrixView<T> entries(Entries, M, N, N);
+    entries.copy(matrix);
+   }
+
+   // Copies the entries into a matrix of the library, memory is
+   // allocated if the matrix has none, otherwise it should be of size
+   // M X N
+   void copy_to(ACMatrix<T> &matrix) const
+   {
+    CCMatrixView<T> entries(const_cast<T*>(Entries), M, N, N);
+    matrix.copy(entries);
+   }
+
+   // Get a view of the entries, the view can be used as any other
+   // ACMatrix and modifies the entries of this matrix. It must not
+   // outlive this matrix
+   inline CCMatrixView<T> view()
+   {return CCMatrixView<T>(Entries, M, N, N);}
+
+  protected:
+
+   // The entries, stored by rows
+   T Entries[M*N];
+
+  };
+
+ // ================================================================
+ // Extra methods to work with fixed matrices and vectors
+ // ================================================================
+
+ // Returns left + right
+ template<class T, unsigned long M, unsigned long N>
+  inline CCFixedMatrix<T, M, N> operator+(const CCFixedMatrix<T, M, N> &left,
+                                          const CCFixedMatrix<T, M, N> &right)
+  {
+   CCFixedMatrix<T, M, N> result(left);
+   result+= right;
+   return result;
+  }
+
+ // Returns left - right
+ template<class T, unsigned long M, unsigned long N>
+  inline CCFixedMatrix<T, M, N> operator-(const CCFixedMatrix<T, M, N> &left,
+                                          const CCFixedMatrix<T, M, N> &right)
+  {
+   CCFixedMatrix<T, M, N> result(left);
+   result-= right;
+   return result;
+  }
+
+ // Returns alpha * matrix
+ template<class T, unsigned long M, unsigned long N>
+  inline CCFixedMatrix<T, M, N> operator*(const T alpha,
+                                          const CCFixedMatrix<T, M, N> &matrix)
+  {
+   CCFixedMatrix<T, M, N> result(matrix);
+   result*= alpha;
+   return result;
+  }
+
+ // Returns matrix * vector
+ template<class T, unsigned long M, unsigned long N>
+  inline CCFixedVector<T, M> operator*(const CCFixedMatrix<T, M, N> &matrix,
+                                       const CCFixedVector<T, N> &vector)
+  {
+   CCFixedVector<T, M> result;
+   CCUnroll<M>::apply([&](const unsigned long i)
+                      {
+                       T sum = 0.0;
+                       CCUnroll<N>::apply([&](const unsigned long j) {sum+= matrix(i, j) * vector(j);});
+                       result(i) = sum;
+                      });
+   return result;
+  }
+
+ // Returns left * right
+ template<class T, unsigned long M, unsigned long K, unsigned long N>
+  inline CCFixedMatrix<T, M, N> operator*(const CCFixedMatrix<T, M, K> &left,
+                                          const CCFixedMatrix<T, K, N> &right)
+  {
+   CCFixedMatrix<T, M, N> result;
+   CCUnroll<M>::apply([&](const unsigned long i)
+                      {
+                       CCUnroll<K>::apply([&](const unsigned long k)
+                                          {
+                                           const T left_ik = left(i, k);
+                                           CCUnroll<N>::apply([&](const unsigned long j) {result(i, j)+= left_ik * right(k, j);});
+                                          });
+                      });
+   return result;
+  }
+
+}
+
+#endif // #ifndef CCFIXEDMATRIX_H
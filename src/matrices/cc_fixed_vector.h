@@ -0,0 +1,310 @@
+// IN THIS FILE: The definition of a vector whose size is known at
+// compile time. The entries are stored in the object itself (on the
+// stack when the vector is a local variable), thus creating it does
+// not allocate memory. The arithmetic operations are unrolled at
+// compile time. Intended for small vectors (positions and velocities
+// of bodies, local stencils, per-node values), use CCVector for
+// larger ones. Conversions from and to ACVector are provided, and
+// view() gives an ACVector that refers to the entries of the fixed
+// vector such that it can be passed to any method of the library
+
+// Check whether the class has been already defined
+#ifndef CCFIXEDVECTOR_H
+#define CCFIXEDVECTOR_H
+
+#include "../general/common_includes.h"
+#include "../general/utilities.h"
+
+// The parent class of the vectors we convert from and to
+#include "ac_vector.h"
+// The view used to pass the entries as an ACVector
+#include "cc_vector_view.h"
+
+namespace scicellxx
+{
+
+ // ==================================================================
+ /// Applies f(0), f(1), ..., f(N-1). The recursion is resolved at
+ /// compile time, thus the loop is fully unrolled
+ // ==================================================================
+ template<unsigned long N>
+  struct CCUnroll
+  {
+   template<class F>
+    static inline void apply(const F &f)
+    {
+     CCUnroll<N-1>::apply(f);
+     f(N-1);
+    }
+  };
+
+ // ==================================================================
+ /// End of the recursion
+ // ==================================================================
+ template<>
+  struct CCUnroll<0>
+  {
+   template<class F>
+    static inline void apply(const F &) { }
+  };
+
+ /// @class CCFixedVector cc_fixed_vector.h
+
+ // Concrete class to represent vectors of N entries, N is known at
+ // compile time
+ template<class T, unsigned long N>
+  class CCFixedVector
+  {
+
+  public:
+
+   // Empty constructor, the entries are set to zero
+   CCFixedVector()
+   {fill(T(0));}
+
+   // Constructor that sets all the entries to value
+   explicit CCFixedVector(const T value)
+   {fill(value);}
+
+   // Constructor that copies the N entries of values_pt
+   explicit CCFixedVector(const T *values_pt)
+   {
+    CCUnroll<N>::apply([&](const unsigned long i) {Entries[i] = values_pt[i];});
+   }
+
+   // Constructor that copies the entries of a vector of the library,
+   // the number of entries should be N
+   explicit CCFixedVector(const ACVector<T> &vector)
+   {copy_from(vector);}
+
+   // The copy constructor, assignment and destructor are the default
+   // ones (copy the N entries)
+
+   // Number of entries
+   static inline unsigned long n_values() {return N;}
+
+   // Number of entries
+   static inline unsigned long size() {return N;}
+
+   // Get the i-th entry (read-only)
+   inline const T &operator()(const unsigned long i) const {return Entries[i];}
+
+   // Get the i-th entry (read-write)
+   inline T &operator()(const unsigned long i) {return Entries[i];}
+
+   // Get the i-th entry (read-only)
+   inline const T &operator[](const unsigned long i) const {return Entries[i];}
+
+   // Get the i-th entry (read-write)
+   inline T &operator[](const unsigned long i) {return Entries[i];}
+
+   // Get the pointer to the entries
+   inline T *data_pt() {return Entries;}
+
+   // Get the pointer to the entries (read-only)
+   inline const T *data_pt() const {return Entries;}
+
+   // Set all the entries to value
+   inline void fill(const T value)
+   {
+    CCUnroll<N>::apply([&](const unsigned long i) {Entries[i] = value;});
+   }
+
+   // this = this + vector
+   inline CCFixedVector &operator+=(const CCFixedVector &vector)
+   {
+    CCUnroll<N>::apply([&](const unsigned long i) {Entries[i]+= vector.Entries[i];});
+    return *this;
+   }
+
+   // this = this - vector
+   inline CCFixedVector &operator-=(const CCFixedVector &vector)
+   {
+    CCUnroll<N>::apply([&](const unsigned long i) {Entries[i]-= vector.Entries[i];});
+    return *this;
+   }
+
+   // this = alpha * this
+   inline CCFixedVector &operator*=(const T alpha)
+   {
+    CCUnroll<N>::apply([&](const unsigned long i) {Entries[i]*= alpha;});
+    return *this;
+   }
+
+   // this = this / alpha
+   inline CCFixedVector &operator/=(const T alpha)
+   {
+    CCUnroll<N>::apply([&](const unsigned long i) {Entries[i]/= alpha;});
+    return *this;
+   }
+
+   // this = this + alpha * x
+   inline void axpy(const T alpha, const CCFixedVector &x)
+   {
+    CCUnroll<N>::apply([&](const unsigned long i) {Entries[i]+= alpha * x.Entries[i];});
+   }
+
+   // Returns this^T * vector
+   inline T dot(const CCFixedVector &vector) const
+   {
+    T sum = 0.0;
+    CCUnroll<N>::apply([&](const unsigned long i) {sum+= Entries[i] * vector.Entries[i];});
+    return sum;
+   }
+
+   // Computes the square of the norm-2 of the vector
+   inline T squared_norm_2() const {return dot(*this);}
+
+   // Computes the norm-2 of the vector
+   inline T norm_2() const {return std::sqrt(squared_norm_2());}
+
+   // Computes the norm-1 of the vector
+   inline T norm_1() const
+   {
+    T sum = 0.0;
+    CCUnroll<N>::apply([&](const unsigned long i) {sum+= std::fabs(Entries[i]);});
+    return sum;
+   }
+
+   // Computes the infinite norm
+   inline T norm_inf() const
+   {
+    T norm = 0.0;
+    CCUnroll<N>::apply([&](const unsigned long i)
+                       {if (std::fabs(Entries[i]) > norm) norm = std::fabs(Entries[i]);});
+    return norm;
+   }
+
+   // Copies the entries of a vector of the library, the number of
+   // entries should be N
+   void copy_from(const ACVector<T> &vector)
+   {
+    if (vector.n_values() != N)
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The number of entries of the vector is not the same as\n"
+                    << "the one of the fixed vector:\n"
+                    << "vector.n_values() = " << vector.n_values() << "\n"
+                    << "N = " << N << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+    const CCVectorSpan<T> x = vector.span();
+    if (!x.is_empty())
+     {
+      CCUnroll<N>::apply([&](const unsigned long i) {Entries[i] = x[i];});
+     }
+    else
+     {
+      CCUnroll<N>::apply([&](const unsigned long i) {Entries[i] = vector.value(i);});
+     }
+   }
+
+   // Copies the entries into a vector of the library, memory is
+   // allocated if the vector has none, otherwise its number of
+   // entries should be N
+   void copy_to(ACVector<T> &vector) const
+   {
+    CCVectorView<T> entries(const_cast<T*>(Entries), N);
+    vector.copy(entries);
+   }
+
+   // Get a view of the entries, the view can be used as any other
+   // ACVector and modifies the entries of this vector. It must not
+   // outlive this vector
+   inline CCVectorView<T> view()
+   {return CCVectorView<T>(Entries, N);}
+
+  protected:
+
+   // The entries
+   T Entries[N];
+
+  };
+
+ // ================================================================
+ // Extra methods to work with fixed vectors
+ // ================================================================
+
+ // Returns left + right
+ template<class T, unsigned long N>
+  inline CCFixedVector<T, N> operator+(const CCFixedVector<T, N> &left,
+                                       const CCFixedVector<T, N> &right)
+  {
+   CCFixedVector<T, N> result(left);
+   result+= right;
+   return result;
+  }
+
+ // Returns left - right
+ template<class T, unsigned long N>
+  inline CCFixedVector<T, N> operator-(const CCFixedVector<T, N> &left,
+                                       const CCFixedVector<T, N> &right)
+  {
+   CCFixedVector<T, N> result(left);
+   result-= right;
+   return result;
+  }
+
+ // Returns -vector
+ template<class T, unsigned long N>
+  inline CCFixedVector<T, N> operator-(const CCFixedVector<T, N> &vector)
+  {
+   CCFixedVector<T, N> result(vector);
+   result*= T(-1);
+   return result;
+  }
+
+ // Returns alpha * vector
+ template<class T, unsigned long N>
+  inline CCFixedVector<T, N> operator*(const T alpha,
+                                       const CCFixedVector<T, N> &vector)
+  {
+   CCFixedVector<T, N> result(vector);
+   result*= alpha;
+   return result;
+  }
+
+ // Returns vector * alpha
+ template<class T, unsigned long N>
+  inline CCFixedVector<T, N> operator*(const CCFixedVector<T, N> &vector,
+                                       const T alpha)
+  {
+   CCFixedVector<T, N> result(vector);
+   result*= alpha;
+   return result;
+  }
+
+ // Returns vector / alpha
+ template<class T, unsigned long N>
+  inline CCFixedVector<T, N> operator/(const CCFixedVector<T, N> &vector,
+                                       const T alpha)
+  {
+   CCFixedVector<T, N> result(vector);
+   result/= alpha;
+   return result;
+  }
+
+ // Returns left^T * right
+ template<class T, unsigned long N>
+  inline T dot(const CCFixedVector<T, N> &left,
+               const CCFixedVector<T, N> &right)
+  {return left.dot(right);}
+
+ // Returns the cross product left x right
+ template<class T>
+  inline CCFixedVector<T, 3> cross(const CCFixedVector<T, 3> &left,
+                                   const CCFixedVector<T, 3> &right)
+  {
+   CCFixedVector<T, 3> result;
+   result(0) = left(1)*right(2) - left(2)*right(1);
+   result(1) = left(2)*right(0) - left(0)*right(2);
+   result(2) = left(0)*right(1) - left(1)*right(0);
+   return result;
+  }
+
+}
+
+#endif // #ifndef CCFIXEDVECTOR_H
@@ -5,13 +5,42 @@
 
 namespace scicellxx
 {
+ 
+ namespace
+ {
+  // =================================================================
+  // Checks that both matrices store their entries in the same order,
+  // required by the operations that combine the entries by their
+  // position in memory
+  // =================================================================
+  template<class T>
+   void check_same_order(const CCMatrix<T> &matrix_one,
+                         const CCMatrix<T> &matrix_two)
+   {
+    if (matrix_one.is_column_major() != matrix_two.is_column_major())
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The matrices are not stored in the same order, change\n"
+                    << "the layout of one of them with set_column_major():\n"
+                    << "matrix_one.is_column_major() = "
+                    << matrix_one.is_column_major() << "\n"
+                    << "matrix_two.is_column_major() = "
+                    << matrix_two.is_column_major() << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+   }
+  
+ }
 
  // ===================================================================
  // Empty constructor
  // ===================================================================
  template<class T>
  CCMatrix<T>::CCMatrix() 
-  : ACMatrix<T>()
+  : ACMatrix<T>(), Is_column_major(false), Is_memory_shared(false)
  {
   // Delete any data in memory
   clean_up();
@@ -22,7 +51,7 @@ namespace scicellxx
  // ===================================================================
  template<class T>
  CCMatrix<T>::CCMatrix(const unsigned long m, const unsigned long n)
-  : ACMatrix<T>(m, n)
+  : ACMatrix<T>(m, n), Is_column_major(false), Is_memory_shared(false)
  {
   allocate_memory(m, n);
  }
@@ -34,7 +63,7 @@ namespace scicellxx
  CCMatrix<T>::CCMatrix(T *matrix_pt,
                        const unsigned long m,
                        const unsigned long n)
- : ACMatrix<T>(m, n)
+ : ACMatrix<T>(m, n), Is_column_major(false), Is_memory_shared(false)
  {
   // Copy the data from the input vector to the Matrix_pt vector
   set_matrix(matrix_pt, m, n);
@@ -45,7 +74,7 @@ namespace scicellxx
  // ===================================================================
  template<class T>
  CCMatrix<T>::CCMatrix(CCVector<T> &vector)
-  : ACMatrix<T>()
+  : ACMatrix<T>(), Is_column_major(false), Is_memory_shared(false)
  {
   // Get the pointer to the vector data
   T *vector_pt = vector.vector_pt();
@@ -72,12 +101,41 @@ namespace scicellxx
  // ===================================================================
  template<class T>
  CCMatrix<T>::CCMatrix(const CCMatrix<T> &copy)
-  : ACMatrix<T>(copy.n_rows(), copy.n_columns())
+  : ACMatrix<T>(copy.n_rows(), copy.n_columns()),
+  Is_column_major(copy.is_column_major()), Is_memory_shared(false)
  {
-  // Copy the data from the copy matrix to the Matrix_pt vector
+  // Copy the data from the copy matrix to the Matrix_pt vector (in
+  // the same order)
   set_matrix(copy.matrix_pt(), this->NRows, this->NColumns);
  }
  
+ // ===================================================================
+ // Move constructor
+ // ===================================================================
+ template<class T>
+ CCMatrix<T>::CCMatrix(CCMatrix<T> &&source_matrix)
+  : ACMatrix<T>(), Is_column_major(false), Is_memory_shared(false)
+ {
+  // Delete any data in memory
+  clean_up();
+  // Take the memory of the source matrix
+  move_matrix(source_matrix);
+ }
+ 
+ // ===================================================================
+ // Constructor from an expression
+ // ===================================================================
+ template<class T>
+ template<class E>
+ CCMatrix<T>::CCMatrix(const CCMatrixExpression<T, E> &expression)
+  : ACMatrix<T>(), Is_column_major(false), Is_memory_shared(false)
+ {
+  // Delete any data in memory
+  clean_up();
+  // Evaluate the expression
+  evaluate_expression(expression.expression());
+ }
+ 
  // ===================================================================
  // Empty destructor
  // ===================================================================
@@ -94,7 +152,9 @@ namespace scicellxx
  template<class T>
  CCMatrix<T>& CCMatrix<T>::operator=(const CCMatrix<T> &source_matrix)
  {
-  // Clean-up and set values
+  // Clean-up and set values (in the same order as the source matrix)
+  clean_up();
+  Is_column_major = source_matrix.is_column_major();
   set_matrix(source_matrix.matrix_pt(),
              source_matrix.n_rows(),
              source_matrix.n_columns());
@@ -103,6 +163,24 @@ namespace scicellxx
   return *this;
  }
  
+ // ===================================================================
+ // Move assignment operator
+ // ===================================================================
+ template<class T>
+ CCMatrix<T>& CCMatrix<T>::operator=(CCMatrix<T> &&source_matrix)
+ {
+  // Check for self-assignment
+  if (this != &source_matrix)
+   {
+    // Clean-up and take the memory of the source matrix
+    clean_up();
+    move_matrix(source_matrix);
+   }
+  
+  // Return this (de-referenced pointer)
+  return *this;
+ }
+ 
  // ===================================================================
  // += operator
  // ===================================================================
@@ -128,30 +206,119 @@ namespace scicellxx
  }
 
  // ===================================================================
- // Add operator
+ // Assignment from an expression
  // ===================================================================
  template<class T>
- CCMatrix<T> CCMatrix<T>::operator+(const CCMatrix<T> &matrix)
+ template<class E>
+ CCMatrix<T>& CCMatrix<T>::operator=(const CCMatrixExpression<T, E> &expression)
  {
-  // Create a zero matrix where to store the result
-  CCMatrix<T> solution(this->NRows, this->NColumns);
-  // Call the method to perform the addition
-  add_matrix(matrix, solution);
+  // Evaluate the expression
+  evaluate_expression(expression.expression());
+  // Return this (de-referenced pointer)
+  return *this;
+ }
+ 
+ // ===================================================================
+ // += operator for expressions
+ // ===================================================================
+ template<class T>
+ template<class E>
+ CCMatrix<T>& CCMatrix<T>::operator+=(const CCMatrixExpression<T, E> &expression)
+ {
+  // Check that the dimensions are the same (the expression is
+  // evaluated on THIS matrix, we can not re-allocate memory)
+  const E &e = expression.expression();
+  if (!this->Is_own_memory_allocated || this->NRows != e.n_rows() ||
+      this->NColumns != e.n_columns() || Is_column_major != e.is_column_major())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The dimension or the storage order of the matrices is\n"
+                  << "not the same or this matrix has no memory allocated:\n"
+                  << "dim(expression) = (" << e.n_rows() << ", "
+                  << e.n_columns() << ")\n"
+                  << "dim(this) = (" << this->NRows << ", "
+                  << this->NColumns << ")\n"
+                  << "expression.is_column_major() = " << e.is_column_major() << "\n"
+                  << "this->is_column_major() = " << Is_column_major << "\n"
+                  << "this->Is_own_memory_allocated = "
+                  << this->Is_own_memory_allocated << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                           SCICELLXX_CURRENT_FUNCTION,
+                           SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  // Perform the operation (an entry of the expression only depends on
+  // the same entry of the operands, thus this matrix may appear in
+  // the expression)
+  const unsigned long n_entries = this->NRows * this->NColumns;
+  for (unsigned long k = 0; k < n_entries; k++)
+   {
+    Matrix_pt[k]+= e.entry(k);
+   }
+  
   // Return the solution matrix
-  return solution;
+  return *this;
  }
-
+ 
  // ===================================================================
- // Substraction operator
+ // -= operator for expressions
  // ===================================================================
  template<class T>
- CCMatrix<T> CCMatrix<T>::operator-(const CCMatrix<T> &matrix)
+ template<class E>
+ CCMatrix<T>& CCMatrix<T>::operator-=(const CCMatrixExpression<T, E> &expression)
  {
-  // Create a zero matrix where to store the result
-  CCMatrix<T> solution(this->NRows, this->NColumns);
-  // Call the method to perform the operation
-  substract_matrix(matrix, solution);
-  return solution;
+  // Add the negative of the expression
+  return (*this)+=(T(-1) * expression);
+ }
+ 
+ // ===================================================================
+ // Evaluates the expression and stores the result in this matrix
+ // ===================================================================
+ template<class T>
+ template<class E>
+ void CCMatrix<T>::evaluate_expression(const E &expression)
+ {
+  const unsigned long n_rows = expression.n_rows();
+  const unsigned long n_columns = expression.n_columns();
+  const unsigned long n_entries = n_rows * n_columns;
+  
+  // If the matrix has the correct size and order then evaluate in
+  // place. An entry of the expression only depends on the same entry
+  // of the operands, thus this matrix may appear in the expression
+  if (this->Is_own_memory_allocated &&
+      this->NRows == n_rows && this->NColumns == n_columns &&
+      Is_column_major == expression.is_column_major())
+   {
+    for (unsigned long k = 0; k < n_entries; k++)
+     {
+      Matrix_pt[k] = expression.entry(k);
+     }
+   }
+  else
+   {
+    // Evaluate in new memory before releasing the current one, it
+    // may be used in the expression
+    T *new_matrix_pt = MemoryAllocator::new_array<T>(n_entries);
+    for (unsigned long k = 0; k < n_entries; k++)
+     {
+      new_matrix_pt[k] = expression.entry(k);
+     }
+    
+    // Clean any possible previously allocated memory
+    clean_up();
+    
+    // Set the number of rows and columns, the order of the entries
+    // and the new memory
+    this->NRows = n_rows;
+    this->NColumns = n_columns;
+    Is_column_major = expression.is_column_major();
+    Matrix_pt = new_matrix_pt;
+    
+    // Mark the matrix as having its own memory
+    this->Is_own_memory_allocated = true;
+   }
+  
  }
 
  // ===================================================================
@@ -160,8 +327,9 @@ namespace scicellxx
  template<class T>
  CCMatrix<T> CCMatrix<T>::operator*(const CCMatrix<T> &right_matrix)
  { 
-  // Create a zero matrix where to store the result
-  CCMatrix<T> solution(this->NRows, right_matrix.n_columns());
+  // The matrix where to store the result, its memory is allocated by
+  // the multiplication (in the same order as the operands)
+  CCMatrix<T> solution;
   // Perform the multiplication
   multiply_by_matrix(right_matrix, solution);
   // Return the solution matrix
@@ -185,7 +353,7 @@ namespace scicellxx
   this->NColumns = n;
   
   // Allocate memory for the matrix
-  Matrix_pt = new T[m*n];
+  Matrix_pt = MemoryAllocator::new_array<T>(m*n);
   
   // Mark the matrix as having its own memory
   this->Is_own_memory_allocated = true;
@@ -195,14 +363,71 @@ namespace scicellxx
   
  }
  
+ // ===================================================================
+ // Takes the memory of the source matrix. The memory is only
+ // transferred if the source matrix is allowed to delete it, otherwise
+ // the entries are copied. In both cases the source matrix is left
+ // empty. THIS matrix should have no memory allocated
+ // ===================================================================
+ template<class T>
+ void CCMatrix<T>::move_matrix(CCMatrix<T> &source_matrix)
+ {
+  if (source_matrix.is_own_memory_allocated())
+   {
+    if (source_matrix.delete_matrix())
+     {
+      // Transfer ownership
+      this->NRows = source_matrix.NRows;
+      this->NColumns = source_matrix.NColumns;
+      Is_column_major = source_matrix.Is_column_major;
+      Matrix_pt = source_matrix.Matrix_pt;
+      this->Is_own_memory_allocated = true;
+      
+      // Leave the source matrix empty, with no memory
+      source_matrix.NRows = 0;
+      source_matrix.NColumns = 0;
+      source_matrix.Matrix_pt = 0;
+      source_matrix.Is_own_memory_allocated = false;
+     }
+    else
+     {
+      // The memory of the source matrix is managed somewhere else,
+      // copy the entries
+      Is_column_major = source_matrix.Is_column_major;
+      set_matrix(source_matrix.matrix_pt(),
+                 source_matrix.n_rows(),
+                 source_matrix.n_columns());
+     }
+   }
+  else
+   {
+    // Nothing to transfer, only the dimensions and the order (the
+    // source matrix is left empty)
+    this->NRows = source_matrix.NRows;
+    this->NColumns = source_matrix.NColumns;
+    Is_column_major = source_matrix.Is_column_major;
+    source_matrix.NRows = 0;
+    source_matrix.NColumns = 0;
+   }
+  
+ }
+ 
  // ===================================================================
  // Clean up for any dynamically stored data
  // ===================================================================
  template<class T>
  void CCMatrix<T>::clean_up()
  {
+  // The shared memory is not released, only forget about it
+  if (Is_memory_shared)
+   {
+    Matrix_pt = 0;
+    this->Is_own_memory_allocated = false;
+    this->Delete_matrix = true;
+    Is_memory_shared = false;
+   }
   // Check whether the Matrix allocated its own memory
-  if (this->Is_own_memory_allocated)
+  else if (this->Is_own_memory_allocated)
    {
     // Mark the matrix as deleteable
     this->Delete_matrix = true;
@@ -217,6 +442,35 @@ namespace scicellxx
   
  }
  
+ // ===================================================================
+ // Uses the given memory to store the entries, the entries are not
+ // copied and the memory is not released by the matrix
+ // ===================================================================
+ template<class T>
+ void CCMatrix<T>::share_matrix(T *matrix_pt,
+                                const unsigned long m,
+                                const unsigned long n,
+                                const bool column_major)
+ {
+  // Clean any possible previously allocated memory
+  clean_up();
+  
+  // Set the number of rows and columns, and the order of the entries
+  this->NRows = m;
+  this->NColumns = n;
+  Is_column_major = column_major;
+  
+  // Use the given memory
+  Matrix_pt = matrix_pt;
+  
+  // The matrix has memory but it is not allowed to release it, moving
+  // the matrix copies the entries
+  this->Is_own_memory_allocated = true;
+  this->Delete_matrix = false;
+  Is_memory_shared = true;
+  
+ }
+ 
  // ===================================================================
  // Free allocated memory for matrix
  // ===================================================================
@@ -228,7 +482,7 @@ namespace scicellxx
   // marked for deletion
   if (this->Delete_matrix)
    {
-    delete [] Matrix_pt;
+    MemoryAllocator::delete_array(Matrix_pt);
     Matrix_pt = 0; 
     
     // Mark the matrix as not having allocated memory
@@ -289,15 +543,23 @@ namespace scicellxx
                            SCICELLXX_EXCEPTION_LOCATION);
    }
   
+  // Check that the matrices are stored in the same order (the
+  // entries are combined by their position in memory)
+  check_same_order(*this, matrix);
+  
   // Check whether the solution matrix has allocated memory, otherwise
-  // allocate it here!!!
+  // allocate it here (in the same order as the operands)!!!
   if (!solution_matrix.is_own_memory_allocated())
    {
     // Allocate memory for the matrix
+    solution_matrix.set_column_major(Is_column_major);
     solution_matrix.allocate_memory(n_rows, n_columns);
    }
   else
    {
+    // Check the order of the solution matrix
+    check_same_order(*this, solution_matrix);
+    
     // Check whether the dimension of the solution matrix are correct
     const unsigned long n_rows_solution_matrix = solution_matrix.n_rows();
     const unsigned long n_columns_solution_matrix = solution_matrix.n_columns();
@@ -323,14 +585,7 @@ namespace scicellxx
   // Get the matrix pointer of the input matrix
   T *matrix_pt = matrix.matrix_pt();
   // Perform the addition
-  for (unsigned long i = 0; i < n_rows; i++)
-   {
-    const unsigned long offset = i*n_columns;
-    for (unsigned long j = 0; j < n_columns; j++)
-     {
-      solution_matrix_pt[offset+j] = Matrix_pt[offset+j] + matrix_pt[offset+j];
-     }
-   }
+  ParallelKernels::add(n_rows*n_columns, Matrix_pt, matrix_pt, solution_matrix_pt);
   
  }
  
@@ -375,15 +630,23 @@ namespace scicellxx
                            SCICELLXX_EXCEPTION_LOCATION);
    }
   
+  // Check that the matrices are stored in the same order (the
+  // entries are combined by their position in memory)
+  check_same_order(*this, matrix);
+  
   // Check whether the solution matrix has allocated memory, otherwise
-  // allocate it here!!!
+  // allocate it here (in the same order as the operands)!!!
   if (!solution_matrix.is_own_memory_allocated())
    {
     // Allocate memory for the matrix
+    solution_matrix.set_column_major(Is_column_major);
     solution_matrix.allocate_memory(n_rows, n_columns);
    }
   else
    {
+    // Check the order of the solution matrix
+    check_same_order(*this, solution_matrix);
+    
     // Check whether the dimension of the solution matrix are correct
     const unsigned long n_rows_solution_matrix = solution_matrix.n_rows();
     const unsigned long n_columns_solution_matrix = solution_matrix.n_columns();
@@ -409,14 +672,7 @@ namespace scicellxx
   // Get the matrix pointer of the input matrix
   T *matrix_pt = matrix.matrix_pt();
   // Perform the addition
-  for (unsigned long i = 0; i < n_rows; i++)
-   {
-    const unsigned long offset = i*n_columns;
-    for (unsigned long j = 0; j < n_columns; j++)
-     {
-      solution_matrix_pt[offset+j] = Matrix_pt[offset+j] - matrix_pt[offset+j];
-     }
-   }
+  ParallelKernels::substract(n_rows*n_columns, Matrix_pt, matrix_pt, solution_matrix_pt);
  
  }
 
@@ -463,15 +719,22 @@ namespace scicellxx
                            SCICELLXX_EXCEPTION_LOCATION);
    }
   
+  // Check that the matrices are stored in the same order
+  check_same_order(*this, right_matrix);
+  
   // Check whether the solution matrix has allocated memory, otherwise
-  // allocate it here!!!
+  // allocate it here (in the same order as the operands)!!!
   if (!solution_matrix.is_own_memory_allocated())
    {
     // Allocate memory for the matrix
+    solution_matrix.set_column_major(Is_column_major);
     solution_matrix.allocate_memory(n_rows_left_matrix, n_columns_right_matrix);
    }
   else
    {
+    // Check the order of the solution matrix
+    check_same_order(*this, solution_matrix);
+    
     // Check whether the dimension of the solution matrix are correct
     const unsigned long n_rows_solution_matrix = solution_matrix.n_rows();
     const unsigned long n_columns_solution_matrix = solution_matrix.n_columns();
@@ -500,21 +763,22 @@ namespace scicellxx
   
   // Get the matrix pointer of the right matrix
   T *right_matrix_pt = right_matrix.matrix_pt();
-  // Perform the multiplication
-  for (unsigned long i = 0; i < n_rows_left_matrix; i++)
+  // Perform the multiplication (cache-blocked kernel). Column major
+  // matrices are stored as their transposes by rows, thus the kernel
+  // computes solution^T = right_matrix^T * this^T
+  if (!Is_column_major)
    {
-    const unsigned offset_right_matrix = i * n_columns_right_matrix;
-    const unsigned offset_left_matrix = i * n_columns_left_matrix;
-    for (unsigned long j = 0; j < n_columns_right_matrix; j++)
-     {
-      // Initialise
-      solution_matrix_pt[offset_right_matrix+j] = 0;
-      for (unsigned long k = 0; k < n_columns_left_matrix; k++)
-       {
-        solution_matrix_pt[offset_right_matrix+j]+=
-         Matrix_pt[offset_left_matrix+k] * right_matrix_pt[k*n_columns_right_matrix+j];
-       }
-     }
+    GEMMKernels::gemm(n_rows_left_matrix, n_columns_right_matrix, n_columns_left_matrix,
+                      Matrix_pt, n_columns_left_matrix,
+                      right_matrix_pt, n_columns_right_matrix,
+                      solution_matrix_pt, n_columns_right_matrix);
+   }
+  else
+   {
+    GEMMKernels::gemm(n_columns_right_matrix, n_rows_left_matrix, n_columns_left_matrix,
+                      right_matrix_pt, n_rows_right_matrix,
+                      Matrix_pt, n_rows_left_matrix,
+                      solution_matrix_pt, n_rows_left_matrix);
    }
   
  }
@@ -525,26 +789,49 @@ namespace scicellxx
  template<class T>
  void CCMatrix<T>::transpose(CCMatrix<T> &transposed_matrix)
  {
+  // Check that THIS matrix has memory allocated
+  if (!(this->is_own_memory_allocated()))
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "THIS matrix has no memory allocated\n"
+                  << "this->Is_own_memory_allocated = "
+                  << this->Is_own_memory_allocated << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                           SCICELLXX_CURRENT_FUNCTION,
+                           SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  // Transposing into itself is done in place
+  if (&transposed_matrix == this)
+   {
+    transpose();
+    return;
+   }
+  
   // Get the number of rows and columns of the matrix
   const unsigned long n_rows = this->NRows;
   const unsigned long n_columns = this->NColumns;
   
-  // Create a vector to store the transposed matrix
-  T *transposed_matrix_pt = new T[n_rows*n_columns];
-  // Copy the data in the transposed matrix
-  for (unsigned i = 0; i < n_rows; i++)
+  // Allocate memory for the transposed matrix, stored in the same
+  // order as this matrix
+  transposed_matrix.clean_up();
+  transposed_matrix.set_column_major(Is_column_major);
+  transposed_matrix.allocate_memory(n_columns, n_rows);
+  
+  // Copy the data in the transposed matrix (cache-oblivious kernel).
+  // A column major matrix is stored as its transpose by rows, thus
+  // the kernel is applied to the transposed dimensions
+  if (!Is_column_major)
    {
-    for (unsigned j = 0; j < n_columns; j++)
-     {    
-      transposed_matrix_pt[j*n_rows+i] = value(i,j);
-     }
+    TransposeKernels::transpose(n_rows, n_columns, Matrix_pt, n_columns,
+                                transposed_matrix.matrix_pt(), n_rows);
+   }
+  else
+   {
+    TransposeKernels::transpose(n_columns, n_rows, Matrix_pt, n_rows,
+                                transposed_matrix.matrix_pt(), n_columns);
    }
-  
-  // Copy the transposed matrix pointer to the transpose_matrix matrix
-  transposed_matrix.set_matrix(transposed_matrix_pt, n_columns, n_rows);
-  
-  // Delete the temporary transpose matrix pointer
-  delete [] transposed_matrix_pt;
   
  }
  
@@ -567,8 +854,50 @@ namespace scicellxx
                            SCICELLXX_EXCEPTION_LOCATION);
    }
   
-  // Transpose itself
-  this->transpose(*this);
+  // Transpose itself, no copy of the matrix is created (tiles are
+  // swapped for square matrices and the cycles of the permutation are
+  // followed for rectangular ones). A column major matrix is stored as
+  // its transpose by rows
+  if (!Is_column_major)
+   {
+    TransposeKernels::transpose_in_place(this->NRows, this->NColumns, Matrix_pt);
+   }
+  else
+   {
+    TransposeKernels::transpose_in_place(this->NColumns, this->NRows, Matrix_pt);
+   }
+  
+  // Swap the dimensions
+  std::swap(this->NRows, this->NColumns);
+ }
+ 
+ // ===================================================================
+ // Sets the order in which the entries are stored, the entries are
+ // reordered in place if the matrix has memory allocated
+ // ===================================================================
+ template<class T>
+ void CCMatrix<T>::set_column_major(const bool column_major)
+ {
+  if (column_major == Is_column_major)
+   {
+    return;
+   }
+  
+  // Reorder the entries, the matrix stored by rows is the transpose
+  // of the matrix stored by columns
+  if (this->Is_own_memory_allocated)
+   {
+    if (!Is_column_major)
+     {
+      TransposeKernels::transpose_in_place(this->NRows, this->NColumns, Matrix_pt);
+     }
+    else
+     {
+      TransposeKernels::transpose_in_place(this->NColumns, this->NRows, Matrix_pt);
+     }
+   }
+  
+  Is_column_major = column_major;
  }
  
  // ===================================================================
@@ -614,7 +943,7 @@ namespace scicellxx
    }
 #endif // #ifdef SCICELLXX_RANGE_CHECK
   // Return the value at row i and column j
-  return Matrix_pt[i*this->NColumns+j];
+  return Matrix_pt[index(i, j)];
  }
 
  // ===================================================================
@@ -660,7 +989,7 @@ namespace scicellxx
    }
 #endif // #ifdef SCICELLXX_RANGE_CHECK
   // Return the value at row i and column j
-  return Matrix_pt[i*this->NColumns+j];
+  return Matrix_pt[index(i, j)];
  }
  
  // ===================================================================
@@ -952,7 +1281,7 @@ namespace scicellxx
   //allocate_memory();
   
   // Allocate memory for the matrix
-  Matrix_pt = new T[this->NRows * this->NColumns];
+  Matrix_pt = MemoryAllocator::new_array<T>(this->NRows * this->NColumns);
   
   // Mark the matrix as allocated its own memory
   this->Is_own_memory_allocated=true;
@@ -1051,15 +1380,23 @@ namespace scicellxx
                            SCICELLXX_EXCEPTION_LOCATION);
    }
   
+  // Check that the matrices are stored in the same order (the
+  // entries are combined by their position in memory)
+  check_same_order(matrix_one, matrix_two);
+  
   // Check whether the solution matrix has allocated memory, otherwise
-  // allocate it here!!!
+  // allocate it here (in the same order as the operands)!!!
   if (!solution_matrix.is_own_memory_allocated())
    {
     // Allocate memory for the matrix
+    solution_matrix.set_column_major(matrix_one.is_column_major());
     solution_matrix.allocate_memory(n_rows_matrix_one, n_columns_matrix_one);
    }
   else
    {
+    // Check the order of the solution matrix
+    check_same_order(matrix_one, solution_matrix);
+    
     // Check whether the dimension of the solution matrix are correct
     const unsigned long n_rows_solution_matrix = solution_matrix.n_rows();
     const unsigned long n_columns_solution_matrix = solution_matrix.n_columns();
@@ -1087,15 +1424,8 @@ namespace scicellxx
   T *matrix_one_pt = matrix_one.matrix_pt();
   T *matrix_two_pt = matrix_two.matrix_pt();
   // Perform the addition
-  for (unsigned long i = 0; i < n_rows_matrix_one; i++)
-   {
-    const unsigned long offset = i*n_columns_matrix_one;
-    for (unsigned long j = 0; j < n_columns_matrix_one; j++)
-     {
-      solution_matrix_pt[offset+j] =
-       matrix_one_pt[offset+j] + matrix_two_pt[offset+j];
-     }
-   }
+  ParallelKernels::add(n_rows_matrix_one*n_columns_matrix_one,
+                       matrix_one_pt, matrix_two_pt, solution_matrix_pt);
   
  }
  
@@ -1143,15 +1473,23 @@ namespace scicellxx
                            SCICELLXX_EXCEPTION_LOCATION);
    }
 
+  // Check that the matrices are stored in the same order (the
+  // entries are combined by their position in memory)
+  check_same_order(matrix_one, matrix_two);
+  
   // Check whether the solution matrix has allocated memory, otherwise
-  // allocate it here!!!
+  // allocate it here (in the same order as the operands)!!!
   if (!solution_matrix.is_own_memory_allocated())
    {
     // Allocate memory for the matrix
+    solution_matrix.set_column_major(matrix_one.is_column_major());
     solution_matrix.allocate_memory(n_rows_matrix_one, n_columns_matrix_one);
    }
   else
    {
+    // Check the order of the solution matrix
+    check_same_order(matrix_one, solution_matrix);
+    
     // Check whether the dimension of the solution matrix are correct
     const unsigned long n_rows_solution_matrix = solution_matrix.n_rows();
     const unsigned long n_columns_solution_matrix = solution_matrix.n_columns();
@@ -1179,15 +1517,8 @@ namespace scicellxx
   T *matrix_one_pt = matrix_one.matrix_pt();
   T *matrix_two_pt = matrix_two.matrix_pt();
   // Perform the substraction
-  for (unsigned long i = 0; i < n_rows_matrix_one; i++)
-   {
-    const unsigned long offset = i*n_columns_matrix_one;
-    for (unsigned long j = 0; j < n_columns_matrix_one; j++)
-     {
-      solution_matrix_pt[offset+j] =
-       matrix_one_pt[offset+j] - matrix_two_pt[offset+j];
-     }
-   }
+  ParallelKernels::substract(n_rows_matrix_one*n_columns_matrix_one,
+                             matrix_one_pt, matrix_two_pt, solution_matrix_pt);
   
  }
  
@@ -1235,14 +1566,21 @@ namespace scicellxx
                            SCICELLXX_EXCEPTION_LOCATION);
    }
   
+  // Check that the matrices are stored in the same order
+  check_same_order(left_matrix, right_matrix);
+  
   // Check whether the solution matrix has allocated memory, otherwise
-  // allocate it here!!!
+  // allocate it here (in the same order as the operands)!!!
   if (!solution_matrix.is_own_memory_allocated())
    {
     // Allocate memory for the matrix
+    solution_matrix.set_column_major(left_matrix.is_column_major());
     solution_matrix.allocate_memory(n_rows_left_matrix, n_columns_right_matrix);
    }
   
+  // Check the order of the solution matrix
+  check_same_order(left_matrix, solution_matrix);
+  
   // Check whether the dimension of the solution matrix are correct
   const unsigned long n_rows_solution_matrix = solution_matrix.n_rows();
   const unsigned long n_columns_solution_matrix = solution_matrix.n_columns();
@@ -1271,21 +1609,22 @@ namespace scicellxx
   T *left_matrix_pt = left_matrix.matrix_pt();
   // Get the matrix pointer of the right matrix
   T *right_matrix_pt = right_matrix.matrix_pt();
-  // Perform the multiplication
-  for (unsigned long i = 0; i < n_rows_left_matrix; i++)
+  // Perform the multiplication (cache-blocked kernel). Column major
+  // matrices are stored as their transposes by rows, thus the kernel
+  // computes solution^T = right_matrix^T * left_matrix^T
+  if (!left_matrix.is_column_major())
    {
-    const unsigned offset_left_matrix = i * n_columns_left_matrix;
-    const unsigned offset_right_matrix = i * n_columns_right_matrix;
-    for (unsigned long j = 0; j < n_columns_right_matrix; j++)
-     {
-      // Initialise
-      solution_matrix_pt[offset_right_matrix+j] = 0;
-      for (unsigned long k = 0; k < n_columns_left_matrix; k++)
-       {
-        solution_matrix_pt[offset_right_matrix+j]+=
-         left_matrix_pt[offset_left_matrix+k] * right_matrix_pt[k*n_columns_right_matrix+j];
-       }
-     }
+    GEMMKernels::gemm(n_rows_left_matrix, n_columns_right_matrix, n_columns_left_matrix,
+                      left_matrix_pt, n_columns_left_matrix,
+                      right_matrix_pt, n_columns_right_matrix,
+                      solution_matrix_pt, n_columns_right_matrix);
+   }
+  else
+   {
+    GEMMKernels::gemm(n_columns_right_matrix, n_rows_left_matrix, n_columns_left_matrix,
+                      right_matrix_pt, n_rows_right_matrix,
+                      left_matrix_pt, n_rows_left_matrix,
+                      solution_matrix_pt, n_rows_left_matrix);
    }
  }
  
@@ -1297,13 +1636,62 @@ namespace scicellxx
                                         const CCMatrix<T> &right_matrix,
                                         CCMatrix<T> &concatenated_matrix)
  {
-  // Error message
-  std::ostringstream error_message;
-  error_message << "This method is not currently implemented for this type of matrices"
-                << "Please implemented it yourself" << std::endl;
-  throw SciCellxxLibError(error_message.str(),
-                         SCICELLXX_CURRENT_FUNCTION,
-                         SCICELLXX_EXCEPTION_LOCATION);
+  // Check that the left and the right matrices have memory allocated
+  if (!left_matrix.is_own_memory_allocated() || !right_matrix.is_own_memory_allocated())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "One of the matrices to concatenate has no memory allocated\n"
+                  << "left_matrix.is_own_memory_allocated() = "
+                  << left_matrix.is_own_memory_allocated() << "\n"
+                  << "right_matrix.is_own_memory_allocated() = "
+                  << right_matrix.is_own_memory_allocated() << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                           SCICELLXX_CURRENT_FUNCTION,
+                           SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  // Check that the matrices have the same number of rows
+  const unsigned long n_rows = left_matrix.n_rows();
+  const unsigned long n_columns_left_matrix = left_matrix.n_columns();
+  const unsigned long n_columns_right_matrix = right_matrix.n_columns();
+  if (n_rows != right_matrix.n_rows())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The number of rows of the matrices is not the same:\n"
+                  << "dim(left_matrix) = (" << n_rows << ", "
+                  << n_columns_left_matrix << ")\n"
+                  << "dim(right_matrix) = (" << right_matrix.n_rows() << ", "
+                  << n_columns_right_matrix << ")\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                           SCICELLXX_CURRENT_FUNCTION,
+                           SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  // Allocate memory for the concatenated matrix (if it has not the
+  // correct size)
+  const unsigned long n_columns = n_columns_left_matrix + n_columns_right_matrix;
+  if (!concatenated_matrix.is_own_memory_allocated() ||
+      concatenated_matrix.n_rows() != n_rows ||
+      concatenated_matrix.n_columns() != n_columns)
+   {
+    concatenated_matrix.allocate_memory(n_rows, n_columns);
+   }
+  
+  // Copy each matrix into its block of the concatenated matrix
+  if (n_columns_left_matrix > 0)
+   {
+    CCMatrixView<T> left_block(concatenated_matrix, 0, 0, n_rows, n_columns_left_matrix);
+    left_block.copy(left_matrix);
+   }
+  if (n_columns_right_matrix > 0)
+   {
+    CCMatrixView<T> right_block(concatenated_matrix, 0, n_columns_left_matrix,
+                                n_rows, n_columns_right_matrix);
+    right_block.copy(right_matrix);
+   }
+  
  }
  
  // ================================================================
@@ -1314,13 +1702,75 @@ namespace scicellxx
                                       const CCMatrix<T> &lower_matrix,
                                       CCMatrix<T> &concatenated_matrix)
  {
-  // Error message
-  std::ostringstream error_message;
-  error_message << "This method is not currently implemented for this type of matrices"
-                << "Please implemented it yourself" << std::endl;
-  throw SciCellxxLibError(error_message.str(),
-                         SCICELLXX_CURRENT_FUNCTION,
-                         SCICELLXX_EXCEPTION_LOCATION);
+  // Check that the upper and the lower matrices have memory allocated
+  if (!upper_matrix.is_own_memory_allocated() || !lower_matrix.is_own_memory_allocated())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "One of the matrices to concatenate has no memory allocated\n"
+                  << "upper_matrix.is_own_memory_allocated() = "
+                  << upper_matrix.is_own_memory_allocated() << "\n"
+                  << "lower_matrix.is_own_memory_allocated() = "
+                  << lower_matrix.is_own_memory_allocated() << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                           SCICELLXX_CURRENT_FUNCTION,
+                           SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  // Check that the matrices have the same number of columns
+  const unsigned long n_columns = upper_matrix.n_columns();
+  const unsigned long n_rows_upper_matrix = upper_matrix.n_rows();
+  const unsigned long n_rows_lower_matrix = lower_matrix.n_rows();
+  if (n_columns != lower_matrix.n_columns())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The number of columns of the matrices is not the same:\n"
+                  << "dim(upper_matrix) = (" << n_rows_upper_matrix << ", "
+                  << n_columns << ")\n"
+                  << "dim(lower_matrix) = (" << n_rows_lower_matrix << ", "
+                  << lower_matrix.n_columns() << ")\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                           SCICELLXX_CURRENT_FUNCTION,
+                           SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  // Allocate memory for the concatenated matrix (if it has not the
+  // correct size)
+  const unsigned long n_rows = n_rows_upper_matrix + n_rows_lower_matrix;
+  if (!concatenated_matrix.is_own_memory_allocated() ||
+      concatenated_matrix.n_rows() != n_rows ||
+      concatenated_matrix.n_columns() != n_columns)
+   {
+    concatenated_matrix.allocate_memory(n_rows, n_columns);
+   }
+  
+  // If all the matrices are stored by rows then each one is a single
+  // block of the concatenated matrix
+  if (!upper_matrix.is_column_major() && !lower_matrix.is_column_major() &&
+      !concatenated_matrix.is_column_major())
+   {
+    BulkKernels::copy(n_rows_upper_matrix*n_columns, upper_matrix.matrix_pt(), 1,
+                      concatenated_matrix.matrix_pt(), 1);
+    BulkKernels::copy(n_rows_lower_matrix*n_columns, lower_matrix.matrix_pt(), 1,
+                      concatenated_matrix.matrix_pt() + n_rows_upper_matrix*n_columns, 1);
+   }
+  else
+   {
+    // Copy each matrix into its block of the concatenated matrix
+    if (n_rows_upper_matrix > 0)
+     {
+      CCMatrixView<T> upper_block(concatenated_matrix, 0, 0, n_rows_upper_matrix, n_columns);
+      upper_block.copy(upper_matrix);
+     }
+    if (n_rows_lower_matrix > 0)
+     {
+      CCMatrixView<T> lower_block(concatenated_matrix, n_rows_upper_matrix, 0,
+                                  n_rows_lower_matrix, n_columns);
+      lower_block.copy(lower_matrix);
+     }
+   }
+  
  }
  
  // ================================================================
@@ -1426,8 +1876,9 @@ namespace scicellxx
 
    }
   
-  // Get the matrix pointer of the solution matrix
-  T *solution_matrix_pt = solution_matrix.matrix_pt();
+  // Get the memory of the solution matrix (it may be stored by rows
+  // or by columns)
+  const CCMatrixSpan<T> solution = solution_matrix.span();
   
   // Get both vectors and multiply them
   T *left_vector_pt = left_vector.vector_pt();
@@ -1437,14 +1888,13 @@ namespace scicellxx
   for (unsigned long i = 0; i < n_rows_left_vector; i++)
    {
     const unsigned offset_left_vector = i * n_columns_left_vector;
-    const unsigned offset_right_vector = i * n_columns_right_vector;
     for (unsigned long j = 0; j < n_columns_right_vector; j++)
      {
       // Initialise
-      solution_matrix_pt[offset_right_vector+j] = 0;
+      solution(i, j) = 0;
       for (unsigned long k = 0; k < n_columns_left_vector; k++)
        {
-        solution_matrix_pt[offset_right_vector+j]+=
+        solution(i, j)+=
          left_vector_pt[offset_left_vector+k] * right_vector_pt[k*n_columns_right_vector+j];
        }
      }
@@ -1542,26 +1992,25 @@ namespace scicellxx
 
    }
   
-  // Get the matrix pointer of the solution matrix
-  T *solution_matrix_pt = solution_matrix.matrix_pt();
+  // Get the memory of the solution matrix and of the matrix (they
+  // may be stored by rows or by columns)
+  const CCMatrixSpan<T> solution = solution_matrix.span();
+  const CCMatrixSpan<T> A = matrix.span();
   
-  // Get both the vector and the matrix pointer
+  // Get the vector pointer
   T *vector_pt = vector.vector_pt();
-  T *matrix_pt = matrix.matrix_pt();
   
   // Perform the multiplication
   for (unsigned long i = 0; i < n_rows_vector; i++)
    {
     const unsigned offset_vector = i * n_columns_vector;
-    const unsigned offset_matrix = i * n_columns_matrix;
     for (unsigned long j = 0; j < n_columns_matrix; j++)
      {
       // Initialise
-      solution_matrix_pt[offset_matrix+j] = 0;
+      solution(i, j) = 0;
       for (unsigned long k = 0; k < n_columns_vector; k++)
        {
-        solution_matrix_pt[offset_matrix+j]+=
-         vector_pt[offset_vector+k] * matrix_pt[k*n_columns_matrix+j];
+        solution(i, j)+= vector_pt[offset_vector+k] * A(k, j);
        }
      }
    }
@@ -1644,7 +2093,7 @@ namespace scicellxx
    }
   
   // Compute the dimensions for the solution vector
-  const unsigned n_rows_solution_vector = n_columns_matrix;
+  const unsigned n_rows_solution_vector = n_rows_matrix;
   const unsigned n_columns_solution_vector = n_columns_vector;
   
   // Check whether the solution vector has allocated memory, otherwise
@@ -1682,19 +2131,22 @@ namespace scicellxx
   T *matrix_pt = matrix.matrix_pt();
   T *vector_pt = vector.vector_pt();
   
-  // Perform the multiplication
-  for (unsigned long i = 0; i < n_rows_solution_vector; i++)
+  // Perform the multiplication (the rows are computed in parallel for
+  // large matrices)
+  if (!matrix.is_column_major())
    {
-    const unsigned offset_matrix = i * n_columns_matrix;
-    const unsigned offset_vector = i * n_columns_vector;
-    // We can skip one loop since there is only one column
-    
-    // Initialise
-    solution_vector_pt[offset_vector] = 0;
-    for (unsigned long k = 0; k < n_columns_matrix; k++)
+    ParallelKernels::matrix_times_vector(n_rows_solution_vector, n_columns_matrix,
+                                         matrix_pt, vector_pt, solution_vector_pt);
+   }
+  else
+   {
+    // The matrix is stored by columns, add each column scaled by the
+    // corresponding entry of the vector
+    std::fill(solution_vector_pt, solution_vector_pt + n_rows_solution_vector, T(0));
+    for (unsigned long j = 0; j < n_columns_matrix; j++)
      {
-      solution_vector_pt[offset_vector]+=
-       matrix_pt[offset_matrix+k] * vector_pt[k];
+      BulkKernels::axpy(n_rows_solution_vector, vector_pt[j],
+                        matrix_pt + j*n_rows_matrix, 1, solution_vector_pt, 1);
      }
    }
   
@@ -10,13 +10,24 @@
 // We include the cc_vector class to deal with vector-matrices
 // operations
 #include "cc_vector.h"
+// Cache-blocked kernels for matrix-matrix multiplication
+#include "gemm_kernels.h"
+// The allocator for the entries of the matrix
+#include "../general/memory_allocator.h"
+// Parallel element-wise operations and matrix times vector
+#include "parallel_kernels.h"
+// Cache-oblivious and in-place transpose
+#include "transpose_kernels.h"
+// Views of sub-blocks, used to concatenate matrices
+#include "cc_matrix_view.h"
 
 namespace scicellxx
 {
 
  // Concrete class to represent matrices
  template<class T>
- class CCMatrix : public virtual ACMatrix<T>
+ class CCMatrix : public virtual ACMatrix<T>,
+ public CCMatrixExpression<T, CCMatrix<T> >
  {
   
  public:
@@ -37,23 +48,46 @@ namespace scicellxx
   // operators overloading as sum and assignment)
   CCMatrix(const CCMatrix &copy);
   
+  // Move constructor, takes the memory of the source matrix if it is
+  // allowed to be deleted by it, otherwise the entries are copied. The
+  // source matrix is left empty
+  CCMatrix(CCMatrix &&source_matrix);
+  
+  // Constructor from an expression (A + B, h * A, ...), the
+  // expression is evaluated in a single loop
+  template<class E>
+   CCMatrix(const CCMatrixExpression<T, E> &expression);
+  
   // Destructor
   virtual ~CCMatrix();
   
   // Assignment operator
   CCMatrix &operator=(const CCMatrix &source_matrix);
   
+  // Move assignment operator, same rules as in the move constructor
+  CCMatrix &operator=(CCMatrix &&source_matrix);
+  
   // += operator
   CCMatrix &operator+=(const CCMatrix &matrix);
   
   // -= operator
   CCMatrix &operator-=(const CCMatrix &matrix);
   
-  // Add operator
-  CCMatrix operator+(const CCMatrix &matrix);
+  // Assignment from an expression (A + B, h * A, ...), the
+  // expression is evaluated in a single loop with no temporaries
+  template<class E>
+   CCMatrix &operator=(const CCMatrixExpression<T, E> &expression);
+  
+  // += operator for expressions
+  template<class E>
+   CCMatrix &operator+=(const CCMatrixExpression<T, E> &expression);
   
-  // Substraction operator
-  CCMatrix operator-(const CCMatrix &matrix);
+  // -= operator for expressions
+  template<class E>
+   CCMatrix &operator-=(const CCMatrixExpression<T, E> &expression);
+  
+  // The add (+) and substraction (-) operators are implemented by
+  // means of expression templates, check cc_expressions.h
   
   // Multiplication operator
   CCMatrix operator*(const CCMatrix &right_matrix);
@@ -74,6 +108,16 @@ namespace scicellxx
                   const unsigned long m,
                   const unsigned long n);
   
+  // Uses the given memory to store the entries of an m X n matrix,
+  // the entries are not copied and the memory is not released by the
+  // matrix, it must remain valid while the matrix uses it (until
+  // clean_up() or the destructor are called). The entries are stored
+  // by columns if column_major is true
+  void share_matrix(T *matrix_pt,
+                    const unsigned long m,
+                    const unsigned long n,
+                    const bool column_major = false);
+  
   // Clean up for any dynamically stored data
   void clean_up();
   
@@ -121,11 +165,58 @@ namespace scicellxx
   
   // Get access to the Matrix_pt
   inline T *matrix_pt() const {return Matrix_pt;}
+  
+  // Is the memory of the entries shared (set by share_matrix())
+  inline bool is_memory_shared() const {return Is_memory_shared;}
+  
+  // Are the entries stored by columns (as in Armadillo and LAPACK)
+  // instead of by rows
+  inline bool is_column_major() const {return Is_column_major;}
+  
+  // Sets the order in which the entries are stored. If the matrix
+  // has memory allocated the entries are reordered in place, thus the
+  // matrix is not changed. A column major matrix may be passed to
+  // Armadillo's solver with no copies
+  void set_column_major(const bool column_major);
+  
+  // Get the span with the memory where the entries are stored
+  inline CCMatrixSpan<T> span() const
+  {
+   if (Is_column_major)
+    {
+     return CCMatrixSpan<T>(Matrix_pt, this->NRows, this->NColumns, 1, this->NRows);
+    }
+   return CCMatrixSpan<T>(Matrix_pt, this->NRows, this->NColumns, this->NColumns, 1);
+  }
+  
+  // Get the k-th entry (in the order in which the entries are stored)
+  // with no range check, used to evaluate expressions
+  inline T entry(const unsigned long k) const {return Matrix_pt[k];}
     
  protected:
-    
+  
+  // Evaluates the expression and stores the result in this matrix
+  template<class E>
+   void evaluate_expression(const E &expression);
+  
+  // Takes the memory of the source matrix (used by the move
+  // constructor and the move assignment operator)
+  void move_matrix(CCMatrix &source_matrix);
+  
+  // Position of the (i,j) entry in Matrix_pt
+  inline unsigned long index(const unsigned long i, const unsigned long j) const
+  {return Is_column_major ? i + j*this->NRows : i*this->NColumns + j;}
+  
   // The matrix
   T *Matrix_pt;
+  
+  // Flag to indicate whether the entries are stored by columns (false
+  // by default)
+  bool Is_column_major;
+  
+  // Flag to indicate whether the memory of the entries is shared, in
+  // which case it is not released by the matrix
+  bool Is_memory_shared;
     
  };
  
@@ -153,13 +244,15 @@ namespace scicellxx
                         const CCMatrix<T> &right_matrix,
                         CCMatrix<T> &solution_matrix);
  
- // Concatenate matrices horizontally
+ // Concatenate matrices horizontally, the entries are copied into
+ // the blocks of the concatenated matrix (use a CCMatrixView of the
+ // blocks to operate on them without copying)
  template<class T>
   void concatenate_matrices_horizontally(const CCMatrix<T> &left_matrix,
                                          const CCMatrix<T> &right_matrix,
                                          CCMatrix<T> &concatenated_matrix);
  
- // Concatenate matrices vertically
+ // Concatenate matrices vertically (same as above)
  template<class T>
   void concatenate_matrices_vertically(const CCMatrix<T> &upper_matrix,
                                        const CCMatrix<T> &lower_matrix,
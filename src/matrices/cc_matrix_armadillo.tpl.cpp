@@ -273,6 +273,54 @@ namespace scicellxx
   this->Is_own_memory_allocated = true;
   
  }
+
+ // ===================================================================
+ // Uses the m X n entries stored by columns at matrix_pt with no copy
+ // ===================================================================
+ template<class T>
+ void CCMatrixArmadillo<T>::share_matrix(T *matrix_pt,
+                                         const unsigned long m,
+                                         const unsigned long n)
+ {
+  // Clean any possible previously allocated memory
+  clean_up();
+  
+  // Set the number of rows and columns
+  this->NRows = m;
+  this->NColumns = n;
+  
+  // Create an Armadillo's matrix that uses the given memory (the
+  // memory is not copied nor released by Armadillo and the size of
+  // the matrix can not be changed)
+  Arma_matrix_pt = new arma::Mat<T>(matrix_pt, m, n, false, true);
+  
+  // Mark the matrix as having memory (only the Armadillo's matrix is
+  // deleted by clean_up())
+  this->Is_own_memory_allocated = true;
+  
+ }
+ 
+ // ===================================================================
+ // Uses the entries of a CCMatrix stored by columns with no copy
+ // ===================================================================
+ template<class T>
+ void CCMatrixArmadillo<T>::share_matrix(CCMatrix<T> &matrix)
+ {
+  // Armadillo stores the entries by columns
+  if (!matrix.is_column_major() && matrix.n_rows() > 1 && matrix.n_columns() > 1)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The entries of the matrix are stored by rows, Armadillo\n"
+                  << "requires them by columns. Call set_column_major(true) on\n"
+                  << "the matrix before sharing its memory" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  share_matrix(matrix.matrix_pt(), matrix.n_rows(), matrix.n_columns());
+ }
  
  // ===================================================================
  // Clean up for any dynamically stored data
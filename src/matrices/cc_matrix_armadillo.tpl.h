@@ -41,6 +41,7 @@ namespace scicellxx
    CCMatrixArmadillo(T *matrix_pt, const unsigned long m, const unsigned long n);
    
    // Constructor that creates an Armadillo's matrix from a CCMatrix
+   // (the entries are copied, use share_matrix() to avoid the copy)
    CCMatrixArmadillo(CCMatrix<T> &matrix);
    
    // Constructor that creates an Armadillo's matrix from a CCVector
@@ -94,6 +95,18 @@ namespace scicellxx
                    const unsigned long m,
                    const unsigned long n);
    
+   // Uses the m X n entries stored by columns at matrix_pt with no
+   // copy (Armadillo's advanced constructor). The memory is not
+   // released by this matrix, thus it must outlive it
+   void share_matrix(T *matrix_pt,
+                     const unsigned long m,
+                     const unsigned long n);
+   
+   // Uses the entries of a CCMatrix with no copy, the CCMatrix must
+   // store its entries by columns (set_column_major(true)) and must
+   // outlive this matrix
+   void share_matrix(CCMatrix<T> &matrix);
+   
    // Clean up for any dynamically stored data
    void clean_up();
   
@@ -142,6 +155,18 @@ namespace scicellxx
    // Get access to the Armadillo's matrix
    inline arma::Mat<T> *arma_matrix_pt() const {return Arma_matrix_pt;}
    
+   // Get the span with the memory where the entries are stored
+   // (Armadillo stores the matrices in column major order)
+   inline CCMatrixSpan<T> span() const
+   {
+    if (Arma_matrix_pt == 0)
+     {
+      return CCMatrixSpan<T>();
+     }
+    return CCMatrixSpan<T>(Arma_matrix_pt->memptr(), this->NRows, this->NColumns,
+                           1, this->NRows);
+   }
+   
   protected:
    
    // The Aramadillo's type matrix
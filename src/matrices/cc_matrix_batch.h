@@ -0,0 +1,7 @@
+// Include header and tpl.cpp files implementing templates. We may use
+// this file to force the instantiation of specific templates
+#ifndef CCMATRIXBATCH_H
+#define CCMATRIXBATCH_H
+#include "cc_matrix_batch.tpl.h"
+#include "cc_matrix_batch.tpl.cpp"
+#endif // #ifndef CCMATRIXBATCH_H
@@ -0,0 +1,404 @@
+// IN THIS FILE: Implementation of a concrete class to represent a
+// batch of matrices with interleaved entries, and of the batched
+// matrix times matrix and matrix times vector
+
+#include "cc_matrix_batch.tpl.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ // Empty constructor
+ // ===================================================================
+ template<class T>
+ CCMatrixBatch<T>::CCMatrixBatch()
+  : N_batch(0), NRows(0), NColumns(0), Data_pt(0)
+ { }
+
+ // ===================================================================
+ // Constructor to create a batch of n_batch zero matrices of size m
+ // X n
+ // ===================================================================
+ template<class T>
+ CCMatrixBatch<T>::CCMatrixBatch(const unsigned long n_batch,
+                                 const unsigned long m,
+                                 const unsigned long n)
+  : N_batch(0), NRows(0), NColumns(0), Data_pt(0)
+ {
+  allocate_memory(n_batch, m, n);
+ }
+
+ // ===================================================================
+ // Copy constructor
+ // ===================================================================
+ template<class T>
+ CCMatrixBatch<T>::CCMatrixBatch(const CCMatrixBatch<T> &copy)
+  : N_batch(0), NRows(0), NColumns(0), Data_pt(0)
+ {
+  if (copy.data_pt() != 0)
+   {
+    allocate_memory(copy.n_batch(), copy.n_rows(), copy.n_columns());
+    std::copy(copy.data_pt(), copy.data_pt() + N_batch * NRows * NColumns, Data_pt);
+   }
+ }
+
+ // ===================================================================
+ // Move constructor
+ // ===================================================================
+ template<class T>
+ CCMatrixBatch<T>::CCMatrixBatch(CCMatrixBatch<T> &&source_batch)
+  : N_batch(0), NRows(0), NColumns(0), Data_pt(0)
+ {
+  // Take the memory of the source batch
+  move_batch(source_batch);
+ }
+
+ // ===================================================================
+ // Destructor
+ // ===================================================================
+ template<class T>
+ CCMatrixBatch<T>::~CCMatrixBatch()
+ {
+  // Deallocate memory
+  clean_up();
+ }
+
+ // ===================================================================
+ // Assignment operator
+ // ===================================================================
+ template<class T>
+ CCMatrixBatch<T>& CCMatrixBatch<T>::operator=(const CCMatrixBatch<T> &source_batch)
+ {
+  // Check for self-assignment
+  if (this != &source_batch)
+   {
+    clean_up();
+    if (source_batch.data_pt() != 0)
+     {
+      allocate_memory(source_batch.n_batch(), source_batch.n_rows(),
+                      source_batch.n_columns());
+      std::copy(source_batch.data_pt(),
+                source_batch.data_pt() + N_batch * NRows * NColumns, Data_pt);
+     }
+   }
+
+  // Return this (de-referenced pointer)
+  return *this;
+ }
+
+ // ===================================================================
+ // Move assignment operator
+ // ===================================================================
+ template<class T>
+ CCMatrixBatch<T>& CCMatrixBatch<T>::operator=(CCMatrixBatch<T> &&source_batch)
+ {
+  // Check for self-assignment
+  if (this != &source_batch)
+   {
+    // Clean-up and take the memory of the source batch
+    clean_up();
+    move_batch(source_batch);
+   }
+
+  // Return this (de-referenced pointer)
+  return *this;
+ }
+
+ // ===================================================================
+ // Allows to create a batch of n_batch matrices of size m X n, all
+ // the entries are zero
+ // ===================================================================
+ template<class T>
+ void CCMatrixBatch<T>::allocate_memory(const unsigned long n_batch,
+                                        const unsigned long m,
+                                        const unsigned long n)
+ {
+  // Clean any possibly stored data
+  clean_up();
+
+  N_batch = n_batch;
+  NRows = m;
+  NColumns = n;
+
+  // A single allocation for all the matrices
+  const unsigned long n_entries = n_batch * m * n;
+  Data_pt = MemoryAllocator::new_array<T>(n_entries);
+  std::fill(Data_pt, Data_pt + n_entries, T(0));
+ }
+
+ // ===================================================================
+ // Fills the matrices with zeroes
+ // ===================================================================
+ template<class T>
+ void CCMatrixBatch<T>::fill_with_zeroes()
+ {
+  // Check that the batch has memory allocated
+  if (Data_pt != 0)
+   {
+    std::fill(Data_pt, Data_pt + N_batch * NRows * NColumns, T(0));
+   }
+  else
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The batch of matrices has no memory allocated\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+ }
+
+ // ===================================================================
+ // Clean up for any dynamically stored data
+ // ===================================================================
+ template<class T>
+ void CCMatrixBatch<T>::clean_up()
+ {
+  if (Data_pt != 0)
+   {
+    MemoryAllocator::delete_array(Data_pt);
+    Data_pt = 0;
+   }
+  N_batch = 0;
+  NRows = 0;
+  NColumns = 0;
+ }
+
+ // ===================================================================
+ // Copies the input matrix into the b-th matrix of the batch
+ // ===================================================================
+ template<class T>
+ void CCMatrixBatch<T>::set_matrix(const unsigned long b, const ACMatrix<T> &matrix)
+ {
+  if (b >= N_batch || matrix.n_rows() != NRows || matrix.n_columns() != NColumns)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix can not be stored in the batch\n"
+                  << "Batch member: " << b << " (batch size: " << N_batch << ")\n"
+                  << "Size of the matrix: " << matrix.n_rows() << " X "
+                  << matrix.n_columns() << " (size of the matrices in the batch: "
+                  << NRows << " X " << NColumns << ")\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  for (unsigned long i = 0; i < NRows; i++)
+   {
+    for (unsigned long j = 0; j < NColumns; j++)
+     {
+      Data_pt[(i * NColumns + j) * N_batch + b] = matrix.value(i, j);
+     }
+   }
+ }
+
+ // ===================================================================
+ // Copies the b-th matrix of the batch into the output matrix, the
+ // output matrix is allocated if its size is different
+ // ===================================================================
+ template<class T>
+ void CCMatrixBatch<T>::get_matrix(const unsigned long b, CCMatrix<T> &matrix) const
+ {
+  if (b >= N_batch)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The batch member is out of range\n"
+                  << "Batch member: " << b << " (batch size: " << N_batch << ")\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  if (matrix.n_rows() != NRows || matrix.n_columns() != NColumns ||
+      !matrix.is_own_memory_allocated())
+   {
+    matrix.allocate_memory(NRows, NColumns);
+   }
+
+  for (unsigned long i = 0; i < NRows; i++)
+   {
+    for (unsigned long j = 0; j < NColumns; j++)
+     {
+      matrix(i, j) = Data_pt[(i * NColumns + j) * N_batch + b];
+     }
+   }
+ }
+
+ // ===================================================================
+ // Takes the memory of the source batch (used by the move
+ // constructor and the move assignment operator)
+ // ===================================================================
+ template<class T>
+ void CCMatrixBatch<T>::move_batch(CCMatrixBatch<T> &source_batch)
+ {
+  N_batch = source_batch.N_batch;
+  NRows = source_batch.NRows;
+  NColumns = source_batch.NColumns;
+  Data_pt = source_batch.Data_pt;
+
+  // The source batch is left empty
+  source_batch.N_batch = 0;
+  source_batch.NRows = 0;
+  source_batch.NColumns = 0;
+  source_batch.Data_pt = 0;
+ }
+
+ // ================================================================
+ // Extra methods to work with batches of matrices and vectors
+ // ================================================================
+
+ // ================================================================
+ // Multiply each matrix of the batch A times the matrix of the batch
+ // B with the same index, C_b = A_b * B_b. The products of each group
+ // of batch members are accumulated in the type given by
+ // AccumulatorTraits (double for float entries), the innermost loop
+ // runs over the members of the group
+ // ================================================================
+ template<class T>
+ void multiply_matrices(const CCMatrixBatch<T> &matrix_one,
+                        const CCMatrixBatch<T> &matrix_two,
+                        CCMatrixBatch<T> &solution_matrix)
+ {
+  const unsigned long n_batch = matrix_one.n_batch();
+  const unsigned long m = matrix_one.n_rows();
+  const unsigned long p = matrix_one.n_columns();
+  const unsigned long n = matrix_two.n_columns();
+
+  if (matrix_two.n_batch() != n_batch || matrix_two.n_rows() != p)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The batches of matrices can not be multiplied\n"
+                  << "Batch one: " << n_batch << " matrices of size "
+                  << m << " X " << p << "\n"
+                  << "Batch two: " << matrix_two.n_batch() << " matrices of size "
+                  << matrix_two.n_rows() << " X " << n << "\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  if (solution_matrix.n_batch() != n_batch || solution_matrix.n_rows() != m ||
+      solution_matrix.n_columns() != n || solution_matrix.data_pt() == 0)
+   {
+    solution_matrix.allocate_memory(n_batch, m, n);
+   }
+
+  typedef typename AccumulatorTraits<T>::Accumulator_type ACC;
+  const T *a = matrix_one.data_pt();
+  const T *b = matrix_two.data_pt();
+  T *c = solution_matrix.data_pt();
+  const unsigned long n_groups = (n_batch + Batch_group_size - 1) / Batch_group_size;
+  ThreadPool::parallel_for(n_groups, [=](const unsigned long begin, const unsigned long end)
+                           {
+                            ACC sum[Batch_group_size];
+                            for (unsigned long g = begin; g < end; g++)
+                             {
+                              const unsigned long first = g * Batch_group_size;
+                              const unsigned long size = std::min(Batch_group_size, n_batch - first);
+                              for (unsigned long i = 0; i < m; i++)
+                               {
+                                for (unsigned long j = 0; j < n; j++)
+                                 {
+                                  for (unsigned long l = 0; l < size; l++)
+                                   {
+                                    sum[l] = 0.0;
+                                   }
+                                  for (unsigned long k = 0; k < p; k++)
+                                   {
+                                    const T *a_ik = a + (i * p + k) * n_batch + first;
+                                    const T *b_kj = b + (k * n + j) * n_batch + first;
+                                    for (unsigned long l = 0; l < size; l++)
+                                     {
+                                      sum[l]+= ACC(a_ik[l]) * ACC(b_kj[l]);
+                                     }
+                                   }
+                                  T *c_ij = c + (i * n + j) * n_batch + first;
+                                  for (unsigned long l = 0; l < size; l++)
+                                   {
+                                    c_ij[l] = T(sum[l]);
+                                   }
+                                 }
+                               }
+                             }
+                           }, Batch_group_size * m * n * p);
+ }
+
+ // ================================================================
+ // Multiply each matrix of the batch A times the vector of the batch
+ // x with the same index, y_b = A_b * x_b
+ // ================================================================
+ template<class T>
+ void multiply_matrix_times_vector(const CCMatrixBatch<T> &matrix,
+                                   const CCVectorBatch<T> &vector,
+                                   CCVectorBatch<T> &solution_vector)
+ {
+  const unsigned long n_batch = matrix.n_batch();
+  const unsigned long m = matrix.n_rows();
+  const unsigned long n = matrix.n_columns();
+
+  if (vector.n_batch() != n_batch || vector.n_values() != n)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The batch of matrices can not be multiplied by the batch\n"
+                  << "of vectors\n"
+                  << "Matrices: " << n_batch << " of size " << m << " X " << n << "\n"
+                  << "Vectors: " << vector.n_batch() << " of size "
+                  << vector.n_values() << "\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  if (solution_vector.n_batch() != n_batch || solution_vector.n_values() != m ||
+      solution_vector.data_pt() == 0)
+   {
+    solution_vector.allocate_memory(n_batch, m);
+   }
+
+  typedef typename AccumulatorTraits<T>::Accumulator_type ACC;
+  const T *a = matrix.data_pt();
+  const T *x = vector.data_pt();
+  T *y = solution_vector.data_pt();
+  const unsigned long n_groups = (n_batch + Batch_group_size - 1) / Batch_group_size;
+  ThreadPool::parallel_for(n_groups, [=](const unsigned long begin, const unsigned long end)
+                           {
+                            ACC sum[Batch_group_size];
+                            for (unsigned long g = begin; g < end; g++)
+                             {
+                              const unsigned long first = g * Batch_group_size;
+                              const unsigned long size = std::min(Batch_group_size, n_batch - first);
+                              for (unsigned long i = 0; i < m; i++)
+                               {
+                                for (unsigned long l = 0; l < size; l++)
+                                 {
+                                  sum[l] = 0.0;
+                                 }
+                                for (unsigned long j = 0; j < n; j++)
+                                 {
+                                  const T *a_ij = a + (i * n + j) * n_batch + first;
+                                  const T *x_j = x + j * n_batch + first;
+                                  for (unsigned long l = 0; l < size; l++)
+                                   {
+                                    sum[l]+= ACC(a_ij[l]) * ACC(x_j[l]);
+                                   }
+                                 }
+                                T *y_i = y + i * n_batch + first;
+                                for (unsigned long l = 0; l < size; l++)
+                                 {
+                                  y_i[l] = T(sum[l]);
+                                 }
+                               }
+                             }
+                           }, Batch_group_size * m * n);
+ }
+
+}
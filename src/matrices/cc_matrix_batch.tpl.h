@@ -0,0 +1,160 @@
+// IN THIS FILE: The definition of a concrete class to store a batch
+// of independent matrices of the same size in a single allocation
+// (for example the Jacobians of many small systems of ODEs, one per
+// cell). The entries are interleaved, the (i, j) entry of all the
+// matrices of the batch are contiguous in memory, thus the loops over
+// the members of the batch are mapped by the compiler to SIMD
+// registers (one member of the batch per lane) instead of working on
+// each small matrix by itself, whose rows are too short to fill them.
+// The batched matrix times matrix and matrix times vector are
+// implemented here, the batched LU solver is in the linear solvers
+// (CCBatchedLUSolver)
+
+// Check whether the class has been already defined
+#ifndef CCMATRIXBATCH_TPL_H
+#define CCMATRIXBATCH_TPL_H
+
+// The matrices stored in the batch
+#include "cc_matrix.h"
+// The batches of vectors
+#include "cc_vector_batch.h"
+// The allocator for the entries
+#include "../general/memory_allocator.h"
+// To work on groups of batch members in parallel
+#include "../general/thread_pool.h"
+// The type used to accumulate the products
+#include "accumulator_traits.h"
+
+namespace scicellxx
+{
+
+ /// @class CCMatrixBatch cc_matrix_batch.h
+
+ // Concrete class to represent a batch of n_batch matrices of size m
+ // X n. The (i, j) entry of the b-th matrix is stored at
+ // Data_pt[(i * n + j) * N_batch + b]
+ template<class T>
+ class CCMatrixBatch
+ {
+
+ public:
+
+  // Empty constructor
+  CCMatrixBatch();
+
+  // Constructor to create a batch of n_batch zero matrices of size m
+  // X n
+  CCMatrixBatch(const unsigned long n_batch, const unsigned long m,
+                const unsigned long n);
+
+  // Copy constructor
+  CCMatrixBatch(const CCMatrixBatch &copy);
+
+  // Move constructor, the source batch is left empty
+  CCMatrixBatch(CCMatrixBatch &&source_batch);
+
+  // Destructor
+  virtual ~CCMatrixBatch();
+
+  // Assignment operator
+  CCMatrixBatch &operator=(const CCMatrixBatch &source_batch);
+
+  // Move assignment operator, the source batch is left empty
+  CCMatrixBatch &operator=(CCMatrixBatch &&source_batch);
+
+  // Allows to create a batch of n_batch matrices of size m X n, all
+  // the entries are zero
+  void allocate_memory(const unsigned long n_batch, const unsigned long m,
+                       const unsigned long n);
+
+  // Fills the matrices with zeroes
+  void fill_with_zeroes();
+
+  // Clean up for any dynamically stored data
+  void clean_up();
+
+  // Copies the input matrix into the b-th matrix of the batch
+  void set_matrix(const unsigned long b, const ACMatrix<T> &matrix);
+
+  // Copies the b-th matrix of the batch into the output matrix, the
+  // output matrix is allocated if its size is different
+  void get_matrix(const unsigned long b, CCMatrix<T> &matrix) const;
+
+  // Get the (i, j) entry of the b-th matrix (read-only)
+  inline const T value(const unsigned long b, const unsigned long i,
+                       const unsigned long j) const
+  {return Data_pt[(i * NColumns + j) * N_batch + b];}
+
+  // Set the (i, j) entry of the b-th matrix (write version)
+  inline T &value(const unsigned long b, const unsigned long i,
+                  const unsigned long j)
+  {return Data_pt[(i * NColumns + j) * N_batch + b];}
+
+  // Get the (i, j) entry of the b-th matrix (read-only)
+  inline const T operator()(const unsigned long b, const unsigned long i,
+                            const unsigned long j) const
+  {return value(b, i, j);}
+
+  // Set the (i, j) entry of the b-th matrix (write version)
+  inline T &operator()(const unsigned long b, const unsigned long i,
+                       const unsigned long j)
+  {return value(b, i, j);}
+
+  // The number of matrices in the batch
+  inline unsigned long n_batch() const {return N_batch;}
+
+  // The number of rows of each matrix
+  inline unsigned long n_rows() const {return NRows;}
+
+  // The number of columns of each matrix
+  inline unsigned long n_columns() const {return NColumns;}
+
+  // Get access to the interleaved entries
+  inline T *data_pt() const {return Data_pt;}
+
+ protected:
+
+  // Takes the memory of the source batch (used by the move
+  // constructor and the move assignment operator)
+  void move_batch(CCMatrixBatch &source_batch);
+
+  // The number of matrices in the batch
+  unsigned long N_batch;
+
+  // The number of rows of each matrix
+  unsigned long NRows;
+
+  // The number of columns of each matrix
+  unsigned long NColumns;
+
+  // The interleaved entries
+  T *Data_pt;
+
+ };
+
+ // ================================================================
+ // Extra methods to work with batches of matrices and vectors
+ // ================================================================
+
+ // The number of consecutive batch members processed together by the
+ // batched operations. Groups of batch members are distributed among
+ // the threads of the pool
+ const unsigned long Batch_group_size = 64;
+
+ // Multiply each matrix of the batch A times the matrix of the batch
+ // B with the same index, C_b = A_b * B_b
+ template<class T>
+  void multiply_matrices(const CCMatrixBatch<T> &matrix_one,
+                         const CCMatrixBatch<T> &matrix_two,
+                         CCMatrixBatch<T> &solution_matrix);
+
+ // Multiply each matrix of the batch A times the vector of the batch
+ // x with the same index, y_b = A_b * x_b
+ template<class T>
+  void multiply_matrix_times_vector(const CCMatrixBatch<T> &matrix,
+                                    const CCVectorBatch<T> &vector,
+                                    CCVectorBatch<T> &solution_vector);
+
+}
+
+#endif // #ifndef CCMATRIXBATCH_TPL_H
@@ -0,0 +1,7 @@
+// Include header and tpl.cpp files implementing templates. We may use
+// this file to force the instantiation of specific templates
+#ifndef CCMATRIXVIEW_H
+#define CCMATRIXVIEW_H
+#include "cc_matrix_view.tpl.h"
+#include "cc_matrix_view.tpl.cpp"
+#endif // #ifndef CCMATRIXVIEW_H
@@ -0,0 +1,559 @@
+// IN THIS FILE: Implementation of a concrete class to refer to the
+// entries of a matrix stored somewhere else (a view)
+
+#include "cc_matrix_view.tpl.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ // Empty constructor, the view refers to no entries
+ // ===================================================================
+ template<class T>
+ CCMatrixView<T>::CCMatrixView()
+  : ACMatrix<T>(), Data_pt(0), Row_stride(0), Column_stride(1)
+ {
+  // The entries are not owned by the view
+  this->Delete_matrix = false;
+ }
+
+ // ===================================================================
+ // View of an m X n matrix starting at data_pt with the given strides
+ // ===================================================================
+ template<class T>
+ CCMatrixView<T>::CCMatrixView(T *data_pt,
+                               const unsigned long m, const unsigned long n,
+                               const unsigned long row_stride,
+                               const unsigned long column_stride)
+  : ACMatrix<T>(m, n), Data_pt(0), Row_stride(0), Column_stride(1)
+ {
+  // The entries are not owned by the view
+  this->Delete_matrix = false;
+  set_view(data_pt, m, n, row_stride, column_stride);
+ }
+
+ // ===================================================================
+ // View of the entries described by the span
+ // ===================================================================
+ template<class T>
+ CCMatrixView<T>::CCMatrixView(const CCMatrixSpan<T> &span)
+  : ACMatrix<T>(span.NRows, span.NColumns), Data_pt(0), Row_stride(0),
+    Column_stride(1)
+ {
+  // The entries are not owned by the view
+  this->Delete_matrix = false;
+  set_view(span.Data_pt, span.NRows, span.NColumns, span.Row_stride,
+           span.Column_stride);
+ }
+
+ // ===================================================================
+ // View of all the entries of the matrix
+ // ===================================================================
+ template<class T>
+ CCMatrixView<T>::CCMatrixView(const ACMatrix<T> &matrix)
+  : ACMatrix<T>(matrix.n_rows(), matrix.n_columns()), Data_pt(0),
+    Row_stride(0), Column_stride(1)
+ {
+  // The entries are not owned by the view
+  this->Delete_matrix = false;
+
+  const CCMatrixSpan<T> matrix_span = matrix.span();
+  if (matrix_span.is_empty())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix has no memory allocated or it does not store\n"
+                  << "its entries in a single block of memory" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  set_view(matrix_span.Data_pt, matrix_span.NRows, matrix_span.NColumns,
+           matrix_span.Row_stride, matrix_span.Column_stride);
+ }
+
+ // ===================================================================
+ // View of the m X n sub-block of the matrix whose first entry is
+ // (i, j)
+ // ===================================================================
+ template<class T>
+ CCMatrixView<T>::CCMatrixView(const ACMatrix<T> &matrix,
+                               const unsigned long i, const unsigned long j,
+                               const unsigned long m, const unsigned long n)
+  : ACMatrix<T>(m, n), Data_pt(0), Row_stride(0), Column_stride(1)
+ {
+  // The entries are not owned by the view
+  this->Delete_matrix = false;
+
+  const CCMatrixSpan<T> matrix_span = matrix.span();
+  if (matrix_span.is_empty())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix has no memory allocated or it does not store\n"
+                  << "its entries in a single block of memory" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  if (i + m > matrix_span.NRows || j + n > matrix_span.NColumns)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The block is out of the range of the matrix\n"
+                  << "dim(matrix) = (" << matrix_span.NRows << ", "
+                  << matrix_span.NColumns << ")\n"
+                  << "Requested block: rows [" << i << ", " << i + m
+                  << "), columns [" << j << ", " << j + n << ")"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  set_view(&matrix_span(i, j), m, n, matrix_span.Row_stride,
+           matrix_span.Column_stride);
+ }
+
+ // ===================================================================
+ // Copy constructor, both views refer to the same entries
+ // ===================================================================
+ template<class T>
+ CCMatrixView<T>::CCMatrixView(const CCMatrixView<T> &copy)
+  : ACMatrix<T>(copy.n_rows(), copy.n_columns()), Data_pt(0),
+    Row_stride(0), Column_stride(1)
+ {
+  // The entries are not owned by the view
+  this->Delete_matrix = false;
+  if (copy.data_pt() != 0)
+   {
+    set_view(copy.data_pt(), copy.n_rows(), copy.n_columns(),
+             copy.row_stride(), copy.column_stride());
+   }
+ }
+
+ // ===================================================================
+ // Destructor, the entries are not deleted
+ // ===================================================================
+ template<class T>
+ CCMatrixView<T>::~CCMatrixView()
+ { }
+
+ // ===================================================================
+ // Refer to the m X n matrix starting at data_pt with the given
+ // strides
+ // ===================================================================
+ template<class T>
+ void CCMatrixView<T>::set_view(T *data_pt,
+                                const unsigned long m, const unsigned long n,
+                                const unsigned long row_stride,
+                                const unsigned long column_stride)
+ {
+  if (data_pt == 0)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The view can not refer to a NULL pointer" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  Data_pt = data_pt;
+  this->NRows = m;
+  this->NColumns = n;
+  Row_stride = row_stride;
+  Column_stride = column_stride;
+
+  // The view refers to entries, the operations of ACMatrix check
+  // this flag before accessing them
+  this->Is_own_memory_allocated = true;
+ }
+
+ // ===================================================================
+ // View of the m X n sub-block of this view whose first entry is
+ // (i, j)
+ // ===================================================================
+ template<class T>
+ CCMatrixView<T> CCMatrixView<T>::block(const unsigned long i,
+                                        const unsigned long j,
+                                        const unsigned long m,
+                                        const unsigned long n) const
+ {
+  return CCMatrixView<T>(*this, i, j, m, n);
+ }
+
+ // ===================================================================
+ // View of the i-th row (a row vector)
+ // ===================================================================
+ template<class T>
+ CCVectorView<T> CCMatrixView<T>::row(const unsigned long i) const
+ {
+  check_view();
+  if (i >= this->NRows)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The row is out of the range of the matrix\n"
+                  << "Number of rows: " << this->NRows << "\n"
+                  << "Requested row: " << i << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  return CCVectorView<T>(span().row(i), false);
+ }
+
+ // ===================================================================
+ // View of the j-th column (a column vector)
+ // ===================================================================
+ template<class T>
+ CCVectorView<T> CCMatrixView<T>::column(const unsigned long j) const
+ {
+  check_view();
+  if (j >= this->NColumns)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The column is out of the range of the matrix\n"
+                  << "Number of columns: " << this->NColumns << "\n"
+                  << "Requested column: " << j << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  return CCVectorView<T>(span().column(j), true);
+ }
+
+ // ===================================================================
+ // A view does not allocate memory, throws an error
+ // ===================================================================
+ template<class T>
+ void CCMatrixView<T>::allocate_memory(const unsigned long m,
+                                       const unsigned long n)
+ {
+  // Error message
+  std::ostringstream error_message;
+  error_message << "A view can not allocate memory, use a CCMatrix to store\n"
+                << "the entries and create a view of it" << std::endl;
+  throw SciCellxxLibError(error_message.str(),
+                          SCICELLXX_CURRENT_FUNCTION,
+                          SCICELLXX_EXCEPTION_LOCATION);
+ }
+
+ // ===================================================================
+ // Fills the entries with zeroes
+ // ===================================================================
+ template<class T>
+ void CCMatrixView<T>::fill_with_zeroes()
+ {
+  check_view();
+  for (unsigned long i = 0; i < this->NRows; i++)
+   {
+    for (unsigned long j = 0; j < this->NColumns; j++)
+     {
+      Data_pt[i*Row_stride + j*Column_stride] = T(0);
+     }
+   }
+ }
+
+ // ===================================================================
+ // Copies the input row major matrix into the entries referred by the
+ // view
+ // ===================================================================
+ template<class T>
+ void CCMatrixView<T>::set_matrix(const T *matrix_pt,
+                                  const unsigned long m,
+                                  const unsigned long n)
+ {
+  check_view();
+  if (m != this->NRows || n != this->NColumns)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The dimension of the matrix is not the same as the one\n"
+                  << "of the view:\n"
+                  << "dim(matrix) = (" << m << ", " << n << ")\n"
+                  << "dim(this) = (" << this->NRows << ", "
+                  << this->NColumns << ")" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  for (unsigned long i = 0; i < m; i++)
+   {
+    BulkKernels::copy(n, matrix_pt + i*n, 1, Data_pt + i*Row_stride,
+                      Column_stride);
+   }
+ }
+
+ // ===================================================================
+ // The view stops referring to any entries
+ // ===================================================================
+ template<class T>
+ void CCMatrixView<T>::clean_up()
+ {
+  free_memory_for_matrix();
+ }
+
+ // ===================================================================
+ // The view stops referring to any entries (the entries are not
+ // deleted)
+ // ===================================================================
+ template<class T>
+ void CCMatrixView<T>::free_memory_for_matrix()
+ {
+  Data_pt = 0;
+  this->NRows = 0;
+  this->NColumns = 0;
+  Row_stride = 0;
+  Column_stride = 1;
+  this->Is_own_memory_allocated = false;
+ }
+
+ // ===================================================================
+ // Get the specified value from the matrix (read-only)
+ // ===================================================================
+ template<class T>
+ const T CCMatrixView<T>::value(const unsigned long i,
+                                const unsigned long j) const
+ {
+#ifdef SCICELLXX_RANGE_CHECK
+  check_view();
+  if (i >= this->NRows || j >= this->NColumns)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The entry you are trying to access is out of range\n"
+                  << "Number of rows: " << this->NRows << std::endl
+                  << "Number of columns: " << this->NColumns << std::endl
+                  << "Requested entry: (" << i << ", " << j << ")"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+#endif // #ifdef SCICELLXX_RANGE_CHECK
+  return Data_pt[i*Row_stride + j*Column_stride];
+ }
+
+ // ===================================================================
+ // Set values in the matrix (write version)
+ // ===================================================================
+ template<class T>
+ T &CCMatrixView<T>::value(const unsigned long i, const unsigned long j)
+ {
+#ifdef SCICELLXX_RANGE_CHECK
+  check_view();
+  if (i >= this->NRows || j >= this->NColumns)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The entry you are trying to access is out of range\n"
+                  << "Number of rows: " << this->NRows << std::endl
+                  << "Number of columns: " << this->NColumns << std::endl
+                  << "Requested entry: (" << i << ", " << j << ")"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+#endif // #ifdef SCICELLXX_RANGE_CHECK
+  return Data_pt[i*Row_stride + j*Column_stride];
+ }
+
+ // ===================================================================
+ /// Permute the rows in the list
+ // ===================================================================
+ template<class T>
+ void CCMatrixView<T>::permute_rows(std::vector<std::pair<unsigned long, unsigned long> > &permute_list)
+ {
+  const unsigned long n_permute_list = permute_list.size();
+  for (unsigned long k = 0; k < n_permute_list; k++)
+   {
+    permute_rows(permute_list[k].first, permute_list[k].second);
+   }
+ }
+
+ // ===================================================================
+ /// Permute the columns in the list
+ // ===================================================================
+ template<class T>
+ void CCMatrixView<T>::permute_columns(std::vector<std::pair<unsigned long, unsigned long> > &permute_list)
+ {
+  const unsigned long n_permute_list = permute_list.size();
+  for (unsigned long k = 0; k < n_permute_list; k++)
+   {
+    permute_columns(permute_list[k].first, permute_list[k].second);
+   }
+ }
+
+ // ===================================================================
+ /// Permute rows i and j
+ // ===================================================================
+ template<class T>
+ void CCMatrixView<T>::permute_rows(const unsigned long &i,
+                                    const unsigned long &j)
+ {
+  check_view();
+  if (i >= this->NRows || j >= this->NRows)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "One of the selected rows to permute is larger than\n"
+                  << "the number of rows of the matrix"
+                  << "i: " << i << " j: " << j << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  T *row_i_pt = Data_pt + i*Row_stride;
+  T *row_j_pt = Data_pt + j*Row_stride;
+  for (unsigned long k = 0; k < this->NColumns; k++)
+   {
+    std::swap(row_i_pt[k*Column_stride], row_j_pt[k*Column_stride]);
+   }
+ }
+
+ // ===================================================================
+ /// Permute columns i and j
+ // ===================================================================
+ template<class T>
+ void CCMatrixView<T>::permute_columns(const unsigned long &i,
+                                       const unsigned long &j)
+ {
+  check_view();
+  if (i >= this->NColumns || j >= this->NColumns)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "One of the selected columns to permute is larger than\n"
+                  << "the number of columns of the matrix"
+                  << "i: " << i << " j: " << j << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  T *column_i_pt = Data_pt + i*Column_stride;
+  T *column_j_pt = Data_pt + j*Column_stride;
+  for (unsigned long k = 0; k < this->NRows; k++)
+   {
+    std::swap(column_i_pt[k*Row_stride], column_j_pt[k*Row_stride]);
+   }
+ }
+
+ // ===================================================================
+ // Output the matrix
+ // ===================================================================
+ template<class T>
+ void CCMatrixView<T>::output(bool output_indexes) const
+ {
+  check_view();
+  // Check whether we should output the indexes
+  if (output_indexes)
+   {
+    for (unsigned long i = 0; i < this->NRows; i++)
+     {
+      for (unsigned long j = 0; j < this->NColumns; j++)
+       {
+        std::cout << "(" << i << ", " << j << "): " << value(i,j)
+                  << std::endl;
+       } // for (j < this->NColumns)
+     } // for (i < this->NRows)
+   } // if (output_indexes)
+  else
+   {
+    for (unsigned long i = 0; i < this->NRows; i++)
+     {
+      for (unsigned long j = 0; j < this->NColumns; j++)
+       {
+        std::cout << value(i,j) << " ";
+       } // for (j < this->NColumns)
+      std::cout << std::endl;
+     } // for (i < this->NRows)
+   } // else if (output_indexes)
+
+ }
+
+ // ===================================================================
+ // Output the matrix
+ // ===================================================================
+ template<class T>
+ void CCMatrixView<T>::output(std::ofstream &outfile,
+                              bool output_indexes) const
+ {
+  check_view();
+  // Check whether we should output the indexes
+  if (output_indexes)
+   {
+    for (unsigned long i = 0; i < this->NRows; i++)
+     {
+      for (unsigned long j = 0; j < this->NColumns; j++)
+       {
+        outfile << "(" << i << ", " << j << "): " << value(i,j)
+                << std::endl;
+       } // for (j < this->NColumns)
+     } // for (i < this->NRows)
+   } // if (output_indexes)
+  else
+   {
+    for (unsigned long i = 0; i < this->NRows; i++)
+     {
+      for (unsigned long j = 0; j < this->NColumns; j++)
+       {
+        outfile << value(i,j) << " ";
+       } // for (j < this->NColumns)
+      outfile << std::endl;
+     } // for (i < this->NRows)
+   } // else if (output_indexes)
+
+ }
+
+ // ===================================================================
+ // Get access to the entries, only valid if they are stored by rows
+ // with no padding between them
+ // ===================================================================
+ template<class T>
+ T *CCMatrixView<T>::matrix_pt() const
+ {
+  if (!(Column_stride == 1 && Row_stride == this->NColumns))
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The entries of the view are not stored by rows with no\n"
+                  << "padding between them\n"
+                  << "row_stride() = " << Row_stride << "\n"
+                  << "column_stride() = " << Column_stride << "\n"
+                  << "n_columns() = " << this->NColumns << "\n"
+                  << "Copy the view into a CCMatrix to get a pointer to\n"
+                  << "consecutive entries" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  return Data_pt;
+ }
+
+ // ===================================================================
+ // Checks that the view refers to entries, throws an error otherwise
+ // ===================================================================
+ template<class T>
+ void CCMatrixView<T>::check_view() const
+ {
+  if (Data_pt == 0)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The view does not refer to any entries" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+ }
+
+}
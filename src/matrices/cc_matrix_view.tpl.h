@@ -0,0 +1,172 @@
+// IN THIS FILE: The definition of a concrete class to refer to the
+// entries of a matrix stored somewhere else (a view). The view does
+// not own the memory, no entries are copied when it is created. The
+// rows and columns are separated by strides such that a view may
+// refer to a sub-block of a larger matrix (a block of a Jacobian for
+// example). Any operation on the view modifies the original entries
+
+// Check whether the class has been already defined
+#ifndef CCMATRIXVIEW_TPL_H
+#define CCMATRIXVIEW_TPL_H
+
+// The parent class
+#include "ac_matrix.h"
+// The rows and columns of the view are vector views
+#include "cc_vector_view.h"
+
+namespace scicellxx
+{
+
+ /// @class CCMatrixView cc_matrix_view.h
+
+ // Concrete class to refer to the entries of a matrix stored in memory
+ // not owned by this class. The (i,j) entry is stored at
+ // Data_pt[i*Row_stride + j*Column_stride]. The memory must outlive
+ // the view
+ template<class T>
+  class CCMatrixView : public virtual ACMatrix<T>
+  {
+
+  public:
+
+   // Empty constructor, the view refers to no entries
+   CCMatrixView();
+
+   // View of an m X n matrix starting at data_pt, row_stride is the
+   // number of positions between the first entries of two consecutive
+   // rows and column_stride the one between the first entries of two
+   // consecutive columns
+   CCMatrixView(T *data_pt, const unsigned long m, const unsigned long n,
+                const unsigned long row_stride,
+                const unsigned long column_stride = 1);
+
+   // View of the entries described by the span
+   CCMatrixView(const CCMatrixSpan<T> &span);
+
+   // View of all the entries of the matrix (the matrix should store
+   // its entries in a single block of memory)
+   CCMatrixView(const ACMatrix<T> &matrix);
+
+   // View of the m X n sub-block of the matrix whose first entry is
+   // (i, j)
+   CCMatrixView(const ACMatrix<T> &matrix,
+                const unsigned long i, const unsigned long j,
+                const unsigned long m, const unsigned long n);
+
+   // Copy constructor, both views refer to the same entries
+   CCMatrixView(const CCMatrixView &copy);
+
+   // Destructor, the entries are not deleted
+   virtual ~CCMatrixView();
+
+   // Refer to the m X n matrix starting at data_pt with the given
+   // strides
+   void set_view(T *data_pt, const unsigned long m, const unsigned long n,
+                 const unsigned long row_stride,
+                 const unsigned long column_stride = 1);
+
+   // View of the m X n sub-block of this view whose first entry is
+   // (i, j)
+   CCMatrixView<T> block(const unsigned long i, const unsigned long j,
+                         const unsigned long m, const unsigned long n) const;
+
+   // View of the i-th row (a row vector)
+   CCVectorView<T> row(const unsigned long i) const;
+
+   // View of the j-th column (a column vector)
+   CCVectorView<T> column(const unsigned long j) const;
+
+   // A view does not allocate memory, throws an error
+   void allocate_memory(const unsigned long m,
+                        const unsigned long n);
+
+   // Fills the entries with zeroes
+   void fill_with_zeroes();
+
+   // Copies the input row major matrix into the entries referred by
+   // the view, the size should be the same
+   void set_matrix(const T *matrix_pt,
+                   const unsigned long m,
+                   const unsigned long n);
+
+   // The view stops referring to any entries
+   void clean_up();
+
+   // The view stops referring to any entries (the entries are not
+   // deleted)
+   void free_memory_for_matrix();
+
+   // Get the specified value from the matrix (read-only)
+   const T value(const unsigned long i, const unsigned long j) const;
+
+   // Set values in the matrix (write version)
+   T &value(const unsigned long i, const unsigned long j);
+
+   /// Permute the rows in the list
+   void permute_rows(std::vector<std::pair<unsigned long, unsigned long> > &permute_list);
+
+   /// Permute the columns in the list
+   void permute_columns(std::vector<std::pair<unsigned long, unsigned long> > &permute_list);
+
+   /// Permute rows i and j
+   void permute_rows(const unsigned long &i, const unsigned long &j);
+
+   /// Permute columns i and j
+   void permute_columns(const unsigned long &i, const unsigned long &j);
+
+   // Output the matrix
+   void output(bool output_indexes = false) const;
+
+   // Output to file
+   void output(std::ofstream &outfile, bool output_indexes = false) const;
+
+   // Get the span with the memory where the entries are stored
+   inline CCMatrixSpan<T> span() const
+   {return CCMatrixSpan<T>(Data_pt, this->NRows, this->NColumns, Row_stride, Column_stride);}
+
+   // Get access to the entries, only valid if they are stored by rows
+   // with no padding between them (a view of a whole CCMatrix or of
+   // a set of consecutive rows)
+   T *matrix_pt() const;
+
+   // Get the pointer to the (0,0) entry
+   inline T *data_pt() const {return Data_pt;}
+
+   // Get the number of positions between the first entries of two
+   // consecutive rows
+   inline unsigned long row_stride() const {return Row_stride;}
+
+   // Get the number of positions between the first entries of two
+   // consecutive columns
+   inline unsigned long column_stride() const {return Column_stride;}
+
+  protected:
+
+   // Checks that the view refers to entries, throws an error otherwise
+   void check_view() const;
+
+   // The (0,0) entry
+   T *Data_pt;
+
+   // The number of positions between the first entries of two
+   // consecutive rows
+   unsigned long Row_stride;
+
+   // The number of positions between the first entries of two
+   // consecutive columns
+   unsigned long Column_stride;
+
+  private:
+
+   // Assignment operator (a view is not assigned, use set_view() to
+   // refer to other entries or copy() to copy the entries)
+   CCMatrixView& operator=(const CCMatrixView &copy)
+    {
+     BrokenCopy::broken_assign("CCMatrixView");
+    }
+
+  };
+
+}
+
+#endif // #ifndef CCMATRIXVIEW_TPL_H
@@ -0,0 +1,210 @@
+// IN THIS FILE: Light-weight descriptions of the memory where the
+// entries of dense vectors and matrices are stored (spans), and the
+// strided kernels (copy, axpy and scale) used by the bulk operations
+// of ACVector and ACMatrix. The spans are obtained once per operation
+// such that the inner loops work on raw pointers instead of calling
+// the virtual value() methods per entry. When the library is
+// configured with SCICELLXX_USES_BLAS axpy and scale are computed by
+// BLAS
+
+// Check whether the classes have been already defined
+#ifndef CCSPAN_H
+#define CCSPAN_H
+
+#include "../general/common_includes.h"
+#include "../general/utilities.h"
+// The interface to an optimised BLAS library
+#include "blas_kernels.h"
+
+namespace scicellxx
+{
+
+ // ==================================================================
+ /// The entries of a vector in memory, the i-th entry is stored at
+ /// Data_pt[i*Stride]. An empty span (Data_pt equal to NULL) indicates
+ /// that the entries are not stored in a single block of memory
+ // ==================================================================
+ template<class T>
+  struct CCVectorSpan
+  {
+   // Empty span
+   CCVectorSpan()
+    : Data_pt(0), NValues(0), Stride(1) { }
+
+   // Span of n entries starting at data_pt
+   CCVectorSpan(T *data_pt, const unsigned long n, const unsigned long stride = 1)
+    : Data_pt(data_pt), NValues(n), Stride(stride) { }
+
+   // Is the span empty
+   inline bool is_empty() const {return Data_pt == 0;}
+
+   // Access the i-th entry
+   inline T &operator[](const unsigned long i) const {return Data_pt[i*Stride];}
+
+   // Pointer to the first entry
+   T *Data_pt;
+
+   // Number of entries
+   unsigned long NValues;
+
+   // Number of positions between two consecutive entries
+   unsigned long Stride;
+  };
+
+ // ==================================================================
+ /// The entries of a matrix in memory, the (i,j) entry is stored at
+ /// Data_pt[i*Row_stride + j*Column_stride]. Row major matrices have
+ /// Column_stride equal to one, column major matrices (Armadillo) have
+ /// Row_stride equal to one. An empty span (Data_pt equal to NULL)
+ /// indicates that the entries are not stored in a single block of
+ /// memory (sparse matrices for example)
+ // ==================================================================
+ template<class T>
+  struct CCMatrixSpan
+  {
+   // Empty span
+   CCMatrixSpan()
+    : Data_pt(0), NRows(0), NColumns(0), Row_stride(0), Column_stride(1) { }
+
+   // Span of an m X n matrix starting at data_pt
+   CCMatrixSpan(T *data_pt, const unsigned long m, const unsigned long n,
+                const unsigned long row_stride, const unsigned long column_stride)
+    : Data_pt(data_pt), NRows(m), NColumns(n), Row_stride(row_stride),
+      Column_stride(column_stride) { }
+
+   // Is the span empty
+   inline bool is_empty() const {return Data_pt == 0;}
+
+   // Are the entries of each row consecutive in memory
+   inline bool is_row_major() const {return Column_stride == 1;}
+
+   // Are the entries of each column consecutive in memory (Armadillo
+   // and LAPACK layout)
+   inline bool is_column_major() const {return Row_stride == 1;}
+
+   // Are all the entries stored in a single block of NRows*NColumns
+   // positions (no padding between rows or columns)
+   inline bool is_contiguous() const
+   {
+    return (Column_stride == 1 && Row_stride == NColumns) ||
+     (Row_stride == 1 && Column_stride == NRows);
+   }
+
+   // Access the (i,j) entry
+   inline T &operator()(const unsigned long i, const unsigned long j) const
+   {return Data_pt[i*Row_stride + j*Column_stride];}
+
+   // The i-th row
+   inline CCVectorSpan<T> row(const unsigned long i) const
+   {return CCVectorSpan<T>(Data_pt + i*Row_stride, NColumns, Column_stride);}
+
+   // The j-th column
+   inline CCVectorSpan<T> column(const unsigned long j) const
+   {return CCVectorSpan<T>(Data_pt + j*Column_stride, NRows, Row_stride);}
+
+   // Pointer to the (0,0) entry
+   T *Data_pt;
+
+   // The size of the matrix
+   unsigned long NRows;
+   unsigned long NColumns;
+
+   // Number of positions between the first entries of two consecutive
+   // rows
+   unsigned long Row_stride;
+
+   // Number of positions between the first entries of two consecutive
+   // columns
+   unsigned long Column_stride;
+  };
+
+ // ==================================================================
+ /// Strided kernels used by the bulk operations of vectors and
+ /// matrices, incx and incy are the number of positions between two
+ /// consecutive entries of x and y, respectively
+ // ==================================================================
+ namespace BulkKernels
+ {
+
+  // ================================================================
+  /// y = x, the entries are converted when x and y are of different
+  /// types (float and double for example)
+  // ================================================================
+  template<class T, class U>
+   inline void copy(const unsigned long n,
+                    const T *x, const unsigned long incx,
+                    U *y, const unsigned long incy)
+   {
+    if (incx == 1 && incy == 1)
+     {
+      std::copy(x, x + n, y);
+     }
+    else
+     {
+      for (unsigned long i = 0; i < n; i++)
+       {
+        y[i*incy] = x[i*incx];
+       }
+     }
+   }
+
+  // ================================================================
+  /// y = y + alpha * x
+  // ================================================================
+  template<class T>
+   inline void axpy(const unsigned long n, const T alpha,
+                    const T *x, const unsigned long incx,
+                    T *y, const unsigned long incy)
+   {
+    if (BLASKernels::axpy(n, alpha, x, incx, y, incy))
+     {
+      return;
+     }
+    if (incx == 1 && incy == 1)
+     {
+      for (unsigned long i = 0; i < n; i++)
+       {
+        y[i]+= alpha * x[i];
+       }
+     }
+    else
+     {
+      for (unsigned long i = 0; i < n; i++)
+       {
+        y[i*incy]+= alpha * x[i*incx];
+       }
+     }
+   }
+
+  // ================================================================
+  /// x = alpha * x
+  // ================================================================
+  template<class T>
+   inline void scale(const unsigned long n, const T alpha,
+                     T *x, const unsigned long incx)
+   {
+    if (BLASKernels::scal(n, alpha, x, incx))
+     {
+      return;
+     }
+    if (incx == 1)
+     {
+      for (unsigned long i = 0; i < n; i++)
+       {
+        x[i]*= alpha;
+       }
+     }
+    else
+     {
+      for (unsigned long i = 0; i < n; i++)
+       {
+        x[i*incx]*= alpha;
+       }
+     }
+   }
+
+ }
+
+}
+
+#endif // #ifndef CCSPAN_H
@@ -0,0 +1,7 @@
+// Include header and tpl.cpp files implementing templates. We may use
+// this file to force the instantiation of specific templates
+#ifndef CCSPARSEMATRIX_H
+#define CCSPARSEMATRIX_H
+#include "cc_sparse_matrix.tpl.h"
+#include "cc_sparse_matrix.tpl.cpp"
+#endif // #ifndef CCSPARSEMATRIX_H
@@ -0,0 +1,1195 @@
+// IN THIS FILE: Implementation of a concrete class to represent
+// sparse matrices in compressed sparse row (CSR) format
+
+#include "cc_sparse_matrix.tpl.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ // Empty constructor
+ // ===================================================================
+ template<class T>
+ CCSparseMatrix<T>::CCSparseMatrix()
+  : ACMatrix<T>(), NNon_zeros(0), Row_start_pt(0), Column_index_pt(0),
+    Values_pt(0)
+ { }
+
+ // ===================================================================
+ // Constructor to create an m X n zero matrix (no non-zero entries)
+ // ===================================================================
+ template<class T>
+ CCSparseMatrix<T>::CCSparseMatrix(const unsigned long m, const unsigned long n)
+  : ACMatrix<T>(m, n), NNon_zeros(0), Row_start_pt(0), Column_index_pt(0),
+    Values_pt(0)
+ {
+  allocate_memory(m, n);
+ }
+
+ // ===================================================================
+ // Constructor where we pass the data for the DENSE matrix of size m
+ // X n, only the non-zero entries are stored
+ // ===================================================================
+ template<class T>
+ CCSparseMatrix<T>::CCSparseMatrix(T *matrix_pt,
+                                   const unsigned long m,
+                                   const unsigned long n)
+  : ACMatrix<T>(m, n), NNon_zeros(0), Row_start_pt(0), Column_index_pt(0),
+    Values_pt(0)
+ {
+  set_matrix(matrix_pt, m, n);
+ }
+
+ // ===================================================================
+ // Constructor where we pass the matrix in CSR format, the arrays are
+ // copied
+ // ===================================================================
+ template<class T>
+ CCSparseMatrix<T>::CCSparseMatrix(const unsigned long m, const unsigned long n,
+                                   const unsigned long n_non_zeros,
+                                   const unsigned long *row_start_pt,
+                                   const unsigned long *column_index_pt,
+                                   const T *values_pt)
+  : ACMatrix<T>(m, n), NNon_zeros(0), Row_start_pt(0), Column_index_pt(0),
+    Values_pt(0)
+ {
+  set_matrix(m, n, n_non_zeros, row_start_pt, column_index_pt, values_pt);
+ }
+
+ // ===================================================================
+ // Copy constructor
+ // ===================================================================
+ template<class T>
+ CCSparseMatrix<T>::CCSparseMatrix(const CCSparseMatrix<T> &copy)
+  : ACMatrix<T>(copy.n_rows(), copy.n_columns()), NNon_zeros(0),
+    Row_start_pt(0), Column_index_pt(0), Values_pt(0)
+ {
+  if (copy.is_own_memory_allocated())
+   {
+    set_matrix(copy.n_rows(), copy.n_columns(), copy.n_non_zeros(),
+               copy.row_start_pt(), copy.column_index_pt(), copy.values_pt());
+   }
+ }
+
+ // ===================================================================
+ // Move constructor
+ // ===================================================================
+ template<class T>
+ CCSparseMatrix<T>::CCSparseMatrix(CCSparseMatrix<T> &&source_matrix)
+  : ACMatrix<T>(), NNon_zeros(0), Row_start_pt(0), Column_index_pt(0),
+    Values_pt(0)
+ {
+  // Take the memory of the source matrix
+  move_matrix(source_matrix);
+ }
+
+ // ===================================================================
+ // Destructor
+ // ===================================================================
+ template<class T>
+ CCSparseMatrix<T>::~CCSparseMatrix()
+ {
+  // Deallocate memory
+  clean_up();
+ }
+
+ // ===================================================================
+ // Assignment operator
+ // ===================================================================
+ template<class T>
+ CCSparseMatrix<T>& CCSparseMatrix<T>::operator=(const CCSparseMatrix<T> &source_matrix)
+ {
+  // Check for self-assignment
+  if (this != &source_matrix)
+   {
+    // Clean-up and set values
+    set_matrix(source_matrix.n_rows(), source_matrix.n_columns(),
+               source_matrix.n_non_zeros(), source_matrix.row_start_pt(),
+               source_matrix.column_index_pt(), source_matrix.values_pt());
+   }
+
+  // Return this (de-referenced pointer)
+  return *this;
+ }
+
+ // ===================================================================
+ // Move assignment operator
+ // ===================================================================
+ template<class T>
+ CCSparseMatrix<T>& CCSparseMatrix<T>::operator=(CCSparseMatrix<T> &&source_matrix)
+ {
+  // Check for self-assignment
+  if (this != &source_matrix)
+   {
+    // Clean-up and take the memory of the source matrix
+    clean_up();
+    move_matrix(source_matrix);
+   }
+
+  // Return this (de-referenced pointer)
+  return *this;
+ }
+
+ // ===================================================================
+ // Allows to create a matrix with the given size but with no non-zero
+ // entries
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::allocate_memory(const unsigned long m,
+                                         const unsigned long n)
+ {
+  // Clean any possibly stored data
+  clean_up();
+
+  // Set the number of rows and columns of the matrix
+  this->NRows = m;
+  this->NColumns = n;
+
+  // No non-zero entries, only the row start array is required
+  NNon_zeros = 0;
+  Row_start_pt = new unsigned long[m+1];
+  std::fill(Row_start_pt, Row_start_pt+m+1, 0);
+
+  // Mark the matrix as allocated its own memory
+  this->Is_own_memory_allocated=true;
+ }
+
+ // ===================================================================
+ // Fills the non-zero entries with zeroes (the sparsity pattern is
+ // kept)
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::fill_with_zeroes()
+ {
+  // Check that the matrix has memory allocated
+  if (this->Is_own_memory_allocated)
+   {
+    std::fill(Values_pt, Values_pt+NNon_zeros, T(0));
+   }
+  else
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix has no memory allocated\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+ }
+
+ // ===================================================================
+ // Transforms the input DENSE matrix to a sparse matrix, only the
+ // non-zero entries are stored
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::set_matrix(const T *matrix_pt,
+                                    const unsigned long m,
+                                    const unsigned long n)
+ {
+  // Count the number of non-zero entries
+  unsigned long n_non_zeros = 0;
+  for (unsigned long k = 0; k < m*n; k++)
+   {
+    if (matrix_pt[k] != T(0))
+     {
+      n_non_zeros++;
+     }
+   }
+
+  // Clean any possible previously allocated memory
+  clean_up();
+
+  // Set the number of rows and columns
+  this->NRows = m;
+  this->NColumns = n;
+  NNon_zeros = n_non_zeros;
+
+  // Allocate memory for the CSR arrays
+  Row_start_pt = new unsigned long[m+1];
+  Column_index_pt = new unsigned long[n_non_zeros];
+  Values_pt = new T[n_non_zeros];
+
+  // Copy the non-zero entries
+  unsigned long k = 0;
+  Row_start_pt[0] = 0;
+  for (unsigned long i = 0; i < m; i++)
+   {
+    for (unsigned long j = 0; j < n; j++)
+     {
+      const T a_ij = matrix_pt[i*n+j];
+      if (a_ij != T(0))
+       {
+        Column_index_pt[k] = j;
+        Values_pt[k] = a_ij;
+        k++;
+       }
+     }
+    Row_start_pt[i+1] = k;
+   }
+
+  // Mark the matrix as having its own memory
+  this->Is_own_memory_allocated = true;
+ }
+
+ // ===================================================================
+ // Set the matrix from the arrays in CSR format (the arrays are
+ // copied)
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::set_matrix(const unsigned long m, const unsigned long n,
+                                    const unsigned long n_non_zeros,
+                                    const unsigned long *row_start_pt,
+                                    const unsigned long *column_index_pt,
+                                    const T *values_pt)
+ {
+  // Check that the arrays are consistent
+  if (row_start_pt[0] != 0 || row_start_pt[m] != n_non_zeros)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The row start array is not consistent with the number\n"
+                  << "of non-zero entries\n"
+                  << "row_start_pt[0]: " << row_start_pt[0] << "\n"
+                  << "row_start_pt[m]: " << row_start_pt[m] << "\n"
+                  << "n_non_zeros: " << n_non_zeros << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // The rows must not end before they start, otherwise the entries
+  // are read out of the arrays
+  for (unsigned long i = 0; i < m; i++)
+   {
+    if (row_start_pt[i+1] < row_start_pt[i])
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The row start array is decreasing at the " << i << "-th\n"
+                    << "row\n"
+                    << "row_start_pt[i]: " << row_start_pt[i] << "\n"
+                    << "row_start_pt[i+1]: " << row_start_pt[i+1] << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+   }
+
+  // The column indices must be strictly increasing in each row, the
+  // entries are searched by bisection (see position())
+  for (unsigned long i = 0; i < m; i++)
+   {
+    for (unsigned long k = row_start_pt[i] + 1; k < row_start_pt[i+1]; k++)
+     {
+      if (column_index_pt[k] <= column_index_pt[k-1])
+       {
+        // Error message
+        std::ostringstream error_message;
+        error_message << "The column indices of the " << i << "-th row are not\n"
+                      << "sorted in increasing order or are repeated\n"
+                      << "Column index of the " << k-1 << "-th entry: "
+                      << column_index_pt[k-1] << "\n"
+                      << "Column index of the " << k << "-th entry: "
+                      << column_index_pt[k] << std::endl;
+        throw SciCellxxLibError(error_message.str(),
+                                SCICELLXX_CURRENT_FUNCTION,
+                                SCICELLXX_EXCEPTION_LOCATION);
+       }
+     }
+   }
+
+  // The columns are increasing in each row, the last entry of each
+  // row has the largest column index
+  for (unsigned long i = 0; i < m; i++)
+   {
+    const unsigned long k = row_start_pt[i+1];
+    if (k > row_start_pt[i] && column_index_pt[k-1] >= n)
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The column index of the " << k-1 << "-th entry is out\n"
+                    << "of range\n"
+                    << "Number of columns: " << n << "\n"
+                    << "Column index: " << column_index_pt[k-1] << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+   }
+
+  // Clean any possible previously allocated memory
+  clean_up();
+
+  // Set the number of rows and columns
+  this->NRows = m;
+  this->NColumns = n;
+  NNon_zeros = n_non_zeros;
+
+  // Allocate memory and copy the CSR arrays
+  Row_start_pt = new unsigned long[m+1];
+  Column_index_pt = new unsigned long[n_non_zeros];
+  Values_pt = new T[n_non_zeros];
+  std::memcpy(Row_start_pt, row_start_pt, (m+1)*sizeof(unsigned long));
+  std::memcpy(Column_index_pt, column_index_pt, n_non_zeros*sizeof(unsigned long));
+  std::memcpy(Values_pt, values_pt, n_non_zeros*sizeof(T));
+
+  // Mark the matrix as having its own memory
+  this->Is_own_memory_allocated = true;
+ }
+
+ // ===================================================================
+ // Set the matrix from triplets (i, j, value). Repeated entries are
+ // added
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::set_from_triplets(const unsigned long m, const unsigned long n,
+                                           const std::vector<unsigned long> &rows,
+                                           const std::vector<unsigned long> &columns,
+                                           const std::vector<T> &values)
+ {
+  // Check that the three arrays have the same size
+  const unsigned long n_triplets = values.size();
+  if (rows.size() != n_triplets || columns.size() != n_triplets)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The number of rows, columns and values of the triplets\n"
+                  << "is not the same\n"
+                  << "rows.size(): " << rows.size() << "\n"
+                  << "columns.size(): " << columns.size() << "\n"
+                  << "values.size(): " << values.size() << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Count the number of entries per row (shifted by one to compute
+  // the row start positions)
+  std::vector<unsigned long> row_start(m+1, 0);
+  for (unsigned long k = 0; k < n_triplets; k++)
+   {
+    if (rows[k] >= m || columns[k] >= n)
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The " << k << "-th triplet is out of the range of\n"
+                    << "the matrix\n"
+                    << "dim(matrix) = (" << m << ", " << n << ")\n"
+                    << "triplet = (" << rows[k] << ", " << columns[k] << ")\n"
+                    << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+    row_start[rows[k]+1]++;
+   }
+  for (unsigned long i = 0; i < m; i++)
+   {
+    row_start[i+1]+= row_start[i];
+   }
+
+  // Scatter the triplets by rows
+  std::vector<std::pair<unsigned long, T> > entries(n_triplets);
+  std::vector<unsigned long> next_position(row_start.begin(), row_start.end()-1);
+  for (unsigned long k = 0; k < n_triplets; k++)
+   {
+    entries[next_position[rows[k]]++] = std::make_pair(columns[k], values[k]);
+   }
+
+  // Sort the entries of each row by column and add the repeated ones
+  unsigned long n_non_zeros = 0;
+  std::vector<unsigned long> compressed_row_start(m+1, 0);
+  for (unsigned long i = 0; i < m; i++)
+   {
+    typename std::vector<std::pair<unsigned long, T> >::iterator row_begin =
+     entries.begin() + row_start[i];
+    typename std::vector<std::pair<unsigned long, T> >::iterator row_end =
+     entries.begin() + row_start[i+1];
+    std::stable_sort(row_begin, row_end, CCSparseMatrixCompareColumns<T>());
+    for (unsigned long k = row_start[i]; k < row_start[i+1]; k++)
+     {
+      if (n_non_zeros > compressed_row_start[i] &&
+          entries[n_non_zeros-1].first == entries[k].first)
+       {
+        entries[n_non_zeros-1].second+= entries[k].second;
+       }
+      else
+       {
+        entries[n_non_zeros++] = entries[k];
+       }
+     }
+    compressed_row_start[i+1] = n_non_zeros;
+   }
+
+  // Clean any possible previously allocated memory
+  clean_up();
+
+  // Set the number of rows and columns
+  this->NRows = m;
+  this->NColumns = n;
+  NNon_zeros = n_non_zeros;
+
+  // Allocate memory for the CSR arrays and copy the entries
+  Row_start_pt = new unsigned long[m+1];
+  Column_index_pt = new unsigned long[n_non_zeros];
+  Values_pt = new T[n_non_zeros];
+  std::copy(compressed_row_start.begin(), compressed_row_start.end(), Row_start_pt);
+  for (unsigned long k = 0; k < n_non_zeros; k++)
+   {
+    Column_index_pt[k] = entries[k].first;
+    Values_pt[k] = entries[k].second;
+   }
+
+  // Mark the matrix as having its own memory
+  this->Is_own_memory_allocated = true;
+ }
+
+ // ===================================================================
+ // Clean up for any dynamically stored data
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::clean_up()
+ {
+  // Check whether the Matrix allocated its own memory
+  if (this->Is_own_memory_allocated)
+   {
+    // Mark the matrix as deleteable
+    this->Delete_matrix = true;
+    // Free the memory allocated for the matrix
+    free_memory_for_matrix();
+   }
+  else // If empty
+   {
+    // Set the pointers to NULL
+    Row_start_pt = 0;
+    Column_index_pt = 0;
+    Values_pt = 0;
+   }
+
+ }
+
+ // ===================================================================
+ // Free allocated memory for matrix
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::free_memory_for_matrix()
+ {
+  // Is the matrix allowed for deletion. If this method is called from
+  // an external source we need to check whether the matrix has been
+  // marked for deletion
+  if (this->Delete_matrix)
+   {
+    delete [] Row_start_pt;
+    Row_start_pt = 0;
+    delete [] Column_index_pt;
+    Column_index_pt = 0;
+    delete [] Values_pt;
+    Values_pt = 0;
+    NNon_zeros = 0;
+
+    // Mark the matrix as not having allocated memory
+    this->Is_own_memory_allocated=false;
+
+   } // if (Delete_matrix)
+  else
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "You are trying to free the memory of a matrix that is\n"
+                  << "not marked as deletable" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+ }
+
+ // ===================================================================
+ // Get the position in Values_pt of the entry (i, j), returns
+ // NNon_zeros if the entry is not in the sparsity pattern
+ // ===================================================================
+ template<class T>
+ unsigned long CCSparseMatrix<T>::position(const unsigned long i,
+                                           const unsigned long j) const
+ {
+#ifdef SCICELLXX_RANGE_CHECK
+  if (!(this->is_own_memory_allocated()))
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix has no memory allocated"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  if (i >= this->n_rows() || j >= this->n_columns())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The entry you are trying to access is out of range\n"
+                  << "Number of rows: " << this->n_rows() << std::endl
+                  << "Number of columns: " << this->n_columns() << std::endl
+                  << "Requested entry: (" << i << ", " << j << ")" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+#endif // #ifdef SCICELLXX_RANGE_CHECK
+
+  // Binary search on the (sorted) column indices of row i
+  const unsigned long *row_begin = Column_index_pt + Row_start_pt[i];
+  const unsigned long *row_end = Column_index_pt + Row_start_pt[i+1];
+  const unsigned long *column_pt = std::lower_bound(row_begin, row_end, j);
+  if (column_pt != row_end && *column_pt == j)
+   {
+    return column_pt - Column_index_pt;
+   }
+
+  return NNon_zeros;
+ }
+
+ // ===================================================================
+ // Get the specified value from the matrix (read-only), returns zero
+ // for entries out of the sparsity pattern
+ // ===================================================================
+ template<class T>
+ const T CCSparseMatrix<T>::value(const unsigned long i, const unsigned long j) const
+ {
+  const unsigned long k = position(i, j);
+  if (k == NNon_zeros)
+   {
+    return T(0);
+   }
+  return Values_pt[k];
+ }
+
+ // ===================================================================
+ // Set values in the matrix (write version). Only the entries in the
+ // sparsity pattern can be modified
+ // ===================================================================
+ template<class T>
+ T &CCSparseMatrix<T>::value(const unsigned long i, const unsigned long j)
+ {
+  const unsigned long k = position(i, j);
+  if (k == NNon_zeros)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The entry you are trying to modify is not in the\n"
+                  << "sparsity pattern of the matrix\n"
+                  << "Requested entry: (" << i << ", " << j << ")\n"
+                  << "Use set_from_triplets() or the CCSparseMatrixBuilder\n"
+                  << "class to create the sparsity pattern" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  return Values_pt[k];
+ }
+
+ // ===================================================================
+ // Permute the rows in the list
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::permute_rows(std::vector<std::pair<unsigned long, unsigned long> > &permute_list)
+ {
+  // The permutation (new row i is old row row_permutation[i])
+  std::vector<unsigned long> row_permutation(this->NRows);
+  for (unsigned long i = 0; i < this->NRows; i++)
+   {
+    row_permutation[i] = i;
+   }
+
+  // Get the number of elements in the permute list
+  const unsigned n_permute_list = permute_list.size();
+  for (unsigned i = 0; i < n_permute_list; i++)
+   {
+    if (permute_list[i].first >= this->NRows || permute_list[i].second >= this->NRows)
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The rows of the permute list in the " << i << "-th position\n"
+                    << "are out of the range of the number of rows of the matrix"
+                    << "permute_list[i].first: " << permute_list[i].first
+                    << "permute_list[i].second: " << permute_list[i].second << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+    std::swap(row_permutation[permute_list[i].first],
+              row_permutation[permute_list[i].second]);
+   }
+
+  // Do the permutations
+  apply_row_permutation(row_permutation);
+ }
+
+ // ===================================================================
+ // Permute the columns in the list
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::permute_columns(std::vector<std::pair<unsigned long, unsigned long> > &permute_list)
+ {
+  // The permutation (new column j is old column column_permutation[j])
+  std::vector<unsigned long> column_permutation(this->NColumns);
+  for (unsigned long j = 0; j < this->NColumns; j++)
+   {
+    column_permutation[j] = j;
+   }
+
+  // Get the number of elements in the permute list
+  const unsigned n_permute_list = permute_list.size();
+  for (unsigned i = 0; i < n_permute_list; i++)
+   {
+    if (permute_list[i].first >= this->NColumns || permute_list[i].second >= this->NColumns)
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The columns of the permute list in the " << i << "-th position\n"
+                    << "are out of the range of the number of columns of the matrix"
+                    << "permute_list[i].first: " << permute_list[i].first
+                    << "permute_list[i].second: " << permute_list[i].second << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+    std::swap(column_permutation[permute_list[i].first],
+              column_permutation[permute_list[i].second]);
+   }
+
+  // Do the permutations
+  apply_column_permutation(column_permutation);
+ }
+
+ // ===================================================================
+ // Permute rows i and j
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::permute_rows(const unsigned long &i, const unsigned long &j)
+ {
+  std::vector<std::pair<unsigned long, unsigned long> > permute_list(1, std::make_pair(i, j));
+  permute_rows(permute_list);
+ }
+
+ // ===================================================================
+ // Permute columns i and j
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::permute_columns(const unsigned long &i, const unsigned long &j)
+ {
+  std::vector<std::pair<unsigned long, unsigned long> > permute_list(1, std::make_pair(i, j));
+  permute_columns(permute_list);
+ }
+
+ // ===================================================================
+ // Rebuild the matrix such that the new row i is the old row
+ // row_permutation[i]
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::apply_row_permutation(const std::vector<unsigned long> &row_permutation)
+ {
+  const unsigned long n_rows = this->NRows;
+  unsigned long *new_row_start_pt = new unsigned long[n_rows+1];
+  unsigned long *new_column_index_pt = new unsigned long[NNon_zeros];
+  T *new_values_pt = new T[NNon_zeros];
+
+  unsigned long k = 0;
+  new_row_start_pt[0] = 0;
+  for (unsigned long i = 0; i < n_rows; i++)
+   {
+    const unsigned long old_i = row_permutation[i];
+    for (unsigned long p = Row_start_pt[old_i]; p < Row_start_pt[old_i+1]; p++)
+     {
+      new_column_index_pt[k] = Column_index_pt[p];
+      new_values_pt[k] = Values_pt[p];
+      k++;
+     }
+    new_row_start_pt[i+1] = k;
+   }
+
+  delete [] Row_start_pt;
+  delete [] Column_index_pt;
+  delete [] Values_pt;
+  Row_start_pt = new_row_start_pt;
+  Column_index_pt = new_column_index_pt;
+  Values_pt = new_values_pt;
+ }
+
+ // ===================================================================
+ // Rebuild the matrix such that the new column j is the old column
+ // column_permutation[j]
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::apply_column_permutation(const std::vector<unsigned long> &column_permutation)
+ {
+  // The new index of each old column
+  const unsigned long n_columns = this->NColumns;
+  std::vector<unsigned long> new_column_index(n_columns);
+  for (unsigned long j = 0; j < n_columns; j++)
+   {
+    new_column_index[column_permutation[j]] = j;
+   }
+
+  // Rename the columns and sort them again in each row
+  std::vector<std::pair<unsigned long, T> > row_entries;
+  for (unsigned long i = 0; i < this->NRows; i++)
+   {
+    row_entries.clear();
+    for (unsigned long p = Row_start_pt[i]; p < Row_start_pt[i+1]; p++)
+     {
+      row_entries.push_back(std::make_pair(new_column_index[Column_index_pt[p]], Values_pt[p]));
+     }
+    std::sort(row_entries.begin(), row_entries.end(), CCSparseMatrixCompareColumns<T>());
+    for (unsigned long p = Row_start_pt[i], q = 0; p < Row_start_pt[i+1]; p++, q++)
+     {
+      Column_index_pt[p] = row_entries[q].first;
+      Values_pt[p] = row_entries[q].second;
+     }
+   }
+ }
+
+ // ===================================================================
+ // Takes the memory of the source matrix, the source matrix is left
+ // empty. THIS matrix should have no memory allocated
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::move_matrix(CCSparseMatrix<T> &source_matrix)
+ {
+  this->NRows = source_matrix.NRows;
+  this->NColumns = source_matrix.NColumns;
+  if (source_matrix.is_own_memory_allocated())
+   {
+    if (source_matrix.delete_matrix())
+     {
+      // Transfer ownership
+      NNon_zeros = source_matrix.NNon_zeros;
+      Row_start_pt = source_matrix.Row_start_pt;
+      Column_index_pt = source_matrix.Column_index_pt;
+      Values_pt = source_matrix.Values_pt;
+      this->Is_own_memory_allocated = true;
+
+      // Leave the source matrix with no memory
+      source_matrix.NNon_zeros = 0;
+      source_matrix.Row_start_pt = 0;
+      source_matrix.Column_index_pt = 0;
+      source_matrix.Values_pt = 0;
+      source_matrix.Is_own_memory_allocated = false;
+     }
+    else
+     {
+      // The memory of the source matrix is managed somewhere else,
+      // copy the entries
+      set_matrix(source_matrix.n_rows(), source_matrix.n_columns(),
+                 source_matrix.n_non_zeros(), source_matrix.row_start_pt(),
+                 source_matrix.column_index_pt(), source_matrix.values_pt());
+     }
+   }
+
+ }
+
+ // ===================================================================
+ // Output the matrix
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::output(bool output_indexes) const
+ {
+  if (!this->Is_own_memory_allocated)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix has no memory allocated. It is empty" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  else
+   {
+    // Check whether we should output the indexes (only the non-zero
+    // entries are output)
+    if (output_indexes)
+     {
+      for (unsigned long i = 0; i < this->NRows; i++)
+       {
+        for (unsigned long p = Row_start_pt[i]; p < Row_start_pt[i+1]; p++)
+         {
+          std::cout << "(" << i << ", " << Column_index_pt[p] << "): "
+                    << Values_pt[p]
+                    << std::endl;
+         } // for (p < Row_start_pt[i+1])
+       } // for (i < this->NRows)
+     } // if (output_indexes)
+    else
+     {
+      for (unsigned long i = 0; i < this->NRows; i++)
+       {
+        for (unsigned long j = 0; j < this->NColumns; j++)
+         {
+          std::cout << value(i,j) << " ";
+         } // for (j < this->NColumns)
+        std::cout << std::endl;
+       } // for (i < this->NRows)
+     } // else if (output_indexes)
+
+   }
+
+ }
+
+ // ===================================================================
+ // Output the matrix
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::output(std::ofstream &outfile,
+                                bool output_indexes) const
+ {
+  if (!this->Is_own_memory_allocated)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix has no memory allocated. It is empty" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  else
+   {
+    // Check whether we should output the indexes (only the non-zero
+    // entries are output)
+    if (output_indexes)
+     {
+      for (unsigned long i = 0; i < this->NRows; i++)
+       {
+        for (unsigned long p = Row_start_pt[i]; p < Row_start_pt[i+1]; p++)
+         {
+          outfile << "(" << i << ", " << Column_index_pt[p] << "): "
+                  << Values_pt[p]
+                  << std::endl;
+         } // for (p < Row_start_pt[i+1])
+       } // for (i < this->NRows)
+     } // if (output_indexes)
+    else
+     {
+      for (unsigned long i = 0; i < this->NRows; i++)
+       {
+        for (unsigned long j = 0; j < this->NColumns; j++)
+         {
+          outfile << value(i,j) << " ";
+         } // for (j < this->NColumns)
+        outfile << std::endl;
+       } // for (i < this->NRows)
+     } // else if (output_indexes)
+
+   }
+
+ }
+
+ // ===================================================================
+ // Copy the matrix into a dense matrix
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrix<T>::to_dense(CCMatrix<T> &dense_matrix) const
+ {
+  const unsigned long n_rows = this->NRows;
+  const unsigned long n_columns = this->NColumns;
+  dense_matrix.allocate_memory(n_rows, n_columns);
+  dense_matrix.fill_with_zeroes();
+  // The dense matrix may be stored by rows or by columns
+  const CCMatrixSpan<T> dense = dense_matrix.span();
+  for (unsigned long i = 0; i < n_rows; i++)
+   {
+    for (unsigned long p = Row_start_pt[i]; p < Row_start_pt[i+1]; p++)
+     {
+      dense(i, Column_index_pt[p]) = Values_pt[p];
+     }
+   }
+ }
+
+ // ===================================================================
+ // Constructor, the size of the matrix to build
+ // ===================================================================
+ template<class T>
+ CCSparseMatrixBuilder<T>::CCSparseMatrixBuilder(const unsigned long m,
+                                                 const unsigned long n)
+  : NRows(m), NColumns(n)
+ { }
+
+ // ===================================================================
+ // Destructor
+ // ===================================================================
+ template<class T>
+ CCSparseMatrixBuilder<T>::~CCSparseMatrixBuilder()
+ { }
+
+ // ===================================================================
+ // Reserve memory for the given number of entries
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrixBuilder<T>::reserve(const unsigned long n_entries)
+ {
+  Rows.reserve(n_entries);
+  Columns.reserve(n_entries);
+  Values.reserve(n_entries);
+ }
+
+ // ===================================================================
+ // Add an entry to the matrix
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrixBuilder<T>::add_entry(const unsigned long i,
+                                          const unsigned long j,
+                                          const T value)
+ {
+#ifdef SCICELLXX_RANGE_CHECK
+  if (i >= NRows || j >= NColumns)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The entry you are trying to add is out of range\n"
+                  << "Number of rows: " << NRows << std::endl
+                  << "Number of columns: " << NColumns << std::endl
+                  << "Requested entry: (" << i << ", " << j << ")" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+#endif // #ifdef SCICELLXX_RANGE_CHECK
+  Rows.push_back(i);
+  Columns.push_back(j);
+  Values.push_back(value);
+ }
+
+ // ===================================================================
+ // Remove all the entries
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrixBuilder<T>::clear()
+ {
+  Rows.clear();
+  Columns.clear();
+  Values.clear();
+ }
+
+ // ===================================================================
+ // Creates the CSR matrix
+ // ===================================================================
+ template<class T>
+ void CCSparseMatrixBuilder<T>::build(CCSparseMatrix<T> &matrix) const
+ {
+  matrix.set_from_triplets(NRows, NColumns, Rows, Columns, Values);
+ }
+
+ // ================================================================
+ // Multiply sparse matrix times vector
+ // ================================================================
+ template<class T>
+ void multiply_matrix_times_vector(const CCSparseMatrix<T> &matrix,
+                                   const CCVector<T> &vector,
+                                   CCVector<T> &solution_vector)
+ {
+  // Check that the matrix and the vector have memory allocated
+  if (!matrix.is_own_memory_allocated() || !vector.is_own_memory_allocated())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "Either the matrix or the vector have no memory allocated\n"
+                  << "matrix.is_own_memory_allocated() = "
+                  << matrix.is_own_memory_allocated() << "\n"
+                  << "vector.is_own_memory_allocated() = "
+                  << vector.is_own_memory_allocated() << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check whether the vector is a column vector
+  if (!vector.is_column_vector())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The vector to multiply the matrix is not a column vector\n"
+                  << "vector.is_column_vector(): " << vector.is_column_vector()
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check that the dimension of the vector and the matrix allow the
+  // operation
+  const unsigned long n_rows_matrix = matrix.n_rows();
+  const unsigned long n_columns_matrix = matrix.n_columns();
+  const unsigned long n_rows_vector = vector.n_values();
+  if (n_columns_matrix != n_rows_vector)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The dimension of the matrix and the vector does\n"
+                  << "not allow multiplication:\n"
+                  << "dim(matrix) = (" << n_rows_matrix << ", "
+                  << n_columns_matrix << ")\n"
+                  << "dim(vector) = (" << n_rows_vector << ", 1)\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check whether the solution vector is a column vector
+  if (!solution_vector.is_column_vector())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The solution vector is not a column vector\n"
+                  << "solution_vector.is_column_vector(): "
+                  << solution_vector.is_column_vector()
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check whether the solution vector has allocated memory, otherwise
+  // allocate it here!!!
+  if (!solution_vector.is_own_memory_allocated())
+   {
+    solution_vector.allocate_memory(n_rows_matrix);
+   }
+  else if (solution_vector.n_values() != n_rows_matrix)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The dimension of the solution vector is not appropiate for\n"
+                  << "the operation:\n"
+                  << "dim(matrix) = (" << n_rows_matrix << ", "
+                  << n_columns_matrix << ")\n"
+                  << "dim(solution_vector) = (" << solution_vector.n_values()
+                  << ", 1)\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Get the CSR arrays
+  const unsigned long *row_start_pt = matrix.row_start_pt();
+  const unsigned long *column_index_pt = matrix.column_index_pt();
+  const T *values_pt = matrix.values_pt();
+
+  // Get both the vector and the solution pointers
+  const T *vector_pt = vector.vector_pt();
+  T *solution_vector_pt = solution_vector.vector_pt();
+
+  // Perform the multiplication (only the non-zero entries are
+  // visited), each row is accumulated in double for float entries
+  typedef typename AccumulatorTraits<T>::Accumulator_type A;
+  for (unsigned long i = 0; i < n_rows_matrix; i++)
+   {
+    A sum = 0;
+    for (unsigned long p = row_start_pt[i]; p < row_start_pt[i+1]; p++)
+     {
+      sum+= A(values_pt[p]) * A(vector_pt[column_index_pt[p]]);
+     }
+    solution_vector_pt[i] = T(sum);
+   }
+
+ }
+
+ // ================================================================
+ // Multiply sparse matrix times dense matrix
+ // ================================================================
+ template<class T>
+ void multiply_matrices(const CCSparseMatrix<T> &left_matrix,
+                        const CCMatrix<T> &right_matrix,
+                        CCMatrix<T> &solution_matrix)
+ {
+  // Check that both matrices have memory allocated
+  if (!left_matrix.is_own_memory_allocated() || !right_matrix.is_own_memory_allocated())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "One of the matrices to operate with has no memory allocated\n"
+                  << "left_matrix.is_own_memory_allocated() = "
+                  << left_matrix.is_own_memory_allocated() << "\n"
+                  << "right_matrix.is_own_memory_allocated() = "
+                  << right_matrix.is_own_memory_allocated() << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check whether the dimensions of the matrices allow for
+  // multiplication
+  const unsigned long n_rows_left_matrix = left_matrix.n_rows();
+  const unsigned long n_columns_left_matrix = left_matrix.n_columns();
+  const unsigned long n_rows_right_matrix = right_matrix.n_rows();
+  const unsigned long n_columns_right_matrix = right_matrix.n_columns();
+  if (n_columns_left_matrix != n_rows_right_matrix)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The dimension of the matrices does not allow "
+                  << "multiplication:\n"
+                  << "dim(left_matrix) = (" << n_rows_left_matrix << ", "
+                  << n_columns_left_matrix << ")\n"
+                  << "dim(right_matrix) = (" << n_rows_right_matrix << ", "
+                  << n_columns_right_matrix << ")\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check whether the solution matrix has allocated memory, otherwise
+  // allocate it here!!!
+  if (!solution_matrix.is_own_memory_allocated())
+   {
+    solution_matrix.allocate_memory(n_rows_left_matrix, n_columns_right_matrix);
+   }
+  else if (solution_matrix.n_rows() != n_rows_left_matrix ||
+           solution_matrix.n_columns() != n_columns_right_matrix)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The dimension of the solution matrix is not appropiate for\n"
+                  << "the operation:\n"
+                  << "dim(left_matrix) = (" << n_rows_left_matrix << ", "
+                  << n_columns_left_matrix << ")\n"
+                  << "dim(right_matrix) = (" << n_rows_right_matrix << ", "
+                  << n_columns_right_matrix << ")\n"
+                  << "dim(solution_matrix) = (" << solution_matrix.n_rows()
+                  << ", " << solution_matrix.n_columns() << ")\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Get the CSR arrays
+  const unsigned long *row_start_pt = left_matrix.row_start_pt();
+  const unsigned long *column_index_pt = left_matrix.column_index_pt();
+  const T *values_pt = left_matrix.values_pt();
+
+  // Get the memory of the dense matrices (they may be stored by rows
+  // or by columns)
+  const CCMatrixSpan<T> right = right_matrix.span();
+  const CCMatrixSpan<T> solution = solution_matrix.span();
+
+  // Perform the multiplication, each row of the solution is a linear
+  // combination of the rows of the right matrix
+  for (unsigned long i = 0; i < n_rows_left_matrix; i++)
+   {
+    const CCVectorSpan<T> solution_row = solution.row(i);
+    for (unsigned long j = 0; j < n_columns_right_matrix; j++)
+     {
+      solution_row[j] = T(0);
+     }
+    for (unsigned long p = row_start_pt[i]; p < row_start_pt[i+1]; p++)
+     {
+      BulkKernels::axpy(n_columns_right_matrix, values_pt[p],
+                        right.row(column_index_pt[p]).Data_pt, right.Column_stride,
+                        solution_row.Data_pt, solution.Column_stride);
+     }
+   }
+
+ }
+
+}
@@ -0,0 +1,257 @@
+// IN THIS FILE: The definition of a concrete class to store and work
+// with sparse matrices. The matrix is stored in compressed sparse row
+// (CSR) format, only the non-zero entries are stored. A builder class
+// that receives the entries as triplets (i, j, value), coordinate
+// (COO) format, is also defined
+
+// Check whether the class has been already defined
+#ifndef CCSPARSEMATRIX_TPL_H
+#define CCSPARSEMATRIX_TPL_H
+
+// The parent class
+#include "ac_matrix.h"
+// We include the cc_vector and cc_matrix classes to deal with
+// sparse-dense operations
+#include "cc_vector.h"
+#include "cc_matrix.h"
+
+namespace scicellxx
+{
+
+ // Compares the column index of two (column, value) pairs, used to
+ // sort the entries of a row
+ template<class T>
+  struct CCSparseMatrixCompareColumns
+  {
+   inline bool operator()(const std::pair<unsigned long, T> &left,
+                          const std::pair<unsigned long, T> &right) const
+   {return left.first < right.first;}
+  };
+
+ // Concrete class to represent sparse matrices in compressed sparse
+ // row (CSR) format. The non-zero entries of row i are stored in
+ // Values_pt[Row_start_pt[i]] ... Values_pt[Row_start_pt[i+1]-1],
+ // and their column indices in the same positions of
+ // Column_index_pt. The column indices of each row are sorted
+ template<class T>
+ class CCSparseMatrix : public virtual ACMatrix<T>
+ {
+
+ public:
+
+  // Empty constructor
+  CCSparseMatrix();
+
+  // Constructor to create an m X n zero matrix (no non-zero entries)
+  CCSparseMatrix(const unsigned long m, const unsigned long n);
+
+  // Constructor where we pass the data for the DENSE matrix of size m
+  // X n, only the non-zero entries are stored
+  CCSparseMatrix(T *matrix_pt, const unsigned long m, const unsigned long n);
+
+  // Constructor where we pass the matrix in CSR format, the arrays are
+  // copied
+  CCSparseMatrix(const unsigned long m, const unsigned long n,
+                 const unsigned long n_non_zeros,
+                 const unsigned long *row_start_pt,
+                 const unsigned long *column_index_pt,
+                 const T *values_pt);
+
+  // Copy constructor
+  CCSparseMatrix(const CCSparseMatrix &copy);
+
+  // Move constructor, the source matrix is left empty
+  CCSparseMatrix(CCSparseMatrix &&source_matrix);
+
+  // Destructor
+  virtual ~CCSparseMatrix();
+
+  // Assignment operator
+  CCSparseMatrix &operator=(const CCSparseMatrix &source_matrix);
+
+  // Move assignment operator, the source matrix is left empty
+  CCSparseMatrix &operator=(CCSparseMatrix &&source_matrix);
+
+  // Allows to create a matrix with the given size but with no
+  // non-zero entries
+  void allocate_memory(const unsigned long m,
+                       const unsigned long n);
+
+  // Fills the non-zero entries with zeroes (the sparsity pattern is
+  // kept)
+  void fill_with_zeroes();
+
+  // Transforms the input DENSE matrix to a sparse matrix, only the
+  // non-zero entries are stored
+  void set_matrix(const T *matrix_pt,
+                  const unsigned long m,
+                  const unsigned long n);
+
+  // Set the matrix from the arrays in CSR format (the arrays are
+  // copied). The row start array must be non-decreasing and the
+  // column indices of each row strictly increasing
+  void set_matrix(const unsigned long m, const unsigned long n,
+                  const unsigned long n_non_zeros,
+                  const unsigned long *row_start_pt,
+                  const unsigned long *column_index_pt,
+                  const T *values_pt);
+
+  // Set the matrix from triplets (i, j, value). Repeated entries are
+  // added
+  void set_from_triplets(const unsigned long m, const unsigned long n,
+                         const std::vector<unsigned long> &rows,
+                         const std::vector<unsigned long> &columns,
+                         const std::vector<T> &values);
+
+  // Clean up for any dynamically stored data
+  void clean_up();
+
+  // Free allocated memory for matrix
+  void free_memory_for_matrix();
+
+  // Get the specified value from the matrix (read-only), returns zero
+  // for entries out of the sparsity pattern
+  const T value(const unsigned long i, const unsigned long j) const;
+
+  // Set values in the matrix (write version). Only the entries in the
+  // sparsity pattern can be modified, use set_from_triplets() or the
+  // CCSparseMatrixBuilder class to create the pattern
+  T &value(const unsigned long i, const unsigned long j);
+
+  /// Permute the rows in the list
+  void permute_rows(std::vector<std::pair<unsigned long, unsigned long> > &permute_list);
+
+  /// Permute the columns in the list
+  void permute_columns(std::vector<std::pair<unsigned long, unsigned long> > &permute_list);
+
+  /// Permute rows i and j
+  void permute_rows(const unsigned long &i, const unsigned long &j);
+
+  /// Permute columns i and j
+  void permute_columns(const unsigned long &i, const unsigned long &j);
+
+  // Output the matrix
+  void output(bool output_indexes = false) const;
+
+  // Output to file
+  void output(std::ofstream &outfile, bool output_indexes = false) const;
+
+  // Copy the matrix into a dense matrix
+  void to_dense(CCMatrix<T> &dense_matrix) const;
+
+  // Get the number of non-zero entries
+  inline unsigned long n_non_zeros() const {return NNon_zeros;}
+
+  // Get access to the Row_start_pt
+  inline unsigned long *row_start_pt() const {return Row_start_pt;}
+
+  // Get access to the Column_index_pt
+  inline unsigned long *column_index_pt() const {return Column_index_pt;}
+
+  // Get access to the Values_pt
+  inline T *values_pt() const {return Values_pt;}
+
+ protected:
+
+  // Get the position in Values_pt of the entry (i, j), returns
+  // NNon_zeros if the entry is not in the sparsity pattern
+  unsigned long position(const unsigned long i, const unsigned long j) const;
+
+  // Rebuild the matrix such that the new row i is the old row
+  // row_permutation[i]
+  void apply_row_permutation(const std::vector<unsigned long> &row_permutation);
+
+  // Rebuild the matrix such that the new column j is the old column
+  // column_permutation[j]
+  void apply_column_permutation(const std::vector<unsigned long> &column_permutation);
+
+  // Takes the memory of the source matrix (used by the move
+  // constructor and the move assignment operator)
+  void move_matrix(CCSparseMatrix &source_matrix);
+
+  // The number of non-zero entries
+  unsigned long NNon_zeros;
+
+  // The position of the first entry of each row in the Values_pt and
+  // Column_index_pt arrays (size NRows+1)
+  unsigned long *Row_start_pt;
+
+  // The column index of each non-zero entry (size NNon_zeros)
+  unsigned long *Column_index_pt;
+
+  // The non-zero entries (size NNon_zeros)
+  T *Values_pt;
+
+ };
+
+ /// @class CCSparseMatrixBuilder cc_sparse_matrix.h
+
+ // Stores the entries of a sparse matrix as triplets (i, j, value),
+ // coordinate (COO) format, and creates the CSR matrix. Entries may
+ // be added in any order, repeated entries are added
+ template<class T>
+ class CCSparseMatrixBuilder
+ {
+
+ public:
+
+  // Constructor, the size of the matrix to build
+  CCSparseMatrixBuilder(const unsigned long m, const unsigned long n);
+
+  // Destructor
+  virtual ~CCSparseMatrixBuilder();
+
+  // Reserve memory for the given number of entries
+  void reserve(const unsigned long n_entries);
+
+  // Add an entry to the matrix
+  void add_entry(const unsigned long i, const unsigned long j, const T value);
+
+  // Remove all the entries
+  void clear();
+
+  // Creates the CSR matrix
+  void build(CCSparseMatrix<T> &matrix) const;
+
+  // The number of entries added so far (including repeated ones)
+  inline unsigned long n_entries() const {return Values.size();}
+
+  // The number of rows of the matrix to build
+  inline unsigned long n_rows() const {return NRows;}
+
+  // The number of columns of the matrix to build
+  inline unsigned long n_columns() const {return NColumns;}
+
+ protected:
+
+  // The size of the matrix
+  unsigned long NRows;
+  unsigned long NColumns;
+
+  // The triplets
+  std::vector<unsigned long> Rows;
+  std::vector<unsigned long> Columns;
+  std::vector<T> Values;
+
+ };
+
+ // ================================================================
+ // Extra methods to work with sparse matrices, vectors and dense
+ // matrices
+ // ================================================================
+
+ // Multiply sparse matrix times vector
+ template<class T>
+  void multiply_matrix_times_vector(const CCSparseMatrix<T> &matrix,
+                                    const CCVector<T> &vector,
+                                    CCVector<T> &solution_vector);
+
+ // Multiply sparse matrix times dense matrix
+ template<class T>
+  void multiply_matrices(const CCSparseMatrix<T> &left_matrix,
+                         const CCMatrix<T> &right_matrix,
+                         CCMatrix<T> &solution_matrix);
+
+}
+
+#endif // #ifndef CCSPARSEMATRIX_TPL_H
@@ -0,0 +1,7 @@
+// Include header and tpl.cpp files implementing templates. We may use
+// this file to force the instantiation of specific templates
+#ifndef CCSYMMETRICMATRIX_H
+#define CCSYMMETRICMATRIX_H
+#include "cc_symmetric_matrix.tpl.h"
+#include "cc_symmetric_matrix.tpl.cpp"
+#endif // #ifndef CCSYMMETRICMATRIX_H
@@ -0,0 +1,723 @@
+// IN THIS FILE: Implementation of a concrete class to represent
+// symmetric matrices in packed storage
+
+#include "cc_symmetric_matrix.tpl.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ // Empty constructor
+ // ===================================================================
+ template<class T>
+ CCSymmetricMatrix<T>::CCSymmetricMatrix()
+  : ACMatrix<T>(), Packed_pt(0)
+ { }
+
+ // ===================================================================
+ // Constructor to create an n X n zero matrix
+ // ===================================================================
+ template<class T>
+ CCSymmetricMatrix<T>::CCSymmetricMatrix(const unsigned long n)
+  : ACMatrix<T>(n, n), Packed_pt(0)
+ {
+  allocate_memory(n);
+ }
+
+ // ===================================================================
+ // Copy constructor
+ // ===================================================================
+ template<class T>
+ CCSymmetricMatrix<T>::CCSymmetricMatrix(const CCSymmetricMatrix<T> &copy)
+  : ACMatrix<T>(copy.n_rows(), copy.n_columns()), Packed_pt(0)
+ {
+  if (copy.is_own_memory_allocated())
+   {
+    allocate_memory(copy.n_rows());
+    std::copy(copy.packed_pt(), copy.packed_pt() + n_packed_values(), Packed_pt);
+   }
+ }
+
+ // ===================================================================
+ // Move constructor
+ // ===================================================================
+ template<class T>
+ CCSymmetricMatrix<T>::CCSymmetricMatrix(CCSymmetricMatrix<T> &&source_matrix)
+  : ACMatrix<T>(), Packed_pt(0)
+ {
+  // Take the memory of the source matrix
+  move_matrix(source_matrix);
+ }
+
+ // ===================================================================
+ // Destructor
+ // ===================================================================
+ template<class T>
+ CCSymmetricMatrix<T>::~CCSymmetricMatrix()
+ {
+  // Deallocate memory
+  clean_up();
+ }
+
+ // ===================================================================
+ // Assignment operator
+ // ===================================================================
+ template<class T>
+ CCSymmetricMatrix<T>& CCSymmetricMatrix<T>::operator=(const CCSymmetricMatrix<T> &source_matrix)
+ {
+  // Check for self-assignment
+  if (this != &source_matrix)
+   {
+    // Clean-up and set values
+    allocate_memory(source_matrix.n_rows());
+    std::copy(source_matrix.packed_pt(),
+              source_matrix.packed_pt() + n_packed_values(), Packed_pt);
+   }
+
+  // Return this (de-referenced pointer)
+  return *this;
+ }
+
+ // ===================================================================
+ // Move assignment operator
+ // ===================================================================
+ template<class T>
+ CCSymmetricMatrix<T>& CCSymmetricMatrix<T>::operator=(CCSymmetricMatrix<T> &&source_matrix)
+ {
+  // Check for self-assignment
+  if (this != &source_matrix)
+   {
+    // Clean-up and take the memory of the source matrix
+    clean_up();
+    move_matrix(source_matrix);
+   }
+
+  // Return this (de-referenced pointer)
+  return *this;
+ }
+
+ // ===================================================================
+ // Allows to create a matrix with the given size (m must be equal to
+ // n)
+ // ===================================================================
+ template<class T>
+ void CCSymmetricMatrix<T>::allocate_memory(const unsigned long m,
+                                            const unsigned long n)
+ {
+  if (m != n)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "Symmetric matrices are square, the requested size is\n"
+                  << m << " x " << n << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  allocate_memory(n);
+ }
+
+ // ===================================================================
+ // Allows to create an n X n matrix
+ // ===================================================================
+ template<class T>
+ void CCSymmetricMatrix<T>::allocate_memory(const unsigned long n)
+ {
+  // Clean any possibly stored data
+  clean_up();
+
+  // Set the size of the matrix
+  this->NRows = n;
+  this->NColumns = n;
+
+  // Allocate the upper triangle, all the entries are zero
+  const unsigned long n_entries = n_packed_values();
+  Packed_pt = MemoryAllocator::new_array<T>(n_entries);
+  std::fill(Packed_pt, Packed_pt + n_entries, T(0));
+
+  // Mark the matrix as allocated its own memory
+  this->Is_own_memory_allocated=true;
+ }
+
+ // ===================================================================
+ // Fills the matrix with zeroes
+ // ===================================================================
+ template<class T>
+ void CCSymmetricMatrix<T>::fill_with_zeroes()
+ {
+  // Check that the matrix has memory allocated
+  if (this->Is_own_memory_allocated)
+   {
+    std::fill(Packed_pt, Packed_pt + n_packed_values(), T(0));
+   }
+  else
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix has no memory allocated\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+ }
+
+ // ===================================================================
+ // Transforms the input DENSE matrix to a symmetric matrix, only the
+ // upper triangle of the input matrix is read
+ // ===================================================================
+ template<class T>
+ void CCSymmetricMatrix<T>::set_matrix(const T *matrix_pt,
+                                       const unsigned long m,
+                                       const unsigned long n)
+ {
+  allocate_memory(m, n);
+  for (unsigned long j = 0; j < n; j++)
+   {
+    T *column_pt = Packed_pt + packed_index(0, j);
+    for (unsigned long i = 0; i <= j; i++)
+     {
+      column_pt[i] = matrix_pt[i*n + j];
+     }
+   }
+ }
+
+ // ===================================================================
+ // Clean up for any dynamically stored data
+ // ===================================================================
+ template<class T>
+ void CCSymmetricMatrix<T>::clean_up()
+ {
+  // Check whether the Matrix allocated its own memory
+  if (this->Is_own_memory_allocated)
+   {
+    // Mark the matrix as deleteable
+    this->Delete_matrix = true;
+    // Free the memory allocated for the matrix
+    free_memory_for_matrix();
+   }
+  else // If empty
+   {
+    // Set the pointer to NULL
+    Packed_pt = 0;
+   }
+
+ }
+
+ // ===================================================================
+ // Free allocated memory for matrix
+ // ===================================================================
+ template<class T>
+ void CCSymmetricMatrix<T>::free_memory_for_matrix()
+ {
+  // Is the matrix allowed for deletion. If this method is called from
+  // an external source we need to check whether the matrix has been
+  // marked for deletion
+  if (this->Delete_matrix)
+   {
+    MemoryAllocator::delete_array(Packed_pt);
+    Packed_pt = 0;
+
+    // Mark the matrix as not having allocated memory
+    this->Is_own_memory_allocated=false;
+
+   } // if (Delete_matrix)
+  else
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "You are trying to free the memory of a matrix that is\n"
+                  << "not marked as deletable" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+ }
+
+  // ===================================================================
+ // Get the specified value from the matrix (read-only)
+ // ===================================================================
+ template<class T>
+ const T CCSymmetricMatrix<T>::value(const unsigned long i, const unsigned long j) const
+ {
+#ifdef SCICELLXX_RANGE_CHECK
+  if (i >= this->n_rows() || j >= this->n_columns())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The entry you are trying to access is out of range\n"
+                  << "Number of rows: " << this->n_rows() << std::endl
+                  << "Number of columns: " << this->n_columns() << std::endl
+                  << "Requested entry: (" << i << ", " << j << ")" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+#endif // #ifdef SCICELLXX_RANGE_CHECK
+
+  return i <= j ? Packed_pt[packed_index(i, j)] : Packed_pt[packed_index(j, i)];
+ }
+
+ // ===================================================================
+ // Set values in the matrix (write version), the (j, i) entry is also
+ // modified
+ // ===================================================================
+ template<class T>
+ T &CCSymmetricMatrix<T>::value(const unsigned long i, const unsigned long j)
+ {
+#ifdef SCICELLXX_RANGE_CHECK
+  if (i >= this->n_rows() || j >= this->n_columns())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The entry you are trying to access is out of range\n"
+                  << "Number of rows: " << this->n_rows() << std::endl
+                  << "Number of columns: " << this->n_columns() << std::endl
+                  << "Requested entry: (" << i << ", " << j << ")" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+#endif // #ifdef SCICELLXX_RANGE_CHECK
+
+  return i <= j ? Packed_pt[packed_index(i, j)] : Packed_pt[packed_index(j, i)];
+ }
+
+ // ===================================================================
+ // Throws an error indicating that permutations are not supported
+ // ===================================================================
+ template<class T>
+ void CCSymmetricMatrix<T>::error_permutations_not_supported() const
+ {
+  // Error message
+  std::ostringstream error_message;
+  error_message << "Permutations of only rows or only columns are not\n"
+                << "supported by symmetric matrices, the permuted matrix is\n"
+                << "not symmetric. Copy the matrix into a dense matrix with\n"
+                << "to_dense() if you need to permute it" << std::endl;
+  throw SciCellxxLibError(error_message.str(),
+                          SCICELLXX_CURRENT_FUNCTION,
+                          SCICELLXX_EXCEPTION_LOCATION);
+ }
+
+ // ===================================================================
+ // Permute the rows in the list
+ // ===================================================================
+ template<class T>
+ void CCSymmetricMatrix<T>::permute_rows(std::vector<std::pair<unsigned long, unsigned long> > &permute_list)
+ {
+  error_permutations_not_supported();
+ }
+
+ // ===================================================================
+ // Permute the columns in the list
+ // ===================================================================
+ template<class T>
+ void CCSymmetricMatrix<T>::permute_columns(std::vector<std::pair<unsigned long, unsigned long> > &permute_list)
+ {
+  error_permutations_not_supported();
+ }
+
+ // ===================================================================
+ // Permute rows i and j
+ // ===================================================================
+ template<class T>
+ void CCSymmetricMatrix<T>::permute_rows(const unsigned long &i, const unsigned long &j)
+ {
+  error_permutations_not_supported();
+ }
+
+ // ===================================================================
+ // Permute columns i and j
+ // ===================================================================
+ template<class T>
+ void CCSymmetricMatrix<T>::permute_columns(const unsigned long &i, const unsigned long &j)
+ {
+  error_permutations_not_supported();
+ }
+
+ // ===================================================================
+ // Takes the memory of the source matrix
+ // ===================================================================
+ template<class T>
+ void CCSymmetricMatrix<T>::move_matrix(CCSymmetricMatrix<T> &source_matrix)
+ {
+  this->NRows = source_matrix.NRows;
+  this->NColumns = source_matrix.NColumns;
+  if (source_matrix.is_own_memory_allocated())
+   {
+    if (source_matrix.delete_matrix())
+     {
+      // Transfer ownership
+      Packed_pt = source_matrix.Packed_pt;
+      this->Is_own_memory_allocated = true;
+
+      // Leave the source matrix with no memory
+      source_matrix.Packed_pt = 0;
+      source_matrix.Is_own_memory_allocated = false;
+     }
+    else
+     {
+      // The memory of the source matrix is managed somewhere else,
+      // copy the entries
+      allocate_memory(source_matrix.n_rows());
+      std::copy(source_matrix.packed_pt(),
+                source_matrix.packed_pt() + n_packed_values(), Packed_pt);
+     }
+   }
+
+ }
+
+ // ===================================================================
+ // Output the matrix
+ // ===================================================================
+ template<class T>
+ void CCSymmetricMatrix<T>::output(bool output_indexes) const
+ {
+  if (!this->Is_own_memory_allocated)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix has no memory allocated. It is empty" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  else
+   {
+    for (unsigned long i = 0; i < this->NRows; i++)
+     {
+      for (unsigned long j = 0; j < this->NColumns; j++)
+       {
+        if (output_indexes)
+         {
+          std::cout << "(" << i << ", " << j << "): " << value(i, j) << std::endl;
+         }
+        else
+         {
+          std::cout << value(i,j) << " ";
+         }
+       } // for (j < this->NColumns)
+      if (!output_indexes)
+       {
+        std::cout << std::endl;
+       }
+     } // for (i < this->NRows)
+   }
+
+ }
+
+ // ===================================================================
+ // Output the matrix
+ // ===================================================================
+ template<class T>
+ void CCSymmetricMatrix<T>::output(std::ofstream &outfile,
+                                   bool output_indexes) const
+ {
+  if (!this->Is_own_memory_allocated)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The matrix has no memory allocated. It is empty" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  else
+   {
+    for (unsigned long i = 0; i < this->NRows; i++)
+     {
+      for (unsigned long j = 0; j < this->NColumns; j++)
+       {
+        if (output_indexes)
+         {
+          outfile << "(" << i << ", " << j << "): " << value(i, j) << std::endl;
+         }
+        else
+         {
+          outfile << value(i,j) << " ";
+         }
+       } // for (j < this->NColumns)
+      if (!output_indexes)
+       {
+        outfile << std::endl;
+       }
+     } // for (i < this->NRows)
+   }
+
+ }
+
+ // ===================================================================
+ // Copy the matrix into a dense matrix
+ // ===================================================================
+ template<class T>
+ void CCSymmetricMatrix<T>::to_dense(CCMatrix<T> &dense_matrix) const
+ {
+  const unsigned long n = this->NRows;
+  dense_matrix.allocate_memory(n, n);
+  // The dense matrix may be stored by rows or by columns
+  const CCMatrixSpan<T> dense = dense_matrix.span();
+  for (unsigned long j = 0; j < n; j++)
+   {
+    const T *column_pt = Packed_pt + packed_index(0, j);
+    for (unsigned long i = 0; i <= j; i++)
+     {
+      dense(i, j) = column_pt[i];
+      dense(j, i) = column_pt[i];
+     }
+   }
+ }
+
+ // ================================================================
+ // Copies the upper triangle (i <= j) of the square matrix into the
+ // packed layout of CCSymmetricMatrix, or at the given offset of each
+ // column. The columns of symmetric matrices are copied as they are,
+ // matrices with their entries in memory (CCMatrix by rows or by
+ // columns) are read through their span, any other matrix entry by
+ // entry
+ // ================================================================
+ template<class T>
+ void copy_upper_triangle(const ACMatrix<T> &matrix, T *packed_pt,
+                          const unsigned long *column_offset)
+ {
+  const unsigned long n = matrix.n_columns();
+  const CCSymmetricMatrix<T> *symmetric_pt =
+   dynamic_cast<const CCSymmetricMatrix<T>*>(&matrix);
+  if (symmetric_pt != 0 && column_offset == 0)
+   {
+    std::copy(symmetric_pt->packed_pt(),
+              symmetric_pt->packed_pt() + symmetric_pt->n_packed_values(),
+              packed_pt);
+    return;
+   }
+
+  const CCMatrixSpan<T> A = matrix.span();
+  for (unsigned long j = 0; j < n; j++)
+   {
+    T *column_pt = packed_pt + (column_offset != 0 ? column_offset[j] :
+                                CCSymmetricMatrix<T>::packed_index(0, j));
+    if (symmetric_pt != 0)
+     {
+      const T *source_pt = symmetric_pt->packed_pt() + CCSymmetricMatrix<T>::packed_index(0, j);
+      std::copy(source_pt, source_pt + j + 1, column_pt);
+     }
+    else if (A.is_empty())
+     {
+      for (unsigned long i = 0; i <= j; i++)
+       {
+        column_pt[i] = matrix.value(i, j);
+       }
+     }
+    else
+     {
+      for (unsigned long i = 0; i <= j; i++)
+       {
+        column_pt[i] = A(i, j);
+       }
+     }
+   }
+ }
+
+ // ================================================================
+ // Multiply symmetric matrix times vector
+ // ================================================================
+ template<class T>
+ void multiply_matrix_times_vector(const CCSymmetricMatrix<T> &matrix,
+                                   const CCVector<T> &vector,
+                                   CCVector<T> &solution_vector)
+ {
+  // Check that the matrix and the vector have memory allocated
+  if (!matrix.is_own_memory_allocated() || !vector.is_own_memory_allocated())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "Either the matrix or the vector have no memory allocated\n"
+                  << "matrix.is_own_memory_allocated() = "
+                  << matrix.is_own_memory_allocated() << "\n"
+                  << "vector.is_own_memory_allocated() = "
+                  << vector.is_own_memory_allocated() << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check whether the vector is a column vector
+  if (!vector.is_column_vector())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The vector to multiply the matrix is not a column vector\n"
+                  << "vector.is_column_vector(): " << vector.is_column_vector()
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check that the dimension of the vector and the matrix allow the
+  // operation
+  const unsigned long n = matrix.n_rows();
+  const unsigned long n_rows_vector = vector.n_values();
+  if (n != n_rows_vector)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The dimension of the matrix and the vector does\n"
+                  << "not allow multiplication:\n"
+                  << "dim(matrix) = (" << n << ", " << n << ")\n"
+                  << "dim(vector) = (" << n_rows_vector << ", 1)\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check whether the solution vector is a column vector
+  if (!solution_vector.is_column_vector())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The solution vector is not a column vector\n"
+                  << "solution_vector.is_column_vector(): "
+                  << solution_vector.is_column_vector()
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Check whether the solution vector has allocated memory, otherwise
+  // allocate it here!!!
+  if (!solution_vector.is_own_memory_allocated())
+   {
+    solution_vector.allocate_memory(n);
+   }
+  else if (solution_vector.n_values() != n)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The dimension of the solution vector is not appropiate for\n"
+                  << "the operation:\n"
+                  << "dim(matrix) = (" << n << ", " << n << ")\n"
+                  << "dim(solution_vector) = (" << solution_vector.n_values()
+                  << ", 1)\n" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  // Each stored column j contributes to the j-th entry of the
+  // solution (the upper part of row j, a dot product) and to the
+  // entries above it (the lower part of column j, an axpy), thus the
+  // packed entries are read once
+  const T *packed_pt = matrix.packed_pt();
+  const T *vector_pt = vector.vector_pt();
+  T *solution_vector_pt = solution_vector.vector_pt();
+  std::fill(solution_vector_pt, solution_vector_pt + n, T(0));
+  typedef typename AccumulatorTraits<T>::Accumulator_type A;
+  for (unsigned long j = 0; j < n; j++)
+   {
+    const T *column_pt = packed_pt + CCSymmetricMatrix<T>::packed_index(0, j);
+    const T x_j = vector_pt[j];
+    A sum = 0;
+    for (unsigned long i = 0; i < j; i++)
+     {
+      solution_vector_pt[i]+= column_pt[i] * x_j;
+      sum+= A(column_pt[i]) * A(vector_pt[i]);
+     }
+    solution_vector_pt[j] = T(sum + A(column_pt[j]) * A(x_j));
+   }
+
+ }
+
+ // ================================================================
+ // Copies the coordinates of the points (the columns of the positions
+ // matrix) into a contiguous array, point i at coordinates[i*dim]
+ // ================================================================
+ template<class T>
+ void gather_coordinates(const ACMatrix<T> &positions, std::vector<T> &coordinates)
+ {
+  const unsigned long dimension = positions.n_rows();
+  const unsigned long n_points = positions.n_columns();
+  coordinates.resize(dimension * n_points);
+  for (unsigned long i = 0; i < n_points; i++)
+   {
+    for (unsigned long k = 0; k < dimension; k++)
+     {
+      coordinates[i*dimension + k] = positions.value(k, i);
+     }
+   }
+ }
+
+ // ================================================================
+ // Distance between the points i and j
+ // ================================================================
+ template<class T>
+ inline T distance_between_points(const T *x_i, const T *x_j, const unsigned long dimension)
+ {
+  typedef typename AccumulatorTraits<T>::Accumulator_type A;
+  A sum = 0;
+  for (unsigned long k = 0; k < dimension; k++)
+   {
+    const A d = A(x_i[k]) - A(x_j[k]);
+    sum+= d * d;
+   }
+  return T(std::sqrt(sum));
+ }
+
+ // ================================================================
+ // Computes the distances between the points whose coordinates are
+ // given in the columns of the positions matrix, only the upper
+ // triangle is computed
+ // ================================================================
+ template<class T>
+ void compute_distance_matrix(const ACMatrix<T> &positions,
+                              CCSymmetricMatrix<T> &distance_matrix)
+ {
+  const unsigned long dimension = positions.n_rows();
+  const unsigned long n_points = positions.n_columns();
+  std::vector<T> coordinates;
+  gather_coordinates(positions, coordinates);
+
+  distance_matrix.allocate_memory(n_points);
+  T *packed_pt = distance_matrix.packed_pt();
+  for (unsigned long j = 0; j < n_points; j++)
+   {
+    T *column_pt = packed_pt + CCSymmetricMatrix<T>::packed_index(0, j);
+    const T *x_j = &coordinates[j*dimension];
+    for (unsigned long i = 0; i <= j; i++)
+     {
+      column_pt[i] = distance_between_points(&coordinates[i*dimension], x_j, dimension);
+     }
+   }
+ }
+
+ // ================================================================
+ // Computes the matrix with the radial function evaluated at the
+ // distances between the points, only the upper triangle is computed
+ // ================================================================
+ template<class T, class RBF>
+ void compute_interpolation_matrix(const ACMatrix<T> &positions,
+                                   RBF &rbf,
+                                   CCSymmetricMatrix<T> &interpolation_matrix)
+ {
+  const unsigned long dimension = positions.n_rows();
+  const unsigned long n_points = positions.n_columns();
+  std::vector<T> coordinates;
+  gather_coordinates(positions, coordinates);
+
+  interpolation_matrix.allocate_memory(n_points);
+  T *packed_pt = interpolation_matrix.packed_pt();
+  for (unsigned long j = 0; j < n_points; j++)
+   {
+    T *column_pt = packed_pt + CCSymmetricMatrix<T>::packed_index(0, j);
+    const T *x_j = &coordinates[j*dimension];
+    for (unsigned long i = 0; i <= j; i++)
+     {
+      column_pt[i] = rbf.psi(distance_between_points(&coordinates[i*dimension], x_j, dimension));
+     }
+   }
+ }
+
+}
@@ -0,0 +1,178 @@
+// IN THIS FILE: The definition of a concrete class to store and work
+// with symmetric matrices. Only the upper triangle (i <= j) is stored,
+// packed by columns, thus the memory is n * (n + 1) / 2 entries
+// instead of n^2. The functions to assemble the distance matrix of a
+// set of points and the matrix of a radial function evaluated at the
+// distances (the interpolation matrix of the RBF methods) only compute
+// the upper triangle
+
+// Check whether the class has been already defined
+#ifndef CCSYMMETRICMATRIX_TPL_H
+#define CCSYMMETRICMATRIX_TPL_H
+
+// The parent class
+#include "ac_matrix.h"
+// We include the cc_vector and cc_matrix classes to deal with
+// symmetric-dense operations
+#include "cc_vector.h"
+#include "cc_matrix.h"
+// The allocator for the packed entries
+#include "../general/memory_allocator.h"
+// The type used to accumulate the products of matrix times vector
+#include "accumulator_traits.h"
+
+namespace scicellxx
+{
+
+ /// @class CCSymmetricMatrix cc_symmetric_matrix.h
+
+ // Concrete class to represent symmetric n X n matrices in packed
+ // storage. The columns of the upper triangle are stored one after
+ // the other, the (i, j) entry with i <= j is stored at
+ // Packed_pt[j * (j + 1) / 2 + i] (the same layout as the 'U' packed
+ // storage of LAPACK). The (i, j) and (j, i) entries are the same
+ // entry, modifying one of them modifies the other
+ template<class T>
+ class CCSymmetricMatrix : public virtual ACMatrix<T>
+ {
+
+ public:
+
+  // Empty constructor
+  CCSymmetricMatrix();
+
+  // Constructor to create an n X n zero matrix
+  CCSymmetricMatrix(const unsigned long n);
+
+  // Copy constructor
+  CCSymmetricMatrix(const CCSymmetricMatrix &copy);
+
+  // Move constructor, the source matrix is left empty
+  CCSymmetricMatrix(CCSymmetricMatrix &&source_matrix);
+
+  // Destructor
+  virtual ~CCSymmetricMatrix();
+
+  // Assignment operator
+  CCSymmetricMatrix &operator=(const CCSymmetricMatrix &source_matrix);
+
+  // Move assignment operator, the source matrix is left empty
+  CCSymmetricMatrix &operator=(CCSymmetricMatrix &&source_matrix);
+
+  // Allows to create a matrix with the given size (m must be equal to
+  // n)
+  void allocate_memory(const unsigned long m,
+                       const unsigned long n);
+
+  // Allows to create an n X n matrix
+  void allocate_memory(const unsigned long n);
+
+  // Fills the matrix with zeroes
+  void fill_with_zeroes();
+
+  // Transforms the input DENSE matrix to a symmetric matrix, only the
+  // upper triangle of the input matrix is read
+  void set_matrix(const T *matrix_pt,
+                  const unsigned long m,
+                  const unsigned long n);
+
+  // Clean up for any dynamically stored data
+  void clean_up();
+
+  // Free allocated memory for matrix
+  void free_memory_for_matrix();
+
+  // Get the specified value from the matrix (read-only)
+  const T value(const unsigned long i, const unsigned long j) const;
+
+  // Set values in the matrix (write version), the (j, i) entry is
+  // also modified
+  T &value(const unsigned long i, const unsigned long j);
+
+  /// Permute the rows in the list (not supported, the matrix would
+  /// not be symmetric)
+  void permute_rows(std::vector<std::pair<unsigned long, unsigned long> > &permute_list);
+
+  /// Permute the columns in the list (not supported)
+  void permute_columns(std::vector<std::pair<unsigned long, unsigned long> > &permute_list);
+
+  /// Permute rows i and j (not supported)
+  void permute_rows(const unsigned long &i, const unsigned long &j);
+
+  /// Permute columns i and j (not supported)
+  void permute_columns(const unsigned long &i, const unsigned long &j);
+
+  // Output the matrix
+  void output(bool output_indexes = false) const;
+
+  // Output to file
+  void output(std::ofstream &outfile, bool output_indexes = false) const;
+
+  // Copy the matrix into a dense matrix
+  void to_dense(CCMatrix<T> &dense_matrix) const;
+
+  // The number of entries stored
+  inline unsigned long n_packed_values() const
+  {return this->NRows * (this->NRows + 1) / 2;}
+
+  // The position of the (i, j) entry, i <= j, in the packed storage
+  static inline unsigned long packed_index(const unsigned long i, const unsigned long j)
+  {return j * (j + 1) / 2 + i;}
+
+  // Get access to the Packed_pt
+  inline T *packed_pt() const {return Packed_pt;}
+
+ protected:
+
+  // Throws an error indicating that permutations are not supported
+  void error_permutations_not_supported() const;
+
+  // Takes the memory of the source matrix (used by the move
+  // constructor and the move assignment operator)
+  void move_matrix(CCSymmetricMatrix &source_matrix);
+
+  // The entries of the upper triangle packed by columns
+  T *Packed_pt;
+
+ };
+
+ // ================================================================
+ // Extra methods to work with symmetric matrices and vectors
+ // ================================================================
+
+ // Multiply symmetric matrix times vector
+ template<class T>
+  void multiply_matrix_times_vector(const CCSymmetricMatrix<T> &matrix,
+                                    const CCVector<T> &vector,
+                                    CCVector<T> &solution_vector);
+
+ // Copies the upper triangle (i <= j) of the square matrix into the
+ // packed layout of CCSymmetricMatrix, packed_pt must have room for
+ // n * (n + 1) / 2 entries. If column_offset is given the entries of
+ // column j are copied at packed_pt + column_offset[j] instead. The
+ // lower triangle is not read
+ template<class T>
+  void copy_upper_triangle(const ACMatrix<T> &matrix, T *packed_pt,
+                           const unsigned long *column_offset = 0);
+
+ // Computes the distances between the points whose coordinates are
+ // given in the columns of the positions matrix (dimension X n_points,
+ // the same layout used by the mesh-free demos). Only the upper
+ // triangle is computed
+ template<class T>
+  void compute_distance_matrix(const ACMatrix<T> &positions,
+                               CCSymmetricMatrix<T> &distance_matrix);
+
+ // Computes the matrix with the radial function evaluated at the
+ // distances between the points given in the columns of the
+ // positions matrix, entry (i, j) is rbf.psi(|x_i - x_j|). The RBF
+ // type provides a psi(r) method (as ACRadialBaseFunction). Only the
+ // upper triangle is computed, the distances are not stored
+ template<class T, class RBF>
+  void compute_interpolation_matrix(const ACMatrix<T> &positions,
+                                    RBF &rbf,
+                                    CCSymmetricMatrix<T> &interpolation_matrix);
+
+}
+
+#endif // #ifndef CCSYMMETRICMATRIX_TPL_H
@@ -11,7 +11,7 @@ namespace scicellxx
  // ===================================================================
  template<class T>
  CCVector<T>::CCVector() 
-  : ACVector<T>()
+  : ACVector<T>(), Is_memory_shared(false)
  {
   // Delete any data in memory
   clean_up();
@@ -24,7 +24,7 @@ namespace scicellxx
  // ===================================================================
  template<class T>
  CCVector<T>::CCVector(const unsigned long n, bool is_column_vector)
-  : ACVector<T>(n, is_column_vector)
+  : ACVector<T>(n, is_column_vector), Is_memory_shared(false)
  {
   // Allocate memory
   allocate_memory(n);
@@ -36,7 +36,7 @@ namespace scicellxx
  template<class T>
  CCVector<T>::CCVector(T *vector_pt, const unsigned long n,
                        bool is_column_vector)
-  : ACVector<T>(n, is_column_vector)
+  : ACVector<T>(n, is_column_vector), Is_memory_shared(false)
  {
   // Copy the data from the input vector to the Vector_pt vector
   set_vector(vector_pt, n, is_column_vector);
@@ -47,12 +47,39 @@ namespace scicellxx
  // ===================================================================
  template<class T>
  CCVector<T>::CCVector(const CCVector<T> &copy)
-  : ACVector<T>(copy.n_values(), copy.is_column_vector())
+  : ACVector<T>(copy.n_values(), copy.is_column_vector()), Is_memory_shared(false)
  {
   // Copy the data from the input vector to the Vector_pt vector
   set_vector(copy.vector_pt(), this->NValues, copy.is_column_vector());
  }
  
+ // ===================================================================
+ // Move constructor
+ // ===================================================================
+ template<class T>
+ CCVector<T>::CCVector(CCVector<T> &&source_vector)
+  : ACVector<T>(), Is_memory_shared(false)
+ {
+  // Delete any data in memory
+  clean_up();
+  // Take the memory of the source vector
+  move_vector(source_vector);
+ }
+ 
+ // ===================================================================
+ // Constructor from an expression
+ // ===================================================================
+ template<class T>
+ template<class E>
+ CCVector<T>::CCVector(const CCVectorExpression<T, E> &expression)
+  : ACVector<T>(), Is_memory_shared(false)
+ {
+  // Delete any data in memory
+  clean_up();
+  // Evaluate the expression
+  evaluate_expression(expression.expression());
+ }
+ 
  // ===================================================================
  // Empty destructor
  // ===================================================================
@@ -78,6 +105,24 @@ namespace scicellxx
   
  }
  
+ // ===================================================================
+ // Move assignment operator
+ // ===================================================================
+ template<class T>
+ CCVector<T>& CCVector<T>::operator=(CCVector<T> &&source_vector)
+ {
+  // Check for self-assignment
+  if (this != &source_vector)
+   {
+    // Clean-up and take the memory of the source vector
+    clean_up();
+    move_vector(source_vector);
+   }
+  
+  // Return this (de-referenced pointer)
+  return *this;
+ }
+ 
  // ===================================================================
  // += operator
  // ===================================================================
@@ -103,30 +148,111 @@ namespace scicellxx
  }
  
  // ===================================================================
- // Add operator
+ // Assignment from an expression
  // ===================================================================
  template<class T>
- CCVector<T> CCVector<T>::operator+(const CCVector<T> &vector)
+ template<class E>
+ CCVector<T>& CCVector<T>::operator=(const CCVectorExpression<T, E> &expression)
  {
-  // Create a zero vector where to store the result
-  CCVector<T> solution(this->NValues);
-  // Call the method to perform the addition
-  add_vector(vector, solution);
+  // Evaluate the expression
+  evaluate_expression(expression.expression());
+  // Return this (de-referenced pointer)
+  return *this;
+ }
+ 
+ // ===================================================================
+ // += operator for expressions
+ // ===================================================================
+ template<class T>
+ template<class E>
+ CCVector<T>& CCVector<T>::operator+=(const CCVectorExpression<T, E> &expression)
+ {
+  // Check that the dimensions are the same (the expression is
+  // evaluated on THIS vector, we can not re-allocate memory)
+  const E &e = expression.expression();
+  if (!this->Is_own_memory_allocated || this->NValues != e.n_values() ||
+      this->Is_column_vector != e.is_column_vector())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The dimension of the vectors is not the same or\n"
+                  << "this vector has no memory allocated:\n"
+                  << "dim(expression) = (" << e.n_values() << ")\n"
+                  << "dim(this) = (" << this->NValues << ")\n"
+                  << "this->Is_own_memory_allocated = "
+                  << this->Is_own_memory_allocated << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                           SCICELLXX_CURRENT_FUNCTION,
+                           SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  // Perform the operation (an entry of the expression only depends on
+  // the same entry of the operands, thus this vector may appear in
+  // the expression)
+  const unsigned long n_values = this->NValues;
+  for (unsigned long i = 0; i < n_values; i++)
+   {
+    Vector_pt[i]+= e.entry(i);
+   }
+  
   // Return the solution vector
-  return solution;
+  return *this;
  }
  
  // ===================================================================
- // Substraction operator
+ // -= operator for expressions
  // ===================================================================
  template<class T>
- CCVector<T> CCVector<T>::operator-(const CCVector<T> &vector)
+ template<class E>
+ CCVector<T>& CCVector<T>::operator-=(const CCVectorExpression<T, E> &expression)
  {
-  // Create a zero vector where to store the result
-  CCVector<T> solution(this->NValues);
-  // Call the method to perform the operation
-  substract_vector(vector, solution);
-  return solution;
+  // Add the negative of the expression
+  return (*this)+=(T(-1) * expression);
+ }
+ 
+ // ===================================================================
+ // Evaluates the expression and stores the result in this vector
+ // ===================================================================
+ template<class T>
+ template<class E>
+ void CCVector<T>::evaluate_expression(const E &expression)
+ {
+  const unsigned long n_values = expression.n_values();
+  
+  // If the vector has the correct size then evaluate in place. An
+  // entry of the expression only depends on the same entry of the
+  // operands, thus this vector may appear in the expression
+  if (this->Is_own_memory_allocated && this->NValues == n_values)
+   {
+    for (unsigned long i = 0; i < n_values; i++)
+     {
+      Vector_pt[i] = expression.entry(i);
+     }
+   }
+  else
+   {
+    // Evaluate in new memory before releasing the current one, it
+    // may be used in the expression
+    T *new_vector_pt = MemoryAllocator::new_array<T>(n_values);
+    for (unsigned long i = 0; i < n_values; i++)
+     {
+      new_vector_pt[i] = expression.entry(i);
+     }
+    
+    // Clean any possible previously allocated memory
+    clean_up();
+    
+    // Set the number of values and the new memory
+    this->NValues = n_values;
+    Vector_pt = new_vector_pt;
+    
+    // Mark the vector as allocated its own memory
+    this->Is_own_memory_allocated = true;
+   }
+  
+  // Set the transposed status
+  this->set_as_column_vector(expression.is_column_vector());
+  
  }
   
  // ===================================================================
@@ -231,11 +357,8 @@ namespace scicellxx
   // Store the dot product of the vectors
   T dot_product = 0.0;
   
-  // Compute the dot product
-  for (unsigned long i = 0; i < n_values_this_vector; i++)
-   {
-    dot_product+= Vector_pt[i] * right_vector_pt[i];
-   }
+  // Compute the dot product (in parallel for large vectors)
+  dot_product = ParallelKernels::dot(n_values_this_vector, Vector_pt, right_vector_pt);
   
   return dot_product;
   
@@ -257,7 +380,7 @@ namespace scicellxx
   this->NValues = n;
   
   // Allocate memory for the vector
-  Vector_pt = new T[n];
+  Vector_pt = MemoryAllocator::new_array<T>(n);
   
   // Mark the vector as allocated its own memory
   this->Is_own_memory_allocated = true;
@@ -270,14 +393,96 @@ namespace scicellxx
   
  }
  
+ // ===================================================================
+ // Takes the memory of the source vector. The memory is only
+ // transferred if the source vector is allowed to delete it, otherwise
+ // the entries are copied. In both cases the source vector is left
+ // empty. THIS vector should have no memory allocated
+ // ===================================================================
+ template<class T>
+ void CCVector<T>::move_vector(CCVector<T> &source_vector)
+ {
+  if (source_vector.is_own_memory_allocated())
+   {
+    if (source_vector.delete_vector())
+     {
+      // Transfer ownership
+      this->NValues = source_vector.NValues;
+      Vector_pt = source_vector.Vector_pt;
+      this->Is_own_memory_allocated = true;
+      
+      // Leave the source vector empty, with no memory
+      source_vector.NValues = 0;
+      source_vector.Vector_pt = 0;
+      source_vector.Is_own_memory_allocated = false;
+     }
+    else
+     {
+      // The memory of the source vector is managed somewhere else,
+      // copy the entries
+      set_vector(source_vector.vector_pt(),
+                 source_vector.n_values(),
+                 source_vector.is_column_vector());
+     }
+   }
+  else
+   {
+    // Nothing to transfer, only the dimension (the source vector is
+    // left empty)
+    this->NValues = source_vector.NValues;
+    source_vector.NValues = 0;
+   }
+  
+  // Set the transposed status
+  this->set_as_column_vector(source_vector.is_column_vector());
+  
+ }
+ 
+ // ===================================================================
+ // Uses the given memory to store the entries, the entries are not
+ // copied and the memory is not released by the vector
+ // ===================================================================
+ template<class T>
+ void CCVector<T>::share_vector(T *vector_pt,
+                                const unsigned long n,
+                                bool is_column_vector)
+ {
+  // Clean any possible previously allocated memory
+  clean_up();
+  
+  // Set the number of values
+  this->NValues = n;
+  
+  // Use the given memory
+  Vector_pt = vector_pt;
+  
+  // The vector has memory but it is not allowed to release it,
+  // moving the vector copies the entries
+  this->Is_own_memory_allocated = true;
+  this->Delete_vector = false;
+  Is_memory_shared = true;
+  
+  // Set the transposed status
+  this->set_as_column_vector(is_column_vector);
+  
+ }
+ 
  // ===================================================================
  // Clean up for any dynamically stored data
  // ===================================================================
  template<class T>
  void CCVector<T>::clean_up()
  {
+  // The shared memory is not released, only forget about it
+  if (Is_memory_shared)
+   {
+    Vector_pt = 0;
+    this->Is_own_memory_allocated = false;
+    this->Delete_vector = true;
+    Is_memory_shared = false;
+   }
   // Check whether the Vector allocated its own memory
-  if (this->Is_own_memory_allocated)
+  else if (this->Is_own_memory_allocated)
    {
     // Mark the vector as deleteable
     this->Delete_vector = true;
@@ -303,7 +508,7 @@ namespace scicellxx
   // marked for deletion
   if (this->Delete_vector)
    {
-    delete [] Vector_pt;
+    MemoryAllocator::delete_array(Vector_pt);
     Vector_pt = 0; 
     
     // Mark the vector as not having memory allocated
@@ -406,10 +611,8 @@ namespace scicellxx
   // Get the vector pointer of the input vector
   T *vector_pt = vector.vector_pt();
   // Perform the addition
-  for (unsigned long i = 0; i < n_values_this_vector; i++)
-   {
-    solution_vector_pt[i] = Vector_pt[i] + vector_pt[i];
-   }
+  ParallelKernels::add(n_values_this_vector, Vector_pt, vector_pt,
+                       solution_vector_pt);
   
  }
  
@@ -496,10 +699,8 @@ namespace scicellxx
   // Get the vector pointer of the input vector
   T *vector_pt = vector.vector_pt();
   // Perform the addition
-  for (unsigned long i = 0; i < n_values_this_vector; i++)
-   {
-    solution_vector_pt[i] = Vector_pt[i] - vector_pt[i];
-   }
+  ParallelKernels::substract(n_values_this_vector, Vector_pt, vector_pt,
+                             solution_vector_pt);
   
  }
  
@@ -587,10 +788,8 @@ namespace scicellxx
   // Get the vector pointer of the input vector
   T *vector_pt = vector.vector_pt();
   // Perform the addition
-  for (unsigned long i = 0; i < n_values_this_vector; i++)
-   {
-    solution_vector_pt[i] = Vector_pt[i] * vector_pt[i];
-   }
+  ParallelKernels::multiply_element_by_element(n_values_this_vector, Vector_pt, vector_pt,
+                                               solution_vector_pt);
   
  }
  
@@ -775,11 +974,8 @@ namespace scicellxx
   // Check whether the vector has memory allocated
   if (this->Is_own_memory_allocated)
    {
-    // Compute the norm
-    for (unsigned long i = 0; i < this->NValues; i++)
-     {
-      sum+= std::fabs(Vector_pt[i]);
-     }
+    // Compute the norm (in parallel for large vectors)
+    sum = ParallelKernels::sum_of_absolute_values(this->NValues, Vector_pt);
    }
   else
    {
@@ -803,16 +999,14 @@ namespace scicellxx
  template<class T>
  T CCVector<T>::norm_2()
  {
-  // Sum
-  T sum = 0.0;
+  // Norm
+  T norm = 0.0;
   // Check whether the vector has memory allocated
   if (this->Is_own_memory_allocated)
    {
-    // Compute the norm 2
-    for (unsigned long i = 0; i < this->NValues; i++)
-     {
-      sum+= (Vector_pt[i]*Vector_pt[i]);
-     }
+    // Compute the norm 2 (in parallel for large vectors, or by BLAS),
+    // scaled such that it does not overflow nor underflow
+    norm = ParallelKernels::norm_2(this->NValues, Vector_pt);
    }
   else
    {
@@ -826,7 +1020,7 @@ namespace scicellxx
                            SCICELLXX_EXCEPTION_LOCATION);
    }
   
-  return sqrt(sum);
+  return norm;
   
  }
 
@@ -841,14 +1035,8 @@ namespace scicellxx
   // Check whether the vector has memory allocated
   if (this->Is_own_memory_allocated)
    {
-    // Initialise the maximum with the first value
-    norm = std::fabs(Vector_pt[0]);
-    // Compute the norm
-    for (unsigned long i = 1; i < this->NValues; i++)
-     {
-      if (std::fabs(Vector_pt[i]) > norm)
-       norm = std::fabs(Vector_pt[i]);
-     }
+    // Compute the norm (in parallel for large vectors)
+    norm = ParallelKernels::max_absolute_value(this->NValues, Vector_pt);
    }
   else
    {
@@ -877,14 +1065,8 @@ namespace scicellxx
   // Check whether the vector has memory allocated
   if (this->Is_own_memory_allocated)
    {
-    // Initialise the maximum with the first value
-    max = Vector_pt[0];
-    // Compute the maximum
-    for (unsigned long i = 1; i < this->NValues; i++)
-     {
-      if (Vector_pt[i] > max)
-       max = Vector_pt[i];
-     }
+    // Compute the maximum (in parallel for large vectors)
+    max = ParallelKernels::maximum(this->NValues, Vector_pt);
    }
   else
    {
@@ -913,14 +1095,8 @@ namespace scicellxx
   // Check whether the vector has memory allocated
   if (this->Is_own_memory_allocated)
    {
-    // Initialise the minimum with the first value
-    min = Vector_pt[0];
-    // Compute the minimum
-    for (unsigned long i = 1; i < this->NValues; i++)
-     {
-      if (Vector_pt[i] < min)
-       min = Vector_pt[i];
-     }
+    // Compute the minimum (in parallel for large vectors)
+    min = ParallelKernels::minimum(this->NValues, Vector_pt);
    }
   else
    {
@@ -953,7 +1129,7 @@ namespace scicellxx
   //allocate_memory();
   
   // Allocate memory for the vector
-  Vector_pt = new T[this->NValues];
+  Vector_pt = MemoryAllocator::new_array<T>(this->NValues);
   
   // Mark the vector as allocated its own memory
   this->Is_own_memory_allocated=true;
@@ -1077,11 +1253,8 @@ namespace scicellxx
   // Store the dot product of the vectors
   T dot_product = 0.0;
   
-  // Compute the dot product
-  for (unsigned long i = 0; i < n_values_left_vector; i++)
-   {
-    dot_product+= left_vector_pt[i] * right_vector_pt[i];
-   }
+  // Compute the dot product (in parallel for large vectors)
+  dot_product = ParallelKernels::dot(n_values_left_vector, left_vector_pt, right_vector_pt);
   
   return dot_product;
   
@@ -1174,10 +1347,8 @@ namespace scicellxx
   T *vector_two_pt = vector_two.vector_pt();
   
   // Perform the addition
-  for (unsigned long i = 0; i < n_values_vector_one; i++)
-   {
-    solution_vector_pt[i] = vector_one_pt[i] + vector_two_pt[i];
-   }
+  ParallelKernels::add(n_values_vector_one, vector_one_pt, vector_two_pt,
+                       solution_vector_pt);
   
  }
 
@@ -1268,10 +1439,8 @@ namespace scicellxx
   T *vector_two_pt = vector_two.vector_pt();
   
   // Perform the substraction of vectors
-  for (unsigned long i = 0; i < n_values_vector_one; i++)
-   {
-    solution_vector_pt[i] = vector_one_pt[i] - vector_two_pt[i];
-   }
+  ParallelKernels::substract(n_values_vector_one, vector_one_pt, vector_two_pt,
+                             solution_vector_pt);
   
  }
 
@@ -1362,10 +1531,8 @@ namespace scicellxx
   T *vector_two_pt = vector_two.vector_pt();
   
   // Perform the substraction of vectors
-  for (unsigned long i = 0; i < n_values_vector_one; i++)
-   {
-    solution_vector_pt[i] = vector_one_pt[i] * vector_two_pt[i];
-   }
+  ParallelKernels::multiply_element_by_element(n_values_vector_one, vector_one_pt, vector_two_pt,
+                                               solution_vector_pt);
   
  }
  
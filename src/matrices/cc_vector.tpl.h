@@ -7,6 +7,12 @@
 
 // The parent class
 #include "ac_vector.h"
+// Expression templates for element-wise operations
+#include "cc_expressions.h"
+// The allocator for the entries of the vector
+#include "../general/memory_allocator.h"
+// Parallel element-wise operations and reductions
+#include "parallel_kernels.h"
 
 namespace scicellxx
 {
@@ -25,7 +31,8 @@ namespace scicellxx
  
  // Concrete class to represent vectors
  template<class T>
-  class CCVector : public virtual ACVector<T>
+  class CCVector : public virtual ACVector<T>,
+  public CCVectorExpression<T, CCVector<T> >
   {
    
   public:
@@ -35,8 +42,10 @@ namespace scicellxx
    
    // Constructor to create an n size zero vector (we assume vectors
    // are created as column vectors, if you need a row vector then
-   // pass "false" as the second parameter)
-   CCVector(const unsigned long n, bool is_column_vector = true);
+   // pass "false" as the second parameter). It is explicit such that
+   // a scalar is never converted into a vector, h * a and a * h are
+   // always scaled vector expressions
+   explicit CCVector(const unsigned long n, bool is_column_vector = true);
    
    // Constructor where we pass the data for the vector of size n.
    CCVector(T *vector_pt, const unsigned long n, bool is_column_vector = true);
@@ -45,23 +54,46 @@ namespace scicellxx
    // operators overloading as sum and assignment)
    CCVector(const CCVector &copy);
    
+   // Move constructor, takes the memory of the source vector if it is
+   // allowed to be deleted by it, otherwise the entries are copied.
+   // The source vector is left empty
+   CCVector(CCVector &&source_vector);
+   
+   // Constructor from an expression (a + b, h * a, ...), the
+   // expression is evaluated in a single loop
+   template<class E>
+    CCVector(const CCVectorExpression<T, E> &expression);
+   
    // Destructor
    virtual ~CCVector();
    
    // Assignment operator
    CCVector& operator=(const CCVector &source_vector);
    
+   // Move assignment operator, same rules as in the move constructor
+   CCVector& operator=(CCVector &&source_vector);
+   
    // += operator
    CCVector& operator+=(const CCVector &vector);
    
    // -= operator
    CCVector& operator-=(const CCVector &vector);
    
-   // Add operator
-   CCVector operator+(const CCVector &vector);
+   // Assignment from an expression (a + b, h * a, ...), the
+   // expression is evaluated in a single loop with no temporaries
+   template<class E>
+    CCVector& operator=(const CCVectorExpression<T, E> &expression);
+   
+   // += operator for expressions
+   template<class E>
+    CCVector& operator+=(const CCVectorExpression<T, E> &expression);
    
-   // Substraction operator
-   CCVector operator-(const CCVector &vector);
+   // -= operator for expressions
+   template<class E>
+    CCVector& operator-=(const CCVectorExpression<T, E> &expression);
+   
+   // The add (+) and substraction (-) operators are implemented by
+   // means of expression templates, check cc_expressions.h
    
    // Multiplication operator (it returns a matrix with the
    // corresponding size, if you require a dot product operation use
@@ -85,6 +117,14 @@ namespace scicellxx
                    const unsigned long n,
                    bool is_column_vector = true);
    
+   // Uses the given memory to store the n entries of the vector, the
+   // entries are not copied and the memory is not released by the
+   // vector, it must remain valid while the vector uses it (until
+   // clean_up() or the destructor are called)
+   void share_vector(T *vector_pt,
+                     const unsigned long n,
+                     bool is_column_vector = true);
+   
    // Clean up for any dynamically stored data
    void clean_up();
    
@@ -126,6 +166,17 @@ namespace scicellxx
    // Get access to the Vector_pt
    inline T *vector_pt() const {return Vector_pt;}
    
+   // Is the memory of the entries shared (set by share_vector())
+   inline bool is_memory_shared() const {return Is_memory_shared;}
+   
+   // Get the span with the memory where the entries are stored
+   inline CCVectorSpan<T> span() const
+   {return CCVectorSpan<T>(Vector_pt, this->NValues, 1);}
+   
+   // Get the i-th entry with no range check, used to evaluate
+   // expressions
+   inline T entry(const unsigned long i) const {return Vector_pt[i];}
+   
    // Computes the norm-1 of the vector
    T norm_1();
    
@@ -142,10 +193,22 @@ namespace scicellxx
    T min();
    
   protected:
-      
+   
+   // Evaluates the expression and stores the result in this vector
+   template<class E>
+    void evaluate_expression(const E &expression);
+   
+   // Takes the memory of the source vector (used by the move
+   // constructor and the move assignment operator)
+   void move_vector(CCVector &source_vector);
+   
    // The vector
    T *Vector_pt;
    
+   // Flag to indicate whether the memory of the entries is shared, in
+   // which case it is not released by the vector
+   bool Is_memory_shared;
+   
   };
  
  // ================================================================
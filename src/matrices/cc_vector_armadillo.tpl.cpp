@@ -257,7 +257,10 @@ namespace scicellxx
    }
   
   // Store the dot product of the vectors
-  const T dot_product = arma::dot(*Arma_vector_pt, *(right_vector.arma_vector_pt()));
+  // The same kernel as CCVector, vectorised and accumulated in double
+  // for float entries
+  const T dot_product = ParallelKernels::dot(n_values_this_vector, Arma_vector_pt->memptr(),
+                                             right_vector.arma_vector_pt()->memptr());
   // Return the dot product
   return dot_product;
   
@@ -321,6 +324,50 @@ namespace scicellxx
   this->set_as_column_vector(is_column_vector);
   
  }
+
+ // ===================================================================
+ // Uses the n entries at vector_pt with no copy
+ // ===================================================================
+ template<class T>
+ void CCVectorArmadillo<T>::share_vector(T *vector_pt,
+                                         const unsigned long n,
+                                         bool is_column_vector)
+ {
+  // Clean any possible previously allocated memory
+  clean_up();
+  
+  // Set the number of values
+  this->NValues = n;
+  
+  // Create an Armadillo's matrix that uses the given memory (the
+  // memory is not copied nor released by Armadillo and the size of
+  // the vector can not be changed)
+  if (is_column_vector)
+   {
+    Arma_vector_pt = new arma::Mat<T>(vector_pt, n, 1, false, true);
+   }
+  else
+   {
+    Arma_vector_pt = new arma::Mat<T>(vector_pt, 1, n, false, true);
+   }
+  
+  // Mark the vector as having memory (only the Armadillo's matrix is
+  // deleted by clean_up())
+  this->Is_own_memory_allocated = true;
+  
+  // Set the transposed status
+  this->set_as_column_vector(is_column_vector);
+  
+ }
+ 
+ // ===================================================================
+ // Uses the entries of a CCVector with no copy
+ // ===================================================================
+ template<class T>
+ void CCVectorArmadillo<T>::share_vector(CCVector<T> &vector)
+ {
+  share_vector(vector.vector_pt(), vector.n_values(), vector.is_column_vector());
+ }
  
  // ===================================================================
  // Clean up for any dynamically stored data
@@ -827,8 +874,8 @@ namespace scicellxx
   // Check whether the vector has memory allocated
   if (this->Is_own_memory_allocated)
    {
-    // Compute the norm
-    sum = arma::norm((*Arma_vector_pt), 1);
+    // Compute the norm (the same kernel as CCVector)
+    sum = ParallelKernels::sum_of_absolute_values(this->NValues, Arma_vector_pt->memptr());
    }
   else
    {
@@ -857,8 +904,9 @@ namespace scicellxx
   // Check whether the vector has memory allocated
   if (this->Is_own_memory_allocated)
    {
-    // Compute the norm
-    sum = arma::norm((*Arma_vector_pt), 2);
+    // Compute the norm (the same kernel as CCVector, scaled such that
+    // it does not overflow nor underflow)
+    sum = ParallelKernels::norm_2(this->NValues, Arma_vector_pt->memptr());
    }
   else
    {
@@ -887,8 +935,8 @@ namespace scicellxx
   // Check whether the vector has memory allocated
   if (this->Is_own_memory_allocated)
    {
-    // Compute the norm
-    norm = arma::norm((*Arma_vector_pt), "inf");
+    // Compute the norm (the same kernel as CCVector)
+    norm = ParallelKernels::max_absolute_value(this->NValues, Arma_vector_pt->memptr());
    }
   else
    {
@@ -916,8 +964,8 @@ namespace scicellxx
   // Check whether the vector has memory allocated
   if (this->Is_own_memory_allocated)
    {
-    // Compute the maximum
-    max = Arma_vector_pt->max();
+    // Compute the maximum (the same kernel as CCVector)
+    max = ParallelKernels::maximum(this->NValues, Arma_vector_pt->memptr());
    }
   else
    {
@@ -945,8 +993,8 @@ namespace scicellxx
   // Check whether the vector has memory allocated
   if (this->Is_own_memory_allocated)
    {
-    // Compute the minimum
-    min = Arma_vector_pt->min();
+    // Compute the minimum (the same kernel as CCVector)
+    min = ParallelKernels::minimum(this->NValues, Arma_vector_pt->memptr());
    }
   else
    {
@@ -1110,7 +1158,9 @@ namespace scicellxx
    }
   
   // Store the dot product of the vectors
-  const T dot_product = arma::dot(*(left_vector.arma_vector_pt()), *(right_vector.arma_vector_pt()));
+  // (the same kernel as CCVector)
+  const T dot_product = ParallelKernels::dot(n_values_left_vector, left_vector.arma_vector_pt()->memptr(),
+                                             right_vector.arma_vector_pt()->memptr());
   // Return the dot product
   return dot_product;
   
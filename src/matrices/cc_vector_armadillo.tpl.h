@@ -50,6 +50,7 @@ namespace scicellxx
    CCVectorArmadillo(T *vector_pt, const unsigned long n, bool is_column_vector = true);
    
    // Constructor that creates an Armadillo's vector from a CCVector
+   // (the entries are copied, use share_vector() to avoid the copy)
    CCVectorArmadillo(CCVector<T> &vector);
    
    // Copy constructor (we require to define this if we want to use
@@ -100,6 +101,16 @@ namespace scicellxx
    void set_vector(arma::Mat<T> *arma_vector_pt,
                    const unsigned long n, bool is_column_vector = true);
    
+   // Uses the n entries at vector_pt with no copy (Armadillo's
+   // advanced constructor). The memory is not released by this
+   // vector, thus it must outlive it
+   void share_vector(T *vector_pt,
+                     const unsigned long n, bool is_column_vector = true);
+   
+   // Uses the entries of a CCVector with no copy, the CCVector must
+   // outlive this vector
+   void share_vector(CCVector<T> &vector);
+   
    // Clean up for any dynamically stored data
    void clean_up();
    
@@ -138,6 +149,16 @@ namespace scicellxx
    // Get access to the Armadillo's vector
    inline arma::Mat<T> *arma_vector_pt() const {return Arma_vector_pt;}
    
+   // Get the span with the memory where the entries are stored
+   inline CCVectorSpan<T> span() const
+   {
+    if (Arma_vector_pt == 0)
+     {
+      return CCVectorSpan<T>();
+     }
+    return CCVectorSpan<T>(Arma_vector_pt->memptr(), this->NValues, 1);
+   }
+   
    // Computes the norm-1 of the vector
    T norm_1();
    
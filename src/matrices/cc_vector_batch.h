@@ -0,0 +1,7 @@
+// Include header and tpl.cpp files implementing templates. We may use
+// this file to force the instantiation of specific templates
+#ifndef CCVECTORBATCH_H
+#define CCVECTORBATCH_H
+#include "cc_vector_batch.tpl.h"
+#include "cc_vector_batch.tpl.cpp"
+#endif // #ifndef CCVECTORBATCH_H
@@ -0,0 +1,234 @@
+// IN THIS FILE: Implementation of a concrete class to represent a
+// batch of vectors with interleaved entries
+
+#include "cc_vector_batch.tpl.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ // Empty constructor
+ // ===================================================================
+ template<class T>
+ CCVectorBatch<T>::CCVectorBatch()
+  : N_batch(0), N_values(0), Data_pt(0)
+ { }
+
+ // ===================================================================
+ // Constructor to create a batch of n_batch zero vectors with n
+ // entries
+ // ===================================================================
+ template<class T>
+ CCVectorBatch<T>::CCVectorBatch(const unsigned long n_batch, const unsigned long n)
+  : N_batch(0), N_values(0), Data_pt(0)
+ {
+  allocate_memory(n_batch, n);
+ }
+
+ // ===================================================================
+ // Copy constructor
+ // ===================================================================
+ template<class T>
+ CCVectorBatch<T>::CCVectorBatch(const CCVectorBatch<T> &copy)
+  : N_batch(0), N_values(0), Data_pt(0)
+ {
+  if (copy.data_pt() != 0)
+   {
+    allocate_memory(copy.n_batch(), copy.n_values());
+    std::copy(copy.data_pt(), copy.data_pt() + N_batch * N_values, Data_pt);
+   }
+ }
+
+ // ===================================================================
+ // Move constructor
+ // ===================================================================
+ template<class T>
+ CCVectorBatch<T>::CCVectorBatch(CCVectorBatch<T> &&source_batch)
+  : N_batch(0), N_values(0), Data_pt(0)
+ {
+  // Take the memory of the source batch
+  move_batch(source_batch);
+ }
+
+ // ===================================================================
+ // Destructor
+ // ===================================================================
+ template<class T>
+ CCVectorBatch<T>::~CCVectorBatch()
+ {
+  // Deallocate memory
+  clean_up();
+ }
+
+ // ===================================================================
+ // Assignment operator
+ // ===================================================================
+ template<class T>
+ CCVectorBatch<T>& CCVectorBatch<T>::operator=(const CCVectorBatch<T> &source_batch)
+ {
+  // Check for self-assignment
+  if (this != &source_batch)
+   {
+    clean_up();
+    if (source_batch.data_pt() != 0)
+     {
+      allocate_memory(source_batch.n_batch(), source_batch.n_values());
+      std::copy(source_batch.data_pt(),
+                source_batch.data_pt() + N_batch * N_values, Data_pt);
+     }
+   }
+
+  // Return this (de-referenced pointer)
+  return *this;
+ }
+
+ // ===================================================================
+ // Move assignment operator
+ // ===================================================================
+ template<class T>
+ CCVectorBatch<T>& CCVectorBatch<T>::operator=(CCVectorBatch<T> &&source_batch)
+ {
+  // Check for self-assignment
+  if (this != &source_batch)
+   {
+    // Clean-up and take the memory of the source batch
+    clean_up();
+    move_batch(source_batch);
+   }
+
+  // Return this (de-referenced pointer)
+  return *this;
+ }
+
+ // ===================================================================
+ // Allows to create a batch of n_batch vectors with n entries, all
+ // the entries are zero
+ // ===================================================================
+ template<class T>
+ void CCVectorBatch<T>::allocate_memory(const unsigned long n_batch,
+                                        const unsigned long n)
+ {
+  // Clean any possibly stored data
+  clean_up();
+
+  N_batch = n_batch;
+  N_values = n;
+
+  // A single allocation for all the vectors
+  const unsigned long n_entries = n_batch * n;
+  Data_pt = MemoryAllocator::new_array<T>(n_entries);
+  std::fill(Data_pt, Data_pt + n_entries, T(0));
+ }
+
+ // ===================================================================
+ // Fills the vectors with zeroes
+ // ===================================================================
+ template<class T>
+ void CCVectorBatch<T>::fill_with_zeroes()
+ {
+  // Check that the batch has memory allocated
+  if (Data_pt != 0)
+   {
+    std::fill(Data_pt, Data_pt + N_batch * N_values, T(0));
+   }
+  else
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The batch of vectors has no memory allocated\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+ }
+
+ // ===================================================================
+ // Clean up for any dynamically stored data
+ // ===================================================================
+ template<class T>
+ void CCVectorBatch<T>::clean_up()
+ {
+  if (Data_pt != 0)
+   {
+    MemoryAllocator::delete_array(Data_pt);
+    Data_pt = 0;
+   }
+  N_batch = 0;
+  N_values = 0;
+ }
+
+ // ===================================================================
+ // Copies the input vector into the b-th vector of the batch
+ // ===================================================================
+ template<class T>
+ void CCVectorBatch<T>::set_vector(const unsigned long b, const ACVector<T> &vector)
+ {
+  if (b >= N_batch || vector.n_values() != N_values)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The vector can not be stored in the batch\n"
+                  << "Batch member: " << b << " (batch size: " << N_batch << ")\n"
+                  << "Entries of the vector: " << vector.n_values()
+                  << " (entries of the vectors in the batch: " << N_values << ")\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  for (unsigned long i = 0; i < N_values; i++)
+   {
+    Data_pt[i * N_batch + b] = vector.value(i);
+   }
+ }
+
+ // ===================================================================
+ // Copies the b-th vector of the batch into the output vector, the
+ // output vector is allocated if its size is different
+ // ===================================================================
+ template<class T>
+ void CCVectorBatch<T>::get_vector(const unsigned long b, CCVector<T> &vector) const
+ {
+  if (b >= N_batch)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The batch member is out of range\n"
+                  << "Batch member: " << b << " (batch size: " << N_batch << ")\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  if (vector.n_values() != N_values || !vector.is_own_memory_allocated())
+   {
+    vector.allocate_memory(N_values);
+   }
+
+  for (unsigned long i = 0; i < N_values; i++)
+   {
+    vector(i) = Data_pt[i * N_batch + b];
+   }
+ }
+
+ // ===================================================================
+ // Takes the memory of the source batch (used by the move
+ // constructor and the move assignment operator)
+ // ===================================================================
+ template<class T>
+ void CCVectorBatch<T>::move_batch(CCVectorBatch<T> &source_batch)
+ {
+  N_batch = source_batch.N_batch;
+  N_values = source_batch.N_values;
+  Data_pt = source_batch.Data_pt;
+
+  // The source batch is left empty
+  source_batch.N_batch = 0;
+  source_batch.N_values = 0;
+  source_batch.Data_pt = 0;
+ }
+
+}
@@ -0,0 +1,115 @@
+// IN THIS FILE: The definition of a concrete class to store a batch
+// of independent vectors of the same size in a single allocation. The
+// entries are interleaved, the i-th entry of all the vectors of the
+// batch are contiguous in memory, thus the loops over the members of
+// the batch are mapped by the compiler to SIMD registers (one member
+// of the batch per lane). Used with the batches of matrices
+// (CCMatrixBatch) to solve many small independent systems at once
+
+// Check whether the class has been already defined
+#ifndef CCVECTORBATCH_TPL_H
+#define CCVECTORBATCH_TPL_H
+
+// The vectors stored in the batch
+#include "cc_vector.h"
+// The allocator for the entries
+#include "../general/memory_allocator.h"
+
+namespace scicellxx
+{
+
+ /// @class CCVectorBatch cc_vector_batch.h
+
+ // Concrete class to represent a batch of n_batch vectors with n
+ // entries each. The i-th entry of the b-th vector is stored at
+ // Data_pt[i * N_batch + b]
+ template<class T>
+ class CCVectorBatch
+ {
+
+ public:
+
+  // Empty constructor
+  CCVectorBatch();
+
+  // Constructor to create a batch of n_batch zero vectors with n
+  // entries
+  CCVectorBatch(const unsigned long n_batch, const unsigned long n);
+
+  // Copy constructor
+  CCVectorBatch(const CCVectorBatch &copy);
+
+  // Move constructor, the source batch is left empty
+  CCVectorBatch(CCVectorBatch &&source_batch);
+
+  // Destructor
+  virtual ~CCVectorBatch();
+
+  // Assignment operator
+  CCVectorBatch &operator=(const CCVectorBatch &source_batch);
+
+  // Move assignment operator, the source batch is left empty
+  CCVectorBatch &operator=(CCVectorBatch &&source_batch);
+
+  // Allows to create a batch of n_batch vectors with n entries, all
+  // the entries are zero
+  void allocate_memory(const unsigned long n_batch, const unsigned long n);
+
+  // Fills the vectors with zeroes
+  void fill_with_zeroes();
+
+  // Clean up for any dynamically stored data
+  void clean_up();
+
+  // Copies the input vector into the b-th vector of the batch
+  void set_vector(const unsigned long b, const ACVector<T> &vector);
+
+  // Copies the b-th vector of the batch into the output vector, the
+  // output vector is allocated if its size is different
+  void get_vector(const unsigned long b, CCVector<T> &vector) const;
+
+  // Get the i-th entry of the b-th vector (read-only)
+  inline const T value(const unsigned long b, const unsigned long i) const
+  {return Data_pt[i * N_batch + b];}
+
+  // Set the i-th entry of the b-th vector (write version)
+  inline T &value(const unsigned long b, const unsigned long i)
+  {return Data_pt[i * N_batch + b];}
+
+  // Get the i-th entry of the b-th vector (read-only)
+  inline const T operator()(const unsigned long b, const unsigned long i) const
+  {return value(b, i);}
+
+  // Set the i-th entry of the b-th vector (write version)
+  inline T &operator()(const unsigned long b, const unsigned long i)
+  {return value(b, i);}
+
+  // The number of vectors in the batch
+  inline unsigned long n_batch() const {return N_batch;}
+
+  // The number of entries of each vector
+  inline unsigned long n_values() const {return N_values;}
+
+  // Get access to the interleaved entries
+  inline T *data_pt() const {return Data_pt;}
+
+ protected:
+
+  // Takes the memory of the source batch (used by the move
+  // constructor and the move assignment operator)
+  void move_batch(CCVectorBatch &source_batch);
+
+  // The number of vectors in the batch
+  unsigned long N_batch;
+
+  // The number of entries of each vector
+  unsigned long N_values;
+
+  // The interleaved entries
+  T *Data_pt;
+
+ };
+
+}
+
+#endif // #ifndef CCVECTORBATCH_TPL_H
@@ -0,0 +1,7 @@
+// Include header and tpl.cpp files implementing templates. We may use
+// this file to force the instantiation of specific templates
+#ifndef CCVECTORVIEW_H
+#define CCVECTORVIEW_H
+#include "cc_vector_view.tpl.h"
+#include "cc_vector_view.tpl.cpp"
+#endif // #ifndef CCVECTORVIEW_H
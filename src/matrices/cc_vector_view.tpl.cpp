@@ -0,0 +1,429 @@
+// IN THIS FILE: Implementation of a concrete class to refer to the
+// entries of a vector stored somewhere else (a view)
+
+#include "cc_vector_view.tpl.h"
+
+namespace scicellxx
+{
+
+ // ===================================================================
+ // Empty constructor, the view refers to no entries
+ // ===================================================================
+ template<class T>
+ CCVectorView<T>::CCVectorView()
+  : ACVector<T>(), Data_pt(0), Stride(1)
+ {
+  // The entries are not owned by the view
+  this->Delete_vector = false;
+ }
+
+ // ===================================================================
+ // View of n entries starting at data_pt, separated by stride
+ // positions
+ // ===================================================================
+ template<class T>
+ CCVectorView<T>::CCVectorView(T *data_pt, const unsigned long n,
+                               const unsigned long stride,
+                               bool is_column_vector)
+  : ACVector<T>(n, is_column_vector), Data_pt(0), Stride(1)
+ {
+  // The entries are not owned by the view
+  this->Delete_vector = false;
+  set_view(data_pt, n, stride);
+ }
+
+ // ===================================================================
+ // View of the entries described by the span
+ // ===================================================================
+ template<class T>
+ CCVectorView<T>::CCVectorView(const CCVectorSpan<T> &span,
+                               bool is_column_vector)
+  : ACVector<T>(span.NValues, is_column_vector), Data_pt(0), Stride(1)
+ {
+  // The entries are not owned by the view
+  this->Delete_vector = false;
+  set_view(span.Data_pt, span.NValues, span.Stride);
+ }
+
+ // ===================================================================
+ // View of all the entries of the vector
+ // ===================================================================
+ template<class T>
+ CCVectorView<T>::CCVectorView(const ACVector<T> &vector)
+  : ACVector<T>(vector.n_values(), vector.is_column_vector()),
+    Data_pt(0), Stride(1)
+ {
+  // The entries are not owned by the view
+  this->Delete_vector = false;
+
+  const CCVectorSpan<T> vector_span = vector.span();
+  if (vector_span.is_empty())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The vector has no memory allocated or it does not store\n"
+                  << "its entries in a single block of memory" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  set_view(vector_span.Data_pt, vector_span.NValues, vector_span.Stride);
+ }
+
+ // ===================================================================
+ // View of n entries of the vector starting at the entry offset
+ // ===================================================================
+ template<class T>
+ CCVectorView<T>::CCVectorView(const ACVector<T> &vector,
+                               const unsigned long offset,
+                               const unsigned long n)
+  : ACVector<T>(n, vector.is_column_vector()), Data_pt(0), Stride(1)
+ {
+  // The entries are not owned by the view
+  this->Delete_vector = false;
+
+  const CCVectorSpan<T> vector_span = vector.span();
+  if (vector_span.is_empty())
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The vector has no memory allocated or it does not store\n"
+                  << "its entries in a single block of memory" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  if (offset + n > vector_span.NValues)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The segment is out of the range of the vector\n"
+                  << "Number of values: " << vector_span.NValues << "\n"
+                  << "Requested segment: [" << offset << ", "
+                  << offset + n << ")" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  set_view(vector_span.Data_pt + offset*vector_span.Stride, n,
+           vector_span.Stride);
+ }
+
+ // ===================================================================
+ // Copy constructor, both views refer to the same entries
+ // ===================================================================
+ template<class T>
+ CCVectorView<T>::CCVectorView(const CCVectorView<T> &copy)
+  : ACVector<T>(copy.n_values(), copy.is_column_vector()),
+    Data_pt(0), Stride(1)
+ {
+  // The entries are not owned by the view
+  this->Delete_vector = false;
+  if (copy.data_pt() != 0)
+   {
+    set_view(copy.data_pt(), copy.n_values(), copy.stride());
+   }
+ }
+
+ // ===================================================================
+ // Destructor, the entries are not deleted
+ // ===================================================================
+ template<class T>
+ CCVectorView<T>::~CCVectorView()
+ { }
+
+ // ===================================================================
+ // Refer to n entries starting at data_pt, separated by stride
+ // positions
+ // ===================================================================
+ template<class T>
+ void CCVectorView<T>::set_view(T *data_pt, const unsigned long n,
+                                const unsigned long stride)
+ {
+  if (data_pt == 0)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The view can not refer to a NULL pointer" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  Data_pt = data_pt;
+  this->NValues = n;
+  Stride = stride;
+
+  // The view refers to entries, the operations of ACVector check
+  // this flag before accessing them
+  this->Is_own_memory_allocated = true;
+ }
+
+ // ===================================================================
+ // A view does not allocate memory, throws an error
+ // ===================================================================
+ template<class T>
+ void CCVectorView<T>::allocate_memory(const unsigned long n)
+ {
+  // Error message
+  std::ostringstream error_message;
+  error_message << "A view can not allocate memory, use a CCVector to store\n"
+                << "the entries and create a view of it" << std::endl;
+  throw SciCellxxLibError(error_message.str(),
+                          SCICELLXX_CURRENT_FUNCTION,
+                          SCICELLXX_EXCEPTION_LOCATION);
+ }
+
+ // ===================================================================
+ // Fills the entries with zeroes
+ // ===================================================================
+ template<class T>
+ void CCVectorView<T>::fill_with_zeroes()
+ {
+  check_view();
+  for (unsigned long i = 0; i < this->NValues; i++)
+   {
+    Data_pt[i*Stride] = T(0);
+   }
+ }
+
+ // ===================================================================
+ // Copies the input entries into the entries referred by the view
+ // ===================================================================
+ template<class T>
+ void CCVectorView<T>::set_vector(const T *vector_pt,
+                                  const unsigned long n,
+                                  bool is_column_vector)
+ {
+  check_view();
+  if (n != this->NValues)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The number of entries is not the same as the one of\n"
+                  << "the view:\n"
+                  << "n = " << n << "\n"
+                  << "this->n_values() = " << this->NValues << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+
+  BulkKernels::copy(n, vector_pt, 1, Data_pt, Stride);
+  this->Is_column_vector = is_column_vector;
+ }
+
+ // ===================================================================
+ // The view stops referring to any entries
+ // ===================================================================
+ template<class T>
+ void CCVectorView<T>::clean_up()
+ {
+  free_memory_for_vector();
+ }
+
+ // ===================================================================
+ // The view stops referring to any entries (the entries are not
+ // deleted)
+ // ===================================================================
+ template<class T>
+ void CCVectorView<T>::free_memory_for_vector()
+ {
+  Data_pt = 0;
+  this->NValues = 0;
+  Stride = 1;
+  this->Is_own_memory_allocated = false;
+ }
+
+ // ===================================================================
+ // Get the specified value from the vector (read-only)
+ // ===================================================================
+ template<class T>
+ const T CCVectorView<T>::value(const unsigned long i) const
+ {
+#ifdef SCICELLXX_RANGE_CHECK
+  check_view();
+  if (i >= this->NValues)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The entry you are trying to access is out of range\n"
+                  << "Number of values: " << this->NValues << std::endl
+                  << "Requested entry: " << i << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+#endif // #ifdef SCICELLXX_RANGE_CHECK
+  return Data_pt[i*Stride];
+ }
+
+ // ===================================================================
+ // Set values in the vector (write version)
+ // ===================================================================
+ template<class T>
+ T &CCVectorView<T>::value(const unsigned long i)
+ {
+#ifdef SCICELLXX_RANGE_CHECK
+  check_view();
+  if (i >= this->NValues)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The entry you are trying to access is out of range\n"
+                  << "Number of values: " << this->NValues << std::endl
+                  << "Requested entry: " << i << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+#endif // #ifdef SCICELLXX_RANGE_CHECK
+  return Data_pt[i*Stride];
+ }
+
+ // ===================================================================
+ // Output the vector
+ // ===================================================================
+ template<class T>
+ void CCVectorView<T>::output(bool output_indexes) const
+ {
+  check_view();
+  // Check whether we should output the indexes
+  if (output_indexes)
+   {
+    for (unsigned long i = 0; i < this->NValues; i++)
+     {
+      std::cout << "(" << i << "): " << value(i) << std::endl;
+     } // for (i < this->NValues)
+   } // if (output_indexes)
+  else
+   {
+    for (unsigned long i = 0; i < this->NValues; i++)
+     {
+      std::cout << value(i) << " ";
+     } // for (i < this->NValues)
+    std::cout << std::endl;
+   } // else if (output_indexes)
+
+ }
+
+ // ===================================================================
+ // Output the vector
+ // ===================================================================
+ template<class T>
+ void CCVectorView<T>::output(std::ofstream &outfile,
+                              bool output_indexes) const
+ {
+  check_view();
+  // Check whether we should output the indexes
+  if (output_indexes)
+   {
+    for (unsigned long i = 0; i < this->NValues; i++)
+     {
+      outfile << "(" << i << "): " << value(i) << std::endl;
+     } // for (i < this->NValues)
+   } // if (output_indexes)
+  else
+   {
+    for (unsigned long i = 0; i < this->NValues; i++)
+     {
+      outfile << value(i) << " ";
+     } // for (i < this->NValues)
+    outfile << std::endl;
+   } // else if (output_indexes)
+
+ }
+
+ // ===================================================================
+ // Computes the norm-1 of the vector
+ // ===================================================================
+ template<class T>
+ T CCVectorView<T>::norm_1()
+ {
+  check_view();
+  return T(ParallelKernels::sum_of_absolute_values(this->NValues, Data_pt, Stride));
+ }
+
+ // ===================================================================
+ // Computes the norm-2 of the vector
+ // ===================================================================
+ template<class T>
+ T CCVectorView<T>::norm_2()
+ {
+  check_view();
+  return T(ParallelKernels::norm_2(this->NValues, Data_pt, Stride));
+ }
+
+ // ===================================================================
+ // Computes the infinite norm
+ // ===================================================================
+ template<class T>
+ T CCVectorView<T>::norm_inf()
+ {
+  check_view();
+  return ParallelKernels::max_absolute_value(this->NValues, Data_pt, Stride);
+ }
+
+ // ===================================================================
+ // Computes the maximum value
+ // ===================================================================
+ template<class T>
+ T CCVectorView<T>::max()
+ {
+  check_view();
+  return ParallelKernels::maximum(this->NValues, Data_pt, Stride);
+ }
+
+ // ===================================================================
+ // Computes the minimum value
+ // ===================================================================
+ template<class T>
+ T CCVectorView<T>::min()
+ {
+  check_view();
+  return ParallelKernels::minimum(this->NValues, Data_pt, Stride);
+ }
+
+ // ===================================================================
+ // Get access to the entries, only valid if they are consecutive in
+ // memory
+ // ===================================================================
+ template<class T>
+ T *CCVectorView<T>::vector_pt() const
+ {
+  if (Stride != 1)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The entries of the view are not consecutive in memory\n"
+                  << "stride() = " << Stride << "\n"
+                  << "Copy the view into a CCVector to get a pointer to\n"
+                  << "consecutive entries" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+  return Data_pt;
+ }
+
+ // ===================================================================
+ // Checks that the view refers to entries, throws an error otherwise
+ // ===================================================================
+ template<class T>
+ void CCVectorView<T>::check_view() const
+ {
+  if (Data_pt == 0)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The view does not refer to any entries" << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                            SCICELLXX_CURRENT_FUNCTION,
+                            SCICELLXX_EXCEPTION_LOCATION);
+   }
+ }
+
+}
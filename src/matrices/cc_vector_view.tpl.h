@@ -0,0 +1,148 @@
+// IN THIS FILE: The definition of a concrete class to refer to the
+// entries of a vector stored somewhere else (a view). The view does
+// not own the memory, no entries are copied when it is created, and
+// the entries may be separated by a stride (a row or a column of a
+// matrix, a segment of a vector, a row of the history values of a
+// CCData). Any operation on the view modifies the original entries
+
+// Check whether the class has been already defined
+#ifndef CCVECTORVIEW_TPL_H
+#define CCVECTORVIEW_TPL_H
+
+// The parent class
+#include "ac_vector.h"
+// Parallel reductions
+#include "parallel_kernels.h"
+
+namespace scicellxx
+{
+
+ /// @class CCVectorView cc_vector_view.h
+
+ // Concrete class to refer to the entries of a vector stored in memory
+ // not owned by this class. The i-th entry is stored at
+ // Data_pt[i*Stride]. The memory must outlive the view
+ template<class T>
+  class CCVectorView : public virtual ACVector<T>
+  {
+
+  public:
+
+   // Empty constructor, the view refers to no entries
+   CCVectorView();
+
+   // View of n entries starting at data_pt, separated by stride
+   // positions
+   CCVectorView(T *data_pt, const unsigned long n,
+                const unsigned long stride = 1,
+                bool is_column_vector = true);
+
+   // View of the entries described by the span
+   CCVectorView(const CCVectorSpan<T> &span, bool is_column_vector = true);
+
+   // View of all the entries of the vector (the vector should store
+   // its entries in a single block of memory)
+   CCVectorView(const ACVector<T> &vector);
+
+   // View of n entries of the vector starting at the entry offset
+   CCVectorView(const ACVector<T> &vector, const unsigned long offset,
+                const unsigned long n);
+
+   // Copy constructor, both views refer to the same entries
+   CCVectorView(const CCVectorView &copy);
+
+   // Destructor, the entries are not deleted
+   virtual ~CCVectorView();
+
+   // Refer to n entries starting at data_pt, separated by stride
+   // positions
+   void set_view(T *data_pt, const unsigned long n,
+                 const unsigned long stride = 1);
+
+   // A view does not allocate memory, throws an error
+   void allocate_memory(const unsigned long n);
+
+   // Fills the entries with zeroes
+   void fill_with_zeroes();
+
+   // Copies the input entries into the entries referred by the view,
+   // the number of entries should be the same
+   void set_vector(const T *vector_pt,
+                   const unsigned long n,
+                   bool is_column_vector = true);
+
+   // The view stops referring to any entries
+   void clean_up();
+
+   // The view stops referring to any entries (the entries are not
+   // deleted)
+   void free_memory_for_vector();
+
+   // Get the specified value from the vector (read-only)
+   const T value(const unsigned long i) const;
+
+   // Set values in the vector (write version)
+   T &value(const unsigned long i);
+
+   // Output the vector (output horizontally without indexes by
+   // default, otherwise output vertically with indexes)
+   void output(bool output_indexes = false) const;
+
+   // Output to file (output horizontally without indexes by default,
+   // otherwise output vertically with indexes)
+   void output(std::ofstream &outfile, bool output_indexes = false) const;
+
+   // Computes the norm-1 of the vector
+   T norm_1();
+
+   // Computes the norm-2 of the vector
+   T norm_2();
+
+   // Computes the infinite norm
+   T norm_inf();
+
+   // Computes the maximum value
+   T max();
+
+   // Computes the minimum value
+   T min();
+
+   // Get the span with the memory where the entries are stored
+   inline CCVectorSpan<T> span() const
+   {return CCVectorSpan<T>(Data_pt, this->NValues, Stride);}
+
+   // Get access to the entries, only valid if they are consecutive
+   // in memory (stride equal to one)
+   T *vector_pt() const;
+
+   // Get the pointer to the first entry
+   inline T *data_pt() const {return Data_pt;}
+
+   // Get the number of positions between two consecutive entries
+   inline unsigned long stride() const {return Stride;}
+
+  protected:
+
+   // Checks that the view refers to entries, throws an error otherwise
+   void check_view() const;
+
+   // The first entry
+   T *Data_pt;
+
+   // The number of positions between two consecutive entries
+   unsigned long Stride;
+
+  private:
+
+   // Assignment operator (a view is not assigned, use set_view() to
+   // refer to other entries or copy() to copy the entries)
+   CCVectorView& operator=(const CCVectorView &copy)
+    {
+     BrokenCopy::broken_assign("CCVectorView");
+    }
+
+  };
+
+}
+
+#endif // #ifndef CCVECTORVIEW_TPL_H
@@ -0,0 +1,633 @@
+// IN THIS FILE: Implementation of the cache-blocked and
+// register-blocked kernels to compute matrix-matrix products
+
+#include "gemm_kernels.h"
+// The interface to an optimised BLAS library
+#include "blas_kernels.h"
+
+#include <atomic>
+
+// The SIMD micro-kernels are only compiled for x86 processors with a
+// compiler that supports function target attributes, the instruction
+// set is enabled per function such that the library does not need to
+// be compiled with -mavx2 or -mavx512f
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SCICELLXX_GEMM_X86_KERNELS
+#include <immintrin.h>
+#endif // #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+namespace scicellxx
+{
+
+ namespace GEMMKernels
+ {
+
+  // Products with m*n*k below this value use the unblocked loop
+  unsigned long Small_product_threshold = 32*32*32;
+
+  // ================================================================
+  // Everything in this unnamed namespace is only visible in this file
+  // ================================================================
+  namespace
+  {
+   // The kernel requested by the user
+   std::atomic<Kernel_type> Requested_kernel(AUTO);
+
+   // The kernel resolved from the requested one (AUTO is not a valid
+   // value here once it has been resolved). It is resolved by the
+   // first call to gemm(), which may happen in several threads of the
+   // pool at the same time, thus it is atomic
+   std::atomic<Kernel_type> Resolved_kernel(AUTO);
+
+   // ===============================================================
+   // The sizes used to block the matrices. The micro-kernel computes
+   // an MR x NR tile of C. Panels of A of size MC x KC are packed to
+   // live in L2 cache, panels of B of size KC x NC are packed to live
+   // in L3 cache
+   // ===============================================================
+   struct Blocking
+   {
+    unsigned long MR;
+    unsigned long NR;
+    unsigned long MC;
+    unsigned long KC;
+    unsigned long NC;
+   };
+
+   // ===============================================================
+   // Packs a block of A of size mc x kc in panels of MR rows scaled
+   // by alpha. Each panel stores its entries column by column (MR
+   // consecutive values per column), rows out of the block are padded
+   // with zeroes
+   // ===============================================================
+   template<class T>
+    void pack_A(const unsigned long mc, const unsigned long kc,
+                const T alpha, const T *A, const unsigned long lda,
+                const unsigned long MR, T *packed_pt)
+    {
+     for (unsigned long ir = 0; ir < mc; ir+=MR)
+      {
+       const unsigned long mr = std::min(MR, mc-ir);
+       for (unsigned long p = 0; p < kc; p++)
+        {
+         for (unsigned long r = 0; r < mr; r++)
+          {
+           packed_pt[r] = alpha * A[(ir+r)*lda+p];
+          }
+         for (unsigned long r = mr; r < MR; r++)
+          {
+           packed_pt[r] = 0;
+          }
+         packed_pt+=MR;
+        }
+      }
+    }
+
+   // ===============================================================
+   // Packs a block of B of size kc x nc in panels of NR columns. Each
+   // panel stores its entries row by row (NR consecutive values per
+   // row), columns out of the block are padded with zeroes
+   // ===============================================================
+   template<class T>
+    void pack_B(const unsigned long kc, const unsigned long nc,
+                const T *B, const unsigned long ldb,
+                const unsigned long NR, T *packed_pt)
+    {
+     for (unsigned long jr = 0; jr < nc; jr+=NR)
+      {
+       const unsigned long nr = std::min(NR, nc-jr);
+       for (unsigned long p = 0; p < kc; p++)
+        {
+         const T *b_row_pt = B + p*ldb + jr;
+         for (unsigned long c = 0; c < nr; c++)
+          {
+           packed_pt[c] = b_row_pt[c];
+          }
+         for (unsigned long c = nr; c < NR; c++)
+          {
+           packed_pt[c] = 0;
+          }
+         packed_pt+=NR;
+        }
+      }
+    }
+
+   // ===============================================================
+   // Generic micro-kernel, computes C += A_panel * B_panel for an MR x
+   // NR tile of C. Written such that the compiler may vectorise the
+   // inner loop
+   // ===============================================================
+   template<class T, unsigned long MR, unsigned long NR>
+    void generic_micro_kernel(const unsigned long kc,
+                              const T *a_pt, const T *b_pt,
+                              T *c_pt, const unsigned long ldc)
+    {
+     T ab[MR*NR];
+     for (unsigned long i = 0; i < MR*NR; i++)
+      {
+       ab[i] = 0;
+      }
+     for (unsigned long p = 0; p < kc; p++)
+      {
+       for (unsigned long i = 0; i < MR; i++)
+        {
+         const T a_ip = a_pt[i];
+         for (unsigned long j = 0; j < NR; j++)
+          {
+           ab[i*NR+j]+= a_ip * b_pt[j];
+          }
+        }
+       a_pt+=MR;
+       b_pt+=NR;
+      }
+     for (unsigned long i = 0; i < MR; i++)
+      {
+       for (unsigned long j = 0; j < NR; j++)
+        {
+         c_pt[i*ldc+j]+= ab[i*NR+j];
+        }
+      }
+    }
+
+#ifdef SCICELLXX_GEMM_X86_KERNELS
+
+   // ===============================================================
+   // AVX2 micro-kernel for double, 6 x 8 tile of C in 12 registers
+   // ===============================================================
+   __attribute__((target("avx2,fma")))
+    void avx2_micro_kernel_6x8(const unsigned long kc,
+                               const double *a_pt, const double *b_pt,
+                               double *c_pt, const unsigned long ldc)
+   {
+    __m256d c_reg[6][2];
+    for (unsigned i = 0; i < 6; i++)
+     {
+      c_reg[i][0] = _mm256_setzero_pd();
+      c_reg[i][1] = _mm256_setzero_pd();
+     }
+    for (unsigned long p = 0; p < kc; p++)
+     {
+      const __m256d b0 = _mm256_loadu_pd(b_pt);
+      const __m256d b1 = _mm256_loadu_pd(b_pt+4);
+      for (unsigned i = 0; i < 6; i++)
+       {
+        const __m256d a_i = _mm256_broadcast_sd(a_pt+i);
+        c_reg[i][0] = _mm256_fmadd_pd(a_i, b0, c_reg[i][0]);
+        c_reg[i][1] = _mm256_fmadd_pd(a_i, b1, c_reg[i][1]);
+       }
+      a_pt+=6;
+      b_pt+=8;
+     }
+    for (unsigned i = 0; i < 6; i++)
+     {
+      double *c_row_pt = c_pt + i*ldc;
+      _mm256_storeu_pd(c_row_pt, _mm256_add_pd(_mm256_loadu_pd(c_row_pt), c_reg[i][0]));
+      _mm256_storeu_pd(c_row_pt+4, _mm256_add_pd(_mm256_loadu_pd(c_row_pt+4), c_reg[i][1]));
+     }
+   }
+
+   // ===============================================================
+   // AVX2 micro-kernel for float, 6 x 16 tile of C in 12 registers
+   // ===============================================================
+   __attribute__((target("avx2,fma")))
+    void avx2_micro_kernel_6x16(const unsigned long kc,
+                                const float *a_pt, const float *b_pt,
+                                float *c_pt, const unsigned long ldc)
+   {
+    __m256 c_reg[6][2];
+    for (unsigned i = 0; i < 6; i++)
+     {
+      c_reg[i][0] = _mm256_setzero_ps();
+      c_reg[i][1] = _mm256_setzero_ps();
+     }
+    for (unsigned long p = 0; p < kc; p++)
+     {
+      const __m256 b0 = _mm256_loadu_ps(b_pt);
+      const __m256 b1 = _mm256_loadu_ps(b_pt+8);
+      for (unsigned i = 0; i < 6; i++)
+       {
+        const __m256 a_i = _mm256_broadcast_ss(a_pt+i);
+        c_reg[i][0] = _mm256_fmadd_ps(a_i, b0, c_reg[i][0]);
+        c_reg[i][1] = _mm256_fmadd_ps(a_i, b1, c_reg[i][1]);
+       }
+      a_pt+=6;
+      b_pt+=16;
+     }
+    for (unsigned i = 0; i < 6; i++)
+     {
+      float *c_row_pt = c_pt + i*ldc;
+      _mm256_storeu_ps(c_row_pt, _mm256_add_ps(_mm256_loadu_ps(c_row_pt), c_reg[i][0]));
+      _mm256_storeu_ps(c_row_pt+8, _mm256_add_ps(_mm256_loadu_ps(c_row_pt+8), c_reg[i][1]));
+     }
+   }
+
+   // ===============================================================
+   // AVX-512 micro-kernel for double, 12 x 16 tile of C in 24
+   // registers
+   // ===============================================================
+   __attribute__((target("avx512f")))
+    void avx512_micro_kernel_12x16(const unsigned long kc,
+                                   const double *a_pt, const double *b_pt,
+                                   double *c_pt, const unsigned long ldc)
+   {
+    __m512d c_reg[12][2];
+    for (unsigned i = 0; i < 12; i++)
+     {
+      c_reg[i][0] = _mm512_setzero_pd();
+      c_reg[i][1] = _mm512_setzero_pd();
+     }
+    for (unsigned long p = 0; p < kc; p++)
+     {
+      const __m512d b0 = _mm512_loadu_pd(b_pt);
+      const __m512d b1 = _mm512_loadu_pd(b_pt+8);
+      for (unsigned i = 0; i < 12; i++)
+       {
+        const __m512d a_i = _mm512_set1_pd(a_pt[i]);
+        c_reg[i][0] = _mm512_fmadd_pd(a_i, b0, c_reg[i][0]);
+        c_reg[i][1] = _mm512_fmadd_pd(a_i, b1, c_reg[i][1]);
+       }
+      a_pt+=12;
+      b_pt+=16;
+     }
+    for (unsigned i = 0; i < 12; i++)
+     {
+      double *c_row_pt = c_pt + i*ldc;
+      _mm512_storeu_pd(c_row_pt, _mm512_add_pd(_mm512_loadu_pd(c_row_pt), c_reg[i][0]));
+      _mm512_storeu_pd(c_row_pt+8, _mm512_add_pd(_mm512_loadu_pd(c_row_pt+8), c_reg[i][1]));
+     }
+   }
+
+   // ===============================================================
+   // AVX-512 micro-kernel for float, 12 x 32 tile of C in 24
+   // registers
+   // ===============================================================
+   __attribute__((target("avx512f")))
+    void avx512_micro_kernel_12x32(const unsigned long kc,
+                                   const float *a_pt, const float *b_pt,
+                                   float *c_pt, const unsigned long ldc)
+   {
+    __m512 c_reg[12][2];
+    for (unsigned i = 0; i < 12; i++)
+     {
+      c_reg[i][0] = _mm512_setzero_ps();
+      c_reg[i][1] = _mm512_setzero_ps();
+     }
+    for (unsigned long p = 0; p < kc; p++)
+     {
+      const __m512 b0 = _mm512_loadu_ps(b_pt);
+      const __m512 b1 = _mm512_loadu_ps(b_pt+16);
+      for (unsigned i = 0; i < 12; i++)
+       {
+        const __m512 a_i = _mm512_set1_ps(a_pt[i]);
+        c_reg[i][0] = _mm512_fmadd_ps(a_i, b0, c_reg[i][0]);
+        c_reg[i][1] = _mm512_fmadd_ps(a_i, b1, c_reg[i][1]);
+       }
+      a_pt+=12;
+      b_pt+=32;
+     }
+    for (unsigned i = 0; i < 12; i++)
+     {
+      float *c_row_pt = c_pt + i*ldc;
+      _mm512_storeu_ps(c_row_pt, _mm512_add_ps(_mm512_loadu_ps(c_row_pt), c_reg[i][0]));
+      _mm512_storeu_ps(c_row_pt+16, _mm512_add_ps(_mm512_loadu_ps(c_row_pt+16), c_reg[i][1]));
+     }
+   }
+
+#endif // #ifdef SCICELLXX_GEMM_X86_KERNELS
+
+   // ===============================================================
+   // Blocked product C = alpha * A * B (or C = C + alpha * A * B if
+   // accumulate is true) using the given micro-kernel. The loops
+   // around the micro-kernel follow the BLIS ordering (jc, pc, ic, jr,
+   // ir)
+   // ===============================================================
+   template<class T>
+    void blocked_gemm(const Blocking &blocking,
+                      void (*micro_kernel_pt)(const unsigned long,
+                                              const T *, const T *,
+                                              T *, const unsigned long),
+                      const unsigned long m, const unsigned long n,
+                      const unsigned long k, const T alpha,
+                      const T *A, const unsigned long lda,
+                      const T *B, const unsigned long ldb,
+                      T *C, const unsigned long ldc,
+                      const bool accumulate)
+    {
+     const unsigned long MR = blocking.MR;
+     const unsigned long NR = blocking.NR;
+     const unsigned long MC = blocking.MC;
+     const unsigned long KC = blocking.KC;
+     const unsigned long NC = blocking.NC;
+
+     // The micro-kernels accumulate on C, thus initialise it
+     if (!accumulate)
+      {
+       for (unsigned long i = 0; i < m; i++)
+        {
+         std::fill(C + i*ldc, C + i*ldc + n, T(0));
+        }
+      }
+
+     // Storage for the packed panels, and for the tiles of C at the
+     // boundaries of the matrix
+     std::vector<T> packed_A(MC*KC);
+     std::vector<T> packed_B(KC*std::min(NC, ((n+NR-1)/NR)*NR));
+     std::vector<T> tile(MR*NR);
+
+     for (unsigned long jc = 0; jc < n; jc+=NC)
+      {
+       const unsigned long nc = std::min(NC, n-jc);
+       for (unsigned long pc = 0; pc < k; pc+=KC)
+        {
+         const unsigned long kc = std::min(KC, k-pc);
+         pack_B(kc, nc, B + pc*ldb + jc, ldb, NR, &packed_B[0]);
+         for (unsigned long ic = 0; ic < m; ic+=MC)
+          {
+           const unsigned long mc = std::min(MC, m-ic);
+           pack_A(mc, kc, alpha, A + ic*lda + pc, lda, MR, &packed_A[0]);
+           for (unsigned long jr = 0; jr < nc; jr+=NR)
+            {
+             const unsigned long nr = std::min(NR, nc-jr);
+             const T *b_panel_pt = &packed_B[jr*kc];
+             for (unsigned long ir = 0; ir < mc; ir+=MR)
+              {
+               const unsigned long mr = std::min(MR, mc-ir);
+               const T *a_panel_pt = &packed_A[ir*kc];
+               T *c_pt = C + (ic+ir)*ldc + jc + jr;
+               if (mr == MR && nr == NR)
+                {
+                 micro_kernel_pt(kc, a_panel_pt, b_panel_pt, c_pt, ldc);
+                }
+               else
+                {
+                 // Compute the full tile in a temporary buffer and
+                 // only copy back the entries inside the matrix
+                 std::fill(tile.begin(), tile.end(), T(0));
+                 micro_kernel_pt(kc, a_panel_pt, b_panel_pt, &tile[0], NR);
+                 for (unsigned long i = 0; i < mr; i++)
+                  {
+                   for (unsigned long j = 0; j < nr; j++)
+                    {
+                     c_pt[i*ldc+j]+= tile[i*NR+j];
+                    }
+                  }
+                }
+              } // for (ir < mc)
+            } // for (jr < nc)
+          } // for (ic < m)
+        } // for (pc < k)
+      } // for (jc < n)
+
+    }
+
+   // ===============================================================
+   // Resolves the AUTO kernel type to the fastest supported kernel
+   // ===============================================================
+   Kernel_type resolve_kernel(const Kernel_type kernel_type)
+   {
+    if (kernel_type != AUTO)
+     {
+      return kernel_type;
+     }
+    if (is_kernel_supported(BLAS))
+     {
+      return BLAS;
+     }
+    if (is_kernel_supported(AVX512))
+     {
+      return AVX512;
+     }
+    if (is_kernel_supported(AVX2))
+     {
+      return AVX2;
+     }
+    return GENERIC;
+   }
+
+
+   // ===============================================================
+   // Computes C = alpha * A * B (or C = C + alpha * A * B if
+   // accumulate is true) for double precision matrices with the
+   // selected kernel
+   // ===============================================================
+   void double_gemm(const unsigned long m, const unsigned long n,
+                    const unsigned long k, const double alpha,
+                    const double *A, const unsigned long lda,
+                    const double *B, const unsigned long ldb,
+                    double *C, const unsigned long ldc,
+                    const bool accumulate)
+   {
+    if (m*n*k < Small_product_threshold)
+     {
+      unblocked_gemm_update(m, n, k, alpha, A, lda, B, ldb, C, ldc, accumulate);
+      return;
+     }
+
+    const Kernel_type kernel_type = kernel();
+    if (kernel_type == BLAS &&
+        BLASKernels::gemm(m, n, k, alpha, A, lda, B, ldb, accumulate ? 1.0 : 0.0, C, ldc))
+     {
+      return;
+     }
+#ifdef SCICELLXX_GEMM_X86_KERNELS
+    if (kernel_type == AVX512)
+     {
+      const Blocking blocking = {12, 16, 144, 256, 2048};
+      blocked_gemm<double>(blocking, avx512_micro_kernel_12x16,
+                           m, n, k, alpha, A, lda, B, ldb, C, ldc, accumulate);
+      return;
+     }
+    if (kernel_type == AVX2)
+     {
+      const Blocking blocking = {6, 8, 96, 256, 2048};
+      blocked_gemm<double>(blocking, avx2_micro_kernel_6x8,
+                           m, n, k, alpha, A, lda, B, ldb, C, ldc, accumulate);
+      return;
+     }
+#endif // #ifdef SCICELLXX_GEMM_X86_KERNELS
+    const Blocking blocking = {4, 4, 128, 256, 2048};
+    blocked_gemm<double>(blocking, generic_micro_kernel<double, 4, 4>,
+                         m, n, k, alpha, A, lda, B, ldb, C, ldc, accumulate);
+   }
+
+   // ===============================================================
+   // Computes C = alpha * A * B (or C = C + alpha * A * B if
+   // accumulate is true) for single precision matrices with the
+   // selected kernel
+   // ===============================================================
+   void float_gemm(const unsigned long m, const unsigned long n,
+                   const unsigned long k, const float alpha,
+                   const float *A, const unsigned long lda,
+                   const float *B, const unsigned long ldb,
+                   float *C, const unsigned long ldc,
+                   const bool accumulate)
+   {
+    if (m*n*k < Small_product_threshold)
+     {
+      unblocked_gemm_update(m, n, k, alpha, A, lda, B, ldb, C, ldc, accumulate);
+      return;
+     }
+
+    const Kernel_type kernel_type = kernel();
+    if (kernel_type == BLAS &&
+        BLASKernels::gemm(m, n, k, alpha, A, lda, B, ldb, accumulate ? 1.0f : 0.0f, C, ldc))
+     {
+      return;
+     }
+#ifdef SCICELLXX_GEMM_X86_KERNELS
+    if (kernel_type == AVX512)
+     {
+      const Blocking blocking = {12, 32, 144, 512, 4096};
+      blocked_gemm<float>(blocking, avx512_micro_kernel_12x32,
+                          m, n, k, alpha, A, lda, B, ldb, C, ldc, accumulate);
+      return;
+     }
+    if (kernel_type == AVX2)
+     {
+      const Blocking blocking = {6, 16, 96, 512, 4096};
+      blocked_gemm<float>(blocking, avx2_micro_kernel_6x16,
+                          m, n, k, alpha, A, lda, B, ldb, C, ldc, accumulate);
+      return;
+     }
+#endif // #ifdef SCICELLXX_GEMM_X86_KERNELS
+    const Blocking blocking = {4, 8, 128, 512, 4096};
+    blocked_gemm<float>(blocking, generic_micro_kernel<float, 4, 8>,
+                        m, n, k, alpha, A, lda, B, ldb, C, ldc, accumulate);
+   }
+
+  }
+
+  // ================================================================
+  // Set the micro-kernel used by gemm(). If the requested kernel is
+  // not supported by the CPU an error is thrown
+  // ================================================================
+  void set_kernel(const Kernel_type kernel_type)
+  {
+   if (!is_kernel_supported(kernel_type))
+    {
+     // Error message
+     std::ostringstream error_message;
+     error_message << "The requested GEMM kernel is not supported by this CPU\n"
+                   << "Requested kernel: " << kernel_name(kernel_type)
+                   << std::endl;
+     throw SciCellxxLibError(error_message.str(),
+                             SCICELLXX_CURRENT_FUNCTION,
+                             SCICELLXX_EXCEPTION_LOCATION);
+    }
+
+   Requested_kernel = kernel_type;
+   Resolved_kernel = resolve_kernel(kernel_type);
+  }
+
+  // ================================================================
+  // Returns the micro-kernel used by gemm()
+  // ================================================================
+  Kernel_type kernel()
+  {
+   Kernel_type resolved_kernel = Resolved_kernel.load();
+   if (resolved_kernel == AUTO)
+    {
+     // All the threads resolve the same kernel
+     resolved_kernel = resolve_kernel(Requested_kernel.load());
+     Resolved_kernel.store(resolved_kernel);
+    }
+   return resolved_kernel;
+  }
+
+  // ================================================================
+  // Checks whether the CPU (and the compiler) supports the given
+  // micro-kernel
+  // ================================================================
+  bool is_kernel_supported(const Kernel_type kernel_type)
+  {
+   switch (kernel_type)
+    {
+    case AUTO:
+    case GENERIC:
+     return true;
+#ifdef SCICELLXX_GEMM_X86_KERNELS
+    case AVX2:
+     return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case AVX512:
+     return __builtin_cpu_supports("avx512f");
+#endif // #ifdef SCICELLXX_GEMM_X86_KERNELS
+    case BLAS:
+     return BLASKernels::is_available();
+    default:
+     return false;
+    }
+  }
+
+  // ================================================================
+  // Returns the name of the micro-kernel
+  // ================================================================
+  std::string kernel_name(const Kernel_type kernel_type)
+  {
+   switch (kernel_type)
+    {
+    case AUTO:
+     return "auto";
+    case GENERIC:
+     return "generic";
+    case AVX2:
+     return "avx2";
+    case AVX512:
+     return "avx512";
+    case BLAS:
+     return "blas";
+    default:
+     return "unknown";
+    }
+  }
+
+  // ================================================================
+  // Computes C = A * B for double precision matrices
+  // ================================================================
+  void gemm(const unsigned long m, const unsigned long n,
+            const unsigned long k,
+            const double *A, const unsigned long lda,
+            const double *B, const unsigned long ldb,
+            double *C, const unsigned long ldc)
+  {
+   double_gemm(m, n, k, 1.0, A, lda, B, ldb, C, ldc, false);
+  }
+
+  // ================================================================
+  // Computes C = A * B for single precision matrices
+  // ================================================================
+  void gemm(const unsigned long m, const unsigned long n,
+            const unsigned long k,
+            const float *A, const unsigned long lda,
+            const float *B, const unsigned long ldb,
+            float *C, const unsigned long ldc)
+  {
+   float_gemm(m, n, k, 1.0f, A, lda, B, ldb, C, ldc, false);
+  }
+
+  // ================================================================
+  // Computes C = C + alpha * A * B for double precision matrices
+  // ================================================================
+  void gemm_update(const unsigned long m, const unsigned long n,
+                   const unsigned long k, const double alpha,
+                   const double *A, const unsigned long lda,
+                   const double *B, const unsigned long ldb,
+                   double *C, const unsigned long ldc)
+  {
+   double_gemm(m, n, k, alpha, A, lda, B, ldb, C, ldc, true);
+  }
+
+  // ================================================================
+  // Computes C = C + alpha * A * B for single precision matrices
+  // ================================================================
+  void gemm_update(const unsigned long m, const unsigned long n,
+                   const unsigned long k, const float alpha,
+                   const float *A, const unsigned long lda,
+                   const float *B, const unsigned long ldb,
+                   float *C, const unsigned long ldc)
+  {
+   float_gemm(m, n, k, alpha, A, lda, B, ldb, C, ldc, true);
+  }
+
+ }
+
+}
@@ -0,0 +1,183 @@
+// IN THIS FILE: Cache-blocked and register-blocked kernels to compute
+// the matrix-matrix product C = A * B of dense row-major matrices. The
+// kernels follow the Goto/BLIS scheme, panels of A and B are packed
+// into contiguous buffers that fit in cache and a small MR x NR
+// micro-kernel computes each tile of C. Micro-kernels using AVX2 and
+// AVX-512 instructions are provided for float and double, the one to
+// use is chosen at runtime based on the features of the CPU
+
+// Check whether the namespace has been already defined
+#ifndef GEMM_KERNELS_H
+#define GEMM_KERNELS_H
+
+#include "../general/common_includes.h"
+#include "../general/utilities.h"
+
+namespace scicellxx
+{
+
+ // ==================================================================
+ /// Kernels to compute the matrix-matrix product C = A * B. All the
+ /// matrices are stored by rows, lda, ldb and ldc are the number of
+ /// entries between two consecutive rows of A, B and C, respectively
+ // ==================================================================
+ namespace GEMMKernels
+ {
+
+  /// Enumerator with the available micro-kernels. AUTO lets the
+  /// library choose the fastest one supported by the CPU, BLAS is
+  /// only available if the library is configured with
+  /// SCICELLXX_USES_BLAS (and is the one chosen by AUTO)
+  enum Kernel_type {AUTO, GENERIC, AVX2, AVX512, BLAS};
+
+  /// Products with a number of multiply-add operations (m*n*k) below
+  /// this threshold are computed with the unblocked loop, packing
+  /// does not pay off for them
+  extern unsigned long Small_product_threshold;
+
+  /// Set the micro-kernel used by gemm(). If the requested kernel is
+  /// not supported by the CPU an error is thrown
+  void set_kernel(const Kernel_type kernel_type);
+
+  /// Returns the micro-kernel used by gemm() (AUTO is resolved to the
+  /// actual kernel)
+  Kernel_type kernel();
+
+  /// Checks whether the CPU (and the compiler) supports the given
+  /// micro-kernel
+  bool is_kernel_supported(const Kernel_type kernel_type);
+
+  /// Returns the name of the micro-kernel
+  std::string kernel_name(const Kernel_type kernel_type);
+
+  /// Computes C = A * B for double precision matrices, A is of size m
+  /// x k, B of size k x n and C of size m x n
+  void gemm(const unsigned long m, const unsigned long n,
+            const unsigned long k,
+            const double *A, const unsigned long lda,
+            const double *B, const unsigned long ldb,
+            double *C, const unsigned long ldc);
+
+  /// Computes C = A * B for single precision matrices, A is of size m
+  /// x k, B of size k x n and C of size m x n
+  void gemm(const unsigned long m, const unsigned long n,
+            const unsigned long k,
+            const float *A, const unsigned long lda,
+            const float *B, const unsigned long ldb,
+            float *C, const unsigned long ldc);
+
+  /// Computes C = C + alpha * A * B for double precision matrices, A
+  /// is of size m x k, B of size k x n and C of size m x n (the update
+  /// of the trailing submatrix of blocked factorisations)
+  void gemm_update(const unsigned long m, const unsigned long n,
+                   const unsigned long k, const double alpha,
+                   const double *A, const unsigned long lda,
+                   const double *B, const unsigned long ldb,
+                   double *C, const unsigned long ldc);
+
+  /// Computes C = C + alpha * A * B for single precision matrices, A
+  /// is of size m x k, B of size k x n and C of size m x n
+  void gemm_update(const unsigned long m, const unsigned long n,
+                   const unsigned long k, const float alpha,
+                   const float *A, const unsigned long lda,
+                   const float *B, const unsigned long ldb,
+                   float *C, const unsigned long ldc);
+
+  // ================================================================
+  /// Unblocked product C = A * B. The loops are ordered (i, k, j) so
+  /// that B and C are traversed by rows. Used for small products and
+  /// for types without a specialised kernel
+  // ================================================================
+  template<class T>
+   void unblocked_gemm(const unsigned long m, const unsigned long n,
+                       const unsigned long k,
+                       const T *A, const unsigned long lda,
+                       const T *B, const unsigned long ldb,
+                       T *C, const unsigned long ldc)
+   {
+    for (unsigned long i = 0; i < m; i++)
+     {
+      T *c_row_pt = C + i*ldc;
+      for (unsigned long j = 0; j < n; j++)
+       {
+        c_row_pt[j] = 0;
+       }
+      const T *a_row_pt = A + i*lda;
+      for (unsigned long p = 0; p < k; p++)
+       {
+        const T a_ip = a_row_pt[p];
+        const T *b_row_pt = B + p*ldb;
+        for (unsigned long j = 0; j < n; j++)
+         {
+          c_row_pt[j]+= a_ip * b_row_pt[j];
+         }
+       }
+     }
+   }
+
+  // ================================================================
+  /// Unblocked product C = alpha * A * B, or C = C + alpha * A * B if
+  /// accumulate is true
+  // ================================================================
+  template<class T>
+   void unblocked_gemm_update(const unsigned long m, const unsigned long n,
+                              const unsigned long k, const T alpha,
+                              const T *A, const unsigned long lda,
+                              const T *B, const unsigned long ldb,
+                              T *C, const unsigned long ldc,
+                              const bool accumulate = true)
+   {
+    for (unsigned long i = 0; i < m; i++)
+     {
+      T *c_row_pt = C + i*ldc;
+      if (!accumulate)
+       {
+        for (unsigned long j = 0; j < n; j++)
+         {
+          c_row_pt[j] = 0;
+         }
+       }
+      const T *a_row_pt = A + i*lda;
+      for (unsigned long p = 0; p < k; p++)
+       {
+        const T a_ip = alpha * a_row_pt[p];
+        const T *b_row_pt = B + p*ldb;
+        for (unsigned long j = 0; j < n; j++)
+         {
+          c_row_pt[j]+= a_ip * b_row_pt[j];
+         }
+       }
+     }
+   }
+
+  // ================================================================
+  /// Product C = A * B for types without a specialised kernel
+  // ================================================================
+  template<class T>
+   void gemm(const unsigned long m, const unsigned long n,
+             const unsigned long k,
+             const T *A, const unsigned long lda,
+             const T *B, const unsigned long ldb,
+             T *C, const unsigned long ldc)
+   {
+    unblocked_gemm(m, n, k, A, lda, B, ldb, C, ldc);
+   }
+
+  // ================================================================
+  /// C = C + alpha * A * B for types without a specialised kernel
+  // ================================================================
+  template<class T>
+   void gemm_update(const unsigned long m, const unsigned long n,
+                    const unsigned long k, const T alpha,
+                    const T *A, const unsigned long lda,
+                    const T *B, const unsigned long ldb,
+                    T *C, const unsigned long ldc)
+   {
+    unblocked_gemm_update(m, n, k, alpha, A, lda, B, ldb, C, ldc);
+   }
+
+ }
+
+}
+
+#endif // #ifndef GEMM_KERNELS_H
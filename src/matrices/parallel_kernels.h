@@ -0,0 +1,285 @@
+// IN THIS FILE: Kernels on the entries of dense vectors and matrices
+// executed in the pool of threads of the library (element-wise
+// operations, reductions and matrix times vector). The kernels are
+// executed by the calling thread for small sizes (see
+// ThreadPool::serial_threshold()). The reductions are deterministic,
+// their result does not depend on the number of threads, and they are
+// accumulated in the type given by AccumulatorTraits (double for
+// float entries). Each block of a reduction is computed by the
+// vectorised kernels of ReductionKernels with the summation method
+// chosen at runtime. When the library is configured with
+// SCICELLXX_USES_BLAS the dot product, the norm 2 and matrix times
+// vector are computed by BLAS (the reductions only with the default
+// summation method, matrix times vector only when the entries are
+// accumulated in their own type)
+
+// Check whether the namespace has been already defined
+#ifndef PARALLEL_KERNELS_H
+#define PARALLEL_KERNELS_H
+
+#include "../general/common_includes.h"
+#include "../general/utilities.h"
+#include "../general/thread_pool.h"
+// The interface to an optimised BLAS library
+#include "blas_kernels.h"
+// The type used to accumulate the reductions
+#include "accumulator_traits.h"
+// The kernels for the reduction of each block
+#include "reduction_kernels.h"
+
+namespace scicellxx
+{
+
+ // ==================================================================
+ /// Parallel kernels on raw arrays of entries
+ // ==================================================================
+ namespace ParallelKernels
+ {
+
+  // ================================================================
+  /// z[i] = op(x[i], y[i]) for i in [0, n)
+  // ================================================================
+  template<class T, class OP>
+   inline void element_wise(const unsigned long n, const T *x, const T *y,
+                            T *z, const OP &op)
+   {
+    ThreadPool::parallel_for(n, [=, &op](const unsigned long begin, const unsigned long end)
+                             {
+                              for (unsigned long i = begin; i < end; i++)
+                               {
+                                z[i] = op(x[i], y[i]);
+                               }
+                             });
+   }
+
+  // ================================================================
+  /// z = x + y
+  // ================================================================
+  template<class T>
+   inline void add(const unsigned long n, const T *x, const T *y, T *z)
+   {
+    element_wise(n, x, y, z, [](const T a, const T b) {return a + b;});
+   }
+
+  // ================================================================
+  /// z = x - y
+  // ================================================================
+  template<class T>
+   inline void substract(const unsigned long n, const T *x, const T *y, T *z)
+   {
+    element_wise(n, x, y, z, [](const T a, const T b) {return a - b;});
+   }
+
+  // ================================================================
+  /// z = x .* y (element by element)
+  // ================================================================
+  template<class T>
+   inline void multiply_element_by_element(const unsigned long n, const T *x,
+                                           const T *y, T *z)
+   {
+    element_wise(n, x, y, z, [](const T a, const T b) {return a * b;});
+   }
+
+  // ================================================================
+  /// Returns sum(x[i] * y[i]) for i in [0, n) computed by the calling
+  /// thread and accumulated in the type A, with the summation method
+  /// of ReductionKernels
+  // ================================================================
+  template<class T, class A>
+   inline A serial_dot(const unsigned long n, const T *x, const T *y)
+   {
+    return ReductionKernels::sum<A>(0, n, [=](const unsigned long i)
+                                    {return A(x[i]) * A(y[i]);});
+   }
+
+  // ================================================================
+  /// Returns sum(x[i] * y[i]), accumulated in the type A (double for
+  /// float entries, see AccumulatorTraits). BLAS is only used with the
+  /// default summation method
+  // ================================================================
+  template<class T, class A = typename AccumulatorTraits<T>::Accumulator_type>
+   inline A dot(const unsigned long n, const T *x, const T *y)
+   {
+    A result = 0.0;
+    if (ReductionKernels::summation_method() == ReductionKernels::ACCUMULATORS &&
+        BLASKernels::dot(n, x, 1, y, 1, result))
+     {
+      return result;
+     }
+    return ThreadPool::parallel_reduce(n, A(0.0),
+                                       [=](const unsigned long begin, const unsigned long end)
+                                       {
+                                        return serial_dot<T, A>(end - begin, x + begin, y + begin);
+                                       },
+                                       [](const A a, const A b) {return a + b;});
+   }
+
+  // ================================================================
+  /// Returns sum(|x[i*stride]|) for i in [0, n), accumulated in the
+  /// type A
+  // ================================================================
+  template<class T, class A = typename AccumulatorTraits<T>::Accumulator_type>
+   inline A sum_of_absolute_values(const unsigned long n, const T *x,
+                                   const unsigned long stride = 1)
+   {
+    return ThreadPool::parallel_reduce(n, A(0.0),
+                                       [=](const unsigned long begin, const unsigned long end)
+                                       {
+                                        return ReductionKernels::sum<A>(begin, end, [=](const unsigned long i)
+                                                                        {return std::fabs(A(x[i*stride]));});
+                                       },
+                                       [](const A a, const A b) {return a + b;});
+   }
+
+  // ================================================================
+  /// Returns sum(x[i] * x[i]), accumulated in the type A
+  // ================================================================
+  template<class T, class A = typename AccumulatorTraits<T>::Accumulator_type>
+   inline A sum_of_squares(const unsigned long n, const T *x)
+   {
+    return dot<T, A>(n, x, x);
+   }
+
+  // ================================================================
+  /// Returns max(|x[i*stride]|) for i in [0, n), zero if n is zero
+  // ================================================================
+  template<class T>
+   inline T max_absolute_value(const unsigned long n, const T *x,
+                               const unsigned long stride = 1)
+   {
+    return ThreadPool::parallel_reduce(n, T(0.0),
+                                       [=](const unsigned long begin, const unsigned long end)
+                                       {
+                                        return ReductionKernels::maximum(begin, end, T(0.0), [=](const unsigned long i)
+                                                                         {return T(std::fabs(x[i*stride]));});
+                                       },
+                                       [](const T a, const T b) {return a > b ? a : b;});
+   }
+
+  // ================================================================
+  /// Returns sum((x[i*stride] / scaling)^2) for i in [0, n),
+  /// accumulated in the type A
+  // ================================================================
+  template<class T, class A>
+   inline A sum_of_squares(const unsigned long n, const T *x,
+                           const unsigned long stride, const A scaling)
+   {
+    return ThreadPool::parallel_reduce(n, A(0.0),
+                                       [=](const unsigned long begin, const unsigned long end)
+                                       {
+                                        if (scaling == A(1.0))
+                                         {
+                                          return ReductionKernels::sum<A>(begin, end, [=](const unsigned long i)
+                                                                          {return A(x[i*stride]) * A(x[i*stride]);});
+                                         }
+                                        return ReductionKernels::sum<A>(begin, end, [=](const unsigned long i)
+                                                                        {
+                                                                         const A scaled = A(x[i*stride]) / scaling;
+                                                                         return scaled * scaled;
+                                                                        });
+                                       },
+                                       [](const A a, const A b) {return a + b;});
+   }
+  
+  // ================================================================
+  /// Returns sqrt(sum(x[i*stride] * x[i*stride])) for i in [0, n),
+  /// accumulated in the type A. As the nrm2 routine of LAPACK the
+  /// result does not overflow nor underflow unless the norm itself
+  /// does. The squares are added directly in a single pass, only when
+  /// the sum overflows, underflows or is zero the entries are scaled
+  /// by their maximum absolute value and added again
+  // ================================================================
+  template<class T, class A = typename AccumulatorTraits<T>::Accumulator_type>
+   inline A norm_2(const unsigned long n, const T *x,
+                   const unsigned long stride = 1)
+   {
+    A result = 0.0;
+    if (ReductionKernels::summation_method() == ReductionKernels::ACCUMULATORS &&
+        BLASKernels::nrm2(n, x, stride, result))
+     {
+      return result;
+     }
+    
+    // The sum is accurate when it is finite and large enough for the
+    // squares of the relevant entries not to underflow (an overflow
+    // gives a NaN sum with the KAHAN method)
+    const A sum = sum_of_squares(n, x, stride, A(1.0));
+    const A small = ReductionKernels::small_for_norm_2<A>();
+    if (sum >= small * small && sum <= std::numeric_limits<A>::max())
+     {
+      return std::sqrt(sum);
+     }
+    
+    // Scale the entries by their maximum absolute value. All zero,
+    // infinity or NaN entries are not scaled such that the NaN are
+    // propagated
+    const A maximum = A(max_absolute_value(n, x, stride));
+    if (!(maximum > 0.0 && maximum <= std::numeric_limits<A>::max()))
+     {
+      return std::sqrt(sum);
+     }
+    return maximum * std::sqrt(sum_of_squares(n, x, stride, maximum));
+   }
+
+  // ================================================================
+  /// Returns max(x[i*stride]) for i in [0, n), n must be larger than
+  /// zero
+  // ================================================================
+  template<class T>
+   inline T maximum(const unsigned long n, const T *x,
+                    const unsigned long stride = 1)
+   {
+    return ThreadPool::parallel_reduce(n, x[0],
+                                       [=](const unsigned long begin, const unsigned long end)
+                                       {
+                                        return ReductionKernels::maximum(begin, end, x[begin*stride], [=](const unsigned long i)
+                                                                         {return x[i*stride];});
+                                       },
+                                       [](const T a, const T b) {return a > b ? a : b;});
+   }
+
+  // ================================================================
+  /// Returns min(x[i*stride]) for i in [0, n), n must be larger than
+  /// zero
+  // ================================================================
+  template<class T>
+   inline T minimum(const unsigned long n, const T *x,
+                    const unsigned long stride = 1)
+   {
+    return ThreadPool::parallel_reduce(n, x[0],
+                                       [=](const unsigned long begin, const unsigned long end)
+                                       {
+                                        return ReductionKernels::minimum(begin, end, x[begin*stride], [=](const unsigned long i)
+                                                                         {return x[i*stride];});
+                                       },
+                                       [](const T a, const T b) {return a < b ? a : b;});
+   }
+
+  // ================================================================
+  /// y = A * x, with A an m X n row major matrix. The rows of y are
+  /// computed in parallel, each of them by the same thread, thus the
+  /// result does not depend on the number of threads. Each entry of y
+  /// is accumulated in the type ACC (double for float entries)
+  // ================================================================
+  template<class T, class ACC = typename AccumulatorTraits<T>::Accumulator_type>
+   inline void matrix_times_vector(const unsigned long m, const unsigned long n,
+                                   const T *A, const T *x, T *y)
+   {
+    if (std::is_same<T, ACC>::value && BLASKernels::gemv(m, n, A, n, x, 1, y, 1))
+     {
+      return;
+     }
+    ThreadPool::parallel_for(m, [=](const unsigned long begin, const unsigned long end)
+                             {
+                              for (unsigned long i = begin; i < end; i++)
+                               {
+                                y[i] = T(serial_dot<T, ACC>(n, A + i*n, x));
+                               }
+                             }, n);
+   }
+
+ }
+
+}
+
+#endif // #ifndef PARALLEL_KERNELS_H
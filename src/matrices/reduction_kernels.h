@@ -0,0 +1,313 @@
+// IN THIS FILE: Kernels for the reductions of a block of entries
+// (sums, maximum and minimum) used by the dot products and norms of
+// vectors and matrices. The sums are accumulated in Number_of_lanes
+// independent partial sums, the loop over the lanes has no dependency
+// between iterations and the compiler maps it to SIMD registers. The
+// lanes are joined by a fixed tree, the result does not depend on the
+// instruction set.
+//
+// The summation method is chosen at runtime (see
+// set_summation_method()):
+//
+// - ACCUMULATORS: the partial sums in the lanes (the default), the
+//   error grows as O(n / Number_of_lanes * eps)
+//
+// - KAHAN: compensated summation in each lane (the Neumaier variant
+//   of Kahan's method), the error is O(eps) independent of n, at two
+//   to four times the cost
+//
+// - PAIRWISE: the block is split in halves recursively down to
+//   Pairwise_base_size entries summed in the lanes, the error grows as
+//   O(log(n) * eps), cheaper than KAHAN
+//
+// The norm 2 does not overflow nor underflow as in the nrm2 routine of
+// LAPACK, the entries are scaled by the maximum absolute value when
+// the sum of their squares overflows or underflows
+
+// Check whether the namespace has been already defined
+#ifndef REDUCTION_KERNELS_H
+#define REDUCTION_KERNELS_H
+
+#include "../general/common_includes.h"
+#include "../general/utilities.h"
+
+#include <limits>
+
+namespace scicellxx
+{
+
+ // ==================================================================
+ /// Kernels for the reductions of the entries in the range [begin,
+ /// end). The entries are given by a term(i) functor
+ // ==================================================================
+ namespace ReductionKernels
+ {
+
+  /// Enumerator with the available summation methods
+  enum Summation_method {ACCUMULATORS, KAHAN, PAIRWISE};
+
+  /// The number of independent partial results (eight doubles fill an
+  /// AVX-512 register, two AVX2 registers or four SSE2 registers)
+  const unsigned Number_of_lanes = 8;
+
+  /// Blocks with at most this number of entries are not split by the
+  /// PAIRWISE method
+  const unsigned long Pairwise_base_size = 256;
+
+  // ================================================================
+  /// The summation method used by the dot products and norms (the
+  /// kernels are header-only, the setting lives in this function such
+  /// that any library that instantiates them shares it)
+  // ================================================================
+  inline Summation_method &current_summation_method()
+  {
+   static Summation_method summation_method = ACCUMULATORS;
+   return summation_method;
+  }
+
+  // ================================================================
+  /// Set the summation method used by the dot products and norms
+  // ================================================================
+  inline void set_summation_method(const Summation_method summation_method)
+  {
+   current_summation_method() = summation_method;
+  }
+
+  // ================================================================
+  /// Returns the summation method used by the dot products and norms
+  // ================================================================
+  inline Summation_method summation_method()
+  {
+   return current_summation_method();
+  }
+
+  // ================================================================
+  /// Returns the name of the summation method
+  // ================================================================
+  inline std::string summation_method_name(const Summation_method summation_method)
+  {
+   if (summation_method == KAHAN)
+    {
+     return std::string("kahan");
+    }
+   else if (summation_method == PAIRWISE)
+    {
+     return std::string("pairwise");
+    }
+   return std::string("accumulators");
+  }
+
+  // ================================================================
+  /// Returns sum(term(i)) for i in [begin, end) accumulated in the
+  /// lanes
+  // ================================================================
+  template<class A, class TERM>
+   inline A sum_by_accumulators(const unsigned long begin, const unsigned long end,
+                                const TERM &term)
+   {
+    A lane[Number_of_lanes];
+    for (unsigned j = 0; j < Number_of_lanes; j++)
+     {
+      lane[j] = 0.0;
+     }
+    unsigned long i = begin;
+    for (; i + Number_of_lanes <= end; i+=Number_of_lanes)
+     {
+      for (unsigned j = 0; j < Number_of_lanes; j++)
+       {
+        lane[j]+= term(i + j);
+       }
+     }
+    for (unsigned j = 0; i < end; i++, j++)
+     {
+      lane[j]+= term(i);
+     }
+    return ((lane[0] + lane[1]) + (lane[2] + lane[3])) +
+     ((lane[4] + lane[5]) + (lane[6] + lane[7]));
+   }
+
+  // ================================================================
+  /// Adds value to sum and accumulates the rounding error in
+  /// compensation (the Neumaier variant of Kahan's summation, correct
+  /// also when value is larger than sum). The selections are compiled
+  /// to blends, the loops over the lanes are still vectorised
+  // ================================================================
+  template<class A>
+   inline void compensated_add(A &sum, A &compensation, const A value)
+   {
+    const A t = sum + value;
+    const bool sum_is_larger = std::fabs(sum) >= std::fabs(value);
+    const A larger = sum_is_larger ? sum : value;
+    const A smaller = sum_is_larger ? value : sum;
+    compensation+= (larger - t) + smaller;
+    sum = t;
+   }
+
+  // ================================================================
+  /// Returns sum(term(i)) for i in [begin, end) with compensated
+  /// summation in each lane, the lanes are joined with compensated
+  /// summation too
+  // ================================================================
+  template<class A, class TERM>
+   inline A sum_by_kahan(const unsigned long begin, const unsigned long end,
+                         const TERM &term)
+   {
+    A lane[Number_of_lanes];
+    A compensation[Number_of_lanes];
+    for (unsigned j = 0; j < Number_of_lanes; j++)
+     {
+      lane[j] = 0.0;
+      compensation[j] = 0.0;
+     }
+    unsigned long i = begin;
+    for (; i + Number_of_lanes <= end; i+=Number_of_lanes)
+     {
+      for (unsigned j = 0; j < Number_of_lanes; j++)
+       {
+        compensated_add(lane[j], compensation[j], A(term(i + j)));
+       }
+     }
+    for (unsigned j = 0; i < end; i++, j++)
+     {
+      compensated_add(lane[j], compensation[j], A(term(i)));
+     }
+
+    // Join the lanes, the compensations are small with respect to the
+    // lanes and are added once the lanes have cancelled each other
+    A sum = 0.0;
+    A sum_compensation = 0.0;
+    for (unsigned j = 0; j < Number_of_lanes; j++)
+     {
+      compensated_add(sum, sum_compensation, lane[j]);
+     }
+    for (unsigned j = 0; j < Number_of_lanes; j++)
+     {
+      sum_compensation+= compensation[j];
+     }
+    return sum + sum_compensation;
+   }
+
+  // ================================================================
+  /// Returns sum(term(i)) for i in [begin, end) by pairwise summation
+  // ================================================================
+  template<class A, class TERM>
+   inline A sum_by_pairwise(const unsigned long begin, const unsigned long end,
+                            const TERM &term)
+   {
+    const unsigned long n = end - begin;
+    if (n <= Pairwise_base_size)
+     {
+      return sum_by_accumulators<A>(begin, end, term);
+     }
+    // Split at a multiple of the number of lanes
+    const unsigned long half = (n / 2 + Number_of_lanes - 1) / Number_of_lanes * Number_of_lanes;
+    return sum_by_pairwise<A>(begin, begin + half, term) +
+     sum_by_pairwise<A>(begin + half, end, term);
+   }
+
+  // ================================================================
+  /// Returns sum(term(i)) for i in [begin, end) with the summation
+  /// method set by set_summation_method()
+  // ================================================================
+  template<class A, class TERM>
+   inline A sum(const unsigned long begin, const unsigned long end,
+                const TERM &term)
+   {
+    switch (summation_method())
+     {
+     case KAHAN:
+      return sum_by_kahan<A>(begin, end, term);
+     case PAIRWISE:
+      return sum_by_pairwise<A>(begin, end, term);
+     default:
+      return sum_by_accumulators<A>(begin, end, term);
+     }
+   }
+
+  // ================================================================
+  /// Returns max(term(i)) for i in [begin, end), initial_value if the
+  /// range is empty
+  // ================================================================
+  template<class T, class TERM>
+   inline T maximum(const unsigned long begin, const unsigned long end,
+                    const T initial_value, const TERM &term)
+   {
+    T lane[Number_of_lanes];
+    for (unsigned j = 0; j < Number_of_lanes; j++)
+     {
+      lane[j] = initial_value;
+     }
+    unsigned long i = begin;
+    for (; i + Number_of_lanes <= end; i+=Number_of_lanes)
+     {
+      for (unsigned j = 0; j < Number_of_lanes; j++)
+       {
+        const T value = term(i + j);
+        lane[j] = value > lane[j] ? value : lane[j];
+       }
+     }
+    for (unsigned j = 0; i < end; i++, j++)
+     {
+      const T value = term(i);
+      lane[j] = value > lane[j] ? value : lane[j];
+     }
+    T result = lane[0];
+    for (unsigned j = 1; j < Number_of_lanes; j++)
+     {
+      result = lane[j] > result ? lane[j] : result;
+     }
+    return result;
+   }
+
+  // ================================================================
+  /// Returns min(term(i)) for i in [begin, end), initial_value if the
+  /// range is empty
+  // ================================================================
+  template<class T, class TERM>
+   inline T minimum(const unsigned long begin, const unsigned long end,
+                    const T initial_value, const TERM &term)
+   {
+    T lane[Number_of_lanes];
+    for (unsigned j = 0; j < Number_of_lanes; j++)
+     {
+      lane[j] = initial_value;
+     }
+    unsigned long i = begin;
+    for (; i + Number_of_lanes <= end; i+=Number_of_lanes)
+     {
+      for (unsigned j = 0; j < Number_of_lanes; j++)
+       {
+        const T value = term(i + j);
+        lane[j] = value < lane[j] ? value : lane[j];
+       }
+     }
+    for (unsigned j = 0; i < end; i++, j++)
+     {
+      const T value = term(i);
+      lane[j] = value < lane[j] ? value : lane[j];
+     }
+    T result = lane[0];
+    for (unsigned j = 1; j < Number_of_lanes; j++)
+     {
+      result = lane[j] < result ? lane[j] : result;
+     }
+    return result;
+   }
+
+  // ================================================================
+  /// A sum of squares of entries of type A that is at least the
+  /// square of small_for_norm_2() is accurate, the squares of the
+  /// entries that are relevant for the sum (larger than the maximum
+  /// times sqrt(eps)) do not underflow
+  // ================================================================
+  template<class A>
+   inline A small_for_norm_2()
+   {
+    return std::sqrt(std::numeric_limits<A>::min() / std::numeric_limits<A>::epsilon());
+   }
+
+ }
+
+}
+
+#endif // #ifndef REDUCTION_KERNELS_H
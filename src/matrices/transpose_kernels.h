@@ -0,0 +1,156 @@
+// IN THIS FILE: Kernels to transpose dense row-major matrices. The
+// out-of-place transpose is cache-oblivious, the matrix is split
+// recursively by its largest dimension until the blocks fit in cache
+// (both the rows read and the columns written are short). The
+// in-place transpose of square matrices swaps pairs of tiles, the one
+// of rectangular matrices follows the cycles of the permutation of
+// the entries and only requires one bit of extra memory per entry
+
+// Check whether the namespace has been already defined
+#ifndef TRANSPOSE_KERNELS_H
+#define TRANSPOSE_KERNELS_H
+
+#include "../general/common_includes.h"
+#include "../general/utilities.h"
+
+namespace scicellxx
+{
+
+ // ==================================================================
+ /// Kernels to transpose matrices stored by rows, lda and ldb are the
+ /// number of entries between two consecutive rows of A and B,
+ /// respectively
+ // ==================================================================
+ namespace TransposeKernels
+ {
+
+  /// Blocks with both dimensions smaller or equal than this are
+  /// transposed with a simple loop (a block of doubles and its
+  /// transpose fit in the L1 cache)
+  const unsigned long Block_size = 32;
+
+  // ================================================================
+  /// Computes B = A^T, A is of size m x n and B of size n x m. A and
+  /// B must not overlap
+  // ================================================================
+  template<class T>
+   void transpose(const unsigned long m, const unsigned long n,
+                  const T *A, const unsigned long lda,
+                  T *B, const unsigned long ldb)
+   {
+    if (m <= Block_size && n <= Block_size)
+     {
+      for (unsigned long i = 0; i < m; i++)
+       {
+        for (unsigned long j = 0; j < n; j++)
+         {
+          B[j*ldb + i] = A[i*lda + j];
+         }
+       }
+     }
+    else if (m >= n)
+     {
+      // Split the rows of A (the columns of B)
+      const unsigned long m_half = m / 2;
+      transpose(m_half, n, A, lda, B, ldb);
+      transpose(m - m_half, n, A + m_half*lda, lda, B + m_half, ldb);
+     }
+    else
+     {
+      // Split the columns of A (the rows of B)
+      const unsigned long n_half = n / 2;
+      transpose(m, n_half, A, lda, B, ldb);
+      transpose(m, n - n_half, A + n_half, lda, B + n_half*ldb, ldb);
+     }
+   }
+
+  // ================================================================
+  /// Transposes the n x n matrix A in place. The diagonal tiles are
+  /// transposed in place, the tiles above the diagonal are transposed
+  /// and swapped with the ones below it
+  // ================================================================
+  template<class T>
+   void transpose_square_in_place(const unsigned long n, T *A,
+                                  const unsigned long lda)
+   {
+    for (unsigned long ii = 0; ii < n; ii+= Block_size)
+     {
+      const unsigned long i_end = std::min(ii + Block_size, n);
+
+      // The diagonal tile
+      for (unsigned long i = ii; i < i_end; i++)
+       {
+        for (unsigned long j = i + 1; j < i_end; j++)
+         {
+          std::swap(A[i*lda + j], A[j*lda + i]);
+         }
+       }
+
+      // Swap the tiles (ii, jj) and (jj, ii)
+      for (unsigned long jj = i_end; jj < n; jj+= Block_size)
+       {
+        const unsigned long j_end = std::min(jj + Block_size, n);
+        for (unsigned long i = ii; i < i_end; i++)
+         {
+          for (unsigned long j = jj; j < j_end; j++)
+           {
+            std::swap(A[i*lda + j], A[j*lda + i]);
+           }
+         }
+       }
+     }
+   }
+
+  // ================================================================
+  /// Transposes the m x n matrix A in place, A is stored in m*n
+  /// consecutive entries and becomes an n x m matrix. The entry at
+  /// position k = i*n + j moves to j*m + i = k*m mod (m*n - 1), the
+  /// cycles of this permutation are followed once each
+  // ================================================================
+  template<class T>
+   void transpose_in_place(const unsigned long m, const unsigned long n,
+                           T *A)
+   {
+    if (m == n)
+     {
+      transpose_square_in_place(n, A, n);
+      return;
+     }
+
+    const unsigned long n_entries = m * n;
+    if (m < 2 || n < 2)
+     {
+      // A vector, the entries do not move
+      return;
+     }
+
+    // Mark the entries already placed (the first and the last ones
+    // never move)
+    const unsigned long last = n_entries - 1;
+    std::vector<bool> moved(n_entries, false);
+    for (unsigned long start = 1; start < last; start++)
+     {
+      if (moved[start])
+       {
+        continue;
+       }
+      // Follow the cycle starting at start, the entry at k goes to
+      // next(k)
+      T value = A[start];
+      unsigned long k = start;
+      do
+       {
+        const unsigned long next = static_cast<unsigned long>
+         ((static_cast<unsigned long long>(k) * m) % last);
+        std::swap(A[next], value);
+        moved[next] = true;
+        k = next;
+       } while (k != start);
+     }
+   }
+
+ }
+
+}
+
+#endif // #ifndef TRANSPOSE_KERNELS_H
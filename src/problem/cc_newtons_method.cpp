@@ -19,10 +19,17 @@ namespace scicellxx
     Linear_solver_has_been_set(false),
     Free_memory_for_linear_solver(false),
     Reuse_jacobian(false),
+    Maximum_jacobian_age(DEFAULT_MAXIMUM_JACOBIAN_AGE),
+    Maximum_convergence_rate_for_jacobian_reuse(DEFAULT_MAXIMUM_CONVERGENCE_RATE_FOR_JACOBIAN_REUSE),
     Jacobian_and_residual_strategy_pt(NULL),
     Linear_solver_pt(NULL),
     X_pt(NULL),
-    Output_messages(true)
+    Output_messages(true),
+    Jacobian_is_stale(true),
+    Jacobian_age(0),
+    N_jacobian_computations(0),
+    N_factorisations(0),
+    N_newton_iterations(0)
  {
   // Performs default configuration
   set_default_configuration(); 
@@ -48,6 +55,9 @@ namespace scicellxx
   // Indicate that the Jacobian and residual computation strategy has
   // been set
   Jacobian_and_residual_strategy_has_been_set = true;
+  
+  // The Jacobian of the new strategy has not been computed
+  mark_jacobian_as_stale();
  }
  
  // ===================================================================
@@ -67,6 +77,52 @@ namespace scicellxx
   // An external new linear solver has been set, then we no longer
   // need to worry about freeing its allocated memory
   Free_memory_for_linear_solver = false;
+  
+  // The new linear solver has not factorised the Jacobian
+  mark_jacobian_as_stale();
+ }
+ 
+ // ===================================================================
+ /// Set the maximum number of calls to solve() that use the same
+ /// Jacobian, 1 only reuses the Jacobian within a call to solve()
+ // ===================================================================
+ void CCNewtonsMethod::set_maximum_jacobian_age(const unsigned new_maximum_jacobian_age)
+ {
+  if (new_maximum_jacobian_age == 0)
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The maximum age of the Jacobian must be at least one\n"
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                           SCICELLXX_CURRENT_FUNCTION,
+                           SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  Maximum_jacobian_age = new_maximum_jacobian_age;
+ }
+ 
+ // ===================================================================
+ /// Set the maximum ratio of the norms of the residuals of two
+ /// consecutive iterations, the Jacobian is recomputed when it is
+ /// larger
+ // ===================================================================
+ void CCNewtonsMethod::set_maximum_convergence_rate_for_jacobian_reuse(const Real new_maximum_convergence_rate)
+ {
+  if (!(new_maximum_convergence_rate > 0.0 && new_maximum_convergence_rate < 1.0))
+   {
+    // Error message
+    std::ostringstream error_message;
+    error_message << "The maximum convergence rate for the reuse of the\n"
+                  << "Jacobian must be in (0, 1)\n"
+                  << "Maximum convergence rate: " << new_maximum_convergence_rate
+                  << std::endl;
+    throw SciCellxxLibError(error_message.str(),
+                           SCICELLXX_CURRENT_FUNCTION,
+                           SCICELLXX_EXCEPTION_LOCATION);
+   }
+  
+  Maximum_convergence_rate_for_jacobian_reuse = new_maximum_convergence_rate;
  }
  
  // ===================================================================
@@ -191,6 +247,9 @@ namespace scicellxx
   // In charge of free the memory for linear solver
   Free_memory_for_linear_solver = true;
   
+  // The new linear solver has not factorised the Jacobian
+  mark_jacobian_as_stale();
+  
  }
  
  // ===================================================================
@@ -248,9 +307,6 @@ namespace scicellxx
                            SCICELLXX_EXCEPTION_LOCATION);
    }
   
-  // Create an instance of a factory for matrices and vectors
-  CCFactoryMatrices<Real> factory_matrices_and_vectors;
-  
   // ----------------------------------------------------------------
   // Initial residual convergence check
   // ----------------------------------------------------------------
@@ -286,8 +342,19 @@ namespace scicellxx
     
    }
   
-  // Flag to indicate that the Jacobian has been computed by the first
-  // time in Newton's method
+  // The Jacobian is stale when it has been used by the maximum
+  // number of calls to solve()
+  if (!Reuse_jacobian || Jacobian_age >= Maximum_jacobian_age)
+   {
+    Jacobian_is_stale = true;
+   }
+  else if (!Jacobian_is_stale)
+   {
+    Jacobian_age++;
+   }
+  
+  // Flag to indicate that the Jacobian has been computed in this call
+  // to Newton's method
   bool jacobian_has_been_computed = false;
   
   // Keep count on the number of newton iterations
@@ -308,10 +375,21 @@ namespace scicellxx
   // Get the number of variables
   const unsigned n_dof = X_pt->n_values();
   
-  // Create the vector to store the solution of the system of
-  // equations during Newton's steps
-  ACVector<Real> *dx_pt = factory_matrices_and_vectors.create_vector();
-  dx_pt->allocate_memory(n_dof);
+  // Take the vector to store the solution of the system of equations
+  // during Newton's steps from the pool, it is given back when
+  // leaving this method (also when an error is thrown)
+  CCFactoryMatrices<Real>::Pooled_vector dx = Factory_matrices_and_vectors.acquire_vector(n_dof);
+  ACVector<Real> *dx_pt = dx.pt();
+  
+  // Keep a copy of the initial guess to restart the iterations when
+  // they fail with a reused Jacobian (also from the pool, only taken
+  // when the Jacobian is reused)
+  CCFactoryMatrices<Real>::Pooled_vector x_initial_guess;
+  if (Reuse_jacobian)
+   {
+    x_initial_guess = Factory_matrices_and_vectors.acquire_vector(n_dof);
+    x_initial_guess.pt()->copy(*X_pt);
+   }
   
   // Time Newton's method
   clock_t initial_clock_time_for_newtons_method = Timing::cpu_clock_time();
@@ -321,6 +399,7 @@ namespace scicellxx
    {
     // Increase the numbew of Newton iterations
     n_newton_iterations++;
+    N_newton_iterations++;
     
     // Perform actions before Newton's step
     actions_before_newton_step();
@@ -332,19 +411,16 @@ namespace scicellxx
     // Time the computation of the Jacobian matrix
     clock_t initial_clock_time_for_jacobian = Timing::cpu_clock_time();
     
-    if (!jacobian_has_been_computed)
+    if (!Reuse_jacobian || Jacobian_is_stale)
      {
-      // Compute the Jacobian
+      // Compute the Jacobian, its new version is factorised by the
+      // linear solver
       Jacobian_and_residual_strategy_pt->compute_jacobian();
+      Jacobian_and_residual_strategy_pt->increase_jacobian_version();
+      N_jacobian_computations++;
       jacobian_has_been_computed = true;
-     }
-    else
-     {
-      if (!Reuse_jacobian)
-       {
-        // Compute the Jacobian
-        Jacobian_and_residual_strategy_pt->compute_jacobian();
-       }
+      Jacobian_is_stale = false;
+      Jacobian_age = 1;
      }
      
     // Time the computation of the Jacobian matrix
@@ -371,8 +447,16 @@ namespace scicellxx
     // Time the linear solver
     clock_t initial_clock_time_for_linear_solver = Timing::cpu_clock_time();
     
-    // Solve the system of equations
-    Linear_solver_pt->solve(Jacobian_pt, residual_pt, dx_pt);
+    // Solve the system of equations, the Jacobian is only factorised
+    // when its version is not that of the cached factorisation
+    const bool jacobian_has_been_factorised =
+     Linear_solver_pt->solve_with_cached_factorisation(Jacobian_pt,
+                                                       Jacobian_and_residual_strategy_pt->jacobian_version(),
+                                                       residual_pt, dx_pt);
+    if (jacobian_has_been_factorised)
+     {
+      N_factorisations++;
+     }
     
     // Time the linear solver
     clock_t final_clock_time_for_linear_solver = Timing::cpu_clock_time();
@@ -389,10 +473,7 @@ namespace scicellxx
      }
     
     // Update initial guess
-    for (unsigned i_dof = 0; i_dof < n_dof; i_dof++)
-     {
-      X_pt->value(i_dof)+=dx_pt->value(i_dof);
-     }
+    X_pt->axpy(1.0, *dx_pt);
     
     // Perform actions after Newton's step
     actions_after_newton_step();
@@ -406,6 +487,9 @@ namespace scicellxx
     // Get a pointer to the residual
     residual_pt = Jacobian_and_residual_strategy_pt->residual_pt();
     
+    // Store the norm of the previous residual
+    const Real previous_residual_norm = current_residual_norm;
+    
     // Compute the norm of the residual
     current_residual_norm = residual_pt->norm_inf();
     
@@ -416,8 +500,48 @@ namespace scicellxx
                       << ": Residual norm (termination tolerance) " << current_residual_norm << " (" << termination_tolerance << ")"<< std::endl;
      }
     
-    if (current_residual_norm > Maximum_allowed_residual)
+    // A slow convergence means that the Jacobian is no longer a good
+    // approximation, compute it at the next iteration
+    if (Reuse_jacobian &&
+        !(current_residual_norm <= Maximum_convergence_rate_for_jacobian_reuse * previous_residual_norm))
+     {
+      Jacobian_is_stale = true;
+     }
+    
+    // Did Newton's method fail?
+    const bool maximum_allowed_residual_exceeded =
+     !(current_residual_norm <= Maximum_allowed_residual);
+    const bool maximum_newton_iterations_reached =
+     n_newton_iterations >= Maximum_newton_iterations && current_residual_norm >= termination_tolerance;
+    
+    // The failure may be due to a Jacobian computed in a previous call
+    // to Newton's method, restart from the initial guess with a new
+    // Jacobian
+    if ((maximum_allowed_residual_exceeded || maximum_newton_iterations_reached) &&
+        Reuse_jacobian && !jacobian_has_been_computed)
+     {
+      // Is output message enabled?
+      if (Output_messages)
+       {
+        scicellxx_output << "Newton's method failed with a reused Jacobian,\n"
+                        << "restart with a new Jacobian" << std::endl;
+       }
+      
+      X_pt->copy(*x_initial_guess.pt());
+      actions_after_newton_step();
+      Jacobian_and_residual_strategy_pt->compute_residual();
+      residual_pt = Jacobian_and_residual_strategy_pt->residual_pt();
+      current_residual_norm = initial_residual_norm;
+      n_newton_iterations = 0;
+      Jacobian_is_stale = true;
+      continue;
+     }
+    
+    if (maximum_allowed_residual_exceeded)
      {
+      // The Jacobian of the failed iterations is not reused
+      Jacobian_is_stale = true;
+      
       // Error message
       std::ostringstream error_message;
       error_message << "Newton's method MAXIMUM ALLOWED RESIDUAL error ["<<Maximum_allowed_residual<<"]\n"
@@ -430,8 +554,11 @@ namespace scicellxx
                              SCICELLXX_EXCEPTION_LOCATION);
      }
     
-    if (n_newton_iterations >= Maximum_newton_iterations)
+    if (maximum_newton_iterations_reached)
      {
+      // The Jacobian of the failed iterations is not reused
+      Jacobian_is_stale = true;
+      
       // Error message
       std::ostringstream error_message;
       error_message << "Newton's method MAXIMUM NUMBER OF ITERATIONS reached ["<<Maximum_newton_iterations<<"]\n"
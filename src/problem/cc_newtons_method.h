@@ -40,9 +40,30 @@ namespace scicellxx
 #endif // #ifdef TYPEDEF_REAL_IS_DOUBLE
 #define DEFAULT_MAXIMUM_NEWTON_ITERATIONS 10
 #define DEFAULT_MAXIMUM_ALLOWED_RESIDUAL 10.0
+#define DEFAULT_MAXIMUM_JACOBIAN_AGE 20
+#define DEFAULT_MAXIMUM_CONVERGENCE_RATE_FOR_JACOBIAN_REUSE 0.5
  
  /// A concrete class for solving a given problem by means of Newton's
  /// method
+ ///
+ /// When the reuse of the Jacobian is enabled the Jacobian and its
+ /// factorisation (cached by the linear solver) are kept across
+ /// Newton's iterations and calls to solve() (a simplified Newton's
+ /// method). The Jacobian is recomputed (and factorised) when it is
+ /// stale, that is when:
+ ///
+ /// - it has been used by Maximum_jacobian_age calls to solve(),
+ ///
+ /// - the norm of the residual was not reduced by at least
+ ///   Maximum_convergence_rate_for_jacobian_reuse in the last
+ ///   iteration,
+ ///
+ /// - it was marked as stale by mark_jacobian_as_stale() (a new time
+ ///   step size, for example).
+ ///
+ /// If Newton's method fails with a Jacobian computed in a previous
+ /// call to solve() the iterations are restarted from the initial
+ /// guess with a new Jacobian before an error is thrown
  class CCNewtonsMethod
  {
   
@@ -110,6 +131,44 @@ namespace scicellxx
    
   /// Disables output messages for Newton's method
   inline void disable_output_messages() {Output_messages=false;}
+  
+  /// Enables the reuse of the Jacobian and its factorisation across
+  /// Newton's iterations and calls to solve()
+  inline void enable_jacobian_reuse() {Reuse_jacobian = true;}
+  
+  /// Disables the reuse of the Jacobian, it is computed and
+  /// factorised at each Newton's iteration (default)
+  inline void disable_jacobian_reuse()
+  {Reuse_jacobian = false; mark_jacobian_as_stale();}
+  
+  /// Set the maximum number of calls to solve() that use the same
+  /// Jacobian, 1 only reuses the Jacobian within a call to solve()
+  void set_maximum_jacobian_age(const unsigned new_maximum_jacobian_age);
+  
+  /// Set the maximum ratio of the norms of the residuals of two
+  /// consecutive iterations, the Jacobian is recomputed when it is
+  /// larger
+  void set_maximum_convergence_rate_for_jacobian_reuse(const Real new_maximum_convergence_rate);
+  
+  /// Forces the computation of the Jacobian at the next Newton's
+  /// iteration. Call it when the problem changes such that the
+  /// current Jacobian is no longer a good approximation
+  inline void mark_jacobian_as_stale() {Jacobian_is_stale = true;}
+  
+  /// The number of Jacobians computed (since construction or the last
+  /// call to reset_statistics())
+  inline unsigned long n_jacobian_computations() const
+  {return N_jacobian_computations;}
+  
+  /// The number of factorisations performed by the linear solver
+  inline unsigned long n_factorisations() const {return N_factorisations;}
+  
+  /// The number of Newton's iterations
+  inline unsigned long n_newton_iterations() const {return N_newton_iterations;}
+  
+  /// Resets the number of Jacobians, factorisations and iterations
+  inline void reset_statistics()
+  {N_jacobian_computations = N_factorisations = N_newton_iterations = 0;}
    
   /// Clean up, free allocated memory
   void clean_up();
@@ -170,9 +229,21 @@ namespace scicellxx
   /// linear solver
   bool Free_memory_for_linear_solver;
    
-  /// Flag to indicate whether to reuse the Jacobian matrix during
-  /// Newton's method
+  /// Flag to indicate whether to reuse the Jacobian matrix (and its
+  /// factorisation) across Newton's iterations and calls to solve()
   bool Reuse_jacobian;
+  
+  /// The maximum number of calls to solve() that use the same Jacobian
+  unsigned Maximum_jacobian_age;
+  
+  /// The maximum ratio of the norms of the residuals of two
+  /// consecutive iterations before the Jacobian is recomputed
+  Real Maximum_convergence_rate_for_jacobian_reuse;
+   
+  /// Factory for the vectors used during Newton's method, the
+  /// increment of each step is taken from its pool such that it is
+  /// reused by later calls to solve()
+  CCFactoryMatrices<Real> Factory_matrices_and_vectors;
    
  private:
    
@@ -212,6 +283,19 @@ namespace scicellxx
   /// Flag to indicate whether output messages are enabled or disabled
   /// (enabled by default)
   bool Output_messages;
+  
+  /// Flag to indicate whether the Jacobian must be computed at the
+  /// next Newton's iteration
+  bool Jacobian_is_stale;
+  
+  /// The number of calls to solve() that have used the Jacobian
+  unsigned Jacobian_age;
+  
+  /// The number of Jacobians computed, factorisations and Newton's
+  /// iterations
+  unsigned long N_jacobian_computations;
+  unsigned long N_factorisations;
+  unsigned long N_newton_iterations;
    
  };
  
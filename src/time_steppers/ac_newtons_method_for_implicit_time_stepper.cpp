@@ -12,6 +12,8 @@ namespace scicellxx
  ACNewtonsMethodForImplicitTimeStepper::ACNewtonsMethodForImplicitTimeStepper()
   : CCNewtonsMethod(),
     ODEs_pt(NULL),
+    Time_step(0.0),
+    Current_time(0.0),
     U_pt(NULL),
     Data_for_jacobian_and_residual_has_been_set(false)
  {
@@ -42,9 +44,19 @@ namespace scicellxx
   // Update U, store the new values at index 'History_index'
   const unsigned k = History_index;
   const unsigned long n_data = U_pt->n_values();
-  for (unsigned long i = 0; i < n_data; i++)
+  const ACVector<Real> *x_vector_pt = this->x_pt();
+  const CCVectorSpan<Real> x = x_vector_pt->span();
+  if (!x.is_empty())
    {
-    U_pt->value(i,k)=this->x_pt()->value(i);
+    BulkKernels::copy(n_data, x.Data_pt, x.Stride,
+                      U_pt->history_values_row_pt(k), 1);
+   }
+  else
+   {
+    for (unsigned long i = 0; i < n_data; i++)
+     {
+      U_pt->value(i,k)=x_vector_pt->value(i);
+     }
    }
   
  }
@@ -58,6 +70,13 @@ namespace scicellxx
  set_data_for_jacobian_and_residual(ACODEs *odes_pt, const Real h, const Real t,
                                     CCData *u_pt, const unsigned k)
  {
+  // The Jacobian of the time stepper depends on the time step, a
+  // reused Jacobian is not valid for other odes or step sizes
+  if (odes_pt != ODEs_pt || u_pt != U_pt || h != Time_step)
+   {
+    this->mark_jacobian_as_stale();
+   }
+  
   // Set the odes
   ODEs_pt = odes_pt;
   
@@ -89,6 +108,9 @@ namespace scicellxx
   if (cache_jacobian_strategy_pt != NULL)
    {
     cache_jacobian_strategy_pt->set_strategy_for_odes_jacobian(jacobian_strategy_for_odes_pt);
+    
+    // The Jacobian of the new strategy has not been computed
+    this->mark_jacobian_as_stale();
    }
   else
    {
@@ -32,7 +32,8 @@ namespace scicellxx
   
   /// Set data for Jacobian and residual computation. The odes, the
   /// time step 'h', the current time 't', the values of 'u' and the
-  /// index where the values of 'u' at time 't+h' will be stored
+  /// index where the values of 'u' at time 't+h' will be stored. The
+  /// Jacobian is marked as stale when the odes, 'u' or 'h' change
   void set_data_for_jacobian_and_residual(ACODEs *odes_pt, const Real h, const Real t,
                                           CCData *u_pt, const unsigned k);
   
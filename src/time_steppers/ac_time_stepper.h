@@ -10,6 +10,9 @@
 // Include factory for matrices and vectors
 #include "../matrices/cc_factory_matrices.h"
 
+// The fused kernels for the updates of the values
+#include "update_kernels.h"
+
 namespace scicellxx
 { 
  /// @class ACTimeStepper ac_time_stepper.h
@@ -72,9 +72,15 @@ namespace scicellxx
 
   // Create a vector with the initial guess from the first row (0)
   // since the values have been shift
-  
-  ACVector<Real> *u_initial_guess_pt = this->Factory_matrices_and_vectors.create_vector();
-  u_initial_guess_pt->set_vector(u.history_values_row_pt(0), n_odes);
+  // (the vector is taken from the pool of the factory and given back
+  // at the end of the time step, the row is copied into its memory by
+  // the bulk kernels)
+  CCFactoryMatrices<Real>::Pooled_vector u_initial_guess =
+   this->Factory_matrices_and_vectors.acquire_vector(n_odes);
+  ACVector<Real> *u_initial_guess_pt = u_initial_guess.pt();
+  const CCVectorSpan<Real> u_initial_guess_span = u_initial_guess_pt->span();
+  BulkKernels::copy(n_odes, u.history_values_row_pt(0), 1,
+                    u_initial_guess_span.Data_pt, u_initial_guess_span.Stride);
   
   // It is not required to shift the values to the right to provide
   // storage for the new values since they were shift when computing
@@ -63,9 +63,11 @@ namespace scicellxx
   // Get the number of odes
   const unsigned n_odes = odes.n_odes();
   
-  // The residual vector
-  ACVector<Real> *local_error_vector_pt = this->Factory_matrices_and_vectors.create_vector();
-  local_error_vector_pt->allocate_memory(n_odes);
+  // The residual vector, taken from the pool of the factory and given
+  // back at the end of the time step
+  CCFactoryMatrices<Real>::Pooled_vector local_error_vector =
+   this->Factory_matrices_and_vectors.acquire_vector(n_odes);
+  ACVector<Real> *local_error_vector_pt = local_error_vector.pt();
   
   // Initialise local error with 0
   Real local_error = 0;
@@ -83,11 +85,15 @@ namespace scicellxx
   // initial values from u
   CCData u_p(u);
   
+  // The rows with the values at index k, the prediction and the
+  // correction are computed directly on them by the fused kernels
+  const Real *u_k_pt = u.history_values_row_pt(k);
+  Real *u_p_k_pt = u_p.history_values_row_pt(k);
+  
   // Prediction step (Forward Euler)
-  for (unsigned i = 0; i < n_odes; i++)
-   {
-    u_p(i,k) = u(i,k) + (h * (dudt(i)));
-   }
+  const Real *dudt_pt = dudt.values_pt();
+  const Real one = 1.0;
+  UpdateKernels::lincomb(n_odes, u_k_pt, h, 1, &one, &dudt_pt, u_p_k_pt);
   
   // -----------------------------------------------------------------
   // -- Evaluation phase
@@ -105,10 +111,9 @@ namespace scicellxx
    // -- Correction phase
    // -----------------------------------------------------------------
    const Real half_h = h * 0.5;
-   for (unsigned i = 0; i < n_odes; i++)
-   {
-    u_p(i,k) = u(i,k) + (half_h * (dudt_p(i) + dudt(i)));
-   }
+   const Real c[] = {1.0, 1.0};
+   const Real *dudt_p_and_dudt_pt[] = {dudt_p.values_pt(), dudt_pt};
+   UpdateKernels::lincomb(n_odes, u_k_pt, half_h, 2, c, dudt_p_and_dudt_pt, u_p_k_pt);
    
    // Compute error
    for (unsigned i = 0; i < n_odes; i++)
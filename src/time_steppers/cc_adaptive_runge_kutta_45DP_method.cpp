@@ -73,6 +73,17 @@ namespace scicellxx
   // Create a copy of the u vector
   CCData u_copy(u);
   
+  // The rows with the values at index k, the stages are computed
+  // directly on them by the fused kernels
+  const Real *u_k_pt = u.history_values_row_pt(k);
+  Real *u_copy_k_pt = u_copy.history_values_row_pt(k);
+  // The K's used by the stages, and the ones used by the solution and
+  // the error (all but K2)
+  const Real *K_pt[] = {K1.values_pt(), K2.values_pt(), K3.values_pt(),
+                        K4.values_pt(), K5.values_pt(), K6.values_pt()};
+  const Real *K_solution_pt[] = {K1.values_pt(), K3.values_pt(), K4.values_pt(),
+                                 K5.values_pt(), K6.values_pt(), K7.values_pt()};
+  
   // Counter for iterations
   unsigned n_iterations = 0;
   // Sum up the error
@@ -141,67 +152,57 @@ namespace scicellxx
     odes.evaluate_derivatives(t, u, K1, k);
     // --------------------------------------------------------------------
     // Evaluate the ODE at time "t+(hh/5)" and with "u+(hh/5)K1"
-    for (unsigned i = 0; i < n_odes; i++)
-     {
-      u_copy(i,k) = u(i,k)+(hh*(0.2*K1(i)));
-     }
+    const Real a2[] = {0.2};
+    UpdateKernels::lincomb(n_odes, u_k_pt, hh, 1, a2, K_pt, u_copy_k_pt);
     // K2
     odes.evaluate_derivatives(t+(0.2*hh), u_copy, K2, k);
     
     // --------------------------------------------------------------------
     // Evaluate the ODE at time "t+(3hh/10)" and with "u+(3hh/40)K1 + 9hh/40"
-    for (unsigned i = 0; i < n_odes; i++)
-     {
-      u_copy(i,k) = u(i,k)+hh*((3.0/40.0)*K1(i)+(9.0/40.0)*K2(i));
-     }
+    const Real a3[] = {3.0/40.0, 9.0/40.0};
+    UpdateKernels::lincomb(n_odes, u_k_pt, hh, 2, a3, K_pt, u_copy_k_pt);
     // K3
     odes.evaluate_derivatives(t+((3.0/10.0)*hh), u_copy, K3, k);
     
     // --------------------------------------------------------------------
     // Evaluate the ODE at time "t+(4hh/5)" and with "u+(44/45)K1 - (56/15)K2 + (32/9)K3"
-    for (unsigned i = 0; i < n_odes; i++)
-     {
-      u_copy(i,k) = u(i,k)+hh*((44.0/45.0)*K1(i)-(56.0/15.0)*K2(i)+(32.0/9.0)*K3(i));
-     }
+    const Real a4[] = {44.0/45.0, -56.0/15.0, 32.0/9.0};
+    UpdateKernels::lincomb(n_odes, u_k_pt, hh, 3, a4, K_pt, u_copy_k_pt);
     // K4
     odes.evaluate_derivatives(t+((4.0/5.0)*hh), u_copy, K4);
     
     // --------------------------------------------------------------------
     // Evaluate the ODE at time "t+(8hh/9)" and with "u+(19372hh/6561)K1 - (25360hh/2187)K2 + (64448hh/6561)K3 - (212hh/729)K4"
-    for (unsigned i = 0; i < n_odes; i++)
-     {
-      u_copy(i,k) = u(i,k)+hh*((19372.0/6561.0)*K1(i)-(25360.0/2187.0)*K2(i)+(64448.0/6561.0)*K3(i)-(212.0/729.0)*K4(i));
-     }
+    const Real a5[] = {19372.0/6561.0, -25360.0/2187.0,
+                       64448.0/6561.0, -212.0/729.0};
+    UpdateKernels::lincomb(n_odes, u_k_pt, hh, 4, a5, K_pt, u_copy_k_pt);
     // K5
     odes.evaluate_derivatives(t+((4.0/5.0)*hh), u_copy, K5);
     
     // --------------------------------------------------------------------
     // Evaluate the ODE at time "t+hh" and with "u+(9017hh/3168)K1 - (355hh/33)K2 + (46732hh/5247)K3 + (49hh/176)K4 - (5103hh/18656)K5"
-    for (unsigned i = 0; i < n_odes; i++)
-     {
-      u_copy(i,k) = u(i,k)+hh*((9017.0/3168.0)*K1(i)-(355.0/33.0)*K2(i)+(46732.0/5247.0)*K3(i)+(49.0/176.0)*K4(i)-(5103.0/18656.0)*K5(i));
-     }
+    const Real a6[] = {9017.0/3168.0, -355.0/33.0, 46732.0/5247.0,
+                       49.0/176.0, -5103.0/18656.0};
+    UpdateKernels::lincomb(n_odes, u_k_pt, hh, 5, a6, K_pt, u_copy_k_pt);
     // K6
     odes.evaluate_derivatives(t+hh, u_copy, K6);
     
     // --------------------------------------------------------------------
     // Evaluate the ODE at time "t+hh" and with "u+(35hh/384)K1 + (500hh/1113)K3 + (125hh/192)K4 - (2187hh/6784)K5 + (11hh/84)K6"
-    for (unsigned i = 0; i < n_odes; i++)
-     {
-      u_copy(i,k) = u(i,k)+hh*((35.0/384.0)*K1(i)+(500.0/1113.0)*K3(i)+(125.0/192.0)*K4(i)-(2187.0/6784.0)*K5(i)+(11.0/84.0)*K6(i));
-     }
+    const Real a7[] = {35.0/384.0, 500.0/1113.0, 125.0/192.0,
+                       -2187.0/6784.0, 11.0/84.0};
+    UpdateKernels::lincomb(n_odes, u_k_pt, hh, 5, a7, K_solution_pt, u_copy_k_pt);
     // K7
     odes.evaluate_derivatives(t+hh, u_copy, K7);
     
     // A storage for the error
     CCData error(n_odes);
-    // Reset the error
-    local_error = 0.0;
-    for (unsigned i = 0; i < n_odes; i++)
-     {
-      error(i) = hh*((71.0/57600.0)*K1(i) - (71.0/16695.0)*K3(i) + (71.0/1920.0)*K4(i) - (17253.0/339200.0)*K5(i) + (22.0/525.0)*K6(i) - (1.0/40.0)*K7(i));
-      local_error+=error(i); 
-     }
+    const Real e[] = {71.0/57600.0, -71.0/16695.0, 71.0/1920.0,
+                      -17253.0/339200.0, 22.0/525.0, -1.0/40.0};
+    UpdateKernels::lincomb(n_odes, static_cast<const Real*>(0), hh, 6, e, K_solution_pt,
+                           error.values_pt());
+    // Sum up the error
+    local_error = UpdateKernels::sum(n_odes, error.values_pt());
     
     // Compute the new step size based on the established strategy
     hh = New_time_step_strategy_pt->new_step_size(local_error, hh);
@@ -265,10 +266,10 @@ namespace scicellxx
   // Once the derivatives have been obtained compute the new "u" as
   // the weighted sum of the K's
   Real hh = this->taken_auto_step_size();
-  for (unsigned i = 0; i < n_odes; i++)
-    {
-     u(i,k) = u(i,k+1) + hh*((35.0/384.0)*K1(i)+(500.0/1113.0)*K3(i)+(125.0/192.0)*K4(i)-(2187.0/6784.0)*K5(i)+(11.0/84.0)*K6(i));
-    }
+  const Real b[] = {35.0/384.0, 500.0/1113.0, 125.0/192.0,
+                    -2187.0/6784.0, 11.0/84.0};
+  UpdateKernels::lincomb(n_odes, u.history_values_row_pt(k+1), hh, 5, b, K_solution_pt,
+                         u.history_values_row_pt(k));
   
  }
  
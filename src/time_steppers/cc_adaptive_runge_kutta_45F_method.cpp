@@ -72,6 +72,17 @@ namespace scicellxx
   // Create a copy of the u vector
   CCData u_copy(u);
   
+  // The rows with the values at index k, the stages are computed
+  // directly on them by the fused kernels
+  const Real *u_k_pt = u.history_values_row_pt(k);
+  Real *u_copy_k_pt = u_copy.history_values_row_pt(k);
+  // The K's used by the stages, and the ones used by the solution and
+  // the error (all but K2)
+  const Real *K_pt[] = {K1.values_pt(), K2.values_pt(), K3.values_pt(),
+                        K4.values_pt(), K5.values_pt()};
+  const Real *K_solution_pt[] = {K1.values_pt(), K3.values_pt(), K4.values_pt(),
+                                 K5.values_pt(), K6.values_pt()};
+  
   // Counter for iterations
   unsigned n_iterations = 0;
   // Sum up the error
@@ -138,45 +149,36 @@ namespace scicellxx
     odes.evaluate_derivatives(t, u, K1, k);
     // --------------------------------------------------------------------
     // Evaluate the ODE at time "t+(hh/4)" and with "u+(hh/4)K1"
-    for (unsigned i = 0; i < n_odes; i++)
-     {
-      u_copy(i,k) = u(i,k)+(hh*(0.25*K1(i)));
-     }
+    const Real a2[] = {0.25};
+    UpdateKernels::lincomb(n_odes, u_k_pt, hh, 1, a2, K_pt, u_copy_k_pt);
     // K2
     odes.evaluate_derivatives(t+(0.25*hh), u_copy, K2, k);
     
     // --------------------------------------------------------------------
     // Evaluate the ODE at time "t+(3hh/8)" and with "u+(3hh/32)K1 + 9hh/32K2"
-    for (unsigned i = 0; i < n_odes; i++)
-     {
-      u_copy(i,k) = u(i,k)+hh*((3.0/32.0)*K1(i)+(9.0/32.0)*K2(i));
-     }
+    const Real a3[] = {3.0/32.0, 9.0/32.0};
+    UpdateKernels::lincomb(n_odes, u_k_pt, hh, 2, a3, K_pt, u_copy_k_pt);
     // K3
     odes.evaluate_derivatives(t+((3.0/8.0)*hh), u_copy, K3, k);
     
     // --------------------------------------------------------------------
     // Evaluate the ODE at time "t+(12hh/13)" and with "u+(1932hh/2197)K1 - (7200hh/2197)K2 + (7296hh/2197)K3"
-    for (unsigned i = 0; i < n_odes; i++)
-     {
-      u_copy(i,k) = u(i,k)+hh*((1932.0/2197.0)*K1(i)-(7200.0/2197.0)*K2(i)+(7296.0/2197.0)*K3(i));
-     }
+    const Real a4[] = {1932.0/2197.0, -7200.0/2197.0, 7296.0/2197.0};
+    UpdateKernels::lincomb(n_odes, u_k_pt, hh, 3, a4, K_pt, u_copy_k_pt);
     // K4
     odes.evaluate_derivatives(t+((12.0/13.0)*hh), u_copy, K4);
     
     // --------------------------------------------------------------------
     // Evaluate the ODE at time "t+hh" and with "u+(439hh/216)K1 - 8hhK2 + (3680hh/513)K3 - (845hh/4104)K4"
-    for (unsigned i = 0; i < n_odes; i++)
-     {
-      u_copy(i,k) = u(i,k)+hh*((439.0/216.0)*K1(i)-8*K2(i)+(3680.0/513.0)*K3(i)-(845.0/4104.0)*K4(i));
-     }
+    const Real a5[] = {439.0/216.0, -8.0, 3680.0/513.0, -845.0/4104.0};
+    UpdateKernels::lincomb(n_odes, u_k_pt, hh, 4, a5, K_pt, u_copy_k_pt);
     // K5
     odes.evaluate_derivatives(t+hh, u_copy, K5);
     // --------------------------------------------------------------------
     // Evaluate the ODE at time "t+(1hh/2)" and with "u+(-8hh/27)K1 + 2hhK2 - (3544hh/2565)K3 + (1859hh/4104)K4 - (11hh/40)K5"
-    for (unsigned i = 0; i < n_odes; i++)
-     {
-      u_copy(i,k) = u(i,k)+hh*((-8.0/27.0)*K1(i)+2*K2(i)-(3544.0/2565.0)*K3(i)+(1859.0/4104.0)*K4(i)-(11.0/40.0)*K5(i));
-     }
+    const Real a6[] = {-8.0/27.0, 2.0, -3544.0/2565.0,
+                       1859.0/4104.0, -11.0/40.0};
+    UpdateKernels::lincomb(n_odes, u_k_pt, hh, 5, a6, K_pt, u_copy_k_pt);
     // K6
     odes.evaluate_derivatives(t+(0.5*hh), u_copy, K6);
     
@@ -195,13 +197,12 @@ namespace scicellxx
     
     // A storage for the error
     CCData error(n_odes);
-    // Reset the error
-    local_error = 0.0;
-    for (unsigned i = 0; i < n_odes; i++)
-     {
-      error(i) = hh*((1.0/360.0)*K1(i) - (128.0/4275.0)*K3(i) - (2197.0/75240.0)*K4(i) + (1.0/50.0)*K5(i) + (2.0/55.0)*K6(i));
-      local_error+=error(i); 
-     }
+    const Real e[] = {1.0/360.0, -128.0/4275.0, -2197.0/75240.0,
+                      1.0/50.0, 2.0/55.0};
+    UpdateKernels::lincomb(n_odes, static_cast<const Real*>(0), hh, 5, e, K_solution_pt,
+                           error.values_pt());
+    // Sum up the error
+    local_error = UpdateKernels::sum(n_odes, error.values_pt());
     
     // Compute the new step size based on the established strategy
     hh = New_time_step_strategy_pt->new_step_size(local_error, hh);
@@ -265,10 +266,10 @@ namespace scicellxx
   // Once the derivatives have been obtained compute the new "u" as
   // the weighted sum of the K's
   Real hh = this->taken_auto_step_size();
-  for (unsigned i = 0; i < n_odes; i++)
-    {
-     u(i,k) = u(i,k+1) + hh*((16.0/135.0)*K1(i) + (6656.0/12825.0)*K3(i) + (28561.0/56430.0)*K4(i) - (9.0/50.0)*K5(i) + (2.0/55.0)*K6(i));
-    }
+  const Real b[] = {16.0/135.0, 6656.0/12825.0, 28561.0/56430.0,
+                    -9.0/50.0, 2.0/55.0};
+  UpdateKernels::lincomb(n_odes, u.history_values_row_pt(k+1), hh, 5, b, K_solution_pt,
+                         u.history_values_row_pt(k));
   
  }
  
@@ -36,10 +36,26 @@ namespace scicellxx
   void time_step(ACODEs &odes, const Real h, const Real t,
                  CCData &u, const unsigned k = 0);
   
+  /// Resets the time stepper to its initial state, the Jacobian of
+  /// Newton's method is no longer reused
+  void reset() {Newtons_method.mark_jacobian_as_stale();}
+  
   /// Set the strategy for the computation of the Jacobian of the ODEs (if known)
   inline void set_strategy_for_odes_jacobian(ACJacobianAndResidualForImplicitTimeStepper *jacobian_strategy_for_odes_pt)
   {Newtons_method.set_strategy_for_odes_jacobian(jacobian_strategy_for_odes_pt);}
   
+  /// Enables the reuse of the Jacobian of Newton's method and its
+  /// factorisation across Newton's iterations and time steps (see
+  /// CCNewtonsMethod for the staleness policy)
+  inline void enable_jacobian_reuse() {Newtons_method.enable_jacobian_reuse();}
+  
+  /// Disables the reuse of the Jacobian of Newton's method (default)
+  inline void disable_jacobian_reuse() {Newtons_method.disable_jacobian_reuse();}
+  
+  /// Gets access to Newton's method, to configure it or to get the
+  /// number of Jacobians and factorisations computed
+  inline CCNewtonsMethod &newtons_method() {return Newtons_method;}
+  
  protected:
   
   /// Copy constructor (we do not want this class to be
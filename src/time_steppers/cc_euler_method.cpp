@@ -66,10 +66,10 @@ namespace scicellxx
   u.shift_history_values();
   
   // Perform one step of Euler's method
-  for (unsigned i = 0; i < n_odes; i++)
-   {
-    u(i,k) = u(i,k+1) + (h * dudt(i));
-   }
+  const Real *dudt_pt = dudt.values_pt();
+  const Real one = 1.0;
+  UpdateKernels::lincomb(n_odes, u.history_values_row_pt(k+1), h, 1, &one, &dudt_pt,
+                         u.history_values_row_pt(k));
   
  }
 
@@ -83,20 +83,13 @@ namespace scicellxx
   // Half time step
   const Real h_half = h * 0.5;
   
-  // Compute the approximated Jacobian (I - h * Jacobian_FY(i, j))
+  // Compute the approximated Jacobian (I - h * Jacobian_FY(i, j)), scale a
+  // copy of Jacobian_FY and add the identity
+  this->Jacobian_pt->copy(*Jacobian_FY_pt);
+  this->Jacobian_pt->scale(-h_half);
   for (unsigned i = 0; i < n_dof; i++)
    {
-    for (unsigned j = 0; j < n_dof; j++)
-     {
-      if (i == j)
-       {
-        (*this->Jacobian_pt)(i, j) = 1.0 - (h_half * Jacobian_FY_pt->value(i, j));
-       }
-      else
-       {
-        (*this->Jacobian_pt)(i, j) = 0.0 - (h_half * Jacobian_FY_pt->value(i, j));
-       }
-     }
+    (*this->Jacobian_pt)(i, i)+= 1.0;
    }
   
  }
@@ -71,6 +71,13 @@ namespace scicellxx
   
   // Create a copy of the u vector
   CCData u_copy(u);
+  
+  // The rows with the values at index k, the stages are computed
+  // directly on them by the fused kernels
+  const Real *u_k_pt = u.history_values_row_pt(k);
+  Real *u_copy_k_pt = u_copy.history_values_row_pt(k);
+  const Real *K_pt[] = {K1.values_pt(), K2.values_pt(), K3.values_pt(), K4.values_pt()};
+  const Real one = 1.0;
 
   // --------------------------------------------------------------------
   // Runge-Kutta 4 method
@@ -96,26 +103,17 @@ namespace scicellxx
   // --------------------------------------------------------------------
   // Evaluate the ODE at time "t+(h/2)" and with "u+(h/2)K1"
   const Real h_half = h*0.5;
-  for (unsigned i = 0; i < n_odes; i++)
-   {
-    u_copy(i,k) = u(i,k)+h_half*K1(i);
-   }
+  UpdateKernels::lincomb(n_odes, u_k_pt, h_half, 1, &one, &K_pt[0], u_copy_k_pt);
   odes.evaluate_derivatives(t+h_half, u_copy, K2, k);
   
   // --------------------------------------------------------------------
   // Evaluate the ODE at time "t+(h/2)" and with "u+(h/2)K2"
-  for (unsigned i = 0; i < n_odes; i++)
-   {
-    u_copy(i,k) = u(i,k)+h_half*K2(i);
-   }
+  UpdateKernels::lincomb(n_odes, u_k_pt, h_half, 1, &one, &K_pt[1], u_copy_k_pt);
   odes.evaluate_derivatives(t+h_half, u_copy, K3, k);
   
   // -------------------------------------------------------------------- 
   // Evaluate the ODE at time "t+h" and with "u+hK3"
-  for (unsigned i = 0; i < n_odes; i++)
-   {
-    u_copy(i,k) = u(i,k)+h*K3(i);
-   }
+  UpdateKernels::lincomb(n_odes, u_k_pt, h, 1, &one, &K_pt[2], u_copy_k_pt);
   odes.evaluate_derivatives(t+h, u_copy, K4);
   
   // Shift values to the right to provide storage for the new values
@@ -123,10 +121,9 @@ namespace scicellxx
   
   // Once the derivatives have been obtained compute the new "u" as
   // the weighted sum of the K's
-  for (unsigned i = 0; i < n_odes; i++)
-   {
-    u(i,k) = u(i,k+1) + (h/6.0)*(K1(i) + 2.0*K2(i) + 2.0*K3(i) + K4(i));
-   }
+  const Real b[] = {1.0, 2.0, 2.0, 1.0};
+  UpdateKernels::lincomb(n_odes, u.history_values_row_pt(k+1), Real(h/6.0), 4, b, K_pt,
+                         u.history_values_row_pt(k));
  
  }
 
@@ -0,0 +1,389 @@
+// IN THIS FILE: Fused kernels for the updates performed by the time
+// steppers (axpy, axpby, linear combinations of up to seven vectors
+// and the weighted RMS norm of the local error). The kernels work on
+// raw pointers such that they can be applied to the history rows of
+// a CCData (history_values_row_pt()) or to the memory of an ACVector
+// (span()). Each kernel performs a single pass over the entries with
+// no calls to virtual methods and with the number of terms known at
+// compile time, thus the inner loops are vectorised by the compiler
+
+// Check whether the namespace has been already defined
+#ifndef UPDATE_KERNELS_H
+#define UPDATE_KERNELS_H
+
+#include "../general/common_includes.h"
+#include "../general/utilities.h"
+
+// The vectors whose memory is used by the kernels
+#include "../matrices/ac_vector.h"
+// The type used to accumulate the reductions
+#include "../matrices/accumulator_traits.h"
+
+namespace scicellxx
+{
+
+ // ==================================================================
+ /// Fused kernels for the updates of the time steppers. The output
+ /// vector y may be the same as the first input vector (x in axpy and
+ /// axpby, x0 in lincomb) but must not overlap any other input
+ // ==================================================================
+ namespace UpdateKernels
+ {
+
+  /// The maximum number of terms of a linear combination (the number
+  /// of stages of the embedded Runge-Kutta methods)
+  const unsigned Maximum_terms = 7;
+
+  // ================================================================
+  /// y = y + alpha * x
+  // ================================================================
+  template<class T>
+   inline void axpy(const unsigned long n, const T alpha,
+                    const T *x, T *y)
+   {
+    for (unsigned long i = 0; i < n; i++)
+     {
+      y[i]+= alpha * x[i];
+     }
+   }
+
+  // ================================================================
+  /// y = alpha * x + beta * y
+  // ================================================================
+  template<class T>
+   inline void axpby(const unsigned long n, const T alpha, const T *x,
+                     const T beta, T *y)
+   {
+    for (unsigned long i = 0; i < n; i++)
+     {
+      y[i] = alpha * x[i] + beta * y[i];
+     }
+   }
+
+  // ================================================================
+  /// y = x0 + alpha * (c[0] * x[0] + ... + c[M-1] * x[M-1]), the
+  /// number of terms is known at compile time such that the sum is
+  /// unrolled
+  // ================================================================
+  template<class T, unsigned M>
+   inline void lincomb_terms(const unsigned long n, const T *x0,
+                             const T alpha, const T *c,
+                             const T *const *x, T *y)
+   {
+    T c_local[M];
+    const T *x_local[M];
+    for (unsigned j = 0; j < M; j++)
+     {
+      c_local[j] = c[j];
+      x_local[j] = x[j];
+     }
+
+    for (unsigned long i = 0; i < n; i++)
+     {
+      T sum = c_local[0] * x_local[0][i];
+      for (unsigned j = 1; j < M; j++)
+       {
+        sum+= c_local[j] * x_local[j][i];
+       }
+      y[i] = x0[i] + alpha * sum;
+     }
+   }
+
+  // ================================================================
+  /// y = alpha * (c[0] * x[0] + ... + c[M-1] * x[M-1]) (no base
+  /// vector)
+  // ================================================================
+  template<class T, unsigned M>
+   inline void lincomb_terms(const unsigned long n, const T alpha,
+                             const T *c, const T *const *x, T *y)
+   {
+    T c_local[M];
+    const T *x_local[M];
+    for (unsigned j = 0; j < M; j++)
+     {
+      c_local[j] = c[j];
+      x_local[j] = x[j];
+     }
+
+    for (unsigned long i = 0; i < n; i++)
+     {
+      T sum = c_local[0] * x_local[0][i];
+      for (unsigned j = 1; j < M; j++)
+       {
+        sum+= c_local[j] * x_local[j][i];
+       }
+      y[i] = alpha * sum;
+     }
+   }
+
+  // ================================================================
+  /// Checks that the number of terms of a linear combination is
+  /// supported
+  // ================================================================
+  inline void check_number_of_terms(const unsigned m)
+  {
+   if (m == 0 || m > Maximum_terms)
+    {
+     // Error message
+     std::ostringstream error_message;
+     error_message << "The number of terms of the linear combination is not\n"
+                   << "supported\n"
+                   << "Number of terms: " << m << "\n"
+                   << "Maximum number of terms: " << Maximum_terms << std::endl;
+     throw SciCellxxLibError(error_message.str(),
+                             SCICELLXX_CURRENT_FUNCTION,
+                             SCICELLXX_EXCEPTION_LOCATION);
+    }
+  }
+
+  // ================================================================
+  /// y = x0 + alpha * (c[0] * x[0] + ... + c[m-1] * x[m-1]) with 1 <=
+  /// m <= 7. If x0 is NULL it is taken as zero. y may be the same as
+  /// x0. The step size is passed as alpha and the coefficients of the
+  /// Butcher tableau as c, thus the operations are the same (and in
+  /// the same order) as in the textbook formula of each stage
+  // ================================================================
+  template<class T>
+   inline void lincomb(const unsigned long n, const T *x0, const T alpha,
+                       const unsigned m, const T *c, const T *const *x,
+                       T *y)
+   {
+    check_number_of_terms(m);
+    if (x0 != 0)
+     {
+      switch (m)
+       {
+       case 1: lincomb_terms<T, 1>(n, x0, alpha, c, x, y); break;
+       case 2: lincomb_terms<T, 2>(n, x0, alpha, c, x, y); break;
+       case 3: lincomb_terms<T, 3>(n, x0, alpha, c, x, y); break;
+       case 4: lincomb_terms<T, 4>(n, x0, alpha, c, x, y); break;
+       case 5: lincomb_terms<T, 5>(n, x0, alpha, c, x, y); break;
+       case 6: lincomb_terms<T, 6>(n, x0, alpha, c, x, y); break;
+       default: lincomb_terms<T, 7>(n, x0, alpha, c, x, y); break;
+       }
+     }
+    else
+     {
+      switch (m)
+       {
+       case 1: lincomb_terms<T, 1>(n, alpha, c, x, y); break;
+       case 2: lincomb_terms<T, 2>(n, alpha, c, x, y); break;
+       case 3: lincomb_terms<T, 3>(n, alpha, c, x, y); break;
+       case 4: lincomb_terms<T, 4>(n, alpha, c, x, y); break;
+       case 5: lincomb_terms<T, 5>(n, alpha, c, x, y); break;
+       case 6: lincomb_terms<T, 6>(n, alpha, c, x, y); break;
+       default: lincomb_terms<T, 7>(n, alpha, c, x, y); break;
+       }
+     }
+   }
+
+  // ================================================================
+  /// Returns the sum of the entries of x (accumulated in double for
+  /// float entries)
+  // ================================================================
+  template<class T>
+   inline T sum(const unsigned long n, const T *x)
+   {
+    typedef typename AccumulatorTraits<T>::Accumulator_type A;
+    A total = 0.0;
+    for (unsigned long i = 0; i < n; i++)
+     {
+      total+= x[i];
+     }
+    return T(total);
+   }
+
+  // ================================================================
+  /// Returns the weighted RMS norm of the local error e
+  ///
+  /// sqrt( 1/n sum_i (e_i / (atol + rtol * max(|y_old_i|, |y_new_i|)))^2 )
+  ///
+  /// where y_old and y_new are the values before and after the step,
+  /// y_new may be NULL in which case only y_old is used for the
+  /// weights. A value smaller or equal than one indicates that the
+  /// error is within the tolerances. The norm is computed in double
+  /// for float entries
+  // ================================================================
+  template<class T>
+   inline T wrms_norm(const unsigned long n, const T *e,
+                      const T *y_old, const T *y_new,
+                      const T atol, const T rtol)
+   {
+    if (n == 0)
+     {
+      return 0.0;
+     }
+
+    typedef typename AccumulatorTraits<T>::Accumulator_type A;
+    A total = 0.0;
+    if (y_new != 0)
+     {
+      for (unsigned long i = 0; i < n; i++)
+       {
+        const A scale = A(atol) + A(rtol) * std::max(std::fabs(A(y_old[i])), std::fabs(A(y_new[i])));
+        const A ratio = A(e[i]) / scale;
+        total+= ratio * ratio;
+       }
+     }
+    else
+     {
+      for (unsigned long i = 0; i < n; i++)
+       {
+        const A ratio = A(e[i]) / (A(atol) + A(rtol) * std::fabs(A(y_old[i])));
+        total+= ratio * ratio;
+       }
+     }
+    return T(std::sqrt(total / A(n)));
+   }
+
+  // ================================================================
+  /// Returns the pointer to the entries of the vector if they are
+  /// stored contiguously, otherwise returns NULL
+  // ================================================================
+  template<class T>
+   inline T *contiguous_pt(const ACVector<T> &vector)
+   {
+    const CCVectorSpan<T> x = vector.span();
+    if (!x.is_empty() && (x.Stride == 1 || vector.n_values() <= 1))
+     {
+      return x.Data_pt;
+     }
+    return 0;
+   }
+
+  // ================================================================
+  /// Checks that the number of entries of the vectors is the same
+  // ================================================================
+  template<class T>
+   inline void check_n_values(const ACVector<T> &x, const ACVector<T> &y)
+   {
+    if (x.n_values() != y.n_values())
+     {
+      // Error message
+      std::ostringstream error_message;
+      error_message << "The number of entries of the vectors is not the same\n"
+                    << "x.n_values() = " << x.n_values() << "\n"
+                    << "y.n_values() = " << y.n_values() << std::endl;
+      throw SciCellxxLibError(error_message.str(),
+                              SCICELLXX_CURRENT_FUNCTION,
+                              SCICELLXX_EXCEPTION_LOCATION);
+     }
+   }
+
+  // ================================================================
+  /// y = y + alpha * x (vectors of the library)
+  // ================================================================
+  template<class T>
+   inline void axpy(const T alpha, const ACVector<T> &x, ACVector<T> &y)
+   {
+    y.axpy(alpha, x);
+   }
+
+  // ================================================================
+  /// y = alpha * x + beta * y (vectors of the library). The entries
+  /// are accessed through value() if any of the vectors is not stored
+  /// contiguously
+  // ================================================================
+  template<class T>
+   inline void axpby(const T alpha, const ACVector<T> &x,
+                     const T beta, ACVector<T> &y)
+   {
+    check_n_values(x, y);
+    const unsigned long n = y.n_values();
+    const T *x_pt = contiguous_pt(x);
+    T *y_pt = contiguous_pt(y);
+    if (x_pt != 0 && y_pt != 0)
+     {
+      axpby(n, alpha, x_pt, beta, y_pt);
+     }
+    else
+     {
+      for (unsigned long i = 0; i < n; i++)
+       {
+        y.value(i) = alpha * x.value(i) + beta * y.value(i);
+       }
+     }
+   }
+
+  // ================================================================
+  /// y = x0 + alpha * (c[0] * x[0] + ... + c[m-1] * x[m-1]) (vectors
+  /// of the library). The entries are accessed through value() if any
+  /// of the vectors is not stored contiguously
+  // ================================================================
+  template<class T>
+   inline void lincomb(const ACVector<T> &x0, const T alpha,
+                       const unsigned m, const T *c,
+                       const ACVector<T> *const *x, ACVector<T> &y)
+   {
+    check_number_of_terms(m);
+    check_n_values(x0, y);
+    const unsigned long n = y.n_values();
+    const T *x0_pt = contiguous_pt(x0);
+    T *y_pt = contiguous_pt(y);
+    const T *x_pt[Maximum_terms];
+    bool contiguous = (x0_pt != 0 && y_pt != 0);
+    for (unsigned j = 0; j < m; j++)
+     {
+      check_n_values(*(x[j]), y);
+      x_pt[j] = contiguous_pt(*(x[j]));
+      contiguous = contiguous && x_pt[j] != 0;
+     }
+
+    if (contiguous)
+     {
+      lincomb(n, x0_pt, alpha, m, c, x_pt, y_pt);
+     }
+    else
+     {
+      for (unsigned long i = 0; i < n; i++)
+       {
+        T total = c[0] * x[0]->value(i);
+        for (unsigned j = 1; j < m; j++)
+         {
+          total+= c[j] * x[j]->value(i);
+         }
+        y.value(i) = x0.value(i) + alpha * total;
+       }
+     }
+   }
+
+  // ================================================================
+  /// Returns the weighted RMS norm of the local error e (vectors of
+  /// the library), see the version for raw pointers
+  // ================================================================
+  template<class T>
+   inline T wrms_norm(const ACVector<T> &e, const ACVector<T> &y_old,
+                      const ACVector<T> &y_new,
+                      const T atol, const T rtol)
+   {
+    check_n_values(e, y_old);
+    check_n_values(e, y_new);
+    const unsigned long n = e.n_values();
+    const T *e_pt = contiguous_pt(e);
+    const T *y_old_pt = contiguous_pt(y_old);
+    const T *y_new_pt = contiguous_pt(y_new);
+    if (e_pt != 0 && y_old_pt != 0 && y_new_pt != 0)
+     {
+      return wrms_norm(n, e_pt, y_old_pt, y_new_pt, atol, rtol);
+     }
+
+    if (n == 0)
+     {
+      return 0.0;
+     }
+    T total = 0.0;
+    for (unsigned long i = 0; i < n; i++)
+     {
+      const T scale =
+       atol + rtol * std::max(std::fabs(y_old.value(i)), std::fabs(y_new.value(i)));
+      const T ratio = e.value(i) / scale;
+      total+= ratio * ratio;
+     }
+    return std::sqrt(total / T(n));
+   }
+
+ }
+
+}
+
+#endif // #ifndef UPDATE_KERNELS_H